@@ -0,0 +1,351 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ChatFilter.cpp
+ * @brief ChatFilter.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "ChatFilter.h"
+#include "DebugHelper.h"
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+ChatFilter::ChatFilter()
+    : _automaton(), _maskedCount(0)
+{
+    LOG_DEBUG("ChatFilter 객체를 생성합니다.");
+}
+
+ChatFilter::~ChatFilter()
+{
+    LOG_DEBUG("ChatFilter 객체를 삭제합니다.");
+}
+
+ChatFilter::Result ChatFilter::loadFile(const std::string& file_path)
+{
+    std::ifstream in(file_path, std::ios::in | std::ios::binary);
+    if (in.is_open() == false)
+    {
+        LOG_ERROR("금칙어 파일을 열 수 없습니다: " + file_path);
+        return (ChatFilter::Result::FAIL_OPEN);
+    }
+
+    std::vector<std::string> words;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // 메모장으로 저장한 파일의 BOM과 CRLF를 지웁니다.
+        if (words.empty() && line.rfind("\xEF\xBB\xBF", 0) == 0)
+        {
+            line.erase(0, 3);
+        }
+        if (line.empty() == false && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        words.push_back(line);
+    }
+
+    this->setWords(words);
+    return (ChatFilter::Result::SUCCESS);
+}
+
+void ChatFilter::setWords(const std::vector<std::string>& words)
+{
+    std::shared_ptr<const ChatFilter::Automaton> automaton = ChatFilter::compile(words);
+    LOG_INFO("금칙어 목록을 적용합니다. 단어: " + std::to_string((automaton != nullptr) ? automaton->wordCount : 0)
+        + "개, 더블 어레이 칸: " + std::to_string((automaton != nullptr) ? automaton->slots.size() : 0) + "개");
+
+    // 컴파일이 끝난 뒤 포인터만 바꿉니다. 이전 오토마톤은 마지막 사용자가 놓을 때 해제됩니다.
+    this->_automaton.store(std::move(automaton), std::memory_order_release);
+}
+
+bool ChatFilter::apply(std::string& text, std::size_t offset)
+{
+    std::shared_ptr<const ChatFilter::Automaton> automaton = this->_automaton.load(std::memory_order_acquire);
+    if (automaton == nullptr || offset >= text.size())
+    {
+        return (false);
+    }
+
+    const ChatFilter::Slot* slots = automaton->slots.data();
+    const ChatFilter::Output* outputs = automaton->outputs.data();
+    std::int32_t slot_count = (std::int32_t)automaton->slots.size();
+
+    // 찾은 구간 [시작, 끝). 끝 위치 순으로 생기므로 겹치는 구간은 바로 합칩니다.
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    std::int32_t state = 0;
+    for (std::size_t i = offset; i < text.size(); ++i)
+    {
+        unsigned char byte = ChatFilter::foldByte((unsigned char)text[i]);
+        while (true)
+        {
+            std::int32_t next = slots[state].base + byte;
+            if (next < slot_count && slots[next].check == state)
+            {
+                state = next;
+                break;
+            }
+            if (state == 0)
+            {
+                break;
+            }
+            state = outputs[state].fail;
+        }
+
+        std::int32_t length = outputs[state].length;
+        if (length == 0)
+        {
+            continue;
+        }
+
+        std::size_t start = i + 1 - (std::size_t)length;
+        std::size_t end = i + 1;
+        while (ranges.empty() == false && start <= ranges.back().second)
+        {
+            start = std::min(start, ranges.back().first);
+            ranges.pop_back();
+        }
+        ranges.emplace_back(start, end);
+    }
+
+    if (ranges.empty())
+    {
+        return (false);
+    }
+
+    // 가린 구간은 글자마다 '*' 하나로 줄입니다. (UTF-8 이어지는 바이트 10xxxxxx는 건너뜁니다.)
+    std::string masked;
+    masked.reserve(text.size());
+    std::size_t copied = 0;
+    for (const std::pair<std::size_t, std::size_t>& range : ranges)
+    {
+        masked.append(text, copied, range.first - copied);
+        for (std::size_t i = range.first; i < range.second; ++i)
+        {
+            if (((unsigned char)text[i] & 0xC0) != 0x80)
+            {
+                masked.push_back('*');
+            }
+        }
+        copied = range.second;
+    }
+    masked.append(text, copied, std::string::npos);
+    text.swap(masked);
+
+    this->_maskedCount.fetch_add(1, std::memory_order_relaxed);
+    return (true);
+}
+
+std::size_t ChatFilter::getWordCount() const
+{
+    std::shared_ptr<const ChatFilter::Automaton> automaton = this->_automaton.load(std::memory_order_acquire);
+    return ((automaton != nullptr) ? automaton->wordCount : 0);
+}
+
+std::uint64_t ChatFilter::getMaskedCount() const
+{
+    return (this->_maskedCount.load(std::memory_order_relaxed));
+}
+
+std::shared_ptr<const ChatFilter::Automaton> ChatFilter::compile(const std::vector<std::string>& words)
+{
+    // 1. 트라이. 자식은 (바이트, 노드) 목록으로 두고 바이트 순으로 정렬합니다.
+    std::vector<std::vector<std::pair<unsigned char, std::int32_t>>> children(1);
+    std::vector<std::int32_t> terminal_length(1, 0);
+    std::size_t word_count = 0;
+
+    for (const std::string& word : words)
+    {
+        if (word.empty() || word.size() > ChatFilter::MAX_WORD_LENGTH)
+        {
+            continue;
+        }
+
+        std::int32_t node = 0;
+        for (char raw : word)
+        {
+            unsigned char byte = ChatFilter::foldByte((unsigned char)raw);
+            std::vector<std::pair<unsigned char, std::int32_t>>& edges = children[node];
+            auto it = std::lower_bound(edges.begin(), edges.end(), std::make_pair(byte, (std::int32_t)0));
+            if (it != edges.end() && it->first == byte)
+            {
+                node = it->second;
+                continue;
+            }
+
+            std::int32_t child = (std::int32_t)children.size();
+            edges.insert(it, std::make_pair(byte, child));
+            children.emplace_back();
+            terminal_length.push_back(0);
+            node = child;
+        }
+        if (terminal_length[node] == 0)
+        {
+            word_count = word_count + 1;
+        }
+        terminal_length[node] = (std::int32_t)word.size();
+    }
+
+    if (word_count == 0)
+    {
+        return (nullptr);
+    }
+
+    // 2. 너비 우선으로 노드마다 자식 칸이 모두 비어 있는 base를 찾아 더블 어레이에 배치합니다.
+    std::shared_ptr<ChatFilter::Automaton> automaton = std::make_shared<ChatFilter::Automaton>();
+    std::vector<ChatFilter::Slot>& slots = automaton->slots;
+    std::vector<std::int32_t> slot_of(children.size(), -1);
+    std::vector<std::int32_t> order;
+    order.reserve(children.size());
+
+    // 빈 칸은 양방향 목록으로 이어 두어, 꽉 찬 구간을 한 칸씩 훑지 않고 빈 칸만 후보로 봅니다. (칸 0은 루트, 목록의 머리 표시로도 씁니다.)
+    std::vector<std::int32_t> next_free;
+    std::vector<std::int32_t> prev_free;
+    auto grow = [&](std::size_t size)
+    {
+        std::size_t old_size = slots.size();
+        if (size <= old_size)
+        {
+            return ;
+        }
+        slots.resize(size, { 0, -1 });
+        next_free.resize(size);
+        prev_free.resize(size);
+
+        std::int32_t tail = (old_size == 0) ? 0 : prev_free[0];
+        for (std::size_t i = std::max(old_size, (std::size_t)1); i < size; ++i)
+        {
+            next_free[tail] = (std::int32_t)i;
+            prev_free[i] = tail;
+            tail = (std::int32_t)i;
+        }
+        next_free[tail] = 0;
+        prev_free[0] = tail;
+    };
+    auto take = [&](std::int32_t position)
+    {
+        next_free[prev_free[position]] = next_free[position];
+        prev_free[next_free[position]] = prev_free[position];
+    };
+
+    grow(256 + 1);
+    slots[0].check = 0;
+    slot_of[0] = 0;
+    order.push_back(0);
+
+    for (std::size_t head = 0; head < order.size(); ++head)
+    {
+        std::int32_t node = order[head];
+        std::int32_t slot = slot_of[node];
+        const std::vector<std::pair<unsigned char, std::int32_t>>& edges = children[node];
+        if (edges.empty())
+        {
+            continue;
+        }
+
+        // 첫 자식을 빈 칸 하나에 맞춰 보고 나머지 자식 칸도 비어 있는지 확인합니다.
+        std::int32_t base = 0;
+        std::int32_t candidate = next_free[0];
+        while (true)
+        {
+            if (candidate == 0)
+            {
+                candidate = (std::int32_t)slots.size();
+                grow(slots.size() + 256);
+            }
+
+            base = candidate - (std::int32_t)edges.front().first;
+            if (base >= 1)
+            {
+                grow((std::size_t)base + 256);
+
+                bool fits = true;
+                for (const std::pair<unsigned char, std::int32_t>& edge : edges)
+                {
+                    if (slots[base + edge.first].check != -1)
+                    {
+                        fits = false;
+                        break;
+                    }
+                }
+                if (fits)
+                {
+                    break;
+                }
+            }
+            candidate = next_free[candidate];
+        }
+
+        slots[slot].base = base;
+        for (const std::pair<unsigned char, std::int32_t>& edge : edges)
+        {
+            std::int32_t child_slot = base + edge.first;
+            slots[child_slot].check = slot;
+            take(child_slot);
+            slot_of[edge.second] = child_slot;
+            order.push_back(edge.second);
+        }
+    }
+
+    // 뒤쪽의 쓰지 않는 칸을 잘라 냅니다. 검사 시 범위를 넘는 전이는 실패로 봅니다.
+    std::size_t used = slots.size();
+    while (used > 1 && slots[used - 1].check == -1)
+    {
+        used = used - 1;
+    }
+    slots.resize(used);
+    slots.shrink_to_fit();
+
+    // 3. 너비 우선 순서대로 실패 링크와 출력 길이를 구합니다. 출력은 실패 링크 쪽의 더 짧은 단어도 덮도록 최댓값을 물려받습니다.
+    std::vector<ChatFilter::Output>& outputs = automaton->outputs;
+    outputs.assign(slots.size(), { 0, 0 });
+    for (std::int32_t node : order)
+    {
+        std::int32_t slot = slot_of[node];
+        for (const std::pair<unsigned char, std::int32_t>& edge : children[node])
+        {
+            std::int32_t child_slot = slot_of[edge.second];
+            std::int32_t fail = 0;
+            if (slot != 0)
+            {
+                std::int32_t candidate = outputs[slot].fail;
+                while (true)
+                {
+                    std::int32_t next = slots[candidate].base + edge.first;
+                    if (next < (std::int32_t)slots.size() && slots[next].check == candidate)
+                    {
+                        fail = next;
+                        break;
+                    }
+                    if (candidate == 0)
+                    {
+                        break;
+                    }
+                    candidate = outputs[candidate].fail;
+                }
+            }
+            outputs[child_slot].fail = fail;
+            outputs[child_slot].length = std::max(terminal_length[edge.second], outputs[fail].length);
+        }
+    }
+
+    automaton->wordCount = word_count;
+    return (automaton);
+}
+
+unsigned char ChatFilter::foldByte(unsigned char byte)
+{
+    if (byte >= 'A' && byte <= 'Z')
+    {
+        return ((unsigned char)(byte - 'A' + 'a'));
+    }
+    return (byte);
+}
@@ -0,0 +1,166 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file ChatFilter.h
+ * @brief 금칙어 목록을 Aho-Corasick 오토마톤으로 컴파일해 채팅을 한 번의 훑기로 가리는 ChatFilter 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 금칙어는 UTF-8 바이트열 그대로 트라이에 넣고, 트라이를 더블 어레이(base/check)로 옮긴 뒤 실패 링크를 붙입니다.
+ * <br>메시지는 바이트마다 전이 한 번(실패 시 실패 링크를 따라감)으로 훑으므로, 검사 시간은 금칙어 수와 관계없이 메시지 길이에 비례합니다.
+ * <br>찾은 금칙어는 글자(코드 포인트)마다 '*' 하나로 바꿉니다. 영문은 대소문자를 구분하지 않습니다.
+ * <br>컴파일된 오토마톤은 바뀌지 않으며, 새 목록은 별도로 컴파일한 뒤 원자적 포인터 교체로 적용합니다.
+ * <br>따라서 다른 스레드에서 목록을 다시 읽어도 서버 루프는 멈추지 않고, 진행 중인 검사는 이전 오토마톤으로 끝납니다.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class ChatFilter
+ * @brief 현재 오토마톤을 원자적 shared_ptr로 들고 있다가 메시지의 금칙어를 가리는 클래스입니다.
+ *
+ * @note apply()는 채팅방 작업자처럼 여러 스레드에서 동시에 호출할 수 있고, setWords()/loadFile()도 어느 스레드에서나 호출할 수 있습니다.
+ */
+class ChatFilter
+{
+public:
+    /// 금칙어 하나의 최대 길이(바이트). 더 긴 단어는 무시합니다.
+    static constexpr std::size_t MAX_WORD_LENGTH = 255;
+
+public:
+    /**
+     * @enum ChatFilter::Result
+     * @brief loadFile()의 반환값.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 읽고 적용함.
+        FAIL_OPEN       ///< 파일을 열 수 없음 (기존 목록을 유지합니다).
+    };
+
+public:
+    /**
+     * @fn ChatFilter::ChatFilter()
+     * @brief 금칙어가 없는 필터를 생성합니다.
+     * @return 없음.
+     */
+    ChatFilter();
+
+    /**
+     * @fn ChatFilter::~ChatFilter()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~ChatFilter();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    ChatFilter(const ChatFilter& obj) = delete;
+    ChatFilter& operator=(const ChatFilter& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    ChatFilter(ChatFilter&& obj) = delete;
+    ChatFilter& operator=(ChatFilter&& obj) = delete;
+
+public:
+    /**
+     * @fn ChatFilter::Result ChatFilter::loadFile(const std::string& file_path)
+     * @brief UTF-8 텍스트 파일에서 한 줄에 하나씩 금칙어를 읽어 적용합니다.
+     * @param[IN] const std::string& file_path : 금칙어 파일 경로.
+     * @return ChatFilter::Result : 결과 코드.
+     * @note 빈 줄과 '#'으로 시작하는 줄은 건너뜁니다. 줄 끝의 '\r'은 지웁니다.
+     */
+    ChatFilter::Result loadFile(const std::string& file_path);
+
+    /**
+     * @fn void ChatFilter::setWords(const std::vector<std::string>& words)
+     * @brief 금칙어 목록을 컴파일해 현재 오토마톤과 바꿉니다.
+     * @param[IN] const std::vector<std::string>& words : UTF-8 금칙어 목록 (빈 목록이면 필터를 끕니다).
+     * @return 없음.
+     */
+    void setWords(const std::vector<std::string>& words);
+
+    /**
+     * @fn bool ChatFilter::apply(std::string& text, std::size_t offset)
+     * @brief 문자열의 offset 이후에서 금칙어를 찾아 글자마다 '*'로 바꿉니다.
+     * @param[IN, OUT] std::string& text : 검사할 문자열.
+     * @param[IN] std::size_t offset : 검사를 시작할 위치 (기본값 0). 닉네임 같은 머리말을 건너뛸 때 사용합니다.
+     * @return bool : 가린 부분이 있으면 true.
+     */
+    bool apply(std::string& text, std::size_t offset = 0);
+
+    /**
+     * @fn std::size_t ChatFilter::getWordCount() const
+     * @brief 현재 적용된 금칙어 수를 반환합니다.
+     * @return std::size_t : 금칙어 수.
+     */
+    std::size_t getWordCount() const;
+
+    /**
+     * @fn std::uint64_t ChatFilter::getMaskedCount() const
+     * @brief 금칙어를 가린 메시지 수를 반환합니다.
+     * @return std::uint64_t : 가린 메시지 수.
+     */
+    std::uint64_t getMaskedCount() const;
+
+private:
+    /**
+     * @struct ChatFilter::Slot
+     * @brief 더블 어레이의 칸 하나. 전이 t = base[s] + 바이트 가 check[t] == s 일 때만 유효합니다.
+     */
+    struct Slot
+    {
+        std::int32_t base;      ///< 이 상태의 자식 전이가 시작하는 위치.
+        std::int32_t check;     ///< 이 칸을 차지한 부모 상태 (비어 있으면 -1).
+    };
+
+    /**
+     * @struct ChatFilter::Output
+     * @brief 상태 하나의 실패 링크와 출력.
+     */
+    struct Output
+    {
+        std::int32_t fail;      ///< 실패 링크 (가장 긴 접미사 상태).
+        std::int32_t length;    ///< 이 상태에서 끝나는 가장 긴 금칙어의 길이(바이트), 없으면 0.
+    };
+
+    /**
+     * @struct ChatFilter::Automaton
+     * @brief 컴파일된 오토마톤. 만든 뒤에는 바뀌지 않습니다.
+     */
+    struct Automaton
+    {
+        std::vector<ChatFilter::Slot> slots;        ///< 더블 어레이 (상태 번호 = 칸 위치, 루트는 0).
+        std::vector<ChatFilter::Output> outputs;    ///< 칸 위치별 실패 링크와 출력.
+        std::size_t wordCount;                      ///< 컴파일한 금칙어 수.
+    };
+
+private:
+    /// 현재 오토마톤 (없으면 필터를 쓰지 않음).
+    std::atomic<std::shared_ptr<const ChatFilter::Automaton>> _automaton;
+
+    /// 금칙어를 가린 메시지 수.
+    std::atomic<std::uint64_t> _maskedCount;
+
+private:
+    /**
+     * @fn static std::shared_ptr<const ChatFilter::Automaton> ChatFilter::compile(const std::vector<std::string>& words)
+     * @brief 금칙어 목록을 트라이로 만든 뒤 더블 어레이와 실패 링크로 컴파일합니다.
+     * @param[IN] const std::vector<std::string>& words : 금칙어 목록.
+     * @return std::shared_ptr<const ChatFilter::Automaton> : 오토마톤, 유효한 단어가 없으면 nullptr.
+     */
+    static std::shared_ptr<const ChatFilter::Automaton> compile(const std::vector<std::string>& words);
+
+    /**
+     * @fn static unsigned char ChatFilter::foldByte(unsigned char byte)
+     * @brief 영문 대문자를 소문자로 바꿉니다. 나머지 바이트(한글의 UTF-8 바이트 포함)는 그대로 둡니다.
+     * @param[IN] unsigned char byte : 바이트.
+     * @return unsigned char : 바꾼 바이트.
+     */
+    static unsigned char foldByte(unsigned char byte);
+};
@@ -9,29 +9,34 @@
 
 #include "ClientManager.h"
 #include "DebugHelper.h"
+#include "TransportInstances.h"
 
-ClientManager::ClientManager()
-    : _clientSockets(), _availableList(), _connectedSocketCount(0)
+template <typename Transport>
+ClientManager<Transport>::ClientManager(Transport& transport)
+    : _transport(transport), _clientSockets(), _socketMask(), _joinedMask(), _stateFlags(), _lastActivityTicks(), _tokenCounts(), _queueDepths(),
+      _coldInfos(), _availableList(), _connectedSocketCount(0)
 {
     initalizeClientSockets();
     initalizeAvailableList();
     LOG_DEBUG("ClientManager 객체를 생성합니다.");
 }
 
-ClientManager::~ClientManager()
+template <typename Transport>
+ClientManager<Transport>::~ClientManager()
 {
     // 클라이언트 소켓 배열 정리.
     for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
     {
         if (this->_clientSockets[i] != INVALID_SOCKET)
         {
-            closesocket(this->_clientSockets[i]);
+            this->_transport.closeSocket(this->_clientSockets[i]);
         }
     }
     LOG_DEBUG("ClientManager 객체를 삭제합니다.");
 }
 
-int ClientManager::addClient(SOCKET client_socket)
+template <typename Transport>
+int ClientManager<Transport>::addClient(SOCKET client_socket, const sockaddr_in& client_addr)
 {
     if (client_socket == INVALID_SOCKET)
     {
@@ -49,13 +54,22 @@ int ClientManager::addClient(SOCKET client_socket)
 
     // 클라이언트 소켓 저장.
     this->_clientSockets[index] = client_socket;
+    this->_socketMask.set(index);
+    this->_stateFlags[index] = ClientManager::FLAG_CONNECTED;
+    this->_lastActivityTicks[index] = 0;
+    this->_tokenCounts[index] = 0;
+    this->_queueDepths[index] = 0;
+    this->_coldInfos[index].nickname = "Player_" + std::to_string(index);
+    this->_coldInfos[index].address = client_addr;
+    this->_coldInfos[index].pendingInput.clear();
     this->_connectedSocketCount = this->_connectedSocketCount + 1;
 
     LOG_INFO("클라이언트 추가 성공(player_" + std::to_string(index) + ")\n" + std::to_string(this->_connectedSocketCount) + "명");
     return (index);
 }
 
-bool ClientManager::removeClient(int client_index)
+template <typename Transport>
+bool ClientManager<Transport>::removeClient(int client_index)
 {
     // 유효한 인덱스 범위인지를 체크.
     if (this->isValidIndex(client_index) == false)
@@ -64,6 +78,17 @@ bool ClientManager::removeClient(int client_index)
         return (false);
     }
 
+    // 일시 중단된 슬롯은 소켓이 이미 닫혀 있으므로 슬롯만 반환합니다.
+    if ((this->_stateFlags[client_index] & ClientManager::FLAG_SUSPENDED) != 0)
+    {
+        this->_stateFlags[client_index] = 0;
+        this->_coldInfos[client_index].nickname.clear();
+        this->_coldInfos[client_index].pendingInput.clear();
+        this->_availableList.push(client_index);
+        LOG_INFO("일시 중단된 클라이언트 제거 완료(player_" + std::to_string(client_index) + ")");
+        return (true);
+    }
+
     // 클라이언트가 연결되어 있는지 확인.
     if (this->_clientSockets[client_index] == INVALID_SOCKET)
     {
@@ -72,8 +97,14 @@ bool ClientManager::removeClient(int client_index)
     }
 
     // 소켓 정리.
-    closesocket(this->_clientSockets[client_index]);
+    this->_transport.closeSocket(this->_clientSockets[client_index]);
     this->_clientSockets[client_index] = INVALID_SOCKET;
+    this->_socketMask.reset(client_index);
+    this->_joinedMask.reset(client_index);
+    this->_stateFlags[client_index] = 0;
+    this->_queueDepths[client_index] = 0;
+    this->_coldInfos[client_index].nickname.clear();
+    this->_coldInfos[client_index].pendingInput.clear();
     this->_connectedSocketCount = this->_connectedSocketCount - 1;
 
     // 삭제한 소켓의 인덱스를 재사용 큐에 추가.
@@ -83,7 +114,69 @@ bool ClientManager::removeClient(int client_index)
     return (true);
 }
 
-SOCKET ClientManager::getClientSocket(int client_index) const
+template <typename Transport>
+bool ClientManager<Transport>::suspendClient(int client_index)
+{
+    if (this->isValidIndex(client_index) == false || this->_clientSockets[client_index] == INVALID_SOCKET)
+    {
+        LOG_WARN("클라이언트 일시 중단 실패: 유효하지 않은 인덱스 " + std::to_string(client_index));
+        return (false);
+    }
+
+    // 소켓은 닫지만 슬롯은 가용 목록에 돌려주지 않습니다.
+    this->_transport.closeSocket(this->_clientSockets[client_index]);
+    this->_clientSockets[client_index] = INVALID_SOCKET;
+    this->_socketMask.reset(client_index);
+    this->_joinedMask.reset(client_index);
+    this->_stateFlags[client_index] = (this->_stateFlags[client_index] & ~ClientManager::FLAG_CONNECTED) | ClientManager::FLAG_SUSPENDED;
+    this->_queueDepths[client_index] = 0;
+    this->_coldInfos[client_index].pendingInput.clear();
+    this->_connectedSocketCount = this->_connectedSocketCount - 1;
+
+    LOG_INFO("클라이언트 일시 중단(player_" + std::to_string(client_index) + ")\n남은 접속자: " + std::to_string(this->_connectedSocketCount) + "명");
+    return (true);
+}
+
+template <typename Transport>
+bool ClientManager<Transport>::transferClient(int from_index, int to_index)
+{
+    if (this->isValidIndex(from_index) == false || this->_clientSockets[from_index] == INVALID_SOCKET)
+    {
+        return (false);
+    }
+    if (this->isValidIndex(to_index) == false || (this->_stateFlags[to_index] & ClientManager::FLAG_SUSPENDED) == 0)
+    {
+        return (false);
+    }
+
+    // 이전 슬롯은 별칭을 유지한 채 새 소켓으로 다시 연결됩니다.
+    this->_clientSockets[to_index] = this->_clientSockets[from_index];
+    this->_socketMask.set(to_index);
+    this->_stateFlags[to_index] = (this->_stateFlags[to_index] & ~ClientManager::FLAG_SUSPENDED) | ClientManager::FLAG_CONNECTED;
+    if ((this->_stateFlags[to_index] & ClientManager::FLAG_JOINED) != 0)
+    {
+        this->_joinedMask.set(to_index);
+    }
+    this->_lastActivityTicks[to_index] = this->_lastActivityTicks[from_index];
+    this->_coldInfos[to_index].address = this->_coldInfos[from_index].address;
+    this->_coldInfos[to_index].pendingInput.swap(this->_coldInfos[from_index].pendingInput);
+
+    // 새 연결이 받았던 슬롯은 소켓을 닫지 않고 비웁니다.
+    this->_clientSockets[from_index] = INVALID_SOCKET;
+    this->_socketMask.reset(from_index);
+    this->_joinedMask.reset(from_index);
+    this->_stateFlags[from_index] = 0;
+    this->_queueDepths[from_index] = 0;
+    this->_coldInfos[from_index].nickname.clear();
+    this->_coldInfos[from_index].pendingInput.clear();
+    this->_availableList.push(from_index);
+
+    LOG_INFO("클라이언트 재접속(player_" + std::to_string(to_index) + ")\n" + std::to_string(this->_connectedSocketCount) + "명");
+    return (true);
+}
+
+template <typename Transport>
+SOCKET ClientManager<Transport>::getClientSocket(int client_index) const
 {
     if (this->isValidIndex(client_index) == false)
     {
@@ -93,17 +186,20 @@ SOCKET ClientManager::getClientSocket(int client_index) const
     return (this->_clientSockets[client_index]);
 }
 
-int ClientManager::getConnectedClientCount() const
+template <typename Transport>
+int ClientManager<Transport>::getConnectedClientCount() const
 {
     return (this->_connectedSocketCount);
 }
 
-bool ClientManager::isValidIndex(int client_index) const
+template <typename Transport>
+bool ClientManager<Transport>::isValidIndex(int client_index) const
 {
     return (client_index >= 0 && client_index < ClientManager::MAX_CLIENTS);
 }
 
-int ClientManager::getAllSockets(SOCKET* sockets, int max_count) const
+template <typename Transport>
+int ClientManager<Transport>::getAllSockets(SOCKET* sockets, int max_count) const
 {
     int count = 0;
 
@@ -119,7 +215,65 @@ int ClientManager::getAllSockets(SOCKET* sockets, int max_count) const
     return (count);
 }
 
-std::string ClientManager::getClientNickname(int client_index) const
+template <typename Transport>
+const ClientManagerBase::SessionMask& ClientManager<Transport>::getSocketMask() const
+{
+    return (this->_socketMask);
+}
+
+template <typename Transport>
+const ClientManagerBase::SessionMask& ClientManager<Transport>::getJoinedMask() const
+{
+    return (this->_joinedMask);
+}
+
+template <typename Transport>
+int ClientManager<Transport>::getJoinedSockets(SOCKET* sockets, int max_count) const
+{
+    return (this->getMaskedSockets(this->_joinedMask, sockets, max_count));
+}
+
+template <typename Transport>
+int ClientManager<Transport>::getJoinedClientCount() const
+{
+    return (this->_joinedMask.count());
+}
+
+template <typename Transport>
+int ClientManager<Transport>::getMaskedSockets(const ClientManager::SessionMask& mask, SOCKET* sockets, int max_count) const
+{
+    int count = 0;
+
+    ClientManager::SessionMask connected = mask;
+    connected.intersect(this->_socketMask);
+    connected.forEach([this, sockets, max_count, &count](int slot)
+    {
+        if (count < max_count)
+        {
+            sockets[count] = this->_clientSockets[slot];
+            count = count + 1;
+        }
+    });
+
+    return (count);
+}
+
+template <typename Transport>
+int ClientManager<Transport>::findClient(const std::string& nickname) const
+{
+    for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
+    {
+        if (this->_stateFlags[i] != 0 && this->_coldInfos[i].nickname == nickname)
+        {
+            return (i);
+        }
+    }
+
+    return (-1);
+}
+
+template <typename Transport>
+std::string ClientManager<Transport>::getClientNickname(int client_index) const
 {
     // 유효하지 않은 인덱스 범위이거나.
     if (this->isValidIndex(client_index) == false)
@@ -127,27 +281,187 @@ std::string ClientManager::getClientNickname(int client_index) const
         return ("Player_Unknown");
     }
 
-    // 해당 소켓이 유효하지 않다면
-    if (this->_clientSockets[client_index] == INVALID_SOCKET)
+    // 사용 중인 슬롯이 아니라면 (일시 중단된 슬롯은 별칭을 유지합니다)
+    if (this->_stateFlags[client_index] == 0)
     {
         return ("Player_Unknown");
     }
 
-    // 항상 Player_{NUMBER} 형식으로 반환.
-    return ("Player_" + std::to_string(client_index));
+    // 추가될 때 부여된 Player_{NUMBER} 형식의 별칭을 반환.
+    return (this->_coldInfos[client_index].nickname);
+}
+
+template <typename Transport>
+bool ClientManager<Transport>::getClientAddress(int client_index, sockaddr_in& client_addr) const
+{
+    if (this->isValidIndex(client_index) == false || this->_clientSockets[client_index] == INVALID_SOCKET)
+    {
+        return (false);
+    }
+
+    client_addr = this->_coldInfos[client_index].address;
+    return (true);
+}
+
+template <typename Transport>
+std::string& ClientManager<Transport>::getPendingInput(int client_index)
+{
+    return (this->_coldInfos[client_index].pendingInput);
+}
+
+template <typename Transport>
+void ClientManager<Transport>::setStateFlag(int client_index, std::uint8_t flag)
+{
+    if (this->isValidIndex(client_index))
+    {
+        this->_stateFlags[client_index] = this->_stateFlags[client_index] | flag;
+        if ((flag & ClientManager::FLAG_JOINED) != 0 && this->_clientSockets[client_index] != INVALID_SOCKET)
+        {
+            this->_joinedMask.set(client_index);
+        }
+    }
+}
+
+template <typename Transport>
+void ClientManager<Transport>::clearStateFlag(int client_index, std::uint8_t flag)
+{
+    if (this->isValidIndex(client_index))
+    {
+        this->_stateFlags[client_index] = this->_stateFlags[client_index] & (std::uint8_t)~flag;
+        if ((flag & ClientManager::FLAG_JOINED) != 0)
+        {
+            this->_joinedMask.reset(client_index);
+        }
+    }
+}
+
+template <typename Transport>
+bool ClientManager<Transport>::hasStateFlag(int client_index, std::uint8_t flag) const
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return (false);
+    }
+
+    return ((this->_stateFlags[client_index] & flag) == flag);
+}
+
+template <typename Transport>
+void ClientManager<Transport>::touchActivity(int client_index, std::int64_t now_tick)
+{
+    if (this->isValidIndex(client_index))
+    {
+        this->_lastActivityTicks[client_index] = now_tick;
+    }
+}
+
+template <typename Transport>
+std::int64_t ClientManager<Transport>::getLastActivityTick(int client_index) const
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return (0);
+    }
+
+    return (this->_lastActivityTicks[client_index]);
+}
+
+template <typename Transport>
+bool ClientManager<Transport>::consumeToken(int client_index)
+{
+    if (this->isValidIndex(client_index) == false || this->_tokenCounts[client_index] <= 0)
+    {
+        return (false);
+    }
+
+    this->_tokenCounts[client_index] = this->_tokenCounts[client_index] - 1;
+    return (true);
+}
+
+template <typename Transport>
+void ClientManager<Transport>::refillTokens(std::int32_t amount, std::int32_t max_tokens)
+{
+    // 빈 슬롯의 토큰도 함께 갱신하여 분기 없이 배열을 한 번 훑습니다 (addClient에서 0으로 초기화됨).
+    for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
+    {
+        std::int32_t tokens = this->_tokenCounts[i] + amount;
+        this->_tokenCounts[i] = (tokens < max_tokens) ? tokens : max_tokens;
+    }
+}
+
+template <typename Transport>
+void ClientManager<Transport>::addQueueDepth(int client_index, std::int32_t delta)
+{
+    if (this->isValidIndex(client_index))
+    {
+        this->_queueDepths[client_index] = this->_queueDepths[client_index] + delta;
+    }
+}
+
+template <typename Transport>
+std::int32_t ClientManager<Transport>::getQueueDepth(int client_index) const
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return (0);
+    }
+
+    return (this->_queueDepths[client_index]);
+}
+
+template <typename Transport>
+int ClientManager<Transport>::collectIdleClients(std::int64_t now_tick, std::int64_t idle_ticks, int* indices, int max_count) const
+{
+    int count = 0;
+
+    for (int i = 0; i < ClientManager::MAX_CLIENTS && count < max_count; ++i)
+    {
+        if ((this->_stateFlags[i] & ClientManager::FLAG_CONNECTED) != 0 && now_tick - this->_lastActivityTicks[i] >= idle_ticks)
+        {
+            indices[count] = i;
+            count = count + 1;
+        }
+    }
+
+    return (count);
+}
+
+template <typename Transport>
+int ClientManager<Transport>::collectBackloggedClients(std::int32_t threshold, int* indices, int max_count) const
+{
+    int count = 0;
+
+    // 빈 슬롯의 큐 깊이는 항상 0이므로 소켓 배열을 읽지 않아도 됩니다.
+    for (int i = 0; i < ClientManager::MAX_CLIENTS && count < max_count; ++i)
+    {
+        if (this->_queueDepths[i] > threshold)
+        {
+            indices[count] = i;
+            count = count + 1;
+        }
+    }
+
+    return (count);
 }
 
-void ClientManager::initalizeClientSockets()
+template <typename Transport>
+void ClientManager<Transport>::initalizeClientSockets()
 {
     // 클라이언트 소켓배열의 요소들을 INVALID_SOCKET으로 초기화합니다.
     for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
     {
         this->_clientSockets[i] = INVALID_SOCKET;
+        this->_stateFlags[i] = 0;
+        this->_lastActivityTicks[i] = 0;
+        this->_tokenCounts[i] = 0;
+        this->_queueDepths[i] = 0;
+        this->_coldInfos[i].address = {};
     }
     LOG_DEBUG("클라이언트 소켓을 완료.");
 }
 
-void ClientManager::initalizeAvailableList()
+template <typename Transport>
+void ClientManager<Transport>::initalizeAvailableList()
 {
     // 우선순위 큐에 0~9까지 숫자를 넣어놓습니다.
     for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
@@ -157,7 +471,8 @@ void ClientManager::initalizeAvailableList()
     LOG_DEBUG("사용 가능한 인덱스 큐 초기화 완료.");
 }
 
-int ClientManager::getNextIndex()
+template <typename Transport>
+int ClientManager<Transport>::getNextIndex()
 {
     // 우선 순위 큐가 비었다면.
     if (this->_availableList.empty())
@@ -170,3 +485,5 @@ int ClientManager::getNextIndex()
 
     return (index);
 }
+
+INSTANTIATE_COMPONENT_TRANSPORTS(ClientManager);
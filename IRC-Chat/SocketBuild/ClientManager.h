@@ -7,42 +7,88 @@
  * @details
  * 클라이언트 연결 관리 기능: 새로운 클라이언트 추가, 클라이언트 제거, 소켓 조회,
  * 고유한 닉네임(예: "Player_1") 생성 등을 수행합니다.
+ * <br>세션 데이터는 구조체 배열(AoS)이 아닌 배열 구조체(SoA)로 저장합니다.
+ * <br>주기적인 전체 스캔(유휴 검사, 토큰 충전, 큐 깊이 검사)이 읽는 필드는 조밀한 병렬 배열에,
+ * <br>닉네임과 주소처럼 드물게 읽는 필드는 별도의 배열에 둡니다.
  */
 
 #pragma once
 
 #pragma execution_character_set("utf-8")
 
-#include <WinSock2.h>
+#include "NetworkTransport.h"
+#include "SlotMask.h"
 #include <array>
+#include <cstdint>
 #include <string>
 #include <queue>
 
+#ifndef CHAT_MAX_CLIENTS
+/// @brief ClientManagerBase::MAX_CLIENTS의 기본값. 벤치마크 빌드(SocketTests)는 전처리기 정의로 늘립니다. 64를 넘기면 FD_SETSIZE도 함께 늘려야 select가 모든 소켓을 다룹니다.
+#define CHAT_MAX_CLIENTS 10
+#endif
+
+/**
+ * @class ClientManagerBase
+ * @brief 전송 계층과 무관한 ClientManager의 상수와 타입을 담습니다.
+ *
+ * @note 전송 계층마다 ClientManager 인스턴스가 달라도 슬롯 수와 플래그는 하나이므로, 바깥에서는 ClientManagerBase::MAX_CLIENTS처럼 씁니다.
+ */
+class ClientManagerBase
+{
+	public:
+		
+		/// @brief 서버에서 동시에 관리할 수 있는 최대 클라이언트 수입니다.
+		static const int MAX_CLIENTS = CHAT_MAX_CLIENTS;
+
+		/// @brief 슬롯에 연결된 클라이언트가 있음을 나타내는 상태 플래그.
+		static const std::uint8_t FLAG_CONNECTED = 0x01;
+
+		/// @brief 접속 절차(환영 메시지, 참가 알림)를 마친 클라이언트임을 나타내는 상태 플래그.
+		static const std::uint8_t FLAG_JOINED = 0x02;
+
+		/// @brief 연결은 끊겼지만 재접속을 기다리며 슬롯과 별칭을 유지 중임을 나타내는 상태 플래그.
+		static const std::uint8_t FLAG_SUSPENDED = 0x04;
+
+		/// @brief 채팅 금지(/mute)를 쓸 수 있는 운영자임을 나타내는 상태 플래그.
+		static const std::uint8_t FLAG_MODERATOR = 0x08;
+
+		/// @brief 접속자 목록 바이너리 프레임(/roster)을 받기로 한 클라이언트임을 나타내는 상태 플래그.
+		static const std::uint8_t FLAG_PRESENCE = 0x10;
+
+		/// @brief 슬롯 번호의 집합 (팬아웃 대상, 무시 목록 등).
+		using SessionMask = SlotMask<MAX_CLIENTS>;
+};
+
 /**
  * @class ClientManager
  * @brief 서버에서 고정된 수의 클라이언트 소켓과 별칭을 관리하는 클래스입니다.
+ * @tparam Transport : 클라이언트 소켓을 닫을 때 사용할 전송 계층 타입.
  *
  * @details
  * 이 클래스는 클라이언트 연결 추가/제거, 활성 소켓 추적,
  * 각 클라이언트에 고유 별칭 할당을 담당합니다.<br>
  * 최대 MAX_CLIENTS개의 클라이언트를 동시 관리할 수 있습니다.
+ *
+ * 자주 스캔되는 필드(hot)는 필드마다 하나의 배열로 저장됩니다.
+ * - 소켓, 상태 플래그, 마지막 활동 시각, 토큰 수, 송신 대기 큐 깊이.
+ *
+ * 스캔에서는 필요한 배열만 순서대로 읽으므로, 세션이 커져도 캐시 라인에 다른 필드가 섞이지 않습니다.
+ * <br>드물게 읽는 필드(cold)는 ColdClientInfo 배열에 따로 둡니다.
  */
-class ClientManager
+template <typename Transport>
+class ClientManager : public ClientManagerBase
 {
-	public:
-		
-		/// @brief 서버에서 동시에 관리할 수 있는 최대 클라이언트 수입니다.
-		static const int MAX_CLIENTS = 10;
-
 	public:
 
 		/**
-		 * @fn ClientManager::ClientManager()
+		 * @fn ClientManager::ClientManager(Transport& transport)
 		 * @brief ClientManager를 생성하고 내부 데이터를 초기화합니다.
+		 * @param[IN] Transport& transport : 클라이언트 소켓을 닫을 때 사용할 전송 계층.
 		 * @note 클라이언트 소켓 배열과 사용 가능한 인덱스 목록을 초기화합니다.<br>
 		 *       모든 클라이언트 슬롯은 초기에는 비어 있습니다.
 		 */
-		ClientManager();
+		explicit ClientManager(Transport& transport);
 
 		/**
 		 * @fn ClientManager::~ClientManager()
@@ -63,13 +109,14 @@ class ClientManager
 	public:
 
 		/**
-		 * @fn int ClientManager::addClient(SOCKET client_socket)
+		 * @fn int ClientManager::addClient(SOCKET client_socket, const sockaddr_in& client_addr)
 		 * @brief 새로운 클라이언트 소켓을 관리자에 추가하고 별칭을 할당합니다.
 		 * @param[IN] SOCKET client_socket : 추가할 클라이언트 소켓 (accept된 연결 소켓).
+		 * @param[IN(default : {})] const sockaddr_in& client_addr : 클라이언트의 네트워크 주소.
 		 * @return int : 새 클라이언트에 할당된 인덱스(0 ~ MAX_CLIENTS-1), 추가 실패 시 -1.
 		 * @note 클라이언트에게 "Player_{N}" 형식의 별칭이 부여됩니다 (N은 인덱스).
 		 */
-		int addClient(SOCKET client_socket);
+		int addClient(SOCKET client_socket, const sockaddr_in& client_addr = {});
 
 
 		/**
@@ -77,9 +124,29 @@ class ClientManager
 		 * @brief 지정한 인덱스의 클라이언트 소켓을 제거합니다.
 		 * @param[IN] int client_index : 제거할 클라이언트의 인덱스.
 		 * @return bool : 제거에 성공하면 true, 인덱스가 잘못되었거나 실패 시 false.
+		 * @note 일시 중단된 슬롯이면 (소켓은 이미 닫혔으므로) 슬롯만 반환합니다.
 		 */
 		bool removeClient(int client_index);
 
+		/**
+		 * @fn bool ClientManager::suspendClient(int client_index)
+		 * @brief 클라이언트 소켓을 닫되 슬롯과 별칭은 재접속을 위해 유지합니다.
+		 * @param[IN] int client_index : 일시 중단할 클라이언트의 인덱스.
+		 * @return bool : 성공하면 true, 연결된 클라이언트가 아니면 false.
+		 * @note 일시 중단된 슬롯은 removeClient()가 호출될 때까지 새 연결에 할당되지 않습니다.
+		 */
+		bool suspendClient(int client_index);
+
+		/**
+		 * @fn bool ClientManager::transferClient(int from_index, int to_index)
+		 * @brief 새 연결의 소켓을 일시 중단된 슬롯으로 옮겨 이전 별칭으로 이어 붙입니다.
+		 * @param[IN] int from_index : 새 연결이 할당받은 인덱스 (옮긴 뒤 빈 슬롯이 됩니다).
+		 * @param[IN] int to_index : 일시 중단된 이전 세션의 인덱스.
+		 * @return bool : 성공하면 true, from_index가 연결되어 있지 않거나 to_index가 일시 중단 상태가 아니면 false.
+		 * @note 소켓은 닫지 않고 그대로 옮깁니다.
+		 */
+		bool transferClient(int from_index, int to_index);
+
 		/**
 		 * @fn SOCKET ClientManager::getClientSocket(int client_index) const
 		 * @brief 주어진 클라이언트 인덱스에 대한 소켓을 가져옵니다.
@@ -113,6 +180,57 @@ class ClientManager
 		 */
 		int getAllSockets(SOCKET* sockets, int max_count) const;
 
+		/**
+		 * @fn const ClientManager::SessionMask& ClientManager::getSocketMask() const
+		 * @brief 소켓이 연결된 슬롯의 집합을 반환합니다.
+		 * @return const ClientManager::SessionMask& : 연결된 슬롯 집합 (일시 중단된 슬롯은 빠집니다).
+		 */
+		const ClientManager::SessionMask& getSocketMask() const;
+
+		/**
+		 * @fn const ClientManager::SessionMask& ClientManager::getJoinedMask() const
+		 * @brief 입장 절차(환영 메시지와 참가 알림)를 마친 연결 슬롯의 집합을 반환합니다.
+		 * @return const ClientManager::SessionMask& : 입장한 슬롯 집합.
+		 * @note 방송 대상은 이 집합으로 정합니다. 재접속 대기 중인 새 연결은 아직 빠져 있습니다.
+		 */
+		const ClientManager::SessionMask& getJoinedMask() const;
+
+		/**
+		 * @fn int ClientManager::getJoinedSockets(SOCKET* sockets, int max_count) const
+		 * @brief 입장 절차를 마친 클라이언트의 소켓만 배열에 복사합니다.
+		 * @param[OUT] SOCKET* sockets : 클라이언트 소켓 핸들을 저장할 배열.
+		 * @param[IN] int max_count : 배열이 담을 수 있는 최대 소켓 개수.
+		 * @return int : 실제 배열에 복사된 클라이언트 소켓의 개수.
+		 */
+		int getJoinedSockets(SOCKET* sockets, int max_count) const;
+
+		/**
+		 * @fn int ClientManager::getJoinedClientCount() const
+		 * @brief 입장 절차를 마친 클라이언트 수를 반환합니다.
+		 * @return int : 입장한 클라이언트 수.
+		 */
+		int getJoinedClientCount() const;
+
+		/**
+		 * @fn int ClientManager::getMaskedSockets(const ClientManager::SessionMask& mask, SOCKET* sockets, int max_count) const
+		 * @brief 주어진 집합 중 소켓이 연결된 슬롯의 소켓만 배열에 복사합니다.
+		 * @param[IN] const ClientManager::SessionMask& mask : 대상 슬롯 집합.
+		 * @param[OUT] SOCKET* sockets : 클라이언트 소켓 핸들을 저장할 배열.
+		 * @param[IN] int max_count : 배열이 담을 수 있는 최대 소켓 개수.
+		 * @return int : 실제 배열에 복사된 클라이언트 소켓의 개수.
+		 * @note 연결된 슬롯 집합과 단어 단위로 교집합을 구한 뒤 켜진 비트만 순회합니다.
+		 */
+		int getMaskedSockets(const ClientManager::SessionMask& mask, SOCKET* sockets, int max_count) const;
+
+		/**
+		 * @fn int ClientManager::findClient(const std::string& nickname) const
+		 * @brief 별칭으로 사용 중인 슬롯을 찾습니다.
+		 * @param[IN] const std::string& nickname : 찾을 별칭.
+		 * @return int : 슬롯 인덱스, 없으면 -1.
+		 * @note 일시 중단된 슬롯도 별칭을 유지하므로 찾습니다.
+		 */
+		int findClient(const std::string& nickname) const;
+
 		/**
 		 * @fn std::string ClientManager::getClientNickname(int client_index) const
 		 * @brief 주어진 인덱스가 유효하다면 클라이언트 자동 생성 별칭을 반환합니다.
@@ -121,11 +239,168 @@ class ClientManager
 		 */
 		std::string getClientNickname(int client_index) const;
 
+		/**
+		 * @fn bool ClientManager::getClientAddress(int client_index, sockaddr_in& client_addr) const
+		 * @brief 클라이언트의 네트워크 주소를 가져옵니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[OUT] sockaddr_in& client_addr : 주소를 저장할 구조체.
+		 * @return bool : 연결된 클라이언트이면 true, 아니면 false.
+		 */
+		bool getClientAddress(int client_index, sockaddr_in& client_addr) const;
+
+		/**
+		 * @fn std::string& ClientManager::getPendingInput(int client_index)
+		 * @brief 클라이언트가 보낸 바이트 중 아직 줄을 이루지 못한 나머지를 반환합니다. (HANDLER 모드 수신용)
+		 * @param[IN] int client_index : 클라이언트의 인덱스 (유효한 인덱스만).
+		 * @return std::string& : 다음 수신 때 이어 붙일 나머지.
+		 * @note 슬롯이 추가되거나 제거될 때 비워지므로, 이전 접속자의 반쪽 줄이 다음 접속자에게 넘어가지 않습니다.
+		 */
+		std::string& getPendingInput(int client_index);
+
+
+		/**
+		 * @fn void ClientManager::setStateFlag(int client_index, std::uint8_t flag)
+		 * @brief 클라이언트의 상태 플래그를 켭니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[IN] std::uint8_t flag : 켤 플래그 (FLAG_JOINED 등).
+		 * @return 없음.
+		 */
+		void setStateFlag(int client_index, std::uint8_t flag);
+
+		/**
+		 * @fn void ClientManager::clearStateFlag(int client_index, std::uint8_t flag)
+		 * @brief 클라이언트의 상태 플래그를 끕니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[IN] std::uint8_t flag : 끌 플래그 (FLAG_PRESENCE 등).
+		 * @return 없음.
+		 */
+		void clearStateFlag(int client_index, std::uint8_t flag);
+
+		/**
+		 * @fn bool ClientManager::hasStateFlag(int client_index, std::uint8_t flag) const
+		 * @brief 클라이언트의 상태 플래그가 켜져 있는지 확인합니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[IN] std::uint8_t flag : 확인할 플래그.
+		 * @return bool : 플래그가 켜져 있으면 true.
+		 */
+		bool hasStateFlag(int client_index, std::uint8_t flag) const;
+
+		/**
+		 * @fn void ClientManager::touchActivity(int client_index, std::int64_t now_tick)
+		 * @brief 클라이언트의 마지막 활동 시각을 갱신합니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[IN] std::int64_t now_tick : 현재 시각(밀리초 단위 틱).
+		 * @return 없음.
+		 */
+		void touchActivity(int client_index, std::int64_t now_tick);
+
+		/**
+		 * @fn std::int64_t ClientManager::getLastActivityTick(int client_index) const
+		 * @brief 클라이언트의 마지막 활동 시각을 반환합니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @return std::int64_t : 마지막 활동 시각, 유효하지 않은 인덱스이면 0.
+		 */
+		std::int64_t getLastActivityTick(int client_index) const;
+
+		/**
+		 * @fn bool ClientManager::consumeToken(int client_index)
+		 * @brief 클라이언트의 토큰을 하나 소비합니다 (속도 제한용).
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @return bool : 토큰이 남아 있어 소비했으면 true, 토큰이 없으면 false.
+		 */
+		bool consumeToken(int client_index);
+
+		/**
+		 * @fn void ClientManager::refillTokens(std::int32_t amount, std::int32_t max_tokens)
+		 * @brief 연결된 모든 클라이언트의 토큰을 충전합니다.
+		 * @param[IN] std::int32_t amount : 충전할 토큰 수.
+		 * @param[IN] std::int32_t max_tokens : 토큰 최대치.
+		 * @return 없음.
+		 * @note 토큰 배열만 순서대로 읽고 씁니다.
+		 */
+		void refillTokens(std::int32_t amount, std::int32_t max_tokens);
+
+		/**
+		 * @fn void ClientManager::addQueueDepth(int client_index, std::int32_t delta)
+		 * @brief 클라이언트의 송신 대기 큐 깊이를 변경합니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @param[IN] std::int32_t delta : 더하거나(양수) 뺄(음수) 양.
+		 * @return 없음.
+		 */
+		void addQueueDepth(int client_index, std::int32_t delta);
+
+		/**
+		 * @fn std::int32_t ClientManager::getQueueDepth(int client_index) const
+		 * @brief 클라이언트의 송신 대기 큐 깊이를 반환합니다.
+		 * @param[IN] int client_index : 클라이언트의 인덱스.
+		 * @return std::int32_t : 큐 깊이, 유효하지 않은 인덱스이면 0.
+		 */
+		std::int32_t getQueueDepth(int client_index) const;
+
+		/**
+		 * @fn int ClientManager::collectIdleClients(std::int64_t now_tick, std::int64_t idle_ticks, int* indices, int max_count) const
+		 * @brief 지정한 시간 이상 활동이 없는 클라이언트의 인덱스를 모읍니다.
+		 * @param[IN] std::int64_t now_tick : 현재 시각(밀리초 단위 틱).
+		 * @param[IN] std::int64_t idle_ticks : 유휴로 판단할 최소 경과 시간.
+		 * @param[OUT] int* indices : 인덱스를 저장할 배열.
+		 * @param[IN] int max_count : 배열이 담을 수 있는 최대 개수.
+		 * @return int : 저장된 인덱스 개수.
+		 * @note 상태 플래그와 마지막 활동 시각 배열만 읽습니다.
+		 */
+		int collectIdleClients(std::int64_t now_tick, std::int64_t idle_ticks, int* indices, int max_count) const;
+
+		/**
+		 * @fn int ClientManager::collectBackloggedClients(std::int32_t threshold, int* indices, int max_count) const
+		 * @brief 송신 대기 큐 깊이가 기준을 넘는 클라이언트의 인덱스를 모읍니다.
+		 * @param[IN] std::int32_t threshold : 큐 깊이 기준.
+		 * @param[OUT] int* indices : 인덱스를 저장할 배열.
+		 * @param[IN] int max_count : 배열이 담을 수 있는 최대 개수.
+		 * @return int : 저장된 인덱스 개수.
+		 * @note 큐 깊이 배열만 읽습니다.
+		 */
+		int collectBackloggedClients(std::int32_t threshold, int* indices, int max_count) const;
+
 	private:
+		/**
+		 * @struct ClientManager::ColdClientInfo
+		 * @brief 주기적인 스캔에서 읽지 않는 클라이언트 정보.
+		 */
+		struct ColdClientInfo
+		{
+			std::string nickname;		///< 클라이언트 별칭.
+			sockaddr_in address;		///< 클라이언트 네트워크 주소.
+			std::string pendingInput;	///< 줄 끝을 아직 받지 못한 수신 나머지.
+		};
+
+	private:
+
+		/// @brief 클라이언트 소켓을 닫을 때 사용하는 전송 계층.
+		Transport& _transport;
 		
 		/// @brief 클라이언트 소켓 배열 (크기 MAX_CLIENTS). 사용되지 않은 슬롯에는 INVALID_SOCKET.
 		std::array<SOCKET, MAX_CLIENTS> _clientSockets;
 
+		/// @brief 소켓이 연결된 슬롯 집합. _clientSockets가 바뀔 때 함께 갱신합니다.
+		ClientManager::SessionMask _socketMask;
+
+		/// @brief 소켓이 연결되어 있고 FLAG_JOINED가 켜진 슬롯 집합. 방송 대상을 정할 때 사용합니다.
+		ClientManager::SessionMask _joinedMask;
+
+		/// @brief 클라이언트 상태 플래그 배열 (FLAG_CONNECTED, FLAG_JOINED).
+		std::array<std::uint8_t, MAX_CLIENTS> _stateFlags;
+
+		/// @brief 클라이언트 마지막 활동 시각 배열 (밀리초 단위 틱).
+		std::array<std::int64_t, MAX_CLIENTS> _lastActivityTicks;
+
+		/// @brief 클라이언트 속도 제한 토큰 수 배열.
+		std::array<std::int32_t, MAX_CLIENTS> _tokenCounts;
+
+		/// @brief 클라이언트 송신 대기 큐 깊이 배열.
+		std::array<std::int32_t, MAX_CLIENTS> _queueDepths;
+
+		/// @brief 드물게 읽는 클라이언트 정보 배열.
+		std::array<ColdClientInfo, MAX_CLIENTS> _coldInfos;
+
 		/// @brief 재사용을 위한 가용 인덱스 목록 (우선순위 큐).
 		std::priority_queue<int, std::vector<int>, std::greater<int>> _availableList;
 
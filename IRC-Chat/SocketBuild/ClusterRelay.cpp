@@ -0,0 +1,711 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ClusterRelay.cpp
+ * @brief ClusterRelay.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "ClusterRelay.h"
+#include "DebugHelper.h"
+#include "TransportInstances.h"
+
+template <typename Transport>
+ClusterRelay<Transport>::ClusterRelay(Transport& transport)
+    : _transport(transport), _listenSocket(INVALID_SOCKET), _port(0), _peers(), _links(), _localHasMembers(false), _ready(false), _openedAt(),
+      _receiveBuffer(ClusterRelay::RECEIVE_CHUNK_SIZE), _relayedCount(0), _skippedCount(0), _receivedCount(0), _forwardedCount(0), _batchCount(0)
+{
+    LOG_DEBUG("ClusterRelay 객체를 생성합니다.");
+}
+
+template <typename Transport>
+ClusterRelay<Transport>::~ClusterRelay()
+{
+    this->close();
+    LOG_DEBUG("ClusterRelay 객체를 삭제합니다.");
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::addPeer(const std::string& host, int port)
+{
+    ClusterRelay::Peer peer;
+    peer.host = host;
+    peer.port = port;
+    peer.linked = false;
+    peer.nextAttempt = NetworkTransport::Clock::time_point();
+    peer.connectingSocket = INVALID_SOCKET;
+    peer.connectDeadline = NetworkTransport::Clock::time_point();
+    this->_peers.push_back(peer);
+}
+
+template <typename Transport>
+ClusterRelayBase::Result ClusterRelay<Transport>::open(int cluster_port)
+{
+    this->_listenSocket = this->_transport.createSocket();
+    if (this->_listenSocket == INVALID_SOCKET)
+    {
+        LOG_ERROR("클러스터 소켓 생성 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+        return (ClusterRelay::Result::FAIL_CREATE);
+    }
+
+    if (this->_transport.bindSocket(this->_listenSocket, cluster_port) == SOCKET_ERROR)
+    {
+        LOG_ERROR("클러스터 포트 바인드 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+        this->_transport.closeSocket(this->_listenSocket);
+        this->_listenSocket = INVALID_SOCKET;
+        return (ClusterRelay::Result::FAIL_BIND);
+    }
+
+    if (this->_transport.listenSocket(this->_listenSocket) == SOCKET_ERROR)
+    {
+        LOG_ERROR("클러스터 리슨 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+        this->_transport.closeSocket(this->_listenSocket);
+        this->_listenSocket = INVALID_SOCKET;
+        return (ClusterRelay::Result::FAIL_LISTEN);
+    }
+
+    this->_port = cluster_port;
+    this->_ready = false;
+    this->_openedAt = this->_transport.now();
+    LOG_INFO("클러스터 중계를 시작합니다. 클러스터 포트: " + std::to_string(cluster_port) + ", 등록된 노드: " + std::to_string(this->_peers.size()) + "개");
+    return (ClusterRelay::Result::SUCCESS);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::close()
+{
+    for (ClusterRelay::Peer& peer : this->_peers)
+    {
+        this->abandonConnect(peer);
+    }
+
+    while (this->_links.empty() == false)
+    {
+        this->closeLink(this->_links.size() - 1);
+    }
+
+    if (this->_listenSocket != INVALID_SOCKET)
+    {
+        this->_transport.closeSocket(this->_listenSocket);
+        this->_listenSocket = INVALID_SOCKET;
+    }
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::isOpen() const
+{
+    return (this->_listenSocket != INVALID_SOCKET);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::maintainLinks()
+{
+    if (this->isOpen() == false)
+    {
+        return ;
+    }
+
+    NetworkTransport::Clock::time_point now = this->_transport.now();
+    for (std::size_t i = 0; i < this->_peers.size(); ++i)
+    {
+        ClusterRelay::Peer& peer = this->_peers[i];
+
+        // 응답 없는 노드를 기다리는 연결은 시간이 지나면 포기하고 다시 시도합니다.
+        if (peer.connectingSocket != INVALID_SOCKET)
+        {
+            if (now >= peer.connectDeadline)
+            {
+                LOG_DEBUG("클러스터 노드가 응답하지 않아 연결을 다시 시도합니다: " + peer.host + ":" + std::to_string(peer.port));
+                this->abandonConnect(peer);
+            }
+            continue;
+        }
+
+        // 클러스터 포트가 더 작은 노드에만 연결합니다. (반대쪽은 상대가 연결해 옵니다.)
+        if (peer.linked || peer.port >= this->_port || now < peer.nextAttempt)
+        {
+            continue;
+        }
+        if ((int)this->_links.size() + this->getConnectingCount() >= ClusterRelay::MAX_LINKS)
+        {
+            break;
+        }
+
+        peer.nextAttempt = now + std::chrono::milliseconds(ClusterRelay::RECONNECT_INTERVAL_MS);
+
+        SOCKET link_socket = this->_transport.createSocket();
+        if (link_socket == INVALID_SOCKET)
+        {
+            continue;
+        }
+
+        // 연결을 기다리지 않고 시작만 합니다. 대부분 WSAEWOULDBLOCK으로 돌아오고, 끝나면 select가 알려 줍니다.
+        if (this->_transport.startConnect(link_socket, peer.host.c_str(), peer.port) == 0)
+        {
+            peer.linked = true;
+            this->addLink(link_socket, (int)i);
+            LOG_INFO("클러스터 노드에 연결했습니다: " + peer.host + ":" + std::to_string(peer.port));
+            continue;
+        }
+        if (this->_transport.getLastError() != WSAEWOULDBLOCK)
+        {
+            // 노드가 아직 뜨지 않았을 수 있으므로 매 시도마다 경고하지 않습니다.
+            LOG_DEBUG("클러스터 노드 연결 실패: " + peer.host + ":" + std::to_string(peer.port) + ", 오류 코드: " + std::to_string(this->_transport.getLastError()));
+            this->_transport.closeSocket(link_socket);
+            continue;
+        }
+
+        peer.connectingSocket = link_socket;
+        peer.connectDeadline = now + std::chrono::milliseconds(ClusterRelay::CONNECT_TIMEOUT_MS);
+    }
+
+    // 모든 노드와 연결되었거나, 오지 않는 노드를 더 기다리지 않을 때가 되면 링에 들어갑니다.
+    if (this->_ready == false
+        && (this->isLinkedToEveryPeer() || now >= this->_openedAt + std::chrono::milliseconds(ClusterRelay::READY_GRACE_MS)))
+    {
+        this->_ready = true;
+        for (ClusterRelay::Link& link : this->_links)
+        {
+            ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::READY, "", 0);
+        }
+        LOG_INFO("클러스터 링에 들어갑니다. 현재 링크: " + std::to_string(this->_links.size()) + "개");
+    }
+}
+
+template <typename Transport>
+int ClusterRelay<Transport>::getConnectingSockets(SOCKET* sockets, int max_count) const
+{
+    int count = 0;
+
+    for (const ClusterRelay::Peer& peer : this->_peers)
+    {
+        if (count == max_count)
+        {
+            break;
+        }
+        if (peer.connectingSocket != INVALID_SOCKET)
+        {
+            sockets[count] = peer.connectingSocket;
+            count = count + 1;
+        }
+    }
+    return (count);
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::finishConnect(SOCKET connecting_socket)
+{
+    for (std::size_t i = 0; i < this->_peers.size(); ++i)
+    {
+        ClusterRelay::Peer& peer = this->_peers[i];
+        if (peer.connectingSocket != connecting_socket || connecting_socket == INVALID_SOCKET)
+        {
+            continue;
+        }
+
+        int connect_error = this->_transport.getConnectResult(connecting_socket);
+        if (connect_error != 0)
+        {
+            LOG_DEBUG("클러스터 노드 연결 실패: " + peer.host + ":" + std::to_string(peer.port) + ", 오류 코드: " + std::to_string(connect_error));
+            this->abandonConnect(peer);
+            return (false);
+        }
+
+        // 링크 소켓은 논블로킹 상태로 남으므로 flush()의 send도 막히지 않습니다.
+        peer.connectingSocket = INVALID_SOCKET;
+        peer.linked = true;
+        this->addLink(connecting_socket, (int)i);
+        LOG_INFO("클러스터 노드에 연결했습니다: " + peer.host + ":" + std::to_string(peer.port));
+        return (true);
+    }
+    return (false);
+}
+
+template <typename Transport>
+int ClusterRelay<Transport>::getConnectingCount() const
+{
+    int count = 0;
+
+    for (const ClusterRelay::Peer& peer : this->_peers)
+    {
+        if (peer.connectingSocket != INVALID_SOCKET)
+        {
+            count = count + 1;
+        }
+    }
+    return (count);
+}
+
+template <typename Transport>
+SOCKET ClusterRelay<Transport>::getListenSocket() const
+{
+    return (this->_listenSocket);
+}
+
+template <typename Transport>
+int ClusterRelay<Transport>::getLinkSockets(SOCKET* sockets, int max_count) const
+{
+    int count = 0;
+
+    for (const ClusterRelay::Link& link : this->_links)
+    {
+        if (count == max_count)
+        {
+            break;
+        }
+        sockets[count] = link.socket;
+        count = count + 1;
+    }
+    return (count);
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::acceptLink()
+{
+    sockaddr_in peer_addr = {};
+    SOCKET link_socket = this->_transport.acceptSocket(this->_listenSocket, &peer_addr);
+    if (link_socket == INVALID_SOCKET)
+    {
+        return (false);
+    }
+
+    if ((int)this->_links.size() >= ClusterRelay::MAX_LINKS)
+    {
+        LOG_WARN("클러스터 링크 수가 최대에 도달해 연결을 거절합니다.");
+        this->_transport.closeSocket(link_socket);
+        return (false);
+    }
+
+    this->addLink(link_socket, -1);
+    LOG_INFO("클러스터 노드의 연결을 수락했습니다. 현재 링크: " + std::to_string(this->_links.size()) + "개");
+    return (true);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::receiveFrom(SOCKET link_socket, std::vector<ClusterRelay::Message>& messages)
+{
+    std::size_t position = 0;
+    while (position < this->_links.size() && this->_links[position].socket != link_socket)
+    {
+        position = position + 1;
+    }
+    if (position == this->_links.size())
+    {
+        return ;
+    }
+
+    int receive_result = this->_transport.receiveBytes(link_socket, this->_receiveBuffer.data(), ClusterRelay::RECEIVE_CHUNK_SIZE);
+    if (receive_result == SOCKET_ERROR && this->_transport.getLastError() == WSAEWOULDBLOCK)
+    {
+        return ;
+    }
+    if (receive_result <= 0)
+    {
+        LOG_WARN("클러스터 링크가 끊어졌습니다. 상대 포트: " + std::to_string(this->_links[position].peerPort));
+        this->closeLink(position);
+        return ;
+    }
+
+    ClusterRelay::Link& link = this->_links[position];
+    link.inbound.append(this->_receiveBuffer.data(), receive_result);
+
+    // 완성된 프레임만 처리하고, 잘린 마지막 프레임은 다음 수신까지 남겨 둡니다.
+    std::size_t offset = 0;
+    while (link.inbound.size() - offset >= ClusterRelay::FRAME_HEADER_SIZE)
+    {
+        const unsigned char* header = (const unsigned char*)link.inbound.data() + offset;
+        std::size_t body_length = (std::size_t)header[0] | ((std::size_t)header[1] << 8);
+        ClusterRelay::FrameType type = (ClusterRelay::FrameType)header[2];
+
+        if (body_length > (std::size_t)ClusterRelay::MAX_FRAME_SIZE)
+        {
+            LOG_WARN("클러스터 프레임이 너무 커 링크를 끊습니다: " + std::to_string(body_length) + "바이트");
+            this->closeLink(position);
+            return ;
+        }
+        if (link.inbound.size() - offset < ClusterRelay::FRAME_HEADER_SIZE + body_length)
+        {
+            break;
+        }
+
+        const char* body = link.inbound.data() + offset + ClusterRelay::FRAME_HEADER_SIZE;
+        if (this->handleFrame(link, type, body, body_length, messages) == false)
+        {
+            LOG_WARN("잘못된 클러스터 프레임을 받아 링크를 끊습니다. 종류: " + std::to_string((int)type));
+            this->closeLink(position);
+            return ;
+        }
+        offset = offset + ClusterRelay::FRAME_HEADER_SIZE + body_length;
+    }
+    link.inbound.erase(0, offset);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::getLiveNodes(std::vector<int>& nodes) const
+{
+    nodes.clear();
+    if (this->_ready)
+    {
+        nodes.push_back(this->_port);
+    }
+    for (const ClusterRelay::Link& link : this->_links)
+    {
+        if (link.peerPort != 0 && link.peerReady)
+        {
+            nodes.push_back(link.peerPort);
+        }
+    }
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::isReady() const
+{
+    return (this->_ready);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::setLocalMembers(bool has_members)
+{
+    if (this->_localHasMembers == has_members)
+    {
+        return ;
+    }
+
+    this->_localHasMembers = has_members;
+    char flag = has_members ? 1 : 0;
+    for (ClusterRelay::Link& link : this->_links)
+    {
+        ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::MEMBERS, &flag, 1);
+    }
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::publishTo(int node, const std::string& room, int hops, const std::string& line)
+{
+    ClusterRelay::Link* link = this->findLink(node);
+    if (link == nullptr)
+    {
+        return (false);
+    }
+
+    std::string body = ClusterRelay::makeRoomBody(room);
+    body.push_back((char)hops);
+    body.append(line);
+    if (body.size() > (std::size_t)ClusterRelay::MAX_FRAME_SIZE)
+    {
+        LOG_WARN("클러스터로 보내기에 너무 긴 채팅입니다: " + std::to_string(line.size()) + "바이트");
+        return (false);
+    }
+
+    ClusterRelay::appendFrame(link->outbound, ClusterRelay::FrameType::PUBLISH, body.data(), body.size());
+    this->_forwardedCount = this->_forwardedCount + 1;
+    return (true);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::broadcastSequenced(const std::string& room, std::uint64_t sequence, const std::string& line)
+{
+    std::string body = ClusterRelay::makeRoomBody(room);
+    ClusterRelay::appendSequence(body, sequence);
+    body.append(line);
+    if (body.size() > (std::size_t)ClusterRelay::MAX_FRAME_SIZE)
+    {
+        LOG_WARN("클러스터로 보내기에 너무 긴 채팅입니다: " + std::to_string(line.size()) + "바이트");
+        return ;
+    }
+
+    // 접속자가 없는 노드에는 보내지 않습니다. 그 노드가 나중에 주인이 되면 HANDOFF나 순번 건너뛰기로 순번을 맞춥니다.
+    for (ClusterRelay::Link& link : this->_links)
+    {
+        if (link.peerHasMembers == false)
+        {
+            this->_skippedCount = this->_skippedCount + 1;
+            continue;
+        }
+        ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::SEQUENCED, body.data(), body.size());
+        this->_relayedCount = this->_relayedCount + 1;
+    }
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::sendHandoff(int node, const std::string& room, std::uint64_t last_sequence)
+{
+    ClusterRelay::Link* link = this->findLink(node);
+    if (link == nullptr)
+    {
+        return (false);
+    }
+
+    std::string body = ClusterRelay::makeRoomBody(room);
+    ClusterRelay::appendSequence(body, last_sequence);
+    ClusterRelay::appendFrame(link->outbound, ClusterRelay::FrameType::HANDOFF, body.data(), body.size());
+    return (true);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::flush()
+{
+    // 닫힌 링크를 목록에서 빼도 나머지 위치가 바뀌지 않도록 뒤에서부터 보냅니다.
+    for (std::size_t i = this->_links.size(); i > 0; --i)
+    {
+        std::size_t position = i - 1;
+        ClusterRelay::Link& link = this->_links[position];
+        if (link.outbound.empty())
+        {
+            continue;
+        }
+
+        int send_result = this->_transport.sendBytes(link.socket, link.outbound.data(), (int)link.outbound.size());
+        this->_batchCount = this->_batchCount + 1;
+        if (send_result == SOCKET_ERROR)
+        {
+            if (this->_transport.getLastError() == WSAEWOULDBLOCK)
+            {
+                continue;
+            }
+            LOG_WARN("클러스터 링크 전송 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+            this->closeLink(position);
+            continue;
+        }
+
+        link.outbound.erase(0, (std::size_t)send_result);
+        if (link.outbound.size() > ClusterRelay::MAX_LINK_BACKLOG)
+        {
+            LOG_WARN("클러스터 노드가 따라오지 못해 링크를 끊습니다. 미전송: " + std::to_string(link.outbound.size()) + "바이트");
+            this->closeLink(position);
+        }
+    }
+}
+
+template <typename Transport>
+int ClusterRelay<Transport>::getLinkCount() const
+{
+    return ((int)this->_links.size());
+}
+
+template <typename Transport>
+std::uint64_t ClusterRelay<Transport>::getRelayedCount() const
+{
+    return (this->_relayedCount);
+}
+
+template <typename Transport>
+std::uint64_t ClusterRelay<Transport>::getSkippedCount() const
+{
+    return (this->_skippedCount);
+}
+
+template <typename Transport>
+std::uint64_t ClusterRelay<Transport>::getReceivedCount() const
+{
+    return (this->_receivedCount);
+}
+
+template <typename Transport>
+std::uint64_t ClusterRelay<Transport>::getForwardedCount() const
+{
+    return (this->_forwardedCount);
+}
+
+template <typename Transport>
+std::uint64_t ClusterRelay<Transport>::getBatchCount() const
+{
+    return (this->_batchCount);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::addLink(SOCKET link_socket, int peer_index)
+{
+    ClusterRelay::Link link;
+    link.socket = link_socket;
+    link.peerIndex = peer_index;
+    link.peerPort = 0;
+    link.peerHasMembers = false;
+    link.peerReady = false;
+
+    char hello[2] = { (char)(this->_port & 0xFF), (char)((this->_port >> 8) & 0xFF) };
+    char flag = this->_localHasMembers ? 1 : 0;
+    ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::HELLO, hello, sizeof(hello));
+    ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::MEMBERS, &flag, 1);
+    if (this->_ready)
+    {
+        ClusterRelay::appendFrame(link.outbound, ClusterRelay::FrameType::READY, "", 0);
+    }
+
+    this->_links.push_back(std::move(link));
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::closeLink(std::size_t position)
+{
+    ClusterRelay::Link& link = this->_links[position];
+    this->_transport.closeSocket(link.socket);
+
+    if (link.peerIndex >= 0)
+    {
+        ClusterRelay::Peer& peer = this->_peers[link.peerIndex];
+        peer.linked = false;
+        peer.nextAttempt = this->_transport.now() + std::chrono::milliseconds(ClusterRelay::RECONNECT_INTERVAL_MS);
+    }
+
+    this->_links.erase(this->_links.begin() + position);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::abandonConnect(ClusterRelay::Peer& peer)
+{
+    if (peer.connectingSocket == INVALID_SOCKET)
+    {
+        return ;
+    }
+
+    this->_transport.closeSocket(peer.connectingSocket);
+    peer.connectingSocket = INVALID_SOCKET;
+}
+
+template <typename Transport>
+typename ClusterRelay<Transport>::Link* ClusterRelay<Transport>::findLink(int node)
+{
+    for (ClusterRelay::Link& link : this->_links)
+    {
+        if (link.peerPort == node && node != 0)
+        {
+            return (&link);
+        }
+    }
+    return (nullptr);
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::isLinkedToEveryPeer() const
+{
+    for (const ClusterRelay::Peer& peer : this->_peers)
+    {
+        bool linked = false;
+        for (const ClusterRelay::Link& link : this->_links)
+        {
+            if (link.peerPort == peer.port)
+            {
+                linked = true;
+                break;
+            }
+        }
+        if (linked == false)
+        {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+template <typename Transport>
+bool ClusterRelay<Transport>::handleFrame(ClusterRelay::Link& link, ClusterRelay::FrameType type, const char* body, std::size_t length, std::vector<ClusterRelay::Message>& messages)
+{
+    if (type == ClusterRelay::FrameType::PUBLISH || type == ClusterRelay::FrameType::SEQUENCED || type == ClusterRelay::FrameType::HANDOFF)
+    {
+        // 공통 앞부분: [방 ID 길이][방 ID]. 보낸 노드를 알아야 하므로 HELLO 전에는 받지 않습니다.
+        std::size_t room_length = (length > 0) ? (unsigned char)body[0] : 0;
+        if (link.peerPort == 0 || room_length == 0 || length < 1 + room_length)
+        {
+            return (false);
+        }
+
+        ClusterRelay::Message message;
+        message.type = type;
+        message.fromNode = link.peerPort;
+        message.room.assign(body + 1, room_length);
+        message.hops = 0;
+        message.sequence = 0;
+
+        const char* rest = body + 1 + room_length;
+        std::size_t rest_length = length - 1 - room_length;
+        if (type == ClusterRelay::FrameType::PUBLISH)
+        {
+            if (rest_length < 1)
+            {
+                return (false);
+            }
+            message.hops = (unsigned char)rest[0];
+            message.line.assign(rest + 1, rest_length - 1);
+        }
+        else
+        {
+            if (rest_length < 8 || (type == ClusterRelay::FrameType::HANDOFF && rest_length != 8))
+            {
+                return (false);
+            }
+            for (int i = 7; i >= 0; --i)
+            {
+                message.sequence = (message.sequence << 8) | (unsigned char)rest[i];
+            }
+            message.line.assign(rest + 8, rest_length - 8);
+            if (type == ClusterRelay::FrameType::SEQUENCED)
+            {
+                this->_receivedCount = this->_receivedCount + 1;
+            }
+        }
+
+        messages.push_back(std::move(message));
+        return (true);
+    }
+
+    switch (type)
+    {
+    case ClusterRelay::FrameType::HELLO:
+        if (length != 2)
+        {
+            return (false);
+        }
+        link.peerPort = (int)((unsigned char)body[0] | ((unsigned char)body[1] << 8));
+        return (true);
+
+    case ClusterRelay::FrameType::MEMBERS:
+        if (length != 1)
+        {
+            return (false);
+        }
+        link.peerHasMembers = (body[0] != 0);
+        return (true);
+
+    case ClusterRelay::FrameType::READY:
+        if (length != 0 || link.peerPort == 0)
+        {
+            return (false);
+        }
+        link.peerReady = true;
+        return (true);
+
+    default:
+        return (false);
+    }
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::appendFrame(std::string& out, ClusterRelay::FrameType type, const char* body, std::size_t length)
+{
+    out.push_back((char)(length & 0xFF));
+    out.push_back((char)((length >> 8) & 0xFF));
+    out.push_back((char)type);
+    out.append(body, length);
+}
+
+template <typename Transport>
+std::string ClusterRelay<Transport>::makeRoomBody(const std::string& room)
+{
+    std::string body;
+    body.push_back((char)room.size());
+    body.append(room);
+    return (body);
+}
+
+template <typename Transport>
+void ClusterRelay<Transport>::appendSequence(std::string& body, std::uint64_t sequence)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        body.push_back((char)((sequence >> (8 * i)) & 0xFF));
+    }
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(ClusterRelay);
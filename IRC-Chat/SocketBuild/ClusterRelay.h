@@ -0,0 +1,505 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file ClusterRelay.h
+ * @brief 여러 채팅 서버 프로세스를 TCP로 묶어 채팅방 메시지와 주인 넘겨주기를 주고받는 ClusterRelay 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 노드마다 클러스터 포트 하나를 리슨하고, 설정된 다른 노드와 TCP 링크를 맺습니다. (전체 연결.)
+ * <br>한 쌍의 노드 사이에는 링크가 하나만 생기도록 클러스터 포트가 더 큰 노드가 작은 노드에 연결합니다.
+ * <br>따라서 모든 노드에 나머지 노드를 모두 등록해야 하며, 클러스터 포트가 노드 번호 역할을 하므로 노드마다 달라야 합니다.
+ *
+ * 링크 위의 프레임 형식 (리틀 엔디언):
+ * @code
+ * [본문 길이 2바이트][종류 1바이트][본문]
+ *   HELLO     : [클러스터 포트 2바이트]                       링크를 맺은 직후 양쪽이 보냅니다.
+ *   MEMBERS   : [접속자 유무 1바이트]                         로컬 접속자가 생기거나 모두 나가면 보냅니다.
+ *   PUBLISH   : [방 ID 길이 1][방 ID][전달 횟수 1][채팅 한 줄]  주인이 아닌 노드가 채팅을 주인에게 넘깁니다.
+ *   SEQUENCED : [방 ID 길이 1][방 ID][순번 8][채팅 한 줄]       주인이 순번을 매긴 채팅을 나머지 노드에 보냅니다.
+ *   HANDOFF   : [방 ID 길이 1][방 ID][마지막 순번 8]            이전 주인이 새 주인에게 채팅방을 넘깁니다.
+ *   READY     : (본문 없음)                                    보낸 노드가 채팅방 주인을 맡을 수 있게 되었습니다.
+ * @endcode
+ * 링크 연결은 논블로킹으로 시작하고, 서버 루프의 select가 연결이 끝났다고 알려 주면 finishConnect()에서 링크로 등록합니다.
+ * <br>따라서 응답하지 않는 노드가 있어도 서버 루프는 멈추지 않으며, CONNECT_TIMEOUT_MS 안에 끝나지 않은 연결은 닫고 다시 시도합니다.
+ * 새로 뜬 노드는 등록된 노드 모두와 링크를 맺은 뒤(또는 READY_GRACE_MS가 지난 뒤) READY를 보내고, 그때부터 링에 들어갑니다.
+ * <br>일부 노드와만 연결된 노드가 채팅방을 넘겨받으면, 아직 링크가 없는 노드의 접속자는 그동안 채팅을 받지 못하기 때문입니다.
+ * 채팅방의 주인과 순번은 RoomDirectory가 정하고, 이 클래스는 프레임만 주고받습니다.
+ * <br>SEQUENCED는 접속자가 있다고 알려 온 노드의 링크에만 쌓이고, PUBLISH와 HANDOFF는 대상 노드의 링크에 쌓입니다.
+ * <br>쌓인 프레임은 서버 루프의 매 반복 시작 시 flush()에서 링크마다 한 번의 send로 묶어 보냅니다.
+ * <br>한 링크 안의 프레임은 순서대로 도착하므로, HANDOFF는 이전 주인이 그 전에 보낸 SEQUENCED보다 먼저 처리되지 않습니다.
+ */
+
+#include "NetworkTransport.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ClusterRelayBase
+ * @brief 전송 계층과 무관한 ClusterRelay의 상수, 프레임 종류와 결과 타입을 담습니다.
+ *
+ * @note 바깥에서는 ClusterRelayBase::Message처럼 씁니다.
+ */
+class ClusterRelayBase
+{
+public:
+    /// 유지할 수 있는 최대 링크 수.
+    static constexpr int MAX_LINKS = 16;
+
+    /// 프레임 본문의 최대 크기(바이트). 더 큰 프레임을 받으면 링크를 끊습니다.
+    static constexpr int MAX_FRAME_SIZE = 4096;
+
+    /// 끊기거나 연결에 실패한 노드에 다시 연결을 시도하는 간격(밀리초).
+    static constexpr int RECONNECT_INTERVAL_MS = 1000;
+
+    /// 시작한 연결이 끝나기를 기다리는 최대 시간(밀리초). 넘으면 응답 없는 노드로 보고 닫은 뒤 다시 시도합니다.
+    static constexpr int CONNECT_TIMEOUT_MS = 3000;
+
+    /// open() 뒤 등록된 노드 일부와 링크를 맺지 못했어도 READY를 보내기까지 기다리는 시간(밀리초). 죽은 노드를 기다리지 않기 위함입니다.
+    static constexpr int READY_GRACE_MS = 2 * ClusterRelayBase::RECONNECT_INTERVAL_MS;
+
+    /// 링크 하나에 쌓아 둘 수 있는 최대 미전송 바이트 수. 넘으면 느린 노드로 보고 링크를 끊습니다.
+    static constexpr std::size_t MAX_LINK_BACKLOG = 1024 * 1024;
+
+    /// 채팅방 ID의 최대 길이(바이트).
+    static constexpr std::size_t MAX_ROOM_ID_LENGTH = 255;
+
+public:
+    /**
+     * @enum ClusterRelayBase::Result
+     * @brief ClusterRelay 함수의 반환값.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 성공.
+        FAIL_CREATE,    ///< 소켓 생성 실패.
+        FAIL_BIND,      ///< 클러스터 포트 바인드 실패.
+        FAIL_LISTEN     ///< 리슨 실패.
+    };
+
+    /**
+     * @enum ClusterRelayBase::FrameType
+     * @brief 노드 간 프레임 종류.
+     */
+    enum class FrameType : std::uint8_t
+    {
+        HELLO = 1,      ///< 보낸 노드의 클러스터 포트.
+        MEMBERS = 2,    ///< 보낸 노드에 로컬 접속자가 있는지 여부.
+        PUBLISH = 3,    ///< 주인에게 넘기는 순번 없는 채팅.
+        SEQUENCED = 4,  ///< 주인이 순번을 매긴 채팅.
+        HANDOFF = 5,    ///< 채팅방 넘겨주기 (이전 주인의 마지막 순번).
+        READY = 6       ///< 보낸 노드가 링에 들어올 준비가 되었음.
+    };
+
+    /**
+     * @struct ClusterRelayBase::Message
+     * @brief 다른 노드에서 받은 채팅방 프레임 하나. (HELLO, MEMBERS, READY는 내부에서 처리합니다.)
+     */
+    struct Message
+    {
+        ClusterRelayBase::FrameType type;   ///< PUBLISH, SEQUENCED, HANDOFF 중 하나.
+        int fromNode;                       ///< 보낸 노드의 클러스터 포트.
+        std::string room;                   ///< 채팅방 ID.
+        int hops;                           ///< PUBLISH가 지금까지 전달된 횟수.
+        std::uint64_t sequence;             ///< SEQUENCED의 순번 또는 HANDOFF의 마지막 순번.
+        std::string line;                   ///< 채팅 한 줄 (HANDOFF는 빈 문자열).
+    };
+
+};
+
+/**
+ * @class ClusterRelay
+ * @brief 클러스터 리스닝 소켓, 노드 간 링크, 링크별 송수신 버퍼와 상대 노드의 접속자 유무를 관리하는 클래스입니다.
+ * @tparam Transport : 소켓 호출에 사용할 전송 계층 타입.
+ */
+template <typename Transport>
+class ClusterRelay : public ClusterRelayBase
+{
+public:
+    /**
+     * @fn ClusterRelay::ClusterRelay(Transport& transport)
+     * @brief 닫힌 상태의 중계기를 생성합니다.
+     * @param[IN] Transport& transport : 소켓 호출에 사용할 전송 계층.
+     * @return 없음.
+     */
+    explicit ClusterRelay(Transport& transport);
+
+    /**
+     * @fn ClusterRelay::~ClusterRelay()
+     * @brief 소멸자. 리스닝 소켓과 모든 링크를 닫습니다.
+     * @return 없음.
+     */
+    ~ClusterRelay();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    ClusterRelay(const ClusterRelay& obj) = delete;
+    ClusterRelay& operator=(const ClusterRelay& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    ClusterRelay(ClusterRelay&& obj) = delete;
+    ClusterRelay& operator=(ClusterRelay&& obj) = delete;
+
+public:
+    /**
+     * @fn void ClusterRelay::addPeer(const std::string& host, int port)
+     * @brief 클러스터의 다른 노드를 등록합니다. open() 전에 호출합니다.
+     * @param[IN] const std::string& host : 노드의 IPv4 주소.
+     * @param[IN] int port : 노드의 클러스터 포트.
+     * @return 없음.
+     */
+    void addPeer(const std::string& host, int port);
+
+    /**
+     * @fn ClusterRelay::Result ClusterRelay::open(int cluster_port)
+     * @brief 클러스터 포트에서 다른 노드의 연결을 기다리기 시작합니다.
+     * @param[IN] int cluster_port : 이 노드의 클러스터 포트.
+     * @return ClusterRelay::Result : 결과 코드.
+     */
+    ClusterRelay::Result open(int cluster_port);
+
+    /**
+     * @fn void ClusterRelay::close()
+     * @brief 리스닝 소켓과 모든 링크를 닫습니다.
+     * @return 없음.
+     */
+    void close();
+
+    /**
+     * @fn bool ClusterRelay::isOpen() const
+     * @brief 중계기가 열려 있는지 확인합니다.
+     * @return bool : 열려 있으면 true.
+     */
+    bool isOpen() const;
+
+    /**
+     * @fn void ClusterRelay::maintainLinks()
+     * @brief 이 노드가 연결할 차례인 노드 중 링크가 없는 노드에 연결을 시작합니다. 준비가 끝났으면 모든 링크에 READY를 쌓습니다.
+     * @return 없음.
+     * @note 연결을 기다리지 않습니다. 진행 중인 연결은 getConnectingSockets()로 select에 등록하고 finishConnect()로 마칩니다.
+     * <br>실패했거나 CONNECT_TIMEOUT_MS 안에 끝나지 않은 노드는 RECONNECT_INTERVAL_MS가 지난 뒤 다시 시도합니다.
+     */
+    void maintainLinks();
+
+    /**
+     * @fn int ClusterRelay::getConnectingSockets(SOCKET* sockets, int max_count) const
+     * @brief 연결이 끝나기를 기다리는 소켓을 배열에 복사합니다. select의 쓰기 집합에 등록합니다.
+     * @param[OUT] SOCKET* sockets : 소켓을 저장할 배열.
+     * @param[IN] int max_count : 배열 크기.
+     * @return int : 복사한 소켓 수.
+     */
+    int getConnectingSockets(SOCKET* sockets, int max_count) const;
+
+    /**
+     * @fn bool ClusterRelay::finishConnect(SOCKET connecting_socket)
+     * @brief select가 연결이 끝났다고 알린 소켓의 결과를 확인해, 성공했으면 링크로 등록하고 실패했으면 닫습니다.
+     * @param[IN] SOCKET connecting_socket : 연결이 끝난 소켓.
+     * @return bool : 링크로 등록했으면 true.
+     */
+    bool finishConnect(SOCKET connecting_socket);
+
+    /**
+     * @fn int ClusterRelay::getConnectingCount() const
+     * @brief 연결이 끝나기를 기다리는 노드 수를 반환합니다.
+     * @return int : 연결 중인 노드 수.
+     */
+    int getConnectingCount() const;
+
+    /**
+     * @fn SOCKET ClusterRelay::getListenSocket() const
+     * @brief select에 등록할 클러스터 리스닝 소켓을 반환합니다.
+     * @return SOCKET : 리스닝 소켓, 닫혀 있으면 INVALID_SOCKET.
+     */
+    SOCKET getListenSocket() const;
+
+    /**
+     * @fn int ClusterRelay::getLinkSockets(SOCKET* sockets, int max_count) const
+     * @brief select에 등록할 링크 소켓을 배열에 복사합니다.
+     * @param[OUT] SOCKET* sockets : 소켓을 저장할 배열.
+     * @param[IN] int max_count : 배열 크기.
+     * @return int : 복사한 소켓 수.
+     */
+    int getLinkSockets(SOCKET* sockets, int max_count) const;
+
+    /**
+     * @fn bool ClusterRelay::acceptLink()
+     * @brief 다른 노드의 연결을 수락해 링크로 등록합니다.
+     * @return bool : 수락했으면 true.
+     */
+    bool acceptLink();
+
+    /**
+     * @fn void ClusterRelay::receiveFrom(SOCKET link_socket, std::vector<ClusterRelay::Message>& messages)
+     * @brief 읽기 준비된 링크에서 받은 프레임을 처리하고, 채팅방 프레임을 받은 순서대로 messages에 덧붙입니다.
+     * @param[IN] SOCKET link_socket : 읽기 준비된 링크 소켓.
+     * @param[OUT] std::vector<ClusterRelay::Message>& messages : 받은 채팅방 프레임.
+     * @return 없음.
+     * @note 연결이 끊겼거나 잘못된 프레임을 받으면 링크를 닫습니다. HELLO 전에 받은 채팅방 프레임도 잘못된 프레임으로 봅니다.
+     */
+    void receiveFrom(SOCKET link_socket, std::vector<ClusterRelay::Message>& messages);
+
+    /**
+     * @fn void ClusterRelay::getLiveNodes(std::vector<int>& nodes) const
+     * @brief READY를 받은 링크의 상대 노드와, 준비가 끝났으면 이 노드를 모읍니다. 채팅방 주인을 정하는 링은 이 목록으로 만듭니다.
+     * @param[OUT] std::vector<int>& nodes : 노드의 클러스터 포트.
+     * @return 없음.
+     */
+    void getLiveNodes(std::vector<int>& nodes) const;
+
+    /**
+     * @fn bool ClusterRelay::isReady() const
+     * @brief 이 노드가 READY를 보냈는지(링에 들어갔는지) 확인합니다. 한 번 준비되면 링크가 끊겨도 되돌아가지 않습니다.
+     * @return bool : 준비가 끝났으면 true.
+     */
+    bool isReady() const;
+
+    /**
+     * @fn void ClusterRelay::setLocalMembers(bool has_members)
+     * @brief 이 노드에 로컬 접속자가 있는지 알립니다. 바뀌었을 때만 모든 링크에 MEMBERS를 쌓습니다.
+     * @param[IN] bool has_members : 로컬 접속자가 한 명 이상이면 true.
+     * @return 없음.
+     */
+    void setLocalMembers(bool has_members);
+
+    /**
+     * @fn bool ClusterRelay::publishTo(int node, const std::string& room, int hops, const std::string& line)
+     * @brief 순번 없는 채팅을 채팅방 주인 노드의 링크에 PUBLISH로 쌓습니다.
+     * @param[IN] int node : 주인 노드의 클러스터 포트.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] int hops : 이번 전달을 포함한 전달 횟수.
+     * @param[IN] const std::string& line : 채팅 한 줄.
+     * @return bool : 쌓았으면 true, 노드와의 링크가 없거나 너무 길면 false.
+     */
+    bool publishTo(int node, const std::string& room, int hops, const std::string& line);
+
+    /**
+     * @fn void ClusterRelay::broadcastSequenced(const std::string& room, std::uint64_t sequence, const std::string& line)
+     * @brief 주인이 순번을 매긴 채팅을 접속자가 있는 노드의 링크에 SEQUENCED로 쌓습니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] std::uint64_t sequence : 채팅방 순번.
+     * @param[IN] const std::string& line : 채팅 한 줄.
+     * @return 없음.
+     */
+    void broadcastSequenced(const std::string& room, std::uint64_t sequence, const std::string& line);
+
+    /**
+     * @fn bool ClusterRelay::sendHandoff(int node, const std::string& room, std::uint64_t last_sequence)
+     * @brief 채팅방을 넘겨받을 노드의 링크에 HANDOFF를 쌓습니다.
+     * @param[IN] int node : 새 주인의 클러스터 포트.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] std::uint64_t last_sequence : 이 노드가 마지막으로 매긴 순번.
+     * @return bool : 쌓았으면 true, 노드와의 링크가 없으면 false.
+     */
+    bool sendHandoff(int node, const std::string& room, std::uint64_t last_sequence);
+
+    /**
+     * @fn void ClusterRelay::flush()
+     * @brief 링크마다 쌓인 프레임을 한 번의 send로 보냅니다. 보내지 못한 나머지는 다음 호출까지 남겨 둡니다.
+     * @return 없음.
+     */
+    void flush();
+
+    /**
+     * @fn int ClusterRelay::getLinkCount() const
+     * @brief 현재 링크 수를 반환합니다.
+     * @return int : 링크 수.
+     */
+    int getLinkCount() const;
+
+    /**
+     * @fn std::uint64_t ClusterRelay::getRelayedCount() const
+     * @brief 다른 노드로 보낸 SEQUENCED 프레임 수를 반환합니다.
+     * @return std::uint64_t : 보낸 수 (링크별로 셉니다).
+     */
+    std::uint64_t getRelayedCount() const;
+
+    /**
+     * @fn std::uint64_t ClusterRelay::getSkippedCount() const
+     * @brief 접속자가 없어 보내지 않은 링크별 채팅 수를 반환합니다.
+     * @return std::uint64_t : 건너뛴 수.
+     */
+    std::uint64_t getSkippedCount() const;
+
+    /**
+     * @fn std::uint64_t ClusterRelay::getReceivedCount() const
+     * @brief 다른 노드에서 받은 SEQUENCED 프레임 수를 반환합니다.
+     * @return std::uint64_t : 받은 수.
+     */
+    std::uint64_t getReceivedCount() const;
+
+    /**
+     * @fn std::uint64_t ClusterRelay::getForwardedCount() const
+     * @brief 주인 노드로 넘긴 PUBLISH 프레임 수를 반환합니다.
+     * @return std::uint64_t : 넘긴 수.
+     */
+    std::uint64_t getForwardedCount() const;
+
+    /**
+     * @fn std::uint64_t ClusterRelay::getBatchCount() const
+     * @brief 프레임 묶음을 보낸 send 호출 수를 반환합니다.
+     * @return std::uint64_t : send 호출 수.
+     */
+    std::uint64_t getBatchCount() const;
+
+private:
+    /**
+     * @struct ClusterRelay::Peer
+     * @brief 등록된 다른 노드 하나.
+     */
+    struct Peer
+    {
+        std::string host;                                   ///< IPv4 주소.
+        int port;                                           ///< 클러스터 포트.
+        bool linked;                                        ///< 이 노드가 연결한 링크가 살아 있는지 여부.
+        NetworkTransport::Clock::time_point nextAttempt;    ///< 다음 연결 시도 시각.
+        SOCKET connectingSocket;                            ///< 연결이 끝나기를 기다리는 소켓 (없으면 INVALID_SOCKET).
+        NetworkTransport::Clock::time_point connectDeadline; ///< 연결을 포기할 시각.
+    };
+
+    /**
+     * @struct ClusterRelay::Link
+     * @brief 다른 노드와의 링크 하나.
+     */
+    struct Link
+    {
+        SOCKET socket;          ///< 링크 소켓.
+        int peerIndex;          ///< 이 노드가 연결한 링크이면 _peers 위치, 수락한 링크이면 -1.
+        int peerPort;           ///< HELLO로 받은 상대 클러스터 포트 (받기 전에는 0).
+        bool peerHasMembers;    ///< 상대 노드에 접속자가 있는지 여부.
+        bool peerReady;         ///< 상대 노드에서 READY를 받았는지 여부.
+        std::string inbound;    ///< 아직 프레임이 다 오지 않은 수신 데이터.
+        std::string outbound;   ///< 아직 보내지 못한 프레임.
+    };
+
+    /// 프레임 머리(본문 길이 2바이트 + 종류 1바이트) 크기.
+    static constexpr std::size_t FRAME_HEADER_SIZE = 3;
+
+    /// 한 번의 recv로 읽는 최대 바이트 수.
+    static constexpr int RECEIVE_CHUNK_SIZE = 16384;
+
+private:
+    /// 소켓 호출에 사용할 전송 계층.
+    Transport& _transport;
+
+    /// 클러스터 리스닝 소켓.
+    SOCKET _listenSocket;
+
+    /// 이 노드의 클러스터 포트.
+    int _port;
+
+    /// 등록된 다른 노드.
+    std::vector<ClusterRelay::Peer> _peers;
+
+    /// 살아 있는 링크.
+    std::vector<ClusterRelay::Link> _links;
+
+    /// 마지막으로 알린 로컬 접속자 유무.
+    bool _localHasMembers;
+
+    /// READY를 보냈는지 여부.
+    bool _ready;
+
+    /// open()한 시각. READY_GRACE_MS를 잽니다.
+    NetworkTransport::Clock::time_point _openedAt;
+
+    /// recv 버퍼.
+    std::vector<char> _receiveBuffer;
+
+    /// 보낸 SEQUENCED 프레임 수.
+    std::uint64_t _relayedCount;
+
+    /// 접속자가 없어 건너뛴 SEQUENCED 수.
+    std::uint64_t _skippedCount;
+
+    /// 받은 SEQUENCED 프레임 수.
+    std::uint64_t _receivedCount;
+
+    /// 넘긴 PUBLISH 프레임 수.
+    std::uint64_t _forwardedCount;
+
+    /// 묶음 send 호출 수.
+    std::uint64_t _batchCount;
+
+private:
+    /**
+     * @fn void ClusterRelay::addLink(SOCKET link_socket, int peer_index)
+     * @brief 링크를 등록하고 HELLO와 현재 MEMBERS를, 준비가 끝났으면 READY도 쌓습니다.
+     * @param[IN] SOCKET link_socket : 링크 소켓.
+     * @param[IN] int peer_index : 이 노드가 연결했으면 _peers 위치, 수락했으면 -1.
+     * @return 없음.
+     */
+    void addLink(SOCKET link_socket, int peer_index);
+
+    /**
+     * @fn void ClusterRelay::closeLink(std::size_t position)
+     * @brief 링크를 닫고 목록에서 뺍니다. 이 노드가 연결한 링크이면 재연결을 예약합니다.
+     * @param[IN] std::size_t position : _links에서의 위치.
+     * @return 없음.
+     */
+    void closeLink(std::size_t position);
+
+    /**
+     * @fn void ClusterRelay::abandonConnect(ClusterRelay::Peer& peer)
+     * @brief 끝나지 않았거나 실패한 연결의 소켓을 닫습니다. 다시 시도할 시각은 연결을 시작할 때 정해 둔 nextAttempt를 따릅니다.
+     * @param[IN, OUT] ClusterRelay::Peer& peer : 연결 중인 노드.
+     * @return 없음.
+     */
+    void abandonConnect(ClusterRelay::Peer& peer);
+
+    /**
+     * @fn ClusterRelay::Link* ClusterRelay::findLink(int node)
+     * @brief 상대 노드와의 링크를 찾습니다.
+     * @param[IN] int node : 상대 노드의 클러스터 포트.
+     * @return ClusterRelay::Link* : 링크, HELLO를 받은 링크가 없으면 nullptr.
+     */
+    ClusterRelay::Link* findLink(int node);
+
+    /**
+     * @fn bool ClusterRelay::isLinkedToEveryPeer() const
+     * @brief 등록된 노드 모두와 HELLO를 주고받은 링크가 있는지 확인합니다.
+     * @return bool : 모두 연결되어 있으면 true.
+     */
+    bool isLinkedToEveryPeer() const;
+
+    /**
+     * @fn bool ClusterRelay::handleFrame(ClusterRelay::Link& link, ClusterRelay::FrameType type, const char* body, std::size_t length, std::vector<ClusterRelay::Message>& messages)
+     * @brief 받은 프레임 하나를 처리합니다.
+     * @param[IN, OUT] ClusterRelay::Link& link : 프레임을 받은 링크.
+     * @param[IN] ClusterRelay::FrameType type : 프레임 종류.
+     * @param[IN] const char* body : 본문.
+     * @param[IN] std::size_t length : 본문 길이.
+     * @param[OUT] std::vector<ClusterRelay::Message>& messages : 받은 채팅방 프레임.
+     * @return bool : 올바른 프레임이면 true, 알 수 없는 종류이거나 본문이 잘못되었으면 false.
+     */
+    bool handleFrame(ClusterRelay::Link& link, ClusterRelay::FrameType type, const char* body, std::size_t length, std::vector<ClusterRelay::Message>& messages);
+
+    /**
+     * @fn static std::string ClusterRelay::makeRoomBody(const std::string& room)
+     * @brief 채팅방 프레임 본문의 앞부분([방 ID 길이][방 ID])을 만듭니다.
+     * @param[IN] const std::string& room : 채팅방 ID (MAX_ROOM_ID_LENGTH 이하).
+     * @return std::string : 본문 앞부분.
+     */
+    static std::string makeRoomBody(const std::string& room);
+
+    /**
+     * @fn static void ClusterRelay::appendSequence(std::string& body, std::uint64_t sequence)
+     * @brief 순번 8바이트를 리틀 엔디언으로 덧붙입니다.
+     * @param[OUT] std::string& body : 프레임 본문.
+     * @param[IN] std::uint64_t sequence : 순번.
+     * @return 없음.
+     */
+    static void appendSequence(std::string& body, std::uint64_t sequence);
+
+    /**
+     * @fn static void ClusterRelay::appendFrame(std::string& out, ClusterRelay::FrameType type, const char* body, std::size_t length)
+     * @brief 프레임 하나를 버퍼 끝에 덧붙입니다.
+     * @param[OUT] std::string& out : 송신 버퍼.
+     * @param[IN] ClusterRelay::FrameType type : 프레임 종류.
+     * @param[IN] const char* body : 본문.
+     * @param[IN] std::size_t length : 본문 길이 (MAX_FRAME_SIZE 이하).
+     * @return 없음.
+     */
+    static void appendFrame(std::string& out, ClusterRelay::FrameType type, const char* body, std::size_t length);
+};
@@ -0,0 +1,266 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file CommandParser.cpp
+ * @brief CommandParser.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "CommandParser.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 명령 표의 한 줄.
+ */
+struct CommandEntry
+{
+    std::string_view name;                  ///< 명령 이름 (첫 공백 전까지, 8바이트 이하).
+    CommandParser::Command command;         ///< 명령 종류.
+    CommandParser::Arguments arguments;     ///< 인자 허용 방식.
+};
+
+/// 명령 표. 이 표만 고치면 해시와 첫 바이트 표는 컴파일할 때 다시 만들어집니다.
+static constexpr CommandEntry COMMAND_TABLE[] =
+{
+    { "quit",       CommandParser::Command::QUIT,        CommandParser::Arguments::NONE },
+    { "/users",     CommandParser::Command::USERS,       CommandParser::Arguments::NONE },
+    { "/pos",       CommandParser::Command::POS,         CommandParser::Arguments::REQUIRED },
+    { "/say",       CommandParser::Command::SAY,         CommandParser::Arguments::REQUIRED },
+    { "/status",    CommandParser::Command::STATUS,      CommandParser::Arguments::OPTIONAL },
+    { "/resume",    CommandParser::Command::RESUME,      CommandParser::Arguments::REQUIRED },
+    { "/ignore",    CommandParser::Command::IGNORE_USER, CommandParser::Arguments::REQUIRED },
+    { "/mute",      CommandParser::Command::MUTE_USER,   CommandParser::Arguments::REQUIRED },
+    { "/mod",       CommandParser::Command::MODERATOR,   CommandParser::Arguments::REQUIRED },
+    { "/top",       CommandParser::Command::TOP,         CommandParser::Arguments::OPTIONAL },
+    { "/roster",    CommandParser::Command::ROSTER,      CommandParser::Arguments::NONE },
+    { "/reload",    CommandParser::Command::RELOAD,      CommandParser::Arguments::NONE },
+};
+
+static constexpr std::size_t COMMAND_COUNT = sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]);
+
+/// 명령 이름의 최대 길이. 이름을 64비트 정수 하나로 묶어 해시하고 비교합니다.
+static constexpr std::size_t MAX_NAME_LENGTH = 8;
+
+/// 해시 슬롯 수. 명령 수의 두 배 이상인 2의 거듭제곱입니다.
+static constexpr std::size_t SLOT_COUNT = std::bit_ceil(COMMAND_COUNT * 2);
+
+/// 슬롯 번호에 쓰는 해시 상위 비트 수.
+static constexpr int SLOT_BITS = std::countr_zero(SLOT_COUNT);
+
+/**
+ * @brief 8바이트 이하의 이름을 작은 주소가 첫 글자인 64비트 정수로 묶습니다.
+ */
+static constexpr std::uint64_t pack_name(std::string_view name)
+{
+    std::uint64_t packed = 0;
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        packed = packed | ((std::uint64_t)(unsigned char)name[i] << (8 * i));
+    }
+    return (packed);
+}
+
+/**
+ * @brief 시드를 섞은 곱셈 해시의 상위 비트로 슬롯을 구합니다.
+ */
+static constexpr std::size_t hash_slot(std::uint64_t packed, std::uint64_t seed)
+{
+    return ((std::size_t)(((packed ^ seed) * 0x9E3779B97F4A7C15ull) >> (64 - SLOT_BITS)));
+}
+
+/**
+ * @brief 표의 모든 이름이 서로 다른 슬롯에 들어가는 가장 작은 시드를 찾습니다. 찾지 못하면 UINT64_MAX.
+ */
+static constexpr std::uint64_t find_perfect_seed()
+{
+    for (std::uint64_t seed = 0; seed < 4096; ++seed)
+    {
+        bool used[SLOT_COUNT] = {};
+        bool collided = false;
+        for (const CommandEntry& entry : COMMAND_TABLE)
+        {
+            std::size_t slot = hash_slot(pack_name(entry.name), seed);
+            if (used[slot])
+            {
+                collided = true;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (collided == false)
+        {
+            return (seed);
+        }
+    }
+    return (UINT64_MAX);
+}
+
+/**
+ * @brief 모든 명령 이름이 비어 있지 않고 MAX_NAME_LENGTH 이하인지 확인합니다.
+ */
+static constexpr bool check_name_lengths()
+{
+    for (const CommandEntry& entry : COMMAND_TABLE)
+    {
+        if (entry.name.empty() || entry.name.size() > MAX_NAME_LENGTH)
+        {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+static_assert(check_name_lengths(), "명령 이름은 1~8바이트여야 합니다.");
+
+static constexpr std::uint64_t COMMAND_SEED = find_perfect_seed();
+static_assert(COMMAND_SEED != UINT64_MAX, "명령 표에 맞는 완전 해시 시드를 찾지 못했습니다. SLOT_COUNT를 늘리세요.");
+
+/**
+ * @brief 해시 슬롯 하나. 파싱 중에 명령 표를 따로 찾지 않도록 필요한 값을 모두 담습니다.
+ */
+struct CommandSlot
+{
+    std::uint64_t name;                 ///< 묶은 이름 (빈 슬롯은 0이며, 명령 후보의 묶은 이름은 0이 될 수 없습니다).
+    std::uint8_t length;                ///< 이름 길이 (이름 안의 '\0'으로 길이만 다른 줄을 거릅니다).
+    std::uint8_t allowed;               ///< 인자 없이 허용하면 1번 비트, 인자와 함께 허용하면 2번 비트.
+    CommandParser::Command command;     ///< 명령 종류.
+};
+
+/**
+ * @brief 슬롯 배열을 만듭니다.
+ */
+static constexpr std::array<CommandSlot, SLOT_COUNT> build_slots()
+{
+    std::array<CommandSlot, SLOT_COUNT> slots = {};
+    for (const CommandEntry& entry : COMMAND_TABLE)
+    {
+        CommandSlot& slot = slots[hash_slot(pack_name(entry.name), COMMAND_SEED)];
+        slot.name = pack_name(entry.name);
+        slot.length = (std::uint8_t)entry.name.size();
+        slot.allowed = (std::uint8_t)(((entry.arguments != CommandParser::Arguments::REQUIRED) ? 1 : 0) |
+                                      ((entry.arguments != CommandParser::Arguments::NONE) ? 2 : 0));
+        slot.command = entry.command;
+    }
+    return (slots);
+}
+
+/**
+ * @brief 어떤 명령의 첫 글자가 될 수 있는 바이트 표를 만듭니다.
+ */
+static constexpr std::array<bool, 256> build_lead_bytes()
+{
+    std::array<bool, 256> lead_bytes = {};
+    for (const CommandEntry& entry : COMMAND_TABLE)
+    {
+        lead_bytes[(unsigned char)entry.name[0]] = true;
+    }
+    return (lead_bytes);
+}
+
+static constexpr std::array<CommandSlot, SLOT_COUNT> COMMAND_SLOTS = build_slots();
+static constexpr std::array<bool, 256> COMMAND_LEAD_BYTES = build_lead_bytes();
+
+CommandParser::Tokenizer::Tokenizer(std::string_view text)
+    : _text(text)
+{
+}
+
+bool CommandParser::Tokenizer::next(std::string_view& token)
+{
+    std::size_t begin = this->_text.find_first_not_of(' ');
+    if (begin == std::string_view::npos)
+    {
+        this->_text = std::string_view();
+        return (false);
+    }
+
+    std::size_t end = this->_text.find(' ', begin);
+    if (end == std::string_view::npos)
+    {
+        end = this->_text.size();
+    }
+
+    token = this->_text.substr(begin, end - begin);
+    this->_text.remove_prefix(end);
+    return (true);
+}
+
+std::string_view CommandParser::Tokenizer::rest() const
+{
+    std::size_t begin = this->_text.find_first_not_of(' ');
+    if (begin == std::string_view::npos)
+    {
+        return (std::string_view());
+    }
+    return (this->_text.substr(begin));
+}
+
+CommandParser::Command CommandParser::parse(std::string_view line, std::string_view& arguments)
+{
+    arguments = std::string_view();
+
+    // 일반 채팅은 첫 바이트 하나만 보고 돌려보냅니다.
+    if (line.empty() || COMMAND_LEAD_BYTES[(unsigned char)line[0]] == false)
+    {
+        return (CommandParser::Command::CHAT);
+    }
+
+    // 앞 8바이트를 한 번에 읽고(리틀 엔디언), 그 안의 첫 공백을 SWAR로 찾아 이름만 남깁니다.
+    std::uint64_t word = 0;
+    if (line.size() >= MAX_NAME_LENGTH)
+    {
+        std::memcpy(&word, line.data(), MAX_NAME_LENGTH);
+    }
+    else
+    {
+        word = pack_name(line);
+    }
+
+    std::uint64_t spaces = word ^ 0x2020202020202020ull;
+    std::uint64_t space_bits = (spaces - 0x0101010101010101ull) & ~spaces & 0x8080808080808080ull;
+
+    std::size_t length = (line.size() < MAX_NAME_LENGTH) ? line.size() : MAX_NAME_LENGTH;
+    if (space_bits != 0)
+    {
+        // 가장 낮은 비트는 정확하므로 그것이 첫 공백입니다.
+        length = (std::size_t)std::countr_zero(space_bits) / 8;
+    }
+    else if (line.size() > MAX_NAME_LENGTH && line[MAX_NAME_LENGTH] != ' ')
+    {
+        // 9번째 바이트도 공백이 아니면 가장 긴 이름보다 깁니다.
+        return (CommandParser::Command::CHAT);
+    }
+    std::uint64_t packed = (length == MAX_NAME_LENGTH) ? word : (word & ((1ull << (8 * length)) - 1));
+
+    // 완전 해시이므로 슬롯 하나와 정수 비교로 끝납니다.
+    const CommandSlot& slot = COMMAND_SLOTS[hash_slot(packed, COMMAND_SEED)];
+    std::size_t has_arguments = (length < line.size()) ? 1 : 0;
+    std::uint64_t mismatch = (slot.name ^ packed) | (slot.length ^ length) | ((((std::size_t)slot.allowed >> has_arguments) & 1) ^ 1);
+    if (mismatch != 0)
+    {
+        return (CommandParser::Command::CHAT);
+    }
+
+    if (has_arguments)
+    {
+        arguments = line.substr(length + 1);
+    }
+    return (slot.command);
+}
+
+std::string CommandParser::redactSecrets(std::string_view line)
+{
+    std::string_view arguments;
+    CommandParser::Command command = CommandParser::parse(line, arguments);
+    if (command != CommandParser::Command::MODERATOR && command != CommandParser::Command::RESUME)
+    {
+        return (std::string(line));
+    }
+
+    // 운영자 암호와 재접속 토큰은 로그 파일을 읽을 수 있는 사람에게도 드러나면 안 됩니다.
+    return (std::string(line.substr(0, line.size() - arguments.size())) + "***");
+}
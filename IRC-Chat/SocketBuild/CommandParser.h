@@ -0,0 +1,117 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file CommandParser.h
+ * @brief 수신한 한 줄이 어떤 명령인지 가려내는 CommandParser 클래스와 인자 분리기를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 명령 목록은 CommandParser.cpp의 constexpr 표 하나에 모여 있고, 컴파일할 때 표에 맞는 완전 해시의 시드와 슬롯 배열을 만듭니다.
+ * <br>이름(8바이트 이하)은 64비트 정수 하나로 묶어 해시하고 비교하므로, 명령이 늘어도 한 줄을 가려내는 비용은 곱셈 한 번과 정수 비교 한 번으로 같습니다.
+ * <br>대부분의 줄은 일반 채팅이므로, 첫 바이트가 어떤 명령의 첫 글자도 아니면 표를 보지 않고 바로 CHAT을 돌려줍니다.
+ * <br>명령을 추가하려면 Command에 값을 더하고 표에 한 줄을 넣습니다. 충돌 없는 시드를 찾지 못하면 컴파일이 실패합니다.
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class CommandParser
+ * @brief 한 줄을 명령과 인자로 나누는 정적 함수와, 인자를 공백 단위로 나누는 Tokenizer를 제공합니다.
+ * @note 상태가 없으므로 객체를 만들지 않습니다.
+ */
+class CommandParser
+{
+public:
+    /**
+     * @enum CommandParser::Command
+     * @brief 가려낸 명령 종류.
+     */
+    enum class Command
+    {
+        CHAT,           ///< 명령이 아닌 일반 채팅 (표에 없는 '/' 줄 포함).
+        QUIT,           ///< "quit" : 연결 종료.
+        USERS,          ///< "/users" : 접속자 목록.
+        POS,            ///< "/pos <x> <y> <z>" : 위치 갱신.
+        SAY,            ///< "/say <메시지>" : 근접 채팅.
+        STATUS,         ///< "/status [상태]" : 상태 메시지 변경.
+        RESUME,         ///< "/resume <토큰> <순번>" : 재접속.
+        IGNORE_USER,    ///< "/ignore <닉네임>" : 무시 목록에 넣거나 뺌.
+        MUTE_USER,      ///< "/mute <닉네임>" : 채팅 금지를 걸거나 풂 (운영자 전용).
+        MODERATOR,      ///< "/mod <암호>" : 운영자 권한 얻기.
+        TOP,            ///< "/top [bytes]" : 최근 가장 많이 보낸 송신자 목록 (운영자 전용).
+        ROSTER,         ///< "/roster" : 접속자 목록 바이너리 프레임 받기를 켜거나 끔.
+        RELOAD          ///< "/reload" : 금칙어 파일을 다시 읽음 (운영자 전용).
+    };
+
+    /**
+     * @enum CommandParser::Arguments
+     * @brief 명령 이름 뒤에 인자(공백과 그 뒤의 문자열)가 올 수 있는지 나타냅니다.
+     */
+    enum class Arguments
+    {
+        NONE,       ///< 이름만 와야 함. 뒤에 공백이 있으면 일반 채팅으로 봅니다.
+        OPTIONAL,   ///< 이름만 오거나 공백 뒤에 인자가 옴.
+        REQUIRED    ///< 이름 뒤에 공백이 있어야 함. 없으면 일반 채팅으로 봅니다.
+    };
+
+    /**
+     * @class CommandParser::Tokenizer
+     * @brief 인자 문자열을 공백 단위로 나누어 string_view로 돌려줍니다. 복사하지 않습니다.
+     */
+    class Tokenizer
+    {
+    public:
+        /**
+         * @fn CommandParser::Tokenizer::Tokenizer(std::string_view text)
+         * @brief 나눌 문자열로 분리기를 생성합니다.
+         * @param[IN] std::string_view text : 인자 문자열 (원본이 살아 있는 동안만 사용할 수 있습니다).
+         * @return 없음.
+         */
+        explicit Tokenizer(std::string_view text);
+
+        /**
+         * @fn bool CommandParser::Tokenizer::next(std::string_view& token)
+         * @brief 앞의 공백을 건너뛰고 다음 토큰을 꺼냅니다.
+         * @param[OUT] std::string_view& token : 공백이 없는 토큰.
+         * @return bool : 토큰이 남아 있었으면 true.
+         */
+        bool next(std::string_view& token);
+
+        /**
+         * @fn std::string_view CommandParser::Tokenizer::rest() const
+         * @brief 아직 꺼내지 않은 나머지를 앞의 공백을 뺀 채로 돌려줍니다. (마지막 인자가 문장일 때 사용합니다)
+         * @return std::string_view : 나머지 문자열.
+         */
+        std::string_view rest() const;
+
+    private:
+        /// 아직 꺼내지 않은 부분.
+        std::string_view _text;
+    };
+
+public:
+    // 정적 함수만 제공하므로 생성하지 않습니다.
+    CommandParser() = delete;
+
+public:
+    /**
+     * @fn static CommandParser::Command CommandParser::parse(std::string_view line, std::string_view& arguments)
+     * @brief 한 줄이 어떤 명령인지 가려내고 인자 부분을 돌려줍니다.
+     * @param[IN] std::string_view line : 줄 끝 문자를 제거한 한 줄.
+     * @param[OUT] std::string_view& arguments : 이름 뒤 첫 공백 다음부터 끝까지 (인자가 없거나 CHAT이면 빈 값).
+     * @return CommandParser::Command : 명령 종류.
+     */
+    static CommandParser::Command parse(std::string_view line, std::string_view& arguments);
+
+    /**
+     * @fn static std::string CommandParser::redactSecrets(std::string_view line)
+     * @brief 로그에 남길 수 있도록 비밀 인자를 가린 줄을 만듭니다.
+     * @param[IN] std::string_view line : 줄 끝 문자를 제거한 한 줄.
+     * @return std::string : "/mod"와 "/resume"이면 인자를 "***"로 바꾼 줄, 그 밖에는 원래 줄.
+     */
+    static std::string redactSecrets(std::string_view line);
+};
@@ -0,0 +1,123 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file CoroutineFramePool.cpp
+ * @brief CoroutineFramePool.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "CoroutineFramePool.h"
+#include "DebugHelper.h"
+#include <new>
+
+CoroutineFramePool& CoroutineFramePool::getInstance()
+{
+    // 첫 사용 시 한 번만 생성됩니다.
+    static CoroutineFramePool instance;
+    return (instance);
+}
+
+CoroutineFramePool::CoroutineFramePool()
+    : _freeLists(), _chunks(), _fallbackCount(0)
+{
+    this->_freeLists.fill(nullptr);
+}
+
+CoroutineFramePool::~CoroutineFramePool()
+{
+    // 확보했던 청크를 모두 해제합니다.
+    for (void* chunk : this->_chunks)
+    {
+        ::operator delete(chunk);
+    }
+}
+
+void* CoroutineFramePool::allocate(std::size_t size)
+{
+    int size_class = this->findSizeClass(size);
+
+    // 풀에서 다룰 수 없는 큰 프레임은 전역 할당자로 넘깁니다.
+    if (size_class == -1)
+    {
+        this->_fallbackCount = this->_fallbackCount + 1;
+        return (::operator new(size));
+    }
+
+    // 자유 목록이 비었다면 청크를 새로 확보합니다.
+    if (this->_freeLists[size_class] == nullptr)
+    {
+        this->refill(size_class);
+    }
+
+    // 자유 목록의 첫 블록을 꺼냅니다.
+    FreeBlock* block = this->_freeLists[size_class];
+    this->_freeLists[size_class] = block->next;
+
+    return (block);
+}
+
+void CoroutineFramePool::deallocate(void* frame, std::size_t size)
+{
+    if (frame == nullptr)
+    {
+        return ;
+    }
+
+    int size_class = this->findSizeClass(size);
+
+    // 전역 할당자로 받은 프레임은 그대로 돌려줍니다.
+    if (size_class == -1)
+    {
+        ::operator delete(frame);
+        return ;
+    }
+
+    // 블록을 자유 목록 맨 앞에 다시 연결합니다.
+    FreeBlock* block = static_cast<FreeBlock*>(frame);
+    block->next = this->_freeLists[size_class];
+    this->_freeLists[size_class] = block;
+}
+
+std::size_t CoroutineFramePool::getChunkCount() const
+{
+    return (this->_chunks.size());
+}
+
+std::size_t CoroutineFramePool::getFallbackCount() const
+{
+    return (this->_fallbackCount);
+}
+
+int CoroutineFramePool::findSizeClass(std::size_t size) const
+{
+    std::size_t block_size = CoroutineFramePool::MIN_BLOCK_SIZE;
+
+    for (int i = 0; i < CoroutineFramePool::SIZE_CLASS_COUNT; ++i)
+    {
+        if (size <= block_size)
+        {
+            return (i);
+        }
+        block_size = block_size * 2;
+    }
+
+    return (-1);
+}
+
+void CoroutineFramePool::refill(int size_class)
+{
+    std::size_t block_size = CoroutineFramePool::MIN_BLOCK_SIZE << size_class;
+    char* chunk = static_cast<char*>(::operator new(block_size * CoroutineFramePool::BLOCKS_PER_CHUNK));
+    this->_chunks.push_back(chunk);
+
+    // 청크를 블록 단위로 잘라 자유 목록에 연결합니다.
+    for (int i = 0; i < CoroutineFramePool::BLOCKS_PER_CHUNK; ++i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + block_size * i);
+        block->next = this->_freeLists[size_class];
+        this->_freeLists[size_class] = block;
+    }
+
+    LOG_DEBUG("코루틴 프레임 청크 확보 - 블록 크기: " + std::to_string(block_size) + ", 청크 수: " + std::to_string(this->_chunks.size()));
+}
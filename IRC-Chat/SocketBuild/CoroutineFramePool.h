@@ -0,0 +1,138 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file CoroutineFramePool.h
+ * @brief 세션 코루틴 프레임을 재사용하는 CoroutineFramePool 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 코루틴 프레임을 크기별 블록으로 나누어 자유 목록(free list)에 보관하고 재사용합니다.
+ * <br>초기 예열 이후에는 세션 코루틴을 생성하거나 중단/재개할 때 힙 할당이 발생하지 않습니다.
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class CoroutineFramePool
+ * @brief 코루틴 프레임 메모리를 크기 등급별로 풀링하는 할당자입니다.
+ *
+ * @details
+ * MIN_BLOCK_SIZE부터 두 배씩 커지는 SIZE_CLASS_COUNT개의 크기 등급을 관리합니다.
+ * <br>각 등급의 자유 목록이 비면 BLOCKS_PER_CHUNK개의 블록을 한 번에 확보합니다.
+ * <br>가장 큰 등급보다 큰 프레임은 전역 operator new로 처리합니다.
+ *
+ * @note 서버 루프는 단일 스레드로 동작하므로 이 클래스는 스레드 안전하지 않습니다.
+ */
+class CoroutineFramePool
+{
+public:
+    /// 가장 작은 블록 크기(바이트 단위).
+    static const std::size_t MIN_BLOCK_SIZE = 128;
+
+    /// 크기 등급 수 (128, 256, 512, 1024, 2048, 4096 바이트).
+    static const int SIZE_CLASS_COUNT = 6;
+
+    /// 자유 목록이 비었을 때 한 번에 확보할 블록 수.
+    static const int BLOCKS_PER_CHUNK = 32;
+
+public:
+    /**
+     * @fn CoroutineFramePool& CoroutineFramePool::getInstance()
+     * @brief 서버 전체에서 공유하는 프레임 풀을 반환합니다.
+     * @return CoroutineFramePool& : 프레임 풀 인스턴스.
+     * @note 코루틴 promise의 operator new/delete에서 사용합니다.
+     */
+    static CoroutineFramePool& getInstance();
+
+    /**
+     * @fn CoroutineFramePool::CoroutineFramePool()
+     * @brief 비어 있는 프레임 풀을 생성합니다.
+     * @return 없음.
+     */
+    CoroutineFramePool();
+
+    /**
+     * @fn CoroutineFramePool::~CoroutineFramePool()
+     * @brief 확보했던 모든 청크 메모리를 해제합니다.
+     * @return 없음.
+     */
+    ~CoroutineFramePool();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    CoroutineFramePool(const CoroutineFramePool& obj) = delete;
+    CoroutineFramePool& operator=(const CoroutineFramePool& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    CoroutineFramePool(CoroutineFramePool&& obj) = delete;
+    CoroutineFramePool& operator=(CoroutineFramePool&& obj) = delete;
+
+public:
+    /**
+     * @fn void* CoroutineFramePool::allocate(std::size_t size)
+     * @brief 주어진 크기 이상의 프레임 블록을 할당합니다.
+     * @param[IN] std::size_t size : 요청한 프레임 크기(바이트 단위).
+     * @return void* : 할당된 블록의 주소.
+     */
+    void* allocate(std::size_t size);
+
+    /**
+     * @fn void CoroutineFramePool::deallocate(void* frame, std::size_t size)
+     * @brief 사용이 끝난 프레임 블록을 자유 목록에 반납합니다.
+     * @param[IN] void* frame : allocate()로 받은 블록의 주소.
+     * @param[IN] std::size_t size : allocate()에 전달했던 크기.
+     * @return 없음.
+     */
+    void deallocate(void* frame, std::size_t size);
+
+    /**
+     * @fn std::size_t CoroutineFramePool::getChunkCount() const
+     * @brief 지금까지 확보한 청크 수를 반환합니다.
+     * @return std::size_t : 확보한 청크 수.
+     * @note 예열 이후 값이 증가하지 않는다면 프레임이 모두 재사용되고 있다는 뜻입니다.
+     */
+    std::size_t getChunkCount() const;
+
+    /**
+     * @fn std::size_t CoroutineFramePool::getFallbackCount() const
+     * @brief 풀의 최대 등급을 넘어 전역 operator new로 처리된 할당 횟수를 반환합니다.
+     * @return std::size_t : 풀 밖에서 처리된 할당 횟수.
+     */
+    std::size_t getFallbackCount() const;
+
+private:
+    /// 자유 목록에 연결되는 블록 헤더.
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    /// 크기 등급별 자유 목록의 첫 블록.
+    std::array<FreeBlock*, SIZE_CLASS_COUNT> _freeLists;
+
+    /// 확보한 청크들의 시작 주소 (소멸 시 해제).
+    std::vector<void*> _chunks;
+
+    /// 풀 밖에서 처리된 할당 횟수.
+    std::size_t _fallbackCount;
+
+private:
+    /**
+     * @fn int CoroutineFramePool::findSizeClass(std::size_t size) const
+     * @brief 요청 크기를 담을 수 있는 가장 작은 크기 등급을 찾습니다.
+     * @param[IN] std::size_t size : 요청 크기.
+     * @return int : 크기 등급 인덱스, 가장 큰 등급보다 크면 -1.
+     */
+    int findSizeClass(std::size_t size) const;
+
+    /**
+     * @fn void CoroutineFramePool::refill(int size_class)
+     * @brief 새 청크를 확보하여 해당 등급의 자유 목록을 채웁니다.
+     * @param[IN] int size_class : 채울 크기 등급 인덱스.
+     * @return 없음.
+     */
+    void refill(int size_class);
+};
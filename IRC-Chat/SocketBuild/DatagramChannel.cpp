@@ -0,0 +1,244 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file DatagramChannel.cpp
+ * @brief DatagramChannel.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "DatagramChannel.h"
+#include "DebugHelper.h"
+#include "TransportInstances.h"
+#include <cstring>
+
+template <typename Transport>
+DatagramChannel<Transport>::DatagramChannel(Transport& transport, int capacity)
+    : _transport(transport), _socket(INVALID_SOCKET), _port(0), _inbox(DatagramChannel::BATCH_SIZE),
+      _outbox(DatagramChannel::SEND_BATCH_SIZE), _outboxCount(0), _endpoints(capacity), _receivedCount(0), _sentCount(0),
+      _droppedCount(0)
+{
+    for (DatagramChannel::Endpoint& endpoint : this->_endpoints)
+    {
+        endpoint.bound = false;
+        endpoint.address = {};
+    }
+    LOG_DEBUG("DatagramChannel 객체를 생성합니다.");
+}
+
+template <typename Transport>
+DatagramChannel<Transport>::~DatagramChannel()
+{
+    this->close();
+    LOG_DEBUG("DatagramChannel 객체를 삭제합니다.");
+}
+
+template <typename Transport>
+DatagramChannelBase::Result DatagramChannel<Transport>::open(int port)
+{
+    this->_socket = this->_transport.createDatagramSocket();
+    if (this->_socket == INVALID_SOCKET)
+    {
+        LOG_ERROR("UDP 소켓 생성 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+        return (DatagramChannel::Result::FAIL_CREATE);
+    }
+
+    if (this->_transport.bindSocket(this->_socket, port) == SOCKET_ERROR)
+    {
+        LOG_ERROR("UDP 소켓 바인드 실패. 오류 코드: " + std::to_string(this->_transport.getLastError()));
+        this->_transport.closeSocket(this->_socket);
+        this->_socket = INVALID_SOCKET;
+        return (DatagramChannel::Result::FAIL_BIND);
+    }
+
+    this->_port = port;
+    LOG_INFO("UDP 이벤트 채널을 열었습니다. 포트: " + std::to_string(port));
+    return (DatagramChannel::Result::SUCCESS);
+}
+
+template <typename Transport>
+void DatagramChannel<Transport>::close()
+{
+    if (this->_socket == INVALID_SOCKET)
+    {
+        return ;
+    }
+
+    this->_transport.closeSocket(this->_socket);
+    this->_socket = INVALID_SOCKET;
+    this->_port = 0;
+    this->_outboxCount = 0;
+    for (DatagramChannel::Endpoint& endpoint : this->_endpoints)
+    {
+        endpoint.bound = false;
+    }
+}
+
+template <typename Transport>
+bool DatagramChannel<Transport>::isOpen() const
+{
+    return (this->_socket != INVALID_SOCKET);
+}
+
+template <typename Transport>
+SOCKET DatagramChannel<Transport>::getSocket() const
+{
+    return (this->_socket);
+}
+
+template <typename Transport>
+int DatagramChannel<Transport>::getPort() const
+{
+    return (this->_port);
+}
+
+template <typename Transport>
+int DatagramChannel<Transport>::receiveBatch()
+{
+    int count = 0;
+
+    while (count < DatagramChannel::BATCH_SIZE)
+    {
+        DatagramChannel::Datagram& datagram = this->_inbox[count];
+        int receive_result = this->_transport.receiveDatagram(this->_socket, datagram.data, DatagramChannel::MAX_DATAGRAM_SIZE, &datagram.address);
+
+        if (receive_result == SOCKET_ERROR)
+        {
+            int error_code = this->_transport.getLastError();
+
+            // 너무 큰 데이터그램과 도달 불가 통지는 해당 데이터그램만 건너뜁니다.
+            if (error_code == WSAEMSGSIZE)
+            {
+                this->_droppedCount = this->_droppedCount + 1;
+                continue;
+            }
+            if (error_code == WSAECONNRESET)
+            {
+                continue;
+            }
+            if (error_code != WSAEWOULDBLOCK)
+            {
+                LOG_WARN("UDP 수신 실패. 오류 코드: " + std::to_string(error_code));
+            }
+            break;
+        }
+
+        datagram.length = receive_result;
+        count = count + 1;
+    }
+
+    this->_receivedCount = this->_receivedCount + count;
+    return (count);
+}
+
+template <typename Transport>
+const DatagramChannelBase::Datagram& DatagramChannel<Transport>::getReceived(int position) const
+{
+    return (this->_inbox[position]);
+}
+
+template <typename Transport>
+void DatagramChannel<Transport>::queueSend(const sockaddr_in& to_addr, const char* data, int length)
+{
+    if (length > DatagramChannel::MAX_DATAGRAM_SIZE)
+    {
+        this->_droppedCount = this->_droppedCount + 1;
+        return ;
+    }
+
+    if (this->_outboxCount == DatagramChannel::SEND_BATCH_SIZE)
+    {
+        this->flushSends();
+    }
+
+    DatagramChannel::Datagram& datagram = this->_outbox[this->_outboxCount];
+    datagram.address = to_addr;
+    datagram.length = length;
+    std::memcpy(datagram.data, data, length);
+    this->_outboxCount = this->_outboxCount + 1;
+}
+
+template <typename Transport>
+int DatagramChannel<Transport>::flushSends()
+{
+    int sent_count = 0;
+
+    for (int i = 0; i < this->_outboxCount; ++i)
+    {
+        const DatagramChannel::Datagram& datagram = this->_outbox[i];
+        int send_result = this->_transport.sendDatagram(this->_socket, datagram.data, datagram.length, datagram.address);
+        if (send_result != SOCKET_ERROR)
+        {
+            sent_count = sent_count + 1;
+            continue;
+        }
+
+        // 송신 버퍼가 가득 찼으면 기다리지 않고 나머지를 버립니다. 늦게 도착한 일회성 이벤트는 의미가 없습니다.
+        int error_code = this->_transport.getLastError();
+        if (error_code == WSAEWOULDBLOCK)
+        {
+            this->_droppedCount = this->_droppedCount + (this->_outboxCount - i);
+            break;
+        }
+
+        // 그 밖의 실패는 해당 주소 문제이므로 다음 데이터그램을 계속 보냅니다.
+        this->_droppedCount = this->_droppedCount + 1;
+    }
+
+    this->_sentCount = this->_sentCount + sent_count;
+    this->_outboxCount = 0;
+    return (sent_count);
+}
+
+template <typename Transport>
+void DatagramChannel<Transport>::bindEndpoint(int client_index, const sockaddr_in& address)
+{
+    if (client_index < 0 || client_index >= (int)this->_endpoints.size())
+    {
+        return ;
+    }
+
+    this->_endpoints[client_index].bound = true;
+    this->_endpoints[client_index].address = address;
+}
+
+template <typename Transport>
+void DatagramChannel<Transport>::unbindEndpoint(int client_index)
+{
+    if (client_index < 0 || client_index >= (int)this->_endpoints.size())
+    {
+        return ;
+    }
+
+    this->_endpoints[client_index].bound = false;
+}
+
+template <typename Transport>
+const sockaddr_in* DatagramChannel<Transport>::findEndpoint(int client_index) const
+{
+    if (client_index < 0 || client_index >= (int)this->_endpoints.size() || this->_endpoints[client_index].bound == false)
+    {
+        return (nullptr);
+    }
+    return (&this->_endpoints[client_index].address);
+}
+
+template <typename Transport>
+std::uint64_t DatagramChannel<Transport>::getReceivedCount() const
+{
+    return (this->_receivedCount);
+}
+
+template <typename Transport>
+std::uint64_t DatagramChannel<Transport>::getSentCount() const
+{
+    return (this->_sentCount);
+}
+
+template <typename Transport>
+std::uint64_t DatagramChannel<Transport>::getDroppedCount() const
+{
+    return (this->_droppedCount);
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(DatagramChannel);
@@ -0,0 +1,259 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file DatagramChannel.h
+ * @brief 자주 바뀌는 일회성 이벤트를 TCP 채팅과 분리해 UDP로 주고받는 DatagramChannel 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 입력 중 표시, 음성 발화 표시, 핑처럼 순서 보장이 필요 없고 늦게 도착하면 의미가 없는 이벤트용 채널입니다.
+ * <br>TCP 리스닝 포트와 같은 번호의 UDP 포트에 바인드되며, 송신은 TCP 송신 대기열을 거치지 않습니다.
+ * <br>한 번 깨어날 때 대기 중인 데이터그램을 BATCH_SIZE개까지 연달아 읽고,
+ * <br>처리 중에 생긴 응답과 팬아웃은 모아 두었다가 flushSends()에서 한 번에 보냅니다.
+ * <br>송신 버퍼가 가득 차면 기다리지 않고 남은 데이터그램을 버립니다.
+ */
+
+#include "NetworkTransport.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class DatagramChannelBase
+ * @brief 전송 계층과 무관한 DatagramChannel의 상수와 타입을 담습니다.
+ *
+ * @note 바깥에서는 DatagramChannelBase::Datagram처럼 씁니다.
+ */
+class DatagramChannelBase
+{
+public:
+    /// 처리하는 데이터그램의 최대 크기(바이트). 더 큰 데이터그램은 버립니다.
+    static const int MAX_DATAGRAM_SIZE = 512;
+
+    /// 한 번의 receiveBatch()에서 읽는 최대 데이터그램 수.
+    static const int BATCH_SIZE = 64;
+
+    /// 송신 대기 버퍼에 모아 둘 수 있는 최대 데이터그램 수. 가득 차면 그 자리에서 보냅니다.
+    static const int SEND_BATCH_SIZE = 256;
+
+public:
+    /**
+     * @enum DatagramChannelBase::Result
+     * @brief DatagramChannel 함수의 반환값.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 성공.
+        FAIL_CREATE,    ///< UDP 소켓 생성 실패.
+        FAIL_BIND       ///< 포트 바인드 실패.
+    };
+
+    /**
+     * @struct DatagramChannelBase::Datagram
+     * @brief 수신했거나 보낼 데이터그램 하나.
+     */
+    struct Datagram
+    {
+        sockaddr_in address;                                ///< 보낸 쪽(수신) 또는 받을 쪽(송신) 주소.
+        int length;                                         ///< 데이터 길이.
+        char data[DatagramChannelBase::MAX_DATAGRAM_SIZE];  ///< 데이터.
+    };
+};
+
+/**
+ * @class DatagramChannel
+ * @brief 논블로킹 UDP 소켓, 일괄 수신/송신 버퍼, 클라이언트 인덱스별 UDP 주소를 관리하는 클래스입니다.
+ * @tparam Transport : 소켓 호출에 사용할 전송 계층 타입.
+ */
+template <typename Transport>
+class DatagramChannel : public DatagramChannelBase
+{
+public:
+    /**
+     * @fn DatagramChannel::DatagramChannel(Transport& transport, int capacity)
+     * @brief 닫힌 상태의 채널을 생성합니다.
+     * @param[IN] Transport& transport : 소켓 호출에 사용할 전송 계층.
+     * @param[IN] int capacity : 최대 클라이언트 수 (UDP 주소 슬롯 수).
+     * @return 없음.
+     */
+    DatagramChannel(Transport& transport, int capacity);
+
+    /**
+     * @fn DatagramChannel::~DatagramChannel()
+     * @brief 소멸자. 열린 소켓을 닫습니다.
+     * @return 없음.
+     */
+    ~DatagramChannel();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    DatagramChannel(const DatagramChannel& obj) = delete;
+    DatagramChannel& operator=(const DatagramChannel& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    DatagramChannel(DatagramChannel&& obj) = delete;
+    DatagramChannel& operator=(DatagramChannel&& obj) = delete;
+
+public:
+    /**
+     * @fn DatagramChannel::Result DatagramChannel::open(int port)
+     * @brief UDP 소켓을 만들어 지정한 포트에 바인드합니다.
+     * @param[IN] int port : 포트 번호.
+     * @return DatagramChannel::Result : 결과 코드.
+     */
+    DatagramChannel::Result open(int port);
+
+    /**
+     * @fn void DatagramChannel::close()
+     * @brief 소켓을 닫고 모든 UDP 주소를 잊습니다.
+     * @return 없음.
+     */
+    void close();
+
+    /**
+     * @fn bool DatagramChannel::isOpen() const
+     * @brief 채널이 열려 있는지 확인합니다.
+     * @return bool : 열려 있으면 true.
+     */
+    bool isOpen() const;
+
+    /**
+     * @fn SOCKET DatagramChannel::getSocket() const
+     * @brief select에 등록할 UDP 소켓을 반환합니다.
+     * @return SOCKET : UDP 소켓, 닫혀 있으면 INVALID_SOCKET.
+     */
+    SOCKET getSocket() const;
+
+    /**
+     * @fn int DatagramChannel::getPort() const
+     * @brief 바인드된 포트를 반환합니다.
+     * @return int : 포트 번호, 닫혀 있으면 0.
+     */
+    int getPort() const;
+
+    /**
+     * @fn int DatagramChannel::receiveBatch()
+     * @brief 대기 중인 데이터그램을 BATCH_SIZE개까지 연달아 읽어 수신 버퍼에 채웁니다.
+     * @return int : 읽은 데이터그램 수. (getReceived()로 꺼냅니다.)
+     *
+     * @details
+     * 더 읽을 것이 없으면(WSAEWOULDBLOCK) 멈춥니다. 너무 큰 데이터그램과
+     * <br>이전에 보낸 데이터그램의 ICMP 도달 불가 통지(WSAECONNRESET)는 건너뛰고 계속 읽습니다.
+     */
+    int receiveBatch();
+
+    /**
+     * @fn const DatagramChannel::Datagram& DatagramChannel::getReceived(int position) const
+     * @brief 마지막 receiveBatch()로 읽은 데이터그램을 반환합니다.
+     * @param[IN] int position : 0부터 (읽은 수 - 1)까지의 위치.
+     * @return const DatagramChannel::Datagram& : 데이터그램.
+     */
+    const DatagramChannel::Datagram& getReceived(int position) const;
+
+    /**
+     * @fn void DatagramChannel::queueSend(const sockaddr_in& to_addr, const char* data, int length)
+     * @brief 보낼 데이터그램을 송신 버퍼에 모읍니다.
+     * @param[IN] const sockaddr_in& to_addr : 받을 쪽 주소.
+     * @param[IN] const char* data : 데이터.
+     * @param[IN] int length : 데이터 길이. MAX_DATAGRAM_SIZE를 넘으면 버립니다.
+     * @return 없음.
+     * @note 송신 버퍼가 가득 차면 먼저 flushSends()를 호출합니다.
+     */
+    void queueSend(const sockaddr_in& to_addr, const char* data, int length);
+
+    /**
+     * @fn int DatagramChannel::flushSends()
+     * @brief 모아 둔 데이터그램을 연달아 보내고 송신 버퍼를 비웁니다.
+     * @return int : 보낸 데이터그램 수.
+     * @note 송신 버퍼가 가득 차(WSAEWOULDBLOCK) 실패하면 기다리지 않고 남은 데이터그램을 버립니다.
+     */
+    int flushSends();
+
+    /**
+     * @fn void DatagramChannel::bindEndpoint(int client_index, const sockaddr_in& address)
+     * @brief 인증된 클라이언트의 UDP 주소를 기억합니다. 이미 있으면 새 주소로 바꿉니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @param[IN] const sockaddr_in& address : 데이터그램을 보낸 주소.
+     * @return 없음.
+     */
+    void bindEndpoint(int client_index, const sockaddr_in& address);
+
+    /**
+     * @fn void DatagramChannel::unbindEndpoint(int client_index)
+     * @brief 클라이언트의 UDP 주소를 잊습니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void unbindEndpoint(int client_index);
+
+    /**
+     * @fn const sockaddr_in* DatagramChannel::findEndpoint(int client_index) const
+     * @brief 클라이언트의 UDP 주소를 찾습니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return const sockaddr_in* : 주소, 없으면 nullptr.
+     */
+    const sockaddr_in* findEndpoint(int client_index) const;
+
+    /**
+     * @fn std::uint64_t DatagramChannel::getReceivedCount() const
+     * @brief 지금까지 받은 데이터그램 수를 반환합니다.
+     * @return std::uint64_t : 받은 수.
+     */
+    std::uint64_t getReceivedCount() const;
+
+    /**
+     * @fn std::uint64_t DatagramChannel::getSentCount() const
+     * @brief 지금까지 보낸 데이터그램 수를 반환합니다.
+     * @return std::uint64_t : 보낸 수.
+     */
+    std::uint64_t getSentCount() const;
+
+    /**
+     * @fn std::uint64_t DatagramChannel::getDroppedCount() const
+     * @brief 너무 크거나 송신 버퍼가 가득 차 버린 데이터그램 수를 반환합니다.
+     * @return std::uint64_t : 버린 수.
+     */
+    std::uint64_t getDroppedCount() const;
+
+private:
+    /**
+     * @struct DatagramChannel::Endpoint
+     * @brief 클라이언트 인덱스 하나의 UDP 주소.
+     */
+    struct Endpoint
+    {
+        bool bound;             ///< 주소가 있는지 여부.
+        sockaddr_in address;    ///< 마지막으로 인증된 데이터그램을 보낸 주소.
+    };
+
+private:
+    /// 소켓 호출에 사용할 전송 계층.
+    Transport& _transport;
+
+    /// UDP 소켓.
+    SOCKET _socket;
+
+    /// 바인드된 포트.
+    int _port;
+
+    /// 수신 버퍼 (BATCH_SIZE개, 미리 할당).
+    std::vector<DatagramChannel::Datagram> _inbox;
+
+    /// 송신 버퍼 (SEND_BATCH_SIZE개, 미리 할당).
+    std::vector<DatagramChannel::Datagram> _outbox;
+
+    /// 송신 버퍼에 모인 데이터그램 수.
+    int _outboxCount;
+
+    /// 클라이언트 인덱스별 UDP 주소.
+    std::vector<DatagramChannel::Endpoint> _endpoints;
+
+    /// 받은 데이터그램 수.
+    std::uint64_t _receivedCount;
+
+    /// 보낸 데이터그램 수.
+    std::uint64_t _sentCount;
+
+    /// 버린 데이터그램 수.
+    std::uint64_t _droppedCount;
+};
@@ -9,7 +9,11 @@
  * 
  * @details
  * 로그 레벨 유형을 정의하고, 현재 시간, 로그 메시지 포맷을 위한 함수를 제공합니다.<br>
- * 로그 레벨 유형을 선택하여 로그를 남길 수 있는 매크로들을 제공합니다.
+ * 타임스탬프는 초가 바뀔 때만 다시 만듭니다. 서버 루프 스레드는 LoopClock이 반복마다 갱신한 문자열을 그대로 씁니다.<br>
+ * 로그 레벨 유형을 선택하여 로그를 남길 수 있는 매크로들을 제공합니다.<br>
+ * 로그 정책은 빌드 시에 정해집니다. 꺼진 레벨의 매크로는 빈 문장이 되어 메시지 문자열도 만들지 않습니다.<br>
+ * - 기본 : INFO/WARNING/ERROR는 항상, DEBUG는 디버그 빌드(_DEBUG)에서만 출력합니다.
+ * - LOG_NULL 정의 : 모든 로그를 컴파일에서 제외합니다. (벤치마크나 부하 측정용. 프로젝트 속성 > C/C++ > 전처리기 정의에 LOG_NULL 추가.)
  */
 
 #include <iostream> 
@@ -33,20 +37,40 @@ enum class LogLevel
 };
 
 /**
- * @fn std::string current_time()
+ * @var loop_timestamp
+ * @brief LoopClock::attachLogger()를 호출한 스레드에서 LoopClock이 캐시한 타임스탬프를 가리킵니다. 그 밖의 스레드에서는 nullptr.
+ */
+inline thread_local const std::string* loop_timestamp = nullptr;
+
+/**
+ * @fn const std::string& current_time()
  * @brief 현재 시스템 시간을 포맷된 문자열로 반환합니다.
- * @return std::string : "YYYY-MM-DD HH:MM:SS" 형식의 현재 시간 문자열.
+ * @return const std::string& : "YYYY-MM-DD HH:MM:SS" 형식의 현재 시간 문자열 (같은 스레드의 다음 호출까지 유효).
  * @note 예시 형식: "2025-06-04 13:45:30". 로그 타임스탬프를 남길 때 유용합니다.
  */
-inline std::string current_time()
+inline const std::string& current_time()
 {
+    // 서버 루프 스레드는 이번 반복에서 LoopClock이 만든 문자열을 그대로 씁니다.
+    if (loop_timestamp != nullptr)
+    {
+        return *loop_timestamp;
+    }
+
+    // 그 밖의 스레드는 스레드별로 캐시하고 초가 바뀔 때만 다시 만듭니다.
+    thread_local time_t cachedSecond = -1;
+    thread_local std::string cachedText;
     time_t now = time(nullptr); // 현재 시간을 초 단위로 가져옴.
-    struct tm timeInfo;
-    localtime_s(&timeInfo , &now);
-    static char buf[64];        // 시간 관련 정보를 담을 배열 - static 사용 재할당 안함.
-    // 해당 함수는 (버퍼, 버퍼사이즈, 출력형식, 시간정보)를 받고 buf에 출력형식대로 저장합니다.
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &timeInfo);
-    return std::string(buf);
+    if (now != cachedSecond)
+    {
+        struct tm timeInfo;
+        localtime_s(&timeInfo , &now);
+        char buf[32];
+        // 해당 함수는 (버퍼, 버퍼사이즈, 출력형식, 시간정보)를 받고 buf에 출력형식대로 저장합니다.
+        size_t length = strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &timeInfo);
+        cachedText.assign(buf, length);
+        cachedSecond = now;
+    }
+    return cachedText;
 }
 
 
@@ -124,14 +148,22 @@ inline void log(
  * @param[IN] const std::string& message : 로그로 남길 일반 메시지.
  * @see log()
  */
+#ifndef LOG_NULL
 #define LOG_INFO(message) log(LogLevel::INFO,  message)
+#else
+#define LOG_INFO(message) ((void)0)
+#endif
 /**
  * @def LOG_WARN(message)
  * @brief WARNING 수준 로그 메시지를 출력하는 매크로.
  * @param[IN] const std::string& message : 로그로 남길 경고 메시지.
  * @see log()
  */
+#ifndef LOG_NULL
 #define LOG_WARN(message) log(LogLevel::WARNING,  message)
+#else
+#define LOG_WARN(message) ((void)0)
+#endif
 /**
  * @def LOG_ERROR(message)
  * @brief ERRORZ 수준 로그 메시지를 출력하는 매크로.
@@ -139,13 +171,22 @@ inline void log(
  * @see log()
  * @note 이 매크로는 로그 출력에 소스 파일과 줄 번호를 포함합니다.
  */
+#ifndef LOG_NULL
 #define LOG_ERROR(message) log(LogLevel::ERRORZ, message, __FILE__, __LINE__)
+#else
+#define LOG_ERROR(message) ((void)0)
+#endif
 /**
  * @def LOG_DEBUG(message)
  * @brief 디버그 수준 로그 메시지를 출력하는 매크로.
  * @param[IN] const std::string& message : 로그로 남길 디버그 메시지.
  * @see log()
  * @note 이 매크로는 로그 출력에 소스 파일과 줄 번호를 포함합니다.
- * <br>디버그 빌드에서만 활성됩니다.
+ * <br>디버그 빌드에서만 활성됩니다. 릴리스 빌드에서는 메시지 식을 평가하지 않으므로
+ * <br>select나 send마다 부르는 곳에서도 문자열을 만드는 비용이 없습니다.
  */
+#if defined(_DEBUG) && !defined(LOG_NULL)
 #define LOG_DEBUG(message) log(LogLevel::DEBUG, message, __FILE__, __LINE__)
+#else
+#define LOG_DEBUG(message) ((void)0)
+#endif
@@ -0,0 +1,166 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file FanoutPool.cpp
+ * @brief FanoutPool.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "FanoutPool.h"
+#include "DebugHelper.h"
+
+FanoutPool::FanoutPool(int worker_count)
+    : _queues(), _threads(), _function(nullptr), _remaining(0), _stolenCount(0),
+      _wakeMutex(), _wakeCondition(), _generation(0), _stopping(false)
+{
+    if (worker_count < 1)
+    {
+        worker_count = 1;
+    }
+
+    for (int i = 0; i <= worker_count; ++i)
+    {
+        this->_queues.push_back(std::make_unique<FanoutPool::WorkerQueue>());
+    }
+    for (int i = 1; i <= worker_count; ++i)
+    {
+        this->_threads.emplace_back(&FanoutPool::workerLoop, this, i);
+    }
+    LOG_DEBUG("FanoutPool 객체를 생성합니다.");
+}
+
+FanoutPool::~FanoutPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_wakeMutex);
+        this->_stopping = true;
+    }
+    this->_wakeCondition.notify_all();
+
+    for (std::thread& thread : this->_threads)
+    {
+        thread.join();
+    }
+    LOG_DEBUG("FanoutPool 객체를 삭제합니다.");
+}
+
+std::size_t FanoutPool::run(std::size_t item_count, std::size_t chunk_size, const FanoutPool::ChunkFunction& function)
+{
+    if (item_count == 0)
+    {
+        return (0);
+    }
+    if (chunk_size == 0)
+    {
+        chunk_size = 1;
+    }
+
+    std::size_t chunk_count = (item_count + chunk_size - 1) / chunk_size;
+    std::size_t queue_count = this->_queues.size();
+
+    this->_function = &function;
+    this->_remaining.store(chunk_count, std::memory_order_relaxed);
+
+    // 이웃한 청크끼리 같은 작업자에 모아 넣어, 훔치지 않는 한 작업자마다 연속된 구간을 처리하게 합니다.
+    for (std::size_t q = 0; q < queue_count; ++q)
+    {
+        std::size_t first = chunk_count * q / queue_count;
+        std::size_t last = chunk_count * (q + 1) / queue_count;
+
+        std::lock_guard<std::mutex> lock(this->_queues[q]->mutex);
+        for (std::size_t c = first; c < last; ++c)
+        {
+            std::size_t begin = c * chunk_size;
+            std::size_t end = (begin + chunk_size < item_count) ? begin + chunk_size : item_count;
+            this->_queues[q]->chunks.push_back(FanoutPool::Chunk{ c, begin, end });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_wakeMutex);
+        this->_generation = this->_generation + 1;
+    }
+    this->_wakeCondition.notify_all();
+
+    // 호출한 스레드도 0번 작업자로 참여하고, 남은 청크가 다른 스레드에서 끝나기를 기다립니다.
+    this->drain(0);
+    while (this->_remaining.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    this->_function = nullptr;
+    return (chunk_count);
+}
+
+int FanoutPool::getThreadCount() const
+{
+    return ((int)this->_queues.size());
+}
+
+std::uint64_t FanoutPool::getStolenChunkCount() const
+{
+    return (this->_stolenCount.load(std::memory_order_relaxed));
+}
+
+void FanoutPool::workerLoop(int worker_index)
+{
+    std::uint64_t seen_generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->_wakeMutex);
+            this->_wakeCondition.wait(lock, [this, seen_generation]() { return (this->_stopping || this->_generation != seen_generation); });
+            if (this->_stopping)
+            {
+                return ;
+            }
+            seen_generation = this->_generation;
+        }
+
+        this->drain(worker_index);
+    }
+}
+
+void FanoutPool::drain(int worker_index)
+{
+    FanoutPool::Chunk chunk;
+    while (this->takeChunk(worker_index, chunk))
+    {
+        // 청크는 대기열 뮤텍스를 거쳐 꺼냈으므로 run()이 저장한 _function이 보입니다.
+        (*this->_function)(chunk.index, chunk.begin, chunk.end);
+        this->_remaining.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool FanoutPool::takeChunk(int worker_index, FanoutPool::Chunk& chunk)
+{
+    {
+        FanoutPool::WorkerQueue& own = *this->_queues[worker_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.chunks.empty() == false)
+        {
+            chunk = own.chunks.front();
+            own.chunks.pop_front();
+            return (true);
+        }
+    }
+
+    // 자기 대기열이 비었으면 다음 작업자부터 차례로 뒤쪽 청크를 훔칩니다.
+    std::size_t queue_count = this->_queues.size();
+    for (std::size_t offset = 1; offset < queue_count; ++offset)
+    {
+        FanoutPool::WorkerQueue& victim = *this->_queues[(worker_index + offset) % queue_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.chunks.empty() == false)
+        {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            this->_stolenCount.fetch_add(1, std::memory_order_relaxed);
+            return (true);
+        }
+    }
+    return (false);
+}
@@ -0,0 +1,164 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file FanoutPool.h
+ * @brief 큰 브로드캐스트를 청크로 나누어 여러 스레드가 나누어 처리하는 작업 훔치기(work-stealing) 스레드 풀 FanoutPool 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * run()을 호출한 스레드(서버 루프)도 작업자 0번으로 참여하며, 호출은 모든 청크가 끝난 뒤에 돌아옵니다.
+ * <br>청크는 연속된 구간끼리 작업자마다 나누어 각자의 대기열 앞쪽부터 꺼내고, 자기 대기열이 비면 다른 작업자의 대기열 뒤쪽에서 훔칩니다.
+ * <br>따라서 한 작업자가 늦게 깨어나거나 느린 청크를 만나도 나머지가 그 몫을 가져가므로 전체 완료 시간이 가장 느린 작업자에 묶이지 않습니다.
+ * <br>작업자가 깨어나지 못해도 호출한 스레드가 남은 청크를 모두 처리하므로 run()은 항상 끝납니다.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FanoutPool
+ * @brief 구간 [0, item_count)를 청크로 나누어 작업 훔치기 방식으로 병렬 실행하는 스레드 풀입니다.
+ *
+ * @note run()은 한 번에 한 스레드(서버 루프)에서만 호출합니다. 청크 함수는 서로 겹치지 않는 데이터만 고쳐야 합니다.
+ */
+class FanoutPool
+{
+public:
+    /**
+     * @brief 청크 하나를 처리하는 함수. (청크 번호, 시작 인덱스, 끝 인덱스(포함하지 않음))
+     */
+    using ChunkFunction = std::function<void(std::size_t chunk_index, std::size_t begin, std::size_t end)>;
+
+public:
+    /**
+     * @fn FanoutPool::FanoutPool(int worker_count)
+     * @brief 작업자 스레드를 만들고 대기시킵니다.
+     * @param[IN] int worker_count : 호출한 스레드 외에 더 만들 작업자 스레드 수 (1 이상).
+     * @return 없음.
+     */
+    explicit FanoutPool(int worker_count);
+
+    /**
+     * @fn FanoutPool::~FanoutPool()
+     * @brief 작업자 스레드를 멈추고 합류(join)합니다.
+     * @return 없음.
+     */
+    ~FanoutPool();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    FanoutPool(const FanoutPool& obj) = delete;
+    FanoutPool& operator=(const FanoutPool& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    FanoutPool(FanoutPool&& obj) = delete;
+    FanoutPool& operator=(FanoutPool&& obj) = delete;
+
+public:
+    /**
+     * @fn std::size_t FanoutPool::run(std::size_t item_count, std::size_t chunk_size, const FanoutPool::ChunkFunction& function)
+     * @brief 구간을 chunk_size 단위 청크로 나누어 모든 작업자가 처리하고, 끝날 때까지 기다립니다.
+     * @param[IN] std::size_t item_count : 전체 항목 수.
+     * @param[IN] std::size_t chunk_size : 청크 하나의 항목 수 (0이면 1로 봅니다).
+     * @param[IN] const FanoutPool::ChunkFunction& function : 청크마다 호출할 함수.
+     * @return std::size_t : 청크 수 (청크 번호는 0부터 이 값 미만입니다).
+     */
+    std::size_t run(std::size_t item_count, std::size_t chunk_size, const FanoutPool::ChunkFunction& function);
+
+    /**
+     * @fn int FanoutPool::getThreadCount() const
+     * @brief 호출한 스레드를 포함해 청크를 처리하는 스레드 수를 반환합니다.
+     * @return int : 작업자 스레드 수 + 1.
+     */
+    int getThreadCount() const;
+
+    /**
+     * @fn std::uint64_t FanoutPool::getStolenChunkCount() const
+     * @brief 다른 작업자의 대기열에서 훔쳐 처리한 청크의 누적 수를 반환합니다.
+     * @return std::uint64_t : 훔친 청크 수.
+     */
+    std::uint64_t getStolenChunkCount() const;
+
+private:
+    /**
+     * @struct FanoutPool::Chunk
+     * @brief 대기열에 넣는 청크 하나.
+     */
+    struct Chunk
+    {
+        std::size_t index;      ///< 청크 번호.
+        std::size_t begin;      ///< 시작 인덱스.
+        std::size_t end;        ///< 끝 인덱스 (포함하지 않음).
+    };
+
+    /**
+     * @struct FanoutPool::WorkerQueue
+     * @brief 작업자 하나의 청크 대기열. 이웃 대기열과 캐시 줄을 나누어 쓰지 않도록 정렬합니다.
+     */
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;               ///< 대기열 보호용 뮤텍스 (주인과 훔치는 쪽이 함께 사용).
+        std::deque<Chunk> chunks;       ///< 주인은 앞에서, 훔치는 쪽은 뒤에서 꺼냅니다.
+    };
+
+private:
+    /// 작업자별 대기열 (0번은 run()을 호출한 스레드).
+    std::vector<std::unique_ptr<FanoutPool::WorkerQueue>> _queues;
+
+    /// 작업자 스레드 (대기열 1번부터).
+    std::vector<std::thread> _threads;
+
+    /// 지금 실행 중인 청크 함수 (run() 동안만 유효).
+    const FanoutPool::ChunkFunction* _function;
+
+    /// 아직 끝나지 않은 청크 수.
+    std::atomic<std::size_t> _remaining;
+
+    /// 훔친 청크의 누적 수.
+    std::atomic<std::uint64_t> _stolenCount;
+
+    /// 작업자를 깨우는 조건 변수와 그 뮤텍스.
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+
+    /// run()을 호출할 때마다 1씩 늘어나는 작업 번호 (_wakeMutex로 보호).
+    std::uint64_t _generation;
+
+    /// 소멸 중이면 true (_wakeMutex로 보호).
+    bool _stopping;
+
+private:
+    /**
+     * @fn void FanoutPool::workerLoop(int worker_index)
+     * @brief 작업자 스레드 본문. 새 작업 번호를 기다렸다가 청크가 없어질 때까지 처리합니다.
+     * @param[IN] int worker_index : 작업자 번호 (1 이상).
+     * @return 없음.
+     */
+    void workerLoop(int worker_index);
+
+    /**
+     * @fn void FanoutPool::drain(int worker_index)
+     * @brief 자기 대기열을 먼저 비우고, 비면 다른 대기열에서 훔쳐 더 이상 청크가 없을 때까지 처리합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @return 없음.
+     */
+    void drain(int worker_index);
+
+    /**
+     * @fn bool FanoutPool::takeChunk(int worker_index, FanoutPool::Chunk& chunk)
+     * @brief 처리할 청크 하나를 꺼냅니다. 자기 대기열의 앞, 그다음 다른 대기열의 뒤 순서로 찾습니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @param[OUT] FanoutPool::Chunk& chunk : 꺼낸 청크.
+     * @return bool : 꺼냈으면 true, 모든 대기열이 비었으면 false.
+     */
+    bool takeChunk(int worker_index, FanoutPool::Chunk& chunk);
+};
@@ -0,0 +1,157 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file FlightRecorder.cpp
+ * @brief FlightRecorder.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "FlightRecorder.h"
+#include "DebugHelper.h"
+#include <fstream>
+
+FlightRecorder::FlightRecorder()
+    : _events(FlightRecorder::CAPACITY), _written(0), _budgetMs(FlightRecorder::DEFAULT_BUDGET_MS), _iterationCount(0),
+      _iterationBegin(), _iterationWaitMicros(0), _stallCount(0), _lastDumpTime(),
+      _lastIterationMark(UINT64_MAX)
+{
+    LOG_DEBUG("FlightRecorder 객체를 생성합니다.");
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    LOG_DEBUG("FlightRecorder 객체를 삭제합니다.");
+}
+
+void FlightRecorder::setBudget(int budget_ms)
+{
+    this->_budgetMs = budget_ms;
+}
+
+int FlightRecorder::getBudget() const
+{
+    return (this->_budgetMs);
+}
+
+void FlightRecorder::record(FlightRecorder::EventType type, SOCKET socket, int value, NetworkTransport::Clock::time_point begin, NetworkTransport::Clock::time_point end)
+{
+    std::int64_t duration_micros = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+    // 가득 차면 가장 오래된 이벤트 자리를 덮어씁니다.
+    FlightRecorder::Event& event = this->_events[this->_written & (FlightRecorder::CAPACITY - 1)];
+    event.begin = begin;
+    event.durationMicros = duration_micros;
+    event.socket = socket;
+    event.value = value;
+    event.type = type;
+    this->_written = this->_written + 1;
+
+    // 대기 시간은 반복 작업 시간에 포함하지 않습니다.
+    if (type == FlightRecorder::EventType::SELECT || type == FlightRecorder::EventType::SLEEP)
+    {
+        this->_iterationWaitMicros = this->_iterationWaitMicros + duration_micros;
+    }
+}
+
+bool FlightRecorder::beginIteration(NetworkTransport::Clock::time_point now)
+{
+    bool dumped = false;
+
+    if (this->_iterationCount > 0 && this->_budgetMs > 0)
+    {
+        std::int64_t elapsed_micros = std::chrono::duration_cast<std::chrono::microseconds>(now - this->_iterationBegin).count();
+        std::int64_t work_micros = elapsed_micros - this->_iterationWaitMicros;
+
+        if (work_micros > (std::int64_t)this->_budgetMs * 1000)
+        {
+            this->_stallCount = this->_stallCount + 1;
+            std::string reason = "반복 " + std::to_string(this->_iterationCount) + " 작업 시간 " + std::to_string(work_micros / 1000)
+                + "ms (예산 " + std::to_string(this->_budgetMs) + "ms, 대기 " + std::to_string(this->_iterationWaitMicros / 1000) + "ms 제외)";
+            LOG_WARN("서버 루프 정체 감지: " + reason);
+
+            // 정체가 이어질 때는 간격을 두고 한 번씩만 저장합니다.
+            bool first_dump = (this->_stallCount == 1);
+            if (first_dump || now - this->_lastDumpTime >= std::chrono::milliseconds(FlightRecorder::MIN_DUMP_INTERVAL_MS))
+            {
+                std::string file_path = "stall_" + std::to_string(this->_stallCount) + ".log";
+                dumped = this->dumpToFile(file_path, reason);
+                this->_lastDumpTime = now;
+            }
+        }
+    }
+
+    this->_iterationCount = this->_iterationCount + 1;
+    this->_iterationBegin = now;
+    this->_iterationWaitMicros = 0;
+
+    // 아무 일도 없던 반복의 표시는 새 표시로 덮어써 바쁜 폴링 중에도 최근 활동이 밀려나지 않게 합니다.
+    if (this->_written > 0 && this->_written - 1 == this->_lastIterationMark)
+    {
+        this->_written = this->_written - 1;
+    }
+    this->_lastIterationMark = this->_written;
+    this->record(FlightRecorder::EventType::ITERATION, INVALID_SOCKET, (int)(this->_iterationCount & 0x7FFFFFFF), now, now);
+    return (dumped);
+}
+
+bool FlightRecorder::dumpToFile(const std::string& file_path, const std::string& reason) const
+{
+    std::ofstream out(file_path, std::ios::out | std::ios::trunc);
+    if (out.is_open() == false)
+    {
+        LOG_ERROR("정체 기록 파일을 열 수 없습니다: " + file_path);
+        return (false);
+    }
+
+    std::uint64_t first = (this->_written > (std::uint64_t)FlightRecorder::CAPACITY) ? this->_written - FlightRecorder::CAPACITY : 0;
+    if (first == this->_written)
+    {
+        out << "# " << reason << "\n# 기록된 이벤트가 없습니다.\n";
+        return (true);
+    }
+
+    // 시각은 가장 오래된 이벤트 기준 상대값(마이크로초)으로 씁니다.
+    NetworkTransport::Clock::time_point origin = this->_events[first & (FlightRecorder::CAPACITY - 1)].begin;
+    out << "# " << reason << "\n";
+    out << "# offset_us type socket value duration_us\n";
+    for (std::uint64_t i = first; i < this->_written; ++i)
+    {
+        const FlightRecorder::Event& event = this->_events[i & (FlightRecorder::CAPACITY - 1)];
+        std::int64_t offset_micros = std::chrono::duration_cast<std::chrono::microseconds>(event.begin - origin).count();
+
+        out << offset_micros << " " << FlightRecorder::toString(event.type) << " ";
+        if (event.socket == INVALID_SOCKET)
+        {
+            out << "-";
+        }
+        else
+        {
+            out << (unsigned long long)event.socket;
+        }
+        out << " " << event.value << " " << event.durationMicros << "\n";
+    }
+
+    LOG_WARN("정체 기록을 저장했습니다: " + file_path + " (" + std::to_string(this->_written - first) + "개 이벤트)");
+    return (true);
+}
+
+std::uint64_t FlightRecorder::getStallCount() const
+{
+    return (this->_stallCount);
+}
+
+const char* FlightRecorder::toString(FlightRecorder::EventType type)
+{
+    switch (type)
+    {
+    case FlightRecorder::EventType::ITERATION: return ("ITERATION");
+    case FlightRecorder::EventType::SELECT: return ("SELECT");
+    case FlightRecorder::EventType::SLEEP: return ("SLEEP");
+    case FlightRecorder::EventType::ACCEPT: return ("ACCEPT");
+    case FlightRecorder::EventType::RECV: return ("RECV");
+    case FlightRecorder::EventType::SEND: return ("SEND");
+    case FlightRecorder::EventType::CLOSE: return ("CLOSE");
+    default: return ("UNKNOWN");
+    }
+}
@@ -0,0 +1,184 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file FlightRecorder.h
+ * @brief 최근 서버 루프 활동을 고정 크기로 보관하다가 반복이 예산을 넘으면 파일로 남기는 FlightRecorder 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 항상 켜져 있는 기록기입니다. 루프 깨어남(select), 준비된 소켓 수, 소켓별 recv/send 크기와 소요 시간을
+ * <br>고정 크기 링 버퍼에 덮어쓰며 보관하므로 할당이나 파일 입출력 없이 기록만 합니다.
+ * <br>beginIteration()이 직전 반복의 작업 시간(대기 시간 제외)을 예산과 비교하고,
+ * <br>넘었다면 그 순간의 링 버퍼 내용을 stall_<번호>.log 파일로 저장합니다.
+ */
+
+#include "NetworkTransport.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class FlightRecorder
+ * @brief 루프 이벤트 링 버퍼와 반복 시간 감시(watchdog)를 제공하는 클래스입니다.
+ */
+class FlightRecorder
+{
+public:
+    /// 보관하는 최근 이벤트 수 (2의 거듭제곱).
+    static const int CAPACITY = 4096;
+
+    /// 반복 하나의 기본 작업 시간 예산(밀리초).
+    static const int DEFAULT_BUDGET_MS = 100;
+
+    /// 연속된 정체 덤프 사이의 최소 간격(밀리초). 정체가 이어질 때 파일이 쏟아지지 않게 합니다.
+    static constexpr int MIN_DUMP_INTERVAL_MS = 10000;
+
+public:
+    /**
+     * @enum FlightRecorder::EventType
+     * @brief 기록하는 루프 이벤트 종류.
+     */
+    enum class EventType : std::uint8_t
+    {
+        ITERATION,  ///< 반복 시작 (value : 반복 번호 하위 32비트).
+        SELECT,     ///< select 깨어남 (value : 준비된 소켓 수, 소요 시간 : 대기 시간).
+        SLEEP,      ///< 소켓이 없을 때의 대기 (value : 요청한 밀리초).
+        ACCEPT,     ///< 연결 수락 (socket : 새 소켓).
+        RECV,       ///< 수신 (value : recv 결과 바이트 수).
+        SEND,       ///< 송신 (value : send 결과 바이트 수).
+        CLOSE       ///< 소켓 닫기.
+    };
+
+public:
+    /**
+     * @fn FlightRecorder::FlightRecorder()
+     * @brief 빈 기록기를 생성합니다. 예산은 DEFAULT_BUDGET_MS입니다.
+     * @return 없음.
+     */
+    FlightRecorder();
+
+    /**
+     * @fn FlightRecorder::~FlightRecorder()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~FlightRecorder();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    FlightRecorder(const FlightRecorder& obj) = delete;
+    FlightRecorder& operator=(const FlightRecorder& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    FlightRecorder(FlightRecorder&& obj) = delete;
+    FlightRecorder& operator=(FlightRecorder&& obj) = delete;
+
+public:
+    /**
+     * @fn void FlightRecorder::setBudget(int budget_ms)
+     * @brief 반복 하나의 작업 시간 예산을 바꿉니다.
+     * @param[IN] int budget_ms : 예산(밀리초). 0 이하이면 감시를 끕니다. (기록은 계속합니다.)
+     * @return 없음.
+     */
+    void setBudget(int budget_ms);
+
+    /**
+     * @fn int FlightRecorder::getBudget() const
+     * @brief 현재 작업 시간 예산을 반환합니다.
+     * @return int : 예산(밀리초).
+     */
+    int getBudget() const;
+
+    /**
+     * @fn void FlightRecorder::record(FlightRecorder::EventType type, SOCKET socket, int value, NetworkTransport::Clock::time_point begin, NetworkTransport::Clock::time_point end)
+     * @brief 이벤트 하나를 링 버퍼에 기록합니다.
+     * @param[IN] FlightRecorder::EventType type : 이벤트 종류.
+     * @param[IN] SOCKET socket : 관련 소켓 (없으면 INVALID_SOCKET).
+     * @param[IN] int value : 이벤트별 값 (바이트 수, 준비된 소켓 수 등).
+     * @param[IN] NetworkTransport::Clock::time_point begin : 시작 시각.
+     * @param[IN] NetworkTransport::Clock::time_point end : 종료 시각.
+     * @return 없음.
+     * @note SELECT와 SLEEP의 소요 시간은 대기 시간으로 보아 반복 작업 시간에서 뺍니다.
+     */
+    void record(FlightRecorder::EventType type, SOCKET socket, int value, NetworkTransport::Clock::time_point begin, NetworkTransport::Clock::time_point end);
+
+    /**
+     * @fn bool FlightRecorder::beginIteration(NetworkTransport::Clock::time_point now)
+     * @brief 새 반복의 시작을 알리고 직전 반복이 예산을 넘었는지 검사합니다.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return bool : 직전 반복이 예산을 넘어 덤프 파일을 남겼으면 true.
+     *
+     * @details
+     * 작업 시간은 (이번 시작 시각 - 직전 시작 시각 - 직전 반복의 select/sleep 대기 시간)입니다.
+     * <br>예산을 넘으면 기록을 멈춘 상태(루프 스레드가 파일을 쓰는 동안 새 이벤트가 없음)에서 링 버퍼를 파일로 저장합니다.
+     */
+    bool beginIteration(NetworkTransport::Clock::time_point now);
+
+    /**
+     * @fn bool FlightRecorder::dumpToFile(const std::string& file_path, const std::string& reason) const
+     * @brief 링 버퍼에 남은 이벤트를 오래된 순서로 텍스트 파일에 저장합니다.
+     * @param[IN] const std::string& file_path : 저장할 파일 경로.
+     * @param[IN] const std::string& reason : 파일 첫 줄에 남길 덤프 사유.
+     * @return bool : 저장에 성공하면 true.
+     */
+    bool dumpToFile(const std::string& file_path, const std::string& reason) const;
+
+    /**
+     * @fn std::uint64_t FlightRecorder::getStallCount() const
+     * @brief 지금까지 예산을 넘은 반복 수를 반환합니다.
+     * @return std::uint64_t : 정체 횟수.
+     */
+    std::uint64_t getStallCount() const;
+
+private:
+    /**
+     * @struct FlightRecorder::Event
+     * @brief 기록된 이벤트 하나.
+     */
+    struct Event
+    {
+        NetworkTransport::Clock::time_point begin;  ///< 시작 시각.
+        std::int64_t durationMicros;                ///< 소요 시간(마이크로초).
+        SOCKET socket;                              ///< 관련 소켓.
+        int value;                                  ///< 이벤트별 값.
+        FlightRecorder::EventType type;             ///< 이벤트 종류.
+    };
+
+private:
+    /// 최근 이벤트 링 버퍼.
+    std::vector<FlightRecorder::Event> _events;
+
+    /// 지금까지 기록한 이벤트 수.
+    std::uint64_t _written;
+
+    /// 반복 작업 시간 예산(밀리초).
+    int _budgetMs;
+
+    /// 지금까지 시작한 반복 수.
+    std::uint64_t _iterationCount;
+
+    /// 현재 반복의 시작 시각.
+    NetworkTransport::Clock::time_point _iterationBegin;
+
+    /// 현재 반복에서 select/sleep으로 대기한 시간(마이크로초).
+    std::int64_t _iterationWaitMicros;
+
+    /// 예산을 넘은 반복 수.
+    std::uint64_t _stallCount;
+
+    /// 마지막으로 덤프한 시각.
+    NetworkTransport::Clock::time_point _lastDumpTime;
+
+    /// 마지막 ITERATION 표시의 기록 번호 (아직 없으면 UINT64_MAX).
+    std::uint64_t _lastIterationMark;
+
+private:
+    /**
+     * @fn static const char* FlightRecorder::toString(FlightRecorder::EventType type)
+     * @brief 이벤트 종류를 문자열로 바꿉니다.
+     * @param[IN] FlightRecorder::EventType type : 이벤트 종류.
+     * @return const char* : 이벤트 이름.
+     */
+    static const char* toString(FlightRecorder::EventType type);
+};
@@ -0,0 +1,94 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file HashRing.cpp
+ * @brief HashRing.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "HashRing.h"
+#include "DebugHelper.h"
+#include <algorithm>
+
+HashRing::HashRing()
+    : _points(), _nodes()
+{
+    LOG_DEBUG("HashRing 객체를 생성합니다.");
+}
+
+HashRing::~HashRing()
+{
+    LOG_DEBUG("HashRing 객체를 삭제합니다.");
+}
+
+void HashRing::setNodes(const std::vector<int>& nodes)
+{
+    this->_nodes = nodes;
+    std::sort(this->_nodes.begin(), this->_nodes.end());
+    this->_nodes.erase(std::unique(this->_nodes.begin(), this->_nodes.end()), this->_nodes.end());
+
+    this->_points.clear();
+    this->_points.reserve(this->_nodes.size() * HashRing::VIRTUAL_NODES);
+    for (int node : this->_nodes)
+    {
+        for (int i = 0; i < HashRing::VIRTUAL_NODES; ++i)
+        {
+            std::string point_name = std::to_string(node) + "#" + std::to_string(i);
+            this->_points.emplace_back(HashRing::hashKey(point_name.data(), point_name.size()), node);
+        }
+    }
+    std::sort(this->_points.begin(), this->_points.end());
+}
+
+int HashRing::findOwner(const std::string& key, int excluded_node) const
+{
+    if (this->_points.empty())
+    {
+        return (HashRing::NO_NODE);
+    }
+
+    std::uint64_t key_hash = HashRing::hashKey(key.data(), key.size());
+    auto it = std::lower_bound(this->_points.begin(), this->_points.end(), std::make_pair(key_hash, INT32_MIN));
+
+    // 시계 방향으로 돌며 제외된 노드가 아닌 첫 점을 찾습니다. (끝을 지나면 처음으로 돌아갑니다.)
+    for (std::size_t step = 0; step < this->_points.size(); ++step)
+    {
+        if (it == this->_points.end())
+        {
+            it = this->_points.begin();
+        }
+        if (it->second != excluded_node)
+        {
+            return (it->second);
+        }
+        ++it;
+    }
+    return (HashRing::NO_NODE);
+}
+
+bool HashRing::hasNode(int node) const
+{
+    return (std::binary_search(this->_nodes.begin(), this->_nodes.end(), node));
+}
+
+const std::vector<int>& HashRing::getNodes() const
+{
+    return (this->_nodes);
+}
+
+std::uint64_t HashRing::hashKey(const char* data, std::size_t length)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash = hash ^ (unsigned char)data[i];
+        hash = hash * 1099511628211ull;
+    }
+
+    // FNV-1a는 짧은 키에서 상위 비트가 덜 섞이므로 한 번 더 섞어 링 위에 고르게 흩어지게 합니다.
+    hash = hash ^ (hash >> 33);
+    hash = hash * 0xff51afd7ed558ccdull;
+    hash = hash ^ (hash >> 33);
+    return (hash);
+}
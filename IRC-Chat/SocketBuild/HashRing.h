@@ -0,0 +1,108 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file HashRing.h
+ * @brief 키를 노드에 대응시키는 가상 노드 기반 일관 해시 링 HashRing 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 노드 하나를 VIRTUAL_NODES개의 점으로 64비트 해시 원 위에 흩어 놓고, 키의 해시에서 시계 방향으로 처음 만나는 점의 노드를 주인으로 봅니다.
+ * <br>노드가 추가되거나 빠지면 그 노드의 점 주변 구간에 있던 키만 주인이 바뀌고 나머지 키는 그대로 남습니다.
+ * <br>모든 노드가 같은 노드 집합으로 링을 만들면 통신 없이도 같은 주인을 계산합니다.
+ */
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class HashRing
+ * @brief 정렬된 (해시, 노드) 배열과 이진 탐색으로 키의 주인 노드를 찾는 일관 해시 링입니다.
+ *
+ * @note 노드는 정수 번호로 구분합니다. (클러스터에서는 클러스터 포트.)
+ */
+class HashRing
+{
+public:
+    /// 노드 하나가 링 위에 놓는 가상 노드(점) 수. 많을수록 키가 고르게 나뉩니다.
+    static constexpr int VIRTUAL_NODES = 64;
+
+    /// 노드가 없을 때 findOwner()가 반환하는 값.
+    static constexpr int NO_NODE = -1;
+
+public:
+    /**
+     * @fn HashRing::HashRing()
+     * @brief 빈 링을 생성합니다.
+     * @return 없음.
+     */
+    HashRing();
+
+    /**
+     * @fn HashRing::~HashRing()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~HashRing();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    HashRing(const HashRing& obj) = delete;
+    HashRing& operator=(const HashRing& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    HashRing(HashRing&& obj) = delete;
+    HashRing& operator=(HashRing&& obj) = delete;
+
+public:
+    /**
+     * @fn void HashRing::setNodes(const std::vector<int>& nodes)
+     * @brief 링을 주어진 노드 집합으로 다시 만듭니다.
+     * @param[IN] const std::vector<int>& nodes : 노드 번호 목록 (순서와 중복은 상관없습니다).
+     * @return 없음.
+     */
+    void setNodes(const std::vector<int>& nodes);
+
+    /**
+     * @fn int HashRing::findOwner(const std::string& key, int excluded_node) const
+     * @brief 키의 주인 노드를 찾습니다.
+     * @param[IN] const std::string& key : 키 (채팅방 ID 등).
+     * @param[IN] int excluded_node : 주인 후보에서 뺄 노드 (기본값 NO_NODE : 빼지 않음). 노드가 빠진 뒤의 주인을 미리 구할 때 사용합니다.
+     * @return int : 주인 노드 번호, 후보가 없으면 NO_NODE.
+     */
+    int findOwner(const std::string& key, int excluded_node = HashRing::NO_NODE) const;
+
+    /**
+     * @fn bool HashRing::hasNode(int node) const
+     * @brief 노드가 링에 있는지 확인합니다.
+     * @param[IN] int node : 노드 번호.
+     * @return bool : 있으면 true.
+     */
+    bool hasNode(int node) const;
+
+    /**
+     * @fn const std::vector<int>& HashRing::getNodes() const
+     * @brief 링을 이루는 노드 목록을 반환합니다.
+     * @return const std::vector<int>& : 정렬된 노드 번호 목록.
+     */
+    const std::vector<int>& getNodes() const;
+
+    /**
+     * @fn static std::uint64_t HashRing::hashKey(const char* data, std::size_t length)
+     * @brief 바이트열의 64비트 해시를 구합니다 (FNV-1a 후 비트 섞기).
+     * @param[IN] const char* data : 바이트열.
+     * @param[IN] std::size_t length : 길이.
+     * @return std::uint64_t : 해시 값.
+     * @note 노드마다 같은 값을 내야 하므로 std::hash처럼 구현마다 다른 함수는 쓰지 않습니다.
+     */
+    static std::uint64_t hashKey(const char* data, std::size_t length);
+
+private:
+    /// 링 위의 점 (해시, 노드 번호). 해시 순으로 정렬됩니다.
+    std::vector<std::pair<std::uint64_t, int>> _points;
+
+    /// 링을 이루는 노드 (정렬, 중복 없음).
+    std::vector<int> _nodes;
+};
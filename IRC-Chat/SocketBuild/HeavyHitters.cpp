@@ -0,0 +1,224 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file HeavyHitters.cpp
+ * @brief HeavyHitters.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "HeavyHitters.h"
+#include "DebugHelper.h"
+#include <algorithm>
+
+static_assert((HeavyHitters::SKETCH_WIDTH & (HeavyHitters::SKETCH_WIDTH - 1)) == 0, "SKETCH_WIDTH는 2의 거듭제곱이어야 합니다.");
+
+HeavyHitters::HeavyHitters()
+    : _windows((std::size_t)HeavyHitters::WINDOW_COUNT * HeavyHitters::SKETCH_DEPTH * HeavyHitters::SKETCH_WIDTH, HeavyHitters::Cell{ 0, 0 }),
+      _total((std::size_t)HeavyHitters::SKETCH_DEPTH * HeavyHitters::SKETCH_WIDTH, HeavyHitters::Cell{ 0, 0 }),
+      _messageTop(), _byteTop(), _currentWindow(0), _windowStartTick(-1)
+{
+    this->_messageTop.count = 0;
+    this->_byteTop.count = 0;
+    LOG_DEBUG("HeavyHitters 객체를 생성합니다.");
+}
+
+HeavyHitters::~HeavyHitters()
+{
+    LOG_DEBUG("HeavyHitters 객체를 삭제합니다.");
+}
+
+void HeavyHitters::record(std::uint64_t key, std::uint32_t bytes, std::int64_t now_tick)
+{
+    if (this->_windowStartTick < 0)
+    {
+        this->_windowStartTick = now_tick;
+    }
+    else if (now_tick - this->_windowStartTick >= HeavyHitters::WINDOW_MS)
+    {
+        this->advance(now_tick);
+    }
+
+    std::array<std::size_t, HeavyHitters::SKETCH_DEPTH> cells;
+    HeavyHitters::getCells(key, cells);
+
+    // 지금 조각과 합계에 같은 양을 더하고, 합계의 행별 최솟값을 추정치로 씁니다.
+    HeavyHitters::Cell* window = this->_windows.data() + (std::size_t)this->_currentWindow * HeavyHitters::SKETCH_DEPTH * HeavyHitters::SKETCH_WIDTH;
+    HeavyHitters::Talker talker = { key, UINT32_MAX, UINT32_MAX };
+    for (std::size_t cell : cells)
+    {
+        window[cell].messages = window[cell].messages + 1;
+        window[cell].bytes = window[cell].bytes + bytes;
+
+        HeavyHitters::Cell& total = this->_total[cell];
+        total.messages = total.messages + 1;
+        total.bytes = total.bytes + bytes;
+        talker.messages = std::min(talker.messages, total.messages);
+        talker.bytes = std::min(talker.bytes, total.bytes);
+    }
+
+    this->offer(this->_messageTop, HeavyHitters::Metric::MESSAGES, talker);
+    this->offer(this->_byteTop, HeavyHitters::Metric::BYTES, talker);
+}
+
+int HeavyHitters::collectTop(HeavyHitters::Metric metric, std::int64_t now_tick, HeavyHitters::Talker* talkers, int max_count)
+{
+    if (this->_windowStartTick >= 0 && now_tick - this->_windowStartTick >= HeavyHitters::WINDOW_MS)
+    {
+        this->advance(now_tick);
+    }
+
+    const HeavyHitters::TopHeap& heap = (metric == HeavyHitters::Metric::MESSAGES) ? this->_messageTop : this->_byteTop;
+    int count = std::min(heap.count, max_count);
+
+    // 힙에 든 값은 기록할 때의 추정치이므로, 두 지표 모두 지금 합계 기준으로 다시 구해 정렬합니다.
+    HeavyHitters::TopHeap sorted = heap;
+    for (int i = 0; i < sorted.count; ++i)
+    {
+        HeavyHitters::Cell current = this->estimate(sorted.talkers[i].key);
+        sorted.talkers[i].messages = current.messages;
+        sorted.talkers[i].bytes = current.bytes;
+    }
+    std::sort(sorted.talkers.begin(), sorted.talkers.begin() + sorted.count, [metric](const HeavyHitters::Talker& a, const HeavyHitters::Talker& b)
+    {
+        return (HeavyHitters::getValue(a, metric) > HeavyHitters::getValue(b, metric));
+    });
+
+    for (int i = 0; i < count; ++i)
+    {
+        talkers[i] = sorted.talkers[i];
+    }
+    return (count);
+}
+
+std::int64_t HeavyHitters::getWindowMs() const
+{
+    return (HeavyHitters::WINDOW_MS * HeavyHitters::WINDOW_COUNT);
+}
+
+std::size_t HeavyHitters::getMemoryBytes() const
+{
+    return ((this->_windows.size() + this->_total.size()) * sizeof(HeavyHitters::Cell) + sizeof(HeavyHitters::TopHeap) * 2);
+}
+
+void HeavyHitters::advance(std::int64_t now_tick)
+{
+    std::int64_t elapsed_windows = (now_tick - this->_windowStartTick) / HeavyHitters::WINDOW_MS;
+    if (elapsed_windows <= 0)
+    {
+        return ;
+    }
+
+    // 다음 조각 자리에는 시간 창에서 가장 오래된 조각이 들어 있으므로, 합계에서 빼고 비웁니다.
+    int expire_count = (int)std::min<std::int64_t>(elapsed_windows, HeavyHitters::WINDOW_COUNT);
+    std::size_t window_size = (std::size_t)HeavyHitters::SKETCH_DEPTH * HeavyHitters::SKETCH_WIDTH;
+    for (int i = 0; i < expire_count; ++i)
+    {
+        this->_currentWindow = (this->_currentWindow + 1) % HeavyHitters::WINDOW_COUNT;
+        HeavyHitters::Cell* window = this->_windows.data() + (std::size_t)this->_currentWindow * window_size;
+        for (std::size_t cell = 0; cell < window_size; ++cell)
+        {
+            this->_total[cell].messages = this->_total[cell].messages - window[cell].messages;
+            this->_total[cell].bytes = this->_total[cell].bytes - window[cell].bytes;
+            window[cell] = HeavyHitters::Cell{ 0, 0 };
+        }
+    }
+    this->_windowStartTick = this->_windowStartTick + elapsed_windows * HeavyHitters::WINDOW_MS;
+
+    // 힙의 값은 줄어들 수만 있으므로 다시 추정하고, 시간 창에서 사라진 송신자는 뺍니다.
+    HeavyHitters::TopHeap* heaps[2] = { &this->_messageTop, &this->_byteTop };
+    HeavyHitters::Metric metrics[2] = { HeavyHitters::Metric::MESSAGES, HeavyHitters::Metric::BYTES };
+    for (int h = 0; h < 2; ++h)
+    {
+        HeavyHitters::TopHeap& heap = *heaps[h];
+        HeavyHitters::Metric metric = metrics[h];
+        int kept = 0;
+        for (int i = 0; i < heap.count; ++i)
+        {
+            HeavyHitters::Cell current = this->estimate(heap.talkers[i].key);
+            heap.talkers[i].messages = current.messages;
+            heap.talkers[i].bytes = current.bytes;
+            if (HeavyHitters::getValue(heap.talkers[i], metric) > 0)
+            {
+                heap.talkers[kept] = heap.talkers[i];
+                kept = kept + 1;
+            }
+        }
+        heap.count = kept;
+        std::make_heap(heap.talkers.begin(), heap.talkers.begin() + heap.count, [metric](const HeavyHitters::Talker& a, const HeavyHitters::Talker& b)
+        {
+            return (HeavyHitters::getValue(a, metric) > HeavyHitters::getValue(b, metric));
+        });
+    }
+}
+
+HeavyHitters::Cell HeavyHitters::estimate(std::uint64_t key) const
+{
+    std::array<std::size_t, HeavyHitters::SKETCH_DEPTH> cells;
+    HeavyHitters::getCells(key, cells);
+
+    HeavyHitters::Cell result = { UINT32_MAX, UINT32_MAX };
+    for (std::size_t cell : cells)
+    {
+        result.messages = std::min(result.messages, this->_total[cell].messages);
+        result.bytes = std::min(result.bytes, this->_total[cell].bytes);
+    }
+    return (result);
+}
+
+void HeavyHitters::offer(HeavyHitters::TopHeap& heap, HeavyHitters::Metric metric, const HeavyHitters::Talker& talker)
+{
+    auto greater = [metric](const HeavyHitters::Talker& a, const HeavyHitters::Talker& b)
+    {
+        return (HeavyHitters::getValue(a, metric) > HeavyHitters::getValue(b, metric));
+    };
+
+    // 이미 힙에 있으면 값만 올리고 힙을 다시 세웁니다. (TOP_COUNT가 작으므로 선형 탐색이 더 쌉니다.)
+    for (int i = 0; i < heap.count; ++i)
+    {
+        if (heap.talkers[i].key == talker.key)
+        {
+            heap.talkers[i] = talker;
+            std::make_heap(heap.talkers.begin(), heap.talkers.begin() + heap.count, greater);
+            return ;
+        }
+    }
+
+    if (heap.count < HeavyHitters::TOP_COUNT)
+    {
+        heap.talkers[heap.count] = talker;
+        heap.count = heap.count + 1;
+        std::push_heap(heap.talkers.begin(), heap.talkers.begin() + heap.count, greater);
+        return ;
+    }
+
+    // 가득 찼으면 가장 적게 보낸 송신자(힙의 맨 앞)보다 많을 때만 바꿔 넣습니다.
+    if (greater(talker, heap.talkers[0]))
+    {
+        std::pop_heap(heap.talkers.begin(), heap.talkers.begin() + heap.count, greater);
+        heap.talkers[heap.count - 1] = talker;
+        std::push_heap(heap.talkers.begin(), heap.talkers.begin() + heap.count, greater);
+    }
+}
+
+void HeavyHitters::getCells(std::uint64_t key, std::array<std::size_t, SKETCH_DEPTH>& cells)
+{
+    // splitmix64 마무리 함수로 키를 섞고, 상위와 하위 32비트를 두 해시로 씁니다.
+    std::uint64_t mixed = key + 0x9E3779B97F4A7C15ull;
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+    mixed = mixed ^ (mixed >> 31);
+
+    std::uint32_t first = (std::uint32_t)mixed;
+    std::uint32_t second = (std::uint32_t)(mixed >> 32) | 1;
+    for (int row = 0; row < HeavyHitters::SKETCH_DEPTH; ++row)
+    {
+        std::size_t column = (first + (std::uint32_t)row * second) & (HeavyHitters::SKETCH_WIDTH - 1);
+        cells[row] = (std::size_t)row * HeavyHitters::SKETCH_WIDTH + column;
+    }
+}
+
+std::uint32_t HeavyHitters::getValue(const HeavyHitters::Talker& talker, HeavyHitters::Metric metric)
+{
+    return ((metric == HeavyHitters::Metric::MESSAGES) ? talker.messages : talker.bytes);
+}
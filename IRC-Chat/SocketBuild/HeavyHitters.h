@@ -0,0 +1,212 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file HeavyHitters.h
+ * @brief 최근 시간 창에서 메시지와 바이트를 가장 많이 보낸 송신자를 고정 메모리로 추적하는 HeavyHitters 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 송신자별 개수는 count-min sketch로 추정합니다. 키마다 SKETCH_DEPTH개의 해시로 행마다 칸 하나를 고르고, 추정치는 그 칸들의 최솟값입니다.
+ * <br>추정치는 실제보다 작아지지 않고, 다른 키와 칸을 나눠 쓴 만큼만 커집니다.
+ * <br>시간 창은 WINDOW_MS 길이의 조각 WINDOW_COUNT개로 나누고, 조각마다 스케치를 따로 둡니다.
+ * <br>모든 조각의 합은 합계 스케치로 따로 유지합니다. 조각이 만료되면 그 조각을 합계에서 빼므로 추정할 때 조각을 다시 더하지 않습니다.
+ * <br>메시지 수 상위와 바이트 수 상위는 각각 TOP_COUNT개짜리 최소 힙으로 유지합니다.
+ * <br>메시지 하나를 기록하는 비용은 SKETCH_DEPTH개 칸 갱신과 힙 두 개 확인이며, 접속자 수와 무관합니다.
+ * <br>메모리는 생성할 때 정해지며 키가 늘어도 늘지 않습니다.
+ * @note 루프 스레드 전용입니다.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HeavyHitters
+ * @brief count-min sketch와 상위 K 힙으로 최근 시간 창의 상위 송신자를 찾습니다.
+ */
+class HeavyHitters
+{
+public:
+    /// 스케치의 행 수 (독립 해시 수).
+    static constexpr int SKETCH_DEPTH = 4;
+
+    /// 스케치 한 행의 칸 수 (2의 거듭제곱).
+    static constexpr int SKETCH_WIDTH = 1024;
+
+    /// 시간 창 조각 하나의 길이 (밀리초).
+    static constexpr std::int64_t WINDOW_MS = 10000;
+
+    /// 시간 창을 이루는 조각 수. 시간 창의 길이는 WINDOW_MS * WINDOW_COUNT입니다.
+    static constexpr int WINDOW_COUNT = 6;
+
+    /// 지표마다 유지하는 상위 송신자 수.
+    static constexpr int TOP_COUNT = 10;
+
+    /**
+     * @enum HeavyHitters::Metric
+     * @brief 상위를 가릴 기준.
+     */
+    enum class Metric
+    {
+        MESSAGES,   ///< 메시지 수.
+        BYTES       ///< 바이트 수.
+    };
+
+    /**
+     * @struct HeavyHitters::Talker
+     * @brief 조회 결과 한 줄.
+     */
+    struct Talker
+    {
+        std::uint64_t key;          ///< 송신자 키.
+        std::uint32_t messages;     ///< 시간 창 안의 추정 메시지 수.
+        std::uint32_t bytes;        ///< 시간 창 안의 추정 바이트 수.
+    };
+
+public:
+    /**
+     * @fn HeavyHitters::HeavyHitters()
+     * @brief 빈 스케치와 힙을 할당합니다. 이후로는 메모리를 더 할당하지 않습니다.
+     * @return 없음.
+     */
+    HeavyHitters();
+
+    /**
+     * @fn HeavyHitters::~HeavyHitters()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~HeavyHitters();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    HeavyHitters(const HeavyHitters& obj) = delete;
+    HeavyHitters& operator=(const HeavyHitters& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    HeavyHitters(HeavyHitters&& obj) = delete;
+    HeavyHitters& operator=(HeavyHitters&& obj) = delete;
+
+public:
+    /**
+     * @fn void HeavyHitters::record(std::uint64_t key, std::uint32_t bytes, std::int64_t now_tick)
+     * @brief 송신자가 메시지 하나를 보냈음을 기록합니다.
+     * @param[IN] std::uint64_t key : 송신자 키.
+     * @param[IN] std::uint32_t bytes : 메시지 바이트 수.
+     * @param[IN] std::int64_t now_tick : 현재 시각 (밀리초 단위 틱).
+     * @return 없음.
+     */
+    void record(std::uint64_t key, std::uint32_t bytes, std::int64_t now_tick);
+
+    /**
+     * @fn int HeavyHitters::collectTop(HeavyHitters::Metric metric, std::int64_t now_tick, HeavyHitters::Talker* talkers, int max_count)
+     * @brief 시간 창 안의 상위 송신자를 많은 순서로 모읍니다.
+     * @param[IN] HeavyHitters::Metric metric : 순위 기준.
+     * @param[IN] std::int64_t now_tick : 현재 시각 (만료된 조각을 먼저 지웁니다).
+     * @param[OUT] HeavyHitters::Talker* talkers : 결과를 저장할 배열.
+     * @param[IN] int max_count : 배열이 담을 수 있는 최대 개수.
+     * @return int : 저장한 개수 (TOP_COUNT 이하).
+     */
+    int collectTop(HeavyHitters::Metric metric, std::int64_t now_tick, HeavyHitters::Talker* talkers, int max_count);
+
+    /**
+     * @fn std::int64_t HeavyHitters::getWindowMs() const
+     * @brief 시간 창의 길이를 반환합니다.
+     * @return std::int64_t : WINDOW_MS * WINDOW_COUNT (밀리초).
+     */
+    std::int64_t getWindowMs() const;
+
+    /**
+     * @fn std::size_t HeavyHitters::getMemoryBytes() const
+     * @brief 스케치와 힙이 쓰는 메모리 크기를 반환합니다. 키 수와 무관하게 일정합니다.
+     * @return std::size_t : 바이트 수.
+     */
+    std::size_t getMemoryBytes() const;
+
+private:
+    /**
+     * @struct HeavyHitters::Cell
+     * @brief 스케치 칸 하나. 두 지표를 같은 칸에 두어 행마다 캐시 줄 하나만 건드립니다.
+     */
+    struct Cell
+    {
+        std::uint32_t messages;     ///< 메시지 수.
+        std::uint32_t bytes;        ///< 바이트 수.
+    };
+
+    /**
+     * @struct HeavyHitters::TopHeap
+     * @brief 한 지표의 상위 송신자 최소 힙. 맨 앞이 가장 적게 보낸 송신자입니다.
+     */
+    struct TopHeap
+    {
+        std::array<HeavyHitters::Talker, TOP_COUNT> talkers;   ///< 힙 배열.
+        int count;                                              ///< 사용 중인 개수.
+    };
+
+private:
+    /// 조각별 스케치 (조각 수 * 행 수 * 칸 수).
+    std::vector<HeavyHitters::Cell> _windows;
+
+    /// 모든 조각의 합 (행 수 * 칸 수).
+    std::vector<HeavyHitters::Cell> _total;
+
+    /// 메시지 수 상위 힙.
+    HeavyHitters::TopHeap _messageTop;
+
+    /// 바이트 수 상위 힙.
+    HeavyHitters::TopHeap _byteTop;
+
+    /// 지금 기록 중인 조각 번호.
+    int _currentWindow;
+
+    /// 지금 조각이 시작된 시각 (밀리초 단위 틱, 아직 기록이 없으면 -1).
+    std::int64_t _windowStartTick;
+
+private:
+    /**
+     * @fn void HeavyHitters::advance(std::int64_t now_tick)
+     * @brief 지난 조각을 만료시키고 합계에서 뺀 뒤, 힙의 값을 합계 기준으로 다시 계산합니다.
+     * @param[IN] std::int64_t now_tick : 현재 시각.
+     * @return 없음.
+     */
+    void advance(std::int64_t now_tick);
+
+    /**
+     * @fn HeavyHitters::Cell HeavyHitters::estimate(std::uint64_t key) const
+     * @brief 합계 스케치에서 키의 추정치를 구합니다.
+     * @param[IN] std::uint64_t key : 송신자 키.
+     * @return HeavyHitters::Cell : 지표별 추정치 (행마다의 최솟값).
+     */
+    HeavyHitters::Cell estimate(std::uint64_t key) const;
+
+    /**
+     * @fn void HeavyHitters::offer(HeavyHitters::TopHeap& heap, HeavyHitters::Metric metric, const HeavyHitters::Talker& talker)
+     * @brief 송신자를 힙에 반영합니다. 이미 있으면 값을 바꾸고, 없으면 가장 적은 송신자보다 많을 때만 바꿔 넣습니다.
+     * @param[IN,OUT] HeavyHitters::TopHeap& heap : 대상 힙.
+     * @param[IN] HeavyHitters::Metric metric : 힙의 순위 기준.
+     * @param[IN] const HeavyHitters::Talker& talker : 새 추정치.
+     * @return 없음.
+     */
+    void offer(HeavyHitters::TopHeap& heap, HeavyHitters::Metric metric, const HeavyHitters::Talker& talker);
+
+    /**
+     * @fn static void HeavyHitters::getCells(std::uint64_t key, std::array<std::size_t, SKETCH_DEPTH>& cells)
+     * @brief 키가 행마다 쓰는 칸의 위치를 구합니다. 키를 한 번만 섞고 두 해시의 선형 조합으로 행마다 다른 칸을 고릅니다.
+     * @param[IN] std::uint64_t key : 송신자 키.
+     * @param[OUT] std::array<std::size_t, SKETCH_DEPTH>& cells : 행마다의 칸 위치 (row * SKETCH_WIDTH + 칸 번호).
+     * @return 없음.
+     */
+    static void getCells(std::uint64_t key, std::array<std::size_t, SKETCH_DEPTH>& cells);
+
+    /**
+     * @fn static std::uint32_t HeavyHitters::getValue(const HeavyHitters::Talker& talker, HeavyHitters::Metric metric)
+     * @brief 송신자의 지표 값을 반환합니다.
+     * @param[IN] const HeavyHitters::Talker& talker : 송신자.
+     * @param[IN] HeavyHitters::Metric metric : 지표.
+     * @return std::uint32_t : 메시지 수 또는 바이트 수.
+     */
+    static std::uint32_t getValue(const HeavyHitters::Talker& talker, HeavyHitters::Metric metric);
+};
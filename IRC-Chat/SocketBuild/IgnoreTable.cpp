@@ -0,0 +1,113 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file IgnoreTable.cpp
+ * @brief IgnoreTable.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "IgnoreTable.h"
+#include "DebugHelper.h"
+
+IgnoreTable::IgnoreTable()
+    : _ignoredBy(), _muted(), _suppressedCount(0)
+{
+    LOG_DEBUG("IgnoreTable 객체를 생성합니다.");
+}
+
+IgnoreTable::~IgnoreTable()
+{
+    LOG_DEBUG("IgnoreTable 객체를 삭제합니다.");
+}
+
+IgnoreTable::Result IgnoreTable::toggleIgnore(int recipient_index, int sender_index, bool& ignoring)
+{
+    if (this->isValidIndex(recipient_index) == false || this->isValidIndex(sender_index) == false)
+    {
+        return (IgnoreTable::Result::INVALID_INDEX);
+    }
+    if (recipient_index == sender_index)
+    {
+        return (IgnoreTable::Result::SELF_TARGET);
+    }
+
+    ClientManagerBase::SessionMask& ignored_by = this->_ignoredBy[sender_index];
+    ignoring = (ignored_by.test(recipient_index) == false);
+    if (ignoring)
+    {
+        ignored_by.set(recipient_index);
+    }
+    else
+    {
+        ignored_by.reset(recipient_index);
+    }
+    return (IgnoreTable::Result::SUCCESS);
+}
+
+IgnoreTable::Result IgnoreTable::toggleMute(int client_index, bool& muted)
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return (IgnoreTable::Result::INVALID_INDEX);
+    }
+
+    muted = (this->_muted.test(client_index) == false);
+    if (muted)
+    {
+        this->_muted.set(client_index);
+    }
+    else
+    {
+        this->_muted.reset(client_index);
+    }
+    return (IgnoreTable::Result::SUCCESS);
+}
+
+bool IgnoreTable::isMuted(int client_index) const
+{
+    return (this->_muted.test(client_index));
+}
+
+void IgnoreTable::excludeIgnoring(int sender_index, ClientManagerBase::SessionMask& recipients)
+{
+    if (this->isValidIndex(sender_index) == false)
+    {
+        return ;
+    }
+
+    const ClientManagerBase::SessionMask& ignored_by = this->_ignoredBy[sender_index];
+    this->_suppressedCount = this->_suppressedCount + (std::uint64_t)recipients.countCommon(ignored_by);
+    recipients.subtract(ignored_by);
+}
+
+void IgnoreTable::clearSlot(int client_index)
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return ;
+    }
+
+    // 슬롯이 다른 사람에게 다시 할당되므로, 이 슬롯이 무시하던 관계와 이 슬롯을 무시하던 관계를 모두 지웁니다.
+    this->_ignoredBy[client_index].clear();
+    for (ClientManagerBase::SessionMask& ignored_by : this->_ignoredBy)
+    {
+        ignored_by.reset(client_index);
+    }
+    this->_muted.reset(client_index);
+}
+
+int IgnoreTable::getMutedCount() const
+{
+    return (this->_muted.count());
+}
+
+std::uint64_t IgnoreTable::getSuppressedCount() const
+{
+    return (this->_suppressedCount);
+}
+
+bool IgnoreTable::isValidIndex(int client_index) const
+{
+    return (client_index >= 0 && client_index < ClientManagerBase::MAX_CLIENTS);
+}
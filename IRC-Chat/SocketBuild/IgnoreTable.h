@@ -0,0 +1,139 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file IgnoreTable.h
+ * @brief 접속자별 무시 목록과 운영자의 채팅 금지 상태를 슬롯 비트 집합으로 보관하는 IgnoreTable 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 무시 관계는 보낸 사람 기준으로 저장합니다. 보낸 사람 슬롯마다 "그 사람을 무시하는 받는 사람" 집합을 하나씩 둡니다.
+ * <br>따라서 팬아웃은 받는 사람을 하나씩 확인하지 않고, 연결된 슬롯 집합에서 보낸 사람의 집합을 단어 단위로 한 번 빼면 됩니다.
+ * <br>채팅 금지는 슬롯 집합 하나이므로, 금지된 사람의 채팅은 줄을 만들기 전에 비트 하나로 거를 수 있습니다.
+ * <br>상태는 슬롯에 묶여 있으므로 일시 중단 동안 유지되고, 슬롯이 비워질 때 clearSlot()으로 지웁니다.
+ */
+
+#include "ClientManager.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @class IgnoreTable
+ * @brief 슬롯 간 무시 관계와 채팅 금지 슬롯을 관리합니다.
+ */
+class IgnoreTable
+{
+public:
+    /**
+     * @enum IgnoreTable::Result
+     * @brief 무시/금지 상태 변경 결과.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 상태를 바꿨습니다.
+        INVALID_INDEX,  ///< 슬롯 번호가 범위를 벗어났습니다.
+        SELF_TARGET     ///< 자기 자신은 무시할 수 없습니다.
+    };
+
+public:
+    /**
+     * @fn IgnoreTable::IgnoreTable()
+     * @brief 무시 관계와 금지 슬롯이 없는 표를 생성합니다.
+     * @return 없음.
+     */
+    IgnoreTable();
+
+    /**
+     * @fn IgnoreTable::~IgnoreTable()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~IgnoreTable();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    IgnoreTable(const IgnoreTable& obj) = delete;
+    IgnoreTable& operator=(const IgnoreTable& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    IgnoreTable(IgnoreTable&& obj) = delete;
+    IgnoreTable& operator=(IgnoreTable&& obj) = delete;
+
+public:
+    /**
+     * @fn IgnoreTable::Result IgnoreTable::toggleIgnore(int recipient_index, int sender_index, bool& ignoring)
+     * @brief 받는 사람이 보낸 사람을 무시하는지 여부를 뒤집습니다.
+     * @param[IN] int recipient_index : 무시 목록의 주인 슬롯.
+     * @param[IN] int sender_index : 무시하거나 무시를 풀 대상 슬롯.
+     * @param[OUT] bool& ignoring : 바뀐 뒤 무시 중이면 true.
+     * @return IgnoreTable::Result : 변경 결과.
+     */
+    IgnoreTable::Result toggleIgnore(int recipient_index, int sender_index, bool& ignoring);
+
+    /**
+     * @fn IgnoreTable::Result IgnoreTable::toggleMute(int client_index, bool& muted)
+     * @brief 슬롯의 채팅 금지 여부를 뒤집습니다.
+     * @param[IN] int client_index : 대상 슬롯.
+     * @param[OUT] bool& muted : 바뀐 뒤 금지 중이면 true.
+     * @return IgnoreTable::Result : 변경 결과.
+     */
+    IgnoreTable::Result toggleMute(int client_index, bool& muted);
+
+    /**
+     * @fn bool IgnoreTable::isMuted(int client_index) const
+     * @brief 슬롯이 채팅 금지 상태인지 확인합니다.
+     * @param[IN] int client_index : 확인할 슬롯.
+     * @return bool : 금지 중이면 true.
+     */
+    bool isMuted(int client_index) const;
+
+    /**
+     * @fn void IgnoreTable::excludeIgnoring(int sender_index, ClientManagerBase::SessionMask& recipients)
+     * @brief 받는 사람 집합에서 보낸 사람을 무시하는 슬롯을 뺍니다.
+     * @param[IN] int sender_index : 보낸 사람 슬롯 (범위 밖이면 아무것도 빼지 않습니다).
+     * @param[IN,OUT] ClientManagerBase::SessionMask& recipients : 받는 사람 집합.
+     * @return 없음.
+     */
+    void excludeIgnoring(int sender_index, ClientManagerBase::SessionMask& recipients);
+
+    /**
+     * @fn void IgnoreTable::clearSlot(int client_index)
+     * @brief 슬롯이 비워질 때 그 슬롯의 무시 목록, 그 슬롯을 무시하던 관계, 금지 상태를 모두 지웁니다.
+     * @param[IN] int client_index : 비워지는 슬롯.
+     * @return 없음.
+     */
+    void clearSlot(int client_index);
+
+    /**
+     * @fn int IgnoreTable::getMutedCount() const
+     * @brief 채팅 금지 중인 슬롯 수를 반환합니다.
+     * @return int : 금지 슬롯 수.
+     */
+    int getMutedCount() const;
+
+    /**
+     * @fn std::uint64_t IgnoreTable::getSuppressedCount() const
+     * @brief 무시 목록 때문에 보내지 않은 전달의 누적 수를 반환합니다.
+     * @return std::uint64_t : 걸러낸 받는 사람 수의 합.
+     */
+    std::uint64_t getSuppressedCount() const;
+
+private:
+    /// 보낸 사람 슬롯별로 그 사람을 무시하는 받는 사람 집합.
+    std::array<ClientManagerBase::SessionMask, ClientManagerBase::MAX_CLIENTS> _ignoredBy;
+
+    /// 채팅 금지된 슬롯 집합.
+    ClientManagerBase::SessionMask _muted;
+
+    /// 무시 목록 때문에 걸러낸 전달 수.
+    std::uint64_t _suppressedCount;
+
+private:
+    /**
+     * @fn bool IgnoreTable::isValidIndex(int client_index) const
+     * @brief 슬롯 번호가 범위 안인지 확인합니다.
+     * @param[IN] int client_index : 슬롯 번호.
+     * @return bool : 0 이상 MAX_CLIENTS 미만이면 true.
+     */
+    bool isValidIndex(int client_index) const;
+};
@@ -0,0 +1,94 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopClock.cpp
+ * @brief LoopClock.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "LoopClock.h"
+#include "DebugHelper.h"
+#include <chrono>
+
+LoopClock::LoopClock()
+    : _now(), _tick(0), _wallSeconds(-1), _timestamp(), _renderCount(0), _loggerAttached(false)
+{
+    LOG_DEBUG("LoopClock 객체를 생성합니다.");
+}
+
+LoopClock::~LoopClock()
+{
+    if (this->_loggerAttached && loop_timestamp == &this->_timestamp)
+    {
+        loop_timestamp = nullptr;
+    }
+    LOG_DEBUG("LoopClock 객체를 삭제합니다.");
+}
+
+void LoopClock::update(NetworkTransport::Clock::time_point monotonic_now)
+{
+    this->_now = monotonic_now;
+    this->_tick = std::chrono::duration_cast<std::chrono::milliseconds>(monotonic_now.time_since_epoch()).count();
+
+    // 초가 바뀐 반복에서만 지역 시각 변환과 문자열 서식을 다시 합니다.
+    std::time_t wall_seconds = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (wall_seconds != this->_wallSeconds)
+    {
+        this->_wallSeconds = wall_seconds;
+        this->renderTimestamp();
+    }
+}
+
+void LoopClock::attachLogger()
+{
+    loop_timestamp = &this->_timestamp;
+    this->_loggerAttached = true;
+}
+
+void LoopClock::detachLogger()
+{
+    if (loop_timestamp == &this->_timestamp)
+    {
+        loop_timestamp = nullptr;
+    }
+    this->_loggerAttached = false;
+}
+
+NetworkTransport::Clock::time_point LoopClock::now() const
+{
+    return (this->_now);
+}
+
+std::int64_t LoopClock::getTick() const
+{
+    return (this->_tick);
+}
+
+std::time_t LoopClock::getWallSeconds() const
+{
+    return (this->_wallSeconds);
+}
+
+const std::string& LoopClock::getTimestamp() const
+{
+    return (this->_timestamp);
+}
+
+std::uint64_t LoopClock::getRenderCount() const
+{
+    return (this->_renderCount);
+}
+
+void LoopClock::renderTimestamp()
+{
+    struct tm time_info;
+    localtime_s(&time_info, &this->_wallSeconds);
+
+    char buffer[32];
+    std::size_t length = strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &time_info);
+
+    // 길이가 같으므로 기존 버퍼를 그대로 덮어써 할당하지 않습니다.
+    this->_timestamp.assign(buffer, length);
+    this->_renderCount = this->_renderCount + 1;
+}
@@ -0,0 +1,136 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopClock.h
+ * @brief 서버 루프가 반복마다 한 번 읽은 시각을 보관하고, 초 단위 타임스탬프 문자열을 캐시하는 LoopClock 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 서버 루프는 select가 돌아온 직후 update()로 단조 시계와 벽시계를 한 번씩 읽습니다.
+ * <br>그 반복 안의 타이머, 유휴 검사, 재전송 버퍼, 로그는 시계를 다시 읽지 않고 이 값을 씁니다.
+ * <br>"YYYY-MM-DD HH:MM:SS" 문자열은 벽시계의 초가 바뀐 반복에서만 다시 만들고, 그 밖에는 같은 문자열을 참조로 돌려줍니다.
+ * <br>attachLogger()를 호출한 스레드의 로그는 time/localtime_s/strftime 대신 이 문자열을 씁니다.
+ * @note 루프 스레드 전용입니다. 작업 구간의 길이를 재는 FlightRecorder와 RecordingTransport는 정확한 시각이 필요하므로 전송 계층의 시계를 직접 읽습니다.
+ */
+
+#include "NetworkTransport.h"
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+/**
+ * @class LoopClock
+ * @brief 루프 반복 단위로 갱신되는 시각과 캐시된 타임스탬프를 제공합니다.
+ */
+class LoopClock
+{
+public:
+    /**
+     * @fn LoopClock::LoopClock()
+     * @brief 시계를 생성합니다. update()를 호출하기 전에는 시각이 0입니다.
+     * @return 없음.
+     */
+    LoopClock();
+
+    /**
+     * @fn LoopClock::~LoopClock()
+     * @brief 로거에 연결되어 있으면 연결을 끊습니다.
+     * @return 없음.
+     */
+    ~LoopClock();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    LoopClock(const LoopClock& obj) = delete;
+    LoopClock& operator=(const LoopClock& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    LoopClock(LoopClock&& obj) = delete;
+    LoopClock& operator=(LoopClock&& obj) = delete;
+
+public:
+    /**
+     * @fn void LoopClock::update(NetworkTransport::Clock::time_point monotonic_now)
+     * @brief 이번 반복의 시각을 기록합니다. 벽시계는 여기서 한 번 읽고, 초가 바뀌었으면 타임스탬프를 다시 만듭니다.
+     * @param[IN] NetworkTransport::Clock::time_point monotonic_now : 전송 계층의 현재 시각 (SimulatedTransport에서는 가상 시각).
+     * @return 없음.
+     */
+    void update(NetworkTransport::Clock::time_point monotonic_now);
+
+    /**
+     * @fn void LoopClock::attachLogger()
+     * @brief 호출한 스레드의 로그 타임스탬프로 이 시계의 문자열을 쓰게 합니다. 루프 스레드에서 첫 update() 뒤에 호출합니다.
+     * @return 없음.
+     */
+    void attachLogger();
+
+    /**
+     * @fn void LoopClock::detachLogger()
+     * @brief 호출한 스레드의 로그가 다시 스스로 시각을 읽게 합니다. attachLogger()를 호출한 스레드에서 호출합니다.
+     * @return 없음.
+     */
+    void detachLogger();
+
+    /**
+     * @fn NetworkTransport::Clock::time_point LoopClock::now() const
+     * @brief 이번 반복의 단조 시각을 반환합니다.
+     * @return NetworkTransport::Clock::time_point : 마지막 update()의 시각.
+     */
+    NetworkTransport::Clock::time_point now() const;
+
+    /**
+     * @fn std::int64_t LoopClock::getTick() const
+     * @brief 이번 반복의 단조 시각을 밀리초 단위 틱으로 반환합니다.
+     * @return std::int64_t : 밀리초 단위 틱.
+     */
+    std::int64_t getTick() const;
+
+    /**
+     * @fn std::time_t LoopClock::getWallSeconds() const
+     * @brief 이번 반복의 벽시계 시각을 초 단위로 반환합니다.
+     * @return std::time_t : 1970-01-01 UTC부터 지난 초.
+     */
+    std::time_t getWallSeconds() const;
+
+    /**
+     * @fn const std::string& LoopClock::getTimestamp() const
+     * @brief 이번 반복의 지역 시각을 "YYYY-MM-DD HH:MM:SS" 형식으로 반환합니다.
+     * @return const std::string& : 캐시된 타임스탬프 (다음 update()까지 유효).
+     */
+    const std::string& getTimestamp() const;
+
+    /**
+     * @fn std::uint64_t LoopClock::getRenderCount() const
+     * @brief 타임스탬프 문자열을 다시 만든 누적 횟수를 반환합니다.
+     * @return std::uint64_t : 다시 만든 횟수 (초가 바뀐 반복 수).
+     */
+    std::uint64_t getRenderCount() const;
+
+private:
+    /// 마지막 update()의 단조 시각.
+    NetworkTransport::Clock::time_point _now;
+
+    /// _now의 밀리초 단위 틱.
+    std::int64_t _tick;
+
+    /// 마지막 update()의 벽시계 초 (-1이면 아직 읽지 않음).
+    std::time_t _wallSeconds;
+
+    /// _wallSeconds를 지역 시각으로 바꾼 문자열.
+    std::string _timestamp;
+
+    /// 타임스탬프를 다시 만든 횟수.
+    std::uint64_t _renderCount;
+
+    /// 로거에 연결되어 있으면 true.
+    bool _loggerAttached;
+
+private:
+    /**
+     * @fn void LoopClock::renderTimestamp()
+     * @brief _wallSeconds로 타임스탬프 문자열을 다시 만듭니다.
+     * @return 없음.
+     */
+    void renderTimestamp();
+};
@@ -9,19 +9,25 @@
 
 #include "MessageReceiver.h"
 #include "DebugHelper.h"
+#include "TextScanner.h"
+#include "CommandParser.h"
+#include "TransportInstances.h"
 
-MessageReceiver::MessageReceiver(SOCKET client_socket)
-    : _clientSocket(client_socket), _lastMessage("")
+template <typename Transport>
+MessageReceiver<Transport>::MessageReceiver(Transport& transport, SOCKET client_socket, std::string& pending_input)
+    : _transport(transport), _clientSocket(client_socket), _pendingInput(pending_input), _lastMessage(""), _lines()
 {
     LOG_DEBUG("MessageReceiver 객체를 생성합니다.");
 }
 
-MessageReceiver::~MessageReceiver()
+template <typename Transport>
+MessageReceiver<Transport>::~MessageReceiver()
 {
     LOG_DEBUG("MessageManager 객체를 삭제합니다.");
 }
 
-MessageReceiver::Result MessageReceiver::receiveMessage()
+template <typename Transport>
+MessageReceiverBase::Result MessageReceiver<Transport>::receiveMessage()
 {
     char buffer[MessageReceiver::BUFFER_SIZE];
 
@@ -38,25 +44,36 @@ MessageReceiver::Result MessageReceiver::receiveMessage()
     //      > 0: 실제로 읽은 바이트 수.
     //      == 0: 연결이 정상적으로 종료됨.
     //      < 0: 오류 발생 (예: 연결 끊김 또는 네트워크 오류).
-    int receive_result = recv(this->_clientSocket, buffer, BUFFER_SIZE - 1, 0);
+    int receive_result = this->_transport.receiveBytes(this->_clientSocket, buffer, BUFFER_SIZE - 1);
 
     // 수신이 제대로 이루어진 경우.
     if (receive_result > 0)
     {
-        buffer[receive_result] = '\0';
-        this->_lastMessage = std::string(buffer);
+        // 수신 받은 데이터를 이전 나머지에 이어 붙여 완성된 줄만 나누고 줄 끝 문자를 제거합니다.
+        this->splitLines(buffer, (std::size_t)receive_result);
 
-        LOG_INFO("수신: " + this->_lastMessage);
-        // 수신 받은 문자열의 케리지 리턴을 제거합니다.
-        cleanMessage(this->_lastMessage);
-
-        // 수신받은 문자열이 quit인지를 체크합니다.
-        if (isQuitCommand(this->_lastMessage))
+        for (std::size_t i = 0; i < this->_lines.size(); ++i)
         {
-            // 맞다면.
-            return (MessageReceiver::Result::CLIENT_QUIT);
+            LOG_INFO("수신: " + CommandParser::redactSecrets(this->_lines[i]));
+
+            // 수신받은 줄이 quit인지를 체크합니다.
+            if (isQuitCommand(this->_lines[i]))
+            {
+                // 맞다면 그 앞의 줄까지만 남깁니다.
+                this->_lines.resize(i);
+                return (MessageReceiver::Result::CLIENT_QUIT);
+            }
         }
 
+        if (this->_lines.empty() == false)
+        {
+            this->_lastMessage = this->_lines.back();
+        }
+        return (MessageReceiver::Result::SUCCESS);
+    }
+    // 논블로킹 소켓에 아직 읽을 데이터가 없음. 처리할 줄 없이 성공으로 돌려줍니다.
+    else if (receive_result == SOCKET_ERROR && this->_transport.getLastError() == WSAEWOULDBLOCK)
+    {
         return (MessageReceiver::Result::SUCCESS);
     }
     // 연결이 정상적으로 종료.
@@ -68,32 +85,92 @@ MessageReceiver::Result MessageReceiver::receiveMessage()
     // 오류 발생.
     else
     {
-        LOG_ERROR("메시지 수신을 실패했습니다.\n에러 코드: " + std::to_string(WSAGetLastError()));
+        LOG_ERROR("메시지 수신을 실패했습니다.\n에러 코드: " + std::to_string(this->_transport.getLastError()));
         return (MessageReceiver::Result::FAIL_RECEIVE);
     }
 }
 
-const std::string& MessageReceiver::getLastMessage() const
+template <typename Transport>
+const std::string& MessageReceiver<Transport>::getLastMessage() const
 {
     // 마지막 문자열을 반환합니다.
     return (this->_lastMessage);
 }
 
-bool MessageReceiver::isQuitCommand(const std::string& message) const
+template <typename Transport>
+const std::vector<std::string>& MessageReceiver<Transport>::getLines() const
+{
+    return (this->_lines);
+}
+
+template <typename Transport>
+bool MessageReceiver<Transport>::isQuitCommand(const std::string& message) const
 {
     // quit가 맞으면 true, 틀리면 false.
-    return (message == "quit");
+    std::string_view arguments;
+    return (CommandParser::parse(message, arguments) == CommandParser::Command::QUIT);
 }
 
-void MessageReceiver::cleanMessage(std::string& message)
+template <typename Transport>
+bool MessageReceiver<Transport>::isUserListCommand(const std::string& message) const
 {
-    // 캐리지 리턴을 제거합니다.
-    if (!message.empty() && message.back() == '\n')
-    {
-        message.pop_back();
-    }
-    if (!message.empty() && message.back() == '\r')
+    // /users가 맞으면 true, 틀리면 false.
+    std::string_view arguments;
+    return (CommandParser::parse(message, arguments) == CommandParser::Command::USERS);
+}
+
+template <typename Transport>
+void MessageReceiver<Transport>::splitLines(const char* data, std::size_t size)
+{
+    this->_lines.clear();
+    this->_pendingInput.append(data, size);
+
+    const char* buffer = this->_pendingInput.data();
+    std::size_t buffer_size = this->_pendingInput.size();
+    std::size_t position = 0;
+    while (position < buffer_size)
     {
-        message.pop_back();
+        std::size_t remaining = buffer_size - position;
+        std::size_t limit = (remaining < MessageReceiver::MAX_LINE_LENGTH) ? remaining : MessageReceiver::MAX_LINE_LENGTH;
+        std::size_t line_break = TextScanner::findLineBreak(buffer + position, limit);
+        std::size_t consumed = line_break + 1;
+        if (line_break == limit)
+        {
+            // 줄 끝이 아직 오지 않았으면 다음 수신까지 남깁니다.
+            if (limit < MessageReceiver::MAX_LINE_LENGTH)
+            {
+                break;
+            }
+
+            // 너무 길면 잘린 UTF-8 문자 앞에서 잘라 한 줄로 내보냅니다.
+            line_break = TextScanner::findUtf8Boundary(buffer + position, MessageReceiver::MAX_LINE_LENGTH);
+            if (line_break == 0)
+            {
+                line_break = MessageReceiver::MAX_LINE_LENGTH;
+            }
+            consumed = line_break;
+        }
+        else if (buffer[position + line_break] == '\r' && consumed < remaining && buffer[position + consumed] == '\n')
+        {
+            // "\r\n"은 줄 끝 하나로 봅니다. 뒤늦게 온 '\n'은 빈 줄이 되어 버려집니다.
+            consumed = consumed + 1;
+        }
+
+        if (line_break > 0)
+        {
+            this->_lines.emplace_back(buffer + position, line_break);
+
+            // 잘못된 UTF-8 바이트가 그대로 브로드캐스트되지 않도록 바꿉니다.
+            std::size_t replaced_count = TextScanner::sanitizeUtf8(this->_lines.back());
+            if (replaced_count > 0)
+            {
+                LOG_WARN("잘못된 UTF-8 바이트를 바꿨습니다. - 소켓: " + std::to_string(this->_clientSocket) + ", " + std::to_string(replaced_count) + "곳");
+            }
+        }
+        position = position + consumed;
     }
+
+    this->_pendingInput.erase(0, position);
 }
+
+INSTANTIATE_COMPONENT_TRANSPORTS(MessageReceiver);
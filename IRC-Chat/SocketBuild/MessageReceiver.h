@@ -12,24 +12,20 @@
  * 특정 명령(예: "quit")을 감지하고, 명령에 맞는 역할을 수행합니다.
  */
 
-#include <winsock2.h>
+#include "NetworkTransport.h"
 #include <string>
+#include <vector>
 
 /**
- * @class MessageReceiver
- * @brief 클라이언트 소켓으로부터 들어오는 메시지를 처리하는 클래스입니다.
- *
- * @details
- * 클라이언트 소켓을 전달받아 객체를 생성합니다.
- * <br>소켓으로부터 메시지를 수신하여 저장하고, 특별한 명령(예: 종료 요청)이 있는지 확인합니다. 
- * <br>고정 크기 버퍼를 사용하여 수신된 데이터를 처리합니다.
+ * @class MessageReceiverBase
+ * @brief 수신 결과 값입니다. MessageReceiver를 어떤 전송 계층으로 만들든 같은 타입입니다.
  */
-class MessageReceiver
+class MessageReceiverBase
 {
     public:
 
         /**
-         * @enum MessageReceiver::Result
+         * @enum MessageReceiverBase::Result
          * @brief 메시지 수신의 결과 상태 값.
          */
         enum class Result
@@ -40,15 +36,34 @@ class MessageReceiver
             CLIENT_QUIT,        ///< 클라이언트가 quit 명령을 보냄
             CLIENT_DISCONNECTED ///< 클라이언트 연결이 예기치 않게 끊어짐
         };
+};
+
+/**
+ * @class MessageReceiver
+ * @brief 클라이언트 소켓으로부터 들어오는 메시지를 처리하는 클래스입니다.
+ * @tparam Transport : recv 호출에 사용할 전송 계층 타입.
+ *
+ * @details
+ * 클라이언트 소켓을 전달받아 객체를 생성합니다.
+ * <br>소켓으로부터 메시지를 수신하여 저장하고, 특별한 명령(예: 종료 요청)이 있는지 확인합니다. 
+ * <br>고정 크기 버퍼를 사용하여 수신된 데이터를 처리합니다.
+ * <br>받은 데이터는 클라이언트별 나머지 버퍼에 이어 붙인 뒤 줄 끝('\n', '\r', "\r\n")마다 나누고, 잘못된 UTF-8 바이트는 U+FFFD로 바꿉니다.
+ * <br>줄 끝을 아직 받지 못한 마지막 조각은 나머지 버퍼에 남겨 다음 수신에서 이어 붙입니다. (SessionContext와 같은 규칙)
+ */
+template <typename Transport>
+class MessageReceiver : public MessageReceiverBase
+{
     public:
         /**
-         * @fn MessageReceiver::MessageReceiver(SOCKET client_socket)
+         * @fn MessageReceiver::MessageReceiver(Transport& transport, SOCKET client_socket, std::string& pending_input)
          * @brief 주어진 클라이언트 소켓에 대한 MessageReceiver 객체를 생성합니다.
+         * @param[IN] Transport& transport : recv 호출에 사용할 전송 계층.
          * @param[IN] SOCKET client_socket : 이 수신기가 메시지를 받을 클라이언트 소켓.
+         * @param[IN, OUT] std::string& pending_input : 이 클라이언트의 이전 수신에서 줄을 이루지 못한 나머지. (ClientManager::getPendingInput())
          * @return 없음.
-         * @note SOCKET을 인자로 받는 이 생성자만 사용할 수 있으며, 내부 변수 초기화합니다.
+         * @note 수신기는 매 수신마다 새로 만들어지므로, 나머지는 클라이언트 슬롯이 소유합니다.
          */
-        explicit MessageReceiver(SOCKET client_socket);
+        MessageReceiver(Transport& transport, SOCKET client_socket, std::string& pending_input);
 
         /**
          * @fn MessageReceiver::~MessageReceiver()
@@ -74,11 +89,12 @@ public:
          *
          * @details
          * 클라이언트 소켓에서 데이터를 읽어들입니다.
-         * <br>성공 시 해당 데이터를 내부에 저장하여 getLastMessage()로 접근할 수 있습니다.
+         * <br>성공 시 완성된 줄을 내부에 저장하여 getLines()와 getLastMessage()로 접근할 수 있습니다.
+         * <br>줄 끝이 오지 않았다면 SUCCESS이면서 getLines()가 비어 있을 수 있습니다.
          * 
          * @note
          * - 메시지가 정상 수신되면 SUCCESS.
-         * - 수신된 메세지가 "quit" 이면 CLIENT_QUIT.
+         * - 수신된 줄 중에 "quit"가 있으면 CLIENT_QUIT (그 앞의 줄까지만 getLines()에 남습니다).
          * - 오류 발생 시 적절한 상태 값.
          */
         MessageReceiver::Result receiveMessage();
@@ -87,10 +103,17 @@ public:
         /**
          * @fn const std::string& MessageReceiver::getLastMessage() const
          * @brief 마지막으로 수신된 메시지를 반환합니다.
-         * @return const std::string& : 저장된 마지막 메시지 문자열에 대한 참조.
+         * @return const std::string& : 저장된 마지막 메시지 문자열에 대한 참조. (완성된 줄이 없었으면 빈 문자열)
          */
         const std::string& getLastMessage() const;
 
+        /**
+         * @fn const std::vector<std::string>& MessageReceiver::getLines() const
+         * @brief 마지막 수신에서 나눈 줄 목록을 반환합니다.
+         * @return const std::vector<std::string>& : 줄 끝 문자를 제거하고 UTF-8을 검증한 줄 목록. (빈 줄은 없습니다)
+         */
+        const std::vector<std::string>& getLines() const;
+
         /**
          * @fn bool MessageReceiver::isQuitCommand(const std::string& message) const
          * @brief 주어진 메시지가 "quit" 명령인지 확인합니다.
@@ -99,23 +122,47 @@ public:
          */
         bool isQuitCommand(const std::string& message) const;
 
+        /**
+         * @fn bool MessageReceiver::isUserListCommand(const std::string& message) const
+         * @brief 주어진 메시지가 접속자 목록 요청 명령("/users")인지 확인합니다.
+         * @param[IN] const std::string& message : 검사할 메시지 문자열.
+         * @return bool : 해당 메시지가 "/users"와 일치하면 true, 아니면 false.
+         */
+        bool isUserListCommand(const std::string& message) const;
+
     private:
+        /// @brief recv 호출에 사용하는 전송 계층.
+        Transport& _transport;
+
         /// @brief 통신에 사용하는 클라이언트 소켓.
         SOCKET _clientSocket;
 
+        /// @brief 클라이언트 슬롯이 소유한, 줄 끝을 아직 받지 못한 수신 나머지.
+        std::string& _pendingInput;
+
         /// @brief 가장 최근에 수신한 메시지.
         std::string _lastMessage;
 
+        /// @brief 가장 최근 수신에서 나눈 줄 목록.
+        std::vector<std::string> _lines;
+
         /// 데이터 수신에 사용하는 버퍼 크기(바이트 단위).
         static const int BUFFER_SIZE = 1024;
 
+        /// 줄 끝 없이 이보다 길어진 나머지는 한 줄로 잘라 냅니다. (SessionContext::MAX_LINE_LENGTH와 같은 값)
+        static const std::size_t MAX_LINE_LENGTH = 4096;
+
     private:
         /**
-         * @fn void MessageReceiver::cleanMessage(std::string& message)
-         * @brief 수신한 메시지 문자열에서 캐리지 리턴/뉴라인 문자를 제거합니다.
-         * @param[IN, OUT] std::string& message : 제거할 메시지 문자열.
+         * @fn void MessageReceiver::splitLines(const char* data, std::size_t size)
+         * @brief 수신한 바이트를 나머지 뒤에 붙이고, 완성된 줄만 줄 끝 문자마다 나누어 _lines에 담습니다.
+         * @param[IN] const char* data : 수신한 바이트.
+         * @param[IN] std::size_t size : 바이트 수.
          * @return 없음.
-         * @note 메시지를 수신한 후 호출되어, 메시지 끝의 개행 문자를 제거합니다.
+         * @note
+         * - 줄 끝 없이 끝난 나머지는 _pendingInput에 남깁니다.
+         * - 나머지가 MAX_LINE_LENGTH에 이르면 잘린 UTF-8 문자 앞에서 한 줄로 잘라 냅니다.
+         * - 빈 줄(recv 사이에 나뉜 "\r\n"의 '\n' 포함)은 버립니다.
          */
-        void cleanMessage(std::string& message);
+        void splitLines(const char* data, std::size_t size);
 };
\ No newline at end of file
@@ -9,21 +9,31 @@
 
 #include "MessageSender.h"
 #include "DebugHelper.h"
+#include "TraceRecorder.h"
+#include "TransportInstances.h"
+#include <chrono>
 
-const char* MessageSender::NEW_LINE = "\r\n";
+const char* MessageSenderBase::NEW_LINE = "\r\n";
 
-MessageSender::MessageSender()
+template <typename Transport>
+MessageSender<Transport>::MessageSender(Transport& transport)
+    : _transport(transport), _queues(), _droppedChatCount(0), _coalescedStateCount(0), _fanoutPool(nullptr),
+      _fanoutThreshold(MessageSender::DEFAULT_FANOUT_THRESHOLD), _fanoutThresholdFixed(false), _inlineTargetNs(0.0), _fanoutProbeCount(0), _parallelFanoutCount(0), _hasBacklog(false)
 {
     LOG_DEBUG("MessageSender 객체를 생성합니다.");
 }
 
-MessageSender::~MessageSender()
+template <typename Transport>
+MessageSender<Transport>::~MessageSender()
 {
     LOG_DEBUG("MessageSender 객체를 삭제합니다.");
 }
 
-MessageSender::Result MessageSender::broadcast(const std::string& message, SOCKET* sockets, int socket_count)
+template <typename Transport>
+MessageSenderBase::Result MessageSender<Transport>::broadcast(const std::string& message, SOCKET* sockets, int socket_count, MessageSender::Lane lane)
 {
+    TRACE_SCOPE("MessageSender::broadcast");
+
     // 전송할 소켓이 없는 경우.
     if (socket_count == 0)
     {
@@ -31,19 +41,12 @@ MessageSender::Result MessageSender::broadcast(const std::string& message, SOCKE
         return (MessageSender::Result::TOTAL_FAIL);
     }
 
-    // 클라이언트로 보낼 메세지로 포멧합니다.
-    std::string formatted_message = this->formatMessage(message);
+    // 클라이언트로 보낼 메세지로 포멧합니다. 모든 대기열이 같은 메시지를 공유합니다.
+    std::shared_ptr<const std::string> formatted_message = std::make_shared<const std::string>(this->formatMessage(message));
 
     // 전송 성공 수.
-    int success_count = 0;
-
-    for (int i = 0; i < socket_count; ++i)
-    {
-        if (this->sendMessage(formatted_message, sockets[i]))
-        {
-            success_count = success_count + 1;
-        }
-    }
+    int target_count = 0;
+    int success_count = this->fanout(formatted_message, sockets, socket_count, INVALID_SOCKET, lane, target_count);
 
     // 결과에 따른 분기.
     if (success_count == socket_count)
@@ -63,8 +66,11 @@ MessageSender::Result MessageSender::broadcast(const std::string& message, SOCKE
     }
 }
 
-MessageSender::Result MessageSender::multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket)
+template <typename Transport>
+MessageSenderBase::Result MessageSender<Transport>::multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane)
 {
+    TRACE_SCOPE("MessageSender::multicast");
+
     // 전송할 소켓이 없는 경우.
     if (socket_count == 0)
     {
@@ -72,23 +78,11 @@ MessageSender::Result MessageSender::multicast(const std::string& message, SOCKE
         return (MessageSender::Result::TOTAL_FAIL);
     }
 
-    // 클라이언트로 보낼 메세지로 포멧합니다.
-    std::string formatted_message = this->formatMessage(message);
+    // 클라이언트로 보낼 메세지로 포멧합니다. 모든 대기열이 같은 메시지를 공유합니다.
+    std::shared_ptr<const std::string> formatted_message = std::make_shared<const std::string>(this->formatMessage(message));
     // 제외된 클라이언트를 제외하고 갯수를 맞췅야하기 때문에 두개의 변수로 나눠서 저장한다.
-    int success_count = 0;
     int target_count = 0;
-
-    for (int i = 0; i < socket_count; ++i)
-    {
-        if (sockets[i] != except_socket)
-        {
-            target_count = target_count + 1;
-            if (this->sendMessage(formatted_message, sockets[i]))
-            {
-                success_count = success_count + 1;
-            }
-        }
-    }
+    int success_count = this->fanout(formatted_message, sockets, socket_count, except_socket, lane, target_count);
 
     // 결과에 따른 분기.
     if (target_count == 0)
@@ -113,7 +107,8 @@ MessageSender::Result MessageSender::multicast(const std::string& message, SOCKE
     }
 }
 
-bool MessageSender::unicast(const std::string& message, SOCKET target_socket)
+template <typename Transport>
+bool MessageSender<Transport>::unicast(const std::string& message, SOCKET target_socket, MessageSender::Lane lane)
 {
     if (target_socket == INVALID_SOCKET)
     {
@@ -121,33 +116,554 @@ bool MessageSender::unicast(const std::string& message, SOCKET target_socket)
         return (false);
     }
 
-    std::string formatted_message = this->formatMessage(message);
-    return (sendMessage(formatted_message, target_socket));
+    return (this->enqueue(std::make_shared<const std::string>(this->formatMessage(message)), target_socket, lane));
+}
+
+template <typename Transport>
+bool MessageSender<Transport>::sendFrame(const std::string& frame, SOCKET target_socket)
+{
+    if (target_socket == INVALID_SOCKET)
+    {
+        LOG_WARN("유효하지 않은 소켓에 프레임 전송 시도");
+        return (false);
+    }
+
+    // 프레임은 이미 인코딩되어 있으므로 개행 문자를 붙이지 않습니다.
+    return (this->enqueue(std::make_shared<const std::string>(frame), target_socket, MessageSender::Lane::CONTROL));
+}
+
+template <typename Transport>
+MessageSenderBase::Result MessageSender<Transport>::publishState(const std::string& key, const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket)
+{
+    TRACE_SCOPE("MessageSender::publishState");
+
+    // 모든 상태 슬롯이 같은 메시지를 공유합니다.
+    std::shared_ptr<const std::string> formatted_message = std::make_shared<const std::string>(this->formatMessage(message));
+    int success_count = 0;
+    int target_count = 0;
+
+    for (int i = 0; i < socket_count; ++i)
+    {
+        if (sockets[i] != except_socket)
+        {
+            target_count = target_count + 1;
+            if (this->enqueueState(key, formatted_message, sockets[i]))
+            {
+                success_count = success_count + 1;
+            }
+        }
+    }
+
+    // 상태 갱신은 잦으므로 성공 로그는 남기지 않습니다.
+    if (success_count == target_count)
+    {
+        return (MessageSender::Result::SUCCESS);
+    }
+    else if (success_count > 0)
+    {
+        LOG_WARN("상태 전송 부분 실패: " + std::to_string(success_count) + "/" + std::to_string(target_count));
+        return (MessageSender::Result::PARTIAL_FAIL);
+    }
+    else
+    {
+        LOG_ERROR("상태 전송 실패.");
+        return (MessageSender::Result::TOTAL_FAIL);
+    }
+}
+
+template <typename Transport>
+void MessageSender<Transport>::flush()
+{
+    TRACE_SCOPE("MessageSender::flush");
+
+    this->_hasBacklog = false;
+    for (auto& entry : this->_queues)
+    {
+        this->flushQueue(entry.first, entry.second, MessageSender::CHAT_FLUSH_BYTES);
+
+        const MessageSender::OutboundQueue& queue = entry.second;
+        if (queue.lanes[(int)MessageSender::Lane::CONTROL].empty() == false || queue.lanes[(int)MessageSender::Lane::CHAT].empty() == false
+            || queue.stateOrder.empty() == false)
+        {
+            this->_hasBacklog = true;
+        }
+    }
+}
+
+template <typename Transport>
+bool MessageSender<Transport>::hasBacklog() const
+{
+    return (this->_hasBacklog);
+}
+
+template <typename Transport>
+void MessageSender<Transport>::release(SOCKET target_socket)
+{
+    auto it = this->_queues.find(target_socket);
+    if (it == this->_queues.end())
+    {
+        return ;
+    }
+
+    // 작별 인사 같은 제어 메시지는 닫기 전에 마저 보내고, 남은 채팅과 상태는 버립니다.
+    it->second.states.clear();
+    it->second.stateOrder.clear();
+    this->flushQueue(target_socket, it->second, 0);
+    this->_queues.erase(it);
+}
+
+template <typename Transport>
+void MessageSender<Transport>::enableParallelFanout(int worker_count)
+{
+    if (worker_count <= 0)
+    {
+        this->_fanoutPool.reset();
+        LOG_INFO("병렬 팬아웃을 끕니다.");
+        return ;
+    }
+
+    this->_fanoutPool = std::make_unique<FanoutPool>(worker_count);
+    this->_fanoutThreshold = MessageSender::DEFAULT_FANOUT_THRESHOLD;
+    this->_fanoutThresholdFixed = false;
+    this->_inlineTargetNs = 0.0;
+    this->_fanoutProbeCount = 0;
+    LOG_INFO("병렬 팬아웃을 사용합니다. 스레드: " + std::to_string(this->_fanoutPool->getThreadCount()) + "개, 초기 임계값: " + std::to_string(this->_fanoutThreshold) + "명");
+}
+
+template <typename Transport>
+int MessageSender<Transport>::getFanoutThreshold() const
+{
+    return (this->_fanoutThreshold);
+}
+
+template <typename Transport>
+void MessageSender<Transport>::fixFanoutThreshold(int threshold)
+{
+    if (threshold < MessageSender::MIN_FANOUT_THRESHOLD)
+    {
+        threshold = MessageSender::MIN_FANOUT_THRESHOLD;
+    }
+    else if (threshold > MessageSender::MAX_FANOUT_THRESHOLD)
+    {
+        threshold = MessageSender::MAX_FANOUT_THRESHOLD;
+    }
+
+    this->_fanoutThreshold = threshold;
+    this->_fanoutThresholdFixed = true;
+    LOG_INFO("팬아웃 임계값을 고정합니다: " + std::to_string(threshold) + "명");
+}
+
+template <typename Transport>
+std::uint64_t MessageSender<Transport>::getParallelFanoutCount() const
+{
+    return (this->_parallelFanoutCount);
 }
 
-std::string MessageSender::formatMessage(const std::string& message) const
+template <typename Transport>
+int MessageSender<Transport>::getLaneDepth(SOCKET target_socket, MessageSender::Lane lane) const
+{
+    auto it = this->_queues.find(target_socket);
+    if (it == this->_queues.end())
+    {
+        return (0);
+    }
+    return ((int)it->second.lanes[(int)lane].size());
+}
+
+template <typename Transport>
+int MessageSender<Transport>::getTotalLaneDepth(MessageSender::Lane lane) const
+{
+    int depth = 0;
+    for (const auto& entry : this->_queues)
+    {
+        depth = depth + (int)entry.second.lanes[(int)lane].size();
+    }
+    return (depth);
+}
+
+template <typename Transport>
+std::uint64_t MessageSender<Transport>::getDroppedChatCount() const
+{
+    return (this->_droppedChatCount);
+}
+
+template <typename Transport>
+int MessageSender<Transport>::getStateDepth(SOCKET target_socket) const
+{
+    auto it = this->_queues.find(target_socket);
+    if (it == this->_queues.end())
+    {
+        return (0);
+    }
+    return ((int)it->second.stateOrder.size());
+}
+
+template <typename Transport>
+int MessageSender<Transport>::getTotalStateDepth() const
+{
+    int depth = 0;
+    for (const auto& entry : this->_queues)
+    {
+        depth = depth + (int)entry.second.stateOrder.size();
+    }
+    return (depth);
+}
+
+template <typename Transport>
+std::uint64_t MessageSender<Transport>::getCoalescedStateCount() const
+{
+    return (this->_coalescedStateCount);
+}
+
+template <typename Transport>
+std::string MessageSender<Transport>::formatMessage(const std::string& message) const
 {
     // 메세지에 개행 문자를 추가합니다.
     return (message + MessageSender::NEW_LINE);
 }
 
-bool MessageSender::sendMessage(const std::string& formatted_mssage, SOCKET target_socket)
+template <typename Transport>
+typename MessageSender<Transport>::SendResult MessageSender<Transport>::sendMessage(const std::string& formatted_mssage, std::size_t& offset, SOCKET target_socket)
 {
     // 전송할 클라이언트 소켓을 확인합니다.
     if (target_socket == INVALID_SOCKET)
     {
-        return (false);
+        return (MessageSender::SendResult::FAIL);
     }
 
     // send 함수로 메세지를 전송합니다.
-    int send_result = send(target_socket, formatted_mssage.c_str(), (int)formatted_mssage.length(), 0);
+    // send는 요청보다 적게 보낼 수 있으므로 송신 버퍼가 찰 때까지 남은 바이트를 이어서 보냅니다.
+    while (offset < formatted_mssage.length())
+    {
+        int send_result = this->_transport.sendBytes(target_socket, formatted_mssage.c_str() + offset, (int)(formatted_mssage.length() - offset));
+
+        if (send_result == SOCKET_ERROR)
+        {
+            int error = this->_transport.getLastError();
+            if (error == WSAEWOULDBLOCK)
+            {
+                // 논블로킹 소켓의 송신 버퍼가 가득 찼습니다. 남은 부분은 다음 flush에서 보냅니다.
+                return (MessageSender::SendResult::WOULD_BLOCK);
+            }
+            LOG_DEBUG("메세지 전송 실패 - 소켓: " + std::to_string(target_socket) + ", 에러: " + std::to_string(error));
+            return (MessageSender::SendResult::FAIL);
+        }
+        offset = offset + send_result;
+    }
+
+    LOG_DEBUG("메세지 전송 성공 - 바이트: " + std::to_string(offset));
+    return (MessageSender::SendResult::COMPLETE);
+}
 
-    if (send_result == SOCKET_ERROR)
+template <typename Transport>
+typename MessageSender<Transport>::SendResult MessageSender<Transport>::sendLane(SOCKET target_socket, MessageSender::OutboundQueue& queue, MessageSender::Lane lane, std::size_t budget)
+{
+    int lane_index = (int)lane;
+    std::size_t sent_bytes = 0;
+
+    while (queue.lanes[lane_index].empty() == false && sent_bytes < budget)
+    {
+        const std::shared_ptr<const std::string>& message = queue.lanes[lane_index].front();
+        std::size_t offset_before = queue.frontOffsets[lane_index];
+        MessageSender::SendResult send_result = this->sendMessage(*message, queue.frontOffsets[lane_index], target_socket);
+        sent_bytes = sent_bytes + (queue.frontOffsets[lane_index] - offset_before);
+        if (send_result != MessageSender::SendResult::COMPLETE)
+        {
+            return (send_result);
+        }
+
+        queue.laneBytes[lane_index] = queue.laneBytes[lane_index] - message->length();
+        queue.frontOffsets[lane_index] = 0;
+        queue.lanes[lane_index].pop_front();
+    }
+
+    return (MessageSender::SendResult::COMPLETE);
+}
+
+template <typename Transport>
+bool MessageSender<Transport>::enqueue(const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket, MessageSender::Lane lane)
+{
+    // 전송할 클라이언트 소켓을 확인합니다.
+    if (target_socket == INVALID_SOCKET)
     {
-        LOG_DEBUG("메세지 전송 실패 - 소켓: " + std::to_string(target_socket) + ", 에러: " + std::to_string(WSAGetLastError()));
         return (false);
     }
 
-    LOG_DEBUG("메세지 전송 성공 - 바이트: " + std::to_string(send_result));
+    int dropped_count = MessageSender::pushToLane(this->_queues[target_socket], formatted_message, lane);
+    if (dropped_count > 0)
+    {
+        this->_droppedChatCount = this->_droppedChatCount + dropped_count;
+        LOG_WARN("채팅 대기열 초과로 메시지를 버렸습니다 - 소켓: " + std::to_string(target_socket) + ", 개수: " + std::to_string(dropped_count));
+    }
+
     return (true);
 }
+
+template <typename Transport>
+int MessageSender<Transport>::pushToLane(MessageSender::OutboundQueue& queue, const std::shared_ptr<const std::string>& formatted_message, MessageSender::Lane lane)
+{
+    int lane_index = (int)lane;
+    queue.lanes[lane_index].push_back(formatted_message);
+    queue.laneBytes[lane_index] = queue.laneBytes[lane_index] + formatted_message->length();
+
+    // 느린 클라이언트: 채팅 레인만 오래된 것부터 버립니다.
+    // 일부를 이미 보낸 맨 앞 메시지는 끝까지 보내야 줄이 잘리지 않으므로 그 다음 것부터 버립니다.
+    int dropped_count = 0;
+    if (lane == MessageSender::Lane::CHAT)
+    {
+        std::deque<std::shared_ptr<const std::string>>& messages = queue.lanes[lane_index];
+        std::size_t keep_count = (queue.frontOffsets[lane_index] > 0) ? 2 : 1;
+        while (queue.laneBytes[lane_index] > MessageSender::MAX_CHAT_QUEUE_BYTES && messages.size() > keep_count)
+        {
+            auto oldest = messages.begin() + (keep_count - 1);
+            queue.laneBytes[lane_index] = queue.laneBytes[lane_index] - (*oldest)->length();
+            messages.erase(oldest);
+            dropped_count = dropped_count + 1;
+        }
+    }
+    return (dropped_count);
+}
+
+template <typename Transport>
+int MessageSender<Transport>::fanout(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 청크 둘 이상이 되는 큰 방이고 수신자당 비용을 이미 쟀을 때만 병렬을 고려합니다. (고정된 임계값은 비교할 필요가 없습니다)
+    // 임계값보다 작은 방도 FANOUT_PROBE_INTERVAL번에 한 번은 병렬로 처리해 임계값을 낮출 수 있는지 확인합니다.
+    bool large = (this->_fanoutPool != nullptr && socket_count >= MessageSender::MIN_FANOUT_THRESHOLD
+        && (this->_inlineTargetNs > 0.0 || this->_fanoutThresholdFixed));
+    bool probe = false;
+    if (large && this->_fanoutThresholdFixed == false && socket_count < this->_fanoutThreshold)
+    {
+        this->_fanoutProbeCount = this->_fanoutProbeCount + 1;
+        probe = (this->_fanoutProbeCount % MessageSender::FANOUT_PROBE_INTERVAL == 0);
+    }
+
+    if (large && (socket_count >= this->_fanoutThreshold || probe))
+    {
+        Clock::time_point start = Clock::now();
+        int success_count = this->fanoutParallel(formatted_message, sockets, socket_count, except_socket, lane, target_count);
+        double elapsed_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+        if (this->_fanoutThresholdFixed == false)
+        {
+            this->updateFanoutThreshold(socket_count, elapsed_ns);
+        }
+        this->_parallelFanoutCount = this->_parallelFanoutCount + 1;
+        return (success_count);
+    }
+
+    // 병렬 팬아웃이 켜져 있으면 청크 하나 이상인 방에서 수신자당 비용을 잽니다.
+    bool measure = (this->_fanoutPool != nullptr && socket_count >= MessageSender::FANOUT_CHUNK_SIZE);
+    std::size_t queue_count = this->_queues.size();
+    Clock::time_point start = measure ? Clock::now() : Clock::time_point();
+
+    int success_count = 0;
+    target_count = 0;
+    for (int i = 0; i < socket_count; ++i)
+    {
+        if (sockets[i] != except_socket)
+        {
+            target_count = target_count + 1;
+            if (this->enqueue(formatted_message, sockets[i], lane))
+            {
+                success_count = success_count + 1;
+            }
+        }
+    }
+
+    // 새 대기열을 만든 팬아웃은 평소보다 훨씬 느리므로 표본에서 뺍니다.
+    if (measure && this->_queues.size() == queue_count)
+    {
+        double target_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() / socket_count;
+        this->_inlineTargetNs = (this->_inlineTargetNs == 0.0) ? target_ns : this->_inlineTargetNs * 0.875 + target_ns * 0.125;
+    }
+    return (success_count);
+}
+
+template <typename Transport>
+int MessageSender<Transport>::fanoutParallel(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count)
+{
+    TRACE_SCOPE("MessageSender::fanoutParallel");
+
+    /**
+     * @brief 청크 하나의 결과. 청크끼리 캐시 줄을 나누어 쓰지 않도록 정렬합니다.
+     */
+    struct alignas(64) ChunkResult
+    {
+        int successCount = 0;           ///< 대기열에 넣은 수.
+        int targetCount = 0;            ///< 제외 소켓을 뺀 대상 수.
+        int droppedCount = 0;           ///< 버린 채팅 메시지 수.
+        std::vector<int> missing;       ///< 아직 대기열이 없는 소켓의 배열 인덱스.
+    };
+
+    std::size_t chunk_count = ((std::size_t)socket_count + MessageSender::FANOUT_CHUNK_SIZE - 1) / MessageSender::FANOUT_CHUNK_SIZE;
+    std::vector<ChunkResult> results(chunk_count);
+
+    this->_fanoutPool->run((std::size_t)socket_count, MessageSender::FANOUT_CHUNK_SIZE, [&](std::size_t chunk_index, std::size_t begin, std::size_t end)
+    {
+        ChunkResult& result = results[chunk_index];
+
+        // 청크 전용 참조 카운트 블록을 가리키는 별칭 포인터입니다. 같은 메시지를 가리키지만 카운트는 청크 안에서만 오갑니다.
+        std::shared_ptr<const std::shared_ptr<const std::string>> owner = std::make_shared<const std::shared_ptr<const std::string>>(formatted_message);
+        std::shared_ptr<const std::string> chunk_message(owner, formatted_message.get());
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (sockets[i] == except_socket)
+            {
+                continue;
+            }
+            result.targetCount = result.targetCount + 1;
+            if (sockets[i] == INVALID_SOCKET)
+            {
+                continue;
+            }
+
+            // find()는 동시에 호출해도 되는 조회이며, 소켓마다 대기열이 달라 넣기도 서로 겹치지 않습니다.
+            auto it = this->_queues.find(sockets[i]);
+            if (it == this->_queues.end())
+            {
+                result.missing.push_back((int)i);
+                continue;
+            }
+            result.droppedCount = result.droppedCount + MessageSender::pushToLane(it->second, chunk_message, lane);
+            result.successCount = result.successCount + 1;
+        }
+    });
+
+    int success_count = 0;
+    int dropped_count = 0;
+    target_count = 0;
+    for (const ChunkResult& result : results)
+    {
+        success_count = success_count + result.successCount;
+        target_count = target_count + result.targetCount;
+        dropped_count = dropped_count + result.droppedCount;
+
+        // 새 대기열은 소켓 표를 고치므로 합류 뒤 루프 스레드에서 만듭니다.
+        for (int index : result.missing)
+        {
+            if (this->enqueue(formatted_message, sockets[index], lane))
+            {
+                success_count = success_count + 1;
+            }
+        }
+    }
+
+    if (dropped_count > 0)
+    {
+        this->_droppedChatCount = this->_droppedChatCount + dropped_count;
+        LOG_WARN("채팅 대기열 초과로 메시지를 버렸습니다 - 병렬 팬아웃, 개수: " + std::to_string(dropped_count));
+    }
+    return (success_count);
+}
+
+template <typename Transport>
+void MessageSender<Transport>::updateFanoutThreshold(int target_count, double parallel_ns)
+{
+    // 같은 수를 루프에서 처리했을 때의 예상 시간과 비교합니다.
+    double inline_ns = target_count * this->_inlineTargetNs;
+
+    if (parallel_ns >= inline_ns)
+    {
+        // 병렬이 손해였으므로 이 크기의 두 배부터 병렬로 처리합니다.
+        int raised = (target_count > MessageSender::MAX_FANOUT_THRESHOLD / 2) ? MessageSender::MAX_FANOUT_THRESHOLD : target_count * 2;
+        this->_fanoutThreshold = (raised > this->_fanoutThreshold) ? raised : this->_fanoutThreshold;
+    }
+    else if (target_count < this->_fanoutThreshold)
+    {
+        // 임계값보다 작은 방에서 이득이었으면 그 크기까지 바로 내립니다.
+        this->_fanoutThreshold = target_count;
+    }
+    else
+    {
+        // 임계값 이상에서 이득이었으면 조금씩 내려 더 작은 방도 시험합니다.
+        int lowered = this->_fanoutThreshold - this->_fanoutThreshold / 8;
+        this->_fanoutThreshold = (lowered < MessageSender::MIN_FANOUT_THRESHOLD) ? MessageSender::MIN_FANOUT_THRESHOLD : lowered;
+    }
+}
+
+template <typename Transport>
+bool MessageSender<Transport>::enqueueState(const std::string& key, const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket)
+{
+    if (target_socket == INVALID_SOCKET)
+    {
+        return (false);
+    }
+
+    MessageSender::OutboundQueue& queue = this->_queues[target_socket];
+
+    // 아직 보내지 않은 이전 값은 의미가 없으므로 제자리에서 덮어씁니다. 전송 순서는 처음 대기한 순서를 유지합니다.
+    auto it = queue.states.find(key);
+    if (it != queue.states.end())
+    {
+        it->second = formatted_message;
+        this->_coalescedStateCount = this->_coalescedStateCount + 1;
+        return (true);
+    }
+
+    queue.states.emplace(key, formatted_message);
+    queue.stateOrder.push_back(key);
+    return (true);
+}
+
+template <typename Transport>
+bool MessageSender<Transport>::flushQueue(SOCKET target_socket, MessageSender::OutboundQueue& queue, std::size_t chat_budget)
+{
+    int control_index = (int)MessageSender::Lane::CONTROL;
+    MessageSender::SendResult send_result = MessageSender::SendResult::COMPLETE;
+
+    // 지난번에 채팅 줄을 보내다 멈췄으면 그 줄부터 마저 보냅니다. 끝나기 전에 제어 바이트를 보내면 줄 중간에 끼어듭니다.
+    // 예산 1바이트는 맨 앞 메시지 하나를 끝까지 보낸 뒤 멈춥니다.
+    if (queue.frontOffsets[(int)MessageSender::Lane::CHAT] > 0)
+    {
+        send_result = this->sendLane(target_socket, queue, MessageSender::Lane::CHAT, 1);
+    }
+
+    // 제어 레인은 예산 없이 모두 보냅니다.
+    if (send_result == MessageSender::SendResult::COMPLETE)
+    {
+        send_result = this->sendLane(target_socket, queue, MessageSender::Lane::CONTROL, SIZE_MAX);
+    }
+
+    // 상태 메시지는 키마다 최신 값 하나뿐이므로 예산 없이 모두 보냅니다.
+    // 제어 레인이 비었을 때만 제어 레인 뒤로 옮기므로, 그 전까지는 상태 슬롯에서 계속 덮어쓸 수 있습니다.
+    if (send_result == MessageSender::SendResult::COMPLETE && queue.stateOrder.empty() == false)
+    {
+        for (const std::string& key : queue.stateOrder)
+        {
+            std::shared_ptr<const std::string>& message = queue.states[key];
+            queue.laneBytes[control_index] = queue.laneBytes[control_index] + message->length();
+            queue.lanes[control_index].push_back(std::move(message));
+        }
+        queue.states.clear();
+        queue.stateOrder.clear();
+        send_result = this->sendLane(target_socket, queue, MessageSender::Lane::CONTROL, SIZE_MAX);
+    }
+
+    // 채팅 레인은 예산만큼만 보냅니다.
+    if (send_result == MessageSender::SendResult::COMPLETE)
+    {
+        send_result = this->sendLane(target_socket, queue, MessageSender::Lane::CHAT, chat_budget);
+    }
+
+    // 연결에 문제가 있으므로 남은 메시지는 비웁니다. (소켓 정리는 수신 측에서 감지합니다.)
+    if (send_result == MessageSender::SendResult::FAIL)
+    {
+        for (int i = 0; i < MessageSender::LANE_COUNT; ++i)
+        {
+            queue.lanes[i].clear();
+            queue.laneBytes[i] = 0;
+            queue.frontOffsets[i] = 0;
+        }
+        queue.states.clear();
+        queue.stateOrder.clear();
+        return (false);
+    }
+
+    return (true);
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(MessageSender);
@@ -12,33 +12,58 @@
  * <br>한 클라이언트를 제외한 모두에게 보내는 멀티캐스트,
  * <br>특정 클라이언트에게만 보내는 유니캐스트 기능을 제공합니다.
  * <br>메시지 포맷팅과 전송 결과 추적을 위한 유틸리티들을 포함합니다.
+ * <br>메시지는 소켓별 송신 대기열의 우선순위 레인(제어/채팅)에 쌓였다가 flush()에서 전송됩니다.
+ * <br>다음 값이 나오면 의미가 없어지는 상태 갱신은 키별 최신 값만 남기는 상태 슬롯에 덮어씁니다.
+ * <br>병렬 팬아웃을 켜면 수신자가 많은 브로드캐스트의 대기열 넣기를 FanoutPool 스레드들이 나누어 처리합니다.
  */
 
-#include <WinSock2.h>
+#include "NetworkTransport.h"
+#include "FanoutPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
- * @class MessageSender
- * @brief 서버에서 클라이언트 소켓으로 메시지를 보내는 기능을 제공하는 클래스입니다.
+ * @class MessageSenderBase
+ * @brief 레인, 결과 값, 대기열 한도처럼 전송 계층과 무관한 MessageSender의 선언을 담습니다.
  *
- * @details
- * 이 클래스는 서버 메시지의 다양한 전달 모드를 구현합니다.
- * - Broadcast : 모든 연결된 클라이언트에게 메시지 전송.
- * - Multicast : 특정 클라이언트를 제외한 다수에게 메시지 전송.
- * - Unicast : 한 클라이언트에게만 메세지 전송.
- * 
- * 내부적으로 개행 문자(NEW_LINE 상수)를 메시지 끝에 추가하여 포맷팅합니다.
- * <br>전송 작업 결과를 나타내는 Result 열거형을 사용합니다.
+ * @note 바깥 코드는 레인과 결과를 MessageSenderBase::Lane, MessageSenderBase::Result로 씁니다.
  */
-class MessageSender
+class MessageSenderBase
 {
 	public:
 		/// 메시지 끝에 붙일 개행 구분자 (소스 파일에서 정의됨).
 		static const char* NEW_LINE;
 
+		/// 우선순위 레인 수.
+		static const int LANE_COUNT = 2;
+
+		/// flush 한 번에 소켓 하나로 보내는 채팅 레인 최대 바이트 수.
+		static const std::size_t CHAT_FLUSH_BYTES = 16 * 1024;
+
+		/// 소켓 하나의 채팅 레인에 쌓아 둘 수 있는 최대 바이트 수 (넘으면 오래된 채팅부터 버림).
+		static const std::size_t MAX_CHAT_QUEUE_BYTES = 256 * 1024;
+
+		/// 병렬 팬아웃 청크 하나의 수신자 수.
+		static const int FANOUT_CHUNK_SIZE = 512;
+
+		/// 측정값이 모이기 전의 팬아웃 임계값 (대상 수).
+		static const int DEFAULT_FANOUT_THRESHOLD = 4096;
+
+		/// 팬아웃 임계값의 하한과 상한.
+		static const int MIN_FANOUT_THRESHOLD = 1024;
+		static const int MAX_FANOUT_THRESHOLD = 1 << 20;
+
+		/// 임계값보다 작은 큰 방(MIN_FANOUT_THRESHOLD 이상)을 이 횟수에 한 번 병렬로 처리해 임계값을 다시 확인합니다.
+		static const int FANOUT_PROBE_INTERVAL = 64;
+
 	public:
 		/**
-		 * @enum MessageSender::Result
+		 * @enum MessageSenderBase::Result
 		 * @brief 메시지 전송 작업의 결과 상태 값.
 		 */
 		enum class Result
@@ -49,14 +74,66 @@ class MessageSender
 			TOTAL_FAIL,		///< 메시지를 어떤 대상에게도 보내지 못함.
 		};
 
+		/**
+		 * @enum MessageSenderBase::Lane
+		 * @brief 송신 대기열의 우선순위 레인. 값이 작을수록 먼저 전송됩니다.
+		 */
+		enum class Lane
+		{
+			CONTROL = 0,	///< 시스템/제어 메시지 (버리지 않음).
+			CHAT = 1		///< 채팅 메시지 (느린 클라이언트에게는 버려질 수 있음).
+		};
+};
+
+/**
+ * @class MessageSender
+ * @brief 서버에서 클라이언트 소켓으로 메시지를 보내는 기능을 제공하는 클래스입니다.
+ *
+ * @details
+ * 이 클래스는 서버 메시지의 다양한 전달 모드를 구현합니다.
+ * - Broadcast : 모든 연결된 클라이언트에게 메시지 전송.
+ * - Multicast : 특정 클라이언트를 제외한 다수에게 메시지 전송.
+ * - Unicast : 한 클라이언트에게만 메세지 전송.
+ * 
+ * 내부적으로 개행 문자(NEW_LINE 상수)를 메시지 끝에 추가하여 포맷팅합니다.
+ * <br>전송 작업 결과를 나타내는 Result 열거형을 사용합니다.
+ *
+ * 송신 대기열은 소켓마다 두 개의 레인으로 나뉩니다.
+ * - CONTROL : 환영/퇴장/작별 인사, 접속자 목록 프레임 등 시스템 메시지. flush 때 항상 먼저 모두 보내며 버리지 않습니다.
+ * - CHAT : 채팅 메시지. flush 한 번에 CHAT_FLUSH_BYTES까지만 보내고, MAX_CHAT_QUEUE_BYTES를 넘으면 가장 오래된 것부터 버립니다.
+ *
+ * 따라서 채팅이 밀린 느린 클라이언트도 시스템 메시지는 다음 flush에서 바로 받습니다.
+ *
+ * 클라이언트 소켓은 논블로킹이므로 flush는 기다리지 않습니다.
+ * <br>send가 일부만 보내면 남은 부분은 레인 맨 앞에 보낸 위치와 함께 남고, WSAEWOULDBLOCK이면 그 소켓은 다음 flush로 넘깁니다.
+ * <br>느린 클라이언트 하나가 다른 클라이언트의 전송을 막지 않고, 밀린 채팅은 위의 버리기 정책으로 정리됩니다.
+ * <br>이미 일부를 보낸 맨 앞 메시지는 버리지 않으므로 클라이언트가 받는 줄이 중간에 잘리지 않습니다.
+ * <br>한 소켓에서 보내다 멈춘 메시지는 언제나 하나뿐입니다. 채팅 줄을 보내다 멈췄으면 다음 flush는 그 줄을 끝낸 뒤에 제어 레인을 보냅니다.
+ *
+ * 상태 메시지(publishState)는 레인과 별도로 소켓마다 키별 최신 값 하나만 보관합니다.
+ * <br>flush 전에 같은 키로 새 값이 오면 대기 중인 값을 그 자리에서 덮어쓰므로,
+ * <br>갱신이 몰려도 전송량은 (키 수 × flush 횟수)를 넘지 않습니다. 제어 레인 다음, 채팅 레인 전에 전송됩니다.
+ *
+ * 병렬 팬아웃(enableParallelFanout)을 켜면 대상 수가 팬아웃 임계값 이상인 broadcast/multicast는
+ * <br>FANOUT_CHUNK_SIZE명 단위 청크로 나뉘어 FanoutPool에서 처리됩니다. 임계값보다 작은 방은 지금처럼 루프 스레드에서 바로 처리합니다.
+ * <br>임계값은 병렬로 처리한 시간을 루프에서 잰 수신자당 비용으로 예상한 시간과 비교해 조정합니다.
+ * <br>병렬이 느렸으면 그 크기의 두 배로 올리고, 빨랐으면 내립니다. 임계값보다 작은 큰 방도 가끔 병렬로 처리해 다시 확인합니다.
+ * <br>수신자당 비용을 재기 전에는 병렬로 처리하지 않습니다.
+ *
+ * @tparam Transport : send 호출에 사용할 전송 계층 타입.
+ */
+template <typename Transport>
+class MessageSender : public MessageSenderBase
+{
 	public:
 		/**
-		 * @fn MessageSender::MessageSender()
+		 * @fn MessageSender::MessageSender(Transport& transport)
 		 * @brief MessageSender 생성자.
+		 * @param[IN] Transport& transport : send 호출에 사용할 전송 계층.
 		 * @return 없음.
 		 * @note 이 생성자에서는 특별한 초기화가 일어나지 않습니다.
 		 */
-		MessageSender();
+		explicit MessageSender(Transport& transport);
 
 		/**
 		 * @fn MessageSender::~MessageSender()
@@ -77,42 +154,244 @@ class MessageSender
 	public:
 		
 		/**
-		 * @fn MessageSender::Result MessageSender::broadcast(const std::string& message, SOCKET* sockets, int socket_count)
+		 * @fn MessageSender::Result MessageSender::broadcast(const std::string& message, SOCKET* sockets, int socket_count, MessageSender::Lane lane)
 		 * @brief 모든 클라이언트에게 메시지를 전송합니다.
 		 * @param[IN] const std::string& message : 보낼 메시지 텍스트.
 		 * @param[IN] SOCKET* sockets : 메시지를 보낼 클라이언트 소켓들의 배열.
 		 * @param[IN] int socket_count : 배열에 포함된 소켓 개수 (전송할 클라이언트 수).
+		 * @param[IN] MessageSender::Lane lane : 메시지를 넣을 레인 (기본값 CONTROL).
 		 * @return MessageSender::Result : 전송 작업 결과 상태 값 (SUCCESS, PARTIAL_FAIL 또는 TOTAL_FAIL).
 		 *
 		 * @details
 		 * 주어진 메시지를 배열에 있는 모든 클라이언트 소켓에 전송합니다.
 		 * <br>하나 이상의 전송에 실패하면 결과 코드가 부분 실패 또는 전체 실패로 표시됩니다.
+		 * <br>포맷된 메시지는 한 번만 만들어 모든 대기열이 공유합니다.
 		 */
-		MessageSender::Result broadcast(const std::string& message, SOCKET* sockets, int socket_count);
+		MessageSender::Result broadcast(const std::string& message, SOCKET* sockets, int socket_count, MessageSender::Lane lane = MessageSender::Lane::CONTROL);
 
 		/**
-		 * @fn MessageSender::Result MessageSender::multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket)
+		 * @fn MessageSender::Result MessageSender::multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane)
 		 * @brief 특정 클라이언트를 제외한 모든 클라이언트에게 메시지를 보냅니다.
 		 * @param[IN] const std::string& message : 보낼 메시지 텍스트.
 		 * @param[IN] SOCKET* sockets : 메시지를 보낼 클라이언트 소켓들의 배열.
 		 * @param[IN] int socket_count : 배열에 포함된 소켓 개수 (전송할 클라이언트 수).
 		 * @param[IN] SOCKET except_socket : 메시지를 보내지 않을 클라이언트의 소켓.
+		 * @param[IN] MessageSender::Lane lane : 메시지를 넣을 레인 (기본값 CONTROL).
 		 * @return MessageSender::Result : 전송 작업 결과 상태 값 (SUCCESS, PARTIAL_FAIL 또는 TOTAL_FAIL).
 		 *
 		 * @details
 		 * 소켓 리스트에서 `except_socket`으로 지정된 소켓을 제외한 모든 소켓에 메시지를 전송합니다.
 		 * <br>한 클라이언트를 제외한 다른 클라이언트에게 메시지를 전달할 때 사용합니다. 
 		 */
-		MessageSender::Result multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket);
+		MessageSender::Result multicast(const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane = MessageSender::Lane::CONTROL);
 		
 		/**
-		 * @fn bool MessageSender::unicast(const std::string& message, SOCKET target_socket)
+		 * @fn bool MessageSender::unicast(const std::string& message, SOCKET target_socket, MessageSender::Lane lane)
 		 * @brief 하나의 클라이언트 소켓에만 메시지를 전송합니다.
 		 * @param[IN] const std::string& message : 보낼 메시지 텍스트.
 		 * @param[IN] SOCKET target_socket : 메시지를 보낼 대상 클라이언트의 소켓.
-		 * @return : bool 메시지 전송에 성공하면 true, 실패하면 false.
+		 * @param[IN] MessageSender::Lane lane : 메시지를 넣을 레인 (기본값 CONTROL).
+		 * @return : bool 메시지를 대기열에 넣었으면 true, 소켓이 유효하지 않으면 false.
+		 */
+		bool unicast(const std::string& message, SOCKET target_socket, MessageSender::Lane lane = MessageSender::Lane::CONTROL);
+
+		/**
+		 * @fn bool MessageSender::sendFrame(const std::string& frame, SOCKET target_socket)
+		 * @brief 개행 문자를 붙이지 않고 바이너리 프레임을 그대로 전송합니다.
+		 * @param[IN] const std::string& frame : 보낼 프레임 바이트.
+		 * @param[IN] SOCKET target_socket : 프레임을 보낼 대상 클라이언트의 소켓.
+		 * @return bool : 프레임을 대기열에 넣었으면 true, 소켓이 유효하지 않으면 false.
+		 * @note 접속자 목록 스냅샷/델타(PresenceTracker)처럼 미리 인코딩된 프레임을 보낼 때 사용합니다. 항상 CONTROL 레인에 들어갑니다.
+		 */
+		bool sendFrame(const std::string& frame, SOCKET target_socket);
+
+		/**
+		 * @fn MessageSender::Result MessageSender::publishState(const std::string& key, const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket)
+		 * @brief 키로 구분되는 상태 메시지를 보냅니다. 아직 보내지 않은 같은 키의 값은 새 값으로 덮어씁니다.
+		 * @param[IN] const std::string& key : 상태 키 (예: "status:3"). 같은 키의 이전 값은 더 이상 의미가 없어야 합니다.
+		 * @param[IN] const std::string& message : 보낼 메시지 텍스트.
+		 * @param[IN] SOCKET* sockets : 메시지를 보낼 클라이언트 소켓들의 배열.
+		 * @param[IN] int socket_count : 배열에 포함된 소켓 개수.
+		 * @param[IN] SOCKET except_socket : 메시지를 보내지 않을 클라이언트의 소켓 (기본값 INVALID_SOCKET : 제외 없음).
+		 * @return MessageSender::Result : 전송 작업 결과 상태 값 (SUCCESS, PARTIAL_FAIL 또는 TOTAL_FAIL).
+		 *
+		 * @details
+		 * 수신자마다 키별로 가장 최근 값 하나만 남으며, 처음 대기한 키의 순서대로 전송됩니다.
+		 * <br>덮어쓴 값은 전송되지 않고 getCoalescedStateCount()에 집계됩니다.
+		 */
+		MessageSender::Result publishState(const std::string& key, const std::string& message, SOCKET* sockets, int socket_count, SOCKET except_socket = INVALID_SOCKET);
+
+		/**
+		 * @fn void MessageSender::flush()
+		 * @brief 모든 소켓의 송신 대기열을 레인 우선순위에 따라 전송합니다.
+		 * @return 없음.
+		 *
+		 * @details
+		 * 소켓마다 CONTROL 레인과 대기 중인 상태 메시지를 모두 보낸 뒤 CHAT 레인을 CHAT_FLUSH_BYTES까지 보냅니다.
+		 * <br>남은 채팅은 다음 flush로 넘어갑니다. 전송에 실패한 소켓의 대기열은 비웁니다.
+		 * <br>송신 버퍼가 가득 찬 소켓(WSAEWOULDBLOCK)은 기다리지 않고 남은 메시지를 그대로 둔 채 다음 소켓으로 넘어갑니다.
+		 */
+		void flush();
+
+		/**
+		 * @fn bool MessageSender::hasBacklog() const
+		 * @brief 마지막 flush() 뒤에 보내지 못한 메시지가 남은 소켓이 있는지 확인합니다.
+		 * @return bool : 남은 메시지가 있으면 true.
+		 * @note 서버 루프는 이 값이 true이면 select 대기 시간을 줄여 곧 다시 flush합니다.
+		 */
+		bool hasBacklog() const;
+
+		/**
+		 * @fn void MessageSender::release(SOCKET target_socket)
+		 * @brief 소켓을 닫기 전에 남은 제어 메시지를 보내고 대기열을 삭제합니다.
+		 * @param[IN] SOCKET target_socket : 곧 닫을 소켓.
+		 * @return 없음.
+		 * @note 남은 채팅과 상태 메시지는 버립니다. 닫힌 소켓 번호가 재사용되어도 이전 메시지가 섞이지 않도록 소켓을 닫기 전에 반드시 호출해야 합니다.
+		 * <br>송신 버퍼가 가득 차 있으면 제어 메시지도 보낼 수 있는 만큼만 보냅니다.
+		 */
+		void release(SOCKET target_socket);
+
+		/**
+		 * @fn void MessageSender::enableParallelFanout(int worker_count)
+		 * @brief 수신자가 많은 broadcast/multicast를 여러 스레드로 나누어 처리하는 병렬 팬아웃을 켭니다.
+		 * @param[IN] int worker_count : 루프 스레드 외에 더 쓸 작업자 스레드 수. 0 이하이면 병렬 팬아웃을 끕니다.
+		 * @return 없음.
+		 *
+		 * @details
+		 * 각 청크는 공유 메시지를 수신자의 송신 대기열에 넣기만 하고, 전송은 지금처럼 루프의 flush()가 합니다.
+		 * <br>청크마다 별도의 참조 카운트 블록을 두어, 스레드들이 공유 메시지 하나의 참조 카운트를 두고 캐시 줄을 다투지 않게 합니다.
+		 * @note 대상 소켓 배열에 같은 소켓이 두 번 들어 있으면 안 됩니다. (ClientManager의 소켓 목록은 중복이 없습니다.)
+		 */
+		void enableParallelFanout(int worker_count);
+
+		/**
+		 * @fn int MessageSender::getFanoutThreshold() const
+		 * @brief 지금의 팬아웃 임계값을 반환합니다. 대상 수가 이 값 이상이면 병렬로 처리합니다.
+		 * @return int : 임계값 (대상 수).
+		 */
+		int getFanoutThreshold() const;
+
+		/**
+		 * @fn void MessageSender::fixFanoutThreshold(int threshold)
+		 * @brief 팬아웃 임계값을 고정하고 자동 조정을 멈춥니다. enableParallelFanout() 뒤에 호출합니다.
+		 * @param[IN] int threshold : 병렬로 처리할 최소 대상 수 (MIN_FANOUT_THRESHOLD ~ MAX_FANOUT_THRESHOLD로 맞춥니다).
+		 * @return 없음.
+		 * @note 스레드 수별 병렬 팬아웃 비용을 잴 때 씁니다. enableParallelFanout()을 다시 호출하면 자동 조정으로 돌아갑니다.
+		 */
+		void fixFanoutThreshold(int threshold);
+
+		/**
+		 * @fn std::uint64_t MessageSender::getParallelFanoutCount() const
+		 * @brief 병렬로 처리한 broadcast/multicast의 누적 수를 반환합니다.
+		 * @return std::uint64_t : 병렬 팬아웃 횟수.
+		 */
+		std::uint64_t getParallelFanoutCount() const;
+
+		/**
+		 * @fn int MessageSender::getLaneDepth(SOCKET target_socket, MessageSender::Lane lane) const
+		 * @brief 소켓 하나의 레인에 대기 중인 메시지 수를 반환합니다.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @param[IN] MessageSender::Lane lane : 조회할 레인.
+		 * @return int : 대기 중인 메시지 수.
+		 */
+		int getLaneDepth(SOCKET target_socket, MessageSender::Lane lane) const;
+
+		/**
+		 * @fn int MessageSender::getTotalLaneDepth(MessageSender::Lane lane) const
+		 * @brief 모든 소켓의 레인에 대기 중인 메시지 수의 합을 반환합니다.
+		 * @param[IN] MessageSender::Lane lane : 조회할 레인.
+		 * @return int : 대기 중인 메시지 수의 합.
+		 */
+		int getTotalLaneDepth(MessageSender::Lane lane) const;
+
+		/**
+		 * @fn std::uint64_t MessageSender::getDroppedChatCount() const
+		 * @brief 느린 클라이언트 정책으로 버린 채팅 메시지의 누적 수를 반환합니다.
+		 * @return std::uint64_t : 버린 채팅 메시지 수.
+		 */
+		std::uint64_t getDroppedChatCount() const;
+
+		/**
+		 * @fn int MessageSender::getStateDepth(SOCKET target_socket) const
+		 * @brief 소켓 하나에 대기 중인 상태 메시지 수(키 수)를 반환합니다.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @return int : 대기 중인 상태 메시지 수.
+		 */
+		int getStateDepth(SOCKET target_socket) const;
+
+		/**
+		 * @fn int MessageSender::getTotalStateDepth() const
+		 * @brief 모든 소켓에 대기 중인 상태 메시지 수의 합을 반환합니다.
+		 * @return int : 대기 중인 상태 메시지 수의 합.
+		 */
+		int getTotalStateDepth() const;
+
+		/**
+		 * @fn std::uint64_t MessageSender::getCoalescedStateCount() const
+		 * @brief 전송 전에 새 값으로 덮어써 보내지 않은 상태 메시지의 누적 수를 반환합니다.
+		 * @return std::uint64_t : 덮어쓴 상태 메시지 수.
 		 */
-		bool unicast(const std::string& message, SOCKET target_socket);
+		std::uint64_t getCoalescedStateCount() const;
+
+	private:
+		/**
+		 * @enum MessageSender::SendResult
+		 * @brief 메시지 하나를 보내려고 한 결과.
+		 */
+		enum class SendResult
+		{
+			COMPLETE,		///< 남은 바이트를 모두 보냄.
+			WOULD_BLOCK,	///< 송신 버퍼가 가득 차 일부만 보냄 (보낸 위치는 갱신됨).
+			FAIL			///< 연결 오류.
+		};
+
+		/**
+		 * @struct MessageSender::OutboundQueue
+		 * @brief 소켓 하나의 레인별 송신 대기열.
+		 * @note 브로드캐스트 메시지는 shared_ptr로 공유되어 대기열마다 복사되지 않습니다.
+		 */
+		struct OutboundQueue
+		{
+			std::deque<std::shared_ptr<const std::string>> lanes[LANE_COUNT];	///< 레인별 대기 메시지.
+			std::size_t laneBytes[LANE_COUNT] = {};								///< 레인별 대기 바이트 수.
+			std::size_t frontOffsets[LANE_COUNT] = {};							///< 레인별 맨 앞 메시지에서 이미 보낸 바이트 수.
+			std::unordered_map<std::string, std::shared_ptr<const std::string>> states;	///< 상태 키별 최신 값.
+			std::vector<std::string> stateOrder;								///< 처음 대기한 순서대로의 상태 키.
+		};
+
+	private:
+		/// send 호출에 사용하는 전송 계층.
+		Transport& _transport;
+
+		/// 소켓별 송신 대기열.
+		std::unordered_map<SOCKET, MessageSender::OutboundQueue> _queues;
+
+		/// 버린 채팅 메시지의 누적 수.
+		std::uint64_t _droppedChatCount;
+
+		/// 덮어써 보내지 않은 상태 메시지의 누적 수.
+		std::uint64_t _coalescedStateCount;
+
+		/// 병렬 팬아웃 스레드 풀 (꺼져 있으면 nullptr).
+		std::unique_ptr<FanoutPool> _fanoutPool;
+
+		/// 대상 수가 이 값 이상이면 병렬로 처리합니다.
+		int _fanoutThreshold;
+
+		/// 임계값을 고정해 자동 조정하지 않는지 여부.
+		bool _fanoutThresholdFixed;
+
+		/// 루프 스레드에서 처리할 때의 수신자 한 명당 비용 이동 평균 (나노초, 아직 없으면 0).
+		double _inlineTargetNs;
+
+		/// 임계값보다 작은 큰 방의 팬아웃 횟수 (FANOUT_PROBE_INTERVAL번마다 병렬로 시험).
+		std::uint64_t _fanoutProbeCount;
+
+		/// 병렬로 처리한 팬아웃의 누적 수.
+		std::uint64_t _parallelFanoutCount;
+
+		/// 마지막 flush() 뒤에 메시지가 남은 소켓이 있는지 여부.
+		bool _hasBacklog;
 
 	private:
 		/**
@@ -125,13 +404,112 @@ class MessageSender
 		std::string formatMessage(const std::string& message) const;
 
 		/**
-		 * @fn bool MessageSender::sendMessage(const std::string& formatted_message, SOCKET target_socket)
-		 * @brief 이미 포맷된 메시지를 특정 클라이언트 소켓으로 전송합니다.
+		 * @fn MessageSender::SendResult MessageSender::sendMessage(const std::string& formatted_message, std::size_t& offset, SOCKET target_socket)
+		 * @brief 이미 포맷된 메시지의 남은 부분을 특정 클라이언트 소켓으로 전송합니다.
 		 * @param[IN] const std::string& formatted_mssage : 개행 문자까지 포함된 메시지 문자열.
+		 * @param[IN, OUT] std::size_t& offset : 이미 보낸 바이트 수. 보낸 만큼 늘어납니다.
 		 * @param[IN] SOCKET target_socket : 메시지를 보낼 대상 클라이언트 소켓.
-		 * @return bool : 메시지 전송에 성공하면 true, 실패하면 false.
+		 * @return MessageSender::SendResult : 모두 보냈으면 COMPLETE, 송신 버퍼가 가득 찼으면 WOULD_BLOCK, 오류면 FAIL.
 		 * 
-		 * @note broadcast, multicast, unicast 함수 내부에서 실제 전송을 담당하는 핵심 구현 함수입니다.
+		 * @note flushQueue 함수 내부에서 실제 전송을 담당하는 핵심 구현 함수입니다.
+		 * <br>send가 일부만 전송한 경우 WSAEWOULDBLOCK이 나올 때까지 남은 바이트를 이어서 보냅니다.
+		 */
+		MessageSender::SendResult sendMessage(const std::string& formatted_mssage, std::size_t& offset, SOCKET target_socket);
+
+		/**
+		 * @fn MessageSender::SendResult MessageSender::sendLane(SOCKET target_socket, MessageSender::OutboundQueue& queue, MessageSender::Lane lane, std::size_t budget)
+		 * @brief 레인 하나를 맨 앞부터 예산만큼 전송합니다. 다 보낸 메시지만 레인에서 뺍니다.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @param[IN, OUT] MessageSender::OutboundQueue& queue : 소켓의 대기열.
+		 * @param[IN] MessageSender::Lane lane : 보낼 레인.
+		 * @param[IN] std::size_t budget : 이번에 보낼 최대 바이트 수 (메시지 하나는 예산을 넘어도 끝까지 보냅니다).
+		 * @return MessageSender::SendResult : 레인을 비웠거나 예산을 다 썼으면 COMPLETE, 그 밖에는 마지막 전송 결과.
+		 */
+		MessageSender::SendResult sendLane(SOCKET target_socket, MessageSender::OutboundQueue& queue, MessageSender::Lane lane, std::size_t budget);
+
+		/**
+		 * @fn bool MessageSender::enqueue(const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket, MessageSender::Lane lane)
+		 * @brief 포맷된 메시지를 소켓의 레인 대기열 끝에 넣습니다.
+		 * @param[IN] const std::shared_ptr<const std::string>& formatted_message : 개행 문자까지 포함된 메시지.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @param[IN] MessageSender::Lane lane : 넣을 레인.
+		 * @return bool : 대기열에 넣었으면 true, 소켓이 유효하지 않으면 false.
+		 * @note CHAT 레인이 MAX_CHAT_QUEUE_BYTES를 넘으면 가장 오래된 채팅부터 버립니다. CONTROL 레인은 버리지 않습니다.
+		 */
+		bool enqueue(const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket, MessageSender::Lane lane);
+
+		/**
+		 * @fn static int MessageSender::pushToLane(MessageSender::OutboundQueue& queue, const std::shared_ptr<const std::string>& formatted_message, MessageSender::Lane lane)
+		 * @brief 대기열 하나의 레인 끝에 메시지를 넣고, CHAT 레인이 넘치면 오래된 채팅을 버립니다.
+		 * @param[IN, OUT] MessageSender::OutboundQueue& queue : 소켓의 대기열.
+		 * @param[IN] const std::shared_ptr<const std::string>& formatted_message : 개행 문자까지 포함된 메시지.
+		 * @param[IN] MessageSender::Lane lane : 넣을 레인.
+		 * @return int : 버린 채팅 메시지 수.
+		 * @note 멤버 상태와 로그를 건드리지 않으므로 병렬 팬아웃 작업자에서도 호출합니다.
+		 */
+		static int pushToLane(MessageSender::OutboundQueue& queue, const std::shared_ptr<const std::string>& formatted_message, MessageSender::Lane lane);
+
+		/**
+		 * @fn int MessageSender::fanout(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count)
+		 * @brief 포맷된 메시지를 제외 소켓을 뺀 모든 소켓의 레인에 넣습니다. 대상이 임계값 이상이고 병렬 팬아웃이 켜져 있으면 FanoutPool로 나누어 처리합니다.
+		 * @param[IN] const std::shared_ptr<const std::string>& formatted_message : 개행 문자까지 포함된 메시지.
+		 * @param[IN] SOCKET* sockets : 대상 소켓 배열.
+		 * @param[IN] int socket_count : 배열의 소켓 수.
+		 * @param[IN] SOCKET except_socket : 제외할 소켓 (없으면 INVALID_SOCKET).
+		 * @param[IN] MessageSender::Lane lane : 넣을 레인.
+		 * @param[OUT] int& target_count : 제외 소켓을 뺀 대상 수.
+		 * @return int : 대기열에 넣은 수.
+		 */
+		int fanout(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count);
+
+		/**
+		 * @fn int MessageSender::fanoutParallel(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count)
+		 * @brief fanout()의 병렬 처리 부분입니다.
+		 * @param[IN] const std::shared_ptr<const std::string>& formatted_message : 개행 문자까지 포함된 메시지.
+		 * @param[IN] SOCKET* sockets : 대상 소켓 배열.
+		 * @param[IN] int socket_count : 배열의 소켓 수.
+		 * @param[IN] SOCKET except_socket : 제외할 소켓 (없으면 INVALID_SOCKET).
+		 * @param[IN] MessageSender::Lane lane : 넣을 레인.
+		 * @param[OUT] int& target_count : 제외 소켓을 뺀 대상 수.
+		 * @return int : 대기열에 넣은 수.
+		 *
+		 * @details
+		 * 작업자는 이미 대기열이 있는 소켓만 찾아(읽기 전용 조회) 넣고, 대기열이 없는 소켓은 청크 결과에 모아 두었다가
+		 * <br>합류 뒤 루프 스레드가 만들어 넣습니다. 소켓 표를 고치는 일은 루프 스레드만 하므로 작업자끼리 잠글 필요가 없습니다.
+		 */
+		int fanoutParallel(const std::shared_ptr<const std::string>& formatted_message, SOCKET* sockets, int socket_count, SOCKET except_socket, MessageSender::Lane lane, int& target_count);
+
+		/**
+		 * @fn void MessageSender::updateFanoutThreshold(int target_count, double parallel_ns)
+		 * @brief 병렬로 처리한 시간을 루프에서 처리했을 때의 예상 시간과 비교해 팬아웃 임계값을 조정합니다.
+		 * @param[IN] int target_count : 병렬로 처리한 대상 수.
+		 * @param[IN] double parallel_ns : 걸린 시간 (나노초).
+		 * @return 없음.
+		 */
+		void updateFanoutThreshold(int target_count, double parallel_ns);
+
+		/**
+		 * @fn bool MessageSender::enqueueState(const std::string& key, const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket)
+		 * @brief 포맷된 상태 메시지를 소켓의 상태 슬롯에 넣습니다. 같은 키가 대기 중이면 그 자리를 덮어씁니다.
+		 * @param[IN] const std::string& key : 상태 키.
+		 * @param[IN] const std::shared_ptr<const std::string>& formatted_message : 개행 문자까지 포함된 메시지.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @return bool : 대기열에 넣었으면 true, 소켓이 유효하지 않으면 false.
+		 */
+		bool enqueueState(const std::string& key, const std::shared_ptr<const std::string>& formatted_message, SOCKET target_socket);
+
+		/**
+		 * @fn bool MessageSender::flushQueue(SOCKET target_socket, MessageSender::OutboundQueue& queue, std::size_t chat_budget)
+		 * @brief 소켓 하나의 대기열을 CONTROL 레인부터 전송합니다.
+		 * @param[IN] SOCKET target_socket : 대상 소켓.
+		 * @param[IN] MessageSender::OutboundQueue& queue : 소켓의 대기열.
+		 * @param[IN] std::size_t chat_budget : 이번에 보낼 CHAT 레인 최대 바이트 수.
+		 * @return bool : 전송 중 오류가 없으면 true, 실패하면 false (대기열은 비워집니다). 송신 버퍼가 가득 찬 것은 오류가 아닙니다.
+		 *
+		 * @details
+		 * 지난번에 CHAT 레인의 맨 앞 메시지를 보내다 멈췄으면 그 메시지를 먼저 끝까지 보냅니다. 끝내지 못하면 다른 레인은 보내지 않습니다.
+		 * <br>제어 레인을 다 보낸 뒤에야 대기 중인 상태 메시지를 제어 레인 뒤로 옮겨 보냅니다.
+		 * <br>그 전까지 상태 메시지는 상태 슬롯에 남아 있으므로 계속 최신 값으로 덮어쓸 수 있습니다.
 		 */
-		bool sendMessage(const std::string& formatted_mssage, SOCKET target_socket);
+		bool flushQueue(SOCKET target_socket, MessageSender::OutboundQueue& queue, std::size_t chat_budget);
 };
\ No newline at end of file
@@ -9,90 +9,282 @@
 
 #include "MultiServer.h"
 #include "DebugHelper.h"
+#include "TraceRecorder.h"
+#include "TransportInstances.h"
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <thread>
 
-MultiServer::MultiServer(int port)
-    : _port(port), _tcpSocket(), _clientManager(), _selectManager(), _messageSender(), _isRunning(false)
+template <typename Transport>
+MultiServer<Transport>::MultiServer(int port, Transport& transport, MultiServer::SessionMode session_mode)
+    : _port(port), _flightRecorder(), _recordingTransport(transport, _flightRecorder), _transport(_recordingTransport),
+      _tcpSocket(_recordingTransport), _clientManager(_recordingTransport), _selectManager(_recordingTransport),
+      _messageSender(_recordingTransport), _isRunning(false), _sessionMode(session_mode), _sessionScheduler(_recordingTransport),
+      _presenceTracker(ClientManagerBase::MAX_CLIENTS), _replayBuffer(), _resumeRegistry(ClientManagerBase::MAX_CLIENTS),
+      _spatialGrid(ClientManagerBase::MAX_CLIENTS, MultiServer::SAY_RADIUS), _lastOutboundMetricsTick(0),
+      _readCursor(0), _pendingReads(), _pendingReadCount(0), _busyPoll(false), _pinnedCore(-1), _idlePollCount(0),
+      _emptyPollTotal(0), _busyPollBlockTotal(0), _datagramEnabled(false),
+      _datagramChannel(_recordingTransport, ClientManagerBase::MAX_CLIENTS), _datagramRejectedCount(0),
+      _bridgeName(), _gameBridge(), _clusterPort(0), _clusterRelay(_recordingTransport), _roomDirectory(), _chatFilter(),
+      _chatFilterFile(), _ignoreTable(), _moderatorPassword(), _mutedRejectedCount(0), _loopClock(), _heavyHitters(),
+      _roomResults(), _roomResultsClosed(false), _roomWorkers(), _roomInFlightCount(0), _roomHeldResults(), _roomDeliveredSequences(), _lastRoomBalanceTick(0)
 {
     LOG_INFO("MultiServer 객체가 생성되었습니다.\n포트번호: " + std::to_string(port));
 }
 
-MultiServer::~MultiServer()
+template <typename Transport>
+MultiServer<Transport>::~MultiServer()
 {
     this->stop();
+
+    // 루프가 끝나 결과 큐를 더 비우지 않으므로, 가득 찬 결과 큐 앞에서 기다리는 작업자가 있으면 포기하게 한 뒤 멈춥니다.
+    this->_roomResultsClosed.store(true, std::memory_order_release);
+    this->_roomWorkers.reset();
     LOG_INFO("MultiServer 객체가 소멸되었습니다.");
 }
 
-MultiServer::Result MultiServer::startServer()
+template <typename Transport>
+MultiServerBase::Result MultiServer<Transport>::startServer()
 {
     LOG_INFO("멀티클라이언트 서버를 시작합니다");
 
     // TCP 소켓 생성
-    if (this->_tcpSocket.createTCPSocket() != TCPSocket::Result::SUCCESS)
+    if (this->_tcpSocket.createTCPSocket() != TCPSocketBase::Result::SUCCESS)
     {
         return (MultiServer::Result::FAIL_START);
     }
 
     // 포트에 바인딩
-    if (this->_tcpSocket.bindTCPSocket(_port) != TCPSocket::Result::SUCCESS)
+    if (this->_tcpSocket.bindTCPSocket(_port) != TCPSocketBase::Result::SUCCESS)
     {
         return (MultiServer::Result::FAIL_START);
     }
 
     // 리슨 시작
-    if (this->_tcpSocket.startListen() != TCPSocket::Result::SUCCESS)
+    if (this->_tcpSocket.startListen() != TCPSocketBase::Result::SUCCESS)
+    {
+        return (MultiServer::Result::FAIL_START);
+    }
+
+    // 일회성 이벤트용 UDP 채널 (같은 포트 번호)
+    if (this->_datagramEnabled && this->_datagramChannel.open(this->_port) != DatagramChannelBase::Result::SUCCESS)
     {
         return (MultiServer::Result::FAIL_START);
     }
 
+    // 같은 호스트의 게임 서버용 공유 메모리 브리지 (메시지가 오면 깨우기 소켓으로 select를 깨웁니다)
+    if (this->_bridgeName.empty() == false)
+    {
+        if (this->_gameBridge.open(this->_bridgeName, SharedMemoryBridge::Role::SERVER) != SharedMemoryBridge::Result::SUCCESS
+            || this->_gameBridge.startWakeSocket() != SharedMemoryBridge::Result::SUCCESS)
+        {
+            return (MultiServer::Result::FAIL_START);
+        }
+    }
+
+    // 다른 서버 노드와의 클러스터 링크
+    if (this->_clusterPort > 0)
+    {
+        if (this->_clusterRelay.open(this->_clusterPort) != ClusterRelayBase::Result::SUCCESS)
+        {
+            return (MultiServer::Result::FAIL_START);
+        }
+        this->_roomDirectory.setLocalNode(this->_clusterPort);
+        this->_roomDirectory.addRoom(MultiServer::LOBBY_ROOM_ID, this->_transport.now());
+    }
+
     this->_isRunning = true;
     LOG_INFO("멀티클라이언트 서버가 성공적으로 시작되었습니다");
 
     return (MultiServer::Result::SUCCESS);
 }
 
-MultiServer::Result MultiServer::runServerLoop()
+template <typename Transport>
+MultiServerBase::Result MultiServer<Transport>::runServerLoop()
 {
     LOG_INFO("서버 메인 루프를 시작합니다");
 
+    // 바쁜 폴링 모드에서는 루프 스레드를 지정한 코어에 고정해 캐시와 스케줄링 지연을 줄입니다.
+    if (this->_busyPoll && this->_pinnedCore >= 0)
+    {
+        if (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << this->_pinnedCore) == 0)
+        {
+            LOG_WARN("루프 스레드를 코어 " + std::to_string(this->_pinnedCore) + "에 고정하지 못했습니다.");
+        }
+    }
+
+    // 이 스레드의 로그는 이제 루프 시계가 캐시한 타임스탬프를 씁니다.
+    this->_loopClock.update(this->_transport.now());
+    this->_loopClock.attachLogger();
+
     while (this->_isRunning)
     {
+        TRACE_SCOPE("MultiServer::loopIteration");
+
+        // 직전 반복이 예산을 넘었다면 최근 루프 활동을 파일로 남깁니다.
+        this->_flightRecorder.beginIteration(this->_transport.now());
+
+        // 트레이스 덤프 요청(Ctrl+Break) 처리
+        TRACE_DUMP_IF_REQUESTED();
+
+        // 지난 반복에서 생긴 접속자 목록 변경 배포
+        this->publishPresence();
+
+        // 게임 서버가 공유 메모리로 보낸 메시지 배포
+        this->pollGameBridge();
+
+        // 채팅방 작업자가 돌려준 채팅 배포
+        if (this->_roomWorkers != nullptr)
+        {
+            this->drainRoomResults();
+            this->maintainRoomWorkers();
+        }
+
+        // 클러스터: 끊긴 노드에 다시 연결하고, 노드 구성이 바뀌었으면 채팅방 주인을 옮기고, 로컬 접속자 유무가 바뀌었으면 알립니다.
+        if (this->_clusterRelay.isOpen())
+        {
+            this->_clusterRelay.maintainLinks();
+            this->updateRoomOwnership();
+            this->_clusterRelay.setLocalMembers(this->_clientManager.getConnectedClientCount() > 0);
+        }
+
+        // 쌓인 송신 대기열을 제어 메시지부터 전송
+        this->flushOutbound();
+
+        // 지난 반복에서 쌓인 노드 간 프레임을 링크마다 한 번에 전송
+        this->_clusterRelay.flush();
+
         // SelectManager를 사용해 fd_set 설정
         this->_selectManager.setupFdSet();
 
         // 서버 소켓 추가
         this->_selectManager.addSocket(this->_tcpSocket.getSocket());
+        if (this->_datagramChannel.isOpen())
+        {
+            this->_selectManager.addSocket(this->_datagramChannel.getSocket());
+        }
+        if (this->_gameBridge.isOpen())
+        {
+            this->_selectManager.addSocket(this->_gameBridge.getWakeSocket());
+        }
+        if (this->_clusterRelay.isOpen())
+        {
+            SOCKET link_sockets[ClusterRelayBase::MAX_LINKS];
+            int link_count = this->_clusterRelay.getLinkSockets(link_sockets, ClusterRelayBase::MAX_LINKS);
+
+            this->_selectManager.addSocket(this->_clusterRelay.getListenSocket());
+            for (int i = 0; i < link_count; ++i)
+            {
+                this->_selectManager.addSocket(link_sockets[i]);
+            }
+
+            // 연결 중인 링크는 select가 연결이 끝났다고 알려 줄 때 마무리합니다.
+            SOCKET connecting_sockets[ClusterRelayBase::MAX_LINKS];
+            int connecting_count = this->_clusterRelay.getConnectingSockets(connecting_sockets, ClusterRelayBase::MAX_LINKS);
+            for (int i = 0; i < connecting_count; ++i)
+            {
+                this->_selectManager.addConnectingSocket(connecting_sockets[i]);
+            }
+        }
 
         // 모든 클라이언트 소켓 추가
-        SOCKET client_sockets[ClientManager::MAX_CLIENTS];
-        int socket_count = _clientManager.getAllSockets(client_sockets, ClientManager::MAX_CLIENTS);
+        int select_timeout_ms = 1000;
+        if (this->_sessionMode == MultiServer::SessionMode::COROUTINE)
+        {
+            // 수신 측이 닫힌 세션은 제외하고, 가장 가까운 sleepFor() 만료 시각까지만 대기합니다.
+            for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+            {
+                if (this->_sessionScheduler.wantsRead(i))
+                {
+                    this->_selectManager.addSocket(this->_clientManager.getClientSocket(i));
+                }
+            }
+            select_timeout_ms = this->_sessionScheduler.getNextTimeoutMs(this->_loopClock.now(), select_timeout_ms);
+        }
+        else
+        {
+            SOCKET client_sockets[ClientManagerBase::MAX_CLIENTS];
+            int socket_count = _clientManager.getAllSockets(client_sockets, ClientManagerBase::MAX_CLIENTS);
+
+            for (int i = 0; i < socket_count; ++i)
+            {
+                this->_selectManager.addSocket(client_sockets[i]);
+            }
+        }
+
+        // 지난 반복에서 예산을 다 써 데이터가 남은 소켓이 있거나 작업자에서 돌아올 채팅이 있으면 기다리지 않고 바로 처리합니다.
+        if (this->_pendingReadCount > 0 || this->_roomInFlightCount > 0)
+        {
+            select_timeout_ms = 0;
+        }
+        else if (this->_busyPoll)
+        {
+            select_timeout_ms = this->getBusyPollTimeoutMs(select_timeout_ms);
+        }
+
+        // 넘겨받기를 기다리는 채팅방이 있으면 마감 시각에 깨어나 이어받습니다.
+        if (this->_clusterRelay.isOpen())
+        {
+            select_timeout_ms = this->_roomDirectory.getNextTimeoutMs(this->_loopClock.now(), select_timeout_ms);
+        }
 
-        for (int i = 0; i < socket_count; ++i)
+        // 송신 버퍼가 가득 차 남은 메시지가 있으면 select는 쓰기 가능을 기다리지 않으므로 짧게 깨어나 다시 보냅니다.
+        if (this->_messageSender.hasBacklog() && select_timeout_ms > MultiServer::OUTPUT_RETRY_MS)
         {
-            this->_selectManager.addSocket(client_sockets[i]);
+            select_timeout_ms = MultiServer::OUTPUT_RETRY_MS;
         }
 
         // select 실행
-        SelectManager::Result select_result = this->_selectManager.executeSelect(1);
+        SelectManagerBase::Result select_result = this->_selectManager.executeSelectMillis(select_timeout_ms);
+
+        // 대기가 끝난 시각을 한 번 읽어 이번 반복의 타이머와 로그에 씁니다.
+        this->_loopClock.update(this->_transport.now());
+
+        // 바쁜 폴링: 이벤트가 오면 다시 회전 구간부터 시작합니다.
+        if (this->_busyPoll)
+        {
+            if (select_result == SelectManagerBase::Result::TIMEOUT)
+            {
+                this->_idlePollCount = this->_idlePollCount + 1;
+            }
+            else
+            {
+                this->_idlePollCount = 0;
+            }
+        }
+
+        // 만료된 세션 타이머 처리
+        if (this->_sessionMode == MultiServer::SessionMode::COROUTINE)
+        {
+            this->_sessionScheduler.processTimers(this->_loopClock.now());
+            this->reapFinishedSessions();
+            this->expireSuspendedSessions();
+        }
 
         // select 결과 처리
         switch (select_result)
         {
-            case SelectManager::Result::SUCCESS:
+            case SelectManagerBase::Result::SUCCESS:
                 // 활성 소켓 처리
                 break;
 
-            case SelectManager::Result::TIMEOUT:
-                // 타임아웃 - 다음 루프로 계속
-                continue;
+            case SelectManagerBase::Result::TIMEOUT:
+                // 타임아웃 - 이월된 소켓이 없으면 다음 루프로 계속
+                if (this->_pendingReadCount == 0)
+                {
+                    continue;
+                }
+                break;
 
-            case SelectManager::Result::FAIL_SELECT:
+            case SelectManagerBase::Result::FAIL_SELECT:
                 LOG_ERROR("select 실행 실패");
+                this->_loopClock.detachLogger();
                 return (MultiServer::Result::FAIL_LOOP);
 
-            case SelectManager::Result::NO_SOCKETS:
+            case SelectManagerBase::Result::NO_SOCKETS:
                 // 소켓이 없으면 잠시 대기
-                Sleep(100);
+                this->_transport.sleepMillis(100);
                 continue;
         }
 
@@ -105,27 +297,147 @@ MultiServer::Result MultiServer::runServerLoop()
             }
         }
 
+        // UDP 이벤트는 TCP 채팅보다 먼저 처리해 채팅량과 관계없이 지연이 짧게 유지되도록 합니다.
+        if (this->_datagramChannel.isOpen() && this->_selectManager.isSocketReady(this->_datagramChannel.getSocket()))
+        {
+            this->handleDatagrams();
+        }
+
+        // 다른 노드에서 온 채팅
+        if (this->_clusterRelay.isOpen())
+        {
+            this->handleClusterTraffic();
+        }
+
         // 각 클라이언트 소켓 확인
-        for (int i = 0; i < ClientManager::MAX_CLIENTS; ++i)
+        // 시작 위치를 매 반복 한 칸씩 옮겨 낮은 인덱스가 항상 먼저 처리되지 않게 합니다.
+        int start_index = this->_readCursor;
+        this->_readCursor = (this->_readCursor + 1) % ClientManagerBase::MAX_CLIENTS;
+        this->_pendingReadCount = 0;
+
+        for (int offset = 0; offset < ClientManagerBase::MAX_CLIENTS; ++offset)
         {
+            int i = (start_index + offset) % ClientManagerBase::MAX_CLIENTS;
             SOCKET client_socket = this->_clientManager.getClientSocket(i);
-            if (client_socket != INVALID_SOCKET && this->_selectManager.isSocketReady(client_socket))
+
+            // 이월 표시는 이번 반복에서 다시 판단합니다.
+            bool carried = this->_pendingReads[i];
+            this->_pendingReads[i] = false;
+
+            if (client_socket == INVALID_SOCKET)
             {
-                if (this->handleClientMessage(i) == false)
-                {
-                    // 클라이언트 연결 종료
-                    this->announceLeave(i);
-                    this->_clientManager.removeClient(i);
-                }
+                continue;
+            }
+
+            // 슬롯이 재사용되었을 수 있으므로 이월된 소켓은 실제로 데이터가 남았는지 확인합니다.
+            bool ready = this->_selectManager.isSocketReady(client_socket);
+            if (ready == false && carried)
+            {
+                ready = (this->_transport.getPendingBytes(client_socket) > 0);
+            }
+            if (ready == false)
+            {
+                continue;
+            }
+
+            if (this->drainReadable(i) == false)
+            {
+                // 클라이언트 연결 종료
+                this->announceLeave(i);
+                this->_presenceTracker.removeMember(i);
+                this->_spatialGrid.remove(i);
+                this->_resumeRegistry.forget(i);
+                this->_datagramChannel.unbindEndpoint(i);
+                this->_messageSender.release(client_socket);
+                this->_ignoreTable.clearSlot(i);
+                this->_clientManager.removeClient(i);
             }
         }
+
+        if (this->_sessionMode == MultiServer::SessionMode::COROUTINE)
+        {
+            this->reapFinishedSessions();
+        }
+    }
+
+    // 작업자에 넘긴 채팅을 모두 돌려받아 보낸 뒤 종료합니다. 이동 중인 채팅방은 울타리를 넣어야 끝납니다.
+    while (this->_roomInFlightCount > 0)
+    {
+        this->_roomWorkers->getProducer(0).sync();
+        this->drainRoomResults();
+        std::this_thread::yield();
+    }
+
+    // 종료 전에 남은 메시지 전송
+    this->flushOutbound();
+
+    // 이 노드가 주인인 채팅방을 다음 노드에 넘겨줍니다.
+    if (this->_clusterRelay.isOpen())
+    {
+        this->handOffRooms();
+    }
+
+    if (this->_datagramChannel.isOpen())
+    {
+        LOG_INFO("UDP 이벤트 통계 - 수신: " + std::to_string(this->_datagramChannel.getReceivedCount()) + "개, 송신: " + std::to_string(this->_datagramChannel.getSentCount())
+            + "개, 버림: " + std::to_string(this->_datagramChannel.getDroppedCount()) + "개, 인증 실패: " + std::to_string(this->_datagramRejectedCount) + "개");
+    }
+
+    if (this->_gameBridge.isOpen())
+    {
+        LOG_INFO("게임 서버 브리지 통계 - 수신: " + std::to_string(this->_gameBridge.getReceivedCount()) + "개, 송신: " + std::to_string(this->_gameBridge.getSentCount())
+            + "개, 버림: " + std::to_string(this->_gameBridge.getDroppedCount()) + "개");
+    }
+
+    if (this->_clusterRelay.isOpen())
+    {
+        LOG_INFO("클러스터 중계 통계 - 링크: " + std::to_string(this->_clusterRelay.getLinkCount()) + "개, 보냄: " + std::to_string(this->_clusterRelay.getRelayedCount())
+            + "개, 건너뜀: " + std::to_string(this->_clusterRelay.getSkippedCount()) + "개, 받음: " + std::to_string(this->_clusterRelay.getReceivedCount())
+            + "개, 묶음 전송: " + std::to_string(this->_clusterRelay.getBatchCount()) + "회");
+        LOG_INFO("채팅방 주인 통계 - 주인에게 넘김: " + std::to_string(this->_clusterRelay.getForwardedCount()) + "개, 주인 변경: " + std::to_string(this->_roomDirectory.getTransferCount())
+            + "회, 순번 건너뛴 이어받기: " + std::to_string(this->_roomDirectory.getTakeoverCount()) + "회, 최대 중단 시간: " + std::to_string(this->_roomDirectory.getMaxDisruptionMs()) + "ms");
+    }
+
+    if (this->_ignoreTable.getSuppressedCount() > 0 || this->_mutedRejectedCount > 0)
+    {
+        LOG_INFO("무시/채팅 금지 통계 - 무시로 건너뛴 전달: " + std::to_string(this->_ignoreTable.getSuppressedCount()) + "개, 금지로 버린 채팅: " + std::to_string(this->_mutedRejectedCount) + "개");
+    }
+
+    LOG_INFO("상위 송신자 집계 - 시간 창: " + std::to_string(this->_heavyHitters.getWindowMs() / 1000) + "초, 고정 메모리: " + std::to_string(this->_heavyHitters.getMemoryBytes()) + "바이트");
+
+    if (this->_chatFilter.getWordCount() > 0)
+    {
+        LOG_INFO("채팅 필터 통계 - 금칙어: " + std::to_string(this->_chatFilter.getWordCount()) + "개, 가린 메시지: " + std::to_string(this->_chatFilter.getMaskedCount()) + "개");
+    }
+
+    if (this->_messageSender.getParallelFanoutCount() > 0)
+    {
+        LOG_INFO("병렬 팬아웃 통계 - 병렬 처리: " + std::to_string(this->_messageSender.getParallelFanoutCount()) + "회, 마지막 임계값: " + std::to_string(this->_messageSender.getFanoutThreshold()) + "명");
+    }
+
+    if (this->_roomWorkers != nullptr)
+    {
+        std::uint64_t processed_count = 0;
+        for (const RoomWorkers::WorkerStats& stats : this->_roomWorkers->getStats())
+        {
+            processed_count = processed_count + stats.processedCount;
+        }
+        LOG_INFO("채팅방 작업자 통계 - 작업자: " + std::to_string(this->_roomWorkers->getWorkerCount()) + "개, 처리: " + std::to_string(processed_count)
+            + "개, 이동: " + std::to_string(this->_roomWorkers->getMigrationCount()) + "회, 최근 치우침: " + std::to_string(this->_roomWorkers->getSkew()));
+    }
+
+    if (this->_busyPoll)
+    {
+        LOG_INFO("바쁜 폴링 통계 - 빈 폴링: " + std::to_string(this->_emptyPollTotal) + "회, 블로킹 전환: " + std::to_string(this->_busyPollBlockTotal) + "회");
     }
 
     LOG_INFO("서버 메인 루프가 종료되었습니다");
+    this->_loopClock.detachLogger();
     return (MultiServer::Result::SUCCESS);
 }
 
-void MultiServer::stop()
+template <typename Transport>
+void MultiServer<Transport>::stop()
 {
     if (this->_isRunning)
     {
@@ -134,30 +446,164 @@ void MultiServer::stop()
     }
 }
 
-bool MultiServer::isRunning() const
+template <typename Transport>
+bool MultiServer<Transport>::isRunning() const
 {
     return (this->_isRunning);
 }
 
-bool MultiServer::handleNewConnection()
+template <typename Transport>
+void MultiServer<Transport>::setStallBudget(int budget_ms)
+{
+    this->_flightRecorder.setBudget(budget_ms);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableBusyPoll(int pinned_core)
+{
+    this->_busyPoll = true;
+    this->_pinnedCore = pinned_core;
+    this->_idlePollCount = 0;
+    LOG_INFO("바쁜 폴링 루프 모드를 사용합니다. 고정 코어: " + std::to_string(pinned_core));
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableParallelFanout(int worker_count)
+{
+    this->_messageSender.enableParallelFanout(worker_count);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableRoomWorkers(int worker_count)
+{
+    if (this->_roomWorkers != nullptr)
+    {
+        return ;
+    }
+
+    // 결과 큐는 작업자가 처음 쓰기 전에 모두 만들어 둡니다.
+    int count = (worker_count < 1) ? 1 : worker_count;
+    for (int i = 0; i < count; ++i)
+    {
+        this->_roomResults.push_back(std::make_unique<SpscQueue<MultiServer::RoomChat>>(RoomWorkers::QUEUE_CAPACITY));
+    }
+
+    // 생산자는 루프 스레드 하나입니다.
+    this->_roomWorkers = std::make_unique<RoomWorkers>(count, 1, [this](int worker_index, RoomWorkers::Room& room, std::uint64_t tag, std::string& line)
+    {
+        this->handleRoomChat(worker_index, room, tag, line);
+    });
+    LOG_INFO("채팅방 작업자 스레드를 사용합니다. 작업자: " + std::to_string(count) + "개");
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::migrateRoom(const std::string& room, int worker_index)
+{
+    if (this->_roomWorkers == nullptr)
+    {
+        return (false);
+    }
+    return (this->_roomWorkers->migrateRoom(room, worker_index));
+}
+
+template <typename Transport>
+std::vector<RoomWorkers::WorkerStats> MultiServer<Transport>::getRoomWorkerStats() const
+{
+    if (this->_roomWorkers == nullptr)
+    {
+        return (std::vector<RoomWorkers::WorkerStats>());
+    }
+    return (this->_roomWorkers->getStats());
+}
+
+template <typename Transport>
+double MultiServer<Transport>::getRoomWorkerSkew() const
+{
+    if (this->_roomWorkers == nullptr)
+    {
+        return (0.0);
+    }
+    return (this->_roomWorkers->getSkew());
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableDatagramChannel()
+{
+    this->_datagramEnabled = true;
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableGameBridge(const std::string& name)
+{
+    this->_bridgeName = name;
+}
+
+template <typename Transport>
+void MultiServer<Transport>::enableCluster(int cluster_port)
+{
+    this->_clusterPort = cluster_port;
+}
+
+template <typename Transport>
+void MultiServer<Transport>::addClusterPeer(const std::string& host, int cluster_port)
+{
+    this->_clusterRelay.addPeer(host, cluster_port);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::loadChatFilter(const std::string& file_path)
+{
+    return (this->_chatFilter.loadFile(file_path) == ChatFilter::Result::SUCCESS);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::setChatFilterFile(const std::string& file_path)
+{
+    this->_chatFilterFile = file_path;
+    return (this->loadChatFilter(file_path));
+}
+
+template <typename Transport>
+void MultiServer<Transport>::setModeratorPassword(const std::string& password)
 {
+    this->_moderatorPassword = password;
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::handleNewConnection()
+{
+    TRACE_SCOPE("MultiServer::handleNewConnection");
+
     // 새로운 클라이언트 연결 수락
-    SOCKET client_socket = this->_tcpSocket.acceptConnection();
+    sockaddr_in client_addr = {};
+    SOCKET client_socket = this->_tcpSocket.acceptConnection(&client_addr);
     if (client_socket == INVALID_SOCKET)
     {
         return (false);
     }
 
     // 클라이언트 추가
-    int client_index = this->_clientManager.addClient(client_socket);
+    int client_index = this->_clientManager.addClient(client_socket, client_addr);
     if (client_index == -1)
     {
         // 최대 클라이언트 수 초과
         std::string reject_message = "서버가 가득 찼습니다. 나중에 다시 시도해주세요.";
         this->_messageSender.unicast(reject_message, client_socket);
-        closesocket(client_socket);
+        this->_messageSender.release(client_socket);
+        this->_transport.closeSocket(client_socket);
         return (false);
     }
+    this->_clientManager.touchActivity(client_index, this->getNowTick());
+
+    if (this->_sessionMode == MultiServer::SessionMode::COROUTINE)
+    {
+        // 접속 절차부터 퇴장까지 세션 코루틴이 수행합니다.
+        SessionContext<RecordingTransport<Transport>>& context = this->_sessionScheduler.prepare(client_index, client_socket);
+        this->_sessionScheduler.spawn(client_index, this->runSession(client_index, context));
+
+        LOG_INFO("새로운 세션 코루틴 시작 - 인덱스: " + std::to_string(client_index));
+        return (true);
+    }
 
     // 환영 메시지 전송
     this->sendWelcomeMessage(client_index);
@@ -165,12 +611,82 @@ bool MultiServer::handleNewConnection()
     // 다른 클라이언트들에게 참여 알림
     this->announceJoin(client_index);
 
+    // 접속자 목록에 추가 (다음 틱에 스냅샷/델타로 배포)
+    this->_presenceTracker.addMember(client_index, this->_clientManager.getClientNickname(client_index));
+    this->_clientManager.setStateFlag(client_index, ClientManagerBase::FLAG_JOINED);
+
+    // 재접속을 지원하지 않는 모드에서도 데이터그램 인증에 쓸 세션 토큰은 발급합니다.
+    if (this->_datagramChannel.isOpen())
+    {
+        this->announceDatagramChannel(client_index, this->_resumeRegistry.issue(client_index));
+    }
+
     LOG_INFO("새로운 클라이언트 연결 완료 - 인덱스: " + std::to_string(client_index));
     return (true);
 }
 
-bool MultiServer::handleClientMessage(int client_index)
+template <typename Transport>
+int MultiServer<Transport>::getBusyPollTimeoutMs(int blocking_timeout_ms)
+{
+    // 회전 구간: 양보 없이 바로 다시 폴링합니다.
+    if (this->_idlePollCount < MultiServer::BUSY_POLL_SPIN_COUNT)
+    {
+        this->_emptyPollTotal = this->_emptyPollTotal + 1;
+        return (0);
+    }
+
+    // 양보 구간: 같은 코어의 다른 스레드에 한 번씩 양보하며 폴링합니다.
+    if (this->_idlePollCount < MultiServer::BUSY_POLL_SPIN_COUNT + MultiServer::BUSY_POLL_YIELD_COUNT)
+    {
+        this->_emptyPollTotal = this->_emptyPollTotal + 1;
+        this->_transport.sleepMillis(0);
+        return (0);
+    }
+
+    // 한동안 조용했으므로 CPU를 쓰지 않도록 블로킹합니다.
+    this->_busyPollBlockTotal = this->_busyPollBlockTotal + 1;
+    return (blocking_timeout_ms);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::drainReadable(int client_index)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    for (int read_count = 0; read_count < MultiServer::READ_BUDGET_PER_CLIENT; ++read_count)
+    {
+        if (this->_sessionMode == MultiServer::SessionMode::COROUTINE)
+        {
+            // 수신 데이터를 세션 코루틴에 전달합니다.
+            this->_sessionScheduler.onReadable(client_index);
+            if (this->_sessionScheduler.wantsRead(client_index) == false)
+            {
+                return (true);
+            }
+        }
+        else if (this->handleClientMessage(client_index) == false)
+        {
+            return (false);
+        }
+
+        // 더 읽을 데이터가 없으면 다음 소켓으로 넘어갑니다. (빈 소켓에 recv를 부르지 않도록 남은 바이트를 먼저 확인합니다.)
+        if (this->_transport.getPendingBytes(client_socket) <= 0)
+        {
+            return (true);
+        }
+    }
+
+    // 예산을 다 쓰고도 데이터가 남았으면 다음 반복으로 이월합니다.
+    this->_pendingReads[client_index] = true;
+    this->_pendingReadCount = this->_pendingReadCount + 1;
+    return (true);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::handleClientMessage(int client_index)
 {
+    TRACE_SCOPE("MultiServer::handleClientMessage");
+
     SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
     if (client_socket == INVALID_SOCKET)
     {
@@ -178,42 +694,34 @@ bool MultiServer::handleClientMessage(int client_index)
     }
 
     // MessageReceiver로 메시지 수신
-    MessageReceiver receiver(client_socket);
-    MessageReceiver::Result recv_result = receiver.receiveMessage();
+    MessageReceiver receiver(this->_transport, client_socket, this->_clientManager.getPendingInput(client_index));
+    MessageReceiverBase::Result recv_result = receiver.receiveMessage();
 
     switch (recv_result)
     {
-    case MessageReceiver::Result::SUCCESS:
+    case MessageReceiverBase::Result::SUCCESS:
+    case MessageReceiverBase::Result::CLIENT_QUIT:
     {
-        std::string message = receiver.getLastMessage();
+        this->_clientManager.touchActivity(client_index, this->getNowTick());
 
-        // quit 명령 확인
-        if (receiver.isQuitCommand(message))
+        // 한 번에 받은 여러 줄을 순서대로 처리합니다.
+        for (const std::string& message : receiver.getLines())
         {
-            std::string goodbye_message = "[시스템] 안녕히 가세요!";
-            this->_messageSender.unicast(goodbye_message, client_socket);
-            return (false); // 연결 종료
+            if (this->handleClientLine(client_index, client_socket, message) == false)
+            {
+                return (false);
+            }
         }
 
-        // 클라이언트 닉네임.
-        std::string nickname = this->_clientManager.getClientNickname(client_index);
-        // 브로드캐스트 메시지 생성.
-        std::string broadcast_message = "[" + nickname + "]: " + message;
-
-
-        // 모든 클라이언트에게 브로드캐스트.
-        SOCKET all_sockets[ClientManager::MAX_CLIENTS];
-        int socket_count = this->_clientManager.getAllSockets(all_sockets, ClientManager::MAX_CLIENTS);
-        this->_messageSender.broadcast(broadcast_message, all_sockets, socket_count);
-
-        return (true);
+        // quit 앞의 줄까지 처리한 뒤 연결을 종료합니다.
+        return (recv_result == MessageReceiverBase::Result::SUCCESS);
     }
 
-    case MessageReceiver::Result::CLIENT_DISCONNECTED:
+    case MessageReceiverBase::Result::CLIENT_DISCONNECTED:
         LOG_INFO("클라이언트 연결 해제 - 인덱스: " + std::to_string(client_index));
         return (false);
 
-    case MessageReceiver::Result::FAIL_RECEIVE:
+    case MessageReceiverBase::Result::FAIL_RECEIVE:
         LOG_ERROR("클라이언트 메시지 수신 실패 - 인덱스: " + std::to_string(client_index));
         return (false);
 
@@ -222,36 +730,122 @@ bool MultiServer::handleClientMessage(int client_index)
     }
 }
 
-void MultiServer::sendWelcomeMessage(int client_index)
+template <typename Transport>
+bool MultiServer<Transport>::handleClientLine(int client_index, SOCKET client_socket, const std::string& message)
 {
-    // 환영 메세지를 보낼 클라이언트 소켓을 가져옵니다.
-    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+    this->recordTalker(client_index, message.size());
 
-    // 소켓에 문제가 있다면.
-    if (client_socket == INVALID_SOCKET) 
+    std::string_view arguments;
+    CommandParser::Command command = CommandParser::parse(message, arguments);
+
+    // quit 명령 확인
+    if (command == CommandParser::Command::QUIT)
     {
-        return ;
+        std::string goodbye_message = "[시스템] 안녕히 가세요!";
+        this->_messageSender.unicast(goodbye_message, client_socket);
+        return (false); // 연결 종료
     }
 
-    // 해당 클라이언트의 닉네임을 가져옵니다.
-    std::string nickname = this->_clientManager.getClientNickname(client_socket);
-    // 현재 접속 중인 유저의 수를 반환합니다.
-    int connectedClientCount = this->_clientManager.getConnectedClientCount();
-    // 환영 메세지를 생성합니다.
-    std::string welcome_message = makeWecomeMessage(nickname, connectedClientCount);
+    // 접속자 목록, 위치, 근접 채팅, 상태 명령 확인
+    if (this->handleCommand(client_index, command, arguments))
+    {
+        return (true);
+    }
 
-    // 클라이언트에게 메세지를 전송합니다.
-    this->_messageSender.unicast(welcome_message, client_socket);
+    // 순번을 붙여 모든 클라이언트에게 브로드캐스트.
+    this->relayChatMessage(client_index, message);
+
+    return (true);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::handleCommand(int client_index, CommandParser::Command command, std::string_view arguments)
+{
+    switch (command)
+    {
+    case CommandParser::Command::USERS:
+        this->sendUserList(client_index);
+        return (true);
+
+    case CommandParser::Command::POS:
+        this->handlePositionCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::SAY:
+        this->handleSayCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::STATUS:
+        this->handleStatusCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::IGNORE_USER:
+        this->handleIgnoreCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::MUTE_USER:
+        this->handleMuteCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::MODERATOR:
+        this->handleModeratorCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::TOP:
+        this->handleTopCommand(client_index, arguments);
+        return (true);
+
+    case CommandParser::Command::ROSTER:
+        this->handleRosterCommand(client_index);
+        return (true);
+
+    case CommandParser::Command::RELOAD:
+        this->handleReloadCommand(client_index);
+        return (true);
+
+    case CommandParser::Command::RESUME:
+        // 접속 중의 /resume은 토큰이 드러나지 않도록 방송하지 않고 본인에게만 거절합니다.
+        this->_messageSender.unicast("[시스템] /resume은 접속 직후 첫 줄로만 보낼 수 있습니다.", this->_clientManager.getClientSocket(client_index));
+        return (true);
+
+    default:
+        return (false);
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::sendWelcomeMessage(int client_index)
+{
+    // 환영 메세지를 보낼 클라이언트 소켓을 가져옵니다.
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    // 소켓에 문제가 있다면.
+    if (client_socket == INVALID_SOCKET) 
+    {
+        return ;
+    }
+
+    // 해당 클라이언트의 닉네임을 가져옵니다.
+    std::string nickname = this->_clientManager.getClientNickname(client_socket);
+    // 입장을 마친 유저 수에 환영 메시지를 받는 본인을 더합니다. (재접속 대기 중인 연결은 세지 않습니다.)
+    int connectedClientCount = this->_clientManager.getJoinedClientCount() + 1;
+    // 환영 메세지를 생성합니다.
+    std::string welcome_message = makeWecomeMessage(nickname, connectedClientCount);
+
+    // 클라이언트에게 메세지를 전송합니다.
+    this->_messageSender.unicast(welcome_message, client_socket);
 }
 
-void MultiServer::announceJoin(int client_index)
+template <typename Transport>
+void MultiServer<Transport>::announceJoin(int client_index)
 {
     std::string nickname = this->_clientManager.getClientNickname(client_index);
     // 클라이언트가 채팅방을 참여했다는 메세지 생성.
     std::string join_message = "[시스템] " + nickname + "님이 채팅방에 참여했습니다.";
 
-    SOCKET all_sockets[ClientManager::MAX_CLIENTS];
-    int socket_count = this->_clientManager.getAllSockets(all_sockets, ClientManager::MAX_CLIENTS);
+    // 입장 절차를 마친 클라이언트에게만 알립니다.
+    SOCKET all_sockets[ClientManagerBase::MAX_CLIENTS];
+    int socket_count = this->_clientManager.getJoinedSockets(all_sockets, ClientManagerBase::MAX_CLIENTS);
 
     // 현재 채팅창에 들어온 클라이언트 소켓.
     SOCKET new_client_socket = this->_clientManager.getClientSocket(client_index);
@@ -260,27 +854,1197 @@ void MultiServer::announceJoin(int client_index)
     this->_messageSender.multicast(join_message, all_sockets, socket_count, new_client_socket);
 }
 
-void MultiServer::announceLeave(int client_index)
+template <typename Transport>
+void MultiServer<Transport>::announceLeave(int client_index)
 {
     std::string nickname = this->_clientManager.getClientNickname(client_index);
     // 클라이언트가 채팅방을 떠났다는 메세지 생성.
     std::string leave_message = "[시스템] " + nickname + "님이 채팅방을 떠났습니다.";
 
-    SOCKET all_sockets[ClientManager::MAX_CLIENTS];
-    // 현재 채팅서버에 접속된 모든 클라이언트의 수.
-    int socket_count = this->_clientManager.getAllSockets(all_sockets, ClientManager::MAX_CLIENTS);
+    SOCKET all_sockets[ClientManagerBase::MAX_CLIENTS];
+    // 입장 절차를 마친 클라이언트의 수.
+    int socket_count = this->_clientManager.getJoinedSockets(all_sockets, ClientManagerBase::MAX_CLIENTS);
 
     // 떠나는 클라이언트를 포함한 모든 클라이언트에게 메세지 전송.
     this->_messageSender.broadcast(leave_message, all_sockets, socket_count);
 }
 
-std::string MultiServer::makeWecomeMessage(const std::string& nickname, int connectedClientCount)
+template <typename Transport>
+std::string MultiServer<Transport>::makeWecomeMessage(const std::string& nickname, int connectedClientCount)
 {
     std::string welcome_message = "";
     welcome_message = welcome_message + "=== 채팅 서버에 오신 것을 환영합니다! ===\n";
     welcome_message = welcome_message + "현재 접속자 수: " + std::to_string(connectedClientCount) + "명\n";
     welcome_message = welcome_message + "'quit'를 입력하면 종료됩니다.\n";
+    welcome_message = welcome_message + "'/users'를 입력하면 접속자 목록을 볼 수 있습니다.\n";
+    welcome_message = welcome_message + "'/say 메시지'를 입력하면 주변 플레이어에게만 말합니다.\n";
+    welcome_message = welcome_message + "'/status 상태'를 입력하면 상태 메시지를 바꿉니다.\n";
+    welcome_message = welcome_message + "'/ignore 닉네임'을 입력하면 그 플레이어의 채팅을 받지 않습니다. (다시 입력하면 풀립니다)\n";
+    welcome_message = welcome_message + "'/roster'를 입력하면 접속자 목록 변경을 바이너리 프레임으로 받습니다. (다시 입력하면 끕니다)\n";
     welcome_message = welcome_message + "==========================================\n";
 
     return (welcome_message);
 }
+
+template <typename Transport>
+std::int64_t MultiServer<Transport>::getNowTick() const
+{
+    return (this->_loopClock.getTick());
+}
+
+template <typename Transport>
+void MultiServer<Transport>::flushOutbound()
+{
+    TRACE_SCOPE("MultiServer::flushOutbound");
+
+    this->_messageSender.flush();
+
+    // 클라이언트별 남은 메시지 수를 큐 깊이로 기록합니다.
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        SOCKET client_socket = this->_clientManager.getClientSocket(i);
+        if (client_socket == INVALID_SOCKET)
+        {
+            continue;
+        }
+
+        std::int32_t depth = this->_messageSender.getLaneDepth(client_socket, MessageSenderBase::Lane::CONTROL)
+            + this->_messageSender.getLaneDepth(client_socket, MessageSenderBase::Lane::CHAT)
+            + this->_messageSender.getStateDepth(client_socket);
+        this->_clientManager.addQueueDepth(i, depth - this->_clientManager.getQueueDepth(i));
+    }
+
+    std::int64_t now_tick = this->getNowTick();
+    if (now_tick - this->_lastOutboundMetricsTick < MultiServer::OUTBOUND_METRICS_INTERVAL_MS)
+    {
+        return ;
+    }
+    this->_lastOutboundMetricsTick = now_tick;
+
+    LOG_INFO("송신 대기열 - 제어: " + std::to_string(this->_messageSender.getTotalLaneDepth(MessageSenderBase::Lane::CONTROL))
+        + "개, 채팅: " + std::to_string(this->_messageSender.getTotalLaneDepth(MessageSenderBase::Lane::CHAT))
+        + "개, 상태: " + std::to_string(this->_messageSender.getTotalStateDepth())
+        + "개, 버린 채팅: " + std::to_string(this->_messageSender.getDroppedChatCount())
+        + "개, 덮어쓴 상태: " + std::to_string(this->_messageSender.getCoalescedStateCount()) + "개");
+}
+
+template <typename Transport>
+void MultiServer<Transport>::sendUserList(int client_index)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+    this->_messageSender.unicast(this->_presenceTracker.makeUserList(), client_socket);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::publishPresence()
+{
+    TRACE_SCOPE("MultiServer::publishPresence");
+
+    // 이번 틱의 변경을 하나의 델타로 합칩니다.
+    bool has_delta = this->_presenceTracker.flush();
+
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        // 텍스트만 읽는 클라이언트에게는 프레임을 보내지 않습니다.
+        if (this->_presenceTracker.isMember(i) == false || this->_clientManager.hasStateFlag(i, ClientManagerBase::FLAG_PRESENCE) == false)
+        {
+            continue;
+        }
+
+        // 일시 중단된 접속자는 재접속할 때 스냅샷을 다시 받습니다.
+        SOCKET client_socket = this->_clientManager.getClientSocket(i);
+        if (client_socket == INVALID_SOCKET)
+        {
+            continue;
+        }
+
+        if (this->_presenceTracker.isSynced(i))
+        {
+            // 기존 접속자에게는 델타만 보냅니다.
+            if (has_delta)
+            {
+                this->_messageSender.sendFrame(this->_presenceTracker.getDeltaFrame(), client_socket);
+            }
+            continue;
+        }
+
+        // 새 접속자에게는 현재 버전의 스냅샷을 한 번 보냅니다 (버전당 한 번만 인코딩됨).
+        if (this->_messageSender.sendFrame(this->_presenceTracker.getSnapshotFrame(), client_socket))
+        {
+            this->_presenceTracker.markSynced(i);
+        }
+    }
+}
+
+template <typename Transport>
+Task<> MultiServer<Transport>::runSession(int client_index, SessionContext<RecordingTransport<Transport>>& context)
+{
+    // 재접속하는 클라이언트는 연결 직후 첫 줄로 "/resume <토큰> <순번>"을 보냅니다.
+    std::string message;
+    SessionContextBase::Result first_result = co_await context.readLineFor(message, std::chrono::milliseconds(MultiServer::RESUME_WAIT_MS));
+    if (first_result != SessionContextBase::Result::SUCCESS && first_result != SessionContextBase::Result::TIMEOUT)
+    {
+        // 접속 절차 전에 끊긴 연결은 알림 없이 종료합니다.
+        co_return;
+    }
+
+    if (first_result == SessionContextBase::Result::SUCCESS)
+    {
+        std::string_view arguments;
+        if (CommandParser::parse(message, arguments) == CommandParser::Command::RESUME)
+        {
+            // 이어 붙이기에 성공하면 연결은 이전 슬롯의 새 세션 코루틴이 넘겨받습니다.
+            if (this->resumeSession(client_index, arguments, context))
+            {
+                co_return;
+            }
+            std::string reject_message = "[시스템] 재접속 정보가 유효하지 않아 새로 접속합니다.";
+            this->_messageSender.unicast(reject_message, this->_clientManager.getClientSocket(client_index));
+        }
+        else
+        {
+            // 일반 메시지는 접속 절차 뒤에 다시 읽습니다.
+            context.unreadInput(message + "\n");
+        }
+    }
+
+    this->completeJoin(client_index);
+    co_await this->chatSession(client_index, context);
+}
+
+template <typename Transport>
+Task<> MultiServer<Transport>::chatSession(int client_index, SessionContext<RecordingTransport<Transport>>& context)
+{
+    std::string message;
+    while (true)
+    {
+        SessionContextBase::Result read_result = co_await context.readLine(message);
+        if (read_result == SessionContextBase::Result::CLIENT_DISCONNECTED)
+        {
+            // 재접속할 수 있도록 퇴장 알림 없이 일시 중단합니다.
+            LOG_INFO("클라이언트 연결 해제 - 인덱스: " + std::to_string(client_index));
+            this->suspendSession(client_index);
+            co_return;
+        }
+        if (read_result != SessionContextBase::Result::SUCCESS)
+        {
+            LOG_ERROR("클라이언트 메시지 수신 실패 - 인덱스: " + std::to_string(client_index));
+            this->suspendSession(client_index);
+            co_return;
+        }
+
+        this->_clientManager.touchActivity(client_index, this->getNowTick());
+
+        // 빈 줄은 전달하지 않습니다.
+        if (message.empty())
+        {
+            continue;
+        }
+
+        LOG_INFO("수신: " + CommandParser::redactSecrets(message));
+        this->recordTalker(client_index, message.size());
+
+        std::string_view arguments;
+        CommandParser::Command command = CommandParser::parse(message, arguments);
+
+        // quit 명령 확인
+        if (command == CommandParser::Command::QUIT)
+        {
+            // 작별 인사는 제어 레인으로 보내 밀린 채팅보다 먼저 도착하게 합니다.
+            std::string goodbye_message = "[시스템] 안녕히 가세요!";
+            this->_messageSender.unicast(goodbye_message, this->_clientManager.getClientSocket(client_index));
+            break;
+        }
+
+        // 접속자 목록, 위치, 근접 채팅, 상태 명령 확인
+        if (this->handleCommand(client_index, command, arguments))
+        {
+            continue;
+        }
+
+        // 순번을 붙여 모든 클라이언트에게 브로드캐스트.
+        this->relayChatMessage(client_index, message);
+    }
+
+    this->_resumeRegistry.forget(client_index);
+    this->announceLeave(client_index);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::completeJoin(int client_index)
+{
+    // 환영 메시지 전송
+    this->sendWelcomeMessage(client_index);
+
+    // 다른 클라이언트들에게 참여 알림
+    this->announceJoin(client_index);
+
+    // 접속자 목록에 추가 (다음 틱에 스냅샷/델타로 배포)
+    this->_presenceTracker.addMember(client_index, this->_clientManager.getClientNickname(client_index));
+    this->_clientManager.setStateFlag(client_index, ClientManagerBase::FLAG_JOINED);
+
+    // 재접속에 사용할 토큰 발급
+    this->issueResumeToken(client_index);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::reapFinishedSessions()
+{
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        if (this->_sessionScheduler.isFinished(i))
+        {
+            this->_sessionScheduler.release(i);
+
+            // 일시 중단된 세션은 재접속이나 유예 시간 만료까지 슬롯을 유지합니다.
+            if (this->_resumeRegistry.isSuspended(i))
+            {
+                continue;
+            }
+
+            // 재접속으로 소켓이 이전 슬롯에 옮겨진 경우 이미 빈 슬롯입니다.
+            if (this->_clientManager.getClientSocket(i) == INVALID_SOCKET)
+            {
+                continue;
+            }
+            this->_presenceTracker.removeMember(i);
+            this->_spatialGrid.remove(i);
+            this->_datagramChannel.unbindEndpoint(i);
+            this->_messageSender.release(this->_clientManager.getClientSocket(i));
+            this->_ignoreTable.clearSlot(i);
+            this->_clientManager.removeClient(i);
+        }
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::relayChatMessage(int client_index, const std::string& message)
+{
+    // 금지된 사람의 채팅은 줄을 만들고 가리기 전에 버립니다.
+    if (this->rejectMutedSender(client_index))
+    {
+        return ;
+    }
+
+    std::string line = "[" + this->_clientManager.getClientNickname(client_index) + "]: ";
+    std::size_t message_offset = line.size();
+    line.append(message);
+
+    // 채팅방 작업자가 가리고 순번을 올려 돌려주면 drainRoomResults()가 이어서 보냅니다.
+    if (this->_roomWorkers != nullptr)
+    {
+        std::uint64_t tag = MultiServer::makeRoomTag(client_index, this->_clientManager.getClientSocket(client_index), message_offset);
+        RoomWorkers::Producer& producer = this->_roomWorkers->getProducer(0);
+
+        // 큐가 가득 차면 돌아온 결과를 보내며 자리가 날 때까지 기다립니다. 버리거나 루프에서 처리하면 순서가 바뀝니다.
+        while (producer.submit(MultiServer::LOBBY_ROOM_ID, line, tag) == false)
+        {
+            this->drainRoomResults();
+            std::this_thread::yield();
+        }
+        this->_roomInFlightCount = this->_roomInFlightCount + 1;
+        return ;
+    }
+
+    // 중계 전에 한 번만 가립니다. 다른 노드와 게임 서버, 재전송 버퍼 모두 가려진 줄을 받습니다.
+    this->_chatFilter.apply(line, message_offset);
+
+    if (this->_clusterRelay.isOpen())
+    {
+        // 순번은 채팅방 주인이 매기므로, 로컬 접속자도 주인을 거쳐 돌아온 순번으로 받습니다.
+        this->publishChatLine(MultiServer::LOBBY_ROOM_ID, line, 0, client_index);
+        return ;
+    }
+
+    // 재접속한 클라이언트가 놓친 메시지를 받을 수 있도록 순번과 함께 보관합니다.
+    std::uint64_t sequence = this->_replayBuffer.append(line, this->_loopClock.getWallSeconds());
+    this->deliverChatLine(sequence, line, client_index);
+}
+
+template <typename Transport>
+std::uint64_t MultiServer<Transport>::makeRoomTag(int client_index, SOCKET client_socket, std::size_t message_offset)
+{
+    static_assert(ClientManagerBase::MAX_CLIENTS <= 0x10000, "채팅방 작업자 값의 슬롯 자리는 16비트입니다.");
+
+    // 닉네임 길이는 제한되어 있지만, 넘치면 필터가 머리말까지 검사할 뿐 메시지를 건너뛰지는 않도록 줄입니다.
+    std::uint64_t offset = (message_offset > 0xFFFF) ? 0 : message_offset;
+    return (((std::uint64_t)(std::uint32_t)client_socket << 32) | (offset << 16) | (std::uint64_t)client_index);
+}
+
+template <typename Transport>
+int MultiServer<Transport>::resolveRoomSender(std::uint64_t tag) const
+{
+    int client_index = (int)(tag & 0xFFFF);
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+    if (client_socket == INVALID_SOCKET || (std::uint32_t)client_socket != (std::uint32_t)(tag >> 32))
+    {
+        return (-1);
+    }
+    return (client_index);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleRoomChat(int worker_index, RoomWorkers::Room& room, std::uint64_t tag, std::string& line)
+{
+    this->_chatFilter.apply(line, (std::size_t)((tag >> 16) & 0xFFFF));
+
+    MultiServer::RoomChat result;
+    result.room = room.id;
+    result.sequence = room.sequence;
+    result.tag = tag;
+    result.line = std::move(line);
+
+    // 결과 큐는 이 작업자만 채우고 루프만 비웁니다.
+    SpscQueue<MultiServer::RoomChat>& results = *this->_roomResults[worker_index];
+    while (results.tryPush(std::move(result)) == false)
+    {
+        if (this->_roomResultsClosed.load(std::memory_order_acquire))
+        {
+            return ;
+        }
+        std::this_thread::yield();
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::drainRoomResults()
+{
+    std::size_t held_count = this->_roomHeldResults.size();
+    MultiServer::RoomChat result;
+    for (std::unique_ptr<SpscQueue<MultiServer::RoomChat>>& results : this->_roomResults)
+    {
+        while (results->tryPop(result))
+        {
+            this->_roomHeldResults.push_back(std::move(result));
+        }
+    }
+    if (this->_roomHeldResults.size() == held_count)
+    {
+        return ;
+    }
+
+    // 작업자 순서로 비웠으므로 채팅방 순번으로 정렬합니다. 다른 채팅방끼리의 순서는 보장하지 않습니다.
+    std::sort(this->_roomHeldResults.begin(), this->_roomHeldResults.end(), [](const MultiServer::RoomChat& left, const MultiServer::RoomChat& right)
+    {
+        return ((left.room != right.room) ? (left.room < right.room) : (left.sequence < right.sequence));
+    });
+
+    std::size_t kept_count = 0;
+    for (std::size_t i = 0; i < this->_roomHeldResults.size(); ++i)
+    {
+        MultiServer::RoomChat& chat = this->_roomHeldResults[i];
+        std::uint64_t& delivered_sequence = this->_roomDeliveredSequences[chat.room];
+
+        // 앞 순번이 아직 다른 작업자의 큐에 있으면 다음 반복까지 보류합니다.
+        if (chat.sequence != delivered_sequence + 1)
+        {
+            if (kept_count != i)
+            {
+                this->_roomHeldResults[kept_count] = std::move(chat);
+            }
+            kept_count = kept_count + 1;
+            continue;
+        }
+        delivered_sequence = chat.sequence;
+        this->_roomInFlightCount = this->_roomInFlightCount - 1;
+
+        int sender_index = this->resolveRoomSender(chat.tag);
+        if (this->_clusterRelay.isOpen())
+        {
+            this->publishChatLine(chat.room, chat.line, 0, sender_index);
+            continue;
+        }
+        std::uint64_t sequence = this->_replayBuffer.append(chat.line, this->_loopClock.getWallSeconds());
+        this->deliverChatLine(sequence, chat.line, sender_index);
+    }
+    this->_roomHeldResults.resize(kept_count);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::maintainRoomWorkers()
+{
+    // 한가한 동안에도 이동이 끝나도록 울타리를 넣습니다.
+    this->_roomWorkers->getProducer(0).sync();
+
+    std::int64_t now_tick = this->_loopClock.getTick();
+    if (now_tick - this->_lastRoomBalanceTick < MultiServer::ROOM_BALANCE_INTERVAL_MS)
+    {
+        return ;
+    }
+    this->_lastRoomBalanceTick = now_tick;
+
+    // 채팅방 하나가 작업자 하나를 채우는 경우처럼 옮겨도 나아지지 않으면 migrateHottestRoom()이 거절합니다.
+    double skew = this->_roomWorkers->getSkew();
+    if (skew >= MultiServer::ROOM_SKEW_THRESHOLD && this->_roomWorkers->migrateHottestRoom())
+    {
+        LOG_INFO("채팅방 작업자 부하가 치우쳐 가장 바쁜 채팅방을 옮깁니다. 치우침: " + std::to_string(skew));
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::publishChatLine(const std::string& room, const std::string& line, int hops, int sender_index)
+{
+    std::uint64_t sequence = 0;
+    RoomDirectory::Result assign_result = this->_roomDirectory.assignSequence(room, sequence);
+
+    if (assign_result == RoomDirectory::Result::SUCCESS)
+    {
+        this->_replayBuffer.appendAt(sequence, line, this->_loopClock.getWallSeconds());
+        this->deliverChatLine(sequence, line, sender_index);
+        this->_clusterRelay.broadcastSequenced(room, sequence, line);
+        return ;
+    }
+
+    if (assign_result == RoomDirectory::Result::AWAITING_HANDOFF)
+    {
+        if (this->_roomDirectory.queuePublish(room, line) != RoomDirectory::Result::SUCCESS)
+        {
+            LOG_WARN("채팅방 넘겨받기 대기열이 가득 차 채팅을 버립니다: " + room);
+        }
+        return ;
+    }
+
+    if (assign_result == RoomDirectory::Result::NOT_OWNER)
+    {
+        int owner = this->_roomDirectory.getOwner(room);
+        if (hops >= MultiServer::MAX_FORWARD_HOPS)
+        {
+            LOG_WARN("채팅방 주인을 찾지 못해 채팅을 버립니다: " + room + ", 주인으로 보이는 노드: " + std::to_string(owner));
+            return ;
+        }
+
+        // 로컬 채팅은 주인이 바뀐 직후 이전 주인을 거쳐 보내 순서를 지킵니다. 전달받은 채팅은 전달 횟수가 남지 않으므로 주인에게 바로 보냅니다.
+        int target = (hops == 0) ? this->_roomDirectory.getRouteNode(room, this->_loopClock.now()) : owner;
+        if (this->_clusterRelay.publishTo(target, room, hops + 1, line) == false)
+        {
+            LOG_WARN("채팅방 주인 노드와의 링크가 없어 채팅을 버립니다: " + std::to_string(target));
+        }
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::updateRoomOwnership()
+{
+    std::vector<int> live_nodes;
+    std::vector<RoomDirectory::Transfer> transfers;
+    this->_clusterRelay.getLiveNodes(live_nodes);
+    this->_roomDirectory.updateNodes(live_nodes, this->_loopClock.now(), transfers);
+
+    // 이 노드가 주인이던 채팅방은 마지막 순번을 새 주인에게 넘겨줍니다. 같은 링크로 보낸 SEQUENCED 뒤에 도착합니다.
+    for (const RoomDirectory::Transfer& transfer : transfers)
+    {
+        if (transfer.fromNode == this->_roomDirectory.getLocalNode())
+        {
+            this->_clusterRelay.sendHandoff(transfer.toNode, transfer.room, this->_roomDirectory.getLastSequence(transfer.room));
+        }
+    }
+
+    // 넘겨받기가 끝났거나 주인이 다른 노드로 바뀐 채팅방에 쌓여 있던 채팅을 처리합니다.
+    std::vector<std::string> pending_lines;
+    if (this->_roomDirectory.takePending(MultiServer::LOBBY_ROOM_ID, pending_lines))
+    {
+        for (const std::string& line : pending_lines)
+        {
+            this->publishChatLine(MultiServer::LOBBY_ROOM_ID, line, 0, -1);
+        }
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handOffRooms()
+{
+    std::vector<std::string> owned_rooms;
+    this->_roomDirectory.getOwnedRooms(owned_rooms);
+
+    for (const std::string& room : owned_rooms)
+    {
+        int successor = this->_roomDirectory.getSuccessor(room);
+        if (successor == HashRing::NO_NODE)
+        {
+            continue;
+        }
+
+        // 넘겨받기를 기다리던 채팅은 새 주인에게 보내고 나서 HANDOFF를 보냅니다.
+        std::vector<std::string> pending_lines;
+        this->_roomDirectory.takePending(room, pending_lines);
+        for (const std::string& line : pending_lines)
+        {
+            this->_clusterRelay.publishTo(successor, room, 1, line);
+        }
+        this->_clusterRelay.sendHandoff(successor, room, this->_roomDirectory.getLastSequence(room));
+        LOG_INFO("종료 전에 채팅방을 넘겨줍니다: " + room + " -> " + std::to_string(successor));
+    }
+    this->_clusterRelay.flush();
+}
+
+template <typename Transport>
+void MultiServer<Transport>::deliverChatLine(std::uint64_t sequence, const std::string& line, int sender_index)
+{
+    // 입장한 슬롯 집합에서 보낸 사람을 무시하는 슬롯을 단어 단위로 빼고, 남은 비트만 순회합니다.
+    ClientManagerBase::SessionMask recipients = this->_clientManager.getJoinedMask();
+    this->_ignoreTable.excludeIgnoring(sender_index, recipients);
+
+    SOCKET recipient_sockets[ClientManagerBase::MAX_CLIENTS];
+    int socket_count = this->_clientManager.getMaskedSockets(recipients, recipient_sockets, ClientManagerBase::MAX_CLIENTS);
+    std::string sequenced_message = this->makeSequencedMessage(sequence, line);
+    this->_messageSender.broadcast(sequenced_message, recipient_sockets, socket_count, MessageSenderBase::Lane::CHAT);
+
+    if (this->_gameBridge.isOpen())
+    {
+        this->_gameBridge.send(sequenced_message);
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handlePositionCommand(int client_index, std::string_view arguments)
+{
+    // "/pos <x> <y> <z>" : 격자 위치만 갱신합니다.
+    CommandParser::Tokenizer tokenizer(arguments);
+    float coordinates[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        std::string_view token;
+        std::from_chars_result parse_result = {};
+        if (tokenizer.next(token))
+        {
+            parse_result = std::from_chars(token.data(), token.data() + token.size(), coordinates[i]);
+        }
+        if (token.empty() || parse_result.ec != std::errc() || parse_result.ptr != token.data() + token.size())
+        {
+            std::string usage_message = "[시스템] 사용법: /pos <x> <y> <z>";
+            this->_messageSender.unicast(usage_message, this->_clientManager.getClientSocket(client_index));
+            return ;
+        }
+    }
+
+    this->_spatialGrid.update(client_index, coordinates[0], coordinates[1], coordinates[2]);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleSayCommand(int client_index, std::string_view arguments)
+{
+    if (this->rejectMutedSender(client_index))
+    {
+        return ;
+    }
+
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    // "/say <메시지>" : 주변 접속자에게만 전달합니다.
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    if (this->_spatialGrid.getPosition(client_index, x, y, z) == false)
+    {
+        std::string no_position_message = "[시스템] 위치 정보가 없어 근처에 말할 수 없습니다. 먼저 /pos를 보내주세요.";
+        this->_messageSender.unicast(no_position_message, client_socket);
+        return ;
+    }
+
+    int nearby_indices[ClientManagerBase::MAX_CLIENTS];
+    int nearby_count = this->_spatialGrid.queryRadius(x, y, z, MultiServer::SAY_RADIUS, nearby_indices, ClientManagerBase::MAX_CLIENTS);
+
+    // 주변 슬롯 집합에서 보낸 사람을 무시하는 슬롯을 뺍니다. 일시 중단된 접속자는 소켓이 없으므로 건너뜁니다.
+    ClientManagerBase::SessionMask nearby_mask;
+    for (int i = 0; i < nearby_count; ++i)
+    {
+        nearby_mask.set(nearby_indices[i]);
+    }
+    this->_ignoreTable.excludeIgnoring(client_index, nearby_mask);
+    nearby_mask.intersect(this->_clientManager.getJoinedMask());
+
+    SOCKET nearby_sockets[ClientManagerBase::MAX_CLIENTS];
+    int socket_count = this->_clientManager.getMaskedSockets(nearby_mask, nearby_sockets, ClientManagerBase::MAX_CLIENTS);
+
+    std::string say_message = "(근처) [" + this->_clientManager.getClientNickname(client_index) + "]: ";
+    std::size_t say_offset = say_message.size();
+    say_message.append(arguments);
+    this->_chatFilter.apply(say_message, say_offset);
+    this->_messageSender.broadcast(say_message, nearby_sockets, socket_count, MessageSenderBase::Lane::CHAT);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleIgnoreCommand(int client_index, std::string_view arguments)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    // "/ignore <닉네임>" : 무시 중이 아니면 무시하고, 무시 중이면 풉니다.
+    CommandParser::Tokenizer tokenizer(arguments);
+    std::string_view nickname;
+    int target_index = -1;
+    if (tokenizer.next(nickname))
+    {
+        target_index = this->_clientManager.findClient(std::string(nickname));
+    }
+    if (target_index == -1)
+    {
+        std::string not_found_message = "[시스템] 접속자를 찾을 수 없습니다. 사용법: /ignore <닉네임>";
+        this->_messageSender.unicast(not_found_message, client_socket);
+        return ;
+    }
+
+    bool ignoring = false;
+    if (this->_ignoreTable.toggleIgnore(client_index, target_index, ignoring) == IgnoreTable::Result::SELF_TARGET)
+    {
+        std::string self_message = "[시스템] 자기 자신은 무시할 수 없습니다.";
+        this->_messageSender.unicast(self_message, client_socket);
+        return ;
+    }
+
+    std::string result_message = "[시스템] " + std::string(nickname) + (ignoring ? "님의 채팅을 받지 않습니다." : "님의 채팅을 다시 받습니다.");
+    this->_messageSender.unicast(result_message, client_socket);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleMuteCommand(int client_index, std::string_view arguments)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    if (this->_clientManager.hasStateFlag(client_index, ClientManagerBase::FLAG_MODERATOR) == false)
+    {
+        std::string denied_message = "[시스템] 운영자만 사용할 수 있는 명령입니다.";
+        this->_messageSender.unicast(denied_message, client_socket);
+        return ;
+    }
+
+    // "/mute <닉네임>" : 금지 중이 아니면 금지하고, 금지 중이면 풉니다.
+    CommandParser::Tokenizer tokenizer(arguments);
+    std::string_view nickname;
+    int target_index = -1;
+    if (tokenizer.next(nickname))
+    {
+        target_index = this->_clientManager.findClient(std::string(nickname));
+    }
+    if (target_index == -1)
+    {
+        std::string not_found_message = "[시스템] 접속자를 찾을 수 없습니다. 사용법: /mute <닉네임>";
+        this->_messageSender.unicast(not_found_message, client_socket);
+        return ;
+    }
+
+    bool muted = false;
+    this->_ignoreTable.toggleMute(target_index, muted);
+    LOG_INFO("채팅 금지 " + std::string(muted ? "설정" : "해제") + " - 대상: " + std::string(nickname) + ", 운영자: " + this->_clientManager.getClientNickname(client_index));
+
+    std::string result_message = "[시스템] " + std::string(nickname) + (muted ? "님의 채팅을 금지했습니다." : "님의 채팅 금지를 풀었습니다.");
+    this->_messageSender.unicast(result_message, client_socket);
+
+    SOCKET target_socket = this->_clientManager.getClientSocket(target_index);
+    if (target_socket != INVALID_SOCKET && target_index != client_index)
+    {
+        std::string notice_message = muted ? "[시스템] 운영자가 채팅을 금지했습니다." : "[시스템] 운영자가 채팅 금지를 풀었습니다.";
+        this->_messageSender.unicast(notice_message, target_socket);
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleModeratorCommand(int client_index, std::string_view arguments)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    CommandParser::Tokenizer tokenizer(arguments);
+    std::string_view password;
+    if (this->_moderatorPassword.empty() || tokenizer.next(password) == false || password != this->_moderatorPassword)
+    {
+        LOG_WARN("운영자 인증 실패 - 인덱스: " + std::to_string(client_index));
+        std::string denied_message = "[시스템] 운영자 암호가 맞지 않습니다.";
+        this->_messageSender.unicast(denied_message, client_socket);
+        return ;
+    }
+
+    this->_clientManager.setStateFlag(client_index, ClientManagerBase::FLAG_MODERATOR);
+    LOG_INFO("운영자 권한 부여 - " + this->_clientManager.getClientNickname(client_index));
+
+    std::string granted_message = "[시스템] 운영자 권한을 얻었습니다. '/mute 닉네임'으로 채팅을 금지하거나 풀고, '/top [bytes]'로 최근 많이 보낸 송신자를 보고, '/reload'로 금칙어 파일을 다시 읽을 수 있습니다.";
+    this->_messageSender.unicast(granted_message, client_socket);
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::rejectMutedSender(int client_index)
+{
+    if (this->_ignoreTable.isMuted(client_index) == false)
+    {
+        return (false);
+    }
+
+    this->_mutedRejectedCount = this->_mutedRejectedCount + 1;
+    std::string muted_message = "[시스템] 운영자가 채팅을 금지한 상태입니다.";
+    this->_messageSender.unicast(muted_message, this->_clientManager.getClientSocket(client_index));
+    return (true);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::recordTalker(int client_index, std::size_t bytes)
+{
+    sockaddr_in client_addr = {};
+    if (this->_clientManager.getClientAddress(client_index, client_addr) == false)
+    {
+        return ;
+    }
+
+    // 다시 접속하거나 세션을 여러 개 열어도 한 송신자로 집계되도록 포트를 뺀 IPv4 주소만 키로 씁니다.
+    // 한계: 한 NAT 뒤의 사용자들과 루프백 클라이언트는 모두 한 송신자로 합쳐집니다. (그래서 /top이 세션을 따로 나열합니다.)
+    // IPv6는 수락하지 않으므로 32비트 키로 충분하지만, 듀얼 스택으로 바꾸면 128비트 주소의 해시를 키로 써야 합니다.
+    std::uint64_t key = ntohl(client_addr.sin_addr.s_addr);
+    this->_heavyHitters.record(key, (std::uint32_t)bytes, this->_loopClock.getTick());
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleTopCommand(int client_index, std::string_view arguments)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    if (this->_clientManager.hasStateFlag(client_index, ClientManagerBase::FLAG_MODERATOR) == false)
+    {
+        std::string denied_message = "[시스템] 운영자만 사용할 수 있는 명령입니다.";
+        this->_messageSender.unicast(denied_message, client_socket);
+        return ;
+    }
+
+    CommandParser::Tokenizer tokenizer(arguments);
+    std::string_view metric_name;
+    HeavyHitters::Metric metric = HeavyHitters::Metric::MESSAGES;
+    if (tokenizer.next(metric_name) && metric_name == "bytes")
+    {
+        metric = HeavyHitters::Metric::BYTES;
+    }
+
+    HeavyHitters::Talker talkers[HeavyHitters::TOP_COUNT];
+    int talker_count = this->_heavyHitters.collectTop(metric, this->_loopClock.getTick(), talkers, HeavyHitters::TOP_COUNT);
+
+    std::string top_message = "[시스템] 최근 " + std::to_string(this->_heavyHitters.getWindowMs() / 1000) + "초 동안 "
+        + (metric == HeavyHitters::Metric::MESSAGES ? "줄 수" : "바이트") + " 기준 상위 송신 주소 (" + std::to_string(talker_count) + "개):";
+    for (int i = 0; i < talker_count; ++i)
+    {
+        std::uint32_t ip = (std::uint32_t)talkers[i].key;
+        std::string address = std::to_string((ip >> 24) & 0xFF) + "." + std::to_string((ip >> 16) & 0xFF) + "."
+            + std::to_string((ip >> 8) & 0xFF) + "." + std::to_string(ip & 0xFF);
+
+        // 집계는 주소 단위이므로, 그 주소로 지금 접속 중인 세션들은 따로 나열합니다.
+        std::string nicknames;
+        for (int j = 0; j < ClientManagerBase::MAX_CLIENTS; ++j)
+        {
+            sockaddr_in client_addr = {};
+            if (this->_clientManager.getClientAddress(j, client_addr) && ntohl(client_addr.sin_addr.s_addr) == ip)
+            {
+                nicknames = nicknames + (nicknames.empty() ? "" : ", ") + this->_clientManager.getClientNickname(j);
+            }
+        }
+        if (nicknames.empty())
+        {
+            nicknames = "접속 종료";
+        }
+
+        top_message = top_message + "\n  " + std::to_string(i + 1) + ". " + address + " - "
+            + std::to_string(talkers[i].messages) + "줄 / " + std::to_string(talkers[i].bytes) + "바이트 (" + nicknames + ")";
+    }
+    this->_messageSender.unicast(top_message, client_socket);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleRosterCommand(int client_index)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    if (this->_clientManager.hasStateFlag(client_index, ClientManagerBase::FLAG_PRESENCE))
+    {
+        this->_clientManager.clearStateFlag(client_index, ClientManagerBase::FLAG_PRESENCE);
+        this->_messageSender.unicast("[시스템] 접속자 목록 프레임을 더 이상 보내지 않습니다.", client_socket);
+        return ;
+    }
+
+    // 다음 배포에서 델타 대신 현재 버전의 스냅샷부터 보냅니다.
+    this->_clientManager.setStateFlag(client_index, ClientManagerBase::FLAG_PRESENCE);
+    this->_presenceTracker.markUnsynced(client_index);
+    this->_messageSender.unicast("[시스템] 접속자 목록 프레임을 보냅니다. (STX + 4바이트 길이로 시작하며 개행이 없습니다)", client_socket);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleReloadCommand(int client_index)
+{
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+
+    if (this->_clientManager.hasStateFlag(client_index, ClientManagerBase::FLAG_MODERATOR) == false)
+    {
+        std::string denied_message = "[시스템] 운영자만 사용할 수 있는 명령입니다.";
+        this->_messageSender.unicast(denied_message, client_socket);
+        return ;
+    }
+
+    if (this->_chatFilterFile.empty())
+    {
+        this->_messageSender.unicast("[시스템] 금칙어 파일이 설정되지 않았습니다. (chat_filter)", client_socket);
+        return ;
+    }
+
+    // 실패하면 ChatFilter가 기존 목록을 그대로 둡니다.
+    if (this->loadChatFilter(this->_chatFilterFile) == false)
+    {
+        this->_messageSender.unicast("[시스템] 금칙어 파일을 열 수 없어 기존 목록을 유지합니다: " + this->_chatFilterFile, client_socket);
+        return ;
+    }
+
+    LOG_INFO("운영자가 금칙어 파일을 다시 읽었습니다 - 인덱스: " + std::to_string(client_index));
+    this->_messageSender.unicast("[시스템] 금칙어 파일을 다시 읽었습니다. 금칙어: " + std::to_string(this->_chatFilter.getWordCount()) + "개", client_socket);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleStatusCommand(int client_index, std::string_view arguments)
+{
+    std::string status_text = "(없음)";
+    if (arguments.empty() == false)
+    {
+        status_text = std::string(arguments);
+        this->_chatFilter.apply(status_text);
+    }
+
+    SOCKET client_sockets[ClientManagerBase::MAX_CLIENTS];
+    int socket_count = this->_clientManager.getJoinedSockets(client_sockets, ClientManagerBase::MAX_CLIENTS);
+
+    // 같은 클라이언트의 이전 상태가 아직 대기 중이면 새 상태로 덮어써집니다.
+    std::string status_message = "[상태] " + this->_clientManager.getClientNickname(client_index) + ": " + status_text;
+    this->_messageSender.publishState("status:" + std::to_string(client_index), status_message, client_sockets, socket_count,
+        this->_clientManager.getClientSocket(client_index));
+}
+
+template <typename Transport>
+std::string MultiServer<Transport>::makeSequencedMessage(std::uint64_t sequence, const std::string& line)
+{
+    return ("#" + std::to_string(sequence) + " " + line);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::issueResumeToken(int client_index)
+{
+    std::string token = this->_resumeRegistry.issue(client_index);
+    if (token.empty())
+    {
+        // 토큰을 만들지 못하면 재접속 없이 계속 진행합니다.
+        return ;
+    }
+    std::string token_message = "[시스템] RESUME " + token + " " + std::to_string(this->_replayBuffer.getLastSequence());
+    this->_messageSender.unicast(token_message, this->_clientManager.getClientSocket(client_index));
+
+    // 토큰이 바뀌었으므로 UDP 인증 토큰도 다시 알립니다.
+    this->announceDatagramChannel(client_index, token);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::announceDatagramChannel(int client_index, const std::string& token)
+{
+    if (this->_datagramChannel.isOpen() == false)
+    {
+        return ;
+    }
+
+    std::string datagram_message = "[시스템] UDP " + std::to_string(this->_datagramChannel.getPort()) + " " + token;
+    this->_messageSender.unicast(datagram_message, this->_clientManager.getClientSocket(client_index));
+}
+
+template <typename Transport>
+void MultiServer<Transport>::pollGameBridge()
+{
+    if (this->_gameBridge.isOpen() == false)
+    {
+        return ;
+    }
+
+    TRACE_SCOPE("MultiServer::pollGameBridge");
+
+    SOCKET all_sockets[ClientManagerBase::MAX_CLIENTS];
+    int socket_count = -1;
+    std::string bridge_message;
+
+    for (int i = 0; i < MultiServer::BRIDGE_BATCH; ++i)
+    {
+        SharedMemoryBridge::Result receive_result = this->_gameBridge.receive(bridge_message);
+        if (receive_result == SharedMemoryBridge::Result::CORRUPTED)
+        {
+            // 브리지가 링을 비웠으므로 새 메시지부터 다시 읽습니다. 계속 망가지면 게임 서버 쪽 문제이므로 닫습니다.
+            if (this->_gameBridge.getCorruptedCount() >= MultiServer::MAX_BRIDGE_CORRUPTIONS)
+            {
+                LOG_ERROR("게임 서버 브리지가 " + std::to_string(this->_gameBridge.getCorruptedCount()) + "번 손상되어 닫습니다. 게임 서버를 확인하십시오.");
+                this->_gameBridge.close();
+                return ;
+            }
+            break;
+        }
+        if (receive_result != SharedMemoryBridge::Result::SUCCESS)
+        {
+            break;
+        }
+
+        if (socket_count < 0)
+        {
+            socket_count = this->_clientManager.getJoinedSockets(all_sockets, ClientManagerBase::MAX_CLIENTS);
+        }
+        this->_messageSender.broadcast("[게임] " + bridge_message, all_sockets, socket_count);
+    }
+
+    // 읽은 뒤에 다시 깨우도록 해 둡니다. 이번 묶음 뒤에 남은 메시지가 있으면 다음 select가 곧바로 깨어납니다.
+    this->_gameBridge.rearmWakeSocket();
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleClusterTraffic()
+{
+    TRACE_SCOPE("MultiServer::handleClusterTraffic");
+
+    if (this->_selectManager.isSocketReady(this->_clusterRelay.getListenSocket()))
+    {
+        this->_clusterRelay.acceptLink();
+    }
+
+    SOCKET connecting_sockets[ClusterRelayBase::MAX_LINKS];
+    int connecting_count = this->_clusterRelay.getConnectingSockets(connecting_sockets, ClusterRelayBase::MAX_LINKS);
+    for (int i = 0; i < connecting_count; ++i)
+    {
+        if (this->_selectManager.isConnectDone(connecting_sockets[i]))
+        {
+            this->_clusterRelay.finishConnect(connecting_sockets[i]);
+        }
+    }
+
+    // 링크 목록은 수신 중에 바뀔 수 있으므로 select 전에 등록한 소켓 기준으로 확인합니다.
+    SOCKET link_sockets[ClusterRelayBase::MAX_LINKS];
+    int link_count = this->_clusterRelay.getLinkSockets(link_sockets, ClusterRelayBase::MAX_LINKS);
+    std::vector<ClusterRelayBase::Message> messages;
+
+    for (int i = 0; i < link_count; ++i)
+    {
+        if (this->_selectManager.isSocketReady(link_sockets[i]))
+        {
+            this->_clusterRelay.receiveFrom(link_sockets[i], messages);
+        }
+    }
+
+    bool handoff_received = false;
+    for (const ClusterRelayBase::Message& message : messages)
+    {
+        switch (message.type)
+        {
+        case ClusterRelayBase::FrameType::PUBLISH:
+            this->publishChatLine(message.room, message.line, message.hops, -1);
+            break;
+
+        case ClusterRelayBase::FrameType::SEQUENCED:
+            if (this->_roomDirectory.observeSequence(message.room, message.sequence) && this->_replayBuffer.appendAt(message.sequence, message.line, this->_loopClock.getWallSeconds()))
+            {
+                this->deliverChatLine(message.sequence, message.line, -1);
+            }
+            break;
+
+        case ClusterRelayBase::FrameType::HANDOFF:
+            this->_roomDirectory.completeHandoff(message.room, message.sequence, this->_loopClock.now());
+            handoff_received = true;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // 넘겨받기가 끝났으면 기다리던 채팅을 다음 반복까지 미루지 않고 바로 순번을 매깁니다.
+    if (handoff_received)
+    {
+        this->updateRoomOwnership();
+    }
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleDatagrams()
+{
+    TRACE_SCOPE("MultiServer::handleDatagrams");
+
+    int received_count = this->_datagramChannel.receiveBatch();
+    for (int i = 0; i < received_count; ++i)
+    {
+        this->handleDatagram(this->_datagramChannel.getReceived(i));
+    }
+
+    // 묶음 처리 중 모인 응답과 팬아웃을 한 번에 보냅니다.
+    this->_datagramChannel.flushSends();
+}
+
+template <typename Transport>
+void MultiServer<Transport>::handleDatagram(const DatagramChannelBase::Datagram& datagram)
+{
+    // "<토큰> <종류>[ <내용>]" 형식을 분리합니다.
+    std::string text(datagram.data, datagram.length);
+    std::size_t token_end = text.find(' ');
+    if (token_end != (std::size_t)ResumeRegistry::TOKEN_LENGTH)
+    {
+        this->_datagramRejectedCount = this->_datagramRejectedCount + 1;
+        return ;
+    }
+
+    // 살아 있는 TCP 세션의 토큰이어야 합니다.
+    int client_index = this->_resumeRegistry.findActive(text.substr(0, token_end));
+    if (client_index == -1 || this->_presenceTracker.isMember(client_index) == false)
+    {
+        this->_datagramRejectedCount = this->_datagramRejectedCount + 1;
+        return ;
+    }
+
+    std::size_t kind_begin = token_end + 1;
+    std::size_t kind_end = text.find(' ', kind_begin);
+    if (kind_end == std::string::npos)
+    {
+        kind_end = text.size();
+    }
+    std::size_t kind_length = kind_end - kind_begin;
+    if (kind_length == 0 || kind_length > MultiServer::MAX_EVENT_KIND_LENGTH)
+    {
+        this->_datagramRejectedCount = this->_datagramRejectedCount + 1;
+        return ;
+    }
+
+    // 주소가 바뀌어도(NAT 재바인딩 등) 마지막으로 인증된 주소로 보냅니다.
+    this->_datagramChannel.bindEndpoint(client_index, datagram.address);
+
+    std::string kind = text.substr(kind_begin, kind_length);
+    std::string payload_suffix = text.substr(kind_end);
+    if (kind == "HELLO")
+    {
+        return ;
+    }
+    if (kind == "PING")
+    {
+        std::string pong = "PONG" + payload_suffix;
+        this->_datagramChannel.queueSend(datagram.address, pong.c_str(), (int)pong.size());
+        return ;
+    }
+
+    // 채팅방의 다른 접속자 중 UDP 주소가 있는 클라이언트에게만 전달합니다.
+    std::string event = this->_clientManager.getClientNickname(client_index) + " " + kind + payload_suffix;
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        if (i == client_index || this->_presenceTracker.isMember(i) == false)
+        {
+            continue;
+        }
+
+        const sockaddr_in* endpoint = this->_datagramChannel.findEndpoint(i);
+        if (endpoint != nullptr)
+        {
+            this->_datagramChannel.queueSend(*endpoint, event.c_str(), (int)event.size());
+        }
+    }
+}
+
+template <typename Transport>
+bool MultiServer<Transport>::resumeSession(int client_index, std::string_view arguments, SessionContext<RecordingTransport<Transport>>& context)
+{
+    // "<토큰> <순번>" 형식을 분리합니다.
+    CommandParser::Tokenizer tokenizer(arguments);
+    std::string_view token_text;
+    std::string_view sequence_text;
+    if (tokenizer.next(token_text) == false || tokenizer.next(sequence_text) == false || tokenizer.rest().empty() == false)
+    {
+        return (false);
+    }
+    std::string token(token_text);
+
+    std::uint64_t last_sequence = 0;
+    std::from_chars_result parse_result = std::from_chars(sequence_text.data(), sequence_text.data() + sequence_text.size(), last_sequence);
+    if (parse_result.ec != std::errc() || parse_result.ptr != sequence_text.data() + sequence_text.size())
+    {
+        return (false);
+    }
+
+    int previous_index = this->_resumeRegistry.claim(token);
+    if (previous_index == -1)
+    {
+        LOG_WARN("유효하지 않은 재접속 토큰 - 인덱스: " + std::to_string(client_index));
+        return (false);
+    }
+
+    // 새 연결의 소켓을 이전 슬롯으로 옮깁니다. 별칭과 접속자 목록 자리는 그대로이므로 참가/퇴장 알림이 없습니다.
+    SOCKET client_socket = this->_clientManager.getClientSocket(client_index);
+    if (this->_clientManager.transferClient(client_index, previous_index) == false)
+    {
+        LOG_ERROR("재접속 슬롯 이동 실패 - 인덱스: " + std::to_string(client_index) + " -> " + std::to_string(previous_index));
+        return (false);
+    }
+    std::string nickname = this->_clientManager.getClientNickname(previous_index);
+
+    // 무시 목록과 채팅 금지는 이전 슬롯에 남아 있습니다. 새 연결이 잠시 쓴 슬롯은 비웁니다.
+    this->_ignoreTable.clearSlot(client_index);
+
+    // 일시 중단 중에 놓친 접속자 목록 델타 대신 다음 틱에 스냅샷을 보냅니다.
+    this->_presenceTracker.markUnsynced(previous_index);
+
+    // 놓친 메시지만 재전송합니다.
+    std::vector<const ReplayBuffer::Entry*> missed_entries;
+    ReplayBuffer::Result replay_result = this->_replayBuffer.collectSince(last_sequence, missed_entries);
+    if (replay_result == ReplayBuffer::Result::TRUNCATED)
+    {
+        std::string truncated_message = "[시스템] 오래된 메시지 일부는 복구할 수 없습니다.";
+        this->_messageSender.unicast(truncated_message, client_socket);
+    }
+
+    std::string resume_message = "[시스템] " + nickname + "(으)로 재접속했습니다. 놓친 메시지 " + std::to_string(missed_entries.size()) + "개를 보냅니다.";
+    if (missed_entries.empty() == false)
+    {
+        // 보관 시각은 루프 시계의 벽시계 초이므로 시계를 다시 읽지 않고 경과 시간을 계산합니다.
+        std::int64_t oldest_age = (std::int64_t)(this->_loopClock.getWallSeconds() - missed_entries.front()->wallSeconds);
+        resume_message = resume_message + " (가장 오래된 메시지: " + std::to_string(oldest_age) + "초 전)";
+    }
+    this->_messageSender.unicast(resume_message, client_socket);
+    for (const ReplayBuffer::Entry* entry : missed_entries)
+    {
+        this->_messageSender.unicast(this->makeSequencedMessage(entry->sequence, entry->line), client_socket, MessageSenderBase::Lane::CHAT);
+    }
+
+    // 새 토큰 발급
+    this->issueResumeToken(previous_index);
+
+    // 이전 슬롯에서 채팅 세션을 이어갑니다. 재접속 요청 뒤에 이미 도착한 데이터도 넘겨줍니다.
+    SessionContext<RecordingTransport<Transport>>& resumed_context = this->_sessionScheduler.prepare(previous_index, client_socket);
+    resumed_context.unreadInput(context.takeBufferedInput());
+    this->_sessionScheduler.spawn(previous_index, this->chatSession(previous_index, resumed_context));
+
+    LOG_INFO("세션 재접속 완료 - 인덱스: " + std::to_string(client_index) + " -> " + std::to_string(previous_index) + ", 재전송: " + std::to_string(missed_entries.size()) + "개");
+    return (true);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::suspendSession(int client_index)
+{
+    NetworkTransport::Clock::time_point deadline = this->_loopClock.now() + std::chrono::milliseconds(MultiServer::RESUME_GRACE_MS);
+    this->_resumeRegistry.suspend(client_index, deadline);
+
+    // 토큰을 받지 못한 세션은 일시 중단하지 않고 바로 퇴장 처리합니다.
+    if (this->_resumeRegistry.isSuspended(client_index) == false)
+    {
+        this->announceLeave(client_index);
+        return ;
+    }
+
+    this->_datagramChannel.unbindEndpoint(client_index);
+    this->_messageSender.release(this->_clientManager.getClientSocket(client_index));
+    this->_clientManager.suspendClient(client_index);
+}
+
+template <typename Transport>
+void MultiServer<Transport>::expireSuspendedSessions()
+{
+    int expired_indices[ClientManagerBase::MAX_CLIENTS];
+    int expired_count = this->_resumeRegistry.collectExpired(this->_loopClock.now(), expired_indices, ClientManagerBase::MAX_CLIENTS);
+
+    for (int i = 0; i < expired_count; ++i)
+    {
+        int client_index = expired_indices[i];
+
+        // 유예 시간 안에 재접속하지 않았으므로 이제 퇴장을 알립니다.
+        this->announceLeave(client_index);
+        this->_resumeRegistry.forget(client_index);
+        this->_presenceTracker.removeMember(client_index);
+        this->_spatialGrid.remove(client_index);
+        this->_datagramChannel.unbindEndpoint(client_index);
+        this->_ignoreTable.clearSlot(client_index);
+        this->_clientManager.removeClient(client_index);
+    }
+}
+
+INSTANTIATE_SERVER_TRANSPORTS(MultiServer);
@@ -17,24 +17,85 @@
 #include "SelectManager.h"
 #include "MessageSender.h"
 #include "MessageReceiver.h"
+#include "SessionScheduler.h"
+#include "PresenceTracker.h"
+#include "ReplayBuffer.h"
+#include "ResumeRegistry.h"
+#include "SpatialGrid.h"
+#include "DatagramChannel.h"
+#include "SharedMemoryBridge.h"
+#include "ClusterRelay.h"
+#include "RoomDirectory.h"
+#include "ChatFilter.h"
+#include "IgnoreTable.h"
+#include "LoopClock.h"
+#include "HeavyHitters.h"
+#include "CommandParser.h"
+#include "FlightRecorder.h"
+#include "RecordingTransport.h"
+#include "RoomWorkers.h"
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 /**
- * @class MultiServer
- * @brief select 기반 루프를 통해 다중 클라이언트 채팅 서버를 관리하는 클래스입니다.
+ * @class MultiServerBase
+ * @brief 전송 계층과 무관한 MultiServer의 상수, 결과 타입과 세션 방식을 담습니다.
  *
- * @details
- * MultiServer 클래스는 지정된 포트에서 서버를 시작합니다.
- * <br>신규 클라이언트 연결을 받아들입니다.
- * <br>등록된 클라이언트로부터 메시지를 수신합니다. (MessageReceiver 사용).
- * <br>등록된 클라이언트들에게 메시지를 발송합니다. (MessageSender 사용).
- * <br>서버 동작 전반을 관리합니다.
- * <br>각 단계에서의 오류를 나타내는 결과 상태 값(Result)을 제공합니다.
+ * @note 설정과 테스트 코드는 MultiServerBase::SessionMode처럼 씁니다.
  */
-class MultiServer
+class MultiServerBase
 {
+public:
+    /// COROUTINE 모드에서 새 연결의 첫 줄이 재접속 요청인지 기다리는 시간(밀리초).
+    static constexpr int RESUME_WAIT_MS = 200;
+
+    /// 연결이 끊긴 세션을 재접속을 위해 유지하는 시간(밀리초).
+    static constexpr int RESUME_GRACE_MS = 30000;
+
+    /// 근접 채팅("/say")이 전달되는 반경 (언리얼 월드 단위, cm).
+    static constexpr float SAY_RADIUS = 2000.0f;
+
+    /// 송신 대기열 지표를 로그로 남기는 주기(밀리초).
+    static constexpr int OUTBOUND_METRICS_INTERVAL_MS = 10000;
+
+    /// 반복 하나에서 클라이언트 하나에게 허용하는 최대 수신(recv/세션 재개) 횟수.
+    static constexpr int READ_BUDGET_PER_CLIENT = 4;
+
+    /// 바쁜 폴링 모드에서 연속으로 빈 0ms 폴링을 허용하는 횟수 (이 구간은 양보 없이 회전합니다).
+    static constexpr int BUSY_POLL_SPIN_COUNT = 20000;
+
+    /// 회전 구간 뒤 매 폴링마다 스레드를 양보하며 0ms 폴링을 더 시도하는 횟수. 이것까지 비면 블로킹 select로 물러납니다.
+    static constexpr int BUSY_POLL_YIELD_COUNT = 2000;
+
+    /// UDP 이벤트 종류 이름의 최대 길이.
+    static constexpr std::size_t MAX_EVENT_KIND_LENGTH = 16;
+
+    /// 송신 버퍼가 가득 차 보내지 못한 메시지가 있을 때 select가 기다리는 최대 시간(밀리초).
+    static constexpr int OUTPUT_RETRY_MS = 10;
+
+    /// 반복 하나에서 게임 서버 브리지로부터 꺼내는 최대 메시지 수.
+    static constexpr int BRIDGE_BATCH = 64;
+
+    /// 게임 서버 브리지 링이 이만큼 손상되면 브리지를 닫습니다.
+    static constexpr std::uint64_t MAX_BRIDGE_CORRUPTIONS = 3;
+
+    /// 클러스터 모드에서 채팅방 ID. (채팅방은 하나이며, 주인 노드는 이 ID의 해시로 정해집니다.)
+    static constexpr const char* LOBBY_ROOM_ID = "lobby";
+
+    /// 주인이 아닌 노드 사이에서 채팅이 주인을 찾아 전달될 수 있는 최대 횟수. 노드마다 링이 잠시 다를 때의 순환을 막습니다.
+    static constexpr int MAX_FORWARD_HOPS = 2;
+
+    /// 채팅방 작업자의 치우침을 확인하는 주기(밀리초).
+    static constexpr int ROOM_BALANCE_INTERVAL_MS = 5000;
+
+    /// 채팅방 작업자의 치우침(최댓값 / 평균)이 이 값 이상이면 가장 바쁜 채팅방을 옮깁니다.
+    static constexpr double ROOM_SKEW_THRESHOLD = 1.5;
+
 public:
     /**
-     * @enum MultiServer::Result
+     * @enum MultiServerBase::Result
      * @brief 서버 동작의 상태 값.
      */
     enum class Result
@@ -45,12 +106,47 @@ public:
         SERVER_STOPPED  ///< 서버가 정상적으로 중지됨 (메인 루프 종료 신호로 사용).
     };
 
+    /**
+     * @enum MultiServerBase::SessionMode
+     * @brief 클라이언트 세션 로직을 실행하는 방식.
+     */
+    enum class SessionMode
+    {
+        HANDLER,        ///< select 이벤트마다 handleClientMessage()를 호출하는 기존 방식.
+        COROUTINE       ///< 연결마다 세션 코루틴(runSession)을 실행하는 방식.
+    };
+
+};
+
+/**
+ * @class MultiServer
+ * @brief select 기반 루프를 통해 다중 클라이언트 채팅 서버를 관리하는 클래스입니다.
+ *
+ * @details
+ * MultiServer 클래스는 지정된 포트에서 서버를 시작합니다.
+ * <br>신규 클라이언트 연결을 받아들입니다.
+ * <br>등록된 클라이언트로부터 메시지를 수신합니다. (MessageReceiver 사용).
+ * <br>등록된 클라이언트들에게 메시지를 발송합니다. (MessageSender 사용).
+ * <br>서버 동작 전반을 관리합니다.
+ * <br>각 단계에서의 오류를 나타내는 결과 상태 값(Result)을 제공합니다.
+ *
+ * 전송 계층 타입(Transport)은 빌드 시점에 정해집니다.
+ * <br>서버는 이를 RecordingTransport<Transport>로 감싸고, 구성 요소들도 같은 타입으로 만듭니다.
+ * <br>final 타입(WinSockTransport, SimulatedTransport)으로 만들면 루프의 모든 소켓 호출이 가상 호출 없이 묶입니다.
+ *
+ * @tparam Transport : 모든 소켓 호출에 사용할 전송 계층 타입.
+ */
+template <typename Transport>
+class MultiServer : public MultiServerBase
+{
 public:
 
     /**
-     * @fn MultiServer::MultiServer(int port)
+     * @fn MultiServer::MultiServer(int port, Transport& transport, MultiServer::SessionMode session_mode)
      * @brief 지정된 포트 번호로 MultiServer를 생성합니다.
      * @param[IN] int port : 서버가 클라이언트 연결을 대기할 TCP 포트 번호.
+     * @param[IN] Transport& transport : 모든 소켓 호출에 사용할 전송 계층 (서버보다 오래 살아 있어야 합니다).
+     * @param[IN(default : HANDLER)] MultiServer::SessionMode session_mode : 세션 로직 실행 방식.
      * @return 없음.
      *
      * @details
@@ -58,7 +154,7 @@ public:
      * <br>서버는 아직 시작되지 않은 상태입니다.
      * <br>서버를 실제로 시작하려면 startServer()를 호출해야 합니다.
      */
-    explicit MultiServer(int port);
+    MultiServer(int port, Transport& transport, MultiServer::SessionMode session_mode = MultiServer::SessionMode::HANDLER);
 
     /**
      * @fn MultiServer::~MultiServer()
@@ -110,7 +206,8 @@ public:
      * @return 없음.
      * 
      * @note 이 함수를 호출하면 내부적으로 서버 종료 플래그를 설정합니다.
-     * <br>루프가 종료되고 자원이 해제됩니다.
+     * <br>루프가 종료되고 자원이 해제됩니다. 루프를 돌리는 스레드가 아닌 스레드에서 호출해도 됩니다.
+     * <br>루프는 지금 대기 중인 select가 끝난 뒤(최대 1초) 멈춥니다.
      */
     void stop();
 
@@ -121,19 +218,277 @@ public:
      */
     bool isRunning() const;
 
+    /**
+     * @fn void MultiServer::setStallBudget(int budget_ms)
+     * @brief 루프 반복 하나의 작업 시간 예산을 설정합니다. 넘으면 최근 루프 활동을 stall_<번호>.log로 남깁니다.
+     * @param[IN] int budget_ms : 예산(밀리초). 0 이하이면 정체 감시를 끕니다.
+     * @return 없음.
+     * @note 기본값은 FlightRecorder::DEFAULT_BUDGET_MS입니다. select 대기 시간은 작업 시간에 포함되지 않습니다.
+     */
+    void setStallBudget(int budget_ms);
+
+    /**
+     * @fn void MultiServer::enableBusyPoll(int pinned_core)
+     * @brief 지연 시간을 CPU보다 우선하는 바쁜 폴링 루프 모드를 켭니다. runServerLoop() 전에 호출합니다.
+     * @param[IN] int pinned_core : 루프 스레드를 고정할 CPU 코어 번호 (기본값 -1 : 고정하지 않음).
+     * @return 없음.
+     *
+     * @details
+     * select를 0ms로 반복 호출하다가, 연속으로 BUSY_POLL_SPIN_COUNT번 비면 양보(Sleep(0))를 섞고,
+     * <br>BUSY_POLL_YIELD_COUNT번 더 비면 평소의 블로킹 select로 물러납니다. 이벤트가 하나라도 오면 다시 회전합니다.
+     * @note Windows 소켓에는 SO_BUSY_POLL이 없으므로 소켓 옵션은 설정하지 않습니다.
+     */
+    void enableBusyPoll(int pinned_core = -1);
+
+    /**
+     * @fn void MultiServer::enableParallelFanout(int worker_count)
+     * @brief 접속자가 많은 채팅방의 브로드캐스트를 여러 스레드로 나누어 송신 대기열에 넣습니다. runServerLoop() 전에 호출합니다.
+     * @param[IN] int worker_count : 루프 스레드 외에 더 쓸 작업자 스레드 수.
+     * @return 없음.
+     *
+     * @details
+     * 대상 수가 팬아웃 임계값 이상인 broadcast/multicast만 청크로 나누어 작업 훔치기 스레드 풀에서 처리하고, 작은 방은 루프에서 바로 처리합니다.
+     * <br>임계값은 실행 중 측정한 비용으로 계속 조정됩니다. 전송(flush)은 지금처럼 루프 스레드가 합니다.
+     * @note 세부 동작은 MessageSender::enableParallelFanout()과 FanoutPool을 참고합니다.
+     */
+    void enableParallelFanout(int worker_count);
+
+    /**
+     * @fn void MultiServer::enableRoomWorkers(int worker_count)
+     * @brief 채팅방 채팅을 채팅방마다 정해진 작업자 스레드에서 처리합니다. runServerLoop() 전에 호출합니다.
+     * @param[IN] int worker_count : 작업자 스레드 수 (1 이상).
+     * @return 없음.
+     *
+     * @details
+     * 루프는 채팅 금지 확인과 줄 만들기만 하고, 줄을 채팅방 주인 작업자에게 (루프, 작업자) 쌍의 SPSC 큐로 넘깁니다.
+     * <br>작업자는 금칙어를 가리고 채팅방 순번을 올린 뒤 작업자별 SPSC 결과 큐로 돌려줍니다.
+     * <br>루프는 매 반복 결과를 채팅방 순번대로 재전송 버퍼에 넣고 보냅니다. 소켓 입출력은 지금처럼 루프 스레드만 합니다.
+     * <br>돌려받지 못한 채팅이 있는 동안 select는 기다리지 않습니다.
+     * <br>ROOM_BALANCE_INTERVAL_MS마다 치우침이 ROOM_SKEW_THRESHOLD 이상이면 가장 바쁜 채팅방을 가장 한가한 작업자로 옮깁니다.
+     * @note 참가/퇴장 같은 시스템 메시지는 작업자를 거치지 않으므로, 작업자가 처리 중인 채팅보다 먼저 도착할 수 있습니다.
+     * <br>배정과 이동 규칙은 RoomWorkers를 참고합니다.
+     */
+    void enableRoomWorkers(int worker_count);
+
+    /**
+     * @fn bool MultiServer::migrateRoom(const std::string& room, int worker_index)
+     * @brief 채팅방을 다른 작업자로 옮깁니다. 어느 스레드에서 호출해도 되며, 옮기는 동안에도 채팅 순서는 유지됩니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] int worker_index : 새 주인 작업자 번호.
+     * @return bool : 이동을 시작했으면 true, 채팅방 작업자를 쓰지 않거나 RoomWorkers::migrateRoom()이 거절하면 false.
+     */
+    bool migrateRoom(const std::string& room, int worker_index);
+
+    /**
+     * @fn std::vector<RoomWorkers::WorkerStats> MultiServer::getRoomWorkerStats() const
+     * @brief 채팅방 작업자별 부하 통계를 반환합니다.
+     * @return std::vector<RoomWorkers::WorkerStats> : 작업자 번호 순서의 통계, 채팅방 작업자를 쓰지 않으면 빈 목록.
+     */
+    std::vector<RoomWorkers::WorkerStats> getRoomWorkerStats() const;
+
+    /**
+     * @fn double MultiServer::getRoomWorkerSkew() const
+     * @brief 채팅방 작업자 부하의 치우침을 반환합니다.
+     * @return double : 최근 초당 처리량의 (최댓값 / 평균), 처리량이 없거나 채팅방 작업자를 쓰지 않으면 0.
+     */
+    double getRoomWorkerSkew() const;
+
+    /**
+     * @fn void MultiServer::enableDatagramChannel()
+     * @brief 입력 중 표시, 발화 표시, 핑 같은 일회성 이벤트용 UDP 채널을 켭니다. startServer() 전에 호출합니다.
+     * @return 없음.
+     *
+     * @details
+     * TCP 포트와 같은 번호의 UDP 포트를 엽니다. 접속한 클라이언트는 "[시스템] UDP <포트> <토큰>"을 받고,
+     * <br>"<토큰> <종류>[ <내용>]" 형식의 데이터그램을 보냅니다. 토큰이 살아 있는 세션의 것이 아니면 버립니다.
+     * - HELLO : 보낸 주소를 이 클라이언트의 UDP 주소로 등록만 합니다.
+     * - PING : 보낸 주소로 "PONG[ <내용>]"을 바로 돌려줍니다.
+     * - 그 밖의 종류 : 채팅방의 다른 접속자 중 UDP 주소가 등록된 클라이언트에게 "<닉네임> <종류>[ <내용>]"으로 전달합니다.
+     * @note 이벤트는 TCP 송신 대기열을 거치지 않으며, 송신 버퍼가 가득 차면 기다리지 않고 버립니다.
+     */
+    void enableDatagramChannel();
+
+    /**
+     * @fn void MultiServer::enableGameBridge(const std::string& name)
+     * @brief 같은 호스트의 게임 서버와 공유 메모리로 메시지를 주고받는 브리지를 켭니다. startServer() 전에 호출합니다.
+     * @param[IN] const std::string& name : 공유 영역 이름 (게임 서버가 같은 이름으로 SharedMemoryBridge::Role::GAME을 엽니다).
+     * @return 없음.
+     *
+     * @details
+     * 게임 서버는 소켓 없이 특별한 세션처럼 동작합니다.
+     * - 게임 서버가 보낸 메시지는 "[게임] 메시지"로 모든 접속자에게 전달됩니다.
+     * - 중계된 채팅은 "#<순번> [닉네임]: 메시지" 그대로 게임 서버에도 전달됩니다.
+     * @note 브리지가 가득 차면 게임 서버로 가는 채팅은 버립니다. (채팅 서버 루프를 막지 않습니다.)
+     */
+    void enableGameBridge(const std::string& name);
+
+    /**
+     * @fn void MultiServer::enableCluster(int cluster_port)
+     * @brief 여러 서버 프로세스가 하나의 채팅방을 나누어 맡는 클러스터 모드를 켭니다. startServer() 전에 호출합니다.
+     * @param[IN] int cluster_port : 다른 노드와의 링크를 받는 클러스터 포트 (노드마다 달라야 합니다).
+     * @return 없음.
+     *
+     * @details
+     * 채팅방의 주인 노드는 살아 있는 노드로 만든 일관 해시 링이 정하고, 주인만 채팅방 순번을 매깁니다.
+     * <br>주인이 아닌 노드는 로컬 접속자의 채팅을 주인에게 넘기고, 주인이 순번을 매겨 돌려준 채팅을 로컬 접속자에게 보냅니다.
+     * <br>따라서 모든 노드의 접속자가 같은 순번과 순서로 채팅을 받습니다.
+     * <br>노드가 들어오거나 나가면 주인이 바뀐 채팅방만 옮겨지며, 이전 주인이 마지막 순번을 넘겨줄 때까지 새 채팅은 새 주인에 쌓여 기다립니다.
+     * <br>정상 종료하는 노드는 자기가 주인인 채팅방을 다음 노드에 넘겨준 뒤 링크를 닫습니다.
+     * @note 노드 간 링크와 프레임 형식은 ClusterRelay를, 주인과 넘겨받기 규칙은 RoomDirectory를 참고합니다.
+     */
+    void enableCluster(int cluster_port);
+
+    /**
+     * @fn void MultiServer::addClusterPeer(const std::string& host, int cluster_port)
+     * @brief 클러스터의 다른 노드를 등록합니다. 모든 노드에 나머지 노드를 모두 등록합니다.
+     * @param[IN] const std::string& host : 노드의 IPv4 주소.
+     * @param[IN] int cluster_port : 노드의 클러스터 포트.
+     * @return 없음.
+     */
+    void addClusterPeer(const std::string& host, int cluster_port);
+
+    /**
+     * @fn bool MultiServer::loadChatFilter(const std::string& file_path)
+     * @brief 금칙어 파일을 읽어 채팅 필터에 적용합니다.
+     * @param[IN] const std::string& file_path : 한 줄에 하나씩 금칙어를 적은 UTF-8 파일 경로.
+     * @return bool : 적용했으면 true, 파일을 열 수 없으면 false (기존 목록 유지).
+     *
+     * @details
+     * 채팅방 채팅, 근접 채팅("/say"), 상태 메시지의 금칙어를 글자마다 '*'로 가린 뒤 보냅니다.
+     * <br>서버 실행 중 다른 스레드에서 호출해도 됩니다. 새 목록은 컴파일이 끝난 뒤 포인터 교체로 적용되므로 루프는 멈추지 않습니다.
+     * @note 필터 구조는 ChatFilter를 참고합니다.
+     */
+    bool loadChatFilter(const std::string& file_path);
+
+    /**
+     * @fn bool MultiServer::setChatFilterFile(const std::string& file_path)
+     * @brief 금칙어 파일 경로를 정하고 읽어 적용합니다. startServer() 전에 호출합니다.
+     * @param[IN] const std::string& file_path : 한 줄에 하나씩 금칙어를 적은 UTF-8 파일 경로.
+     * @return bool : 적용했으면 true, 파일을 열 수 없으면 false.
+     * @note 운영자는 "/reload"로 서버를 멈추지 않고 같은 파일을 다시 읽게 할 수 있습니다. 다시 읽기는 루프 스레드에서 하므로 그동안 루프가 잠시 멈춥니다.
+     */
+    bool setChatFilterFile(const std::string& file_path);
+
+    /**
+     * @fn void MultiServer::setModeratorPassword(const std::string& password)
+     * @brief "/mod <암호>"로 운영자 권한을 얻을 때 쓸 암호를 정합니다. startServer() 전에 호출합니다.
+     * @param[IN] const std::string& password : 운영자 암호 (비어 있으면 아무도 운영자가 될 수 없습니다).
+     * @return 없음.
+     *
+     * @details
+     * 운영자는 "/mute <닉네임>"으로 다른 접속자의 채팅방 채팅과 근접 채팅을 막거나 풀 수 있습니다.
+     * <br>모든 접속자는 "/ignore <닉네임>"으로 특정 접속자의 채팅을 받지 않거나 다시 받을 수 있습니다.
+     * <br>무시 목록과 채팅 금지는 슬롯 비트 집합(IgnoreTable)으로 보관하므로, 팬아웃마다 받는 사람을 하나씩 확인하지 않습니다.
+     * @note 클러스터 모드에서 채팅방 주인을 거쳐 돌아온 채팅과 재접속 때 재전송하는 채팅에는 무시 목록을 적용하지 않습니다.
+     */
+    void setModeratorPassword(const std::string& password);
+
 private:
     /// 서버가 수신 대기하는 TCP 포트 번호.
     int _port;
+    /// 최근 루프 활동(깨어남, 송수신 크기와 소요 시간)을 보관하는 상시 기록기.
+    FlightRecorder _flightRecorder;
+    /// 생성자에 전달된 전송 계층을 감싸 모든 소켓 호출을 _flightRecorder에 남기는 전송 계층.
+    RecordingTransport<Transport> _recordingTransport;
+    /// 소켓 호출과 대기에 사용하는 전송 계층 (_recordingTransport). 구성 요소들도 이 타입으로 만들어 같은 경로를 씁니다.
+    RecordingTransport<Transport>& _transport;
     /// 리스닝(클라이언트 받기용) TCP 소켓(create, bind, listen, accept 관리).
-    TCPSocket _tcpSocket;
+    TCPSocket<RecordingTransport<Transport>> _tcpSocket;
     /// 연결된 클라이언트 소켓들과 별칭을 관리하는 객체.
-    ClientManager _clientManager;
+    ClientManager<RecordingTransport<Transport>> _clientManager;
     /// fd_set 구성 및 select() 호출하는 객체.
-    SelectManager _selectManager;
+    SelectManager<RecordingTransport<Transport>> _selectManager;
     /// 서버에서 클라이언트들에게 메시지를 보내는 객체.
-    MessageSender _messageSender;
-    /// 서버 루프 실행 여부를 나타내는 플래그.
-    bool _isRunning;
+    MessageSender<RecordingTransport<Transport>> _messageSender;
+    /// 서버 루프 실행 여부를 나타내는 플래그 (다른 스레드의 stop()이 바꿀 수 있음).
+    std::atomic<bool> _isRunning;
+    /// 클라이언트 세션 로직 실행 방식.
+    SessionMode _sessionMode;
+    /// COROUTINE 모드에서 세션 코루틴을 재개하는 스케줄러.
+    SessionScheduler<RecordingTransport<Transport>> _sessionScheduler;
+    /// 채팅방 접속자 목록의 스냅샷과 버전별 델타를 관리하는 객체.
+    PresenceTracker _presenceTracker;
+    /// 중계된 채팅 메시지를 순번과 함께 보관하는 재전송 버퍼.
+    ReplayBuffer _replayBuffer;
+    /// 재접속 토큰과 일시 중단된 세션을 관리하는 객체.
+    ResumeRegistry _resumeRegistry;
+    /// 근접 채팅 대상을 찾기 위한 접속자 위치 격자.
+    SpatialGrid _spatialGrid;
+    /// 송신 대기열 지표를 마지막으로 기록한 틱.
+    std::int64_t _lastOutboundMetricsTick;
+    /// 다음 반복에서 클라이언트 검사를 시작할 인덱스 (매 반복 한 칸씩 회전).
+    int _readCursor;
+    /// 수신 예산을 다 써 데이터가 남은 채로 다음 반복에 이월된 클라이언트 표시.
+    std::array<bool, ClientManagerBase::MAX_CLIENTS> _pendingReads;
+    /// 이월된 클라이언트 수 (0보다 크면 select를 기다리지 않습니다).
+    int _pendingReadCount;
+    /// 바쁜 폴링 모드 사용 여부.
+    bool _busyPoll;
+    /// 루프 스레드를 고정할 CPU 코어 번호 (-1이면 고정하지 않음).
+    int _pinnedCore;
+    /// 바쁜 폴링 모드에서 연속으로 비어 있던 폴링 횟수.
+    int _idlePollCount;
+    /// 바쁜 폴링 모드에서 빈 0ms 폴링의 누적 횟수 (CPU 사용 지표).
+    std::uint64_t _emptyPollTotal;
+    /// 바쁜 폴링 모드에서 블로킹 select로 물러난 누적 횟수.
+    std::uint64_t _busyPollBlockTotal;
+    /// startServer()에서 UDP 이벤트 채널을 열지 여부.
+    bool _datagramEnabled;
+    /// 일회성 이벤트용 UDP 채널.
+    DatagramChannel<RecordingTransport<Transport>> _datagramChannel;
+    /// 토큰이 없거나 형식이 잘못되어 버린 데이터그램 수.
+    std::uint64_t _datagramRejectedCount;
+    /// startServer()에서 열 게임 서버 브리지 이름 (비어 있으면 사용하지 않음).
+    std::string _bridgeName;
+    /// 같은 호스트의 게임 서버와 연결된 공유 메모리 브리지.
+    SharedMemoryBridge _gameBridge;
+    /// startServer()에서 열 클러스터 포트 (0이면 클러스터를 사용하지 않음).
+    int _clusterPort;
+    /// 다른 서버 노드와 채팅을 주고받는 클러스터 중계기.
+    ClusterRelay<RecordingTransport<Transport>> _clusterRelay;
+    /// 클러스터 모드에서 채팅방 주인과 순번을 관리하는 디렉터리.
+    RoomDirectory _roomDirectory;
+    /// 채팅의 금칙어를 가리는 필터.
+    ChatFilter _chatFilter;
+    /// "/reload"가 다시 읽는 금칙어 파일 경로 (비어 있으면 설정되지 않음).
+    std::string _chatFilterFile;
+    /// 접속자별 무시 목록과 채팅 금지 슬롯.
+    IgnoreTable _ignoreTable;
+    /// "/mod" 명령의 운영자 암호 (비어 있으면 사용하지 않음).
+    std::string _moderatorPassword;
+    /// 채팅 금지 상태라서 버린 채팅 수.
+    std::uint64_t _mutedRejectedCount;
+    /// select가 돌아올 때마다 한 번 읽는 루프 시계. 타이머, 유휴 검사, 재전송 버퍼, 루프 스레드의 로그가 함께 씁니다.
+    LoopClock _loopClock;
+    /// 최근 시간 창에서 채팅 줄과 바이트를 가장 많이 보낸 송신자를 고정 메모리로 추적하는 집계기.
+    HeavyHitters _heavyHitters;
+
+    /**
+     * @struct MultiServer::RoomChat
+     * @brief 채팅방 작업자가 처리를 마치고 루프로 돌려주는 채팅 한 줄.
+     */
+    struct RoomChat
+    {
+        std::string room;               ///< 채팅방 ID.
+        std::uint64_t sequence = 0;     ///< 작업자가 매긴 채팅방 순번 (이동해도 이어집니다).
+        std::uint64_t tag = 0;          ///< 제출할 때 붙인 값 (makeRoomTag() 참고).
+        std::string line;               ///< 금칙어를 가린 "[닉네임]: 메시지".
+    };
+
+    /// 채팅방 작업자가 처리한 채팅을 루프로 돌려주는 작업자별 큐 (_roomWorkers보다 먼저 만들고 나중에 없앱니다).
+    std::vector<std::unique_ptr<SpscQueue<RoomChat>>> _roomResults;
+    /// 결과 큐를 더 비우지 않으면 true. 가득 찬 결과 큐 앞에서 기다리던 작업자가 포기하고 멈출 수 있게 합니다.
+    std::atomic<bool> _roomResultsClosed;
+    /// 채팅방 채팅을 채팅방별 작업자 스레드에서 처리하는 실행기 (nullptr이면 루프에서 바로 처리).
+    std::unique_ptr<RoomWorkers> _roomWorkers;
+    /// 작업자에 넘겼지만 아직 보내지 않은 채팅 수 (0보다 크면 select를 기다리지 않습니다).
+    std::size_t _roomInFlightCount;
+    /// 앞 순번을 기다리며 보류 중인 결과.
+    std::vector<RoomChat> _roomHeldResults;
+    /// 채팅방별로 마지막으로 보낸 작업자 순번.
+    std::unordered_map<std::string, std::uint64_t> _roomDeliveredSequences;
+    /// 채팅방 작업자의 치우침을 마지막으로 확인한 틱.
+    std::int64_t _lastRoomBalanceTick;
 
 private:
     /**
@@ -148,6 +503,27 @@ private:
      */
     bool handleNewConnection();
 
+    /**
+     * @fn int MultiServer::getBusyPollTimeoutMs(int blocking_timeout_ms)
+     * @brief 바쁜 폴링 모드에서 이번 select의 대기 시간을 정합니다.
+     * @param[IN] int blocking_timeout_ms : 블로킹으로 물러날 때 사용할 대기 시간.
+     * @return int : 회전/양보 구간이면 0, 물러날 때는 blocking_timeout_ms.
+     */
+    int getBusyPollTimeoutMs(int blocking_timeout_ms);
+
+    /**
+     * @fn bool MultiServer::drainReadable(int client_index)
+     * @brief 읽기 가능한 클라이언트 소켓을 READ_BUDGET_PER_CLIENT 횟수까지 읽어 처리합니다.
+     * @param[IN] int client_index : 클라이언트의 인덱스.
+     * @return bool : 계속 연결을 유지하면 true, HANDLER 모드에서 연결을 종료해야 하면 false.
+     *
+     * @details
+     * HANDLER 모드에서는 handleClientMessage()를, COROUTINE 모드에서는 세션 재개를 반복합니다.
+     * <br>매 회 수신 버퍼에 남은 데이터가 없으면 멈추고, 예산을 다 쓰고도 남았으면 다음 반복으로 이월합니다.
+     * <br>이로써 데이터를 많이 보내는 클라이언트가 한 반복을 독점하지 않고, 밀린 데이터도 한 번에 한 번씩만 읽히지 않습니다.
+     */
+    bool drainReadable(int client_index);
+
     /**
      * @fn bool MultiServer::handleClientMessage(int client_index)
      * @brief 지정된 인덱스의 클라이언트로부터 들어온 메시지를 처리합니다.
@@ -160,9 +536,31 @@ private:
      * <br>클라이언트가 quit 명령을 보내거나 연결이 끊어진 경우 적절히 처리합니다.
      * <br>외에 정상적인 메세지는 MessageSender를 통해 다른 클라이언트들에게 메시지를 전달합니다.
      * <br>함수가 false를 반환하면 해당 클라이언트를 제거해야 함을 의미합니다.
+     * <br>한 번의 수신에 여러 줄이 들어 있으면 handleClientLine()으로 한 줄씩 처리합니다.
      */
     bool handleClientMessage(int client_index);
 
+    /**
+     * @fn bool MultiServer::handleClientLine(int client_index, SOCKET client_socket, const std::string& message)
+     * @brief HANDLER 모드에서 수신한 한 줄을 명령 또는 채팅으로 처리합니다.
+     * @param[IN] int client_index : 줄을 보낸 클라이언트의 인덱스.
+     * @param[IN] SOCKET client_socket : 클라이언트 소켓.
+     * @param[IN] const std::string& message : 줄 끝 문자를 제거하고 UTF-8을 검증한 한 줄.
+     * @return bool : 연결을 유지하면 true, 종료해야 하면 false.
+     */
+    bool handleClientLine(int client_index, SOCKET client_socket, const std::string& message);
+
+    /**
+     * @fn bool MultiServer::handleCommand(int client_index, CommandParser::Command command, std::string_view arguments)
+     * @brief 두 세션 방식이 같이 쓰는 명령(접속자 목록, 위치, 근접 채팅, 상태)을 처리합니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] CommandParser::Command command : CommandParser::parse()로 가려낸 명령.
+     * @param[IN] std::string_view arguments : 명령 인자.
+     * @return bool : 처리했으면 true, 일반 채팅으로 보내야 하면 false.
+     * @note quit는 세션 방식마다 종료 절차가 달라 호출하는 쪽에서 처리합니다.
+     */
+    bool handleCommand(int client_index, CommandParser::Command command, std::string_view arguments);
+
     /**
      * @fn void MultiServer::sendWelcomeMessage(int client_index)
      * @brief 새로 연결된 클라이언트에게 환영 메시지를 보냅니다.
@@ -209,6 +607,387 @@ private:
      * === 채팅 서버에 오신 것을 환영합니다! ===
      * <br>현재 접속자 수: <connectedClientCount>명
      * <br>'quit'를 입력하면 종료됩니다.
+     * <br>'/users'를 입력하면 접속자 목록을 볼 수 있습니다.
+     * <br>'/say 메시지'를 입력하면 주변 플레이어에게만 말합니다.
      */
     std::string makeWecomeMessage(const std::string& nickname, int connectedClientCount);
+
+    /**
+     * @fn std::int64_t MultiServer::getNowTick() const
+     * @brief 이번 루프 반복의 시각을 밀리초 단위 틱으로 반환합니다. 시계를 다시 읽지 않습니다.
+     * @return std::int64_t : 현재 틱 (ClientManager의 마지막 활동 시각 등에 사용).
+     */
+    std::int64_t getNowTick() const;
+
+    /**
+     * @fn void MultiServer::flushOutbound()
+     * @brief 이번 반복에서 쌓인 송신 대기열을 전송하고 레인 깊이 지표를 갱신합니다.
+     * @return 없음.
+     *
+     * @details
+     * select로 대기하기 전에 매 반복 호출됩니다.
+     * <br>클라이언트별 대기 메시지 수를 ClientManager의 큐 깊이에 반영하고,
+     * <br>OUTBOUND_METRICS_INTERVAL_MS마다 레인별 전체 깊이와 버린 채팅 수를 로그로 남깁니다.
+     */
+    void flushOutbound();
+
+    /**
+     * @fn void MultiServer::sendUserList(int client_index)
+     * @brief 요청한 클라이언트에게 현재 접속자 목록을 텍스트로 보냅니다 ("/users" 명령).
+     * @param[IN] int client_index : 요청한 클라이언트의 인덱스.
+     * @return 없음.
+     */
+    void sendUserList(int client_index);
+
+    /**
+     * @fn void MultiServer::publishPresence()
+     * @brief 이번 틱의 접속자 목록 변경을 배포합니다.
+     * @return 없음.
+     *
+     * @details
+     * 서버 루프의 매 반복 시작 시 호출됩니다.
+     * <br>프레임은 "/roster"로 신청한(FLAG_PRESENCE) 접속자에게만 보냅니다. 나머지는 기존처럼 참가/퇴장 텍스트 알림만 받습니다.
+     * <br>변경이 있으면 하나의 델타 프레임을 만들어 이미 동기화된 접속자들에게만 보냅니다.
+     * <br>아직 동기화되지 않은 새 접속자에게는 델타 대신 현재 버전의 스냅샷을 한 번 보냅니다.
+     */
+    void publishPresence();
+
+    /**
+     * @fn void MultiServer::relayChatMessage(int client_index, const std::string& message)
+     * @brief 채팅 메시지에 채팅방 순번을 붙여 재전송 버퍼에 보관하고 모든 클라이언트에게 보냅니다. 클러스터 모드이면 채팅방 주인을 거쳐 보냅니다.
+     * @param[IN] int client_index : 메시지를 보낸 클라이언트의 인덱스.
+     * @param[IN] const std::string& message : 채팅 메시지.
+     * @return 없음.
+     * @note 전송 형식은 "#<순번> [닉네임]: 메시지"입니다. 채팅방 작업자를 켰으면 가리기는 작업자가 하고, 보내기는 drainRoomResults()가 합니다.
+     */
+    void relayChatMessage(int client_index, const std::string& message);
+
+    /**
+     * @fn static std::uint64_t MultiServer::makeRoomTag(int client_index, SOCKET client_socket, std::size_t message_offset)
+     * @brief 채팅방 작업자에 넘길 값을 만듭니다. (하위 16비트 : 슬롯, 다음 16비트 : 메시지 시작 위치, 상위 32비트 : 소켓 하위 32비트)
+     * @param[IN] int client_index : 보낸 클라이언트의 인덱스.
+     * @param[IN] SOCKET client_socket : 보낸 클라이언트의 소켓.
+     * @param[IN] std::size_t message_offset : 줄에서 메시지가 시작하는 위치 (닉네임 머리말 길이).
+     * @return std::uint64_t : 작업자에 넘길 값.
+     */
+    static std::uint64_t makeRoomTag(int client_index, SOCKET client_socket, std::size_t message_offset);
+
+    /**
+     * @fn int MultiServer::resolveRoomSender(std::uint64_t tag) const
+     * @brief 돌려받은 채팅의 보낸 슬롯을 구합니다.
+     * @param[IN] std::uint64_t tag : makeRoomTag()로 만든 값.
+     * @return int : 보낸 클라이언트의 인덱스, 그사이 연결이 끊겨 슬롯이 비었거나 다른 연결이 차지했으면 -1.
+     */
+    int resolveRoomSender(std::uint64_t tag) const;
+
+    /**
+     * @fn void MultiServer::handleRoomChat(int worker_index, RoomWorkers::Room& room, std::uint64_t tag, std::string& line)
+     * @brief 채팅방 작업자 스레드에서 채팅 한 줄의 금칙어를 가리고 결과 큐로 돌려줍니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @param[IN] RoomWorkers::Room& room : 채팅방 상태 (순번은 RoomWorkers가 올립니다).
+     * @param[IN] std::uint64_t tag : makeRoomTag()로 만든 값.
+     * @param[IN, OUT] std::string& line : "[닉네임]: 메시지" (결과로 옮겨 갑니다).
+     * @return 없음.
+     * @note 결과 큐가 가득 차면 루프가 비울 때까지 기다립니다.
+     */
+    void handleRoomChat(int worker_index, RoomWorkers::Room& room, std::uint64_t tag, std::string& line);
+
+    /**
+     * @fn void MultiServer::drainRoomResults()
+     * @brief 채팅방 작업자가 돌려준 채팅을 채팅방 순번대로 재전송 버퍼에 넣고 보냅니다. 클러스터 모드이면 채팅방 주인을 거쳐 보냅니다.
+     * @return 없음.
+     * @note 채팅방이 작업자를 옮기면 이전 주인의 결과가 다음 반복에야 보일 수 있으므로, 순번이 이어지지 않는 결과는 보류합니다.
+     */
+    void drainRoomResults();
+
+    /**
+     * @fn void MultiServer::maintainRoomWorkers()
+     * @brief 이동 중인 채팅방의 울타리를 넣고, 주기마다 치우침을 확인해 가장 바쁜 채팅방을 옮깁니다.
+     * @return 없음.
+     */
+    void maintainRoomWorkers();
+
+    /**
+     * @fn void MultiServer::handlePositionCommand(int client_index, std::string_view arguments)
+     * @brief 위치 갱신("/pos <x> <y> <z>") 명령을 처리합니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : "<x> <y> <z>".
+     * @return 없음.
+     * @note 격자에서 클라이언트의 위치만 옮기고 응답하지 않습니다. (게임 클라이언트가 주기적으로 보냅니다.)
+     */
+    void handlePositionCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn void MultiServer::handleSayCommand(int client_index, std::string_view arguments)
+     * @brief 근접 채팅("/say <메시지>") 명령을 처리합니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : 메시지.
+     * @return 없음.
+     * @note 보낸 클라이언트 주변 SAY_RADIUS 안의 접속자에게만 "(근처) [닉네임]: 메시지"로 전달합니다. 채팅방 순번과 재전송 버퍼에 포함되지 않습니다.
+     */
+    void handleSayCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn void MultiServer::handleIgnoreCommand(int client_index, std::string_view arguments)
+     * @brief 무시("/ignore <닉네임>") 명령을 처리합니다. 이미 무시 중이면 무시를 풉니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : 닉네임.
+     * @return 없음.
+     */
+    void handleIgnoreCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn void MultiServer::handleMuteCommand(int client_index, std::string_view arguments)
+     * @brief 채팅 금지("/mute <닉네임>") 명령을 처리합니다. 이미 금지 중이면 금지를 풉니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스 (운영자여야 합니다).
+     * @param[IN] std::string_view arguments : 닉네임.
+     * @return 없음.
+     */
+    void handleMuteCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn void MultiServer::handleModeratorCommand(int client_index, std::string_view arguments)
+     * @brief 운영자 권한("/mod <암호>") 명령을 처리합니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : 암호.
+     * @return 없음.
+     */
+    void handleModeratorCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn bool MultiServer::rejectMutedSender(int client_index)
+     * @brief 보낸 클라이언트가 채팅 금지 상태이면 알리고 true를 반환합니다. 줄을 만들기 전에 호출합니다.
+     * @param[IN] int client_index : 채팅을 보낸 클라이언트의 인덱스.
+     * @return bool : 금지 상태라서 채팅을 버려야 하면 true.
+     */
+    bool rejectMutedSender(int client_index);
+
+    /**
+     * @fn void MultiServer::recordTalker(int client_index, std::size_t bytes)
+     * @brief 받은 한 줄을 송신자의 IPv4 주소 기준으로 HeavyHitters에 기록합니다.
+     * @note 포트는 접속마다 바뀌므로 키에 넣지 않습니다. 같은 주소의 여러 세션은 하나로 합쳐 집계됩니다.
+     * <br>그래서 한 NAT 뒤의 여러 사용자나 같은 호스트(127.0.0.1)의 클라이언트도 송신자 하나로 보입니다.
+     * <br>서버는 AF_INET으로만 수락하므로 IPv6 클라이언트는 없습니다. 듀얼 스택으로 바꾸면 키도 바꿔야 합니다.
+     * @param[IN] int client_index : 줄을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::size_t bytes : 줄의 바이트 수.
+     * @return 없음.
+     */
+    void recordTalker(int client_index, std::size_t bytes);
+
+    /**
+     * @fn void MultiServer::handleTopCommand(int client_index, std::string_view arguments)
+     * @brief 최근 가장 많이 보낸 송신자 목록("/top [bytes]") 명령을 처리합니다. 운영자만 사용할 수 있습니다.
+     * @details 주소마다 추정치를 보여 주고, 그 주소로 지금 접속 중인 세션의 닉네임을 따로 덧붙입니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : "bytes"이면 바이트 기준, 없으면 줄 수 기준.
+     * @return 없음.
+     */
+    void handleTopCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn void MultiServer::handleRosterCommand(int client_index)
+     * @brief 접속자 목록 프레임 받기("/roster") 명령을 처리합니다. 이미 받고 있으면 끕니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @return 없음.
+     * @note 켜면 다음 publishPresence()에서 현재 버전의 스냅샷부터 받습니다.
+     */
+    void handleRosterCommand(int client_index);
+
+    /**
+     * @fn void MultiServer::handleReloadCommand(int client_index)
+     * @brief 금칙어 파일 다시 읽기("/reload") 명령을 처리합니다. 운영자만 사용할 수 있습니다.
+     * @param[IN] int client_index : 명령을 보낸 클라이언트의 인덱스.
+     * @return 없음.
+     * @note 파일을 열 수 없으면 기존 목록을 유지하고 운영자에게 알립니다.
+     */
+    void handleReloadCommand(int client_index);
+
+    /**
+     * @fn void MultiServer::handleDatagrams()
+     * @brief 대기 중인 UDP 데이터그램을 한 묶음 읽어 처리하고, 생긴 응답과 팬아웃을 한 번에 보냅니다.
+     * @return 없음.
+     */
+    void handleDatagrams();
+
+    /**
+     * @fn void MultiServer::pollGameBridge()
+     * @brief 게임 서버가 보낸 메시지를 BRIDGE_BATCH개까지 꺼내 모든 접속자에게 "[게임] 메시지"로 보냅니다.
+     * @return 없음.
+     * @note 링이 손상되면 브리지가 남은 내용을 버리고, MAX_BRIDGE_CORRUPTIONS번째에는 브리지를 닫습니다.
+     */
+    void pollGameBridge();
+
+    /**
+     * @fn void MultiServer::handleClusterTraffic()
+     * @brief 클러스터의 새 링크를 수락하고, 읽기 준비된 링크에서 받은 채팅방 프레임을 처리합니다.
+     * @return 없음.
+     *
+     * @details
+     * - PUBLISH : 이 노드가 주인이면 순번을 매기고, 아니면 주인에게 다시 넘깁니다.
+     * - SEQUENCED : 처음 보는 순번이면 재전송 버퍼에 보관하고 로컬 접속자에게 보냅니다.
+     * - HANDOFF : 이전 주인의 마지막 순번을 이어받고 쌓여 있던 채팅을 처리합니다.
+     */
+    void handleClusterTraffic();
+
+    /**
+     * @fn void MultiServer::publishChatLine(const std::string& room, const std::string& line, int hops, int sender_index)
+     * @brief 클러스터 모드에서 채팅 한 줄을 채팅방 주인에게 보냅니다. 이 노드가 주인이면 바로 순번을 매겨 모든 노드에 보냅니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] const std::string& line : "[닉네임]: 메시지" 형식의 채팅 한 줄.
+     * @param[IN] int hops : 지금까지 다른 노드를 거쳐 온 횟수 (로컬 채팅은 0).
+     * @param[IN] int sender_index : 보낸 로컬 클라이언트의 인덱스. 다른 노드에서 왔거나 넘겨받기 대기열에서 다시 꺼낸 줄은 -1.
+     * @return 없음.
+     * @note 주인이 넘겨받기를 기다리는 중이면 쌓아 두었다가 넘겨받은 뒤 처리합니다. 주인이 바뀐 직후의 로컬 채팅은 RoomDirectory::getRouteNode()가 고른 이전 주인을 거칩니다.
+     * <br>이 노드가 주인이면 sender_index로 무시 목록을 적용합니다. 다른 노드의 주인을 거쳐 돌아온 줄은 보낸 슬롯을 모르므로 적용하지 않습니다.
+     */
+    void publishChatLine(const std::string& room, const std::string& line, int hops, int sender_index);
+
+    /**
+     * @fn void MultiServer::updateRoomOwnership()
+     * @brief 살아 있는 노드로 채팅방 주인을 다시 계산합니다. 주인이 이 노드에서 떠난 채팅방은 HANDOFF를 보내고, 넘겨받기가 끝난 채팅방의 쌓인 채팅을 처리합니다.
+     * @return 없음.
+     */
+    void updateRoomOwnership();
+
+    /**
+     * @fn void MultiServer::handOffRooms()
+     * @brief 종료 전에 이 노드가 주인인 채팅방을 다음 주인에게 넘겨주고 링크의 남은 프레임을 보냅니다.
+     * @return 없음.
+     */
+    void handOffRooms();
+
+    /**
+     * @fn void MultiServer::deliverChatLine(std::uint64_t sequence, const std::string& line, int sender_index)
+     * @brief 재전송 버퍼에 보관된 채팅 한 줄을 순번과 함께 로컬 접속자와 게임 서버 브리지에 보냅니다.
+     * @param[IN] std::uint64_t sequence : 채팅방 순번.
+     * @param[IN] const std::string& line : "[닉네임]: 메시지" 형식의 채팅 한 줄.
+     * @param[IN] int sender_index : 보낸 로컬 클라이언트의 인덱스 (다른 노드에서 왔으면 -1).
+     * @return 없음.
+     * @note 보낸 사람을 무시하는 접속자는 받는 사람 집합에서 빠집니다.
+     */
+    void deliverChatLine(std::uint64_t sequence, const std::string& line, int sender_index);
+
+    /**
+     * @fn void MultiServer::handleDatagram(const DatagramChannelBase::Datagram& datagram)
+     * @brief 데이터그램 하나를 인증하고 종류에 따라 처리합니다.
+     * @param[IN] const DatagramChannelBase::Datagram& datagram : 수신한 데이터그램.
+     * @return 없음.
+     */
+    void handleDatagram(const DatagramChannelBase::Datagram& datagram);
+
+    /**
+     * @fn void MultiServer::announceDatagramChannel(int client_index, const std::string& token)
+     * @brief UDP 채널이 열려 있으면 클라이언트에게 UDP 포트와 데이터그램 인증 토큰을 보냅니다.
+     * @param[IN] int client_index : 클라이언트의 인덱스.
+     * @param[IN] const std::string& token : 세션 토큰.
+     * @return 없음.
+     * @note 전송 형식은 "[시스템] UDP <포트> <토큰>"입니다.
+     */
+    void announceDatagramChannel(int client_index, const std::string& token);
+
+    /**
+     * @fn void MultiServer::handleStatusCommand(int client_index, std::string_view arguments)
+     * @brief "/status <상태>" 명령으로 클라이언트의 상태 메시지를 바꿉니다.
+     * @param[IN] int client_index : 보낸 클라이언트의 인덱스.
+     * @param[IN] std::string_view arguments : 새 상태 (비어 있으면 "(없음)").
+     * @return 없음.
+     *
+     * @details
+     * 다른 접속자에게 "[상태] 닉네임: 상태"를 상태 메시지로 보냅니다. ("/status"만 보내면 "(없음)".)
+     * <br>상태는 다음 값이 오면 의미가 없으므로, 아직 보내지 못한 이전 상태는 새 상태로 덮어써집니다.
+     * <br>채팅방 순번과 재전송 버퍼에 포함되지 않습니다.
+     */
+    void handleStatusCommand(int client_index, std::string_view arguments);
+
+    /**
+     * @fn std::string MultiServer::makeSequencedMessage(std::uint64_t sequence, const std::string& line)
+     * @brief 메시지 앞에 순번을 붙입니다.
+     * @param[IN] std::uint64_t sequence : 채팅방 순번.
+     * @param[IN] const std::string& line : 메시지.
+     * @return std::string : "#<순번> <메시지>" 형식의 문자열.
+     */
+    std::string makeSequencedMessage(std::uint64_t sequence, const std::string& line);
+
+    /**
+     * @fn void MultiServer::issueResumeToken(int client_index)
+     * @brief 클라이언트에게 재접속 토큰과 현재 채팅방 순번을 보냅니다.
+     * @param[IN] int client_index : 클라이언트의 인덱스.
+     * @return 없음.
+     * @note 전송 형식은 "[시스템] RESUME <토큰> <순번>"이며, 재접속 시 "/resume <토큰> <마지막으로 받은 순번>"을 첫 줄로 보냅니다.
+     */
+    void issueResumeToken(int client_index);
+
+    /**
+     * @fn bool MultiServer::resumeSession(int client_index, std::string_view arguments, SessionContext<RecordingTransport<Transport>>& context)
+     * @brief "/resume <토큰> <순번>" 요청으로 일시 중단된 세션을 새 연결에 이어 붙입니다.
+     * @param[IN] int client_index : 새 연결의 클라이언트 인덱스.
+     * @param[IN] std::string_view arguments : 재접속 요청의 인자 ("<토큰> <순번>").
+     * @param[IN] SessionContext<RecordingTransport<Transport>>& context : 새 연결의 세션 컨텍스트 (남은 수신 데이터를 넘겨받습니다).
+     * @return bool : 이어 붙였으면 true, 요청 형식이 틀리거나 토큰이 유효하지 않으면 false.
+     *
+     * @details
+     * 새 연결의 소켓을 이전 세션의 슬롯으로 옮기므로 별칭과 접속자 목록 자리가 유지되고, 참가/퇴장 알림은 보내지 않습니다.
+     * <br>클라이언트가 마지막으로 받은 순번 이후의 메시지만 재전송 버퍼에서 보내고, 새 토큰을 발급한 뒤
+     * <br>이전 슬롯에서 chatSession()을 시작합니다. true를 반환하면 호출한 세션 코루틴은 바로 끝나야 합니다.
+     */
+    bool resumeSession(int client_index, std::string_view arguments, SessionContext<RecordingTransport<Transport>>& context);
+
+    /**
+     * @fn void MultiServer::suspendSession(int client_index)
+     * @brief 연결이 끊긴 세션을 퇴장 알림 없이 일시 중단 상태로 둡니다.
+     * @param[IN] int client_index : 클라이언트의 인덱스.
+     * @return 없음.
+     * @note RESUME_GRACE_MS 안에 재접속하지 않으면 expireSuspendedSessions()가 퇴장 처리합니다.
+     */
+    void suspendSession(int client_index);
+
+    /**
+     * @fn void MultiServer::expireSuspendedSessions()
+     * @brief 유예 시간이 지난 일시 중단 세션의 퇴장을 알리고 슬롯을 반환합니다.
+     * @return 없음.
+     */
+    void expireSuspendedSessions();
+
+    /**
+     * @fn Task<> MultiServer::runSession(int client_index, SessionContext<RecordingTransport<Transport>>& context)
+     * @brief 연결 하나의 전체 흐름(접속 절차, 채팅, 퇴장)을 수행하는 세션 코루틴입니다.
+     * @param[IN] int client_index : 세션의 클라이언트 인덱스.
+     * @param[IN] SessionContext<RecordingTransport<Transport>>& context : 세션의 입출력 컨텍스트.
+     * @return Task<> : 세션 코루틴.
+     *
+     * @details
+     * 첫 줄이 RESUME_WAIT_MS 안에 "/resume" 요청으로 오면 이전 세션을 이어 붙이고 끝납니다.
+     * <br>아니면 completeJoin()으로 접속 절차를 마친 뒤 chatSession()을 실행합니다.
+     * <br>종료된 세션은 루프가 reapFinishedSessions()로 정리합니다.
+     */
+    Task<> runSession(int client_index, SessionContext<RecordingTransport<Transport>>& context);
+
+    /**
+     * @fn Task<> MultiServer::chatSession(int client_index, SessionContext<RecordingTransport<Transport>>& context)
+     * @brief 접속 절차를 마친 세션의 채팅 루프입니다.
+     * @param[IN] int client_index : 세션의 클라이언트 인덱스.
+     * @param[IN] SessionContext<RecordingTransport<Transport>>& context : 세션의 입출력 컨텍스트.
+     * @return Task<> : 세션 코루틴.
+     *
+     * @details
+     * 한 줄씩 읽어 순번을 붙여 모든 클라이언트에게 전달합니다.
+     * <br>quit 명령 시 퇴장을 알리고 끝나며, 연결이 끊기면 재접속을 위해 일시 중단됩니다.
+     */
+    Task<> chatSession(int client_index, SessionContext<RecordingTransport<Transport>>& context);
+
+    /**
+     * @fn void MultiServer::completeJoin(int client_index)
+     * @brief 새 세션의 접속 절차(환영 메시지, 참가 알림, 접속자 목록 등록, 재접속 토큰 발급)를 수행합니다.
+     * @param[IN] int client_index : 세션의 클라이언트 인덱스.
+     * @return 없음.
+     * @note 클라이언트의 응답을 기다리지 않으므로 코루틴이 아닌 일반 함수입니다. 세션 코루틴이 채팅 루프 전에 호출합니다.
+     */
+    void completeJoin(int client_index);
+
+    /**
+     * @fn void MultiServer::reapFinishedSessions()
+     * @brief 종료된 세션 코루틴을 정리하고 클라이언트를 제거합니다.
+     * @return 없음.
+     */
+    void reapFinishedSessions();
 };
\ No newline at end of file
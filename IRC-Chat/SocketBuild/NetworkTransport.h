@@ -0,0 +1,209 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file NetworkTransport.h
+ * @brief 서버가 사용하는 소켓 호출을 추상화한 NetworkTransport 인터페이스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * TCPSocket, SelectManager, MessageSender, MessageReceiver, ClientManager는 WinSock 함수를 직접 부르지 않고
+ * <br>이 인터페이스를 통해 소켓을 다룹니다.
+ * <br>실제 서버는 WinSockTransport를, 결정적인 루프 측정은 SimulatedTransport를 사용합니다.
+ */
+
+#include <WinSock2.h>
+#include <chrono>
+
+/**
+ * @class NetworkTransport
+ * @brief 소켓 생성, 수락, 송수신, select, 시계를 제공하는 전송 계층 인터페이스입니다.
+ *
+ * @details
+ * 각 함수의 반환 규약은 대응하는 WinSock 함수와 같습니다.
+ * <br>(실패 시 SOCKET_ERROR 또는 INVALID_SOCKET을 반환하고, 오류 코드는 getLastError()로 얻습니다.)
+ * <br>따라서 호출하는 쪽의 오류 처리 코드는 WinSock을 직접 쓸 때와 동일합니다.
+ */
+class NetworkTransport
+{
+public:
+    /// 세션 타이머와 루프가 사용하는 단조 시계.
+    using Clock = std::chrono::steady_clock;
+
+public:
+    virtual ~NetworkTransport() {}
+
+    /**
+     * @fn SOCKET NetworkTransport::createSocket()
+     * @brief TCP 소켓을 생성합니다 (socket).
+     * @return SOCKET : 생성된 소켓, 실패 시 INVALID_SOCKET.
+     */
+    virtual SOCKET createSocket() = 0;
+
+    /**
+     * @fn int NetworkTransport::bindSocket(SOCKET socket, int port)
+     * @brief 소켓을 모든 인터페이스의 지정한 포트에 바인드합니다 (bind).
+     * @param[IN] SOCKET socket : 바인드할 소켓.
+     * @param[IN] int port : 포트 번호.
+     * @return int : 성공 시 0, 실패 시 SOCKET_ERROR.
+     */
+    virtual int bindSocket(SOCKET socket, int port) = 0;
+
+    /**
+     * @fn int NetworkTransport::listenSocket(SOCKET socket)
+     * @brief 소켓을 연결 대기 상태로 전환합니다 (listen).
+     * @param[IN] SOCKET socket : 리스닝 소켓.
+     * @return int : 성공 시 0, 실패 시 SOCKET_ERROR.
+     */
+    virtual int listenSocket(SOCKET socket) = 0;
+
+    /**
+     * @fn SOCKET NetworkTransport::acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr)
+     * @brief 대기 중인 연결 하나를 수락합니다 (accept).
+     * @param[IN] SOCKET listen_socket : 리스닝 소켓.
+     * @param[OUT] sockaddr_in* client_addr : 수락한 클라이언트의 주소.
+     * @return SOCKET : 클라이언트 소켓, 실패 시 INVALID_SOCKET.
+     * @note 수락한 소켓은 논블로킹입니다. 송신 버퍼가 가득 차면 sendBytes()가 WSAEWOULDBLOCK으로 실패합니다.
+     */
+    virtual SOCKET acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr) = 0;
+
+    /**
+     * @fn int NetworkTransport::connectSocket(SOCKET socket, const char* host, int port)
+     * @brief 원격 서버에 연결합니다 (connect).
+     * @param[IN] SOCKET socket : createSocket()으로 만든 소켓.
+     * @param[IN] const char* host : IPv4 주소 문자열 (예: "127.0.0.1").
+     * @param[IN] int port : 포트 번호.
+     * @return int : 성공 시 0, 실패 시 SOCKET_ERROR. (주소 형식이 잘못되면 WSAEINVAL.)
+     * @note 블로킹 호출입니다. 상대가 응답하지 않으면 연결 시간 초과까지 돌아오지 않으므로 서버 루프에서는 startConnect()를 사용합니다.
+     */
+    virtual int connectSocket(SOCKET socket, const char* host, int port) = 0;
+
+    /**
+     * @fn int NetworkTransport::startConnect(SOCKET socket, const char* host, int port)
+     * @brief 소켓을 논블로킹으로 바꾸고 원격 서버에 연결을 시작합니다 (ioctlsocket FIONBIO, connect).
+     * @param[IN] SOCKET socket : createSocket()으로 만든 소켓.
+     * @param[IN] const char* host : IPv4 주소 문자열 (예: "127.0.0.1").
+     * @param[IN] int port : 포트 번호.
+     * @return int : 바로 연결되면 0, 실패 시 SOCKET_ERROR. 연결이 진행 중이면 오류 코드가 WSAEWOULDBLOCK입니다.
+     * @note 진행 중인 연결은 selectSockets()의 write_set으로 끝나기를 기다린 뒤 getConnectResult()로 성공 여부를 확인합니다.
+     */
+    virtual int startConnect(SOCKET socket, const char* host, int port) = 0;
+
+    /**
+     * @fn int NetworkTransport::getConnectResult(SOCKET socket)
+     * @brief startConnect()로 시작한 연결의 결과를 확인합니다 (getsockopt SO_ERROR).
+     * @param[IN] SOCKET socket : 연결을 시작한 소켓.
+     * @return int : 연결되었으면 0, 실패했으면 오류 코드 (예: WSAECONNREFUSED).
+     */
+    virtual int getConnectResult(SOCKET socket) = 0;
+
+    /**
+     * @fn int NetworkTransport::sendBytes(SOCKET socket, const char* data, int length)
+     * @brief 데이터를 전송합니다 (send).
+     * @param[IN] SOCKET socket : 대상 소켓.
+     * @param[IN] const char* data : 보낼 데이터.
+     * @param[IN] int length : 보낼 바이트 수.
+     * @return int : 실제로 보낸 바이트 수(length보다 작을 수 있음), 실패 시 SOCKET_ERROR.
+     */
+    virtual int sendBytes(SOCKET socket, const char* data, int length) = 0;
+
+    /**
+     * @fn int NetworkTransport::receiveBytes(SOCKET socket, char* buffer, int length)
+     * @brief 데이터를 수신합니다 (recv).
+     * @param[IN] SOCKET socket : 대상 소켓.
+     * @param[OUT] char* buffer : 수신 데이터를 저장할 버퍼.
+     * @param[IN] int length : 버퍼 크기.
+     * @return int : 읽은 바이트 수, 연결 종료 시 0, 실패 시 SOCKET_ERROR.
+     */
+    virtual int receiveBytes(SOCKET socket, char* buffer, int length) = 0;
+
+    /**
+     * @fn int NetworkTransport::selectReadable(fd_set* read_set, int timeout_ms)
+     * @brief 읽기 준비된 소켓만 남도록 read_set을 갱신합니다 (select).
+     * @param[IN, OUT] fd_set* read_set : 감시할 소켓 집합. 반환 시 준비된 소켓만 남습니다.
+     * @param[IN] int timeout_ms : 최대 대기 시간(밀리초).
+     * @return int : 준비된 소켓 수, 타임아웃 시 0, 실패 시 SOCKET_ERROR.
+     */
+    virtual int selectReadable(fd_set* read_set, int timeout_ms) = 0;
+
+    /**
+     * @fn int NetworkTransport::selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms)
+     * @brief 읽기 준비된 소켓과 연결이 끝난 소켓만 남도록 두 집합을 갱신합니다 (select).
+     * @param[IN, OUT] fd_set* read_set : 읽기를 감시할 소켓 집합. 반환 시 준비된 소켓만 남습니다.
+     * @param[IN, OUT] fd_set* write_set : startConnect()가 진행 중인 소켓 집합. 반환 시 연결이 성공했거나 실패한 소켓만 남습니다.
+     * @param[IN] int timeout_ms : 최대 대기 시간(밀리초).
+     * @return int : 준비된 소켓 수, 타임아웃 시 0, 실패 시 SOCKET_ERROR.
+     * @note Windows는 실패한 연결을 예외 집합으로 알리므로, 구현은 그 소켓도 write_set에 남깁니다.
+     */
+    virtual int selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms) = 0;
+
+    /**
+     * @fn int NetworkTransport::getPendingBytes(SOCKET socket)
+     * @brief 소켓 수신 버퍼에 남아 있어 바로 읽을 수 있는 바이트 수를 반환합니다 (ioctlsocket FIONREAD).
+     * @param[IN] SOCKET socket : 확인할 소켓.
+     * @return int : 남은 바이트 수, 실패 시 SOCKET_ERROR.
+     * @note recv를 막히지 않고 더 호출할 수 있는지 판단할 때 사용합니다.
+     */
+    virtual int getPendingBytes(SOCKET socket) = 0;
+
+    /**
+     * @fn SOCKET NetworkTransport::createDatagramSocket()
+     * @brief 논블로킹 UDP 소켓을 생성합니다 (socket, ioctlsocket FIONBIO).
+     * @return SOCKET : 생성된 소켓, 실패 시 INVALID_SOCKET.
+     * @note 바인드는 bindSocket()을 그대로 사용합니다.
+     */
+    virtual SOCKET createDatagramSocket() = 0;
+
+    /**
+     * @fn int NetworkTransport::receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr)
+     * @brief 데이터그램 하나를 수신합니다 (recvfrom).
+     * @param[IN] SOCKET socket : UDP 소켓.
+     * @param[OUT] char* buffer : 수신 데이터를 저장할 버퍼.
+     * @param[IN] int length : 버퍼 크기.
+     * @param[OUT] sockaddr_in* from_addr : 보낸 쪽 주소.
+     * @return int : 데이터그램 크기, 실패 시 SOCKET_ERROR. (대기 중인 데이터그램이 없으면 WSAEWOULDBLOCK.)
+     */
+    virtual int receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr) = 0;
+
+    /**
+     * @fn int NetworkTransport::sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr)
+     * @brief 데이터그램 하나를 전송합니다 (sendto).
+     * @param[IN] SOCKET socket : UDP 소켓.
+     * @param[IN] const char* data : 보낼 데이터.
+     * @param[IN] int length : 보낼 바이트 수.
+     * @param[IN] const sockaddr_in& to_addr : 받을 쪽 주소.
+     * @return int : 보낸 바이트 수, 실패 시 SOCKET_ERROR. (송신 버퍼가 가득 차면 WSAEWOULDBLOCK.)
+     */
+    virtual int sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr) = 0;
+
+    /**
+     * @fn int NetworkTransport::closeSocket(SOCKET socket)
+     * @brief 소켓을 닫습니다 (closesocket).
+     * @param[IN] SOCKET socket : 닫을 소켓.
+     * @return int : 성공 시 0, 실패 시 SOCKET_ERROR.
+     */
+    virtual int closeSocket(SOCKET socket) = 0;
+
+    /**
+     * @fn int NetworkTransport::getLastError() const
+     * @brief 마지막 실패의 오류 코드를 반환합니다 (WSAGetLastError).
+     * @return int : 오류 코드.
+     */
+    virtual int getLastError() const = 0;
+
+    /**
+     * @fn NetworkTransport::Clock::time_point NetworkTransport::now() const
+     * @brief 전송 계층 기준의 현재 시각을 반환합니다.
+     * @return Clock::time_point : 현재 시각 (SimulatedTransport에서는 가상 시각).
+     */
+    virtual Clock::time_point now() const = 0;
+
+    /**
+     * @fn void NetworkTransport::sleepMillis(int timeout_ms)
+     * @brief 지정한 시간 동안 대기합니다 (Sleep).
+     * @param[IN] int timeout_ms : 대기 시간(밀리초).
+     * @return 없음.
+     */
+    virtual void sleepMillis(int timeout_ms) = 0;
+};
@@ -0,0 +1,119 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file NullTransport.h
+ * @brief 아무 일도 하지 않고 바로 성공하는 NullTransport 클래스를 정의합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 구성 요소가 전송 계층을 부르는 비용만 재기 위한 테스트 전용 구현입니다.
+ * <br>송신은 받은 바이트를 모두 보낸 것으로, 수신은 항상 WSAEWOULDBLOCK으로 돌려줍니다.
+ * <br>함수가 모두 헤더에 있으므로 final 타입으로 넘기면 호출이 인라인되고, NetworkTransport&로 넘기면 가상 호출만 남습니다.
+ * <br>TransportInstances.h가 CHAT_TEST_TRANSPORTS에서만 구성 요소를 이 타입으로 인스턴스화합니다.
+ */
+
+#include "NetworkTransport.h"
+
+/**
+ * @class NullTransport
+ * @brief 모든 소켓 호출이 상수를 돌려주는 NetworkTransport 구현입니다.
+ */
+class NullTransport final : public NetworkTransport
+{
+public:
+    SOCKET createSocket() override
+    {
+        return (1);
+    }
+
+    int bindSocket(SOCKET socket, int port) override
+    {
+        return (0);
+    }
+
+    int listenSocket(SOCKET socket) override
+    {
+        return (0);
+    }
+
+    SOCKET acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr) override
+    {
+        return (INVALID_SOCKET);
+    }
+
+    int connectSocket(SOCKET socket, const char* host, int port) override
+    {
+        return (0);
+    }
+
+    int startConnect(SOCKET socket, const char* host, int port) override
+    {
+        return (0);
+    }
+
+    int getConnectResult(SOCKET socket) override
+    {
+        return (0);
+    }
+
+    int sendBytes(SOCKET socket, const char* data, int length) override
+    {
+        return (length);
+    }
+
+    int receiveBytes(SOCKET socket, char* buffer, int length) override
+    {
+        return (SOCKET_ERROR);
+    }
+
+    int selectReadable(fd_set* read_set, int timeout_ms) override
+    {
+        return (0);
+    }
+
+    int selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms) override
+    {
+        return (0);
+    }
+
+    int getPendingBytes(SOCKET socket) override
+    {
+        return (0);
+    }
+
+    SOCKET createDatagramSocket() override
+    {
+        return (1);
+    }
+
+    int receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr) override
+    {
+        return (SOCKET_ERROR);
+    }
+
+    int sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr) override
+    {
+        return (length);
+    }
+
+    int closeSocket(SOCKET socket) override
+    {
+        return (0);
+    }
+
+    int getLastError() const override
+    {
+        return (WSAEWOULDBLOCK);
+    }
+
+    NetworkTransport::Clock::time_point now() const override
+    {
+        return (NetworkTransport::Clock::time_point());
+    }
+
+    void sleepMillis(int timeout_ms) override
+    {
+    }
+};
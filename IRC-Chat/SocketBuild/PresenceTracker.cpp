@@ -0,0 +1,288 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file PresenceTracker.cpp
+ * @brief PresenceTracker.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "PresenceTracker.h"
+#include "DebugHelper.h"
+
+PresenceTracker::PresenceTracker(int capacity)
+    : _current(capacity), _published(capacity), _synced(capacity, false), _dirty(capacity, false), _dirtyIndices(),
+      _version(0), _memberCount(0), _deltaFrame(), _snapshotFrame(), _snapshotVersion(0), _hasSnapshot(false)
+{
+    for (int i = 0; i < capacity; ++i)
+    {
+        this->_current[i].present = false;
+        this->_current[i].epoch = 0;
+        this->_published[i] = this->_current[i];
+    }
+    this->_dirtyIndices.reserve(capacity);
+    LOG_DEBUG("PresenceTracker 객체를 생성합니다.");
+}
+
+PresenceTracker::~PresenceTracker()
+{
+    LOG_DEBUG("PresenceTracker 객체를 삭제합니다.");
+}
+
+PresenceTracker::Result PresenceTracker::addMember(int index, const std::string& nickname)
+{
+    if (this->isValidIndex(index) == false)
+    {
+        return (PresenceTracker::Result::INVALID_INDEX);
+    }
+    if (this->_current[index].present)
+    {
+        return (PresenceTracker::Result::ALREADY_MEMBER);
+    }
+
+    Member& member = this->_current[index];
+    member.present = true;
+    member.epoch = member.epoch + 1;
+    member.nickname = nickname.substr(0, PresenceTracker::MAX_NICKNAME_LENGTH);
+    this->_memberCount = this->_memberCount + 1;
+
+    // 새 접속자는 스냅샷을 받기 전까지 델타를 받지 않습니다.
+    this->_synced[index] = false;
+    this->markDirty(index);
+    return (PresenceTracker::Result::SUCCESS);
+}
+
+PresenceTracker::Result PresenceTracker::updateMember(int index, const std::string& nickname)
+{
+    if (this->isValidIndex(index) == false)
+    {
+        return (PresenceTracker::Result::INVALID_INDEX);
+    }
+    if (this->_current[index].present == false)
+    {
+        return (PresenceTracker::Result::NOT_MEMBER);
+    }
+
+    this->_current[index].nickname = nickname.substr(0, PresenceTracker::MAX_NICKNAME_LENGTH);
+    this->markDirty(index);
+    return (PresenceTracker::Result::SUCCESS);
+}
+
+PresenceTracker::Result PresenceTracker::removeMember(int index)
+{
+    if (this->isValidIndex(index) == false)
+    {
+        return (PresenceTracker::Result::INVALID_INDEX);
+    }
+    if (this->_current[index].present == false)
+    {
+        return (PresenceTracker::Result::NOT_MEMBER);
+    }
+
+    this->_current[index].present = false;
+    this->_current[index].nickname.clear();
+    this->_memberCount = this->_memberCount - 1;
+    this->_synced[index] = false;
+    this->markDirty(index);
+    return (PresenceTracker::Result::SUCCESS);
+}
+
+bool PresenceTracker::flush()
+{
+    if (this->_dirtyIndices.empty())
+    {
+        return (false);
+    }
+
+    // 헤더의 항목 수는 마지막에 채웁니다.
+    std::string frame;
+    this->writeHeader(frame, PresenceTracker::DELTA_FRAME, 0);
+    std::uint16_t count = 0;
+
+    for (int index : this->_dirtyIndices)
+    {
+        const Member& before = this->_published[index];
+        const Member& after = this->_current[index];
+
+        if (before.present == false && after.present)
+        {
+            frame.push_back((char)PresenceTracker::DeltaType::ADDED);
+            PresenceTracker::writeEntry(frame, index, after.nickname);
+            count = count + 1;
+        }
+        else if (before.present && after.present == false)
+        {
+            frame.push_back((char)PresenceTracker::DeltaType::REMOVED);
+            PresenceTracker::writeEntry(frame, index, "");
+            count = count + 1;
+        }
+        else if (before.present && after.present && (before.epoch != after.epoch || before.nickname != after.nickname))
+        {
+            frame.push_back((char)PresenceTracker::DeltaType::CHANGED);
+            PresenceTracker::writeEntry(frame, index, after.nickname);
+            count = count + 1;
+        }
+        // 이외(같은 틱 안에서 추가 후 제거 등)는 서로 상쇄되어 보낼 것이 없습니다.
+
+        this->_published[index] = after;
+        this->_dirty[index] = false;
+    }
+    this->_dirtyIndices.clear();
+
+    if (count == 0)
+    {
+        return (false);
+    }
+
+    // 버전과 항목 수를 채웁니다.
+    this->_version = this->_version + 1;
+    std::string header;
+    this->writeHeader(header, PresenceTracker::DELTA_FRAME, count);
+    frame.replace(0, header.size(), header);
+    PresenceTracker::writeLength(frame);
+    this->_deltaFrame = std::move(frame);
+
+    LOG_DEBUG("접속자 목록 버전 " + std::to_string(this->_version) + " - 변경 " + std::to_string(count) + "건");
+    return (true);
+}
+
+const std::string& PresenceTracker::getDeltaFrame() const
+{
+    return (this->_deltaFrame);
+}
+
+const std::string& PresenceTracker::getSnapshotFrame()
+{
+    // 같은 버전의 스냅샷은 다시 인코딩하지 않습니다.
+    if (this->_hasSnapshot && this->_snapshotVersion == this->_version)
+    {
+        return (this->_snapshotFrame);
+    }
+
+    std::string frame;
+    std::uint16_t count = 0;
+    for (const Member& member : this->_published)
+    {
+        if (member.present)
+        {
+            count = count + 1;
+        }
+    }
+
+    this->writeHeader(frame, PresenceTracker::SNAPSHOT_FRAME, count);
+    for (int i = 0; i < (int)this->_published.size(); ++i)
+    {
+        if (this->_published[i].present)
+        {
+            PresenceTracker::writeEntry(frame, i, this->_published[i].nickname);
+        }
+    }
+    PresenceTracker::writeLength(frame);
+
+    this->_snapshotFrame = std::move(frame);
+    this->_snapshotVersion = this->_version;
+    this->_hasSnapshot = true;
+    return (this->_snapshotFrame);
+}
+
+bool PresenceTracker::isMember(int index) const
+{
+    return (this->isValidIndex(index) && this->_published[index].present);
+}
+
+bool PresenceTracker::isSynced(int index) const
+{
+    return (this->isValidIndex(index) && this->_synced[index]);
+}
+
+void PresenceTracker::markSynced(int index)
+{
+    if (this->isValidIndex(index))
+    {
+        this->_synced[index] = true;
+    }
+}
+
+void PresenceTracker::markUnsynced(int index)
+{
+    if (this->isValidIndex(index))
+    {
+        this->_synced[index] = false;
+    }
+}
+
+std::uint32_t PresenceTracker::getVersion() const
+{
+    return (this->_version);
+}
+
+int PresenceTracker::getMemberCount() const
+{
+    return (this->_memberCount);
+}
+
+std::string PresenceTracker::makeUserList() const
+{
+    std::string user_list = "[시스템] 접속자 목록 (" + std::to_string(this->_memberCount) + "명): ";
+
+    bool first = true;
+    for (const Member& member : this->_current)
+    {
+        if (member.present == false)
+        {
+            continue;
+        }
+        if (first == false)
+        {
+            user_list = user_list + ", ";
+        }
+        user_list = user_list + member.nickname;
+        first = false;
+    }
+
+    return (user_list);
+}
+
+bool PresenceTracker::isValidIndex(int index) const
+{
+    return (index >= 0 && index < (int)this->_current.size());
+}
+
+void PresenceTracker::markDirty(int index)
+{
+    if (this->_dirty[index] == false)
+    {
+        this->_dirty[index] = true;
+        this->_dirtyIndices.push_back(index);
+    }
+}
+
+void PresenceTracker::writeHeader(std::string& frame, char frame_type, std::uint16_t count) const
+{
+    frame.push_back(PresenceTracker::FRAME_MARKER);
+    frame.append(PresenceTracker::LENGTH_FIELD_SIZE, '\0');
+    frame.push_back(frame_type);
+    frame.push_back((char)((this->_version >> 24) & 0xFF));
+    frame.push_back((char)((this->_version >> 16) & 0xFF));
+    frame.push_back((char)((this->_version >> 8) & 0xFF));
+    frame.push_back((char)(this->_version & 0xFF));
+    frame.push_back((char)((count >> 8) & 0xFF));
+    frame.push_back((char)(count & 0xFF));
+}
+
+void PresenceTracker::writeLength(std::string& frame)
+{
+    std::uint32_t length = (std::uint32_t)(frame.size() - 1 - PresenceTracker::LENGTH_FIELD_SIZE);
+    frame[1] = (char)((length >> 24) & 0xFF);
+    frame[2] = (char)((length >> 16) & 0xFF);
+    frame[3] = (char)((length >> 8) & 0xFF);
+    frame[4] = (char)(length & 0xFF);
+}
+
+void PresenceTracker::writeEntry(std::string& frame, int index, const std::string& nickname)
+{
+    frame.push_back((char)((index >> 8) & 0xFF));
+    frame.push_back((char)(index & 0xFF));
+    frame.push_back((char)nickname.size());
+    frame.append(nickname);
+}
@@ -0,0 +1,297 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file PresenceTracker.h
+ * @brief 채팅방 접속자 목록을 버전 단위로 관리하는 PresenceTracker 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 접속자 목록의 현재 상태와 마지막으로 배포한 상태를 함께 보관합니다.
+ * <br>한 루프(틱) 동안 생긴 변경은 flush()에서 하나의 델타 프레임으로 합쳐지고 버전이 1 증가합니다.
+ * <br>새 참가자에게는 스냅샷 프레임을 한 번만 보내고, 기존 참가자에게는 델타 프레임만 보냅니다.
+ * <br>두 프레임 모두 버전당 한 번만 인코딩되므로 N명 방에서 한 명이 참가할 때 전송량은 O(N)입니다.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class PresenceTracker
+ * @brief 접속자 목록 스냅샷과 버전별 델타를 생성하는 클래스입니다.
+ *
+ * @details
+ * 프레임 형식 (정수는 빅 엔디언):
+ * - 공통 헤더 : [FRAME_MARKER 1][길이 4][종류 1 ('S' 또는 'D')][버전 4][항목 수 2]
+ * - 길이 : 길이 필드 다음부터 프레임 끝까지의 바이트 수. 닉네임이나 인덱스에 0x0A/0x0D가 들어 있어도 받는 쪽은 줄을 나누지 않고 이만큼 건너뜁니다.
+ * - 스냅샷 항목 : [인덱스 2][닉네임 길이 1][닉네임]
+ * - 델타 항목 : [DeltaType 1][인덱스 2][닉네임 길이 1][닉네임] (REMOVED는 닉네임 길이 0)
+ *
+ * 버전 v의 델타는 버전 v-1 상태에 적용됩니다.
+ * <br>프레임은 줄 단위 채팅 메시지와 구분되도록 FRAME_MARKER로 시작하며 개행을 붙이지 않습니다.
+ * <br>텍스트만 읽는 클라이언트가 깨지지 않도록 MultiServer는 "/roster"로 신청한 클라이언트에게만 프레임을 보냅니다.
+ */
+class PresenceTracker
+{
+public:
+    /// 프레임 시작 바이트 (STX).
+    static const char FRAME_MARKER = 0x02;
+
+    /// 스냅샷 프레임 종류 바이트.
+    static const char SNAPSHOT_FRAME = 'S';
+
+    /// 델타 프레임 종류 바이트.
+    static const char DELTA_FRAME = 'D';
+
+    /// FRAME_MARKER 뒤 길이 필드의 바이트 수.
+    static const std::size_t LENGTH_FIELD_SIZE = 4;
+
+    /// 프레임에 담을 수 있는 최대 닉네임 길이(바이트).
+    static const std::size_t MAX_NICKNAME_LENGTH = 255;
+
+    /**
+     * @enum PresenceTracker::Result
+     * @brief 접속자 목록 변경 요청의 결과 상태 값.
+     */
+    enum class Result
+    {
+        SUCCESS,            ///< 변경이 반영됨.
+        INVALID_INDEX,      ///< 인덱스가 범위를 벗어남.
+        ALREADY_MEMBER,     ///< 이미 목록에 있는 인덱스를 추가하려 함.
+        NOT_MEMBER          ///< 목록에 없는 인덱스를 변경/제거하려 함.
+    };
+
+    /**
+     * @enum PresenceTracker::DeltaType
+     * @brief 델타 항목의 종류.
+     */
+    enum class DeltaType : std::uint8_t
+    {
+        ADDED = 1,          ///< 새 접속자.
+        REMOVED = 2,        ///< 퇴장한 접속자.
+        CHANGED = 3         ///< 정보가 바뀌었거나 같은 슬롯에 다른 접속자가 들어옴.
+    };
+
+public:
+    /**
+     * @fn PresenceTracker::PresenceTracker(int capacity)
+     * @brief 지정한 슬롯 수를 가진 빈 접속자 목록을 생성합니다.
+     * @param[IN] int capacity : 최대 접속자 수 (클라이언트 인덱스 범위, 65535 이하).
+     * @return 없음.
+     */
+    explicit PresenceTracker(int capacity);
+
+    /**
+     * @fn PresenceTracker::~PresenceTracker()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~PresenceTracker();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    PresenceTracker(const PresenceTracker& obj) = delete;
+    PresenceTracker& operator=(const PresenceTracker& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    PresenceTracker(PresenceTracker&& obj) = delete;
+    PresenceTracker& operator=(PresenceTracker&& obj) = delete;
+
+public:
+    /**
+     * @fn PresenceTracker::Result PresenceTracker::addMember(int index, const std::string& nickname)
+     * @brief 접속자를 추가합니다. 추가된 접속자는 스냅샷을 받기 전까지 동기화되지 않은 상태입니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[IN] const std::string& nickname : 닉네임 (MAX_NICKNAME_LENGTH를 넘으면 잘립니다).
+     * @return PresenceTracker::Result : 처리 결과.
+     */
+    PresenceTracker::Result addMember(int index, const std::string& nickname);
+
+    /**
+     * @fn PresenceTracker::Result PresenceTracker::updateMember(int index, const std::string& nickname)
+     * @brief 접속자의 닉네임을 변경합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[IN] const std::string& nickname : 새 닉네임.
+     * @return PresenceTracker::Result : 처리 결과.
+     */
+    PresenceTracker::Result updateMember(int index, const std::string& nickname);
+
+    /**
+     * @fn PresenceTracker::Result PresenceTracker::removeMember(int index)
+     * @brief 접속자를 제거합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return PresenceTracker::Result : 처리 결과.
+     */
+    PresenceTracker::Result removeMember(int index);
+
+    /**
+     * @fn bool PresenceTracker::flush()
+     * @brief 이번 틱의 변경을 하나의 델타로 합쳐 새 버전을 만듭니다.
+     * @return bool : 새 버전이 만들어졌으면 true, 배포할 변경이 없으면 false.
+     *
+     * @details
+     * 같은 틱 안에서 추가 후 제거된 접속자처럼 서로 상쇄되는 변경은 델타에 포함되지 않습니다.
+     * <br>true를 반환하면 getDeltaFrame()이 새 델타 프레임을 반환합니다.
+     */
+    bool flush();
+
+    /**
+     * @fn const std::string& PresenceTracker::getDeltaFrame() const
+     * @brief 마지막 flush()로 만든 델타 프레임을 반환합니다.
+     * @return const std::string& : 델타 프레임.
+     */
+    const std::string& getDeltaFrame() const;
+
+    /**
+     * @fn const std::string& PresenceTracker::getSnapshotFrame()
+     * @brief 현재 버전의 스냅샷 프레임을 반환합니다.
+     * @return const std::string& : 스냅샷 프레임.
+     * @note 버전이 바뀐 뒤 처음 호출될 때만 인코딩하고, 이후에는 캐시를 반환합니다.
+     */
+    const std::string& getSnapshotFrame();
+
+    /**
+     * @fn bool PresenceTracker::isMember(int index) const
+     * @brief 인덱스가 배포된(마지막 버전) 접속자 목록에 있는지 확인합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return bool : 목록에 있으면 true.
+     */
+    bool isMember(int index) const;
+
+    /**
+     * @fn bool PresenceTracker::isSynced(int index) const
+     * @brief 접속자가 스냅샷을 받아 델타를 받을 수 있는 상태인지 확인합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return bool : 동기화되었으면 true.
+     */
+    bool isSynced(int index) const;
+
+    /**
+     * @fn void PresenceTracker::markSynced(int index)
+     * @brief 접속자가 스냅샷을 받았음을 기록합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void markSynced(int index);
+
+    /**
+     * @fn void PresenceTracker::markUnsynced(int index)
+     * @brief 접속자가 다음 틱에 스냅샷을 다시 받도록 합니다 (재접속 등으로 델타를 놓친 경우).
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void markUnsynced(int index);
+
+    /**
+     * @fn std::uint32_t PresenceTracker::getVersion() const
+     * @brief 마지막으로 배포된 버전을 반환합니다.
+     * @return std::uint32_t : 버전 (처음에는 0).
+     */
+    std::uint32_t getVersion() const;
+
+    /**
+     * @fn int PresenceTracker::getMemberCount() const
+     * @brief 현재 접속자 수를 반환합니다.
+     * @return int : 접속자 수.
+     */
+    int getMemberCount() const;
+
+    /**
+     * @fn std::string PresenceTracker::makeUserList() const
+     * @brief 사람이 읽을 수 있는 접속자 목록 문자열을 만듭니다.
+     * @return std::string : "[시스템] 접속자 목록 (N명): A, B, ..." 형식의 문자열.
+     */
+    std::string makeUserList() const;
+
+private:
+    /**
+     * @struct PresenceTracker::Member
+     * @brief 슬롯 하나의 접속자 정보.
+     */
+    struct Member
+    {
+        bool present;           ///< 슬롯에 접속자가 있는지 여부.
+        std::uint32_t epoch;    ///< 슬롯에 새 접속자가 들어올 때마다 증가하는 값.
+        std::string nickname;   ///< 닉네임.
+    };
+
+private:
+    /// 현재 접속자 상태.
+    std::vector<Member> _current;
+
+    /// 마지막 버전으로 배포된 접속자 상태.
+    std::vector<Member> _published;
+
+    /// 스냅샷을 받은 접속자 여부.
+    std::vector<bool> _synced;
+
+    /// 이번 틱에 변경된 슬롯 여부.
+    std::vector<bool> _dirty;
+
+    /// 이번 틱에 변경된 슬롯 목록 (중복 없음).
+    std::vector<int> _dirtyIndices;
+
+    /// 마지막으로 배포된 버전.
+    std::uint32_t _version;
+
+    /// 현재 접속자 수.
+    int _memberCount;
+
+    /// 마지막 flush()로 만든 델타 프레임.
+    std::string _deltaFrame;
+
+    /// 캐시된 스냅샷 프레임.
+    std::string _snapshotFrame;
+
+    /// _snapshotFrame이 인코딩된 버전.
+    std::uint32_t _snapshotVersion;
+
+    /// _snapshotFrame이 한 번이라도 인코딩되었는지 여부.
+    bool _hasSnapshot;
+
+private:
+    /**
+     * @fn bool PresenceTracker::isValidIndex(int index) const
+     * @brief 인덱스가 슬롯 범위 안인지 확인합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return bool : 범위 안이면 true.
+     */
+    bool isValidIndex(int index) const;
+
+    /**
+     * @fn void PresenceTracker::markDirty(int index)
+     * @brief 슬롯을 이번 틱의 변경 목록에 추가합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void markDirty(int index);
+
+    /**
+     * @fn void PresenceTracker::writeHeader(std::string& frame, char frame_type, std::uint16_t count) const
+     * @brief 프레임 공통 헤더를 씁니다. 길이 필드는 0으로 두고 writeLength()에서 채웁니다.
+     * @param[OUT] std::string& frame : 헤더를 쓸 버퍼.
+     * @param[IN] char frame_type : SNAPSHOT_FRAME 또는 DELTA_FRAME.
+     * @param[IN] std::uint16_t count : 항목 수.
+     * @return 없음.
+     */
+    void writeHeader(std::string& frame, char frame_type, std::uint16_t count) const;
+
+    /**
+     * @fn static void PresenceTracker::writeLength(std::string& frame)
+     * @brief 완성된 프레임의 길이 필드를 채웁니다.
+     * @param[IN, OUT] std::string& frame : 헤더와 항목을 모두 쓴 프레임.
+     * @return 없음.
+     */
+    static void writeLength(std::string& frame);
+
+    /**
+     * @fn static void PresenceTracker::writeEntry(std::string& frame, int index, const std::string& nickname)
+     * @brief [인덱스][닉네임 길이][닉네임] 항목을 씁니다.
+     * @param[OUT] std::string& frame : 항목을 쓸 버퍼.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[IN] const std::string& nickname : 닉네임 (빈 문자열 가능).
+     * @return 없음.
+     */
+    static void writeEntry(std::string& frame, int index, const std::string& nickname);
+};
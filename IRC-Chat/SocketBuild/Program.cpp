@@ -11,8 +11,8 @@
 #include "Program.h"
 #include "DebugHelper.h"
 
-Program::Program()
-    : _socketIniter(), _multiServer(Program::SERVER_PORT)
+Program::Program(const ServerConfig& config)
+    : _socketIniter(), _transport(), _multiServer(config.getPort(), _transport, config.getSessionMode()), _config(config)
 {
     LOG_INFO("Select 기반 멀티클라이언트 서버 프로그램을 시작합니다.");
 }
@@ -59,8 +59,52 @@ Program::Result Program::initialize()
 
 Program::Result Program::startMultiServer()
 {
+    // 설정에 켜진 선택 기능을 적용합니다.
+    if (this->_config.isBusyPollEnabled())
+    {
+        this->_multiServer.enableBusyPoll(this->_config.getPinnedCore());
+    }
+    if (this->_config.getFanoutWorkerCount() > 0)
+    {
+        this->_multiServer.enableParallelFanout(this->_config.getFanoutWorkerCount());
+    }
+    if (this->_config.getRoomWorkerCount() > 0)
+    {
+        this->_multiServer.enableRoomWorkers(this->_config.getRoomWorkerCount());
+    }
+    if (this->_config.isDatagramChannelEnabled())
+    {
+        this->_multiServer.enableDatagramChannel();
+    }
+    if (this->_config.getGameBridgeName().empty() == false)
+    {
+        this->_multiServer.enableGameBridge(this->_config.getGameBridgeName());
+    }
+    if (this->_config.getClusterPort() > 0)
+    {
+        this->_multiServer.enableCluster(this->_config.getClusterPort());
+        for (const ServerConfig::ClusterPeer& peer : this->_config.getClusterPeers())
+        {
+            this->_multiServer.addClusterPeer(peer.host, peer.port);
+        }
+    }
+    else if (this->_config.getClusterPeers().empty() == false)
+    {
+        LOG_WARN("cluster_port가 없어 cluster_peer 설정을 무시합니다.");
+    }
+    if (this->_config.getModeratorPassword().empty() == false)
+    {
+        this->_multiServer.setModeratorPassword(this->_config.getModeratorPassword());
+    }
+    if (this->_config.getChatFilterFile().empty() == false
+        && this->_multiServer.setChatFilterFile(this->_config.getChatFilterFile()) == false)
+    {
+        LOG_ERROR("금칙어 파일을 열 수 없습니다: " + this->_config.getChatFilterFile());
+        return (Program::Result::FAIL);
+    }
+
     // 멀티클라이언트 서버를 부팅하고 소켓을 listen 대기로 합니다.
-    if (this->_multiServer.startServer() != MultiServer::Result::SUCCESS)
+    if (this->_multiServer.startServer() != MultiServerBase::Result::SUCCESS)
     {
         LOG_ERROR("멀티클라이언트 서버 시작에 실패했습니다.");
         return (Program::Result::FAIL);
@@ -73,21 +117,21 @@ Program::Result Program::startMultiServer()
 void Program::runServerLoop()
 {
     LOG_INFO("멀티클라이언트 서버 메인 루프를 시작합니다.");
-    LOG_INFO("최대 " + std::to_string(ClientManager::MAX_CLIENTS) + "명의 클라이언트가 동시 접속 가능합니다.");
+    LOG_INFO("최대 " + std::to_string(ClientManagerBase::MAX_CLIENTS) + "명의 클라이언트가 동시 접속 가능합니다.");
 
     // 멀티 서버 메인 루프 실행
-    MultiServer::Result result = this->_multiServer.runServerLoop();
+    MultiServerBase::Result result = this->_multiServer.runServerLoop();
 
     // 결과에 따른 로그 출력
     switch (result)
     {
-    case MultiServer::Result::SUCCESS:
+    case MultiServerBase::Result::SUCCESS:
         LOG_INFO("멀티클라이언트 서버가 정상적으로 종료되었습니다.");
         break;
-    case MultiServer::Result::FAIL_LOOP:
+    case MultiServerBase::Result::FAIL_LOOP:
         LOG_ERROR("서버 루프 실행 중 오류가 발생했습니다.");
         break;
-    case MultiServer::Result::SERVER_STOPPED:
+    case MultiServerBase::Result::SERVER_STOPPED:
         LOG_INFO("서버가 사용자 요청에 의해 중지되었습니다.");
         break;
     default:
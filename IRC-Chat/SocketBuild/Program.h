@@ -14,7 +14,9 @@
  */
 
 #include "SocketIniter.h"
+#include "WinSockTransport.h"
 #include "MultiServer.h"
+#include "ServerConfig.h"
 
 /**
  * @class Program
@@ -40,14 +42,16 @@ class Program
 
 public:
 	/**
-	 * @fn Program::Program()
+	 * @fn Program::Program(const ServerConfig& config)
 	 * @brief Program 객체를 생성하고 하위 구성 요소를 초기화합니다.
+	 * @param[IN] const ServerConfig& config : 설정 파일과 명령줄 인자에서 읽은 실행 옵션.
 	 * @return 없음.
 	 *
 	 * @details
-	 * SocketIniter(WinSock 초기화 담당)와 MultiServer를 초기화합니다.
+	 * SocketIniter(WinSock 초기화 담당), WinSockTransport와 MultiServer를 초기화합니다.
+	 * <br>MultiServer는 설정의 포트와 세션 실행 방식(기본값 COROUTINE)으로 만듭니다.
 	 */
-	Program();
+	explicit Program(const ServerConfig& config);
 
 	/**
 	 * @fn Program::~Program()
@@ -86,11 +90,14 @@ private:
 	/// WinSock(Windows Sockets API)의 초기화와 정리를 담당하는 객체.
 	SocketIniter _socketIniter;
 
-	/// 클라이언트 연결과 메시지를 처리하는 다중 클라이언트 서버 객체.
-	MultiServer _multiServer;
+	/// 서버가 사용하는 WinSock 전송 계층 (_multiServer보다 먼저 생성되어야 합니다).
+	WinSockTransport _transport;
 
-	/// 서버가 사용할 TCP 포트 번호 (기본값: 5500).
-	static const int SERVER_PORT = 5500;
+	/// 클라이언트 연결과 메시지를 처리하는 다중 클라이언트 서버 객체. 전송 계층 타입을 WinSockTransport로 고정해 루프의 소켓 호출을 직접 호출로 묶습니다.
+	MultiServer<WinSockTransport> _multiServer;
+
+	/// 실행 옵션. startMultiServer()에서 MultiServer에 적용합니다.
+	ServerConfig _config;
 
 private:
 	/**
@@ -110,7 +117,7 @@ private:
 	 * @return Program::Result : 서버 시작에 성공하면 SUCCESS, 서버 시작 실패 시 FAIL.
 	 *
 	 * @details
-	 * SERVER_PORT로 MultiServer를 초기화합니다.
+	 * 설정에 켜진 선택 기능을 MultiServer에 적용합니다.
 	 * <br>MultiServer::startServer()를 호출합니다. 
 	 * <br>서버가 클라이언트의 접속을 받을 준비를 마칩니다.
 	 */
@@ -0,0 +1,179 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file RecordingTransport.cpp
+ * @brief RecordingTransport.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "RecordingTransport.h"
+#include "DebugHelper.h"
+#include "TransportInstances.h"
+
+template <typename Inner>
+RecordingTransport<Inner>::RecordingTransport(Inner& inner, FlightRecorder& recorder)
+    : _inner(inner), _recorder(recorder)
+{
+    LOG_DEBUG("RecordingTransport 객체를 생성합니다.");
+}
+
+template <typename Inner>
+RecordingTransport<Inner>::~RecordingTransport()
+{
+    LOG_DEBUG("RecordingTransport 객체를 삭제합니다.");
+}
+
+template <typename Inner>
+SOCKET RecordingTransport<Inner>::createSocket()
+{
+    return (this->_inner.createSocket());
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::bindSocket(SOCKET socket, int port)
+{
+    return (this->_inner.bindSocket(socket, port));
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::listenSocket(SOCKET socket)
+{
+    return (this->_inner.listenSocket(socket));
+}
+
+template <typename Inner>
+SOCKET RecordingTransport<Inner>::acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    SOCKET client_socket = this->_inner.acceptSocket(listen_socket, client_addr);
+    this->_recorder.record(FlightRecorder::EventType::ACCEPT, client_socket, 0, begin, this->_inner.now());
+    return (client_socket);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::connectSocket(SOCKET socket, const char* host, int port)
+{
+    return (this->_inner.connectSocket(socket, host, port));
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::startConnect(SOCKET socket, const char* host, int port)
+{
+    return (this->_inner.startConnect(socket, host, port));
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::getConnectResult(SOCKET socket)
+{
+    return (this->_inner.getConnectResult(socket));
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::sendBytes(SOCKET socket, const char* data, int length)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int send_result = this->_inner.sendBytes(socket, data, length);
+    this->_recorder.record(FlightRecorder::EventType::SEND, socket, send_result, begin, this->_inner.now());
+    return (send_result);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::receiveBytes(SOCKET socket, char* buffer, int length)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int receive_result = this->_inner.receiveBytes(socket, buffer, length);
+    this->_recorder.record(FlightRecorder::EventType::RECV, socket, receive_result, begin, this->_inner.now());
+    return (receive_result);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::selectReadable(fd_set* read_set, int timeout_ms)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int ready_count = this->_inner.selectReadable(read_set, timeout_ms);
+
+    // 바쁜 폴링의 빈 0ms 폴링은 기록하지 않아 최근 활동이 밀려나지 않게 합니다.
+    if (ready_count != 0 || timeout_ms > 0)
+    {
+        this->_recorder.record(FlightRecorder::EventType::SELECT, INVALID_SOCKET, ready_count, begin, this->_inner.now());
+    }
+    return (ready_count);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int ready_count = this->_inner.selectSockets(read_set, write_set, timeout_ms);
+
+    if (ready_count != 0 || timeout_ms > 0)
+    {
+        this->_recorder.record(FlightRecorder::EventType::SELECT, INVALID_SOCKET, ready_count, begin, this->_inner.now());
+    }
+    return (ready_count);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::getPendingBytes(SOCKET socket)
+{
+    return (this->_inner.getPendingBytes(socket));
+}
+
+template <typename Inner>
+SOCKET RecordingTransport<Inner>::createDatagramSocket()
+{
+    return (this->_inner.createDatagramSocket());
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int receive_result = this->_inner.receiveDatagram(socket, buffer, length, from_addr);
+    this->_recorder.record(FlightRecorder::EventType::RECV, socket, receive_result, begin, this->_inner.now());
+    return (receive_result);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int send_result = this->_inner.sendDatagram(socket, data, length, to_addr);
+    this->_recorder.record(FlightRecorder::EventType::SEND, socket, send_result, begin, this->_inner.now());
+    return (send_result);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::closeSocket(SOCKET socket)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    int close_result = this->_inner.closeSocket(socket);
+    this->_recorder.record(FlightRecorder::EventType::CLOSE, socket, close_result, begin, this->_inner.now());
+    return (close_result);
+}
+
+template <typename Inner>
+int RecordingTransport<Inner>::getLastError() const
+{
+    return (this->_inner.getLastError());
+}
+
+template <typename Inner>
+NetworkTransport::Clock::time_point RecordingTransport<Inner>::now() const
+{
+    return (this->_inner.now());
+}
+
+template <typename Inner>
+void RecordingTransport<Inner>::sleepMillis(int timeout_ms)
+{
+    NetworkTransport::Clock::time_point begin = this->_inner.now();
+    this->_inner.sleepMillis(timeout_ms);
+    if (timeout_ms > 0)
+    {
+        this->_recorder.record(FlightRecorder::EventType::SLEEP, INVALID_SOCKET, timeout_ms, begin, this->_inner.now());
+    }
+}
+
+INSTANTIATE_SERVER_TRANSPORTS(RecordingTransport);
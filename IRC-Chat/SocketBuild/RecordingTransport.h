@@ -0,0 +1,81 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file RecordingTransport.h
+ * @brief 다른 전송 계층을 감싸 소켓 호출을 FlightRecorder에 기록하는 RecordingTransport 클래스 템플릿을 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 각 함수는 감싼 전송 계층의 같은 함수를 그대로 호출하고, 호출 전후 시각과 결과를 기록기에 남깁니다.
+ * <br>서버 코드는 어떤 전송 계층이든 이 클래스로 감싸기만 하면 되므로 송수신 지점마다 기록 코드를 넣지 않아도 됩니다.
+ * <br>감싼 전송 계층은 템플릿 인자로 받습니다. 인자가 final 타입이면 감싼 호출도 가상 호출 없이 묶입니다.
+ */
+
+#include "NetworkTransport.h"
+#include "FlightRecorder.h"
+
+/**
+ * @class RecordingTransport
+ * @brief 소켓 호출의 크기와 소요 시간을 FlightRecorder에 남기는 NetworkTransport 데코레이터입니다.
+ * @tparam Inner : 감쌀 전송 계층 타입 (NetworkTransport이면 감싼 호출은 가상 호출입니다).
+ *
+ * @note 시각은 감싼 전송 계층의 now()를 사용하므로 SimulatedTransport와 함께 쓰면 가상 시계 기준으로 기록됩니다.
+ * <br>정의는 RecordingTransport.cpp에 있으며 TransportInstances.h의 조합으로만 인스턴스화합니다.
+ */
+template <typename Inner>
+class RecordingTransport final : public NetworkTransport
+{
+public:
+    /**
+     * @fn RecordingTransport::RecordingTransport(Inner& inner, FlightRecorder& recorder)
+     * @brief 전송 계층과 기록기를 연결합니다.
+     * @param[IN] Inner& inner : 실제 호출을 수행할 전송 계층.
+     * @param[IN] FlightRecorder& recorder : 이벤트를 남길 기록기.
+     * @return 없음.
+     */
+    RecordingTransport(Inner& inner, FlightRecorder& recorder);
+
+    /**
+     * @fn RecordingTransport::~RecordingTransport()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~RecordingTransport() override;
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    RecordingTransport(const RecordingTransport& obj) = delete;
+    RecordingTransport& operator=(const RecordingTransport& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    RecordingTransport(RecordingTransport&& obj) = delete;
+    RecordingTransport& operator=(RecordingTransport&& obj) = delete;
+
+public:
+    SOCKET createSocket() override;
+    int bindSocket(SOCKET socket, int port) override;
+    int listenSocket(SOCKET socket) override;
+    SOCKET acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr) override;
+    int connectSocket(SOCKET socket, const char* host, int port) override;
+    int startConnect(SOCKET socket, const char* host, int port) override;
+    int getConnectResult(SOCKET socket) override;
+    int sendBytes(SOCKET socket, const char* data, int length) override;
+    int receiveBytes(SOCKET socket, char* buffer, int length) override;
+    int selectReadable(fd_set* read_set, int timeout_ms) override;
+    int selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms) override;
+    int getPendingBytes(SOCKET socket) override;
+    SOCKET createDatagramSocket() override;
+    int receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr) override;
+    int sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr) override;
+    int closeSocket(SOCKET socket) override;
+    int getLastError() const override;
+    NetworkTransport::Clock::time_point now() const override;
+    void sleepMillis(int timeout_ms) override;
+
+private:
+    /// 실제 호출을 수행하는 전송 계층.
+    Inner& _inner;
+    /// 이벤트를 남길 기록기.
+    FlightRecorder& _recorder;
+};
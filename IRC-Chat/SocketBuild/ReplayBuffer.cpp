@@ -0,0 +1,98 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ReplayBuffer.cpp
+ * @brief ReplayBuffer.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "ReplayBuffer.h"
+#include "DebugHelper.h"
+
+ReplayBuffer::ReplayBuffer(int capacity)
+    : _entries(capacity), _head(0), _count(0), _lastSequence(0)
+{
+    LOG_DEBUG("ReplayBuffer 객체를 생성합니다.");
+}
+
+ReplayBuffer::~ReplayBuffer()
+{
+    LOG_DEBUG("ReplayBuffer 객체를 삭제합니다.");
+}
+
+std::uint64_t ReplayBuffer::append(const std::string& line, std::time_t wall_seconds)
+{
+    this->_lastSequence = this->_lastSequence + 1;
+
+    // 가득 찼다면 가장 오래된 메시지 자리를 덮어씁니다.
+    ReplayBuffer::Entry& entry = this->_entries[this->_head];
+    entry.sequence = this->_lastSequence;
+    entry.line = line;
+    entry.wallSeconds = wall_seconds;
+
+    this->_head = (this->_head + 1) % (int)this->_entries.size();
+    if (this->_count < (int)this->_entries.size())
+    {
+        this->_count = this->_count + 1;
+    }
+
+    return (this->_lastSequence);
+}
+
+bool ReplayBuffer::appendAt(std::uint64_t sequence, const std::string& line, std::time_t wall_seconds)
+{
+    if (sequence <= this->_lastSequence)
+    {
+        return (false);
+    }
+
+    // 건너뛴 순번은 채울 수 없으므로 그 앞의 메시지는 재접속 시 TRUNCATED로 처리되게 합니다.
+    if (sequence != this->_lastSequence + 1)
+    {
+        this->_count = 0;
+    }
+
+    this->_lastSequence = sequence - 1;
+    this->append(line, wall_seconds);
+    return (true);
+}
+
+ReplayBuffer::Result ReplayBuffer::collectSince(std::uint64_t last_sequence, std::vector<const ReplayBuffer::Entry*>& entries) const
+{
+    entries.clear();
+
+    if (last_sequence > this->_lastSequence)
+    {
+        return (ReplayBuffer::Result::INVALID_SEQUENCE);
+    }
+
+    // 보관 중인 가장 오래된 메시지의 순번.
+    std::uint64_t oldest_sequence = this->_lastSequence - this->_count + 1;
+    std::uint64_t first_sequence = last_sequence + 1;
+    ReplayBuffer::Result result = ReplayBuffer::Result::COMPLETE;
+    if (first_sequence < oldest_sequence)
+    {
+        first_sequence = oldest_sequence;
+        result = ReplayBuffer::Result::TRUNCATED;
+    }
+
+    // 순번은 연속이므로 시작 위치를 바로 계산할 수 있습니다.
+    int missing_count = (int)(this->_lastSequence - first_sequence + 1);
+    int capacity = (int)this->_entries.size();
+    int position = (this->_head - missing_count + capacity) % capacity;
+
+    entries.reserve(missing_count);
+    for (int i = 0; i < missing_count; ++i)
+    {
+        entries.push_back(&this->_entries[position]);
+        position = (position + 1) % capacity;
+    }
+
+    return (result);
+}
+
+std::uint64_t ReplayBuffer::getLastSequence() const
+{
+    return (this->_lastSequence);
+}
@@ -0,0 +1,127 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file ReplayBuffer.h
+ * @brief 채팅방에 중계된 메시지를 순번과 함께 보관하는 ReplayBuffer 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 중계되는 메시지마다 1부터 단조 증가하는 순번을 부여하고, 최근 capacity개를 원형 버퍼에 보관합니다.
+ * <br>재접속한 클라이언트가 마지막으로 받은 순번을 알려 주면 그 이후의 메시지만 다시 보낼 수 있습니다.
+ */
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @class ReplayBuffer
+ * @brief 순번이 매겨진 메시지를 고정 크기로 보관하는 원형 버퍼입니다.
+ *
+ * @note 버퍼가 가득 차면 가장 오래된 메시지를 덮어씁니다.
+ */
+class ReplayBuffer
+{
+public:
+    /// 기본 보관 개수.
+    static const int DEFAULT_CAPACITY = 256;
+
+    /**
+     * @enum ReplayBuffer::Result
+     * @brief collectSince()의 결과 상태 값.
+     */
+    enum class Result
+    {
+        COMPLETE,       ///< 요청한 순번 이후의 메시지를 빠짐없이 모음.
+        TRUNCATED,      ///< 일부 메시지가 이미 덮어써져 보관 중인 메시지만 모음.
+        INVALID_SEQUENCE ///< 요청한 순번이 아직 부여되지 않은 값임.
+    };
+
+    /**
+     * @struct ReplayBuffer::Entry
+     * @brief 보관된 메시지 하나.
+     */
+    struct Entry
+    {
+        std::uint64_t sequence;     ///< 메시지 순번.
+        std::string line;           ///< 메시지 본문.
+        std::time_t wallSeconds;    ///< 보관한 시각 (루프 시계의 벽시계 초).
+    };
+
+public:
+    /**
+     * @fn ReplayBuffer::ReplayBuffer(int capacity)
+     * @brief 지정한 개수만큼 보관하는 빈 버퍼를 생성합니다.
+     * @param[IN] int capacity : 보관할 최대 메시지 수.
+     * @return 없음.
+     */
+    explicit ReplayBuffer(int capacity = ReplayBuffer::DEFAULT_CAPACITY);
+
+    /**
+     * @fn ReplayBuffer::~ReplayBuffer()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~ReplayBuffer();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    ReplayBuffer(const ReplayBuffer& obj) = delete;
+    ReplayBuffer& operator=(const ReplayBuffer& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    ReplayBuffer(ReplayBuffer&& obj) = delete;
+    ReplayBuffer& operator=(ReplayBuffer&& obj) = delete;
+
+public:
+    /**
+     * @fn std::uint64_t ReplayBuffer::append(const std::string& line, std::time_t wall_seconds)
+     * @brief 메시지에 다음 순번을 부여하고 보관합니다.
+     * @param[IN] const std::string& line : 보관할 메시지.
+     * @param[IN] std::time_t wall_seconds : 보관 시각 (LoopClock::getWallSeconds()).
+     * @return std::uint64_t : 부여된 순번.
+     */
+    std::uint64_t append(const std::string& line, std::time_t wall_seconds);
+
+    /**
+     * @fn bool ReplayBuffer::appendAt(std::uint64_t sequence, const std::string& line, std::time_t wall_seconds)
+     * @brief 다른 곳(클러스터의 채팅방 주인)에서 매긴 순번으로 메시지를 보관합니다.
+     * @param[IN] std::uint64_t sequence : 메시지 순번.
+     * @param[IN] const std::string& line : 보관할 메시지.
+     * @param[IN] std::time_t wall_seconds : 보관 시각 (LoopClock::getWallSeconds()).
+     * @return bool : 보관했으면 true, 마지막 순번 이하이면 false.
+     * @note 순번이 건너뛰면 이전 메시지를 비웁니다. 보관 중인 순번은 항상 연속이어야 collectSince()가 위치를 계산할 수 있습니다.
+     */
+    bool appendAt(std::uint64_t sequence, const std::string& line, std::time_t wall_seconds);
+
+    /**
+     * @fn ReplayBuffer::Result ReplayBuffer::collectSince(std::uint64_t last_sequence, std::vector<const ReplayBuffer::Entry*>& entries) const
+     * @brief last_sequence보다 큰 순번의 메시지를 오래된 순서로 모읍니다.
+     * @param[IN] std::uint64_t last_sequence : 클라이언트가 마지막으로 받은 순번.
+     * @param[OUT] std::vector<const ReplayBuffer::Entry*>& entries : 모은 메시지 (다음 append() 전까지 유효).
+     * @return ReplayBuffer::Result : 누락 없이 모았으면 COMPLETE, 일부가 덮어써졌으면 TRUNCATED.
+     */
+    ReplayBuffer::Result collectSince(std::uint64_t last_sequence, std::vector<const ReplayBuffer::Entry*>& entries) const;
+
+    /**
+     * @fn std::uint64_t ReplayBuffer::getLastSequence() const
+     * @brief 마지막으로 부여한 순번을 반환합니다.
+     * @return std::uint64_t : 마지막 순번 (메시지가 없으면 0).
+     */
+    std::uint64_t getLastSequence() const;
+
+private:
+    /// 원형 버퍼 저장소.
+    std::vector<ReplayBuffer::Entry> _entries;
+
+    /// 다음에 쓸 위치.
+    int _head;
+
+    /// 보관 중인 메시지 수.
+    int _count;
+
+    /// 마지막으로 부여한 순번.
+    std::uint64_t _lastSequence;
+};
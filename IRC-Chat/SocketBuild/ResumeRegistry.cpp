@@ -0,0 +1,147 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ResumeRegistry.cpp
+ * @brief ResumeRegistry.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "ResumeRegistry.h"
+#include "DebugHelper.h"
+#include <Windows.h>
+#include <bcrypt.h>
+
+#pragma comment(lib, "bcrypt.lib")
+
+ResumeRegistry::ResumeRegistry(int capacity)
+    : _slots(capacity), _tokenIndex()
+{
+    for (ResumeRegistry::Slot& slot : this->_slots)
+    {
+        slot.suspended = false;
+    }
+    LOG_DEBUG("ResumeRegistry 객체를 생성합니다.");
+}
+
+ResumeRegistry::~ResumeRegistry()
+{
+    LOG_DEBUG("ResumeRegistry 객체를 삭제합니다.");
+}
+
+std::string ResumeRegistry::issue(int client_index)
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return ("");
+    }
+
+    // 이전 토큰은 더 이상 사용할 수 없습니다.
+    this->forget(client_index);
+
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::string token;
+    do
+    {
+        // 토큰을 추측해 남의 세션을 가로챌 수 없도록 예측 가능한 의사 난수 대신 운영체제의 CSPRNG를 씁니다.
+        unsigned char bytes[ResumeRegistry::TOKEN_BYTES];
+        if (BCryptGenRandom(nullptr, bytes, (ULONG)sizeof(bytes), BCRYPT_USE_SYSTEM_PREFERRED_RNG) != 0)
+        {
+            LOG_ERROR("재접속 토큰 난수 생성 실패 - 인덱스: " + std::to_string(client_index));
+            return ("");
+        }
+
+        token.clear();
+        for (unsigned char byte : bytes)
+        {
+            token.push_back(HEX_DIGITS[byte >> 4]);
+            token.push_back(HEX_DIGITS[byte & 0xF]);
+        }
+    } while (this->_tokenIndex.count(token) != 0);
+
+    this->_slots[client_index].token = token;
+    this->_tokenIndex[token] = client_index;
+    return (token);
+}
+
+void ResumeRegistry::suspend(int client_index, NetworkTransport::Clock::time_point deadline)
+{
+    if (this->isValidIndex(client_index) == false || this->_slots[client_index].token.empty())
+    {
+        return ;
+    }
+
+    this->_slots[client_index].suspended = true;
+    this->_slots[client_index].deadline = deadline;
+}
+
+int ResumeRegistry::claim(const std::string& token)
+{
+    auto it = this->_tokenIndex.find(token);
+    if (it == this->_tokenIndex.end())
+    {
+        return (-1);
+    }
+
+    // 아직 연결이 살아 있는 세션의 토큰으로는 이어 붙일 수 없습니다.
+    int client_index = it->second;
+    if (this->_slots[client_index].suspended == false)
+    {
+        return (-1);
+    }
+
+    this->forget(client_index);
+    return (client_index);
+}
+
+int ResumeRegistry::findActive(const std::string& token) const
+{
+    auto it = this->_tokenIndex.find(token);
+    if (it == this->_tokenIndex.end() || this->_slots[it->second].suspended)
+    {
+        return (-1);
+    }
+    return (it->second);
+}
+
+int ResumeRegistry::collectExpired(NetworkTransport::Clock::time_point now, int* indices, int max_count) const
+{
+    int count = 0;
+
+    for (int i = 0; i < (int)this->_slots.size() && count < max_count; ++i)
+    {
+        if (this->_slots[i].suspended && this->_slots[i].deadline <= now)
+        {
+            indices[count] = i;
+            count = count + 1;
+        }
+    }
+
+    return (count);
+}
+
+bool ResumeRegistry::isSuspended(int client_index) const
+{
+    return (this->isValidIndex(client_index) && this->_slots[client_index].suspended);
+}
+
+void ResumeRegistry::forget(int client_index)
+{
+    if (this->isValidIndex(client_index) == false)
+    {
+        return ;
+    }
+
+    ResumeRegistry::Slot& slot = this->_slots[client_index];
+    if (slot.token.empty() == false)
+    {
+        this->_tokenIndex.erase(slot.token);
+        slot.token.clear();
+    }
+    slot.suspended = false;
+}
+
+bool ResumeRegistry::isValidIndex(int client_index) const
+{
+    return (client_index >= 0 && client_index < (int)this->_slots.size());
+}
@@ -0,0 +1,147 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file ResumeRegistry.h
+ * @brief 재접속 토큰과 일시 중단된 세션을 관리하는 ResumeRegistry 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 접속 절차를 마친 클라이언트에게 추측하기 어려운 재접속 토큰을 발급합니다.
+ * <br>토큰은 운영체제의 암호학적 난수 생성기(BCryptGenRandom)로 만든 128비트 값입니다.
+ * <br>연결이 예기치 않게 끊긴 세션은 유예 시간 동안 일시 중단 상태로 남고,
+ * <br>그 안에 같은 토큰으로 재접속하면 참가/퇴장 알림 없이 이어집니다.
+ */
+
+#include "NetworkTransport.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ResumeRegistry
+ * @brief 클라이언트 인덱스별 재접속 토큰과 일시 중단 상태를 보관하는 클래스입니다.
+ */
+class ResumeRegistry
+{
+public:
+    /// 재접속 토큰의 난수 바이트 수 (128비트).
+    static const int TOKEN_BYTES = 16;
+
+    /// 재접속 토큰 길이 (16진수 문자 수).
+    static const int TOKEN_LENGTH = TOKEN_BYTES * 2;
+
+public:
+    /**
+     * @fn ResumeRegistry::ResumeRegistry(int capacity)
+     * @brief 지정한 슬롯 수를 가진 빈 레지스트리를 생성합니다.
+     * @param[IN] int capacity : 최대 클라이언트 수.
+     * @return 없음.
+     */
+    explicit ResumeRegistry(int capacity);
+
+    /**
+     * @fn ResumeRegistry::~ResumeRegistry()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~ResumeRegistry();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    ResumeRegistry(const ResumeRegistry& obj) = delete;
+    ResumeRegistry& operator=(const ResumeRegistry& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    ResumeRegistry(ResumeRegistry&& obj) = delete;
+    ResumeRegistry& operator=(ResumeRegistry&& obj) = delete;
+
+public:
+    /**
+     * @fn std::string ResumeRegistry::issue(int client_index)
+     * @brief 클라이언트에게 새 재접속 토큰을 발급합니다. 이전 토큰은 무효가 됩니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return std::string : 발급된 토큰. 난수 생성에 실패하면 빈 문자열.
+     */
+    std::string issue(int client_index);
+
+    /**
+     * @fn void ResumeRegistry::suspend(int client_index, NetworkTransport::Clock::time_point deadline)
+     * @brief 세션을 일시 중단 상태로 바꿉니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @param[IN] NetworkTransport::Clock::time_point deadline : 재접속을 기다릴 마감 시각.
+     * @return 없음.
+     */
+    void suspend(int client_index, NetworkTransport::Clock::time_point deadline);
+
+    /**
+     * @fn int ResumeRegistry::claim(const std::string& token)
+     * @brief 토큰에 해당하는 일시 중단된 세션을 찾아 레지스트리에서 꺼냅니다.
+     * @param[IN] const std::string& token : 클라이언트가 제시한 토큰.
+     * @return int : 일시 중단되어 있던 클라이언트 인덱스, 토큰이 없거나 세션이 중단 상태가 아니면 -1.
+     */
+    int claim(const std::string& token);
+
+    /**
+     * @fn int ResumeRegistry::findActive(const std::string& token) const
+     * @brief 토큰에 해당하는, 연결이 살아 있는 세션을 찾습니다. 레지스트리는 바뀌지 않습니다.
+     * @param[IN] const std::string& token : 클라이언트가 제시한 토큰.
+     * @return int : 클라이언트 인덱스, 토큰이 없거나 세션이 일시 중단 상태이면 -1.
+     * @note UDP 데이터그램처럼 TCP 연결 밖에서 온 요청을 세션에 연결할 때 사용합니다.
+     */
+    int findActive(const std::string& token) const;
+
+    /**
+     * @fn int ResumeRegistry::collectExpired(NetworkTransport::Clock::time_point now, int* indices, int max_count) const
+     * @brief 마감 시각이 지난 일시 중단 세션의 인덱스를 모읍니다.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @param[OUT] int* indices : 인덱스를 저장할 배열.
+     * @param[IN] int max_count : 배열이 담을 수 있는 최대 개수.
+     * @return int : 저장된 인덱스 개수.
+     */
+    int collectExpired(NetworkTransport::Clock::time_point now, int* indices, int max_count) const;
+
+    /**
+     * @fn bool ResumeRegistry::isSuspended(int client_index) const
+     * @brief 세션이 일시 중단 상태인지 확인합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return bool : 일시 중단 상태이면 true.
+     */
+    bool isSuspended(int client_index) const;
+
+    /**
+     * @fn void ResumeRegistry::forget(int client_index)
+     * @brief 클라이언트의 토큰과 중단 상태를 삭제합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void forget(int client_index);
+
+private:
+    /**
+     * @struct ResumeRegistry::Slot
+     * @brief 클라이언트 인덱스 하나의 재접속 정보.
+     */
+    struct Slot
+    {
+        std::string token;                              ///< 발급된 토큰 (없으면 빈 문자열).
+        bool suspended;                                 ///< 일시 중단 여부.
+        NetworkTransport::Clock::time_point deadline;   ///< 재접속 마감 시각.
+    };
+
+private:
+    /// 클라이언트 인덱스별 재접속 정보.
+    std::vector<ResumeRegistry::Slot> _slots;
+
+    /// 토큰에서 클라이언트 인덱스로의 조회 테이블.
+    std::unordered_map<std::string, int> _tokenIndex;
+
+private:
+    /**
+     * @fn bool ResumeRegistry::isValidIndex(int client_index) const
+     * @brief 인덱스가 슬롯 범위 안인지 확인합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return bool : 범위 안이면 true.
+     */
+    bool isValidIndex(int client_index) const;
+};
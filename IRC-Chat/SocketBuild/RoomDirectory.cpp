@@ -0,0 +1,364 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file RoomDirectory.cpp
+ * @brief RoomDirectory.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "RoomDirectory.h"
+#include "DebugHelper.h"
+#include <algorithm>
+
+RoomDirectory::RoomDirectory()
+    : _localNode(HashRing::NO_NODE), _ring(), _rooms(), _transferCount(0), _takeoverCount(0), _maxDisruptionMs(0)
+{
+    LOG_DEBUG("RoomDirectory 객체를 생성합니다.");
+}
+
+RoomDirectory::~RoomDirectory()
+{
+    LOG_DEBUG("RoomDirectory 객체를 삭제합니다.");
+}
+
+void RoomDirectory::setLocalNode(int node)
+{
+    this->_localNode = node;
+    this->_ring.setNodes({ node });
+    for (RoomDirectory::Room& room : this->_rooms)
+    {
+        room.owner = node;
+    }
+}
+
+int RoomDirectory::getLocalNode() const
+{
+    return (this->_localNode);
+}
+
+void RoomDirectory::addRoom(const std::string& room, NetworkTransport::Clock::time_point now)
+{
+    if (this->findRoom(room) != nullptr)
+    {
+        return ;
+    }
+
+    RoomDirectory::Room state;
+    state.id = room;
+    state.owner = this->_ring.findOwner(room);
+    state.lastSequence = 0;
+    state.awaitingHandoff = (state.owner == this->_localNode);
+    state.joining = state.awaitingHandoff;
+    state.ownedSince = now;
+    state.handoffDeadline = now + std::chrono::milliseconds(RoomDirectory::JOIN_WAIT_MS);
+    state.handoffReceived = false;
+    state.handoffReceivedAt = NetworkTransport::Clock::time_point();
+    state.drainNode = HashRing::NO_NODE;
+    state.drainUntil = NetworkTransport::Clock::time_point();
+    this->_rooms.push_back(std::move(state));
+}
+
+void RoomDirectory::updateNodes(const std::vector<int>& live_nodes, NetworkTransport::Clock::time_point now, std::vector<RoomDirectory::Transfer>& transfers)
+{
+    transfers.clear();
+
+    // 이 노드가 아직 링에 들어가지 않았고 준비된 다른 노드도 없으면 혼자인 것으로 봅니다.
+    std::vector<int> nodes = live_nodes;
+    if (nodes.empty())
+    {
+        nodes.push_back(this->_localNode);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    if (nodes != this->_ring.getNodes())
+    {
+        this->_ring.setNodes(nodes);
+        LOG_INFO("클러스터 노드 구성이 바뀌었습니다. 노드: " + std::to_string(nodes.size()) + "개");
+
+        // 링에서 점이 옮겨진 구간의 채팅방만 주인이 바뀝니다.
+        for (RoomDirectory::Room& room : this->_rooms)
+        {
+            int new_owner = this->_ring.findOwner(room.id);
+            if (new_owner == room.owner)
+            {
+                continue;
+            }
+
+            int previous_owner = room.owner;
+            transfers.push_back({ room.id, previous_owner, new_owner });
+            this->_transferCount = this->_transferCount + 1;
+            LOG_INFO("채팅방 주인이 바뀝니다: " + room.id + ", " + std::to_string(previous_owner) + " -> " + std::to_string(new_owner));
+
+            room.owner = new_owner;
+            room.drainNode = HashRing::NO_NODE;
+            if (previous_owner != this->_localNode && new_owner != this->_localNode && this->_ring.hasNode(previous_owner))
+            {
+                // 이전 주인에게 보낸 로컬 채팅이 아직 가는 중일 수 있으므로, 잠시 같은 링크로 이어 보냅니다.
+                room.drainNode = previous_owner;
+                room.drainUntil = now + std::chrono::milliseconds(RoomDirectory::PREVIOUS_OWNER_DRAIN_MS);
+            }
+
+            if (new_owner == this->_localNode)
+            {
+                this->takeOwnership(room, this->_ring.hasNode(previous_owner), now);
+            }
+            else
+            {
+                // 쌓여 있던 채팅은 호출하는 쪽이 takePending()으로 꺼내 새 주인에게 보냅니다.
+                room.awaitingHandoff = false;
+                room.joining = false;
+            }
+        }
+    }
+
+    for (RoomDirectory::Room& room : this->_rooms)
+    {
+        if (room.awaitingHandoff == false || now < room.handoffDeadline)
+        {
+            continue;
+        }
+
+        if (room.joining)
+        {
+            LOG_INFO("기존 주인이 없어 채팅방을 처음부터 맡습니다: " + room.id);
+        }
+        else
+        {
+            LOG_WARN("HANDOFF가 오지 않아 순번을 건너뛰고 채팅방을 이어받습니다: " + room.id);
+            room.lastSequence = room.lastSequence + RoomDirectory::TAKEOVER_SEQUENCE_GAP;
+            this->_takeoverCount = this->_takeoverCount + 1;
+        }
+        this->finishHandoff(room, now);
+    }
+}
+
+int RoomDirectory::getNextTimeoutMs(NetworkTransport::Clock::time_point now, int max_timeout_ms) const
+{
+    long long timeout_ms = max_timeout_ms;
+
+    for (const RoomDirectory::Room& room : this->_rooms)
+    {
+        if (room.awaitingHandoff == false)
+        {
+            continue;
+        }
+
+        long long remain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(room.handoffDeadline - now).count();
+        timeout_ms = std::min(timeout_ms, std::max(remain_ms, 0LL));
+    }
+    return ((int)timeout_ms);
+}
+
+int RoomDirectory::getOwner(const std::string& room) const
+{
+    const RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return (HashRing::NO_NODE);
+    }
+    return (state->owner);
+}
+
+int RoomDirectory::getRouteNode(const std::string& room, NetworkTransport::Clock::time_point now) const
+{
+    const RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return (HashRing::NO_NODE);
+    }
+    if (state->drainNode != HashRing::NO_NODE && now < state->drainUntil && this->_ring.hasNode(state->drainNode))
+    {
+        return (state->drainNode);
+    }
+    return (state->owner);
+}
+
+int RoomDirectory::getSuccessor(const std::string& room) const
+{
+    return (this->_ring.findOwner(room, this->_localNode));
+}
+
+RoomDirectory::Result RoomDirectory::assignSequence(const std::string& room, std::uint64_t& sequence)
+{
+    RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return (RoomDirectory::Result::UNKNOWN_ROOM);
+    }
+    if (state->owner != this->_localNode)
+    {
+        return (RoomDirectory::Result::NOT_OWNER);
+    }
+    if (state->awaitingHandoff)
+    {
+        return (RoomDirectory::Result::AWAITING_HANDOFF);
+    }
+
+    state->lastSequence = state->lastSequence + 1;
+    sequence = state->lastSequence;
+    return (RoomDirectory::Result::SUCCESS);
+}
+
+RoomDirectory::Result RoomDirectory::queuePublish(const std::string& room, const std::string& line)
+{
+    RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return (RoomDirectory::Result::UNKNOWN_ROOM);
+    }
+    if (state->pending.size() >= RoomDirectory::MAX_PENDING_PUBLISHES)
+    {
+        return (RoomDirectory::Result::PENDING_FULL);
+    }
+
+    state->pending.push_back(line);
+    return (RoomDirectory::Result::SUCCESS);
+}
+
+bool RoomDirectory::takePending(const std::string& room, std::vector<std::string>& lines)
+{
+    lines.clear();
+
+    RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr || state->awaitingHandoff || state->pending.empty())
+    {
+        return (false);
+    }
+
+    lines.swap(state->pending);
+    return (true);
+}
+
+bool RoomDirectory::observeSequence(const std::string& room, std::uint64_t sequence)
+{
+    RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr || sequence <= state->lastSequence)
+    {
+        return (false);
+    }
+
+    state->lastSequence = sequence;
+    return (true);
+}
+
+void RoomDirectory::completeHandoff(const std::string& room, std::uint64_t last_sequence, NetworkTransport::Clock::time_point now)
+{
+    RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return ;
+    }
+
+    state->lastSequence = std::max(state->lastSequence, last_sequence);
+    if (state->owner != this->_localNode)
+    {
+        // 이전 주인이 링 변경을 먼저 알아차린 경우입니다. 이 노드도 곧 주인이 됩니다.
+        state->handoffReceived = true;
+        state->handoffReceivedAt = now;
+        return ;
+    }
+    if (state->awaitingHandoff)
+    {
+        this->finishHandoff(*state, now);
+    }
+}
+
+std::uint64_t RoomDirectory::getLastSequence(const std::string& room) const
+{
+    const RoomDirectory::Room* state = this->findRoom(room);
+    if (state == nullptr)
+    {
+        return (0);
+    }
+    return (state->lastSequence);
+}
+
+void RoomDirectory::getOwnedRooms(std::vector<std::string>& rooms) const
+{
+    rooms.clear();
+    for (const RoomDirectory::Room& room : this->_rooms)
+    {
+        if (room.owner == this->_localNode)
+        {
+            rooms.push_back(room.id);
+        }
+    }
+}
+
+std::uint64_t RoomDirectory::getTransferCount() const
+{
+    return (this->_transferCount);
+}
+
+std::uint64_t RoomDirectory::getTakeoverCount() const
+{
+    return (this->_takeoverCount);
+}
+
+long long RoomDirectory::getMaxDisruptionMs() const
+{
+    return (this->_maxDisruptionMs);
+}
+
+RoomDirectory::Room* RoomDirectory::findRoom(const std::string& room)
+{
+    for (RoomDirectory::Room& state : this->_rooms)
+    {
+        if (state.id == room)
+        {
+            return (&state);
+        }
+    }
+    return (nullptr);
+}
+
+const RoomDirectory::Room* RoomDirectory::findRoom(const std::string& room) const
+{
+    for (const RoomDirectory::Room& state : this->_rooms)
+    {
+        if (state.id == room)
+        {
+            return (&state);
+        }
+    }
+    return (nullptr);
+}
+
+void RoomDirectory::takeOwnership(RoomDirectory::Room& room, bool previous_alive, NetworkTransport::Clock::time_point now)
+{
+    room.ownedSince = now;
+    room.joining = false;
+
+    bool recent_handoff = room.handoffReceived && now - room.handoffReceivedAt <= std::chrono::milliseconds(RoomDirectory::HANDOFF_TIMEOUT_MS);
+    room.handoffReceived = false;
+    if (recent_handoff)
+    {
+        this->finishHandoff(room, now);
+        return ;
+    }
+
+    if (previous_alive)
+    {
+        room.awaitingHandoff = true;
+        room.handoffDeadline = now + std::chrono::milliseconds(RoomDirectory::HANDOFF_TIMEOUT_MS);
+        return ;
+    }
+
+    // 이전 주인이 넘겨주지 못하고 빠졌습니다. 이 노드에 오지 않은 순번이 있을 수 있으므로 건너뜁니다.
+    LOG_WARN("이전 주인 없이 채팅방을 이어받습니다: " + room.id);
+    room.lastSequence = room.lastSequence + RoomDirectory::TAKEOVER_SEQUENCE_GAP;
+    this->_takeoverCount = this->_takeoverCount + 1;
+    this->finishHandoff(room, now);
+}
+
+void RoomDirectory::finishHandoff(RoomDirectory::Room& room, NetworkTransport::Clock::time_point now)
+{
+    room.awaitingHandoff = false;
+    room.joining = false;
+
+    long long disruption_ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(now - room.ownedSince).count();
+    this->_maxDisruptionMs = std::max(this->_maxDisruptionMs, disruption_ms);
+    LOG_INFO("채팅방을 넘겨받았습니다: " + room.id + ", 다음 순번: " + std::to_string(room.lastSequence + 1) + ", 중단 시간: " + std::to_string(disruption_ms) + "ms");
+}
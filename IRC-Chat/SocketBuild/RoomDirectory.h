@@ -0,0 +1,328 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file RoomDirectory.h
+ * @brief 클러스터에서 채팅방마다 주인 노드와 순번, 넘겨받기 상태를 관리하는 RoomDirectory 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 채팅방의 주인은 살아 있는 노드로 만든 HashRing이 정합니다. 주인만 채팅방 순번을 매기므로 모든 노드가 같은 순서를 봅니다.
+ * <br>노드가 들어오거나 나가 주인이 바뀌면 updateNodes()가 바뀐 채팅방만 Transfer로 알려 줍니다.
+ * <br>새 주인은 이전 주인이 살아 있으면 HANDOFF(마지막 순번)를 받을 때까지 들어온 채팅을 쌓아 두고, 받은 뒤 이어서 순번을 매깁니다.
+ * <br>이전 주인이 죽었거나 HANDOFF_TIMEOUT_MS 안에 HANDOFF가 오지 않으면 본 적 없는 순번과 겹치지 않도록 TAKEOVER_SEQUENCE_GAP만큼 건너뛰고 이어받습니다.
+ * <br>막 시작한 노드는 혼자인 링에서 모든 채팅방의 주인이지만, 이미 돌고 있는 클러스터의 주인이 HANDOFF를 보낼 수 있도록 JOIN_WAIT_MS 동안 기다립니다.
+ */
+
+#include "HashRing.h"
+#include "NetworkTransport.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class RoomDirectory
+ * @brief 채팅방별 주인 노드, 마지막 순번, 넘겨받기 대기 상태와 대기 중인 채팅을 보관하는 클래스입니다.
+ *
+ * @note 노드 번호는 클러스터 포트입니다. 소켓은 다루지 않으며, 프레임 송수신은 호출하는 쪽(MultiServer)이 ClusterRelay로 합니다.
+ */
+class RoomDirectory
+{
+public:
+    /// 새 주인이 살아 있는 이전 주인의 HANDOFF를 기다리는 최대 시간(밀리초).
+    static constexpr int HANDOFF_TIMEOUT_MS = 500;
+
+    /// 시작한 노드가 주인인 채팅방에서 기존 주인의 HANDOFF를 기다리는 시간(밀리초). 다른 노드가 재연결 간격마다 연결해 오므로 그보다 길게 둡니다.
+    static constexpr int JOIN_WAIT_MS = 2000;
+
+    /// HANDOFF 없이 이어받을 때 건너뛰는 순번 수. 이전 주인이 매겼지만 이 노드에 오지 않은 순번과 겹치지 않게 합니다.
+    static constexpr std::uint64_t TAKEOVER_SEQUENCE_GAP = 65536;
+
+    /// 두 노드 사이에서 주인이 바뀐 채팅방의 로컬 채팅을, 제3의 노드가 이전 주인을 거쳐 보내는 시간(밀리초).
+    /// 이전 주인에게 이미 보낸 채팅보다 새 주인에게 바로 보낸 채팅이 먼저 순번을 받지 않게 합니다.
+    static constexpr int PREVIOUS_OWNER_DRAIN_MS = 500;
+
+    /// 넘겨받기를 기다리는 동안 채팅방 하나에 쌓아 둘 수 있는 최대 채팅 수.
+    static constexpr std::size_t MAX_PENDING_PUBLISHES = 1024;
+
+public:
+    /**
+     * @enum RoomDirectory::Result
+     * @brief RoomDirectory 함수의 반환값.
+     */
+    enum class Result
+    {
+        SUCCESS,            ///< 성공.
+        UNKNOWN_ROOM,       ///< 등록되지 않은 채팅방.
+        NOT_OWNER,          ///< 이 노드가 주인이 아님.
+        AWAITING_HANDOFF,   ///< 이 노드가 주인이지만 아직 HANDOFF를 기다리는 중.
+        PENDING_FULL        ///< 대기 중인 채팅이 MAX_PENDING_PUBLISHES에 도달함.
+    };
+
+    /**
+     * @struct RoomDirectory::Transfer
+     * @brief 주인이 바뀐 채팅방 하나.
+     */
+    struct Transfer
+    {
+        std::string room;   ///< 채팅방 ID.
+        int fromNode;       ///< 이전 주인.
+        int toNode;         ///< 새 주인.
+    };
+
+public:
+    /**
+     * @fn RoomDirectory::RoomDirectory()
+     * @brief 채팅방이 없는 디렉터리를 생성합니다.
+     * @return 없음.
+     */
+    RoomDirectory();
+
+    /**
+     * @fn RoomDirectory::~RoomDirectory()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~RoomDirectory();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    RoomDirectory(const RoomDirectory& obj) = delete;
+    RoomDirectory& operator=(const RoomDirectory& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    RoomDirectory(RoomDirectory&& obj) = delete;
+    RoomDirectory& operator=(RoomDirectory&& obj) = delete;
+
+public:
+    /**
+     * @fn void RoomDirectory::setLocalNode(int node)
+     * @brief 이 노드의 번호를 정하고, 다른 노드를 모르는 상태(이 노드 혼자)로 링을 만듭니다.
+     * @param[IN] int node : 이 노드의 클러스터 포트.
+     * @return 없음.
+     */
+    void setLocalNode(int node);
+
+    /**
+     * @fn int RoomDirectory::getLocalNode() const
+     * @brief 이 노드의 번호를 반환합니다.
+     * @return int : 이 노드의 클러스터 포트.
+     */
+    int getLocalNode() const;
+
+    /**
+     * @fn void RoomDirectory::addRoom(const std::string& room, NetworkTransport::Clock::time_point now)
+     * @brief 채팅방을 등록합니다. 주인은 현재 링으로 정하며, 이 노드가 주인이면 JOIN_WAIT_MS 동안 HANDOFF를 기다립니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return 없음.
+     * @note JOIN_WAIT_MS 안에 HANDOFF가 오지 않으면 클러스터에 처음 뜬 노드로 보고 순번을 건너뛰지 않고 시작합니다.
+     */
+    void addRoom(const std::string& room, NetworkTransport::Clock::time_point now);
+
+    /**
+     * @fn void RoomDirectory::updateNodes(const std::vector<int>& live_nodes, NetworkTransport::Clock::time_point now, std::vector<RoomDirectory::Transfer>& transfers)
+     * @brief 살아 있는 노드 목록으로 링을 다시 만들고 주인이 바뀐 채팅방을 처리합니다. 넘겨받기 대기 시간이 지난 채팅방은 이어받습니다.
+     * @param[IN] const std::vector<int>& live_nodes : 링에 넣을 노드 (ClusterRelay::getLiveNodes()). 이 노드는 준비가 끝났을 때만 들어 있습니다.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @param[OUT] std::vector<RoomDirectory::Transfer>& transfers : 주인이 바뀐 채팅방 (이전 주인이 이 노드이면 HANDOFF를 보내야 합니다).
+     * @return 없음.
+     * @note 노드 목록이 바뀌지 않았으면 링을 다시 만들지 않습니다. live_nodes가 비어 있으면 이 노드 혼자로 링을 만듭니다.
+     */
+    void updateNodes(const std::vector<int>& live_nodes, NetworkTransport::Clock::time_point now, std::vector<RoomDirectory::Transfer>& transfers);
+
+    /**
+     * @fn int RoomDirectory::getNextTimeoutMs(NetworkTransport::Clock::time_point now, int max_timeout_ms) const
+     * @brief 가장 가까운 넘겨받기 마감 시각까지 남은 시간을 select 대기 시간으로 계산합니다.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @param[IN] int max_timeout_ms : 기다리는 채팅방이 없을 때 사용할 최대 대기 시간.
+     * @return int : select에 전달할 대기 시간(밀리초).
+     */
+    int getNextTimeoutMs(NetworkTransport::Clock::time_point now, int max_timeout_ms) const;
+
+    /**
+     * @fn int RoomDirectory::getOwner(const std::string& room) const
+     * @brief 채팅방의 현재 주인을 반환합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return int : 주인 노드, 등록되지 않은 채팅방이면 HashRing::NO_NODE.
+     */
+    int getOwner(const std::string& room) const;
+
+    /**
+     * @fn int RoomDirectory::getRouteNode(const std::string& room, NetworkTransport::Clock::time_point now) const
+     * @brief 이 노드의 접속자가 보낸 채팅을 넘길 노드를 반환합니다. 보통은 주인이고, 주인이 바뀐 직후에는 이전 주인입니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return int : 넘길 노드, 등록되지 않은 채팅방이면 HashRing::NO_NODE.
+     * @note 이전 주인은 넘겨준 뒤 받은 채팅을 HANDOFF 다음에 새 주인에게 넘기므로, 이 노드가 보낸 순서가 유지됩니다.
+     */
+    int getRouteNode(const std::string& room, NetworkTransport::Clock::time_point now) const;
+
+    /**
+     * @fn int RoomDirectory::getSuccessor(const std::string& room) const
+     * @brief 이 노드가 빠졌을 때 채팅방을 이어받을 노드를 반환합니다. 종료 전 넘겨주기에 사용합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return int : 이어받을 노드, 다른 노드가 없으면 HashRing::NO_NODE.
+     */
+    int getSuccessor(const std::string& room) const;
+
+    /**
+     * @fn RoomDirectory::Result RoomDirectory::assignSequence(const std::string& room, std::uint64_t& sequence)
+     * @brief 이 노드가 주인인 채팅방에서 다음 순번을 매깁니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[OUT] std::uint64_t& sequence : 매긴 순번.
+     * @return RoomDirectory::Result : SUCCESS, 주인이 아니면 NOT_OWNER, 넘겨받기 중이면 AWAITING_HANDOFF.
+     */
+    RoomDirectory::Result assignSequence(const std::string& room, std::uint64_t& sequence);
+
+    /**
+     * @fn RoomDirectory::Result RoomDirectory::queuePublish(const std::string& room, const std::string& line)
+     * @brief 넘겨받기를 기다리는 동안 들어온 채팅을 쌓아 둡니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] const std::string& line : 채팅 한 줄.
+     * @return RoomDirectory::Result : SUCCESS, 가득 찼으면 PENDING_FULL.
+     */
+    RoomDirectory::Result queuePublish(const std::string& room, const std::string& line);
+
+    /**
+     * @fn bool RoomDirectory::takePending(const std::string& room, std::vector<std::string>& lines)
+     * @brief 넘겨받기가 끝난 채팅방에 쌓인 채팅을 꺼냅니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[OUT] std::vector<std::string>& lines : 쌓인 순서대로의 채팅.
+     * @return bool : 꺼낸 채팅이 있으면 true. 아직 넘겨받기 중이면 꺼내지 않고 false.
+     */
+    bool takePending(const std::string& room, std::vector<std::string>& lines);
+
+    /**
+     * @fn bool RoomDirectory::observeSequence(const std::string& room, std::uint64_t sequence)
+     * @brief 주인이 매긴 순번을 받았음을 기록합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] std::uint64_t sequence : 받은 순번.
+     * @return bool : 마지막 순번보다 커서 전달해야 하면 true, 이미 본 순번이면 false.
+     */
+    bool observeSequence(const std::string& room, std::uint64_t sequence);
+
+    /**
+     * @fn void RoomDirectory::completeHandoff(const std::string& room, std::uint64_t last_sequence, NetworkTransport::Clock::time_point now)
+     * @brief 이전 주인이 보낸 HANDOFF를 반영합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] std::uint64_t last_sequence : 이전 주인이 마지막으로 매긴 순번.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return 없음.
+     * @note 아직 이 노드가 주인이 되기 전에 받으면 기억해 두었다가, HANDOFF_TIMEOUT_MS 안에 주인이 되면 기다리지 않고 바로 이어받습니다.
+     */
+    void completeHandoff(const std::string& room, std::uint64_t last_sequence, NetworkTransport::Clock::time_point now);
+
+    /**
+     * @fn std::uint64_t RoomDirectory::getLastSequence(const std::string& room) const
+     * @brief 채팅방의 마지막 순번(매겼거나 받은 것 중 가장 큰 값)을 반환합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return std::uint64_t : 마지막 순번, 없으면 0.
+     */
+    std::uint64_t getLastSequence(const std::string& room) const;
+
+    /**
+     * @fn void RoomDirectory::getOwnedRooms(std::vector<std::string>& rooms) const
+     * @brief 이 노드가 주인인 채팅방을 모읍니다.
+     * @param[OUT] std::vector<std::string>& rooms : 채팅방 ID 목록.
+     * @return 없음.
+     */
+    void getOwnedRooms(std::vector<std::string>& rooms) const;
+
+    /**
+     * @fn std::uint64_t RoomDirectory::getTransferCount() const
+     * @brief 주인이 바뀐 횟수(채팅방별)를 반환합니다.
+     * @return std::uint64_t : 바뀐 횟수.
+     */
+    std::uint64_t getTransferCount() const;
+
+    /**
+     * @fn std::uint64_t RoomDirectory::getTakeoverCount() const
+     * @brief HANDOFF 없이 순번을 건너뛰어 이어받은 횟수를 반환합니다.
+     * @return std::uint64_t : 이어받은 횟수.
+     */
+    std::uint64_t getTakeoverCount() const;
+
+    /**
+     * @fn long long RoomDirectory::getMaxDisruptionMs() const
+     * @brief 이 노드가 주인이 된 뒤 채팅을 다시 순번 매기기까지 걸린 가장 긴 시간을 반환합니다.
+     * @return long long : 가장 긴 중단 시간(밀리초).
+     */
+    long long getMaxDisruptionMs() const;
+
+private:
+    /**
+     * @struct RoomDirectory::Room
+     * @brief 채팅방 하나의 상태.
+     */
+    struct Room
+    {
+        std::string id;                                         ///< 채팅방 ID.
+        int owner;                                              ///< 현재 주인 노드.
+        std::uint64_t lastSequence;                             ///< 매겼거나 받은 가장 큰 순번.
+        bool awaitingHandoff;                                   ///< 주인이 되었지만 HANDOFF를 기다리는 중인지 여부.
+        bool joining;                                           ///< 노드 시작 직후의 기다림인지 여부 (마감되어도 순번을 건너뛰지 않습니다).
+        NetworkTransport::Clock::time_point ownedSince;         ///< 이 노드가 주인이 된 시각.
+        NetworkTransport::Clock::time_point handoffDeadline;    ///< HANDOFF를 기다리는 마감 시각.
+        bool handoffReceived;                                   ///< 주인이 되기 전에 HANDOFF를 받았는지 여부.
+        NetworkTransport::Clock::time_point handoffReceivedAt;  ///< 그 HANDOFF를 받은 시각.
+        std::vector<std::string> pending;                       ///< 넘겨받기를 기다리는 동안 들어온 채팅.
+        int drainNode;                                          ///< 로컬 채팅을 잠시 거쳐 보낼 이전 주인 (없으면 HashRing::NO_NODE).
+        NetworkTransport::Clock::time_point drainUntil;         ///< 이전 주인을 거쳐 보내는 마감 시각.
+    };
+
+private:
+    /// 이 노드의 번호.
+    int _localNode;
+
+    /// 이 노드와 살아 있는 노드로 만든 링.
+    HashRing _ring;
+
+    /// 등록된 채팅방.
+    std::vector<RoomDirectory::Room> _rooms;
+
+    /// 주인이 바뀐 횟수.
+    std::uint64_t _transferCount;
+
+    /// 순번을 건너뛰어 이어받은 횟수.
+    std::uint64_t _takeoverCount;
+
+    /// 가장 긴 중단 시간(밀리초).
+    long long _maxDisruptionMs;
+
+private:
+    /**
+     * @fn RoomDirectory::Room* RoomDirectory::findRoom(const std::string& room)
+     * @brief 채팅방 상태를 찾습니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return RoomDirectory::Room* : 채팅방 상태, 없으면 nullptr.
+     */
+    RoomDirectory::Room* findRoom(const std::string& room);
+
+    /**
+     * @fn const RoomDirectory::Room* RoomDirectory::findRoom(const std::string& room) const
+     * @brief 채팅방 상태를 찾습니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return const RoomDirectory::Room* : 채팅방 상태, 없으면 nullptr.
+     */
+    const RoomDirectory::Room* findRoom(const std::string& room) const;
+
+    /**
+     * @fn void RoomDirectory::takeOwnership(RoomDirectory::Room& room, bool previous_alive, NetworkTransport::Clock::time_point now)
+     * @brief 이 노드가 채팅방의 주인이 되었을 때 넘겨받기를 시작합니다.
+     * @param[IN, OUT] RoomDirectory::Room& room : 채팅방 상태.
+     * @param[IN] bool previous_alive : 이전 주인이 아직 살아 있는지 여부.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return 없음.
+     */
+    void takeOwnership(RoomDirectory::Room& room, bool previous_alive, NetworkTransport::Clock::time_point now);
+
+    /**
+     * @fn void RoomDirectory::finishHandoff(RoomDirectory::Room& room, NetworkTransport::Clock::time_point now)
+     * @brief 넘겨받기 대기를 끝내고 중단 시간을 기록합니다.
+     * @param[IN, OUT] RoomDirectory::Room& room : 채팅방 상태.
+     * @param[IN] NetworkTransport::Clock::time_point now : 현재 시각.
+     * @return 없음.
+     */
+    void finishHandoff(RoomDirectory::Room& room, NetworkTransport::Clock::time_point now);
+};
@@ -0,0 +1,542 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file RoomWorkers.cpp
+ * @brief RoomWorkers.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "RoomWorkers.h"
+#include "DebugHelper.h"
+#include <deque>
+#include <utility>
+
+/**
+ * @struct RoomWorkers::WorkerState
+ * @brief 작업자 스레드만 접근하는 상태. 작업자 스레드의 지역 변수로 두므로 잠그지 않습니다.
+ */
+struct RoomWorkers::WorkerState
+{
+    std::unordered_map<std::string, std::unique_ptr<RoomWorkers::Room>> rooms;     ///< 맡고 있는 채팅방.
+    std::unordered_map<std::string, int> fenceCounts;                               ///< 떠나는 채팅방별로 받은 울타리 수.
+    std::unordered_map<std::string, std::vector<RoomWorkers::Envelope>> held;       ///< 들어오는 채팅방의 상태를 받기 전에 도착한 메시지.
+    std::deque<std::pair<int, RoomWorkers::Envelope>> outbox;                       ///< 받는 쪽 큐가 가득 차 아직 보내지 못한 HANDOFF.
+    std::chrono::steady_clock::time_point windowStart;                              ///< 이번 통계 구간의 시작 시각.
+    std::uint64_t windowCount = 0;                                                  ///< 이번 통계 구간에 처리한 메시지 수.
+};
+
+RoomWorkers::Producer::Producer(RoomWorkers& owner, int index)
+    : _owner(owner), _index(index), _routes(owner._routes.load(std::memory_order_acquire)), _routesVersion(0), _pendingFences()
+{
+    this->_routesVersion = this->_routes->version;
+}
+
+bool RoomWorkers::Producer::submit(const std::string& room, std::string payload, std::uint64_t tag)
+{
+    this->sync();
+
+    RoomWorkers::Envelope envelope;
+    envelope.kind = RoomWorkers::Envelope::Kind::MESSAGE;
+    envelope.room = room;
+    envelope.payload = std::move(payload);
+    envelope.tag = tag;
+    return (this->_owner.push(this->_index, this->route(room), envelope));
+}
+
+void RoomWorkers::Producer::sync()
+{
+    // 번호만 먼저 보고, 바뀐 경우에만 경로 표를 다시 읽습니다.
+    if (this->_owner._routesVersion.load(std::memory_order_acquire) != this->_routesVersion)
+    {
+        std::shared_ptr<const RoomWorkers::Routes> latest = this->_owner._routes.load(std::memory_order_acquire);
+
+        // 주인이 바뀐 채팅방은 두 표 중 어느 한쪽의 예외 목록에 반드시 있습니다.
+        // 채팅방 하나는 한 번에 한 번만 옮겨지므로 (이전 표의 주인)이 곧 이동의 출발지입니다.
+        const RoomWorkers::Routes* tables[2] = { this->_routes.get(), latest.get() };
+        for (const RoomWorkers::Routes* table : tables)
+        {
+            for (const auto& entry : table->overrides)
+            {
+                int old_owner = this->_owner.findOwner(*this->_routes, entry.first);
+                if (old_owner != this->_owner.findOwner(*latest, entry.first))
+                {
+                    this->_pendingFences.emplace(entry.first, old_owner);
+                }
+            }
+        }
+
+        this->_routes = latest;
+        this->_routesVersion = latest->version;
+    }
+
+    // 울타리를 넣기 전까지 그 채팅방의 메시지는 이전 주인에게 계속 보냅니다 (route() 참고).
+    for (auto it = this->_pendingFences.begin(); it != this->_pendingFences.end();)
+    {
+        RoomWorkers::Envelope fence;
+        fence.kind = RoomWorkers::Envelope::Kind::FENCE;
+        fence.room = it->first;
+        if (this->_owner.push(this->_index, it->second, fence))
+        {
+            it = this->_pendingFences.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+int RoomWorkers::Producer::route(const std::string& room) const
+{
+    if (this->_pendingFences.empty() == false)
+    {
+        auto it = this->_pendingFences.find(room);
+        if (it != this->_pendingFences.end())
+        {
+            return (it->second);
+        }
+    }
+    return (this->_owner.findOwner(*this->_routes, room));
+}
+
+RoomWorkers::RoomWorkers(int worker_count, int producer_count, RoomWorkers::Handler handler)
+    : _workerCount((worker_count < 1) ? 1 : worker_count), _producerCount((producer_count < 1) ? 1 : producer_count),
+      _handler(std::move(handler)), _ring(), _routes(std::make_shared<const RoomWorkers::Routes>()), _routesVersion(0), _controlMutex(),
+      _queues(), _workers(), _producers(), _migrationCount(0), _stopping(false)
+{
+    std::vector<int> nodes;
+    for (int i = 0; i < this->_workerCount; ++i)
+    {
+        nodes.push_back(i);
+    }
+    this->_ring.setNodes(nodes);
+
+    // 보낸 쪽은 생산자 다음에 작업자(HANDOFF용) 순서입니다.
+    int sender_count = this->_producerCount + this->_workerCount;
+    for (int i = 0; i < sender_count * this->_workerCount; ++i)
+    {
+        this->_queues.push_back(std::make_unique<SpscQueue<RoomWorkers::Envelope>>(RoomWorkers::QUEUE_CAPACITY));
+    }
+    for (int i = 0; i < this->_producerCount; ++i)
+    {
+        this->_producers.push_back(std::unique_ptr<RoomWorkers::Producer>(new RoomWorkers::Producer(*this, i)));
+    }
+    for (int i = 0; i < this->_workerCount; ++i)
+    {
+        this->_workers.push_back(std::make_unique<RoomWorkers::Worker>());
+    }
+    for (int i = 0; i < this->_workerCount; ++i)
+    {
+        this->_workers[i]->thread = std::thread(&RoomWorkers::workerLoop, this, i);
+    }
+    LOG_DEBUG("RoomWorkers 객체를 생성합니다.");
+}
+
+RoomWorkers::~RoomWorkers()
+{
+    this->_stopping.store(true, std::memory_order_release);
+    for (std::unique_ptr<RoomWorkers::Worker>& worker : this->_workers)
+    {
+        worker->signal.fetch_add(1, std::memory_order_release);
+        worker->signal.notify_all();
+    }
+    for (std::unique_ptr<RoomWorkers::Worker>& worker : this->_workers)
+    {
+        worker->thread.join();
+    }
+    LOG_DEBUG("RoomWorkers 객체를 삭제합니다.");
+}
+
+RoomWorkers::Producer& RoomWorkers::getProducer(int index)
+{
+    return (*this->_producers[index]);
+}
+
+int RoomWorkers::getOwner(const std::string& room) const
+{
+    return (this->findOwner(*this->_routes.load(std::memory_order_acquire), room));
+}
+
+bool RoomWorkers::migrateRoom(const std::string& room, int worker_index)
+{
+    if (worker_index < 0 || worker_index >= this->_workerCount)
+    {
+        return (false);
+    }
+
+    std::lock_guard<std::mutex> lock(this->_controlMutex);
+    std::shared_ptr<const RoomWorkers::Routes> current = this->_routes.load(std::memory_order_acquire);
+
+    // 이동 중인 채팅방을 또 옮기면 울타리가 어느 이동의 것인지 구분할 수 없으므로 끝날 때까지 받지 않습니다.
+    if (current->migrating.count(room) != 0)
+    {
+        return (false);
+    }
+    int from_worker = this->findOwner(*current, room);
+    if (from_worker == worker_index)
+    {
+        return (false);
+    }
+
+    std::shared_ptr<RoomWorkers::Routes> next = std::make_shared<RoomWorkers::Routes>(*current);
+    next->version = current->version + 1;
+    if (this->_ring.findOwner(room) == worker_index)
+    {
+        next->overrides.erase(room);
+    }
+    else
+    {
+        next->overrides[room] = worker_index;
+    }
+    next->migrating[room] = from_worker;
+
+    this->_routes.store(next, std::memory_order_release);
+    this->_routesVersion.store(next->version, std::memory_order_release);
+    LOG_INFO("채팅방 작업자 이동을 시작합니다 - 채팅방: " + room + ", 작업자: " + std::to_string(from_worker) + " -> " + std::to_string(worker_index));
+    return (true);
+}
+
+bool RoomWorkers::migrateHottestRoom()
+{
+    std::vector<RoomWorkers::WorkerStats> stats = this->getStats();
+
+    const RoomWorkers::WorkerStats* busiest = &stats[0];
+    const RoomWorkers::WorkerStats* idlest = &stats[0];
+    for (const RoomWorkers::WorkerStats& entry : stats)
+    {
+        if (entry.messagesPerSecond > busiest->messagesPerSecond)
+        {
+            busiest = &entry;
+        }
+        if (entry.messagesPerSecond < idlest->messagesPerSecond)
+        {
+            idlest = &entry;
+        }
+    }
+
+    // 옮긴 뒤 받는 쪽이 지금의 가장 바쁜 작업자만큼 바빠진다면 치우침이 줄지 않습니다.
+    if (busiest == idlest || busiest->hottestRoom.empty() ||
+        idlest->messagesPerSecond + busiest->hottestRoomPerSecond >= busiest->messagesPerSecond)
+    {
+        return (false);
+    }
+    return (this->migrateRoom(busiest->hottestRoom, idlest->worker));
+}
+
+std::vector<RoomWorkers::WorkerStats> RoomWorkers::getStats() const
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::vector<RoomWorkers::WorkerStats> stats;
+
+    for (int i = 0; i < this->_workerCount; ++i)
+    {
+        const RoomWorkers::Worker& worker = *this->_workers[i];
+        RoomWorkers::WorkerStats entry;
+        entry.worker = i;
+        entry.processedCount = worker.processedCount.load(std::memory_order_relaxed);
+
+        int sender_count = this->_producerCount + this->_workerCount;
+        for (int sender = 0; sender < sender_count; ++sender)
+        {
+            entry.queuedCount = entry.queuedCount + this->_queues[sender * this->_workerCount + i]->getSize();
+        }
+
+        // 잠들어 게시하지 못한 구간은 처리량이 없었던 것으로 봅니다.
+        std::shared_ptr<const RoomWorkers::StatsSnapshot> snapshot = worker.stats.load(std::memory_order_acquire);
+        if (snapshot != nullptr)
+        {
+            entry.roomCount = snapshot->roomCount;
+            if (now - snapshot->publishedAt <= std::chrono::milliseconds(2 * RoomWorkers::STATS_INTERVAL_MS))
+            {
+                entry.messagesPerSecond = snapshot->messagesPerSecond;
+                entry.hottestRoom = snapshot->hottestRoom;
+                entry.hottestRoomPerSecond = snapshot->hottestRoomPerSecond;
+            }
+        }
+        stats.push_back(entry);
+    }
+    return (stats);
+}
+
+double RoomWorkers::getSkew() const
+{
+    std::vector<RoomWorkers::WorkerStats> stats = this->getStats();
+
+    double total = 0.0;
+    double maximum = 0.0;
+    for (const RoomWorkers::WorkerStats& entry : stats)
+    {
+        total = total + entry.messagesPerSecond;
+        maximum = (entry.messagesPerSecond > maximum) ? entry.messagesPerSecond : maximum;
+    }
+    if (total <= 0.0)
+    {
+        return (0.0);
+    }
+    return (maximum / (total / stats.size()));
+}
+
+std::uint64_t RoomWorkers::getMigrationCount() const
+{
+    return (this->_migrationCount.load(std::memory_order_relaxed));
+}
+
+int RoomWorkers::getWorkerCount() const
+{
+    return (this->_workerCount);
+}
+
+SpscQueue<RoomWorkers::Envelope>& RoomWorkers::getQueue(int sender, int worker_index)
+{
+    return (*this->_queues[sender * this->_workerCount + worker_index]);
+}
+
+bool RoomWorkers::push(int sender, int worker_index, RoomWorkers::Envelope& envelope)
+{
+    if (this->getQueue(sender, worker_index).tryPush(std::move(envelope)) == false)
+    {
+        return (false);
+    }
+
+    // 작업자의 (sleeping 쓰기 → 큐 확인)과 짝을 이루는 울타리입니다. 둘 중 적어도 한쪽은 상대의 쓰기를 봅니다.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    RoomWorkers::Worker& worker = *this->_workers[worker_index];
+    if (worker.sleeping.load(std::memory_order_relaxed))
+    {
+        worker.signal.fetch_add(1, std::memory_order_release);
+        worker.signal.notify_one();
+    }
+    return (true);
+}
+
+int RoomWorkers::findOwner(const RoomWorkers::Routes& routes, const std::string& room) const
+{
+    if (routes.overrides.empty() == false)
+    {
+        auto it = routes.overrides.find(room);
+        if (it != routes.overrides.end())
+        {
+            return (it->second);
+        }
+    }
+    return (this->_ring.findOwner(room));
+}
+
+void RoomWorkers::completeMigration(const std::string& room)
+{
+    std::lock_guard<std::mutex> lock(this->_controlMutex);
+    std::shared_ptr<const RoomWorkers::Routes> current = this->_routes.load(std::memory_order_acquire);
+
+    // 주인은 그대로이므로 생산자는 이 표를 보고도 울타리를 넣지 않습니다.
+    std::shared_ptr<RoomWorkers::Routes> next = std::make_shared<RoomWorkers::Routes>(*current);
+    next->version = current->version + 1;
+    next->migrating.erase(room);
+
+    this->_routes.store(next, std::memory_order_release);
+    this->_routesVersion.store(next->version, std::memory_order_release);
+    this->_migrationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RoomWorkers::handleEnvelope(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Envelope& envelope)
+{
+    switch (envelope.kind)
+    {
+    case RoomWorkers::Envelope::Kind::MESSAGE:
+    {
+        auto it = state.rooms.find(envelope.room);
+        if (it == state.rooms.end())
+        {
+            // 상태가 아직 오지 않은 들어오는 채팅방이면 쌓아 둡니다. 경로 표는 채팅방을 처음 볼 때만 읽습니다.
+            auto held = state.held.find(envelope.room);
+            if (held != state.held.end())
+            {
+                held->second.push_back(std::move(envelope));
+                return ;
+            }
+            std::shared_ptr<const RoomWorkers::Routes> routes = this->_routes.load(std::memory_order_acquire);
+            if (routes->migrating.count(envelope.room) != 0 && this->findOwner(*routes, envelope.room) == worker_index)
+            {
+                state.held[envelope.room].push_back(std::move(envelope));
+                return ;
+            }
+
+            std::unique_ptr<RoomWorkers::Room> room = std::make_unique<RoomWorkers::Room>();
+            room->id = envelope.room;
+            it = state.rooms.emplace(envelope.room, std::move(room)).first;
+        }
+        this->processMessage(worker_index, state, *it->second, envelope);
+        return ;
+    }
+
+    case RoomWorkers::Envelope::Kind::FENCE:
+    {
+        int& fence_count = state.fenceCounts[envelope.room];
+        fence_count = fence_count + 1;
+        if (fence_count < this->_producerCount)
+        {
+            return ;
+        }
+
+        // 모든 생산자가 새 주인으로 돌아섰으므로 이 채팅방으로 올 메시지는 더 없습니다.
+        state.fenceCounts.erase(envelope.room);
+        std::unique_ptr<RoomWorkers::Room> room;
+        auto it = state.rooms.find(envelope.room);
+        if (it != state.rooms.end())
+        {
+            room = std::move(it->second);
+            state.rooms.erase(it);
+        }
+        else
+        {
+            room = std::make_unique<RoomWorkers::Room>();
+            room->id = envelope.room;
+        }
+
+        RoomWorkers::Envelope handoff;
+        handoff.kind = RoomWorkers::Envelope::Kind::HANDOFF;
+        handoff.room = envelope.room;
+        handoff.state = std::move(room);
+        state.outbox.emplace_back(this->getOwner(envelope.room), std::move(handoff));
+        return ;
+    }
+
+    case RoomWorkers::Envelope::Kind::HANDOFF:
+    {
+        RoomWorkers::Room& room = *state.rooms.emplace(envelope.room, std::move(envelope.state)).first->second;
+
+        auto held = state.held.find(envelope.room);
+        if (held != state.held.end())
+        {
+            for (RoomWorkers::Envelope& message : held->second)
+            {
+                this->processMessage(worker_index, state, room, message);
+            }
+            state.held.erase(held);
+        }
+        this->completeMigration(envelope.room);
+        return ;
+    }
+    }
+}
+
+void RoomWorkers::processMessage(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Room& room, RoomWorkers::Envelope& envelope)
+{
+    room.sequence = room.sequence + 1;
+    room.windowCount = room.windowCount + 1;
+    state.windowCount = state.windowCount + 1;
+
+    this->_handler(worker_index, room, envelope.tag, envelope.payload);
+
+    // 이 값은 이 작업자만 쓰므로 읽고 더해 저장하면 됩니다.
+    RoomWorkers::Worker& worker = *this->_workers[worker_index];
+    worker.processedCount.store(worker.processedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void RoomWorkers::publishStats(int worker_index, RoomWorkers::WorkerState& state)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - state.windowStart).count();
+
+    std::shared_ptr<RoomWorkers::StatsSnapshot> snapshot = std::make_shared<RoomWorkers::StatsSnapshot>();
+    snapshot->publishedAt = now;
+    snapshot->roomCount = state.rooms.size();
+    snapshot->messagesPerSecond = (seconds > 0.0) ? state.windowCount / seconds : 0.0;
+
+    std::uint64_t hottest_count = 0;
+    for (auto& entry : state.rooms)
+    {
+        if (entry.second->windowCount > hottest_count)
+        {
+            hottest_count = entry.second->windowCount;
+            snapshot->hottestRoom = entry.first;
+        }
+        entry.second->windowCount = 0;
+    }
+    snapshot->hottestRoomPerSecond = (seconds > 0.0) ? hottest_count / seconds : 0.0;
+
+    this->_workers[worker_index]->stats.store(snapshot, std::memory_order_release);
+    state.windowStart = now;
+    state.windowCount = 0;
+}
+
+bool RoomWorkers::hasInbound(int worker_index) const
+{
+    int sender_count = this->_producerCount + this->_workerCount;
+    for (int sender = 0; sender < sender_count; ++sender)
+    {
+        if (this->_queues[sender * this->_workerCount + worker_index]->isEmpty() == false)
+        {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+void RoomWorkers::workerLoop(int worker_index)
+{
+    RoomWorkers::Worker& worker = *this->_workers[worker_index];
+    RoomWorkers::WorkerState state;
+    state.windowStart = std::chrono::steady_clock::now();
+
+    int sender_count = this->_producerCount + this->_workerCount;
+    int idle_count = 0;
+
+    while (this->_stopping.load(std::memory_order_acquire) == false)
+    {
+        bool worked = false;
+
+        // 받는 쪽 큐가 가득 차 미뤄 둔 HANDOFF를 먼저 보냅니다.
+        while (state.outbox.empty() == false)
+        {
+            std::pair<int, RoomWorkers::Envelope>& pending = state.outbox.front();
+            if (this->push(this->_producerCount + worker_index, pending.first, pending.second) == false)
+            {
+                break;
+            }
+            state.outbox.pop_front();
+            worked = true;
+        }
+
+        RoomWorkers::Envelope envelope;
+        for (int sender = 0; sender < sender_count; ++sender)
+        {
+            SpscQueue<RoomWorkers::Envelope>& queue = this->getQueue(sender, worker_index);
+            for (int n = 0; n < RoomWorkers::POP_BATCH && queue.tryPop(envelope); ++n)
+            {
+                this->handleEnvelope(worker_index, state, envelope);
+                worked = true;
+            }
+        }
+
+        if (std::chrono::steady_clock::now() - state.windowStart >= std::chrono::milliseconds(RoomWorkers::STATS_INTERVAL_MS))
+        {
+            this->publishStats(worker_index, state);
+        }
+
+        if (worked)
+        {
+            idle_count = 0;
+            continue;
+        }
+
+        // 보낼 HANDOFF가 남아 있으면 잠들지 않고 받는 쪽이 큐를 비우기를 기다립니다.
+        idle_count = idle_count + 1;
+        if (idle_count < RoomWorkers::IDLE_SPIN_COUNT || state.outbox.empty() == false)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // push()의 울타리와 짝을 이룹니다. 잠들기로 한 뒤 큐를 다시 보고, 그사이 들어온 항목이 없을 때만 잠듭니다.
+        std::uint32_t seen = worker.signal.load(std::memory_order_acquire);
+        worker.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->hasInbound(worker_index) == false && this->_stopping.load(std::memory_order_acquire) == false)
+        {
+            worker.signal.wait(seen, std::memory_order_acquire);
+        }
+        worker.sleeping.store(false, std::memory_order_relaxed);
+        idle_count = 0;
+    }
+}
@@ -0,0 +1,421 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file RoomWorkers.h
+ * @brief 채팅방마다 전담 작업자 스레드를 정해 잠금 없이 순서대로 처리하는 RoomWorkers 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 채팅방은 작업자 번호로 만든 HashRing으로 작업자 하나에 배정되고, 그 채팅방의 상태 변경과 중계는 모두 그 작업자에서만 실행됩니다.
+ * <br>연결 I/O 스레드(생산자)는 (생산자, 작업자) 쌍마다 하나씩 있는 SpscQueue로 메시지를 넘기므로 데이터 경로에는 잠금이 없습니다.
+ * <br>한 생산자가 한 채팅방에 넣은 메시지는 넣은 순서대로 처리되고, 채팅방 하나의 처리는 한 스레드에서만 일어나므로 핸들러도 잠글 필요가 없습니다.
+ *
+ * 실행 중에 채팅방을 다른 작업자로 옮길 수 있습니다(migrateRoom). 순서를 지키기 위한 절차는 다음과 같습니다.
+ * -# 경로 표(Routes)를 새 주인으로 바꾸어 게시하고, 옮기는 중이라는 기록을 함께 남깁니다.
+ * -# 각 생산자는 새 경로 표를 처음 볼 때 이전 주인에게 울타리(FENCE)를 넣은 뒤부터 새 주인에게 보냅니다.
+ * -# 이전 주인은 모든 생산자의 울타리를 받으면 그 채팅방으로 올 메시지가 더 없으므로 채팅방 상태를 새 주인에게 넘깁니다(HANDOFF).
+ * -# 새 주인은 상태를 받을 때까지 들어온 메시지를 쌓아 두었다가, 받은 뒤 도착 순서대로 처리합니다.
+ *
+ * 울타리는 생산자가 submit() 또는 sync()를 호출할 때 넣으므로, 한가한 생산자도 주기적으로 sync()를 호출해야 이동이 끝납니다.
+ */
+
+#include "HashRing.h"
+#include "SpscQueue.h"
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class RoomWorkers
+ * @brief 채팅방을 작업자 스레드에 고정 배정하고, 생산자에서 작업자로 SPSC 큐로 메시지를 넘기는 실행기입니다.
+ *
+ * @note 생산자 객체(Producer) 하나는 한 스레드에서만 사용합니다. migrateRoom()과 통계 함수는 어느 스레드에서 호출해도 됩니다.
+ */
+class RoomWorkers
+{
+public:
+    /// (생산자, 작업자) 쌍 하나의 큐 용량.
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+    /// 작업자가 잠들기 전에 빈 큐를 다시 훑는 횟수.
+    static constexpr int IDLE_SPIN_COUNT = 256;
+
+    /// 작업자가 큐 하나에서 한 번에 꺼내는 최대 항목 수 (한 생산자가 다른 생산자를 굶기지 않게 합니다).
+    static constexpr int POP_BATCH = 64;
+
+    /// 작업자가 부하 통계를 게시하는 간격(밀리초).
+    static constexpr int STATS_INTERVAL_MS = 1000;
+
+public:
+    /**
+     * @struct RoomWorkers::Room
+     * @brief 채팅방 하나의 상태. 주인 작업자만 접근하며, 이동할 때 통째로 새 주인에게 넘어갑니다.
+     */
+    struct Room
+    {
+        std::string id;                 ///< 채팅방 ID.
+        std::uint64_t sequence = 0;     ///< 처리한 메시지 순번 (핸들러 호출 직전에 1 증가).
+        std::uint64_t windowCount = 0;  ///< 이번 통계 구간에 처리한 메시지 수.
+        std::any state;                 ///< 핸들러가 자유롭게 쓰는 채팅방 상태.
+    };
+
+    /**
+     * @struct RoomWorkers::WorkerStats
+     * @brief 작업자 하나의 부하 통계.
+     */
+    struct WorkerStats
+    {
+        int worker = 0;                     ///< 작업자 번호.
+        std::uint64_t processedCount = 0;   ///< 처리한 메시지의 누적 수.
+        std::size_t roomCount = 0;          ///< 맡고 있는 채팅방 수.
+        std::size_t queuedCount = 0;        ///< 들어오는 큐에 대기 중인 항목 수 (근삿값).
+        double messagesPerSecond = 0.0;     ///< 최근 통계 구간의 초당 처리량.
+        std::string hottestRoom;            ///< 최근 통계 구간에 가장 많이 처리한 채팅방 (없으면 빈 문자열).
+        double hottestRoomPerSecond = 0.0;  ///< 그 채팅방의 초당 처리량.
+    };
+
+    /**
+     * @brief 메시지 하나를 처리하는 함수. (작업자 번호, 채팅방, 제출할 때 붙인 값, 내용) 채팅방의 주인 작업자 스레드에서 호출됩니다.
+     * @note 내용은 처리가 끝나면 버리므로 핸들러가 고치거나 옮겨 가도 됩니다.
+     */
+    using Handler = std::function<void(int worker_index, RoomWorkers::Room& room, std::uint64_t tag, std::string& payload)>;
+
+private:
+    struct Routes;
+    struct Envelope;
+    struct WorkerState;
+
+public:
+    /**
+     * @class RoomWorkers::Producer
+     * @brief 생산자 스레드 하나가 쓰는 제출 창구. 작업자마다 전용 SPSC 큐를 가집니다.
+     */
+    class Producer
+    {
+    public:
+        /**
+         * @fn bool RoomWorkers::Producer::submit(const std::string& room, std::string payload, std::uint64_t tag)
+         * @brief 메시지를 채팅방 주인 작업자의 큐에 넣습니다.
+         * @param[IN] const std::string& room : 채팅방 ID.
+         * @param[IN] std::string payload : 내용.
+         * @param[IN] std::uint64_t tag : 핸들러에 그대로 전달할 값 (기본값 0). 보낸 사람처럼 내용 밖의 정보를 실어 보냅니다.
+         * @return bool : 넣었으면 true, 주인 작업자의 큐가 가득 찼으면 false (호출한 쪽이 다시 시도하거나 버립니다).
+         */
+        bool submit(const std::string& room, std::string payload, std::uint64_t tag = 0);
+
+        /**
+         * @fn void RoomWorkers::Producer::sync()
+         * @brief 경로 표가 바뀌었으면 이동 중인 채팅방의 이전 주인에게 울타리를 넣습니다.
+         * @return 없음.
+         * @note submit()도 같은 일을 하므로, 제출할 메시지가 없는 동안만 주기적으로 호출하면 됩니다.
+         */
+        void sync();
+
+    private:
+        friend class RoomWorkers;
+
+        /**
+         * @fn RoomWorkers::Producer::Producer(RoomWorkers& owner, int index)
+         * @brief 생산자 창구를 생성합니다. RoomWorkers만 생성합니다.
+         * @param[IN] RoomWorkers& owner : 소속 실행기.
+         * @param[IN] int index : 생산자 번호.
+         * @return 없음.
+         */
+        Producer(RoomWorkers& owner, int index);
+
+        /**
+         * @fn int RoomWorkers::Producer::route(const std::string& room) const
+         * @brief 이 생산자가 지금 보내야 할 작업자를 구합니다. 울타리를 아직 넣지 못한 채팅방은 이전 주인입니다.
+         * @param[IN] const std::string& room : 채팅방 ID.
+         * @return int : 작업자 번호.
+         */
+        int route(const std::string& room) const;
+
+    private:
+        /// 소속 실행기.
+        RoomWorkers& _owner;
+        /// 생산자 번호.
+        int _index;
+        /// 마지막으로 본 경로 표.
+        std::shared_ptr<const RoomWorkers::Routes> _routes;
+        /// 마지막으로 본 경로 표 번호 (_routes->version과 같음).
+        std::uint64_t _routesVersion;
+        /// 큐가 가득 차 아직 넣지 못한 울타리 (채팅방 → 이전 주인).
+        std::unordered_map<std::string, int> _pendingFences;
+    };
+
+public:
+    /**
+     * @fn RoomWorkers::RoomWorkers(int worker_count, int producer_count, RoomWorkers::Handler handler)
+     * @brief 작업자 스레드와 생산자 창구, (생산자, 작업자) 쌍마다 큐를 만듭니다.
+     * @param[IN] int worker_count : 작업자 스레드 수 (1 이상).
+     * @param[IN] int producer_count : 생산자 창구 수 (1 이상).
+     * @param[IN] RoomWorkers::Handler handler : 메시지 처리 함수.
+     * @return 없음.
+     */
+    RoomWorkers(int worker_count, int producer_count, RoomWorkers::Handler handler);
+
+    /**
+     * @fn RoomWorkers::~RoomWorkers()
+     * @brief 작업자 스레드를 멈추고 합류합니다. 큐에 남은 메시지는 처리하지 않습니다.
+     * @return 없음.
+     */
+    ~RoomWorkers();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    RoomWorkers(const RoomWorkers& obj) = delete;
+    RoomWorkers& operator=(const RoomWorkers& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    RoomWorkers(RoomWorkers&& obj) = delete;
+    RoomWorkers& operator=(RoomWorkers&& obj) = delete;
+
+public:
+    /**
+     * @fn RoomWorkers::Producer& RoomWorkers::getProducer(int index)
+     * @brief 생산자 창구를 반환합니다.
+     * @param[IN] int index : 생산자 번호 (0 이상 producer_count 미만).
+     * @return RoomWorkers::Producer& : 생산자 창구.
+     */
+    RoomWorkers::Producer& getProducer(int index);
+
+    /**
+     * @fn int RoomWorkers::getOwner(const std::string& room) const
+     * @brief 경로 표에 따른 채팅방의 주인 작업자를 반환합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return int : 작업자 번호.
+     */
+    int getOwner(const std::string& room) const;
+
+    /**
+     * @fn bool RoomWorkers::migrateRoom(const std::string& room, int worker_index)
+     * @brief 채팅방을 다른 작업자로 옮깁니다. 옮기는 동안에도 메시지는 순서대로 처리됩니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @param[IN] int worker_index : 새 주인 작업자 번호.
+     * @return bool : 이동을 시작했으면 true, 이미 그 작업자가 주인이거나 그 채팅방이 이동 중이거나 번호가 잘못되었으면 false.
+     */
+    bool migrateRoom(const std::string& room, int worker_index);
+
+    /**
+     * @fn bool RoomWorkers::migrateHottestRoom()
+     * @brief 가장 바쁜 작업자의 가장 바쁜 채팅방을 가장 한가한 작업자로 옮깁니다.
+     * @return bool : 옮겼으면 true, 옮겨도 치우침이 줄지 않거나 통계가 없으면 false.
+     * @note 채팅방 하나가 작업자 하나를 혼자 채우는 경우처럼, 옮기면 받는 쪽이 더 바빠지는 이동은 하지 않습니다.
+     */
+    bool migrateHottestRoom();
+
+    /**
+     * @fn std::vector<RoomWorkers::WorkerStats> RoomWorkers::getStats() const
+     * @brief 작업자별 부하 통계를 반환합니다.
+     * @return std::vector<RoomWorkers::WorkerStats> : 작업자 번호 순서의 통계.
+     */
+    std::vector<RoomWorkers::WorkerStats> getStats() const;
+
+    /**
+     * @fn double RoomWorkers::getSkew() const
+     * @brief 작업자 부하의 치우침을 반환합니다.
+     * @return double : 최근 초당 처리량의 (최댓값 / 평균). 고르면 1.0, 처리량이 없으면 0.
+     */
+    double getSkew() const;
+
+    /**
+     * @fn std::uint64_t RoomWorkers::getMigrationCount() const
+     * @brief 끝난 채팅방 이동의 누적 수를 반환합니다.
+     * @return std::uint64_t : 이동 횟수.
+     */
+    std::uint64_t getMigrationCount() const;
+
+    /**
+     * @fn int RoomWorkers::getWorkerCount() const
+     * @brief 작업자 수를 반환합니다.
+     * @return int : 작업자 수.
+     */
+    int getWorkerCount() const;
+
+private:
+    /**
+     * @struct RoomWorkers::Routes
+     * @brief 한 번 게시하면 바뀌지 않는 경로 표. 바꿀 때는 새 표를 만들어 포인터를 교체합니다.
+     */
+    struct Routes
+    {
+        std::uint64_t version = 0;                              ///< 게시할 때마다 1씩 늘어나는 번호.
+        std::unordered_map<std::string, int> overrides;         ///< 해시 링과 다른 작업자에 둔 채팅방.
+        std::unordered_map<std::string, int> migrating;         ///< 이동 중인 채팅방 → 이전 주인.
+    };
+
+    /**
+     * @struct RoomWorkers::Envelope
+     * @brief 큐로 오가는 항목 하나.
+     */
+    struct Envelope
+    {
+        /**
+         * @enum RoomWorkers::Envelope::Kind
+         * @brief 항목 종류.
+         */
+        enum class Kind
+        {
+            MESSAGE,    ///< 처리할 메시지.
+            FENCE,      ///< 생산자 하나가 이 채팅방을 이전 주인에게 더 보내지 않음.
+            HANDOFF     ///< 이전 주인이 넘기는 채팅방 상태.
+        };
+
+        Kind kind = Kind::MESSAGE;                  ///< 항목 종류.
+        std::string room;                           ///< 채팅방 ID.
+        std::string payload;                        ///< MESSAGE의 내용.
+        std::uint64_t tag = 0;                      ///< MESSAGE에 붙인 값.
+        std::unique_ptr<RoomWorkers::Room> state;   ///< HANDOFF의 채팅방 상태.
+    };
+
+    /**
+     * @struct RoomWorkers::StatsSnapshot
+     * @brief 작업자가 STATS_INTERVAL_MS마다 게시하는 통계.
+     */
+    struct StatsSnapshot
+    {
+        std::chrono::steady_clock::time_point publishedAt;  ///< 게시 시각.
+        std::size_t roomCount = 0;                          ///< 맡고 있는 채팅방 수.
+        double messagesPerSecond = 0.0;                     ///< 구간의 초당 처리량.
+        std::string hottestRoom;                            ///< 구간에 가장 많이 처리한 채팅방.
+        double hottestRoomPerSecond = 0.0;                  ///< 그 채팅방의 초당 처리량.
+    };
+
+    /**
+     * @struct RoomWorkers::Worker
+     * @brief 작업자 하나의 스레드와, 다른 스레드가 함께 보는 값. 작업자끼리 캐시 줄을 나누어 쓰지 않도록 정렬합니다.
+     */
+    struct alignas(64) Worker
+    {
+        std::thread thread;                                         ///< 작업자 스레드.
+        std::atomic<std::uint32_t> signal{ 0 };                     ///< 잠든 작업자를 깨울 때 늘리는 값 (atomic wait 대상).
+        std::atomic<bool> sleeping{ false };                        ///< 작업자가 잠들려는 중이면 true.
+        std::atomic<std::uint64_t> processedCount{ 0 };             ///< 처리한 메시지의 누적 수.
+        std::atomic<std::shared_ptr<const StatsSnapshot>> stats;    ///< 마지막으로 게시한 통계.
+    };
+
+private:
+    /// 작업자 수.
+    int _workerCount;
+    /// 생산자 창구 수.
+    int _producerCount;
+    /// 메시지 처리 함수.
+    RoomWorkers::Handler _handler;
+    /// 작업자 번호로 만든 해시 링 (생성 후 바뀌지 않으므로 모든 스레드가 읽습니다).
+    HashRing _ring;
+    /// 현재 경로 표.
+    std::atomic<std::shared_ptr<const RoomWorkers::Routes>> _routes;
+    /// 현재 경로 표 번호. 생산자는 이 값이 바뀌었을 때만 경로 표를 다시 읽습니다.
+    std::atomic<std::uint64_t> _routesVersion;
+    /// 경로 표를 바꾸는 쪽끼리의 잠금 (데이터 경로에서는 잡지 않습니다).
+    mutable std::mutex _controlMutex;
+    /// 보낸 쪽(생산자 다음에 작업자) × 받는 작업자 순서로 놓인 큐.
+    std::vector<std::unique_ptr<SpscQueue<RoomWorkers::Envelope>>> _queues;
+    /// 작업자.
+    std::vector<std::unique_ptr<RoomWorkers::Worker>> _workers;
+    /// 생산자 창구.
+    std::vector<std::unique_ptr<RoomWorkers::Producer>> _producers;
+    /// 끝난 이동의 누적 수.
+    std::atomic<std::uint64_t> _migrationCount;
+    /// 소멸 중이면 true.
+    std::atomic<bool> _stopping;
+
+private:
+    /**
+     * @fn SpscQueue<RoomWorkers::Envelope>& RoomWorkers::getQueue(int sender, int worker_index)
+     * @brief 보낸 쪽에서 작업자로 가는 큐를 반환합니다.
+     * @param[IN] int sender : 생산자 번호, 작업자가 보낼 때는 (생산자 수 + 작업자 번호).
+     * @param[IN] int worker_index : 받는 작업자 번호.
+     * @return SpscQueue<RoomWorkers::Envelope>& : 큐.
+     */
+    SpscQueue<RoomWorkers::Envelope>& getQueue(int sender, int worker_index);
+
+    /**
+     * @fn bool RoomWorkers::push(int sender, int worker_index, RoomWorkers::Envelope& envelope)
+     * @brief 항목을 큐에 넣고, 작업자가 잠들어 있으면 깨웁니다.
+     * @param[IN] int sender : 보낸 쪽 번호.
+     * @param[IN] int worker_index : 받는 작업자 번호.
+     * @param[IN, OUT] RoomWorkers::Envelope& envelope : 넣을 항목 (성공하면 옮겨집니다).
+     * @return bool : 넣었으면 true, 큐가 가득 찼으면 false.
+     */
+    bool push(int sender, int worker_index, RoomWorkers::Envelope& envelope);
+
+    /**
+     * @fn int RoomWorkers::findOwner(const RoomWorkers::Routes& routes, const std::string& room) const
+     * @brief 경로 표에서 채팅방의 주인을 찾습니다.
+     * @param[IN] const RoomWorkers::Routes& routes : 경로 표.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return int : 작업자 번호.
+     */
+    int findOwner(const RoomWorkers::Routes& routes, const std::string& room) const;
+
+    /**
+     * @fn void RoomWorkers::completeMigration(const std::string& room)
+     * @brief 새 주인이 상태를 받은 뒤 이동 중 기록을 지운 경로 표를 게시합니다.
+     * @param[IN] const std::string& room : 채팅방 ID.
+     * @return 없음.
+     */
+    void completeMigration(const std::string& room);
+
+    /**
+     * @fn void RoomWorkers::handleEnvelope(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Envelope& envelope)
+     * @brief 작업자가 꺼낸 항목 하나를 처리합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @param[IN, OUT] RoomWorkers::WorkerState& state : 작업자 전용 상태.
+     * @param[IN, OUT] RoomWorkers::Envelope& envelope : 꺼낸 항목.
+     * @return 없음.
+     *
+     * @details
+     * - MESSAGE : 채팅방 상태가 없고 이 작업자로 이동 중인 채팅방이면 쌓아 두고, 아니면 (없으면 만들어) 핸들러를 호출합니다.
+     * - FENCE : 모든 생산자의 울타리가 모이면 채팅방 상태를 새 주인에게 넘길 항목을 보낼 목록에 넣습니다.
+     * - HANDOFF : 상태를 넣고 쌓아 둔 메시지를 도착 순서대로 처리한 뒤 이동을 끝냅니다.
+     */
+    void handleEnvelope(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Envelope& envelope);
+
+    /**
+     * @fn void RoomWorkers::processMessage(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Room& room, RoomWorkers::Envelope& envelope)
+     * @brief 채팅방 순번을 올리고 핸들러를 호출합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @param[IN, OUT] RoomWorkers::WorkerState& state : 작업자 전용 상태.
+     * @param[IN, OUT] RoomWorkers::Room& room : 채팅방 상태.
+     * @param[IN, OUT] RoomWorkers::Envelope& envelope : 처리할 MESSAGE (내용은 핸들러에 넘깁니다).
+     * @return 없음.
+     */
+    void processMessage(int worker_index, RoomWorkers::WorkerState& state, RoomWorkers::Room& room, RoomWorkers::Envelope& envelope);
+
+    /**
+     * @fn void RoomWorkers::publishStats(int worker_index, RoomWorkers::WorkerState& state)
+     * @brief 이번 통계 구간의 처리량과 가장 바쁜 채팅방을 게시하고 구간을 새로 시작합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @param[IN, OUT] RoomWorkers::WorkerState& state : 작업자 전용 상태.
+     * @return 없음.
+     */
+    void publishStats(int worker_index, RoomWorkers::WorkerState& state);
+
+    /**
+     * @fn bool RoomWorkers::hasInbound(int worker_index) const
+     * @brief 작업자로 들어오는 큐에 항목이 있는지 확인합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @return bool : 하나라도 있으면 true.
+     */
+    bool hasInbound(int worker_index) const;
+
+    /**
+     * @fn void RoomWorkers::workerLoop(int worker_index)
+     * @brief 작업자 스레드 본문. 들어오는 큐를 돌며 메시지, 울타리, 상태 넘겨받기를 처리합니다.
+     * @param[IN] int worker_index : 작업자 번호.
+     * @return 없음.
+     */
+    void workerLoop(int worker_index);
+};
@@ -9,36 +9,37 @@
 
 #include "SelectManager.h"
 #include "DebugHelper.h"
+#include "TraceRecorder.h"
+#include "TransportInstances.h"
 
-static timeval make_timer(long sec, long usec)
-{
-    timeval timeout;
-    timeout.tv_sec = sec;
-    timeout.tv_usec = usec;
-    return (timeout);
-}
-
-SelectManager::SelectManager()
-    : _originSet(), _copySet(), _socketCount(0)
+template <typename Transport>
+SelectManager<Transport>::SelectManager(Transport& transport)
+    : _transport(transport), _originSet(), _copySet(), _socketCount(0), _originConnectSet(), _copyConnectSet(), _connectingCount(0)
 {
     LOG_DEBUG("SelectManager 객체를 생성합니다.");
 }
 
-SelectManager::~SelectManager()
+template <typename Transport>
+SelectManager<Transport>::~SelectManager()
 {
     LOG_DEBUG("SelectManager 객체를 삭제합니다.");
 }
 
-void SelectManager::setupFdSet()
+template <typename Transport>
+void SelectManager<Transport>::setupFdSet()
 {
     // fd_set 초기화.
     FD_ZERO(&this->_originSet);
     this->_socketCount = 0;
+    FD_ZERO(&this->_originConnectSet);
+    FD_ZERO(&this->_copyConnectSet);
+    this->_connectingCount = 0;
 
     LOG_DEBUG("fd_set과 소켓 count를 초기화합니다.");
 }
 
-bool SelectManager::addSocket(SOCKET socket)
+template <typename Transport>
+bool SelectManager<Transport>::addSocket(SOCKET socket)
 {
     // 유효한 소켓인지 확인합니다.
     if (socket == INVALID_SOCKET)
@@ -55,10 +56,33 @@ bool SelectManager::addSocket(SOCKET socket)
     return (true);
 }
 
-SelectManager::Result SelectManager::executeSelect(int timeout_sec)
+template <typename Transport>
+bool SelectManager<Transport>::addConnectingSocket(SOCKET socket)
+{
+    if (socket == INVALID_SOCKET)
+    {
+        LOG_WARN("연결 대기 소켓 등록 시 유효하지 않은 소켓이 확인되었습니다.");
+        return (false);
+    }
+
+    FD_SET(socket, &this->_originConnectSet);
+    this->_connectingCount = this->_connectingCount + 1;
+    return (true);
+}
+
+template <typename Transport>
+SelectManagerBase::Result SelectManager<Transport>::executeSelect(int timeout_sec)
+{
+    return (this->executeSelectMillis(timeout_sec * 1000));
+}
+
+template <typename Transport>
+SelectManagerBase::Result SelectManager<Transport>::executeSelectMillis(int timeout_ms)
 {
+    TRACE_SCOPE("SelectManager::executeSelectMillis");
+
     // 감시할 소켓이 없으면 바로 탈출합니다.
-    if (this->_socketCount == 0)
+    if (this->_socketCount == 0 && this->_connectingCount == 0)
     {
         LOG_DEBUG("감시할 소켓이 없습니다.");
         return (SelectManager::Result::NO_SOCKETS);
@@ -68,17 +92,23 @@ SelectManager::Result SelectManager::executeSelect(int timeout_sec)
     // select 함수가 인자의 fd_set을 수정하므로 원본을 수정하지 않기 위해 복사해서 사용합니다.
     this->_copySet = this->_originSet;
 
-    // select에 사용할 timeout 설정.
-    timeval timeout = make_timer(timeout_sec, 0);
-
-    // Windows에서는 select함수의 첫번 째 매개변수가 무시됩니다.(원래는 최대 값의 소켓 id).
     // 읽기 준비가 된 소켓을 수를 리턴합니다.
-    int result = select(0, &this->_copySet, nullptr, nullptr, &timeout);
+    // 연결 중인 소켓이 있을 때만 쓰기 집합을 함께 넘깁니다.
+    int result = 0;
+    if (this->_connectingCount > 0)
+    {
+        this->_copyConnectSet = this->_originConnectSet;
+        result = this->_transport.selectSockets(&this->_copySet, &this->_copyConnectSet, timeout_ms);
+    }
+    else
+    {
+        result = this->_transport.selectReadable(&this->_copySet, timeout_ms);
+    }
 
     // select 결과에 따른 분기.
     if (result == SOCKET_ERROR)
     {
-        LOG_ERROR("slect 함수 실행 실패\n 에러 코드: " + std::to_string(WSAGetLastError()));
+        LOG_ERROR("slect 함수 실행 실패\n 에러 코드: " + std::to_string(this->_transport.getLastError()));
         return (SelectManager::Result::FAIL_SELECT);
     }
     else if (result == 0)
@@ -95,9 +125,18 @@ SelectManager::Result SelectManager::executeSelect(int timeout_sec)
     }
 }
 
-bool SelectManager::isSocketReady(SOCKET socket) const
+template <typename Transport>
+bool SelectManager<Transport>::isSocketReady(SOCKET socket) const
 {
     // FD_ISSET를 사용하여 fd_set에서 소켓이 읽기가 준비되었는지 체크합니다.
     // select() 실행 후 복사된 fd_set에는 읽기가 준비된 소켓만 남아있습니다.
     return (FD_ISSET(socket, &this->_copySet));
 }
+
+template <typename Transport>
+bool SelectManager<Transport>::isConnectDone(SOCKET socket) const
+{
+    return (FD_ISSET(socket, &this->_copyConnectSet));
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(SelectManager);
@@ -12,24 +12,20 @@
  * 감시할 소켓 집합을 유지하고, 소켓이 준비되었는지, 타임아웃됐는지, 오류가 발생했는지를 나타내는 결과를 제공합니다.
  */
 
-#include <WinSock2.h>
+#include "NetworkTransport.h"
 
  /**
-  * @class SelectManager
-  * @brief 소켓 집합을 관리하고 select()를 사용하여 네트워크 I/O를 다중화합니다.
+  * @class SelectManagerBase
+  * @brief 전송 계층과 무관한 SelectManager의 결과 값을 담습니다.
   *
-  * @details
-  * SelectManager는 select에 필요한 fd_set 구조체를 래핑합니다.
-  * <br>소켓을 추가하여 select 연산을 수행하는 메서드를 제공합니다.
-  * <br>어떤 소켓에 수신 데이터가 있는지(읽기 준비 완료 상태인지)를 확인합니다.
-  * <br>타임아웃 상황을 처리할 수 있습니다.
+  * @note 전송 계층마다 SelectManager 인스턴스가 달라도 결과 타입은 하나이므로, 바깥에서는 SelectManagerBase::Result로 씁니다.
   */
-class SelectManager
+class SelectManagerBase
 {
 public:
 
 	/**
-	 * @enum SelectManager::Result
+	 * @enum SelectManagerBase::Result
 	 * @brief select 연산에 대한 결과 상태 값입니다.
 	 */
 	enum class Result
@@ -39,17 +35,34 @@ public:
 		FAIL_SELECT,	///< select 호출이 실패한 경우 (예: 잘못된 소켓 등 오류로 인해).
 		NO_SOCKETS		///< 모니터링할 소켓이 하나도 설정되지 않은 경우 (select가 호출되지 않음).
 	};
+};
 
+ /**
+  * @class SelectManager
+  * @brief 소켓 집합을 관리하고 select()를 사용하여 네트워크 I/O를 다중화합니다.
+  * @tparam Transport : select 호출에 사용할 전송 계층 타입.
+  *
+  * @details
+  * SelectManager는 select에 필요한 fd_set 구조체를 래핑합니다.
+  * <br>소켓을 추가하여 select 연산을 수행하는 메서드를 제공합니다.
+  * <br>어떤 소켓에 수신 데이터가 있는지(읽기 준비 완료 상태인지)를 확인합니다.
+  * <br>논블로킹 connect가 진행 중인 소켓은 쓰기 집합으로 함께 감시해, 연결이 끝났는지 확인합니다.
+  * <br>타임아웃 상황을 처리할 수 있습니다.
+  */
+template <typename Transport>
+class SelectManager : public SelectManagerBase
+{
 public:
 	/**
-	 * @fn SelectManager::SelectManager()
+	 * @fn SelectManager::SelectManager(Transport& transport)
 	 * @brief SelectManager를 생성하여 내부 소켓 집합을 초기화합니다.
+	 * @param[IN] Transport& transport : select 호출에 사용할 전송 계층.
 	 * @return 없음.
 	 *
 	 * @details
 	 * 빈 fd_set들을 준비합니다.
 	 */
-	SelectManager();
+	explicit SelectManager(Transport& transport);
 
 	/**
 	 * @fn SelectManager::~SelectManager()
@@ -91,6 +104,14 @@ public:
 	 */
 	bool addSocket(SOCKET socket);
 
+	/**
+	 * @fn bool SelectManager::addConnectingSocket(SOCKET socket)
+	 * @brief startConnect()로 연결 중인 소켓을 쓰기 집합에 추가해 연결이 끝나기를 기다립니다.
+	 * @param[IN] SOCKET socket : 연결 중인 소켓입니다.
+	 * @return bool : 추가했으면 true, 잘못된 소켓이면 false를 반환합니다.
+	 */
+	bool addConnectingSocket(SOCKET socket);
+
 	/**
 	 * @fn SelectManager::Result SelectManager::executeSelect(int timeout_sec)
 	 * @brief 현재 설정된 소켓 집합에 대해 select() 시스템 호출을 수행합니다.
@@ -105,6 +126,16 @@ public:
 	 */
 	SelectManager::Result executeSelect(int timeout_sec = 1);
 
+	/**
+	 * @fn SelectManager::Result SelectManager::executeSelectMillis(int timeout_ms)
+	 * @brief executeSelect()와 같지만 대기 시간을 밀리초 단위로 지정합니다.
+	 * @param[IN] int timeout_ms : 이벤트를 기다릴 시간(밀리초)입니다. 0이면 기다리지 않고 바로 반환합니다.
+	 * @return SelectManager::Result : select 연산의 결과를 반환합니다 (SUCCESS, TIMEOUT, FAIL_SELECT 또는 NO_SOCKETS).
+	 *
+	 * @note 세션 코루틴의 sleepFor()처럼 1초보다 짧은 타이머를 맞출 때 사용합니다.
+	 */
+	SelectManager::Result executeSelectMillis(int timeout_ms);
+
 	/**
 	 * @fn bool SelectManager::isSocketReady(SOCKET socket) const
 	 * @brief 해당 소켓이 "읽기 준비 완료"로 표시되었는지 확인합니다.
@@ -117,7 +148,18 @@ public:
 	 */
 	bool isSocketReady(SOCKET socket) const;
 
+	/**
+	 * @fn bool SelectManager::isConnectDone(SOCKET socket) const
+	 * @brief addConnectingSocket()으로 추가한 소켓의 연결이 끝났는지 확인합니다.
+	 * @param[IN] SOCKET socket : 확인할 소켓입니다.
+	 * @return bool : 연결이 성공했거나 실패해 끝났으면 true를 반환합니다. 성공 여부는 NetworkTransport::getConnectResult()로 확인합니다.
+	 */
+	bool isConnectDone(SOCKET socket) const;
+
 private:
+	/// select 호출에 사용하는 전송 계층.
+	Transport& _transport;
+
 	/// 재사용 가능한 원본 소켓 집합 (모니터링할 소켓들의 집합).
 	fd_set _originSet;
 
@@ -126,5 +168,14 @@ private:
 
 	/// 현재 집합에 포함된 소켓 개수입니다.
 	int  _socketCount;
+
+	/// 연결이 끝나기를 기다리는 소켓 집합입니다.
+	fd_set _originConnectSet;
+
+	/// select()에 전달되는 연결 대기 소켓 집합의 복사본입니다.
+	fd_set _copyConnectSet;
+
+	/// 연결이 끝나기를 기다리는 소켓 개수입니다.
+	int  _connectingCount;
 };
 
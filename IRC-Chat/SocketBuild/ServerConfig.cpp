@@ -0,0 +1,352 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ServerConfig.cpp
+ * @brief ServerConfig.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "ServerConfig.h"
+#include "DebugHelper.h"
+#include <charconv>
+#include <fstream>
+
+/**
+ * @brief 앞뒤 공백과 탭을 잘라 냅니다.
+ */
+static std::string trimBlank(const std::string& text)
+{
+    std::size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos)
+    {
+        return ("");
+    }
+    std::size_t last = text.find_last_not_of(" \t");
+    return (text.substr(first, last - first + 1));
+}
+
+ServerConfig::ServerConfig()
+    : _port(5500), _sessionMode(MultiServerBase::SessionMode::COROUTINE), _busyPoll(false), _pinnedCore(-1), _fanoutWorkerCount(0), _roomWorkerCount(0),
+      _datagramChannel(false), _gameBridgeName(), _clusterPort(0), _clusterPeers(),
+      _chatFilterFile(), _moderatorPassword()
+{
+}
+
+ServerConfig::Result ServerConfig::load(int argc, char* argv[])
+{
+    ServerConfig::Result result = this->loadFile(ServerConfig::DEFAULT_FILE);
+    if (result == ServerConfig::Result::FAIL_OPEN)
+    {
+        LOG_INFO(std::string(ServerConfig::DEFAULT_FILE) + " 파일이 없어 기본 설정으로 시작합니다.");
+    }
+    else if (result != ServerConfig::Result::SUCCESS)
+    {
+        return (result);
+    }
+
+    return (this->parseArguments(argc, argv));
+}
+
+ServerConfig::Result ServerConfig::loadFile(const std::string& file_path)
+{
+    std::ifstream in(file_path, std::ios::in | std::ios::binary);
+    if (in.is_open() == false)
+    {
+        return (ServerConfig::Result::FAIL_OPEN);
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line))
+    {
+        line_number = line_number + 1;
+
+        // 메모장으로 저장한 파일의 BOM과 CRLF를 지웁니다.
+        if (line_number == 1 && line.rfind("\xEF\xBB\xBF", 0) == 0)
+        {
+            line.erase(0, 3);
+        }
+        if (line.empty() == false && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        line = trimBlank(line);
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::size_t equal = line.find('=');
+        if (equal == std::string::npos
+            || this->setValue(trimBlank(line.substr(0, equal)), trimBlank(line.substr(equal + 1))) != ServerConfig::Result::SUCCESS)
+        {
+            LOG_ERROR("설정 파일의 " + std::to_string(line_number) + "번째 줄을 읽을 수 없습니다: " + file_path);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+    }
+
+    LOG_INFO("설정 파일을 읽었습니다: " + file_path);
+    return (ServerConfig::Result::SUCCESS);
+}
+
+ServerConfig::Result ServerConfig::parseArguments(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i = i + 2)
+    {
+        std::string option = argv[i];
+        if (option.rfind("--", 0) != 0 || i + 1 >= argc)
+        {
+            LOG_ERROR("명령줄 인자는 \"--키 값\" 형식이어야 합니다: " + option);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+
+        std::string key = option.substr(2);
+        std::string value = argv[i + 1];
+        ServerConfig::Result result = ServerConfig::Result::SUCCESS;
+        if (key == "config")
+        {
+            result = this->loadFile(value);
+            if (result == ServerConfig::Result::FAIL_OPEN)
+            {
+                LOG_ERROR("설정 파일을 열 수 없습니다: " + value);
+            }
+        }
+        else
+        {
+            result = this->setValue(key, value);
+        }
+
+        if (result != ServerConfig::Result::SUCCESS)
+        {
+            return (result);
+        }
+    }
+
+    return (ServerConfig::Result::SUCCESS);
+}
+
+ServerConfig::Result ServerConfig::setValue(const std::string& key, const std::string& value)
+{
+    if (key == "port")
+    {
+        if (ServerConfig::parseInteger(value, 1, 65535, this->_port) == false)
+        {
+            LOG_ERROR("port 값이 올바르지 않습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "session_mode")
+    {
+        if (value == "handler")
+        {
+            this->_sessionMode = MultiServerBase::SessionMode::HANDLER;
+        }
+        else if (value == "coroutine")
+        {
+            this->_sessionMode = MultiServerBase::SessionMode::COROUTINE;
+        }
+        else
+        {
+            LOG_ERROR("session_mode는 handler 또는 coroutine이어야 합니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "busy_poll")
+    {
+        if (ServerConfig::parseSwitch(value, this->_busyPoll) == false)
+        {
+            LOG_ERROR("busy_poll은 on 또는 off여야 합니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "pinned_core")
+    {
+        // 스레드 선호도 마스크(DWORD_PTR)의 비트 수를 넘는 코어는 고를 수 없습니다.
+        if (ServerConfig::parseInteger(value, -1, 63, this->_pinnedCore) == false)
+        {
+            LOG_ERROR("pinned_core 값이 올바르지 않습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "fanout_workers")
+    {
+        if (ServerConfig::parseInteger(value, 0, 64, this->_fanoutWorkerCount) == false)
+        {
+            LOG_ERROR("fanout_workers 값이 올바르지 않습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "room_workers")
+    {
+        if (ServerConfig::parseInteger(value, 0, 64, this->_roomWorkerCount) == false)
+        {
+            LOG_ERROR("room_workers 값이 올바르지 않습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "datagram_channel")
+    {
+        if (ServerConfig::parseSwitch(value, this->_datagramChannel) == false)
+        {
+            LOG_ERROR("datagram_channel은 on 또는 off여야 합니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "game_bridge")
+    {
+        // 브리지가 이름 앞에 Local 네임스페이스를 붙이므로, 이름 자체에는 백슬래시를 쓸 수 없습니다.
+        if (value.find('\\') != std::string::npos)
+        {
+            LOG_ERROR("game_bridge 이름에 '\\'를 쓸 수 없습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        this->_gameBridgeName = value;
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "cluster_port")
+    {
+        if (ServerConfig::parseInteger(value, 1, 65535, this->_clusterPort) == false)
+        {
+            LOG_ERROR("cluster_port 값이 올바르지 않습니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "cluster_peer")
+    {
+        // "주소:포트" 형식입니다. 같은 키를 여러 번 적으면 노드가 차례로 추가됩니다.
+        ServerConfig::ClusterPeer peer = {};
+        std::size_t colon = value.rfind(':');
+        if (colon == std::string::npos || colon == 0
+            || ServerConfig::parseInteger(value.substr(colon + 1), 1, 65535, peer.port) == false)
+        {
+            LOG_ERROR("cluster_peer는 \"주소:포트\" 형식이어야 합니다: " + value);
+            return (ServerConfig::Result::FAIL_VALUE);
+        }
+        peer.host = value.substr(0, colon);
+        this->_clusterPeers.push_back(peer);
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "chat_filter")
+    {
+        this->_chatFilterFile = value;
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    if (key == "moderator_password")
+    {
+        this->_moderatorPassword = value;
+        return (ServerConfig::Result::SUCCESS);
+    }
+
+    LOG_ERROR("알 수 없는 설정 키입니다: " + key);
+    return (ServerConfig::Result::FAIL_VALUE);
+}
+
+int ServerConfig::getPort() const
+{
+    return (this->_port);
+}
+
+MultiServerBase::SessionMode ServerConfig::getSessionMode() const
+{
+    return (this->_sessionMode);
+}
+
+bool ServerConfig::isBusyPollEnabled() const
+{
+    return (this->_busyPoll);
+}
+
+int ServerConfig::getPinnedCore() const
+{
+    return (this->_pinnedCore);
+}
+
+int ServerConfig::getFanoutWorkerCount() const
+{
+    return (this->_fanoutWorkerCount);
+}
+
+int ServerConfig::getRoomWorkerCount() const
+{
+    return (this->_roomWorkerCount);
+}
+
+bool ServerConfig::isDatagramChannelEnabled() const
+{
+    return (this->_datagramChannel);
+}
+
+const std::string& ServerConfig::getGameBridgeName() const
+{
+    return (this->_gameBridgeName);
+}
+
+int ServerConfig::getClusterPort() const
+{
+    return (this->_clusterPort);
+}
+
+const std::vector<ServerConfig::ClusterPeer>& ServerConfig::getClusterPeers() const
+{
+    return (this->_clusterPeers);
+}
+
+const std::string& ServerConfig::getChatFilterFile() const
+{
+    return (this->_chatFilterFile);
+}
+
+const std::string& ServerConfig::getModeratorPassword() const
+{
+    return (this->_moderatorPassword);
+}
+
+bool ServerConfig::parseInteger(const std::string& text, int min_value, int max_value, int& value)
+{
+    int parsed = 0;
+    const char* end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, parsed);
+    if (text.empty() || result.ec != std::errc() || result.ptr != end || parsed < min_value || parsed > max_value)
+    {
+        return (false);
+    }
+
+    value = parsed;
+    return (true);
+}
+
+bool ServerConfig::parseSwitch(const std::string& text, bool& value)
+{
+    if (text == "on")
+    {
+        value = true;
+        return (true);
+    }
+    if (text == "off")
+    {
+        value = false;
+        return (true);
+    }
+    return (false);
+}
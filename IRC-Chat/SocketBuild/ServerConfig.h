@@ -0,0 +1,248 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file ServerConfig.h
+ * @brief 설정 파일과 명령줄 인자로 서버 실행 옵션을 읽는 ServerConfig 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 설정 파일은 한 줄에 "키 = 값" 하나씩 적고, '#'으로 시작하는 줄은 주석입니다.
+ * <br>명령줄에서는 "--키 값"으로 같은 키를 지정하며, 파일보다 나중에 읽으므로 파일의 값을 덮어씁니다.
+ * <br>"--config 경로"는 그 자리에서 다른 설정 파일을 읽습니다.
+ * - port : 채팅 TCP 포트 (기본값 5500).
+ * - session_mode : handler 또는 coroutine (기본값 coroutine). 재접속("/resume")은 coroutine에서만 동작합니다.
+ * - busy_poll : on 또는 off (기본값 off). 켜면 지연 시간을 CPU보다 우선하는 바쁜 폴링 루프로 실행합니다.
+ * - pinned_core : busy_poll이 켜졌을 때 루프 스레드를 고정할 CPU 코어 번호 0~63 (기본값 -1 : 고정하지 않음).
+ * - fanout_workers : 큰 방의 브로드캐스트를 나누어 처리할 작업자 스레드 수 0~64 (기본값 0 : 루프 스레드에서만 처리).
+ * - room_workers : 채팅방 채팅을 채팅방별로 고정해 처리할 작업자 스레드 수 0~64 (기본값 0 : 루프 스레드에서만 처리).
+ * - datagram_channel : on 또는 off (기본값 off). 켜면 채팅 포트와 같은 번호의 UDP 포트로 입력 중 표시, 핑 같은 일회성 이벤트를 받습니다.
+ * - game_bridge : 같은 호스트의 게임 서버와 메시지를 주고받을 공유 메모리 이름 (기본값 비어 있음 : 브리지를 열지 않음).
+ * - cluster_port : 다른 노드와의 링크를 받는 클러스터 포트 (기본값 0 : 클러스터 모드를 쓰지 않음). 노드마다 달라야 합니다.
+ * - cluster_peer : 다른 노드의 "IPv4주소:클러스터포트". 여러 번 적어 나머지 노드를 모두 등록합니다.
+ * - moderator_password : "/mod <암호>"로 운영자 권한을 얻을 암호 (기본값 비어 있음 : 아무도 운영자가 될 수 없음).
+ * - chat_filter : 금칙어 파일 경로 (기본값 비어 있음 : 필터를 쓰지 않음). 운영자가 "/reload"로 다시 읽게 할 수 있습니다.
+ */
+
+#include "MultiServer.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class ServerConfig
+ * @brief 서버 실행 옵션을 보관하고 설정 파일과 명령줄 인자에서 읽어 들이는 클래스입니다.
+ */
+class ServerConfig
+{
+public:
+    /**
+     * @enum ServerConfig::Result
+     * @brief 설정 읽기 결과.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 모두 읽었습니다.
+        FAIL_OPEN,      ///< 설정 파일을 열 수 없습니다.
+        FAIL_VALUE      ///< 알 수 없는 키이거나 값이 올바르지 않습니다.
+    };
+
+    /// 실행 파일과 같은 폴더에서 찾는 기본 설정 파일 (없으면 기본값으로 실행합니다).
+    static constexpr const char* DEFAULT_FILE = "server.cfg";
+
+    /**
+     * @struct ServerConfig::ClusterPeer
+     * @brief cluster_peer로 등록한 다른 클러스터 노드.
+     */
+    struct ClusterPeer
+    {
+        std::string host;       ///< 노드의 IPv4 주소.
+        int port;               ///< 노드의 클러스터 포트.
+    };
+
+public:
+    /**
+     * @fn ServerConfig::ServerConfig()
+     * @brief 모든 옵션을 기본값으로 초기화합니다.
+     * @return 없음.
+     */
+    ServerConfig();
+
+public:
+    /**
+     * @fn ServerConfig::Result ServerConfig::load(int argc, char* argv[])
+     * @brief 기본 설정 파일이 있으면 읽은 뒤 명령줄 인자를 적용합니다.
+     * @param[IN] int argc : 인자 수.
+     * @param[IN] char* argv[] : 인자 배열 (argv[0]은 실행 파일 경로).
+     * @return ServerConfig::Result : 결과.
+     */
+    ServerConfig::Result load(int argc, char* argv[]);
+
+    /**
+     * @fn ServerConfig::Result ServerConfig::loadFile(const std::string& file_path)
+     * @brief 설정 파일을 읽어 적용합니다.
+     * @param[IN] const std::string& file_path : UTF-8 설정 파일 경로.
+     * @return ServerConfig::Result : 결과. 잘못된 줄이 있으면 그 앞의 줄까지만 적용됩니다.
+     */
+    ServerConfig::Result loadFile(const std::string& file_path);
+
+    /**
+     * @fn ServerConfig::Result ServerConfig::parseArguments(int argc, char* argv[])
+     * @brief "--키 값" 형식의 명령줄 인자를 적용합니다.
+     * @param[IN] int argc : 인자 수.
+     * @param[IN] char* argv[] : 인자 배열 (argv[0]은 건너뜁니다).
+     * @return ServerConfig::Result : 결과.
+     */
+    ServerConfig::Result parseArguments(int argc, char* argv[]);
+
+    /**
+     * @fn ServerConfig::Result ServerConfig::setValue(const std::string& key, const std::string& value)
+     * @brief 키 하나의 값을 적용합니다.
+     * @param[IN] const std::string& key : 키 (예: "port").
+     * @param[IN] const std::string& value : 값.
+     * @return ServerConfig::Result : 알 수 없는 키이거나 값이 올바르지 않으면 FAIL_VALUE.
+     */
+    ServerConfig::Result setValue(const std::string& key, const std::string& value);
+
+    /**
+     * @fn int ServerConfig::getPort() const
+     * @brief 채팅 TCP 포트를 반환합니다.
+     * @return int : 포트 번호.
+     */
+    int getPort() const;
+
+    /**
+     * @fn MultiServerBase::SessionMode ServerConfig::getSessionMode() const
+     * @brief 세션 로직 실행 방식을 반환합니다.
+     * @return MultiServerBase::SessionMode : 실행 방식.
+     */
+    MultiServerBase::SessionMode getSessionMode() const;
+
+    /**
+     * @fn bool ServerConfig::isBusyPollEnabled() const
+     * @brief 바쁜 폴링 루프 모드를 켤지 반환합니다.
+     * @return bool : busy_poll = on이면 true.
+     */
+    bool isBusyPollEnabled() const;
+
+    /**
+     * @fn int ServerConfig::getPinnedCore() const
+     * @brief 바쁜 폴링 루프 스레드를 고정할 CPU 코어 번호를 반환합니다.
+     * @return int : 코어 번호, 고정하지 않으면 -1.
+     */
+    int getPinnedCore() const;
+
+    /**
+     * @fn int ServerConfig::getFanoutWorkerCount() const
+     * @brief 병렬 팬아웃에 더 쓸 작업자 스레드 수를 반환합니다.
+     * @return int : 스레드 수, 병렬 팬아웃을 쓰지 않으면 0.
+     */
+    int getFanoutWorkerCount() const;
+
+    /**
+     * @fn int ServerConfig::getRoomWorkerCount() const
+     * @brief 채팅방 채팅을 처리할 작업자 스레드 수를 반환합니다.
+     * @return int : 스레드 수, 채팅방 작업자를 쓰지 않으면 0.
+     */
+    int getRoomWorkerCount() const;
+
+    /**
+     * @fn bool ServerConfig::isDatagramChannelEnabled() const
+     * @brief 일회성 이벤트용 UDP 채널을 켤지 반환합니다.
+     * @return bool : datagram_channel = on이면 true.
+     */
+    bool isDatagramChannelEnabled() const;
+
+    /**
+     * @fn const std::string& ServerConfig::getGameBridgeName() const
+     * @brief 게임 서버 브리지의 공유 메모리 이름을 반환합니다.
+     * @return const std::string& : 이름, 브리지를 열지 않으면 빈 문자열.
+     */
+    const std::string& getGameBridgeName() const;
+
+    /**
+     * @fn int ServerConfig::getClusterPort() const
+     * @brief 클러스터 포트를 반환합니다.
+     * @return int : 포트 번호, 클러스터 모드를 쓰지 않으면 0.
+     */
+    int getClusterPort() const;
+
+    /**
+     * @fn const std::vector<ServerConfig::ClusterPeer>& ServerConfig::getClusterPeers() const
+     * @brief 등록한 다른 클러스터 노드 목록을 반환합니다.
+     * @return const std::vector<ServerConfig::ClusterPeer>& : 적은 순서대로의 노드 목록.
+     */
+    const std::vector<ServerConfig::ClusterPeer>& getClusterPeers() const;
+
+    /**
+     * @fn const std::string& ServerConfig::getChatFilterFile() const
+     * @brief 금칙어 파일 경로를 반환합니다.
+     * @return const std::string& : 경로, 필터를 쓰지 않으면 빈 문자열.
+     */
+    const std::string& getChatFilterFile() const;
+
+    /**
+     * @fn const std::string& ServerConfig::getModeratorPassword() const
+     * @brief 운영자 암호를 반환합니다.
+     * @return const std::string& : 암호, 운영자를 두지 않으면 빈 문자열.
+     */
+    const std::string& getModeratorPassword() const;
+
+private:
+    /// 채팅 TCP 포트.
+    int _port;
+
+    /// 세션 로직 실행 방식.
+    MultiServerBase::SessionMode _sessionMode;
+
+    /// 바쁜 폴링 루프 모드 사용 여부.
+    bool _busyPoll;
+
+    /// 바쁜 폴링 루프 스레드를 고정할 코어 번호 (-1 : 고정하지 않음).
+    int _pinnedCore;
+
+    /// 병렬 팬아웃 작업자 스레드 수 (0 : 쓰지 않음).
+    int _fanoutWorkerCount;
+
+    /// 채팅방 작업자 스레드 수 (0 : 쓰지 않음).
+    int _roomWorkerCount;
+
+    /// 일회성 이벤트용 UDP 채널 사용 여부.
+    bool _datagramChannel;
+
+    /// 게임 서버 브리지의 공유 메모리 이름 (비어 있으면 열지 않습니다).
+    std::string _gameBridgeName;
+
+    /// 클러스터 포트 (0 : 클러스터 모드를 쓰지 않음).
+    int _clusterPort;
+
+    /// 다른 클러스터 노드 목록.
+    std::vector<ServerConfig::ClusterPeer> _clusterPeers;
+
+    /// 금칙어 파일 경로 (비어 있으면 필터를 쓰지 않습니다).
+    std::string _chatFilterFile;
+
+    /// 운영자 암호 (비어 있으면 아무도 운영자가 될 수 없습니다).
+    std::string _moderatorPassword;
+
+private:
+    /**
+     * @fn static bool ServerConfig::parseInteger(const std::string& text, int min_value, int max_value, int& value)
+     * @brief 10진수 정수를 범위를 확인하며 읽습니다.
+     * @param[IN] const std::string& text : 읽을 문자열.
+     * @param[IN] int min_value : 허용 최솟값.
+     * @param[IN] int max_value : 허용 최댓값.
+     * @param[OUT] int& value : 읽은 값.
+     * @return bool : 문자열 전체가 범위 안의 정수이면 true.
+     */
+    static bool parseInteger(const std::string& text, int min_value, int max_value, int& value);
+
+    /**
+     * @fn static bool ServerConfig::parseSwitch(const std::string& text, bool& value)
+     * @brief on/off 값을 읽습니다.
+     * @param[IN] const std::string& text : 읽을 문자열.
+     * @param[OUT] bool& value : on이면 true, off이면 false.
+     * @return bool : 문자열이 on 또는 off이면 true.
+     */
+    static bool parseSwitch(const std::string& text, bool& value);
+};
@@ -0,0 +1,323 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionContext.cpp
+ * @brief SessionContext.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "SessionContext.h"
+#include "DebugHelper.h"
+#include "TextScanner.h"
+#include "TransportInstances.h"
+
+template <typename Transport>
+SessionContext<Transport>::ReadLineAwaiter::ReadLineAwaiter(SessionContext& context, std::string& line)
+    : _context(context), _line(line), _hasLine(false), _hasDeadline(false), _deadline()
+{
+}
+
+template <typename Transport>
+SessionContext<Transport>::ReadLineAwaiter::ReadLineAwaiter(SessionContext& context, std::string& line, Clock::time_point deadline)
+    : _context(context), _line(line), _hasLine(false), _hasDeadline(true), _deadline(deadline)
+{
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::ReadLineAwaiter::await_ready()
+{
+    // 이미 버퍼에 줄이 있으면 중단하지 않고 바로 돌려줍니다.
+    this->_hasLine = this->_context.extractLine(this->_line);
+    return (this->_hasLine || this->_context.isClosed());
+}
+
+template <typename Transport>
+void SessionContext<Transport>::ReadLineAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->_context._waiter = handle;
+    if (this->_hasDeadline)
+    {
+        this->_context._waitState = SessionContext::WaitState::READ_TIMED;
+        this->_context._wakeTime = this->_deadline;
+        return ;
+    }
+    this->_context._waitState = SessionContext::WaitState::READ;
+}
+
+template <typename Transport>
+SessionContextBase::Result SessionContext<Transport>::ReadLineAwaiter::await_resume()
+{
+    // 재개된 경우 그 사이 수신된 줄을 꺼냅니다.
+    if (this->_hasLine == false)
+    {
+        this->_hasLine = this->_context.extractLine(this->_line);
+    }
+
+    if (this->_hasLine)
+    {
+        return (SessionContext::Result::SUCCESS);
+    }
+    if (this->_context.isClosed() == false)
+    {
+        // 줄도 없고 연결도 열려 있다면 readLineFor()의 시간이 초과된 것입니다.
+        return (SessionContext::Result::TIMEOUT);
+    }
+    return (this->_context._closeResult);
+}
+
+template <typename Transport>
+SessionContext<Transport>::SleepAwaiter::SleepAwaiter(SessionContext& context, Clock::time_point deadline)
+    : _context(context), _deadline(deadline)
+{
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::SleepAwaiter::await_ready() const
+{
+    return (this->_deadline <= this->_context._transport->now());
+}
+
+template <typename Transport>
+void SessionContext<Transport>::SleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->_context._waiter = handle;
+    this->_context._waitState = SessionContext::WaitState::SLEEP;
+    this->_context._wakeTime = this->_deadline;
+}
+
+template <typename Transport>
+void SessionContext<Transport>::SleepAwaiter::await_resume() const
+{
+}
+
+template <typename Transport>
+SessionContext<Transport>::SessionContext()
+    : _clientIndex(-1), _clientSocket(INVALID_SOCKET), _transport(nullptr), _inputBuffer(), _skipLineFeed(false), _waiter(nullptr),
+      _waitState(SessionContext::WaitState::NONE), _wakeTime(), _closeResult(SessionContext::Result::SUCCESS)
+{
+}
+
+template <typename Transport>
+SessionContext<Transport>::~SessionContext()
+{
+}
+
+template <typename Transport>
+void SessionContext<Transport>::attach(int client_index, SOCKET client_socket, Transport& transport)
+{
+    this->detach();
+    this->_clientIndex = client_index;
+    this->_clientSocket = client_socket;
+    this->_transport = &transport;
+}
+
+template <typename Transport>
+void SessionContext<Transport>::detach()
+{
+    this->_clientIndex = -1;
+    this->_clientSocket = INVALID_SOCKET;
+    this->_inputBuffer.clear();
+    this->_skipLineFeed = false;
+    this->_waiter = nullptr;
+    this->_waitState = SessionContext::WaitState::NONE;
+    this->_closeResult = SessionContext::Result::SUCCESS;
+}
+
+template <typename Transport>
+typename SessionContext<Transport>::ReadLineAwaiter SessionContext<Transport>::readLine(std::string& line)
+{
+    return (SessionContext::ReadLineAwaiter(*this, line));
+}
+
+template <typename Transport>
+typename SessionContext<Transport>::ReadLineAwaiter SessionContext<Transport>::readLineFor(std::string& line, std::chrono::milliseconds timeout)
+{
+    return (SessionContext::ReadLineAwaiter(*this, line, this->_transport->now() + timeout));
+}
+
+template <typename Transport>
+void SessionContext<Transport>::unreadInput(const std::string& bytes)
+{
+    this->_inputBuffer.insert(0, bytes);
+}
+
+template <typename Transport>
+std::string SessionContext<Transport>::takeBufferedInput()
+{
+    std::string bytes = std::move(this->_inputBuffer);
+    this->_inputBuffer.clear();
+    return (bytes);
+}
+
+template <typename Transport>
+typename SessionContext<Transport>::SleepAwaiter SessionContext<Transport>::sleepFor(std::chrono::milliseconds duration)
+{
+    return (SessionContext::SleepAwaiter(*this, this->_transport->now() + duration));
+}
+
+template <typename Transport>
+SessionContextBase::Result SessionContext<Transport>::receiveAvailable()
+{
+    // 이미 닫힌 연결은 다시 읽지 않습니다.
+    if (this->isClosed())
+    {
+        return (this->_closeResult);
+    }
+
+    char buffer[SessionContext::BUFFER_SIZE];
+    int receive_result = this->_transport->receiveBytes(this->_clientSocket, buffer, SessionContext::BUFFER_SIZE);
+
+    if (receive_result > 0)
+    {
+        this->_inputBuffer.append(buffer, receive_result);
+        return (SessionContext::Result::SUCCESS);
+    }
+    else if (receive_result == SOCKET_ERROR && this->_transport->getLastError() == WSAEWOULDBLOCK)
+    {
+        // 논블로킹 소켓에 아직 읽을 데이터가 없습니다. 줄이 완성될 때까지 계속 기다립니다.
+        return (SessionContext::Result::SUCCESS);
+    }
+    else if (receive_result == 0)
+    {
+        LOG_INFO("클라이언트가 연결을 종료했습니다. - 인덱스: " + std::to_string(this->_clientIndex));
+        this->_closeResult = SessionContext::Result::CLIENT_DISCONNECTED;
+    }
+    else
+    {
+        LOG_ERROR("메시지 수신을 실패했습니다.\n에러 코드: " + std::to_string(this->_transport->getLastError()));
+        this->_closeResult = SessionContext::Result::FAIL_RECEIVE;
+    }
+
+    return (this->_closeResult);
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::isReadable() const
+{
+    if (this->_waitState != SessionContext::WaitState::READ && this->_waitState != SessionContext::WaitState::READ_TIMED)
+    {
+        return (false);
+    }
+    return (this->hasLine() || this->isClosed());
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::isSleepExpired(Clock::time_point now) const
+{
+    return (this->isSleeping() && this->_wakeTime <= now);
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::isSleeping() const
+{
+    return (this->_waitState == SessionContext::WaitState::SLEEP || this->_waitState == SessionContext::WaitState::READ_TIMED);
+}
+
+template <typename Transport>
+SessionContextBase::Clock::time_point SessionContext<Transport>::getWakeTime() const
+{
+    return (this->_wakeTime);
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::isClosed() const
+{
+    return (this->_closeResult != SessionContext::Result::SUCCESS);
+}
+
+template <typename Transport>
+std::coroutine_handle<> SessionContext<Transport>::takeWaiter()
+{
+    std::coroutine_handle<> waiter = this->_waiter;
+    this->_waiter = nullptr;
+    this->_waitState = SessionContext::WaitState::NONE;
+    return (waiter);
+}
+
+template <typename Transport>
+int SessionContext<Transport>::getClientIndex() const
+{
+    return (this->_clientIndex);
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::extractLine(std::string& line)
+{
+    if (this->hasLine() == false)
+    {
+        return (false);
+    }
+
+    // 직전 줄의 "\r\n" 중 뒤늦게 도착한 '\n'을 버립니다.
+    std::size_t start = this->getLineStart();
+    this->_skipLineFeed = false;
+
+    const char* data = this->_inputBuffer.data() + start;
+    std::size_t size = this->_inputBuffer.size() - start;
+    std::size_t limit = (size < SessionContext::MAX_LINE_LENGTH) ? size : SessionContext::MAX_LINE_LENGTH;
+    std::size_t line_break = TextScanner::findLineBreak(data, limit);
+
+    std::size_t consumed = SessionContext::MAX_LINE_LENGTH;
+    if (line_break < limit)
+    {
+        consumed = line_break + 1;
+        if (data[line_break] == '\r')
+        {
+            // '\r' 다음 바이트가 아직 오지 않았다면 다음 줄을 꺼낼 때 확인합니다.
+            if (consumed == size)
+            {
+                this->_skipLineFeed = true;
+            }
+            else if (data[consumed] == '\n')
+            {
+                consumed = consumed + 1;
+            }
+        }
+    }
+    else
+    {
+        // 너무 긴 줄은 잘린 UTF-8 문자 앞에서 잘라, 나머지 바이트는 다음 줄의 앞에 남깁니다.
+        line_break = TextScanner::findUtf8Boundary(data, SessionContext::MAX_LINE_LENGTH);
+        if (line_break == 0)
+        {
+            line_break = SessionContext::MAX_LINE_LENGTH;
+        }
+        consumed = line_break;
+    }
+
+    line.assign(data, line_break);
+    this->_inputBuffer.erase(0, start + consumed);
+
+    // 잘못된 UTF-8 바이트가 그대로 브로드캐스트되지 않도록 바꿉니다.
+    std::size_t replaced_count = TextScanner::sanitizeUtf8(line);
+    if (replaced_count > 0)
+    {
+        LOG_WARN("잘못된 UTF-8 바이트를 바꿨습니다. - 인덱스: " + std::to_string(this->_clientIndex) + ", " + std::to_string(replaced_count) + "곳");
+    }
+    return (true);
+}
+
+template <typename Transport>
+bool SessionContext<Transport>::hasLine() const
+{
+    std::size_t start = this->getLineStart();
+    std::size_t size = this->_inputBuffer.size() - start;
+    if (size >= SessionContext::MAX_LINE_LENGTH)
+    {
+        return (true);
+    }
+    return (TextScanner::findLineBreak(this->_inputBuffer.data() + start, size) != size);
+}
+
+template <typename Transport>
+std::size_t SessionContext<Transport>::getLineStart() const
+{
+    if (this->_skipLineFeed && this->_inputBuffer.empty() == false && this->_inputBuffer[0] == '\n')
+    {
+        return (1);
+    }
+    return (0);
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(SessionContext);
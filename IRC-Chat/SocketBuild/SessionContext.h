@@ -0,0 +1,312 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionContext.h
+ * @brief 세션 코루틴 하나의 입출력 상태와 awaiter를 제공하는 SessionContext 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 세션 코루틴은 SessionContext를 통해 한 줄 읽기, 버퍼 쓰기, 일정 시간 대기를 `co_await`로 표현합니다.
+ * <br>실제 수신과 재개는 서버 루프(SessionScheduler)가 select 결과에 따라 수행합니다.
+ * <br>줄은 '\n', '\r', "\r\n" 중 하나로 끝나며, 꺼낸 줄의 잘못된 UTF-8 바이트는 U+FFFD로 바꿉니다.
+ */
+
+#include "NetworkTransport.h"
+#include <chrono>
+#include <coroutine>
+#include <string>
+
+/**
+ * @class SessionContextBase
+ * @brief 전송 계층과 무관한 SessionContext의 시계, 결과 타입과 버퍼 크기를 담습니다.
+ *
+ * @note 세션 코루틴과 서버 루프는 SessionContextBase::Result처럼 씁니다.
+ */
+class SessionContextBase
+{
+public:
+    /// 세션 타이머가 사용하는 단조 시계 (현재 시각은 전송 계층에서 얻습니다).
+    using Clock = NetworkTransport::Clock;
+
+    /**
+     * @enum SessionContextBase::Result
+     * @brief 세션 입출력의 결과 상태 값.
+     */
+    enum class Result
+    {
+        SUCCESS,                ///< 한 줄 읽기에 성공함.
+        FAIL_RECEIVE,           ///< recv 오류로 세션을 더 이상 읽을 수 없음.
+        CLIENT_DISCONNECTED,    ///< 클라이언트가 연결을 종료함.
+        TIMEOUT                 ///< readLineFor()의 대기 시간 안에 줄이 도착하지 않음.
+    };
+
+    /// 한 번의 recv에 사용하는 버퍼 크기(바이트 단위).
+    static const int BUFFER_SIZE = 1024;
+
+    /// 개행 없이 쌓일 수 있는 최대 줄 길이. 넘으면 그대로 한 줄로 잘라냅니다.
+    static const std::size_t MAX_LINE_LENGTH = 4096;
+};
+
+/**
+ * @class SessionContext
+ * @brief 연결 하나의 수신 버퍼, 대기 중인 코루틴, 타이머 정보를 관리합니다.
+ * @tparam Transport : 송수신과 시계에 사용할 전송 계층 타입.
+ *
+ * @details
+ * - readLine() : 수신 버퍼에 완성된 줄이 생길 때까지 코루틴을 중단합니다.
+ * - sleepFor() : 지정한 시간이 지날 때까지 코루틴을 중단합니다.
+ *
+ * 서버 루프는 receiveAvailable()로 데이터를 버퍼에 쌓고, 재개 조건이 충족된 코루틴을 takeWaiter()로 꺼내 재개합니다.
+ * <br>클라이언트 소켓은 논블로킹이므로 세션의 출력은 소켓에 직접 쓰지 않고 MessageSender의 송신 대기열을 거칩니다.
+ */
+template <typename Transport>
+class SessionContext : public SessionContextBase
+{
+public:
+    /**
+     * @class SessionContext::ReadLineAwaiter
+     * @brief 완성된 한 줄이 수신될 때까지 코루틴을 중단하는 awaiter입니다.
+     */
+    class ReadLineAwaiter
+    {
+    public:
+        ReadLineAwaiter(SessionContext& context, std::string& line);
+        ReadLineAwaiter(SessionContext& context, std::string& line, Clock::time_point deadline);
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        SessionContext::Result await_resume();
+
+    private:
+        SessionContext& _context;
+        std::string& _line;
+        bool _hasLine;
+        bool _hasDeadline;
+        Clock::time_point _deadline;
+    };
+
+    /**
+     * @class SessionContext::SleepAwaiter
+     * @brief 지정한 시각까지 코루틴을 중단하는 awaiter입니다.
+     */
+    class SleepAwaiter
+    {
+    public:
+        SleepAwaiter(SessionContext& context, Clock::time_point deadline);
+
+        bool await_ready() const;
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const;
+
+    private:
+        SessionContext& _context;
+        Clock::time_point _deadline;
+    };
+
+public:
+    /**
+     * @fn SessionContext::SessionContext()
+     * @brief 어떤 연결에도 연결되지 않은 빈 컨텍스트를 생성합니다.
+     * @return 없음.
+     */
+    SessionContext();
+
+    /**
+     * @fn SessionContext::~SessionContext()
+     * @brief 소멸자.
+     * @return 없음.
+     * @note 소켓은 ClientManager가 관리하므로 닫지 않습니다.
+     */
+    ~SessionContext();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SessionContext(const SessionContext& obj) = delete;
+    SessionContext& operator=(const SessionContext& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SessionContext(SessionContext&& obj) = delete;
+    SessionContext& operator=(SessionContext&& obj) = delete;
+
+public:
+    /**
+     * @fn void SessionContext::attach(int client_index, SOCKET client_socket, Transport& transport)
+     * @brief 컨텍스트를 새 연결에 연결하고 내부 상태를 초기화합니다.
+     * @param[IN] int client_index : ClientManager가 할당한 클라이언트 인덱스.
+     * @param[IN] SOCKET client_socket : 세션이 사용할 클라이언트 소켓.
+     * @param[IN] Transport& transport : 송수신과 시계에 사용할 전송 계층.
+     * @return 없음.
+     */
+    void attach(int client_index, SOCKET client_socket, Transport& transport);
+
+    /**
+     * @fn void SessionContext::detach()
+     * @brief 컨텍스트를 연결에서 분리하고 버퍼와 대기 정보를 비웁니다.
+     * @return 없음.
+     */
+    void detach();
+
+    /**
+     * @fn SessionContext::ReadLineAwaiter SessionContext::readLine(std::string& line)
+     * @brief 다음 한 줄을 읽습니다. 버퍼에 줄이 없으면 수신될 때까지 중단합니다.
+     * @param[OUT] std::string& line : 개행 문자를 제거한 한 줄.
+     * @return ReadLineAwaiter : `co_await` 결과는 SessionContext::Result.
+     */
+    ReadLineAwaiter readLine(std::string& line);
+
+    /**
+     * @fn SessionContext::ReadLineAwaiter SessionContext::readLineFor(std::string& line, std::chrono::milliseconds timeout)
+     * @brief readLine()과 같지만, 지정한 시간 안에 줄이 오지 않으면 TIMEOUT으로 재개합니다.
+     * @param[OUT] std::string& line : 개행 문자를 제거한 한 줄.
+     * @param[IN] std::chrono::milliseconds timeout : 최대 대기 시간.
+     * @return ReadLineAwaiter : `co_await` 결과는 SessionContext::Result (시간 초과 시 TIMEOUT).
+     */
+    ReadLineAwaiter readLineFor(std::string& line, std::chrono::milliseconds timeout);
+
+    /**
+     * @fn void SessionContext::unreadInput(const std::string& bytes)
+     * @brief 바이트열을 수신 버퍼 앞에 되돌려 다음 readLine()이 다시 읽도록 합니다.
+     * @param[IN] const std::string& bytes : 되돌릴 바이트열 (줄이면 개행 문자 포함).
+     * @return 없음.
+     */
+    void unreadInput(const std::string& bytes);
+
+    /**
+     * @fn std::string SessionContext::takeBufferedInput()
+     * @brief 아직 줄 단위로 소비하지 않은 수신 데이터를 꺼내고 버퍼를 비웁니다.
+     * @return std::string : 남아 있던 수신 데이터.
+     * @note 연결을 다른 컨텍스트로 옮길 때 사용합니다.
+     */
+    std::string takeBufferedInput();
+
+    /**
+     * @fn SessionContext::SleepAwaiter SessionContext::sleepFor(std::chrono::milliseconds duration)
+     * @brief 지정한 시간 동안 코루틴을 중단합니다.
+     * @param[IN] std::chrono::milliseconds duration : 대기할 시간.
+     * @return SleepAwaiter : `co_await` 결과는 없음.
+     */
+    SleepAwaiter sleepFor(std::chrono::milliseconds duration);
+
+public:
+    /**
+     * @fn SessionContext::Result SessionContext::receiveAvailable()
+     * @brief 소켓에서 한 번 recv하여 수신 버퍼에 덧붙입니다.
+     * @return SessionContext::Result : 수신 성공 시 SUCCESS, 연결 종료나 오류 시 해당 상태 값.
+     * @note select가 읽기 준비를 알린 뒤에만 호출해야 합니다.
+     */
+    SessionContext::Result receiveAvailable();
+
+    /**
+     * @fn bool SessionContext::isReadable() const
+     * @brief 대기 중인 readLine()을 재개할 수 있는지 확인합니다.
+     * @return bool : 읽기 대기 중이면서 완성된 줄이 있거나 연결이 닫혔으면 true.
+     */
+    bool isReadable() const;
+
+    /**
+     * @fn bool SessionContext::isSleepExpired(Clock::time_point now) const
+     * @brief 대기 중인 sleepFor() 또는 readLineFor()의 만료 시각이 지났는지 확인합니다.
+     * @param[IN] Clock::time_point now : 현재 시각.
+     * @return bool : 만료되었으면 true.
+     */
+    bool isSleepExpired(Clock::time_point now) const;
+
+    /**
+     * @fn bool SessionContext::isSleeping() const
+     * @brief 코루틴이 만료 시각이 있는 대기(sleepFor(), readLineFor())로 중단되어 있는지 확인합니다.
+     * @return bool : 대기 중이면 true.
+     */
+    bool isSleeping() const;
+
+    /**
+     * @fn Clock::time_point SessionContext::getWakeTime() const
+     * @brief sleepFor() 또는 readLineFor()가 만료되는 시각을 반환합니다.
+     * @return Clock::time_point : 만료 시각.
+     */
+    Clock::time_point getWakeTime() const;
+
+    /**
+     * @fn bool SessionContext::isClosed() const
+     * @brief 수신 측 연결이 닫혔는지 확인합니다.
+     * @return bool : 연결 종료 또는 수신 오류가 발생했으면 true.
+     */
+    bool isClosed() const;
+
+    /**
+     * @fn std::coroutine_handle<> SessionContext::takeWaiter()
+     * @brief 중단된 코루틴 핸들을 꺼내고 대기 상태를 해제합니다.
+     * @return std::coroutine_handle<> : 재개할 코루틴 (없으면 빈 핸들).
+     */
+    std::coroutine_handle<> takeWaiter();
+
+    /**
+     * @fn int SessionContext::getClientIndex() const
+     * @brief 연결된 클라이언트 인덱스를 반환합니다.
+     * @return int : 클라이언트 인덱스, 연결되지 않았으면 -1.
+     */
+    int getClientIndex() const;
+
+private:
+    /**
+     * @enum SessionContext::WaitState
+     * @brief 코루틴이 무엇을 기다리며 중단되어 있는지 나타냅니다.
+     */
+    enum class WaitState
+    {
+        NONE,       ///< 중단되어 있지 않음.
+        READ,       ///< readLine()에서 중단됨.
+        READ_TIMED, ///< readLineFor()에서 중단됨.
+        SLEEP       ///< sleepFor()에서 중단됨.
+    };
+
+    /// 연결된 클라이언트 인덱스.
+    int _clientIndex;
+
+    /// 세션 소켓 (ClientManager 소유).
+    SOCKET _clientSocket;
+
+    /// 송수신과 시계에 사용하는 전송 계층 (attach 전에는 nullptr).
+    Transport* _transport;
+
+    /// 아직 줄 단위로 소비하지 않은 수신 데이터.
+    std::string _inputBuffer;
+
+    /// 직전 줄이 버퍼 끝의 '\r'로 끝나, 다음에 오는 '\n' 하나를 건너뛰어야 하는지 여부.
+    bool _skipLineFeed;
+
+    /// 중단된 코루틴.
+    std::coroutine_handle<> _waiter;
+
+    /// 코루틴이 기다리는 조건.
+    WaitState _waitState;
+
+    /// sleepFor() 또는 readLineFor()가 만료되는 시각.
+    Clock::time_point _wakeTime;
+
+    /// 수신 측 종료 상태 (SUCCESS이면 열려 있음).
+    SessionContext::Result _closeResult;
+
+private:
+    /**
+     * @fn bool SessionContext::extractLine(std::string& line)
+     * @brief 수신 버퍼에서 완성된 한 줄을 꺼냅니다.
+     * @param[OUT] std::string& line : 개행 문자를 제거하고 UTF-8을 검증한 한 줄.
+     * @return bool : 줄을 꺼냈으면 true.
+     */
+    bool extractLine(std::string& line);
+
+    /**
+     * @fn bool SessionContext::hasLine() const
+     * @brief 수신 버퍼에 꺼낼 수 있는 줄이 있는지 확인합니다.
+     * @return bool : 개행 문자가 있거나 MAX_LINE_LENGTH를 넘었으면 true.
+     */
+    bool hasLine() const;
+
+    /**
+     * @fn std::size_t SessionContext::getLineStart() const
+     * @brief 수신 버퍼에서 다음 줄이 시작하는 위치를 구합니다.
+     * @return std::size_t : 건너뛸 '\n'이 맨 앞에 있으면 1, 아니면 0.
+     */
+    std::size_t getLineStart() const;
+};
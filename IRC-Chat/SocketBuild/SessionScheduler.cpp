@@ -0,0 +1,145 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionScheduler.cpp
+ * @brief SessionScheduler.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "SessionScheduler.h"
+#include "DebugHelper.h"
+#include "TraceRecorder.h"
+#include "TransportInstances.h"
+
+template <typename Transport>
+SessionScheduler<Transport>::SessionScheduler(Transport& transport)
+    : _transport(transport), _contexts(), _tasks()
+{
+    LOG_DEBUG("SessionScheduler 객체를 생성합니다.");
+}
+
+template <typename Transport>
+SessionScheduler<Transport>::~SessionScheduler()
+{
+    // 컨텍스트보다 코루틴 프레임을 먼저 파괴합니다.
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        this->_tasks[i].reset();
+    }
+    LOG_DEBUG("SessionScheduler 객체를 삭제합니다.");
+}
+
+template <typename Transport>
+SessionContext<Transport>& SessionScheduler<Transport>::prepare(int client_index, SOCKET client_socket)
+{
+    this->_tasks[client_index].reset();
+    this->_contexts[client_index].attach(client_index, client_socket, this->_transport);
+    return (this->_contexts[client_index]);
+}
+
+template <typename Transport>
+void SessionScheduler<Transport>::spawn(int client_index, Task<> task)
+{
+    this->_tasks[client_index] = std::move(task);
+
+    // 첫 readLine()이나 sleepFor()까지 실행합니다.
+    this->_tasks[client_index].start();
+}
+
+template <typename Transport>
+void SessionScheduler<Transport>::onReadable(int client_index)
+{
+    TRACE_SCOPE("SessionScheduler::onReadable");
+
+    SessionContext<Transport>& context = this->_contexts[client_index];
+
+    context.receiveAvailable();
+
+    // 한 번의 수신으로 여러 줄이 들어올 수 있으므로, 줄이 남아 있는 동안 계속 재개합니다.
+    while (context.isReadable())
+    {
+        this->resume(client_index);
+    }
+}
+
+template <typename Transport>
+void SessionScheduler<Transport>::processTimers(SessionContextBase::Clock::time_point now)
+{
+    TRACE_SCOPE("SessionScheduler::processTimers");
+
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        if (this->_contexts[i].isSleepExpired(now))
+        {
+            this->resume(i);
+
+            // 대기에서 깨어난 뒤 이미 쌓여 있던 줄도 처리합니다.
+            while (this->_contexts[i].isReadable())
+            {
+                this->resume(i);
+            }
+        }
+    }
+}
+
+template <typename Transport>
+int SessionScheduler<Transport>::getNextTimeoutMs(SessionContextBase::Clock::time_point now, int max_timeout_ms) const
+{
+    long long timeout_ms = max_timeout_ms;
+
+    for (int i = 0; i < ClientManagerBase::MAX_CLIENTS; ++i)
+    {
+        if (this->_contexts[i].isSleeping() == false)
+        {
+            continue;
+        }
+
+        long long remain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(this->_contexts[i].getWakeTime() - now).count();
+        if (remain_ms < 0)
+        {
+            remain_ms = 0;
+        }
+        if (remain_ms < timeout_ms)
+        {
+            timeout_ms = remain_ms;
+        }
+    }
+
+    return ((int)timeout_ms);
+}
+
+template <typename Transport>
+bool SessionScheduler<Transport>::wantsRead(int client_index) const
+{
+    if (this->_tasks[client_index].isDone())
+    {
+        return (false);
+    }
+    return (this->_contexts[client_index].isClosed() == false);
+}
+
+template <typename Transport>
+bool SessionScheduler<Transport>::isFinished(int client_index) const
+{
+    return (this->_tasks[client_index].isValid() && this->_tasks[client_index].isDone());
+}
+
+template <typename Transport>
+void SessionScheduler<Transport>::release(int client_index)
+{
+    this->_tasks[client_index].reset();
+    this->_contexts[client_index].detach();
+}
+
+template <typename Transport>
+void SessionScheduler<Transport>::resume(int client_index)
+{
+    std::coroutine_handle<> waiter = this->_contexts[client_index].takeWaiter();
+    if (waiter)
+    {
+        waiter.resume();
+    }
+}
+
+INSTANTIATE_COMPONENT_TRANSPORTS(SessionScheduler);
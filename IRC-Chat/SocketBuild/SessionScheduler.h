@@ -0,0 +1,148 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionScheduler.h
+ * @brief 세션 코루틴을 서버 루프에서 실행하는 SessionScheduler 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 클라이언트 인덱스마다 SessionContext와 최상위 Task를 하나씩 보관합니다.
+ * <br>select가 알려 준 읽기 이벤트와 만료된 타이머에 따라 중단된 코루틴을 재개합니다.
+ * <br>모든 재개는 서버 루프 스레드에서만 일어나므로 잠금이 필요 없습니다.
+ */
+
+#include "ClientManager.h"
+#include "SessionContext.h"
+#include "SessionTask.h"
+#include <array>
+
+/**
+ * @class SessionScheduler
+ * @brief 세션 코루틴의 시작, 재개, 종료를 관리하는 단일 스레드 스케줄러입니다.
+ *
+ * @details
+ * - spawn() : 새 연결의 세션 코루틴을 첫 중단 지점까지 실행합니다.
+ * - onReadable() : 소켓 데이터를 수신 버퍼에 쌓고 읽기 대기 중인 코루틴을 재개합니다.
+ * - processTimers() : 만료된 sleepFor()를 재개합니다.
+ * - release() : 종료된 세션의 코루틴 프레임과 컨텍스트를 정리합니다.
+ *
+ * @tparam Transport : 세션 송수신과 타이머에 사용할 전송 계층 타입.
+ */
+template <typename Transport>
+class SessionScheduler
+{
+public:
+    /**
+     * @fn SessionScheduler::SessionScheduler(Transport& transport)
+     * @brief 빈 스케줄러를 생성합니다.
+     * @param[IN] Transport& transport : 세션 송수신과 타이머에 사용할 전송 계층.
+     * @return 없음.
+     */
+    explicit SessionScheduler(Transport& transport);
+
+    /**
+     * @fn SessionScheduler::~SessionScheduler()
+     * @brief 남아 있는 모든 세션 코루틴 프레임을 파괴합니다.
+     * @return 없음.
+     */
+    ~SessionScheduler();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SessionScheduler(const SessionScheduler& obj) = delete;
+    SessionScheduler& operator=(const SessionScheduler& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SessionScheduler(SessionScheduler&& obj) = delete;
+    SessionScheduler& operator=(SessionScheduler&& obj) = delete;
+
+public:
+    /**
+     * @fn SessionContext<Transport>& SessionScheduler::prepare(int client_index, SOCKET client_socket)
+     * @brief 새 연결에 사용할 컨텍스트를 초기화하여 반환합니다.
+     * @param[IN] int client_index : ClientManager가 할당한 인덱스.
+     * @param[IN] SOCKET client_socket : 클라이언트 소켓.
+     * @return SessionContext<Transport>& : 세션 코루틴에 전달할 컨텍스트.
+     * @note 세션 코루틴을 만들기 전에 호출하고, 만든 코루틴은 spawn()으로 시작합니다.
+     */
+    SessionContext<Transport>& prepare(int client_index, SOCKET client_socket);
+
+    /**
+     * @fn void SessionScheduler::spawn(int client_index, Task<> task)
+     * @brief 세션 코루틴을 등록하고 첫 중단 지점까지 실행합니다.
+     * @param[IN] int client_index : 세션의 클라이언트 인덱스.
+     * @param[IN] Task<> task : 세션 코루틴.
+     * @return 없음.
+     */
+    void spawn(int client_index, Task<> task);
+
+    /**
+     * @fn void SessionScheduler::onReadable(int client_index)
+     * @brief 읽기 준비된 세션의 데이터를 수신하고 필요하면 코루틴을 재개합니다.
+     * @param[IN] int client_index : 읽기 준비된 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void onReadable(int client_index);
+
+    /**
+     * @fn void SessionScheduler::processTimers(SessionContextBase::Clock::time_point now)
+     * @brief sleepFor() 만료 시각이 지난 모든 세션 코루틴을 재개합니다.
+     * @param[IN] SessionContextBase::Clock::time_point now : 이번 루프 반복의 시각 (LoopClock::now()).
+     * @return 없음.
+     */
+    void processTimers(SessionContextBase::Clock::time_point now);
+
+    /**
+     * @fn int SessionScheduler::getNextTimeoutMs(SessionContextBase::Clock::time_point now, int max_timeout_ms) const
+     * @brief 가장 가까운 타이머까지 남은 시간을 select 대기 시간으로 계산합니다.
+     * @param[IN] SessionContextBase::Clock::time_point now : 이번 루프 반복의 시각 (LoopClock::now()).
+     * @param[IN] int max_timeout_ms : 대기 중인 타이머가 없을 때 사용할 최대 대기 시간.
+     * @return int : select에 전달할 대기 시간(밀리초).
+     */
+    int getNextTimeoutMs(SessionContextBase::Clock::time_point now, int max_timeout_ms) const;
+
+    /**
+     * @fn bool SessionScheduler::wantsRead(int client_index) const
+     * @brief 해당 세션 소켓을 select 감시 목록에 넣어야 하는지 확인합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return bool : 세션이 살아 있고 수신 측이 닫히지 않았으면 true.
+     * @note 닫힌 소켓은 계속 읽기 준비로 표시되므로, 코루틴이 대기 중일 때 루프가 공회전하지 않도록 제외합니다.
+     */
+    bool wantsRead(int client_index) const;
+
+    /**
+     * @fn bool SessionScheduler::isFinished(int client_index) const
+     * @brief 세션 코루틴이 종료되어 정리가 필요한지 확인합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return bool : 등록된 코루틴이 끝났으면 true.
+     */
+    bool isFinished(int client_index) const;
+
+    /**
+     * @fn void SessionScheduler::release(int client_index)
+     * @brief 세션 코루틴 프레임을 파괴하고 컨텍스트를 분리합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void release(int client_index);
+
+private:
+    /// 세션 송수신과 타이머에 사용하는 전송 계층.
+    Transport& _transport;
+
+    /// 클라이언트 인덱스별 세션 컨텍스트.
+    std::array<SessionContext<Transport>, ClientManagerBase::MAX_CLIENTS> _contexts;
+
+    /// 클라이언트 인덱스별 최상위 세션 코루틴.
+    std::array<Task<>, ClientManagerBase::MAX_CLIENTS> _tasks;
+
+private:
+    /**
+     * @fn void SessionScheduler::resume(int client_index)
+     * @brief 세션의 중단된 코루틴을 재개합니다.
+     * @param[IN] int client_index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void resume(int client_index);
+};
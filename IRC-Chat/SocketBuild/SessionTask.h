@@ -0,0 +1,332 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionTask.h
+ * @brief 세션 코루틴의 반환 타입인 Task 템플릿을 정의합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * Task<T>는 지연 시작(lazy start) 코루틴으로, 다른 Task 안에서 co_await로 호출하면
+ * <br>하위 코루틴이 끝나는 즉시 호출한 코루틴이 이어서 실행됩니다(대칭 전환).
+ * <br>코루틴 프레임은 CoroutineFramePool에서 할당되므로 예열 이후에는 힙 할당이 없습니다.
+ */
+
+#include "CoroutineFramePool.h"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// MemoryLeakHelper.h의 new 매크로가 operator new 선언을 깨뜨리지 않도록 잠시 해제합니다.
+#pragma push_macro("new")
+#undef new
+
+template <typename T = void>
+class Task;
+
+/**
+ * @class TaskPromiseBase
+ * @brief Task의 promise가 공통으로 사용하는 프레임 할당과 종료 처리를 담당합니다.
+ *
+ * @details
+ * 프레임 메모리를 CoroutineFramePool에서 가져오고, 코루틴이 끝나면
+ * <br>자신을 co_await한 코루틴(continuation)으로 실행을 넘깁니다.
+ */
+class TaskPromiseBase
+{
+public:
+    /**
+     * @struct TaskPromiseBase::FinalAwaiter
+     * @brief 코루틴 종료 시 continuation으로 실행을 넘기는 awaiter입니다.
+     */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return (false);
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            // 기다리던 코루틴이 있으면 곧바로 재개하고, 없으면 스케줄러로 돌아갑니다.
+            std::coroutine_handle<> continuation = handle.promise()._continuation;
+            if (continuation)
+            {
+                return (continuation);
+            }
+            return (std::noop_coroutine());
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    static void* operator new(std::size_t size)
+    {
+        return (CoroutineFramePool::getInstance().allocate(size));
+    }
+
+    static void operator delete(void* frame, std::size_t size)
+    {
+        CoroutineFramePool::getInstance().deallocate(frame, size);
+    }
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        this->_exception = std::current_exception();
+    }
+
+    /**
+     * @fn void TaskPromiseBase::setContinuation(std::coroutine_handle<> continuation)
+     * @brief 이 코루틴이 끝난 뒤 재개할 코루틴을 등록합니다.
+     * @param[IN] std::coroutine_handle<> continuation : 재개할 코루틴 핸들.
+     * @return 없음.
+     */
+    void setContinuation(std::coroutine_handle<> continuation) noexcept
+    {
+        this->_continuation = continuation;
+    }
+
+    /**
+     * @fn void TaskPromiseBase::rethrowIfFailed() const
+     * @brief 코루틴 본문에서 잡히지 않은 예외가 있었다면 다시 던집니다.
+     * @return 없음.
+     */
+    void rethrowIfFailed() const
+    {
+        if (this->_exception)
+        {
+            std::rethrow_exception(this->_exception);
+        }
+    }
+
+private:
+    /// 이 코루틴이 끝나면 재개할 코루틴.
+    std::coroutine_handle<> _continuation;
+
+    /// 코루틴 본문에서 발생한 예외.
+    std::exception_ptr _exception;
+};
+
+/**
+ * @class TaskPromise
+ * @brief 값을 반환하는 Task<T>의 promise입니다.
+ */
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    void return_value(T value)
+    {
+        this->_value.emplace(std::move(value));
+    }
+
+    /**
+     * @fn T TaskPromise<T>::takeResult()
+     * @brief co_return으로 전달된 값을 꺼냅니다.
+     * @return T : 코루틴의 반환 값.
+     */
+    T takeResult()
+    {
+        this->rethrowIfFailed();
+        return (std::move(*this->_value));
+    }
+
+private:
+    /// co_return으로 전달된 값.
+    std::optional<T> _value;
+};
+
+/**
+ * @class TaskPromise<void>
+ * @brief 값을 반환하지 않는 Task<>의 promise입니다.
+ */
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept
+    {
+    }
+
+    void takeResult() const
+    {
+        this->rethrowIfFailed();
+    }
+};
+
+/**
+ * @class Task
+ * @brief 서버 루프 위에서 실행되는 세션 코루틴의 반환 타입입니다.
+ *
+ * @details
+ * Task는 코루틴 프레임의 소유권을 가지며, 소멸 시 프레임을 파괴합니다.
+ * <br>최상위 Task는 SessionScheduler가 start()로 시작하고 isDone()으로 종료를 확인합니다.
+ * <br>하위 Task는 `co_await`로 호출하며, 그 결과 값을 반환받습니다.
+ *
+ * @note 코루틴 프레임을 소유하므로 복사는 금지되고 이동만 허용됩니다.
+ */
+template <typename T>
+class Task
+{
+public:
+    using promise_type = TaskPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /**
+     * @class Task::Awaiter
+     * @brief 하위 Task를 co_await할 때 사용하는 awaiter입니다.
+     */
+    class Awaiter
+    {
+    public:
+        explicit Awaiter(handle_type handle) noexcept
+            : _handle(handle)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return (!this->_handle || this->_handle.done());
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+        {
+            // 하위 코루틴이 끝나면 호출한 코루틴을 재개하도록 등록한 뒤 하위 코루틴을 실행합니다.
+            this->_handle.promise().setContinuation(continuation);
+            return (this->_handle);
+        }
+
+        T await_resume()
+        {
+            return (this->_handle.promise().takeResult());
+        }
+
+    private:
+        handle_type _handle;
+    };
+
+public:
+    Task() noexcept
+        : _handle(nullptr)
+    {
+    }
+
+    explicit Task(handle_type handle) noexcept
+        : _handle(handle)
+    {
+    }
+
+    ~Task()
+    {
+        this->reset();
+    }
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    Task(const Task& obj) = delete;
+    Task& operator=(const Task& obj) = delete;
+
+    Task(Task&& obj) noexcept
+        : _handle(std::exchange(obj._handle, nullptr))
+    {
+    }
+
+    Task& operator=(Task&& obj) noexcept
+    {
+        if (this != &obj)
+        {
+            this->reset();
+            this->_handle = std::exchange(obj._handle, nullptr);
+        }
+        return (*this);
+    }
+
+public:
+    Awaiter operator co_await() && noexcept
+    {
+        return (Awaiter(this->_handle));
+    }
+
+    /**
+     * @fn void Task::start()
+     * @brief 아직 시작하지 않은 최상위 코루틴을 첫 중단 지점까지 실행합니다.
+     * @return 없음.
+     */
+    void start()
+    {
+        if (this->_handle && !this->_handle.done())
+        {
+            this->_handle.resume();
+        }
+    }
+
+    /**
+     * @fn bool Task::isValid() const
+     * @brief Task가 코루틴 프레임을 소유하고 있는지 확인합니다.
+     * @return bool : 프레임을 소유하면 true.
+     */
+    bool isValid() const noexcept
+    {
+        return (static_cast<bool>(this->_handle));
+    }
+
+    /**
+     * @fn bool Task::isDone() const
+     * @brief 코루틴이 끝까지 실행되었는지 확인합니다.
+     * @return bool : 코루틴이 종료되었거나 프레임이 없으면 true.
+     */
+    bool isDone() const noexcept
+    {
+        return (!this->_handle || this->_handle.done());
+    }
+
+    /**
+     * @fn void Task::reset()
+     * @brief 소유한 코루틴 프레임을 파괴하고 빈 Task가 됩니다.
+     * @return 없음.
+     */
+    void reset() noexcept
+    {
+        if (this->_handle)
+        {
+            this->_handle.destroy();
+            this->_handle = nullptr;
+        }
+    }
+
+private:
+    /// 소유한 코루틴 핸들.
+    handle_type _handle;
+};
+
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return (Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this)));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return (Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this)));
+}
+
+#pragma pop_macro("new")
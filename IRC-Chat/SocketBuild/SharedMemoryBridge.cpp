@@ -0,0 +1,406 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SharedMemoryBridge.cpp
+ * @brief SharedMemoryBridge.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "SharedMemoryBridge.h"
+#include "DebugHelper.h"
+#include <cstring>
+
+SharedMemoryBridge::SharedMemoryBridge()
+    : _mapping(nullptr), _layout(nullptr), _inbound(nullptr), _outbound(nullptr), _inboundEvent(nullptr), _outboundEvent(nullptr),
+      _sentCount(0), _receivedCount(0), _droppedCount(0), _corruptedCount(0), _wakeSocket(INVALID_SOCKET), _signalSocket(INVALID_SOCKET),
+      _wakeThread(), _wakeMutex(), _wakeCondition(), _wakePending(false), _wakeStopping(false)
+{
+    LOG_DEBUG("SharedMemoryBridge 객체를 생성합니다.");
+}
+
+SharedMemoryBridge::~SharedMemoryBridge()
+{
+    this->close();
+    LOG_DEBUG("SharedMemoryBridge 객체를 삭제합니다.");
+}
+
+SharedMemoryBridge::Result SharedMemoryBridge::open(const std::string& name, SharedMemoryBridge::Role role)
+{
+    std::string mapping_name = "Local\\" + name;
+
+    if (role == SharedMemoryBridge::Role::SERVER)
+    {
+        this->_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD)sizeof(SharedMemoryBridge::Layout), mapping_name.c_str());
+        if (this->_mapping != nullptr && GetLastError() == ERROR_ALREADY_EXISTS)
+        {
+            LOG_WARN("이미 있는 공유 영역을 다시 초기화합니다: " + mapping_name);
+        }
+    }
+    else
+    {
+        this->_mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapping_name.c_str());
+    }
+    if (this->_mapping == nullptr)
+    {
+        LOG_ERROR("공유 영역을 열 수 없습니다: " + mapping_name + ", 오류 코드: " + std::to_string(GetLastError()));
+        return (SharedMemoryBridge::Result::FAIL_MAPPING);
+    }
+
+    this->_layout = (SharedMemoryBridge::Layout*)MapViewOfFile(this->_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedMemoryBridge::Layout));
+    if (this->_layout == nullptr)
+    {
+        LOG_ERROR("공유 영역을 매핑할 수 없습니다. 오류 코드: " + std::to_string(GetLastError()));
+        this->close();
+        return (SharedMemoryBridge::Result::FAIL_MAPPING);
+    }
+
+    if (role == SharedMemoryBridge::Role::SERVER)
+    {
+        // 위치를 모두 0으로 맞춘 뒤 마지막에 표시를 세워, 게임 서버가 반쯤 초기화된 영역을 보지 않게 합니다.
+        this->_layout->magic.store(0, std::memory_order_relaxed);
+        for (SharedMemoryBridge::Ring* ring : { &this->_layout->toServer, &this->_layout->toGame })
+        {
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->tail.store(0, std::memory_order_relaxed);
+            ring->consumerWaiting.store(0, std::memory_order_relaxed);
+        }
+        this->_layout->version = SharedMemoryBridge::LAYOUT_VERSION;
+        this->_layout->magic.store(SharedMemoryBridge::LAYOUT_MAGIC, std::memory_order_release);
+
+        this->_inbound = &this->_layout->toServer;
+        this->_outbound = &this->_layout->toGame;
+        this->_inboundEvent = this->openEvent(mapping_name + ".ToServer", role);
+        this->_outboundEvent = this->openEvent(mapping_name + ".ToGame", role);
+    }
+    else
+    {
+        if (this->_layout->magic.load(std::memory_order_acquire) != SharedMemoryBridge::LAYOUT_MAGIC
+            || this->_layout->version != SharedMemoryBridge::LAYOUT_VERSION)
+        {
+            LOG_ERROR("공유 영역이 초기화되지 않았거나 배치 버전이 다릅니다: " + mapping_name);
+            this->close();
+            return (SharedMemoryBridge::Result::INCOMPATIBLE);
+        }
+
+        this->_inbound = &this->_layout->toGame;
+        this->_outbound = &this->_layout->toServer;
+        this->_inboundEvent = this->openEvent(mapping_name + ".ToGame", role);
+        this->_outboundEvent = this->openEvent(mapping_name + ".ToServer", role);
+    }
+
+    if (this->_inboundEvent == nullptr || this->_outboundEvent == nullptr)
+    {
+        LOG_ERROR("깨우기 이벤트를 열 수 없습니다. 오류 코드: " + std::to_string(GetLastError()));
+        this->close();
+        return (SharedMemoryBridge::Result::FAIL_EVENT);
+    }
+
+    LOG_INFO("공유 메모리 브리지를 열었습니다: " + mapping_name);
+    return (SharedMemoryBridge::Result::SUCCESS);
+}
+
+SharedMemoryBridge::Result SharedMemoryBridge::startWakeSocket()
+{
+    if (this->isOpen() == false)
+    {
+        return (SharedMemoryBridge::Result::NOT_OPEN);
+    }
+
+    // 깨우기 소켓은 루프백의 빈 포트에 바인드하고, 루프가 비울 때 막히지 않도록 논블로킹으로 둡니다.
+    sockaddr_in wake_addr = {};
+    int wake_addr_length = sizeof(wake_addr);
+    wake_addr.sin_family = AF_INET;
+    wake_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    wake_addr.sin_port = 0;
+    u_long non_blocking = 1;
+
+    this->_wakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    this->_signalSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (this->_wakeSocket == INVALID_SOCKET || this->_signalSocket == INVALID_SOCKET
+        || bind(this->_wakeSocket, (const sockaddr*)&wake_addr, (int)sizeof(wake_addr)) == SOCKET_ERROR
+        || getsockname(this->_wakeSocket, (sockaddr*)&wake_addr, &wake_addr_length) == SOCKET_ERROR
+        || ioctlsocket(this->_wakeSocket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        LOG_ERROR("브리지 깨우기 소켓을 만들 수 없습니다. 오류 코드: " + std::to_string(WSAGetLastError()));
+        this->stopWakeSocket();
+        return (SharedMemoryBridge::Result::FAIL_WAKE_SOCKET);
+    }
+
+    this->_wakePending = false;
+    this->_wakeStopping = false;
+    this->_wakeThread = std::thread(&SharedMemoryBridge::runWakeThread, this, wake_addr);
+    return (SharedMemoryBridge::Result::SUCCESS);
+}
+
+SOCKET SharedMemoryBridge::getWakeSocket() const
+{
+    return (this->_wakeSocket);
+}
+
+void SharedMemoryBridge::rearmWakeSocket()
+{
+    if (this->_wakeSocket == INVALID_SOCKET)
+    {
+        return ;
+    }
+
+    // 쌓인 신호를 모두 읽어 소켓을 읽기 불가 상태로 되돌린 뒤 다시 깨울 수 있게 합니다.
+    char buffer[16];
+    while (recv(this->_wakeSocket, buffer, (int)sizeof(buffer), 0) > 0)
+    {
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_wakeMutex);
+        this->_wakePending = false;
+    }
+    this->_wakeCondition.notify_one();
+}
+
+void SharedMemoryBridge::close()
+{
+    // 깨우기 스레드가 링을 보고 있을 수 있으므로 매핑보다 먼저 멈춥니다.
+    this->stopWakeSocket();
+
+    if (this->_inboundEvent != nullptr)
+    {
+        CloseHandle(this->_inboundEvent);
+        this->_inboundEvent = nullptr;
+    }
+    if (this->_outboundEvent != nullptr)
+    {
+        CloseHandle(this->_outboundEvent);
+        this->_outboundEvent = nullptr;
+    }
+    if (this->_layout != nullptr)
+    {
+        UnmapViewOfFile(this->_layout);
+        this->_layout = nullptr;
+    }
+    if (this->_mapping != nullptr)
+    {
+        CloseHandle(this->_mapping);
+        this->_mapping = nullptr;
+    }
+    this->_inbound = nullptr;
+    this->_outbound = nullptr;
+}
+
+bool SharedMemoryBridge::isOpen() const
+{
+    return (this->_layout != nullptr && this->_inbound != nullptr);
+}
+
+SharedMemoryBridge::Result SharedMemoryBridge::send(const std::string& message)
+{
+    if (this->isOpen() == false)
+    {
+        return (SharedMemoryBridge::Result::NOT_OPEN);
+    }
+    if (message.size() > SharedMemoryBridge::MAX_MESSAGE_SIZE)
+    {
+        this->_droppedCount = this->_droppedCount + 1;
+        return (SharedMemoryBridge::Result::TOO_LARGE);
+    }
+
+    SharedMemoryBridge::Ring& ring = *this->_outbound;
+    std::uint32_t length = (std::uint32_t)message.size();
+    std::uint32_t record_size = SharedMemoryBridge::getRecordSize(length);
+    std::uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    std::uint32_t head = ring.head.load(std::memory_order_acquire);
+    std::uint32_t offset = tail & (SharedMemoryBridge::RING_CAPACITY - 1);
+    std::uint32_t to_end = SharedMemoryBridge::RING_CAPACITY - offset;
+
+    // 끝에 들어가지 않으면 남은 자리를 건너뛰고 처음부터 씁니다.
+    std::uint32_t needed = (to_end < record_size) ? to_end + record_size : record_size;
+    if (SharedMemoryBridge::RING_CAPACITY - (tail - head) < needed)
+    {
+        this->_droppedCount = this->_droppedCount + 1;
+        return (SharedMemoryBridge::Result::FULL);
+    }
+    if (to_end < record_size)
+    {
+        std::memcpy(ring.data + offset, &SharedMemoryBridge::WRAP_MARKER, sizeof(std::uint32_t));
+        tail = tail + to_end;
+        offset = 0;
+    }
+
+    std::memcpy(ring.data + offset, &length, sizeof(std::uint32_t));
+    std::memcpy(ring.data + offset + sizeof(std::uint32_t), message.data(), length);
+    ring.tail.store(tail + record_size, std::memory_order_release);
+    this->_sentCount = this->_sentCount + 1;
+
+    // 위치 공개와 대기 표시 확인 사이의 순서를 보장해 상대가 잠드는 순간의 깨우기를 놓치지 않습니다.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ring.consumerWaiting.load(std::memory_order_relaxed) != 0)
+    {
+        SetEvent(this->_outboundEvent);
+    }
+    return (SharedMemoryBridge::Result::SUCCESS);
+}
+
+SharedMemoryBridge::Result SharedMemoryBridge::receive(std::string& message)
+{
+    if (this->isOpen() == false)
+    {
+        return (SharedMemoryBridge::Result::NOT_OPEN);
+    }
+
+    SharedMemoryBridge::Ring& ring = *this->_inbound;
+    std::uint32_t head = ring.head.load(std::memory_order_relaxed);
+    std::uint32_t tail = ring.tail.load(std::memory_order_acquire);
+    if (head == tail)
+    {
+        return (SharedMemoryBridge::Result::EMPTY);
+    }
+
+    // 두 위치가 링 크기보다 멀리 떨어져 있으면(head가 tail을 앞지른 경우 포함) 위치 자체가 잘못된 것이므로 레코드를 읽지 않습니다.
+    bool positions_valid = (tail - head <= SharedMemoryBridge::RING_CAPACITY);
+    std::uint32_t offset = head & (SharedMemoryBridge::RING_CAPACITY - 1);
+    std::uint32_t length = 0;
+    if (positions_valid)
+    {
+        std::memcpy(&length, ring.data + offset, sizeof(std::uint32_t));
+        if (length == SharedMemoryBridge::WRAP_MARKER)
+        {
+            head = head + (SharedMemoryBridge::RING_CAPACITY - offset);
+            offset = 0;
+            std::memcpy(&length, ring.data, sizeof(std::uint32_t));
+        }
+    }
+
+    // 상대 프로세스가 쓴 값이므로 범위를 확인합니다.
+    // 잘못된 레코드는 건너뛸 길이를 알 수 없으므로 지금까지 쓰인 내용을 모두 버리고 생산자가 새로 쓰는 것부터 읽습니다.
+    if (positions_valid == false || length > SharedMemoryBridge::MAX_MESSAGE_SIZE || tail - head < SharedMemoryBridge::getRecordSize(length))
+    {
+        LOG_ERROR("공유 메모리 링의 위치 또는 길이 정보가 잘못되었습니다: " + std::to_string(length) + ", 남은 " + std::to_string(tail - head) + "바이트를 버립니다.");
+        ring.head.store(tail, std::memory_order_release);
+        this->_corruptedCount = this->_corruptedCount + 1;
+        return (SharedMemoryBridge::Result::CORRUPTED);
+    }
+
+    message.assign(ring.data + offset + sizeof(std::uint32_t), length);
+    ring.head.store(head + SharedMemoryBridge::getRecordSize(length), std::memory_order_release);
+    this->_receivedCount = this->_receivedCount + 1;
+    return (SharedMemoryBridge::Result::SUCCESS);
+}
+
+bool SharedMemoryBridge::waitForMessage(int timeout_ms)
+{
+    if (this->isOpen() == false)
+    {
+        return (false);
+    }
+
+    SharedMemoryBridge::Ring& ring = *this->_inbound;
+    if (ring.head.load(std::memory_order_relaxed) != ring.tail.load(std::memory_order_acquire))
+    {
+        return (true);
+    }
+
+    // 대기 표시를 세운 뒤 다시 확인합니다. 그 사이에 들어온 메시지는 생산자가 표시를 보고 깨웁니다.
+    ring.consumerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ring.head.load(std::memory_order_relaxed) == ring.tail.load(std::memory_order_acquire))
+    {
+        WaitForSingleObject(this->_inboundEvent, (DWORD)timeout_ms);
+    }
+    ring.consumerWaiting.store(0, std::memory_order_relaxed);
+
+    return (ring.head.load(std::memory_order_relaxed) != ring.tail.load(std::memory_order_acquire));
+}
+
+std::uint64_t SharedMemoryBridge::getSentCount() const
+{
+    return (this->_sentCount);
+}
+
+std::uint64_t SharedMemoryBridge::getReceivedCount() const
+{
+    return (this->_receivedCount);
+}
+
+std::uint64_t SharedMemoryBridge::getDroppedCount() const
+{
+    return (this->_droppedCount);
+}
+
+std::uint64_t SharedMemoryBridge::getCorruptedCount() const
+{
+    return (this->_corruptedCount);
+}
+
+std::uint32_t SharedMemoryBridge::getRecordSize(std::uint32_t length)
+{
+    return ((length + (std::uint32_t)sizeof(std::uint32_t) + 3u) & ~3u);
+}
+
+HANDLE SharedMemoryBridge::openEvent(const std::string& name, SharedMemoryBridge::Role role)
+{
+    // 자동 리셋 이벤트: 깨어난 대기자 하나가 신호를 소비합니다.
+    if (role == SharedMemoryBridge::Role::SERVER)
+    {
+        return (CreateEventA(nullptr, FALSE, FALSE, name.c_str()));
+    }
+    return (OpenEventA(SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, name.c_str()));
+}
+
+void SharedMemoryBridge::runWakeThread(sockaddr_in wake_addr)
+{
+    while (true)
+    {
+        // 루프가 지난 신호를 처리할 때까지 링을 보지 않습니다.
+        {
+            std::unique_lock<std::mutex> lock(this->_wakeMutex);
+            this->_wakeCondition.wait(lock, [this]() { return (this->_wakePending == false || this->_wakeStopping); });
+            if (this->_wakeStopping)
+            {
+                return ;
+            }
+        }
+
+        if (this->waitForMessage(SharedMemoryBridge::WAKE_CHECK_MS) == false)
+        {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->_wakeMutex);
+            if (this->_wakeStopping)
+            {
+                return ;
+            }
+            this->_wakePending = true;
+        }
+        char signal = 1;
+        sendto(this->_signalSocket, &signal, 1, 0, (const sockaddr*)&wake_addr, (int)sizeof(wake_addr));
+    }
+}
+
+void SharedMemoryBridge::stopWakeSocket()
+{
+    if (this->_wakeThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->_wakeMutex);
+            this->_wakeStopping = true;
+        }
+        this->_wakeCondition.notify_one();
+
+        // 이벤트를 기다리는 중이면 바로 깨웁니다. (자동 리셋이므로 아직 기다리기 전이어도 신호가 남습니다.)
+        SetEvent(this->_inboundEvent);
+        this->_wakeThread.join();
+    }
+
+    if (this->_wakeSocket != INVALID_SOCKET)
+    {
+        closesocket(this->_wakeSocket);
+        this->_wakeSocket = INVALID_SOCKET;
+    }
+    if (this->_signalSocket != INVALID_SOCKET)
+    {
+        closesocket(this->_signalSocket);
+        this->_signalSocket = INVALID_SOCKET;
+    }
+}
@@ -0,0 +1,339 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SharedMemoryBridge.h
+ * @brief 같은 호스트의 게임 서버와 공유 메모리 링 버퍼로 메시지를 주고받는 SharedMemoryBridge 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 이름 있는 파일 매핑(CreateFileMapping) 하나에 방향별 단일 생산자/단일 소비자 링 버퍼 두 개를 둡니다.
+ * - toServer : 게임 서버 → 채팅 서버 (시스템 메시지 주입).
+ * - toGame : 채팅 서버 → 게임 서버 (게임 화면에 표시할 채팅).
+ *
+ * 메시지를 넣고 빼는 데는 시스템 호출이 없습니다. 소비자가 waitForMessage()로 잠들어 있을 때만
+ * <br>생산자가 이름 있는 이벤트(SetEvent)로 깨웁니다. (futex처럼 대기 표시가 있을 때만 커널을 부릅니다.)
+ * <br>채팅 서버 루프는 select로 대기하므로 이벤트를 직접 기다릴 수 없습니다. 대신 startWakeSocket()이 띄운 스레드가 이벤트를 기다리다가
+ * <br>루프백 UDP 소켓(getWakeSocket())에 1바이트를 보내, 루프가 다른 소켓과 함께 select로 기다리게 합니다.
+ *
+ * 게임 서버 쪽 사용 예:
+ * @code
+ * SharedMemoryBridge bridge;
+ * bridge.open("UnrealChatBridge", SharedMemoryBridge::Role::GAME);
+ * bridge.send("라운드가 시작되었습니다.");
+ * std::string chat_line;
+ * while (bridge.waitForMessage(16))
+ * {
+ *     while (bridge.receive(chat_line) == SharedMemoryBridge::Result::SUCCESS) { ... }
+ * }
+ * @endcode
+ */
+
+#include <WinSock2.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class SharedMemoryBridge
+ * @brief 공유 메모리 링 버퍼 한 쌍과 깨우기 이벤트를 관리하는 클래스입니다. 채팅 서버와 게임 서버가 같은 클래스를 역할만 달리해 사용합니다.
+ *
+ * @note 방향마다 생산자와 소비자가 각각 한 스레드여야 합니다.
+ */
+class SharedMemoryBridge
+{
+public:
+    /// 방향 하나의 링 버퍼 크기(바이트, 2의 거듭제곱).
+    static constexpr std::uint32_t RING_CAPACITY = 256 * 1024;
+
+    /// 메시지 하나의 최대 크기(바이트).
+    static constexpr std::uint32_t MAX_MESSAGE_SIZE = 4096;
+
+    /// 공유 영역이 초기화되었음을 나타내는 값 ("CHAT").
+    static constexpr std::uint32_t LAYOUT_MAGIC = 0x43484154;
+
+    /// 공유 영역 배치 버전. 배치가 바뀌면 올립니다.
+    static constexpr std::uint32_t LAYOUT_VERSION = 1;
+
+    /// 깨우기 스레드가 이벤트를 한 번에 기다리는 최대 시간(밀리초). 종료는 이벤트로 알리므로 놓쳤을 때의 안전장치입니다.
+    static constexpr int WAKE_CHECK_MS = 1000;
+
+public:
+    /**
+     * @enum SharedMemoryBridge::Role
+     * @brief 브리지를 여는 쪽의 역할.
+     */
+    enum class Role
+    {
+        SERVER,     ///< 채팅 서버. 공유 영역을 만들고 toServer를 읽고 toGame에 씁니다.
+        GAME        ///< 게임 서버. 만들어진 공유 영역을 열고 toGame을 읽고 toServer에 씁니다.
+    };
+
+    /**
+     * @enum SharedMemoryBridge::Result
+     * @brief SharedMemoryBridge 함수의 반환값.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 성공.
+        FAIL_MAPPING,   ///< 파일 매핑 생성/열기 실패.
+        FAIL_EVENT,     ///< 깨우기 이벤트 생성/열기 실패.
+        FAIL_WAKE_SOCKET,   ///< 깨우기 소켓 생성 실패.
+        INCOMPATIBLE,   ///< 공유 영역이 초기화되지 않았거나 배치 버전이 다름.
+        NOT_OPEN,       ///< 브리지가 열려 있지 않음.
+        FULL,           ///< 링 버퍼에 공간이 없음 (메시지를 버림).
+        EMPTY,          ///< 읽을 메시지가 없음.
+        TOO_LARGE,      ///< 메시지가 MAX_MESSAGE_SIZE보다 큼.
+        CORRUPTED       ///< 링 버퍼의 위치 또는 길이 정보가 잘못됨 (링에 남은 내용을 버림).
+    };
+
+public:
+    /**
+     * @fn SharedMemoryBridge::SharedMemoryBridge()
+     * @brief 닫힌 상태의 브리지를 생성합니다.
+     * @return 없음.
+     */
+    SharedMemoryBridge();
+
+    /**
+     * @fn SharedMemoryBridge::~SharedMemoryBridge()
+     * @brief 소멸자. 열린 매핑과 이벤트를 닫습니다.
+     * @return 없음.
+     */
+    ~SharedMemoryBridge();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SharedMemoryBridge(const SharedMemoryBridge& obj) = delete;
+    SharedMemoryBridge& operator=(const SharedMemoryBridge& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SharedMemoryBridge(SharedMemoryBridge&& obj) = delete;
+    SharedMemoryBridge& operator=(SharedMemoryBridge&& obj) = delete;
+
+public:
+    /**
+     * @fn SharedMemoryBridge::Result SharedMemoryBridge::open(const std::string& name, SharedMemoryBridge::Role role)
+     * @brief 이름 있는 공유 영역과 깨우기 이벤트를 만들거나 엽니다.
+     * @param[IN] const std::string& name : 브리지 이름 (두 프로세스가 같은 이름을 사용합니다).
+     * @param[IN] SharedMemoryBridge::Role role : 이 프로세스의 역할.
+     * @return SharedMemoryBridge::Result : 결과 코드.
+     * @note SERVER가 먼저 열어야 합니다. GAME은 SERVER가 초기화한 영역만 엽니다.
+     */
+    SharedMemoryBridge::Result open(const std::string& name, SharedMemoryBridge::Role role);
+
+    /**
+     * @fn SharedMemoryBridge::Result SharedMemoryBridge::startWakeSocket()
+     * @brief 내 방향 링에 메시지가 들어오면 읽기 가능해지는 루프백 UDP 소켓과, 이벤트를 기다려 그 소켓을 깨우는 스레드를 시작합니다.
+     * @return SharedMemoryBridge::Result : SUCCESS, NOT_OPEN 또는 FAIL_WAKE_SOCKET.
+     *
+     * @details
+     * 한 번 깨운 뒤에는 rearmWakeSocket()을 부를 때까지 다시 깨우지 않으므로, 메시지가 몰려도 신호는 반복마다 하나입니다.
+     * <br>깨우기 스레드는 waitForMessage()만 부르고 receive()는 부르지 않으므로 링의 단일 소비자 규칙을 지킵니다.
+     * @note WSAStartup() 뒤에 open()한 브리지에서 호출합니다. close()가 스레드를 멈추고 소켓을 닫습니다.
+     */
+    SharedMemoryBridge::Result startWakeSocket();
+
+    /**
+     * @fn SOCKET SharedMemoryBridge::getWakeSocket() const
+     * @brief select에 등록할 깨우기 소켓을 반환합니다.
+     * @return SOCKET : 깨우기 소켓, 시작하지 않았으면 INVALID_SOCKET.
+     */
+    SOCKET getWakeSocket() const;
+
+    /**
+     * @fn void SharedMemoryBridge::rearmWakeSocket()
+     * @brief 깨우기 소켓에 쌓인 신호를 비우고 다음 메시지에 다시 깨우도록 합니다. 링을 읽은 뒤 호출합니다.
+     * @return 없음.
+     * @note 링에 아직 메시지가 남아 있으면 곧바로 다시 깨웁니다.
+     */
+    void rearmWakeSocket();
+
+    /**
+     * @fn void SharedMemoryBridge::close()
+     * @brief 매핑과 이벤트를 닫습니다.
+     * @return 없음.
+     */
+    void close();
+
+    /**
+     * @fn bool SharedMemoryBridge::isOpen() const
+     * @brief 브리지가 열려 있는지 확인합니다.
+     * @return bool : 열려 있으면 true.
+     */
+    bool isOpen() const;
+
+    /**
+     * @fn SharedMemoryBridge::Result SharedMemoryBridge::send(const std::string& message)
+     * @brief 상대 방향 링 버퍼에 메시지 하나를 넣습니다. 상대가 잠들어 있으면 깨웁니다.
+     * @param[IN] const std::string& message : 보낼 메시지.
+     * @return SharedMemoryBridge::Result : SUCCESS, FULL, TOO_LARGE 또는 NOT_OPEN.
+     * @note 공간이 없으면 기다리지 않고 FULL을 반환합니다.
+     */
+    SharedMemoryBridge::Result send(const std::string& message);
+
+    /**
+     * @fn SharedMemoryBridge::Result SharedMemoryBridge::receive(std::string& message)
+     * @brief 내 방향 링 버퍼에서 메시지 하나를 꺼냅니다.
+     * @param[OUT] std::string& message : 꺼낸 메시지.
+     * @return SharedMemoryBridge::Result : SUCCESS, EMPTY, CORRUPTED 또는 NOT_OPEN.
+     */
+    SharedMemoryBridge::Result receive(std::string& message);
+
+    /**
+     * @fn bool SharedMemoryBridge::waitForMessage(int timeout_ms)
+     * @brief 읽을 메시지가 생길 때까지 최대 timeout_ms 동안 잠듭니다.
+     * @param[IN] int timeout_ms : 최대 대기 시간(밀리초).
+     * @return bool : 읽을 메시지가 있으면 true, 시간이 다 되었거나 닫혀 있으면 false.
+     * @note 대기 표시를 먼저 세운 뒤 링을 다시 확인하므로 깨우기를 놓치지 않습니다.
+     */
+    bool waitForMessage(int timeout_ms);
+
+    /**
+     * @fn std::uint64_t SharedMemoryBridge::getSentCount() const
+     * @brief 지금까지 보낸 메시지 수를 반환합니다.
+     * @return std::uint64_t : 보낸 수.
+     */
+    std::uint64_t getSentCount() const;
+
+    /**
+     * @fn std::uint64_t SharedMemoryBridge::getReceivedCount() const
+     * @brief 지금까지 받은 메시지 수를 반환합니다.
+     * @return std::uint64_t : 받은 수.
+     */
+    std::uint64_t getReceivedCount() const;
+
+    /**
+     * @fn std::uint64_t SharedMemoryBridge::getDroppedCount() const
+     * @brief 링 버퍼가 가득 차 버린 메시지 수를 반환합니다.
+     * @return std::uint64_t : 버린 수.
+     */
+    std::uint64_t getDroppedCount() const;
+
+    /**
+     * @fn std::uint64_t SharedMemoryBridge::getCorruptedCount() const
+     * @brief 위치 또는 길이 정보가 잘못되어 링에 남은 내용을 버린 횟수를 반환합니다.
+     * @return std::uint64_t : 버린 횟수.
+     */
+    std::uint64_t getCorruptedCount() const;
+
+private:
+    /**
+     * @struct SharedMemoryBridge::Ring
+     * @brief 공유 영역 안의 단일 생산자/단일 소비자 링 버퍼 하나.
+     *
+     * @details
+     * 위치는 계속 증가하는 32비트 값이며 (위치 & (RING_CAPACITY - 1))이 실제 오프셋입니다.
+     * <br>레코드는 [길이 4바이트][내용]이고 4바이트 단위로 정렬됩니다.
+     * <br>끝까지 남은 공간이 모자라면 WRAP_MARKER를 쓰고 처음부터 이어 씁니다.
+     * <br>생산자와 소비자가 쓰는 값은 서로 다른 캐시 라인에 둡니다.
+     */
+    struct Ring
+    {
+        alignas(64) std::atomic<std::uint32_t> head;            ///< 소비자가 다음에 읽을 위치.
+        alignas(64) std::atomic<std::uint32_t> tail;            ///< 생산자가 다음에 쓸 위치.
+        alignas(64) std::atomic<std::uint32_t> consumerWaiting; ///< 소비자가 이벤트를 기다리는 중이면 1.
+        alignas(64) char data[SharedMemoryBridge::RING_CAPACITY];   ///< 레코드 저장 공간.
+    };
+
+    /**
+     * @struct SharedMemoryBridge::Layout
+     * @brief 공유 영역 전체 배치.
+     */
+    struct Layout
+    {
+        std::atomic<std::uint32_t> magic;   ///< 초기화 완료 표시 (LAYOUT_MAGIC).
+        std::uint32_t version;              ///< 배치 버전 (LAYOUT_VERSION).
+        SharedMemoryBridge::Ring toServer;  ///< 게임 서버 → 채팅 서버.
+        SharedMemoryBridge::Ring toGame;    ///< 채팅 서버 → 게임 서버.
+    };
+
+    /// 링을 처음으로 되감으라는 표시 (길이 자리에 씁니다).
+    static constexpr std::uint32_t WRAP_MARKER = 0xFFFFFFFFu;
+
+private:
+    /// 파일 매핑 핸들.
+    HANDLE _mapping;
+
+    /// 매핑된 공유 영역.
+    SharedMemoryBridge::Layout* _layout;
+
+    /// 내가 읽는 링 (SERVER : toServer, GAME : toGame).
+    SharedMemoryBridge::Ring* _inbound;
+
+    /// 내가 쓰는 링 (SERVER : toGame, GAME : toServer).
+    SharedMemoryBridge::Ring* _outbound;
+
+    /// 내가 기다리는 이벤트.
+    HANDLE _inboundEvent;
+
+    /// 상대를 깨우는 이벤트.
+    HANDLE _outboundEvent;
+
+    /// 보낸 메시지 수.
+    std::uint64_t _sentCount;
+
+    /// 받은 메시지 수.
+    std::uint64_t _receivedCount;
+
+    /// 버린 메시지 수.
+    std::uint64_t _droppedCount;
+
+    /// 위치 또는 길이 정보가 잘못되어 링을 비운 횟수.
+    std::uint64_t _corruptedCount;
+
+    /// 깨우기 소켓 (루프가 select로 기다리는 쪽).
+    SOCKET _wakeSocket;
+
+    /// 깨우기 스레드가 신호를 보내는 소켓.
+    SOCKET _signalSocket;
+
+    /// 이벤트를 기다려 깨우기 소켓에 신호를 보내는 스레드.
+    std::thread _wakeThread;
+
+    /// _wakePending, _wakeStopping 보호용 뮤텍스와 그 조건 변수.
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+
+    /// 신호를 보낸 뒤 아직 rearmWakeSocket()이 불리지 않았으면 true.
+    bool _wakePending;
+
+    /// 깨우기 스레드에 종료를 요청했으면 true.
+    bool _wakeStopping;
+
+private:
+    /**
+     * @fn static std::uint32_t SharedMemoryBridge::getRecordSize(std::uint32_t length)
+     * @brief 내용 길이로 정렬된 레코드 크기를 구합니다.
+     * @param[IN] std::uint32_t length : 내용 길이.
+     * @return std::uint32_t : 길이 필드를 포함해 4바이트 단위로 올린 크기.
+     */
+    static std::uint32_t getRecordSize(std::uint32_t length);
+
+    /**
+     * @fn HANDLE SharedMemoryBridge::openEvent(const std::string& name, SharedMemoryBridge::Role role)
+     * @brief 역할에 따라 이름 있는 자동 리셋 이벤트를 만들거나 엽니다.
+     * @param[IN] const std::string& name : 이벤트 이름.
+     * @param[IN] SharedMemoryBridge::Role role : SERVER이면 만들고, GAME이면 엽니다.
+     * @return HANDLE : 이벤트 핸들, 실패 시 nullptr.
+     */
+    HANDLE openEvent(const std::string& name, SharedMemoryBridge::Role role);
+
+    /**
+     * @fn void SharedMemoryBridge::runWakeThread(sockaddr_in wake_addr)
+     * @brief 깨우기 스레드 본체. 메시지가 들어오면 wake_addr로 1바이트를 보내고 rearmWakeSocket()을 기다립니다.
+     * @param[IN] sockaddr_in wake_addr : 깨우기 소켓 주소 (127.0.0.1).
+     * @return 없음.
+     */
+    void runWakeThread(sockaddr_in wake_addr);
+
+    /**
+     * @fn void SharedMemoryBridge::stopWakeSocket()
+     * @brief 깨우기 스레드를 멈추고 소켓을 닫습니다.
+     * @return 없음.
+     */
+    void stopWakeSocket();
+};
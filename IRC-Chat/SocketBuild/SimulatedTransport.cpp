@@ -0,0 +1,804 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SimulatedTransport.cpp
+ * @brief SimulatedTransport.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "SimulatedTransport.h"
+#include "DebugHelper.h"
+#include <algorithm>
+#include <cstring>
+
+SimulatedTransport::SimulatedTransport()
+    : _sockets(), _events(), _pendingAccepts(), _pendingAcceptHead(0), _nowMs(0), _nextSequence(0), _lastError(0),
+      _readChunkLimit(0), _writeChunkLimit(0), _captureOutput(false), _totalBytesSent(0), _totalBytesReceived(0),
+      _sendCallCount(0), _receiveCallCount(0), _selectCallCount(0),
+      _capturedDatagrams(), _datagramSendCount(0), _refusedPorts(), _stalledPorts(), _connectedSockets()
+{
+    LOG_DEBUG("SimulatedTransport 객체를 생성합니다.");
+}
+
+SimulatedTransport::~SimulatedTransport()
+{
+    LOG_DEBUG("SimulatedTransport 객체를 삭제합니다.");
+}
+
+SOCKET SimulatedTransport::createSocket()
+{
+    return (this->allocateSocket(SimulatedTransport::SocketState::CREATED));
+}
+
+int SimulatedTransport::bindSocket(SOCKET socket, int port)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (this->fail(WSAEINVAL));
+    }
+    if (target->state != SimulatedTransport::SocketState::CREATED && target->state != SimulatedTransport::SocketState::DATAGRAM)
+    {
+        return (this->fail(WSAEINVAL));
+    }
+
+    // 데이터그램은 바인드된 포트로 찾아 전달합니다.
+    target->boundPort = port;
+    return (0);
+}
+
+int SimulatedTransport::listenSocket(SOCKET socket)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::CREATED)
+    {
+        return (this->fail(WSAEINVAL));
+    }
+
+    target->state = SimulatedTransport::SocketState::LISTENING;
+    return (0);
+}
+
+SOCKET SimulatedTransport::acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr)
+{
+    VirtualSocket* listener = this->findSocket(listen_socket);
+    if (listener == nullptr || listener->state != SimulatedTransport::SocketState::LISTENING)
+    {
+        this->fail(WSAEINVAL);
+        return (INVALID_SOCKET);
+    }
+
+    // 이 포트로 도착한 연결이 없으면 논블로킹 소켓처럼 동작합니다.
+    std::size_t position = this->findPendingAccept(listener->boundPort);
+    if (position == this->_pendingAccepts.size())
+    {
+        this->fail(WSAEWOULDBLOCK);
+        return (INVALID_SOCKET);
+    }
+
+    SOCKET client_socket = this->_pendingAccepts[position];
+    if (position == this->_pendingAcceptHead)
+    {
+        this->_pendingAcceptHead = this->_pendingAcceptHead + 1;
+    }
+    else
+    {
+        this->_pendingAccepts.erase(this->_pendingAccepts.begin() + position);
+    }
+
+    // 대기열을 모두 소비했으면 메모리를 재사용합니다.
+    if (this->_pendingAcceptHead == this->_pendingAccepts.size())
+    {
+        this->_pendingAccepts.clear();
+        this->_pendingAcceptHead = 0;
+    }
+
+    VirtualSocket* client = this->findSocket(client_socket);
+    client->state = SimulatedTransport::SocketState::OPEN;
+
+    // 가상 클라이언트 주소는 (setPeerAddress()로 지정한 주소, 기본 127.0.0.1):(소켓 번호)로 채웁니다.
+    if (client_addr != nullptr)
+    {
+        *client_addr = {};
+        client_addr->sin_family = AF_INET;
+        client_addr->sin_addr.s_addr = htonl(client->peerAddress);
+        client_addr->sin_port = htons((unsigned short)(client_socket & 0xFFFF));
+    }
+
+    return (client_socket);
+}
+
+int SimulatedTransport::connectSocket(SOCKET socket, const char* host, int port)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::CREATED || host == nullptr)
+    {
+        return (this->fail(WSAEINVAL));
+    }
+    if (std::find(this->_refusedPorts.begin(), this->_refusedPorts.end(), port) != this->_refusedPorts.end())
+    {
+        return (this->fail(WSAECONNREFUSED));
+    }
+
+    // 상대는 시나리오가 대신하므로 바로 연결된 것으로 봅니다.
+    target->state = SimulatedTransport::SocketState::OPEN;
+    target->boundPort = port;
+    this->_connectedSockets[port] = socket;
+    return (0);
+}
+
+int SimulatedTransport::startConnect(SOCKET socket, const char* host, int port)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::CREATED || host == nullptr)
+    {
+        return (this->fail(WSAEINVAL));
+    }
+
+    // 실제 논블로킹 connect처럼 결과는 항상 다음 select에서 알려 줍니다.
+    target->state = SimulatedTransport::SocketState::CONNECTING;
+    target->boundPort = port;
+    if (std::find(this->_refusedPorts.begin(), this->_refusedPorts.end(), port) != this->_refusedPorts.end())
+    {
+        target->connectError = WSAECONNREFUSED;
+    }
+    else if (std::find(this->_stalledPorts.begin(), this->_stalledPorts.end(), port) == this->_stalledPorts.end())
+    {
+        target->state = SimulatedTransport::SocketState::OPEN;
+        this->_connectedSockets[port] = socket;
+    }
+    return (this->fail(WSAEWOULDBLOCK));
+}
+
+int SimulatedTransport::getConnectResult(SOCKET socket)
+{
+    const VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (WSAENOTSOCK);
+    }
+    return (target->connectError);
+}
+
+int SimulatedTransport::sendBytes(SOCKET socket, const char* data, int length)
+{
+    this->_sendCallCount = this->_sendCallCount + 1;
+
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::OPEN)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+    if (target->peerClosed)
+    {
+        return (this->fail(WSAECONNRESET));
+    }
+
+    // 상대의 수신 버퍼가 가득 찬 소켓은 논블로킹 소켓처럼 WSAEWOULDBLOCK으로 실패합니다.
+    if (target->sendWindow == 0)
+    {
+        return (this->fail(WSAEWOULDBLOCK));
+    }
+
+    // 부분 쓰기 제한이나 남은 송신 창이 있으면 앞부분만 받아들입니다.
+    int accepted = length;
+    if (this->_writeChunkLimit > 0 && accepted > this->_writeChunkLimit)
+    {
+        accepted = this->_writeChunkLimit;
+    }
+    if (target->sendWindow > 0)
+    {
+        if (accepted > target->sendWindow)
+        {
+            accepted = (int)target->sendWindow;
+        }
+        target->sendWindow = target->sendWindow - accepted;
+    }
+
+    if (this->_captureOutput)
+    {
+        target->captured.append(data, accepted);
+    }
+    target->bytesSent = target->bytesSent + accepted;
+    this->_totalBytesSent = this->_totalBytesSent + accepted;
+
+    return (accepted);
+}
+
+int SimulatedTransport::receiveBytes(SOCKET socket, char* buffer, int length)
+{
+    this->_receiveCallCount = this->_receiveCallCount + 1;
+
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::OPEN)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+
+    std::size_t available = target->inbound.size() - target->readOffset;
+    if (available == 0)
+    {
+        // 상대가 닫았으면 정상 종료(0), 아니면 읽을 데이터가 없음.
+        if (target->peerClosed)
+        {
+            return (0);
+        }
+        return (this->fail(WSAEWOULDBLOCK));
+    }
+
+    // 버퍼 크기와 부분 읽기 제한 중 작은 값만큼 돌려줍니다.
+    std::size_t count = std::min<std::size_t>(available, (std::size_t)length);
+    if (this->_readChunkLimit > 0)
+    {
+        count = std::min<std::size_t>(count, (std::size_t)this->_readChunkLimit);
+    }
+
+    std::memcpy(buffer, target->inbound.data() + target->readOffset, count);
+    target->readOffset = target->readOffset + count;
+    this->_totalBytesReceived = this->_totalBytesReceived + count;
+
+    // 모두 읽었으면 버퍼를 비워 메모리가 계속 늘지 않도록 합니다.
+    if (target->readOffset == target->inbound.size())
+    {
+        target->inbound.clear();
+        target->readOffset = 0;
+    }
+
+    return ((int)count);
+}
+
+int SimulatedTransport::selectReadable(fd_set* read_set, int timeout_ms)
+{
+    return (this->selectSockets(read_set, nullptr, timeout_ms));
+}
+
+int SimulatedTransport::selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms)
+{
+    this->_selectCallCount = this->_selectCallCount + 1;
+    this->deliverDueEvents();
+
+    long long deadline = this->_nowMs + timeout_ms;
+
+    // 준비된 소켓이 생기거나 대기 시간이 끝날 때까지 다음 이벤트 시각으로 건너뜁니다.
+    while (this->countReady(read_set, write_set) == 0 && this->_nowMs < deadline)
+    {
+        long long next_ms = deadline;
+        if (this->_events.empty() == false && this->_events.front().atMs < next_ms)
+        {
+            next_ms = this->_events.front().atMs;
+        }
+        this->advanceTo(next_ms);
+    }
+
+    // Windows fd_set 구조에 맞게 준비된 소켓만 앞으로 모읍니다.
+    unsigned int ready_count = 0;
+    for (unsigned int i = 0; i < read_set->fd_count; ++i)
+    {
+        if (this->isReadable(read_set->fd_array[i]))
+        {
+            read_set->fd_array[ready_count] = read_set->fd_array[i];
+            ready_count = ready_count + 1;
+        }
+    }
+    read_set->fd_count = ready_count;
+
+    if (write_set != nullptr)
+    {
+        unsigned int done_count = 0;
+        for (unsigned int i = 0; i < write_set->fd_count; ++i)
+        {
+            if (this->isConnectDone(write_set->fd_array[i]))
+            {
+                write_set->fd_array[done_count] = write_set->fd_array[i];
+                done_count = done_count + 1;
+            }
+        }
+        write_set->fd_count = done_count;
+        ready_count = ready_count + done_count;
+    }
+
+    return ((int)ready_count);
+}
+
+int SimulatedTransport::getPendingBytes(SOCKET socket)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::OPEN)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+
+    // 아직 읽지 않은 수신 데이터만 셉니다. (읽기 제한과 무관하게 남은 전체 크기.)
+    return ((int)(target->inbound.size() - target->readOffset));
+}
+
+SOCKET SimulatedTransport::createDatagramSocket()
+{
+    return (this->allocateSocket(SimulatedTransport::SocketState::DATAGRAM));
+}
+
+int SimulatedTransport::receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr)
+{
+    this->_receiveCallCount = this->_receiveCallCount + 1;
+
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::DATAGRAM)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+    if (target->datagrams.empty())
+    {
+        return (this->fail(WSAEWOULDBLOCK));
+    }
+
+    PendingDatagram datagram = std::move(target->datagrams.front());
+    target->datagrams.pop_front();
+
+    if (from_addr != nullptr)
+    {
+        *from_addr = {};
+        from_addr->sin_family = AF_INET;
+        from_addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        from_addr->sin_port = htons(datagram.fromPort);
+    }
+
+    // 버퍼보다 큰 데이터그램은 WinSock처럼 앞부분만 채우고 WSAEMSGSIZE로 실패합니다.
+    std::size_t count = std::min<std::size_t>(datagram.payload.size(), (std::size_t)length);
+    std::memcpy(buffer, datagram.payload.data(), count);
+    this->_totalBytesReceived = this->_totalBytesReceived + count;
+    if (count < datagram.payload.size())
+    {
+        return (this->fail(WSAEMSGSIZE));
+    }
+    return ((int)count);
+}
+
+int SimulatedTransport::sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr)
+{
+    this->_sendCallCount = this->_sendCallCount + 1;
+
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state != SimulatedTransport::SocketState::DATAGRAM)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+
+    if (this->_captureOutput)
+    {
+        this->_capturedDatagrams[ntohs(to_addr.sin_port)].push_back(std::string(data, length));
+    }
+    target->bytesSent = target->bytesSent + length;
+    this->_totalBytesSent = this->_totalBytesSent + length;
+    this->_datagramSendCount = this->_datagramSendCount + 1;
+
+    return (length);
+}
+
+int SimulatedTransport::closeSocket(SOCKET socket)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr || target->state == SimulatedTransport::SocketState::CLOSED)
+    {
+        return (this->fail(WSAENOTSOCK));
+    }
+
+    target->state = SimulatedTransport::SocketState::CLOSED;
+    target->inbound.clear();
+    target->inbound.shrink_to_fit();
+    target->readOffset = 0;
+    target->datagrams.clear();
+    return (0);
+}
+
+int SimulatedTransport::getLastError() const
+{
+    return (this->_lastError);
+}
+
+NetworkTransport::Clock::time_point SimulatedTransport::now() const
+{
+    return (NetworkTransport::Clock::time_point(std::chrono::milliseconds(this->_nowMs)));
+}
+
+void SimulatedTransport::sleepMillis(int timeout_ms)
+{
+    this->advanceTo(this->_nowMs + timeout_ms);
+}
+
+SOCKET SimulatedTransport::scheduleConnect(long long at_ms, int to_port)
+{
+    SOCKET client_socket = this->allocateSocket(SimulatedTransport::SocketState::SCHEDULED);
+    this->findSocket(client_socket)->boundPort = to_port;
+
+    ScheduledEvent event = {};
+    event.atMs = at_ms;
+    event.type = SimulatedTransport::EventType::CONNECT;
+    event.socket = client_socket;
+    this->pushEvent(std::move(event));
+
+    return (client_socket);
+}
+
+void SimulatedTransport::scheduleData(SOCKET socket, long long at_ms, const std::string& bytes)
+{
+    ScheduledEvent event = {};
+    event.atMs = at_ms;
+    event.type = SimulatedTransport::EventType::DATA;
+    event.socket = socket;
+    event.payload = bytes;
+    this->pushEvent(std::move(event));
+}
+
+void SimulatedTransport::scheduleLines(SOCKET socket, long long start_ms, long long interval_ms, int count, const std::string& line)
+{
+    std::string framed_line = line + "\r\n";
+
+    for (int i = 0; i < count; ++i)
+    {
+        this->scheduleData(socket, start_ms + interval_ms * i, framed_line);
+    }
+}
+
+void SimulatedTransport::scheduleDisconnect(SOCKET socket, long long at_ms)
+{
+    ScheduledEvent event = {};
+    event.atMs = at_ms;
+    event.type = SimulatedTransport::EventType::DISCONNECT;
+    event.socket = socket;
+    this->pushEvent(std::move(event));
+}
+
+void SimulatedTransport::scheduleDatagram(long long at_ms, int to_port, unsigned short from_port, const std::string& payload)
+{
+    ScheduledEvent event = {};
+    event.atMs = at_ms;
+    event.type = SimulatedTransport::EventType::DATAGRAM_ARRIVAL;
+    event.socket = INVALID_SOCKET;
+    event.payload = payload;
+    event.toPort = to_port;
+    event.fromPort = from_port;
+    this->pushEvent(std::move(event));
+}
+
+void SimulatedTransport::scheduleCallback(long long at_ms, std::function<void()> callback)
+{
+    ScheduledEvent event = {};
+    event.atMs = at_ms;
+    event.type = SimulatedTransport::EventType::CALLBACK_CALL;
+    event.socket = INVALID_SOCKET;
+    event.callback = std::move(callback);
+    this->pushEvent(std::move(event));
+}
+
+void SimulatedTransport::setReadChunkLimit(int max_bytes)
+{
+    this->_readChunkLimit = max_bytes;
+}
+
+void SimulatedTransport::setWriteChunkLimit(int max_bytes)
+{
+    this->_writeChunkLimit = max_bytes;
+}
+
+void SimulatedTransport::setSendWindow(SOCKET socket, long long max_bytes)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target != nullptr)
+    {
+        target->sendWindow = (max_bytes < 0) ? -1 : max_bytes;
+    }
+}
+
+void SimulatedTransport::setPeerAddress(SOCKET socket, unsigned long ipv4_address)
+{
+    VirtualSocket* target = this->findSocket(socket);
+    if (target != nullptr)
+    {
+        target->peerAddress = ipv4_address;
+    }
+}
+
+void SimulatedTransport::setOutputCapture(bool enabled)
+{
+    this->_captureOutput = enabled;
+}
+
+void SimulatedTransport::advanceTime(long long duration_ms)
+{
+    this->advanceTo(this->_nowMs + duration_ms);
+}
+
+long long SimulatedTransport::getElapsedMs() const
+{
+    return (this->_nowMs);
+}
+
+bool SimulatedTransport::hasPendingEvents() const
+{
+    return (this->_events.empty() == false);
+}
+
+const std::string& SimulatedTransport::getCapturedOutput(SOCKET socket) const
+{
+    static const std::string empty_output;
+
+    const VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (empty_output);
+    }
+    return (target->captured);
+}
+
+const std::vector<std::string>& SimulatedTransport::getCapturedDatagrams(unsigned short to_port) const
+{
+    static const std::vector<std::string> empty_datagrams;
+
+    auto it = this->_capturedDatagrams.find(to_port);
+    if (it == this->_capturedDatagrams.end())
+    {
+        return (empty_datagrams);
+    }
+    return (it->second);
+}
+
+unsigned long long SimulatedTransport::getDatagramSendCount() const
+{
+    return (this->_datagramSendCount);
+}
+
+unsigned long long SimulatedTransport::getBytesSent(SOCKET socket) const
+{
+    const VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (0);
+    }
+    return (target->bytesSent);
+}
+
+unsigned long long SimulatedTransport::getTotalBytesSent() const
+{
+    return (this->_totalBytesSent);
+}
+
+unsigned long long SimulatedTransport::getTotalBytesReceived() const
+{
+    return (this->_totalBytesReceived);
+}
+
+unsigned long long SimulatedTransport::getSendCallCount() const
+{
+    return (this->_sendCallCount);
+}
+
+unsigned long long SimulatedTransport::getReceiveCallCount() const
+{
+    return (this->_receiveCallCount);
+}
+
+unsigned long long SimulatedTransport::getSelectCallCount() const
+{
+    return (this->_selectCallCount);
+}
+
+void SimulatedTransport::setConnectRefused(int port, bool refused)
+{
+    this->_refusedPorts.erase(std::remove(this->_refusedPorts.begin(), this->_refusedPorts.end(), port), this->_refusedPorts.end());
+    if (refused)
+    {
+        this->_refusedPorts.push_back(port);
+    }
+}
+
+void SimulatedTransport::setConnectStalled(int port, bool stalled)
+{
+    this->_stalledPorts.erase(std::remove(this->_stalledPorts.begin(), this->_stalledPorts.end(), port), this->_stalledPorts.end());
+    if (stalled)
+    {
+        this->_stalledPorts.push_back(port);
+    }
+}
+
+SOCKET SimulatedTransport::findConnectedSocket(int port) const
+{
+    auto it = this->_connectedSockets.find(port);
+    if (it == this->_connectedSockets.end())
+    {
+        return (INVALID_SOCKET);
+    }
+    return (it->second);
+}
+
+SOCKET SimulatedTransport::allocateSocket(SocketState state)
+{
+    VirtualSocket virtual_socket = {};
+    virtual_socket.state = state;
+    virtual_socket.sendWindow = -1;
+    virtual_socket.peerAddress = INADDR_LOOPBACK;
+    this->_sockets.push_back(std::move(virtual_socket));
+
+    return (SimulatedTransport::FIRST_SOCKET + (SOCKET)(this->_sockets.size() - 1));
+}
+
+SimulatedTransport::VirtualSocket* SimulatedTransport::findSocket(SOCKET socket)
+{
+    if (socket < SimulatedTransport::FIRST_SOCKET || socket - SimulatedTransport::FIRST_SOCKET >= this->_sockets.size())
+    {
+        return (nullptr);
+    }
+    return (&this->_sockets[socket - SimulatedTransport::FIRST_SOCKET]);
+}
+
+const SimulatedTransport::VirtualSocket* SimulatedTransport::findSocket(SOCKET socket) const
+{
+    if (socket < SimulatedTransport::FIRST_SOCKET || socket - SimulatedTransport::FIRST_SOCKET >= this->_sockets.size())
+    {
+        return (nullptr);
+    }
+    return (&this->_sockets[socket - SimulatedTransport::FIRST_SOCKET]);
+}
+
+void SimulatedTransport::pushEvent(ScheduledEvent event)
+{
+    event.sequence = this->_nextSequence;
+    this->_nextSequence = this->_nextSequence + 1;
+
+    this->_events.push_back(std::move(event));
+    std::push_heap(this->_events.begin(), this->_events.end(), SimulatedTransport::isLaterEvent);
+}
+
+void SimulatedTransport::deliverDueEvents()
+{
+    while (this->_events.empty() == false && this->_events.front().atMs <= this->_nowMs)
+    {
+        std::pop_heap(this->_events.begin(), this->_events.end(), SimulatedTransport::isLaterEvent);
+        ScheduledEvent event = std::move(this->_events.back());
+        this->_events.pop_back();
+
+        VirtualSocket* target = this->findSocket(event.socket);
+
+        switch (event.type)
+        {
+        case SimulatedTransport::EventType::CONNECT:
+            target->state = SimulatedTransport::SocketState::PENDING;
+            this->_pendingAccepts.push_back(event.socket);
+            break;
+
+        case SimulatedTransport::EventType::DATA:
+            // 서버가 이미 닫은 소켓에 도착한 데이터는 버립니다.
+            if (target != nullptr && target->state != SimulatedTransport::SocketState::CLOSED && target->peerClosed == false)
+            {
+                target->inbound.append(event.payload);
+            }
+            break;
+
+        case SimulatedTransport::EventType::DISCONNECT:
+            if (target != nullptr)
+            {
+                target->peerClosed = true;
+            }
+            break;
+
+        case SimulatedTransport::EventType::DATAGRAM_ARRIVAL:
+            // 해당 포트에 바인드된 UDP 소켓이 없으면 실제 네트워크처럼 조용히 버려집니다.
+            for (VirtualSocket& candidate : this->_sockets)
+            {
+                if (candidate.state == SimulatedTransport::SocketState::DATAGRAM && candidate.boundPort == event.toPort)
+                {
+                    candidate.datagrams.push_back(PendingDatagram{ event.fromPort, std::move(event.payload) });
+                    break;
+                }
+            }
+            break;
+
+        case SimulatedTransport::EventType::CALLBACK_CALL:
+            event.callback();
+            break;
+        }
+    }
+}
+
+void SimulatedTransport::advanceTo(long long target_ms)
+{
+    // 중간 이벤트를 시각 순서대로 전달하며 진행합니다.
+    while (this->_events.empty() == false && this->_events.front().atMs <= target_ms)
+    {
+        if (this->_events.front().atMs > this->_nowMs)
+        {
+            this->_nowMs = this->_events.front().atMs;
+        }
+        this->deliverDueEvents();
+    }
+
+    if (target_ms > this->_nowMs)
+    {
+        this->_nowMs = target_ms;
+    }
+}
+
+bool SimulatedTransport::isReadable(SOCKET socket) const
+{
+    const VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (false);
+    }
+
+    if (target->state == SimulatedTransport::SocketState::LISTENING)
+    {
+        return (this->findPendingAccept(target->boundPort) < this->_pendingAccepts.size());
+    }
+    if (target->state == SimulatedTransport::SocketState::OPEN)
+    {
+        return (target->readOffset < target->inbound.size() || target->peerClosed);
+    }
+    if (target->state == SimulatedTransport::SocketState::DATAGRAM)
+    {
+        return (target->datagrams.empty() == false);
+    }
+    return (false);
+}
+
+bool SimulatedTransport::isConnectDone(SOCKET socket) const
+{
+    const VirtualSocket* target = this->findSocket(socket);
+    if (target == nullptr)
+    {
+        return (false);
+    }
+
+    return (target->state == SimulatedTransport::SocketState::OPEN
+        || (target->state == SimulatedTransport::SocketState::CONNECTING && target->connectError != 0));
+}
+
+std::size_t SimulatedTransport::findPendingAccept(int listen_port) const
+{
+    for (std::size_t i = this->_pendingAcceptHead; i < this->_pendingAccepts.size(); ++i)
+    {
+        int to_port = this->findSocket(this->_pendingAccepts[i])->boundPort;
+        if (to_port == 0 || to_port == listen_port)
+        {
+            return (i);
+        }
+    }
+    return (this->_pendingAccepts.size());
+}
+
+int SimulatedTransport::countReady(const fd_set* read_set, const fd_set* write_set) const
+{
+    int ready_count = 0;
+
+    for (unsigned int i = 0; i < read_set->fd_count; ++i)
+    {
+        if (this->isReadable(read_set->fd_array[i]))
+        {
+            ready_count = ready_count + 1;
+        }
+    }
+    for (unsigned int i = 0; write_set != nullptr && i < write_set->fd_count; ++i)
+    {
+        if (this->isConnectDone(write_set->fd_array[i]))
+        {
+            ready_count = ready_count + 1;
+        }
+    }
+    return (ready_count);
+}
+
+bool SimulatedTransport::isLaterEvent(const ScheduledEvent& a, const ScheduledEvent& b)
+{
+    // 이른 시각, 같은 시각이면 먼저 예약된 이벤트가 힙의 front에 오도록 합니다.
+    if (a.atMs != b.atMs)
+    {
+        return (a.atMs > b.atMs);
+    }
+    return (a.sequence > b.sequence);
+}
+
+int SimulatedTransport::fail(int error_code)
+{
+    this->_lastError = error_code;
+    return (SOCKET_ERROR);
+}
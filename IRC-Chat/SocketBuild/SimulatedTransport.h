@@ -0,0 +1,538 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SimulatedTransport.h
+ * @brief 메모리 안에서 소켓과 시간을 흉내 내는 SimulatedTransport 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 가상 소켓, 예약된 도착 이벤트(연결, 데이터, 종료), 부분 읽기/쓰기, 가상 시계를 제공합니다.
+ * <br>커널과 실제 네트워크 없이 서버 루프, 줄 단위 분리, 팬아웃 로직을 결정적으로 실행하고 측정할 수 있습니다.
+ */
+
+#include "NetworkTransport.h"
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SimulatedTransport
+ * @brief 가상 소켓과 가상 시계를 사용하는 NetworkTransport 구현입니다.
+ *
+ * @details
+ * 시나리오는 서버를 실행하기 전에 schedule* 함수들로 구성합니다.
+ * - scheduleConnect() : 지정 시각에 새 연결이 수락 대기열에 들어옵니다. (포트를 지정하면 그 포트의 리스닝 소켓만 수락합니다.)
+ * - scheduleData(), scheduleLines() : 지정 시각(또는 주기)에 데이터가 수신 버퍼에 도착합니다.
+ * - scheduleDisconnect() : 지정 시각에 상대편이 연결을 닫습니다.
+ * - scheduleDatagram() : 지정 시각에 해당 포트로 바인드된 UDP 소켓에 데이터그램이 도착합니다.
+ * - scheduleCallback() : 지정 시각에 임의의 함수를 호출합니다 (예: MultiServer::stop()).
+ *
+ * connectSocket()은 상대 없이 바로 성공하며(setConnectRefused()로 거절 가능), findConnectedSocket()으로 찾은 소켓에
+ * <br>scheduleData()로 상대가 보낸 데이터를 넣고 getCapturedOutput()으로 보낸 데이터를 확인합니다.
+ *
+ * startConnect()는 항상 WSAEWOULDBLOCK으로 돌아오고, 다음 selectSockets()에서 연결이 끝난 것으로 보고합니다.
+ * <br>거절된 포트는 getConnectResult()가 WSAECONNREFUSED를 돌려주고, setConnectStalled()로 지정한 포트는 연결이 끝나지 않습니다.
+ *
+ * selectReadable(), selectSockets()와 sleepMillis()는 실제로 기다리지 않고 다음 이벤트 시각으로 가상 시계를 건너뜁니다.
+ * <br>같은 시나리오는 항상 같은 순서로 실행되므로 결과가 결정적입니다.
+ *
+ * @note 시간 단위는 모두 가상 시계의 밀리초입니다.
+ */
+class SimulatedTransport final : public NetworkTransport
+{
+public:
+    /// 첫 가상 소켓 핸들 값. 이후 소켓은 1씩 증가합니다.
+    static const SOCKET FIRST_SOCKET = 1000;
+
+public:
+    /**
+     * @fn SimulatedTransport::SimulatedTransport()
+     * @brief 가상 시각 0에서 시작하는 빈 시뮬레이션을 생성합니다.
+     * @return 없음.
+     */
+    SimulatedTransport();
+
+    /**
+     * @fn SimulatedTransport::~SimulatedTransport()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~SimulatedTransport() override;
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SimulatedTransport(const SimulatedTransport& obj) = delete;
+    SimulatedTransport& operator=(const SimulatedTransport& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SimulatedTransport(SimulatedTransport&& obj) = delete;
+    SimulatedTransport& operator=(SimulatedTransport&& obj) = delete;
+
+public:
+    SOCKET createSocket() override;
+    int bindSocket(SOCKET socket, int port) override;
+    int listenSocket(SOCKET socket) override;
+    SOCKET acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr) override;
+    int connectSocket(SOCKET socket, const char* host, int port) override;
+    int startConnect(SOCKET socket, const char* host, int port) override;
+    int getConnectResult(SOCKET socket) override;
+    int sendBytes(SOCKET socket, const char* data, int length) override;
+    int receiveBytes(SOCKET socket, char* buffer, int length) override;
+    int selectReadable(fd_set* read_set, int timeout_ms) override;
+    int selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms) override;
+    int getPendingBytes(SOCKET socket) override;
+    SOCKET createDatagramSocket() override;
+    int receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr) override;
+    int sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr) override;
+    int closeSocket(SOCKET socket) override;
+    int getLastError() const override;
+    NetworkTransport::Clock::time_point now() const override;
+    void sleepMillis(int timeout_ms) override;
+
+public:
+    /**
+     * @fn SOCKET SimulatedTransport::scheduleConnect(long long at_ms, int to_port)
+     * @brief 지정 시각에 새 클라이언트 연결이 도착하도록 예약합니다.
+     * @param[IN] long long at_ms : 연결이 도착할 가상 시각.
+     * @param[IN] int to_port : 연결할 리스닝 포트 (기본값 0 : 아무 리스닝 소켓).
+     * @return SOCKET : 수락 후 서버가 받게 될 가상 소켓 핸들 (데이터 예약에 사용).
+     */
+    SOCKET scheduleConnect(long long at_ms, int to_port = 0);
+
+    /**
+     * @fn void SimulatedTransport::scheduleData(SOCKET socket, long long at_ms, const std::string& bytes)
+     * @brief 지정 시각에 클라이언트가 보낸 데이터가 도착하도록 예약합니다.
+     * @param[IN] SOCKET socket : scheduleConnect()가 반환한 소켓.
+     * @param[IN] long long at_ms : 데이터가 도착할 가상 시각.
+     * @param[IN] const std::string& bytes : 도착할 바이트열.
+     * @return 없음.
+     */
+    void scheduleData(SOCKET socket, long long at_ms, const std::string& bytes);
+
+    /**
+     * @fn void SimulatedTransport::scheduleLines(SOCKET socket, long long start_ms, long long interval_ms, int count, const std::string& line)
+     * @brief 일정한 간격으로 같은 줄이 반복 도착하도록 예약합니다.
+     * @param[IN] SOCKET socket : scheduleConnect()가 반환한 소켓.
+     * @param[IN] long long start_ms : 첫 줄이 도착할 가상 시각.
+     * @param[IN] long long interval_ms : 줄 사이 간격 (0이면 모두 같은 시각에 몰아서 도착).
+     * @param[IN] int count : 도착할 줄 수.
+     * @param[IN] const std::string& line : 개행 문자를 제외한 줄 내용 ("\r\n"이 붙어 도착).
+     * @return 없음.
+     */
+    void scheduleLines(SOCKET socket, long long start_ms, long long interval_ms, int count, const std::string& line);
+
+    /**
+     * @fn void SimulatedTransport::scheduleDisconnect(SOCKET socket, long long at_ms)
+     * @brief 지정 시각에 클라이언트가 연결을 닫도록 예약합니다.
+     * @param[IN] SOCKET socket : scheduleConnect()가 반환한 소켓.
+     * @param[IN] long long at_ms : 연결이 닫힐 가상 시각.
+     * @return 없음.
+     */
+    void scheduleDisconnect(SOCKET socket, long long at_ms);
+
+    /**
+     * @fn void SimulatedTransport::scheduleDatagram(long long at_ms, int to_port, unsigned short from_port, const std::string& payload)
+     * @brief 지정 시각에 UDP 데이터그램이 도착하도록 예약합니다.
+     * @param[IN] long long at_ms : 도착 시각.
+     * @param[IN] int to_port : 받을 UDP 소켓이 바인드된 포트. (해당 소켓이 없으면 버려집니다.)
+     * @param[IN] unsigned short from_port : 보낸 쪽 포트 (주소는 127.0.0.1).
+     * @param[IN] const std::string& payload : 데이터그램 내용.
+     * @return 없음.
+     */
+    void scheduleDatagram(long long at_ms, int to_port, unsigned short from_port, const std::string& payload);
+
+    /**
+     * @fn void SimulatedTransport::scheduleCallback(long long at_ms, std::function<void()> callback)
+     * @brief 지정 시각에 함수를 호출하도록 예약합니다.
+     * @param[IN] long long at_ms : 호출할 가상 시각.
+     * @param[IN] std::function<void()> callback : 호출할 함수 (예: 서버 중지).
+     * @return 없음.
+     */
+    void scheduleCallback(long long at_ms, std::function<void()> callback);
+
+    /**
+     * @fn void SimulatedTransport::setReadChunkLimit(int max_bytes)
+     * @brief receiveBytes() 한 번이 돌려줄 최대 바이트 수를 설정합니다 (부분 읽기 재현).
+     * @param[IN] int max_bytes : 최대 바이트 수, 0이면 제한 없음.
+     * @return 없음.
+     */
+    void setReadChunkLimit(int max_bytes);
+
+    /**
+     * @fn void SimulatedTransport::setWriteChunkLimit(int max_bytes)
+     * @brief sendBytes() 한 번이 받아들일 최대 바이트 수를 설정합니다 (부분 쓰기 재현).
+     * @param[IN] int max_bytes : 최대 바이트 수, 0이면 제한 없음.
+     * @return 없음.
+     */
+    void setWriteChunkLimit(int max_bytes);
+
+    /**
+     * @fn void SimulatedTransport::setSendWindow(SOCKET socket, long long max_bytes)
+     * @brief 소켓 하나가 앞으로 더 받아들일 송신 바이트 수를 설정합니다 (느린 수신자 재현).
+     * @param[IN] SOCKET socket : 대상 소켓.
+     * @param[IN] long long max_bytes : 받아들일 바이트 수. 다 차면 sendBytes()가 WSAEWOULDBLOCK으로 실패합니다. 음수이면 제한 없음.
+     * @return 없음.
+     * @note 상대가 읽어 버퍼가 비는 것은 scheduleCallback()에서 다시 호출해 재현합니다.
+     */
+    void setSendWindow(SOCKET socket, long long max_bytes);
+
+    /**
+     * @fn void SimulatedTransport::setPeerAddress(SOCKET socket, unsigned long ipv4_address)
+     * @brief acceptSocket()이 해당 연결의 상대 주소로 돌려줄 IPv4 주소를 설정합니다 (기본값 127.0.0.1).
+     * @param[IN] SOCKET socket : scheduleConnect()가 반환한 소켓.
+     * @param[IN] unsigned long ipv4_address : 호스트 바이트 순서의 IPv4 주소 (예: 0x0A000001 = 10.0.0.1).
+     * @return 없음.
+     * @note 수락 전에 설정해야 합니다. 포트는 여전히 소켓 번호입니다.
+     */
+    void setPeerAddress(SOCKET socket, unsigned long ipv4_address);
+
+    /**
+     * @fn void SimulatedTransport::setOutputCapture(bool enabled)
+     * @brief 서버가 보낸 데이터를 소켓별로 보관할지 설정합니다.
+     * @param[IN] bool enabled : true이면 getCapturedOutput()으로 확인할 수 있도록 보관합니다.
+     * @return 없음.
+     * @note 대규모 시뮬레이션에서는 메모리를 아끼기 위해 끄고 바이트 수만 집계합니다.
+     */
+    void setOutputCapture(bool enabled);
+
+    /**
+     * @fn void SimulatedTransport::advanceTime(long long duration_ms)
+     * @brief 가상 시계를 진행시키고 그 사이 예약된 이벤트를 전달합니다.
+     * @param[IN] long long duration_ms : 진행할 시간.
+     * @return 없음.
+     */
+    void advanceTime(long long duration_ms);
+
+    /**
+     * @fn long long SimulatedTransport::getElapsedMs() const
+     * @brief 시뮬레이션 시작 이후 흐른 가상 시간을 반환합니다.
+     * @return long long : 가상 시각(밀리초).
+     */
+    long long getElapsedMs() const;
+
+    /**
+     * @fn bool SimulatedTransport::hasPendingEvents() const
+     * @brief 아직 전달되지 않은 예약 이벤트가 있는지 확인합니다.
+     * @return bool : 남은 이벤트가 있으면 true.
+     */
+    bool hasPendingEvents() const;
+
+    /**
+     * @fn const std::string& SimulatedTransport::getCapturedOutput(SOCKET socket) const
+     * @brief 서버가 해당 소켓으로 보낸 데이터를 반환합니다.
+     * @param[IN] SOCKET socket : 조회할 가상 소켓.
+     * @return const std::string& : 보관된 송신 데이터 (보관하지 않았으면 빈 문자열).
+     */
+    const std::string& getCapturedOutput(SOCKET socket) const;
+
+    /**
+     * @fn const std::vector<std::string>& SimulatedTransport::getCapturedDatagrams(unsigned short to_port) const
+     * @brief 서버가 해당 포트로 보낸 데이터그램을 보낸 순서대로 반환합니다.
+     * @param[IN] unsigned short to_port : 받는 쪽 포트.
+     * @return const std::vector<std::string>& : 보관된 데이터그램 (보관하지 않았으면 빈 목록).
+     */
+    const std::vector<std::string>& getCapturedDatagrams(unsigned short to_port) const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getDatagramSendCount() const
+     * @brief sendDatagram() 성공 횟수를 반환합니다.
+     * @return unsigned long long : 보낸 데이터그램 수.
+     */
+    unsigned long long getDatagramSendCount() const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getBytesSent(SOCKET socket) const
+     * @brief 서버가 해당 소켓으로 보낸 총 바이트 수를 반환합니다.
+     * @param[IN] SOCKET socket : 조회할 가상 소켓.
+     * @return unsigned long long : 송신 바이트 수.
+     */
+    unsigned long long getBytesSent(SOCKET socket) const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getTotalBytesSent() const
+     * @brief 모든 소켓의 송신 바이트 합계를 반환합니다.
+     * @return unsigned long long : 송신 바이트 합계.
+     */
+    unsigned long long getTotalBytesSent() const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getTotalBytesReceived() const
+     * @brief 서버가 읽어 간 수신 바이트 합계를 반환합니다.
+     * @return unsigned long long : 수신 바이트 합계.
+     */
+    unsigned long long getTotalBytesReceived() const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getSendCallCount() const
+     * @brief sendBytes() 호출 횟수를 반환합니다.
+     * @return unsigned long long : 호출 횟수.
+     */
+    unsigned long long getSendCallCount() const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getReceiveCallCount() const
+     * @brief receiveBytes() 호출 횟수를 반환합니다.
+     * @return unsigned long long : 호출 횟수.
+     */
+    unsigned long long getReceiveCallCount() const;
+
+    /**
+     * @fn unsigned long long SimulatedTransport::getSelectCallCount() const
+     * @brief selectReadable()과 selectSockets() 호출 횟수(루프 반복 횟수)를 반환합니다.
+     * @return unsigned long long : 호출 횟수.
+     */
+    unsigned long long getSelectCallCount() const;
+
+    /**
+     * @fn void SimulatedTransport::setConnectRefused(int port, bool refused)
+     * @brief 지정 포트로의 connectSocket()과 startConnect()가 거절(WSAECONNREFUSED)되도록 하거나 다시 허용합니다.
+     * @param[IN] int port : 포트 번호.
+     * @param[IN] bool refused : true이면 거절.
+     * @return 없음.
+     */
+    void setConnectRefused(int port, bool refused);
+
+    /**
+     * @fn void SimulatedTransport::setConnectStalled(int port, bool stalled)
+     * @brief 지정 포트로 startConnect()한 연결이 응답 없는 상대처럼 끝나지 않도록 하거나 다시 허용합니다.
+     * @param[IN] int port : 포트 번호.
+     * @param[IN] bool stalled : true이면 연결이 끝나지 않음. (이미 시작한 연결에는 영향이 없습니다.)
+     * @return 없음.
+     */
+    void setConnectStalled(int port, bool stalled);
+
+    /**
+     * @fn SOCKET SimulatedTransport::findConnectedSocket(int port) const
+     * @brief 지정 포트로 마지막에 connectSocket() 또는 startConnect()로 연결된 소켓을 찾습니다.
+     * @param[IN] int port : 포트 번호.
+     * @return SOCKET : 소켓, 없으면 INVALID_SOCKET.
+     */
+    SOCKET findConnectedSocket(int port) const;
+
+private:
+    /**
+     * @enum SimulatedTransport::SocketState
+     * @brief 가상 소켓의 상태.
+     */
+    enum class SocketState
+    {
+        CREATED,    ///< createSocket()으로 생성됨.
+        LISTENING,  ///< listenSocket()으로 연결 대기 중.
+        SCHEDULED,  ///< scheduleConnect()로 예약되었으나 아직 도착하지 않음.
+        PENDING,    ///< 도착하여 accept 대기 중.
+        OPEN,       ///< 서버가 수락하여 송수신 가능.
+        CONNECTING, ///< startConnect()로 시작한 연결이 끝나지 않았거나 거절됨.
+        DATAGRAM,   ///< createDatagramSocket()으로 생성된 UDP 소켓.
+        CLOSED      ///< 서버가 닫음.
+    };
+
+    /**
+     * @enum SimulatedTransport::EventType
+     * @brief 예약 이벤트의 종류.
+     */
+    enum class EventType
+    {
+        CONNECT,
+        DATA,
+        DISCONNECT,
+        DATAGRAM_ARRIVAL,
+        CALLBACK_CALL
+    };
+
+    /// 도착하여 읽기를 기다리는 데이터그램.
+    struct PendingDatagram
+    {
+        unsigned short fromPort;
+        std::string payload;
+    };
+
+    /// 가상 소켓 하나의 상태와 버퍼.
+    struct VirtualSocket
+    {
+        SocketState state;
+        std::string inbound;
+        std::size_t readOffset;
+        std::string captured;
+        unsigned long long bytesSent;
+        long long sendWindow;
+        bool peerClosed;
+        int boundPort;
+        unsigned long peerAddress;
+        int connectError;
+        std::deque<PendingDatagram> datagrams;
+    };
+
+    /// 예약 이벤트. 같은 시각이면 예약 순서(sequence)대로 전달됩니다.
+    struct ScheduledEvent
+    {
+        long long atMs;
+        unsigned long long sequence;
+        EventType type;
+        SOCKET socket;
+        std::string payload;
+        int toPort;
+        unsigned short fromPort;
+        std::function<void()> callback;
+    };
+
+    /// 가상 소켓 목록 (인덱스 = 핸들 - FIRST_SOCKET).
+    std::vector<VirtualSocket> _sockets;
+
+    /// 예약 이벤트 최소 힙 (가장 이른 이벤트가 front).
+    std::vector<ScheduledEvent> _events;
+
+    /// 도착하여 accept를 기다리는 연결.
+    std::vector<SOCKET> _pendingAccepts;
+
+    /// _pendingAccepts에서 다음에 꺼낼 위치.
+    std::size_t _pendingAcceptHead;
+
+    /// 현재 가상 시각(밀리초).
+    long long _nowMs;
+
+    /// 다음 예약 이벤트에 부여할 순번.
+    unsigned long long _nextSequence;
+
+    /// 마지막 실패의 오류 코드.
+    int _lastError;
+
+    /// 부분 읽기 크기 제한 (0이면 제한 없음).
+    int _readChunkLimit;
+
+    /// 부분 쓰기 크기 제한 (0이면 제한 없음).
+    int _writeChunkLimit;
+
+    /// 송신 데이터 보관 여부.
+    bool _captureOutput;
+
+    /// 송신 바이트 합계.
+    unsigned long long _totalBytesSent;
+
+    /// 수신 바이트 합계.
+    unsigned long long _totalBytesReceived;
+
+    /// sendBytes() 호출 횟수.
+    unsigned long long _sendCallCount;
+
+    /// receiveBytes() 호출 횟수.
+    unsigned long long _receiveCallCount;
+
+    /// selectReadable() 호출 횟수.
+    unsigned long long _selectCallCount;
+
+    /// 받는 쪽 포트별로 보관한 송신 데이터그램.
+    std::unordered_map<unsigned short, std::vector<std::string>> _capturedDatagrams;
+
+    /// sendDatagram() 성공 횟수.
+    unsigned long long _datagramSendCount;
+
+    /// connectSocket()을 거절할 포트.
+    std::vector<int> _refusedPorts;
+
+    /// startConnect()가 끝나지 않을 포트.
+    std::vector<int> _stalledPorts;
+
+    /// 포트별로 마지막에 connectSocket()한 소켓.
+    std::unordered_map<int, SOCKET> _connectedSockets;
+
+private:
+    /**
+     * @fn SOCKET SimulatedTransport::allocateSocket(SocketState state)
+     * @brief 새 가상 소켓을 만들고 핸들을 반환합니다.
+     * @param[IN] SocketState state : 초기 상태.
+     * @return SOCKET : 가상 소켓 핸들.
+     */
+    SOCKET allocateSocket(SocketState state);
+
+    /**
+     * @fn VirtualSocket* SimulatedTransport::findSocket(SOCKET socket)
+     * @brief 핸들에 해당하는 가상 소켓을 찾습니다.
+     * @param[IN] SOCKET socket : 가상 소켓 핸들.
+     * @return VirtualSocket* : 가상 소켓, 없으면 nullptr.
+     */
+    VirtualSocket* findSocket(SOCKET socket);
+
+    /**
+     * @fn const VirtualSocket* SimulatedTransport::findSocket(SOCKET socket) const
+     * @brief findSocket()의 const 버전입니다.
+     * @param[IN] SOCKET socket : 가상 소켓 핸들.
+     * @return const VirtualSocket* : 가상 소켓, 없으면 nullptr.
+     */
+    const VirtualSocket* findSocket(SOCKET socket) const;
+
+    /**
+     * @fn void SimulatedTransport::pushEvent(ScheduledEvent event)
+     * @brief 이벤트에 순번을 부여하고 힙에 넣습니다.
+     * @param[IN] ScheduledEvent event : 예약할 이벤트.
+     * @return 없음.
+     */
+    void pushEvent(ScheduledEvent event);
+
+    /**
+     * @fn void SimulatedTransport::deliverDueEvents()
+     * @brief 현재 가상 시각까지 도래한 이벤트를 모두 전달합니다.
+     * @return 없음.
+     */
+    void deliverDueEvents();
+
+    /**
+     * @fn void SimulatedTransport::advanceTo(long long target_ms)
+     * @brief 중간 이벤트를 순서대로 전달하며 가상 시계를 target_ms까지 진행합니다.
+     * @param[IN] long long target_ms : 목표 가상 시각.
+     * @return 없음.
+     */
+    void advanceTo(long long target_ms);
+
+    /**
+     * @fn bool SimulatedTransport::isReadable(SOCKET socket) const
+     * @brief 가상 소켓이 읽기 준비 상태인지 확인합니다.
+     * @param[IN] SOCKET socket : 가상 소켓 핸들.
+     * @return bool : 수락할 연결이나 읽을 데이터가 있거나 상대가 닫았으면 true.
+     */
+    bool isReadable(SOCKET socket) const;
+
+    /**
+     * @fn bool SimulatedTransport::isConnectDone(SOCKET socket) const
+     * @brief startConnect()로 시작한 연결이 성공했거나 실패해 끝났는지 확인합니다.
+     * @param[IN] SOCKET socket : 가상 소켓 핸들.
+     * @return bool : 연결되었거나 거절되었으면 true.
+     */
+    bool isConnectDone(SOCKET socket) const;
+
+    /**
+     * @fn std::size_t SimulatedTransport::findPendingAccept(int listen_port) const
+     * @brief 지정 포트의 리스닝 소켓이 수락할 수 있는 가장 먼저 도착한 연결을 찾습니다.
+     * @param[IN] int listen_port : 리스닝 소켓이 바인드된 포트.
+     * @return std::size_t : _pendingAccepts에서의 위치, 없으면 _pendingAccepts.size().
+     */
+    std::size_t findPendingAccept(int listen_port) const;
+
+    /**
+     * @fn int SimulatedTransport::countReady(const fd_set* read_set, const fd_set* write_set) const
+     * @brief 읽기 집합에서 읽기 준비된 소켓과 쓰기 집합에서 연결이 끝난 소켓의 수를 셉니다.
+     * @param[IN] const fd_set* read_set : 읽기를 감시 중인 소켓 집합.
+     * @param[IN] const fd_set* write_set : 연결을 감시 중인 소켓 집합, 없으면 nullptr.
+     * @return int : 준비된 소켓 수.
+     */
+    int countReady(const fd_set* read_set, const fd_set* write_set) const;
+
+    /**
+     * @fn bool SimulatedTransport::isLaterEvent(const ScheduledEvent& a, const ScheduledEvent& b)
+     * @brief 이벤트 힙의 정렬 기준입니다.
+     * @param[IN] const ScheduledEvent& a : 비교할 이벤트.
+     * @param[IN] const ScheduledEvent& b : 비교할 이벤트.
+     * @return bool : a가 b보다 나중에 전달되어야 하면 true.
+     */
+    static bool isLaterEvent(const ScheduledEvent& a, const ScheduledEvent& b);
+
+    /**
+     * @fn int SimulatedTransport::fail(int error_code)
+     * @brief 오류 코드를 기록하고 SOCKET_ERROR를 반환합니다.
+     * @param[IN] int error_code : WinSock 오류 코드.
+     * @return int : 항상 SOCKET_ERROR.
+     */
+    int fail(int error_code);
+};
@@ -0,0 +1,196 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SlotMask.h
+ * @brief 세션 슬롯 번호를 비트 하나로 나타내는 고정 크기 비트 집합 SlotMask 템플릿을 정의합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 슬롯 집합끼리의 교집합과 차집합은 64비트 단어 단위로 계산하므로, 접속자 수가 늘어도 단어 수만큼의 연산으로 끝납니다.
+ * <br>켜진 비트를 순회할 때는 countr_zero로 다음 비트로 바로 건너뛰므로 비어 있는 슬롯을 하나씩 확인하지 않습니다.
+ */
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class SlotMask
+ * @brief 슬롯 [0, SlotCount)의 부분 집합을 비트로 저장합니다.
+ * @tparam SlotCount 슬롯 수.
+ */
+template <int SlotCount>
+class SlotMask
+{
+public:
+    /// @brief 비트를 담는 64비트 단어 수.
+    static constexpr std::size_t WORD_COUNT = (SlotCount + 63) / 64;
+
+public:
+    /**
+     * @fn SlotMask<SlotCount>::SlotMask()
+     * @brief 빈 집합을 생성합니다.
+     * @return 없음.
+     */
+    SlotMask()
+        : _words()
+    {
+    }
+
+public:
+    /**
+     * @fn void SlotMask<SlotCount>::set(int slot)
+     * @brief 슬롯을 집합에 넣습니다. 범위 밖이면 무시합니다.
+     * @param[IN] int slot : 슬롯 번호.
+     * @return 없음.
+     */
+    void set(int slot)
+    {
+        if (slot >= 0 && slot < SlotCount)
+        {
+            this->_words[slot / 64] = this->_words[slot / 64] | ((std::uint64_t)1 << (slot % 64));
+        }
+    }
+
+    /**
+     * @fn void SlotMask<SlotCount>::reset(int slot)
+     * @brief 슬롯을 집합에서 뺍니다. 범위 밖이면 무시합니다.
+     * @param[IN] int slot : 슬롯 번호.
+     * @return 없음.
+     */
+    void reset(int slot)
+    {
+        if (slot >= 0 && slot < SlotCount)
+        {
+            this->_words[slot / 64] = this->_words[slot / 64] & ~((std::uint64_t)1 << (slot % 64));
+        }
+    }
+
+    /**
+     * @fn bool SlotMask<SlotCount>::test(int slot) const
+     * @brief 슬롯이 집합에 있는지 확인합니다.
+     * @param[IN] int slot : 슬롯 번호.
+     * @return bool : 있으면 true, 없거나 범위 밖이면 false.
+     */
+    bool test(int slot) const
+    {
+        if (slot < 0 || slot >= SlotCount)
+        {
+            return (false);
+        }
+        return (((this->_words[slot / 64] >> (slot % 64)) & 1) != 0);
+    }
+
+    /**
+     * @fn void SlotMask<SlotCount>::clear()
+     * @brief 집합을 비웁니다.
+     * @return 없음.
+     */
+    void clear()
+    {
+        this->_words.fill(0);
+    }
+
+    /**
+     * @fn bool SlotMask<SlotCount>::any() const
+     * @brief 집합에 슬롯이 하나라도 있는지 확인합니다.
+     * @return bool : 비어 있지 않으면 true.
+     */
+    bool any() const
+    {
+        for (std::uint64_t word : this->_words)
+        {
+            if (word != 0)
+            {
+                return (true);
+            }
+        }
+        return (false);
+    }
+
+    /**
+     * @fn int SlotMask<SlotCount>::count() const
+     * @brief 집합에 든 슬롯 수를 반환합니다.
+     * @return int : 슬롯 수.
+     */
+    int count() const
+    {
+        int total = 0;
+        for (std::uint64_t word : this->_words)
+        {
+            total = total + std::popcount(word);
+        }
+        return (total);
+    }
+
+    /**
+     * @fn void SlotMask<SlotCount>::intersect(const SlotMask& other)
+     * @brief 다른 집합에도 있는 슬롯만 남깁니다.
+     * @param[IN] const SlotMask& other : 교집합을 구할 집합.
+     * @return 없음.
+     */
+    void intersect(const SlotMask& other)
+    {
+        for (std::size_t i = 0; i < SlotMask::WORD_COUNT; ++i)
+        {
+            this->_words[i] = this->_words[i] & other._words[i];
+        }
+    }
+
+    /**
+     * @fn void SlotMask<SlotCount>::subtract(const SlotMask& other)
+     * @brief 다른 집합에 있는 슬롯을 뺍니다.
+     * @param[IN] const SlotMask& other : 뺄 집합.
+     * @return 없음.
+     */
+    void subtract(const SlotMask& other)
+    {
+        for (std::size_t i = 0; i < SlotMask::WORD_COUNT; ++i)
+        {
+            this->_words[i] = this->_words[i] & ~other._words[i];
+        }
+    }
+
+    /**
+     * @fn int SlotMask<SlotCount>::countCommon(const SlotMask& other) const
+     * @brief 두 집합에 모두 있는 슬롯 수를 반환합니다.
+     * @param[IN] const SlotMask& other : 비교할 집합.
+     * @return int : 교집합의 슬롯 수.
+     */
+    int countCommon(const SlotMask& other) const
+    {
+        int total = 0;
+        for (std::size_t i = 0; i < SlotMask::WORD_COUNT; ++i)
+        {
+            total = total + std::popcount(this->_words[i] & other._words[i]);
+        }
+        return (total);
+    }
+
+    /**
+     * @fn void SlotMask<SlotCount>::forEach(Function&& function) const
+     * @brief 켜진 슬롯마다 작은 번호부터 함수를 호출합니다.
+     * @param[IN] Function&& function : void(int slot) 형태의 함수.
+     * @return 없음.
+     */
+    template <typename Function>
+    void forEach(Function&& function) const
+    {
+        for (std::size_t i = 0; i < SlotMask::WORD_COUNT; ++i)
+        {
+            std::uint64_t word = this->_words[i];
+            while (word != 0)
+            {
+                function((int)(i * 64) + std::countr_zero(word));
+                word = word & (word - 1);
+            }
+        }
+    }
+
+private:
+    /// 슬롯 비트 (슬롯 n은 n / 64번 단어의 n % 64번 비트).
+    std::array<std::uint64_t, WORD_COUNT> _words;
+};
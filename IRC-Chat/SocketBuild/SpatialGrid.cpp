@@ -0,0 +1,179 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SpatialGrid.cpp
+ * @brief SpatialGrid.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "SpatialGrid.h"
+#include "DebugHelper.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid(int capacity, float cell_size)
+    : _cellSize(cell_size), _entries(capacity), _cells()
+{
+    for (SpatialGrid::Entry& entry : this->_entries)
+    {
+        entry.tracked = false;
+        entry.x = 0.0f;
+        entry.y = 0.0f;
+        entry.z = 0.0f;
+        entry.cellKey = 0;
+        entry.slot = -1;
+    }
+    LOG_DEBUG("SpatialGrid 객체를 생성합니다.");
+}
+
+SpatialGrid::~SpatialGrid()
+{
+    LOG_DEBUG("SpatialGrid 객체를 삭제합니다.");
+}
+
+SpatialGrid::Result SpatialGrid::update(int index, float x, float y, float z)
+{
+    if (index < 0 || index >= (int)this->_entries.size())
+    {
+        return (SpatialGrid::Result::INVALID_INDEX);
+    }
+
+    SpatialGrid::Entry& entry = this->_entries[index];
+    std::int64_t cell_key = SpatialGrid::makeCellKey(this->toCell(x), this->toCell(y));
+
+    // 칸이 바뀐 경우에만 칸 목록을 옮깁니다.
+    if (entry.tracked == false)
+    {
+        this->insertIntoCell(index, cell_key);
+    }
+    else if (entry.cellKey != cell_key)
+    {
+        this->eraseFromCell(index);
+        this->insertIntoCell(index, cell_key);
+    }
+
+    entry.tracked = true;
+    entry.x = x;
+    entry.y = y;
+    entry.z = z;
+    return (SpatialGrid::Result::SUCCESS);
+}
+
+SpatialGrid::Result SpatialGrid::remove(int index)
+{
+    if (index < 0 || index >= (int)this->_entries.size())
+    {
+        return (SpatialGrid::Result::INVALID_INDEX);
+    }
+    if (this->_entries[index].tracked == false)
+    {
+        return (SpatialGrid::Result::NOT_TRACKED);
+    }
+
+    this->eraseFromCell(index);
+    this->_entries[index].tracked = false;
+    return (SpatialGrid::Result::SUCCESS);
+}
+
+bool SpatialGrid::getPosition(int index, float& x, float& y, float& z) const
+{
+    if (index < 0 || index >= (int)this->_entries.size() || this->_entries[index].tracked == false)
+    {
+        return (false);
+    }
+
+    x = this->_entries[index].x;
+    y = this->_entries[index].y;
+    z = this->_entries[index].z;
+    return (true);
+}
+
+int SpatialGrid::queryRadius(float x, float y, float z, float radius, int* indices, int max_count) const
+{
+    int count = 0;
+    float radius_squared = radius * radius;
+
+    // 반경이 걸치는 칸들만 검사합니다.
+    int min_cell_x = this->toCell(x - radius);
+    int max_cell_x = this->toCell(x + radius);
+    int min_cell_y = this->toCell(y - radius);
+    int max_cell_y = this->toCell(y + radius);
+
+    for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x)
+    {
+        for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y)
+        {
+            auto it = this->_cells.find(SpatialGrid::makeCellKey(cell_x, cell_y));
+            if (it == this->_cells.end())
+            {
+                continue;
+            }
+
+            for (int index : it->second)
+            {
+                const SpatialGrid::Entry& entry = this->_entries[index];
+                float dx = entry.x - x;
+                float dy = entry.y - y;
+                float dz = entry.z - z;
+                if (dx * dx + dy * dy + dz * dz > radius_squared)
+                {
+                    continue;
+                }
+                if (count >= max_count)
+                {
+                    return (count);
+                }
+                indices[count] = index;
+                count = count + 1;
+            }
+        }
+    }
+
+    return (count);
+}
+
+int SpatialGrid::getCellCount() const
+{
+    return ((int)this->_cells.size());
+}
+
+int SpatialGrid::toCell(float coordinate) const
+{
+    return ((int)std::floor(coordinate / this->_cellSize));
+}
+
+std::int64_t SpatialGrid::makeCellKey(int cell_x, int cell_y)
+{
+    return (((std::int64_t)cell_x << 32) | (std::uint32_t)cell_y);
+}
+
+void SpatialGrid::insertIntoCell(int index, std::int64_t cell_key)
+{
+    std::vector<int>& cell = this->_cells[cell_key];
+    this->_entries[index].cellKey = cell_key;
+    this->_entries[index].slot = (int)cell.size();
+    cell.push_back(index);
+}
+
+void SpatialGrid::eraseFromCell(int index)
+{
+    SpatialGrid::Entry& entry = this->_entries[index];
+    auto it = this->_cells.find(entry.cellKey);
+    if (it == this->_cells.end())
+    {
+        return ;
+    }
+
+    // 마지막 항목을 빈 자리로 옮기고 끝을 줄입니다.
+    std::vector<int>& cell = it->second;
+    int last_index = cell.back();
+    cell[entry.slot] = last_index;
+    this->_entries[last_index].slot = entry.slot;
+    cell.pop_back();
+    entry.slot = -1;
+
+    if (cell.empty())
+    {
+        this->_cells.erase(it);
+    }
+}
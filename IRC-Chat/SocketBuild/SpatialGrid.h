@@ -0,0 +1,176 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SpatialGrid.h
+ * @brief 세션 위치를 균일 격자로 색인하는 SpatialGrid 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 월드를 XY 평면의 정사각형 칸(cell)으로 나누고, 칸 좌표를 해시 키로 하여 칸마다 세션 목록을 보관합니다.
+ * <br>위치 갱신은 이전 칸에서 빼고 새 칸에 넣는 O(1) 작업이며,
+ * <br>반경 질의는 반경이 걸치는 칸들만 검사하므로 비용이 전체 인구가 아니라 주변 인구에 비례합니다.
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief 근접 채팅 대상을 찾기 위한 공간 해시 격자입니다.
+ *
+ * @note 좌표는 언리얼 월드 좌표(cm)를 그대로 사용하며, 칸 분할은 X/Y로만 하고 거리 검사는 X/Y/Z 모두 사용합니다.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * @enum SpatialGrid::Result
+     * @brief 격자 갱신 요청의 결과 상태 값.
+     */
+    enum class Result
+    {
+        SUCCESS,        ///< 갱신이 반영됨.
+        INVALID_INDEX,  ///< 인덱스가 범위를 벗어남.
+        NOT_TRACKED     ///< 격자에 없는 인덱스를 제거하려 함.
+    };
+
+public:
+    /**
+     * @fn SpatialGrid::SpatialGrid(int capacity, float cell_size)
+     * @brief 빈 격자를 생성합니다.
+     * @param[IN] int capacity : 최대 세션 수 (클라이언트 인덱스 범위).
+     * @param[IN] float cell_size : 칸 한 변의 길이. 주로 쓰는 질의 반경과 같게 두면 질의 시 3x3 칸만 검사합니다.
+     * @return 없음.
+     */
+    SpatialGrid(int capacity, float cell_size);
+
+    /**
+     * @fn SpatialGrid::~SpatialGrid()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~SpatialGrid();
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SpatialGrid(const SpatialGrid& obj) = delete;
+    SpatialGrid& operator=(const SpatialGrid& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SpatialGrid(SpatialGrid&& obj) = delete;
+    SpatialGrid& operator=(SpatialGrid&& obj) = delete;
+
+public:
+    /**
+     * @fn SpatialGrid::Result SpatialGrid::update(int index, float x, float y, float z)
+     * @brief 세션의 위치를 갱신합니다. 처음이면 격자에 추가합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[IN] float x : X 좌표.
+     * @param[IN] float y : Y 좌표.
+     * @param[IN] float z : Z 좌표.
+     * @return SpatialGrid::Result : 처리 결과.
+     * @note 칸이 바뀌지 않으면 좌표만 갱신하고, 바뀌면 이전 칸에서 swap-remove 후 새 칸에 추가합니다.
+     */
+    SpatialGrid::Result update(int index, float x, float y, float z);
+
+    /**
+     * @fn SpatialGrid::Result SpatialGrid::remove(int index)
+     * @brief 세션을 격자에서 제거합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return SpatialGrid::Result : 처리 결과.
+     */
+    SpatialGrid::Result remove(int index);
+
+    /**
+     * @fn bool SpatialGrid::getPosition(int index, float& x, float& y, float& z) const
+     * @brief 세션의 마지막 위치를 가져옵니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[OUT] float& x : X 좌표.
+     * @param[OUT] float& y : Y 좌표.
+     * @param[OUT] float& z : Z 좌표.
+     * @return bool : 위치가 등록되어 있으면 true.
+     */
+    bool getPosition(int index, float& x, float& y, float& z) const;
+
+    /**
+     * @fn int SpatialGrid::queryRadius(float x, float y, float z, float radius, int* indices, int max_count) const
+     * @brief 지정한 위치에서 반경 안에 있는 세션의 인덱스를 모읍니다.
+     * @param[IN] float x : 중심 X 좌표.
+     * @param[IN] float y : 중심 Y 좌표.
+     * @param[IN] float z : 중심 Z 좌표.
+     * @param[IN] float radius : 반경.
+     * @param[OUT] int* indices : 인덱스를 저장할 배열.
+     * @param[IN] int max_count : 배열이 담을 수 있는 최대 개수.
+     * @return int : 저장된 인덱스 개수.
+     */
+    int queryRadius(float x, float y, float z, float radius, int* indices, int max_count) const;
+
+    /**
+     * @fn int SpatialGrid::getCellCount() const
+     * @brief 세션이 하나 이상 있는 칸의 수를 반환합니다.
+     * @return int : 사용 중인 칸 수.
+     */
+    int getCellCount() const;
+
+private:
+    /**
+     * @struct SpatialGrid::Entry
+     * @brief 세션 하나의 위치와 격자 내 자리.
+     */
+    struct Entry
+    {
+        bool tracked;           ///< 격자에 등록되어 있는지 여부.
+        float x;                ///< X 좌표.
+        float y;                ///< Y 좌표.
+        float z;                ///< Z 좌표.
+        std::int64_t cellKey;   ///< 속한 칸의 키.
+        int slot;               ///< 칸 목록 안에서의 위치 (swap-remove용).
+    };
+
+private:
+    /// 칸 한 변의 길이.
+    float _cellSize;
+
+    /// 클라이언트 인덱스별 위치 정보.
+    std::vector<SpatialGrid::Entry> _entries;
+
+    /// 칸 키별 세션 인덱스 목록.
+    std::unordered_map<std::int64_t, std::vector<int>> _cells;
+
+private:
+    /**
+     * @fn int SpatialGrid::toCell(float coordinate) const
+     * @brief 좌표를 칸 좌표로 변환합니다.
+     * @param[IN] float coordinate : 월드 좌표.
+     * @return int : 칸 좌표.
+     */
+    int toCell(float coordinate) const;
+
+    /**
+     * @fn static std::int64_t SpatialGrid::makeCellKey(int cell_x, int cell_y)
+     * @brief 칸 좌표 두 개를 하나의 해시 키로 합칩니다.
+     * @param[IN] int cell_x : X 칸 좌표.
+     * @param[IN] int cell_y : Y 칸 좌표.
+     * @return std::int64_t : 칸 키.
+     */
+    static std::int64_t makeCellKey(int cell_x, int cell_y);
+
+    /**
+     * @fn void SpatialGrid::insertIntoCell(int index, std::int64_t cell_key)
+     * @brief 세션을 칸 목록 끝에 추가합니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @param[IN] std::int64_t cell_key : 칸 키.
+     * @return 없음.
+     */
+    void insertIntoCell(int index, std::int64_t cell_key);
+
+    /**
+     * @fn void SpatialGrid::eraseFromCell(int index)
+     * @brief 세션을 현재 칸 목록에서 swap-remove로 뺍니다.
+     * @param[IN] int index : 클라이언트 인덱스.
+     * @return 없음.
+     */
+    void eraseFromCell(int index);
+};
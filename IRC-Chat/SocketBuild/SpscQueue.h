@@ -0,0 +1,157 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file SpscQueue.h
+ * @brief 생산자 하나와 소비자 하나가 잠금 없이 주고받는 고정 크기 링 큐 SpscQueue 템플릿을 정의합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 생산자만 _tail을, 소비자만 _head를 씁니다. 서로의 인덱스는 읽기만 하므로 원자적 load/store만으로 충분합니다.
+ * <br>상대 인덱스는 마지막으로 읽은 값을 캐시해 두고, 캐시로 판단할 수 없을 때만 다시 읽어 캐시 줄 왕복을 줄입니다.
+ * <br>생산자 쪽 값과 소비자 쪽 값은 서로 다른 캐시 줄에 둡니다.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpscQueue
+ * @brief 단일 생산자, 단일 소비자 전용의 잠금 없는 고정 크기 큐입니다.
+ * @tparam T 항목 타입 (기본 생성과 이동이 가능해야 합니다).
+ *
+ * @note tryPush()는 한 스레드에서만, tryPop()은 다른 한 스레드에서만 호출합니다.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @fn SpscQueue<T>::SpscQueue(std::size_t capacity)
+     * @brief 큐를 생성합니다.
+     * @param[IN] std::size_t capacity : 최소 용량 (2의 거듭제곱으로 올림).
+     * @return 없음.
+     */
+    explicit SpscQueue(std::size_t capacity)
+        : _slots(), _mask(0), _consumer(), _producer()
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+        {
+            size = size * 2;
+        }
+        this->_slots.resize(size);
+        this->_mask = size - 1;
+    }
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    SpscQueue(const SpscQueue& obj) = delete;
+    SpscQueue& operator=(const SpscQueue& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    SpscQueue(SpscQueue&& obj) = delete;
+    SpscQueue& operator=(SpscQueue&& obj) = delete;
+
+public:
+    /**
+     * @fn bool SpscQueue<T>::tryPush(T&& item)
+     * @brief 항목을 큐 끝에 넣습니다. (생산자 전용)
+     * @param[IN] T&& item : 넣을 항목. 가득 차서 실패하면 옮기지 않습니다.
+     * @return bool : 넣었으면 true, 가득 찼으면 false.
+     */
+    bool tryPush(T&& item)
+    {
+        std::size_t tail = this->_producer.tail.load(std::memory_order_relaxed);
+        if (tail - this->_producer.cachedHead > this->_mask)
+        {
+            this->_producer.cachedHead = this->_consumer.head.load(std::memory_order_acquire);
+            if (tail - this->_producer.cachedHead > this->_mask)
+            {
+                return (false);
+            }
+        }
+
+        this->_slots[tail & this->_mask] = std::move(item);
+        this->_producer.tail.store(tail + 1, std::memory_order_release);
+        return (true);
+    }
+
+    /**
+     * @fn bool SpscQueue<T>::tryPop(T& item)
+     * @brief 큐 앞의 항목을 꺼냅니다. (소비자 전용)
+     * @param[OUT] T& item : 꺼낸 항목.
+     * @return bool : 꺼냈으면 true, 비었으면 false.
+     */
+    bool tryPop(T& item)
+    {
+        std::size_t head = this->_consumer.head.load(std::memory_order_relaxed);
+        if (head == this->_consumer.cachedTail)
+        {
+            this->_consumer.cachedTail = this->_producer.tail.load(std::memory_order_acquire);
+            if (head == this->_consumer.cachedTail)
+            {
+                return (false);
+            }
+        }
+
+        item = std::move(this->_slots[head & this->_mask]);
+        this->_consumer.head.store(head + 1, std::memory_order_release);
+        return (true);
+    }
+
+    /**
+     * @fn bool SpscQueue<T>::isEmpty() const
+     * @brief 큐가 비었는지 확인합니다. 다른 스레드에서 부르면 호출 시점의 근삿값입니다.
+     * @return bool : 비었으면 true.
+     */
+    bool isEmpty() const
+    {
+        return (this->_producer.tail.load(std::memory_order_acquire) == this->_consumer.head.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @fn std::size_t SpscQueue<T>::getSize() const
+     * @brief 큐에 든 항목 수를 반환합니다. 다른 스레드에서 부르면 호출 시점의 근삿값입니다.
+     * @return std::size_t : 항목 수.
+     */
+    std::size_t getSize() const
+    {
+        std::size_t head = this->_consumer.head.load(std::memory_order_acquire);
+        std::size_t tail = this->_producer.tail.load(std::memory_order_acquire);
+        return ((tail >= head) ? tail - head : 0);
+    }
+
+    /**
+     * @fn std::size_t SpscQueue<T>::getCapacity() const
+     * @brief 큐 용량을 반환합니다.
+     * @return std::size_t : 용량.
+     */
+    std::size_t getCapacity() const
+    {
+        return (this->_mask + 1);
+    }
+
+private:
+    /// 항목 배열 (크기는 2의 거듭제곱).
+    std::vector<T> _slots;
+
+    /// 인덱스를 배열 위치로 바꾸는 마스크 (용량 - 1).
+    std::size_t _mask;
+
+    /// 소비자가 쓰는 값.
+    struct alignas(64)
+    {
+        std::atomic<std::size_t> head{ 0 };   ///< 다음에 꺼낼 인덱스.
+        std::size_t cachedTail = 0;           ///< 마지막으로 읽은 생산자 인덱스.
+    } _consumer;
+
+    /// 생산자가 쓰는 값.
+    struct alignas(64)
+    {
+        std::atomic<std::size_t> tail{ 0 };   ///< 다음에 넣을 인덱스.
+        std::size_t cachedHead = 0;           ///< 마지막으로 읽은 소비자 인덱스.
+    } _producer;
+};
@@ -12,22 +12,17 @@
  * <br>이를 통해 저수준의 소켓 호출을 단순한 인터페이스로 추상화할 수 있습니다.
  */
 
-#include <WinSock2.h>
+#include "NetworkTransport.h"
 
  /**
-  * @class TCPSocket
-  * @brief TCP 서버 소켓과 그 기본 동작(생성, 바인드, 연결 대기, 연결 수락, 종료)을 캡슐화합니다.
-  *
-  * @details
-  * 이 클래스는 서버에서 클라이언트의 접속을 받는 리스닝 소켓을 처리하는 데 사용됩니다. 
-  * <br>각 단계별 문제를 표시하는 오류 상태 값(Result)을 제공합니다.
-  * <br>TCPSocket을 사용하면 상위 수준의 서버 코드(MultiServer)가 네트워킹을 보다 높은 추상화 수준에서 처리할 수 있습니다.
+  * @class TCPSocketBase
+  * @brief 전송 계층 타입과 상관없이 모든 TCPSocket이 함께 쓰는 결과 값입니다.
   */
-class TCPSocket
+class TCPSocketBase
 {
 	public :
 		/**
-		 * @enum TCPSocket::Result
+		 * @enum TCPSocketBase::Result
 		 * @brief TCPSocket 연산에 대한 결과 상태 값입니다.
 		 */
 		enum class Result
@@ -38,10 +33,26 @@ class TCPSocket
 			FAIL_LISTEN,	///< 리스닝 모드 전환 실패.
 			FAIL_ACCEPT		///< 새 연결 수락 실패.
 		};
-		
+};
+
+ /**
+  * @class TCPSocket
+  * @brief TCP 서버 소켓과 그 기본 동작(생성, 바인드, 연결 대기, 연결 수락, 종료)을 캡슐화합니다.
+  * @tparam Transport : 소켓 호출에 사용할 전송 계층 타입.
+  *
+  * @details
+  * 이 클래스는 서버에서 클라이언트의 접속을 받는 리스닝 소켓을 처리하는 데 사용됩니다. 
+  * <br>각 단계별 문제를 표시하는 오류 상태 값(Result)을 제공합니다.
+  * <br>TCPSocket을 사용하면 상위 수준의 서버 코드(MultiServer)가 네트워킹을 보다 높은 추상화 수준에서 처리할 수 있습니다.
+  */
+template <typename Transport>
+class TCPSocket : public TCPSocketBase
+{
+	public :
 		/**
-		 * @fn TCPSocket::TCPSocket()
+		 * @fn TCPSocket::TCPSocket(Transport& transport)
 		 * @brief TCPSocket 객체를 생성하고 소켓 핸들을 INVALID_SOCKET으로 초기화합니다.
+		 * @param[IN] Transport& transport : 소켓 호출에 사용할 전송 계층.
 		 * @return 없음.
 		 * 
 		 * @details
@@ -50,7 +61,7 @@ class TCPSocket
 		 * @note 
 		 * 생성 후 실제 소켓을 만들려면 createTCPSocket()을 호출해야합니다.
 		 */
-		TCPSocket();
+		explicit TCPSocket(Transport& transport);
 
 		/**
 		 * @fn TCPSocket::~TCPSocket()
@@ -74,7 +85,7 @@ class TCPSocket
 		 * @return TCPSocket::Result : 소켓 생성에 성공하면 SUCCESS, 실패하면 FAIL_CREATE를 반환합니다.
 		 *
 		 * @note
-		 * 내부적으로 socket(...) 함수(winsock API)를 호출합니다. 
+		 * 내부적으로 NetworkTransport::createSocket()(WinSock의 socket 함수)를 호출합니다. 
 		 * <br>이 메서드는 바인드나 리스닝을 수행하기 전에 호출되어야 합니다.
 		 */
 		TCPSocket::Result createTCPSocket();
@@ -102,8 +113,9 @@ class TCPSocket
 		TCPSocket::Result startListen();
 
 		/**
-		 * @fn SOCKET TCPSocket::acceptConnection()
+		 * @fn SOCKET TCPSocket::acceptConnection(sockaddr_in* client_addr)
 		 * @brief 들어오는 클라이언트 연결을 수락합니다.
+		 * @param[OUT(default : nullptr)] sockaddr_in* client_addr : 수락한 클라이언트의 주소를 받을 구조체 (필요 없으면 nullptr).
 		 * @return SOCKET : 수락된 연결에 대한 새로운 클라이언트 소켓을 반환합니다. 
 		 * <br>연결이 수락되지 않았거나 오류가 발생한 경우 INVALID_SOCKET을 반환합니다.
 		 *
@@ -111,7 +123,7 @@ class TCPSocket
 		 * 들어오는 연결을 대기합니다. (리스닝 소켓에 대해 select()가 읽기 가능 이벤트를 나타낸 후 호출되어야 합니다.)
 		 * <br>성공 시 유효한 클라이언트용 SOCKET을 반환하며, 이 소켓은 ClientManager가 관리해야 합니다.
 		 */
-		SOCKET acceptConnection();
+		SOCKET acceptConnection(sockaddr_in* client_addr = nullptr);
 
 		/**
 		 * @fn void TCPSocket::closeTCPSocket()
@@ -138,6 +150,9 @@ class TCPSocket
 		SOCKET getSocket() const;
 
 	private:
+		/// 소켓 호출에 사용하는 전송 계층.
+		Transport& _transport;
+
 		/// TCP 서버 소켓(WinSock 소켓).
 		SOCKET _tcpSocket;
 
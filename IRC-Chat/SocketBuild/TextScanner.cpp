@@ -0,0 +1,486 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file TextScanner.cpp
+ * @brief TextScanner.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TextScanner.h"
+#include "DebugHelper.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#define TEXT_SCANNER_X86
+#include <intrin.h>
+#endif
+
+/**
+ * @brief data에서 시작하는 UTF-8 문자 하나가 앞에서부터 몇 바이트까지 올바른지 셉니다. (유니코드 표준 표 3-7 기준)
+ * @param[IN] const unsigned char* data : 문자 시작 위치 (0x80 이상인 바이트).
+ * @param[IN] std::size_t size : 남은 바이트 수 (1 이상).
+ * @param[OUT] std::size_t& expected : 첫 바이트가 나타내는 문자 길이, 첫 바이트부터 틀리면 0.
+ * @return std::size_t : 올바른 접두부 길이 (expected와 같으면 완전한 문자).
+ */
+static std::size_t measure_sequence(const unsigned char* data, std::size_t size, std::size_t& expected)
+{
+    unsigned char lead = data[0];
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        expected = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        // E0은 과잉 표현, ED는 서로게이트(U+D800~U+DFFF)를 막도록 두 번째 바이트 범위가 좁습니다.
+        expected = 3;
+        low = (lead == 0xE0) ? 0xA0 : low;
+        high = (lead == 0xED) ? 0x9F : high;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        // F0은 과잉 표현, F4는 U+10FFFF 초과를 막습니다.
+        expected = 4;
+        low = (lead == 0xF0) ? 0x90 : low;
+        high = (lead == 0xF4) ? 0x8F : high;
+    }
+    else
+    {
+        expected = 0;
+        return (0);
+    }
+
+    if (size < 2 || data[1] < low || data[1] > high)
+    {
+        return (1);
+    }
+
+    std::size_t length = 2;
+    while (length < expected && length < size && (data[length] & 0xC0) == 0x80)
+    {
+        length = length + 1;
+    }
+    return (length);
+}
+
+static std::size_t find_line_break_scalar(const char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (data[i] == '\n' || data[i] == '\r')
+        {
+            return (i);
+        }
+    }
+    return (size);
+}
+
+static bool is_valid_utf8_scalar(const char* data, std::size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    std::size_t i = 0;
+    while (i < size)
+    {
+        if (bytes[i] < 0x80)
+        {
+            i = i + 1;
+            continue;
+        }
+
+        std::size_t expected = 0;
+        std::size_t length = measure_sequence(bytes + i, size - i, expected);
+        if (expected == 0 || length != expected)
+        {
+            return (false);
+        }
+        i = i + length;
+    }
+    return (true);
+}
+
+#ifdef TEXT_SCANNER_X86
+
+static std::size_t find_line_break_sse2(const char* data, std::size_t size)
+{
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, line_feed), _mm_cmpeq_epi8(block, carriage_return)));
+        if (mask != 0)
+        {
+            return (i + (std::size_t)std::countr_zero(mask));
+        }
+    }
+    return (i + find_line_break_scalar(data + i, size - i));
+}
+
+static bool is_valid_utf8_sse2(const char* data, std::size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    std::size_t i = 0;
+    while (i + 16 <= size)
+    {
+        // 문자 경계에서 16바이트가 모두 ASCII면 한 번에 건너뛰고, 아니면 처음 나오는 비ASCII 문자 하나를 스칼라로 검사합니다.
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(bytes + i)));
+        if (mask == 0)
+        {
+            i = i + 16;
+            continue;
+        }
+        i = i + (std::size_t)std::countr_zero(mask);
+
+        std::size_t expected = 0;
+        std::size_t length = measure_sequence(bytes + i, size - i, expected);
+        if (expected == 0 || length != expected)
+        {
+            return (false);
+        }
+        i = i + length;
+    }
+    return (is_valid_utf8_scalar(data + i, size - i));
+}
+
+static std::size_t find_line_break_avx2(const char* data, std::size_t size)
+{
+    const __m256i line_feed = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, line_feed), _mm256_cmpeq_epi8(block, carriage_return)));
+        if (mask != 0)
+        {
+            return (i + (std::size_t)std::countr_zero(mask));
+        }
+    }
+    return (i + find_line_break_sse2(data + i, size - i));
+}
+
+/**
+ * @brief 16개 값의 표를 두 128비트 레인에 똑같이 채웁니다. (_mm256_shuffle_epi8은 레인마다 따로 찾습니다)
+ */
+static __m256i make_table(char v0, char v1, char v2, char v3, char v4, char v5, char v6, char v7,
+                          char v8, char v9, char v10, char v11, char v12, char v13, char v14, char v15)
+{
+    return (_mm256_broadcastsi128_si256(_mm_setr_epi8(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15)));
+}
+
+/**
+ * @brief input의 각 바이트 위치에서 N바이트 앞의 바이트를 모읍니다. 블록 앞부분은 이전 블록 끝에서 가져옵니다.
+ */
+template <int N>
+static __m256i previous_bytes(__m256i input, __m256i previous_input)
+{
+    return (_mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous_input, input, 0x21), 16 - N));
+}
+
+static __m256i high_nibbles(__m256i input)
+{
+    return (_mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F)));
+}
+
+/**
+ * @brief 비ASCII 블록 하나의 오류 비트를 구합니다. (0이 아닌 바이트가 있으면 잘못된 UTF-8)
+ * @details
+ * 두 바이트(앞 바이트, 현재 바이트) 조합의 오류 종류를 비트로 나누고,
+ * <br>앞 바이트 상위 4비트, 앞 바이트 하위 4비트, 현재 바이트 상위 4비트로 각각 표를 찾아 AND하면 세 표 모두에 걸리는 오류만 남습니다.
+ * <br>3, 4바이트 문자의 세 번째, 네 번째 바이트는 2, 3바이트 앞의 첫 바이트로 따로 확인합니다.
+ */
+static __m256i check_utf8_block(__m256i input, __m256i previous_input)
+{
+    const char TOO_SHORT = 1 << 0;          // 11______ 다음에 0_______ 또는 11______
+    const char TOO_LONG = 1 << 1;           // 0_______ 다음에 10______
+    const char OVERLONG_3 = 1 << 2;         // 11100000 100_____
+    const char TOO_LARGE = 1 << 3;          // 11110100 1001____ 이상
+    const char SURROGATE = 1 << 4;          // 11101101 101_____
+    const char OVERLONG_2 = 1 << 5;         // 1100000_ 10______
+    const char TOO_LARGE_1000 = 1 << 6;     // 11110101 이상 다음에 1000____
+    const char OVERLONG_4 = 1 << 6;         // 11110000 1000____
+    const char TWO_CONTS = (char)(1 << 7);  // 10______ 10______
+    const char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    __m256i previous_1 = previous_bytes<1>(input, previous_input);
+
+    __m256i byte_1_high = _mm256_shuffle_epi8(make_table(
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4), high_nibbles(previous_1));
+
+    __m256i byte_1_low = _mm256_shuffle_epi8(make_table(
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000), _mm256_and_si256(previous_1, _mm256_set1_epi8(0x0F)));
+
+    __m256i byte_2_high = _mm256_shuffle_epi8(make_table(
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT), high_nibbles(input));
+
+    __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // 2바이트 앞이 1110____ 이상, 3바이트 앞이 11110___ 이상이면 이 자리는 이어지는 바이트여야 합니다.
+    // 이 경우 위 표에서는 TWO_CONTS(0x80)가 켜지므로, XOR하면 맞는 자리는 꺼지고 틀린 자리만 남습니다.
+    __m256i is_third_byte = _mm256_subs_epu8(previous_bytes<2>(input, previous_input), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i is_fourth_byte = _mm256_subs_epu8(previous_bytes<3>(input, previous_input), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8((char)0x80));
+
+    return (_mm256_xor_si256(must_be_continuation, special_cases));
+}
+
+/**
+ * @brief 블록 끝의 1~3바이트가 끝나지 않은 문자의 시작이면 0이 아닌 값을 돌려줍니다.
+ */
+static __m256i check_utf8_incomplete(__m256i input)
+{
+    const __m256i max_value = _mm256_setr_epi8(
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    return (_mm256_subs_epu8(input, max_value));
+}
+
+static bool is_valid_utf8_avx2(const char* data, std::size_t size)
+{
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous_input = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        __m256i input;
+        if (i + 32 <= size)
+        {
+            input = _mm256_loadu_si256((const __m256i*)(data + i));
+        }
+        else
+        {
+            // 마지막 조각은 0(ASCII)으로 채워 같은 방식으로 검사합니다. 끝나지 않은 문자는 TOO_SHORT로 걸립니다.
+            alignas(32) char tail[32] = {};
+            std::memcpy(tail, data + i, size - i);
+            input = _mm256_load_si256((const __m256i*)tail);
+        }
+
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // ASCII 블록 앞에서 문자가 끊겼는지만 확인합니다.
+            error = _mm256_or_si256(error, previous_incomplete);
+            previous_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            error = _mm256_or_si256(error, check_utf8_block(input, previous_input));
+            previous_incomplete = check_utf8_incomplete(input);
+        }
+        previous_input = input;
+        i = i + 32;
+    }
+
+    error = _mm256_or_si256(error, previous_incomplete);
+    return (_mm256_testz_si256(error, error) != 0);
+}
+
+#endif
+
+/**
+ * @brief 이 CPU에서 쓸 수 있는 가장 넓은 구현을 고릅니다.
+ */
+static TextScanner::Kernel detect_kernel()
+{
+#ifdef TEXT_SCANNER_X86
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool has_sse2 = (info[3] & (1 << 26)) != 0;
+    bool has_avx = (info[2] & (1 << 28)) != 0;
+    bool has_os_xsave = (info[2] & (1 << 27)) != 0;
+
+    // AVX2 명령이 있어도 운영체제가 YMM 레지스터를 저장하지 않으면 쓸 수 없습니다.
+    if (max_leaf >= 7 && has_avx && has_os_xsave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0)
+        {
+            return (TextScanner::Kernel::AVX2);
+        }
+    }
+    if (has_sse2)
+    {
+        return (TextScanner::Kernel::SSE2);
+    }
+#endif
+    return (TextScanner::Kernel::SCALAR);
+}
+
+/**
+ * @brief 현재 선택된 구현. 처음 쓸 때 한 번 검사해서 정합니다.
+ */
+static std::atomic<TextScanner::Kernel>& current_kernel()
+{
+    static std::atomic<TextScanner::Kernel> kernel(detect_kernel());
+    return (kernel);
+}
+
+TextScanner::Kernel TextScanner::getKernel()
+{
+    return (current_kernel().load(std::memory_order_relaxed));
+}
+
+bool TextScanner::selectKernel(TextScanner::Kernel kernel)
+{
+    if ((int)kernel > (int)detect_kernel())
+    {
+        return (false);
+    }
+
+    current_kernel().store(kernel, std::memory_order_relaxed);
+    LOG_INFO(std::string("수신 텍스트 검사 구현을 바꿨습니다: ") + TextScanner::getKernelName(kernel));
+    return (true);
+}
+
+const char* TextScanner::getKernelName(TextScanner::Kernel kernel)
+{
+    switch (kernel)
+    {
+    case TextScanner::Kernel::SSE2:
+        return ("sse2");
+    case TextScanner::Kernel::AVX2:
+        return ("avx2");
+    default:
+        return ("scalar");
+    }
+}
+
+std::size_t TextScanner::findLineBreak(const char* data, std::size_t size)
+{
+    switch (TextScanner::getKernel())
+    {
+#ifdef TEXT_SCANNER_X86
+    case TextScanner::Kernel::AVX2:
+        return (find_line_break_avx2(data, size));
+    case TextScanner::Kernel::SSE2:
+        return (find_line_break_sse2(data, size));
+#endif
+    default:
+        return (find_line_break_scalar(data, size));
+    }
+}
+
+bool TextScanner::isValidUtf8(const char* data, std::size_t size)
+{
+    switch (TextScanner::getKernel())
+    {
+#ifdef TEXT_SCANNER_X86
+    case TextScanner::Kernel::AVX2:
+        return (is_valid_utf8_avx2(data, size));
+    case TextScanner::Kernel::SSE2:
+        return (is_valid_utf8_sse2(data, size));
+#endif
+    default:
+        return (is_valid_utf8_scalar(data, size));
+    }
+}
+
+std::size_t TextScanner::sanitizeUtf8(std::string& text)
+{
+    if (TextScanner::isValidUtf8(text.data(), text.size()))
+    {
+        return (0);
+    }
+
+    const unsigned char* bytes = (const unsigned char*)text.data();
+    std::string cleaned;
+    cleaned.reserve(text.size() + 8);
+    std::size_t replaced_count = 0;
+
+    std::size_t i = 0;
+    while (i < text.size())
+    {
+        if (bytes[i] < 0x80)
+        {
+            cleaned.push_back((char)bytes[i]);
+            i = i + 1;
+            continue;
+        }
+
+        std::size_t expected = 0;
+        std::size_t length = measure_sequence(bytes + i, text.size() - i, expected);
+        if (expected != 0 && length == expected)
+        {
+            cleaned.append(text, i, length);
+            i = i + length;
+            continue;
+        }
+
+        // 올바른 접두부(최소 1바이트)를 U+FFFD 하나로 바꿉니다.
+        cleaned.append(TextScanner::REPLACEMENT_CHARACTER);
+        replaced_count = replaced_count + 1;
+        i = i + ((length == 0) ? 1 : length);
+    }
+
+    text.swap(cleaned);
+    return (replaced_count);
+}
+
+std::size_t TextScanner::findUtf8Boundary(const char* data, std::size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    // 문자는 최대 4바이트이므로 끝에서 3바이트 안쪽의 첫 바이트만 확인합니다.
+    std::size_t lowest = (size > 3) ? size - 3 : 0;
+    for (std::size_t i = size; i > lowest; --i)
+    {
+        std::size_t start = i - 1;
+        if ((bytes[start] & 0xC0) == 0x80)
+        {
+            continue;
+        }
+        if (bytes[start] < 0x80)
+        {
+            return (size);
+        }
+
+        std::size_t expected = 0;
+        std::size_t length = measure_sequence(bytes + start, size - start, expected);
+        if (expected != 0 && length == size - start && length < expected)
+        {
+            return (start);
+        }
+        return (size);
+    }
+    return (size);
+}
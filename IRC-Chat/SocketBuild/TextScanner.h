@@ -0,0 +1,109 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file TextScanner.h
+ * @brief 수신 단계에서 줄 끝 문자를 찾고 UTF-8을 검증하는 TextScanner 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 수신한 바이트는 모두 줄 끝('\n', '\r') 찾기와 UTF-8 검증을 거친 뒤에야 명령 처리와 브로드캐스트로 넘어갑니다.
+ * <br>두 작업 모두 바이트마다 한 번씩 보는 반복문이라, x86에서는 SSE2(16바이트)나 AVX2(32바이트) 단위로 처리합니다.
+ * <br>- 줄 끝 찾기 : 블록을 '\n', '\r'과 한 번에 비교하고 movemask 결과의 가장 낮은 비트로 위치를 구합니다.
+ * <br>- UTF-8 검증(AVX2) : Keiser-Lemire 방식으로, 앞 바이트의 상위/하위 4비트와 현재 바이트의 상위 4비트를 표에서 찾아 AND한 결과로 오류를 판정합니다.
+ * <br>- UTF-8 검증(SSE2) : SSE2에는 바이트 셔플이 없으므로 ASCII 블록만 16바이트씩 건너뛰고, 나머지는 스칼라로 검사합니다.
+ * <br>사용할 구현은 처음 호출할 때 CPUID로 한 번 고르며, x86이 아니거나 확장을 지원하지 않으면 스칼라 구현을 씁니다.
+ */
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class TextScanner
+ * @brief 줄 끝 찾기, UTF-8 검증, 잘못된 바이트 치환을 제공하는 정적 함수 모음입니다.
+ *
+ * @note 상태가 없으므로 객체를 만들지 않습니다. selectKernel()만 전역 선택을 바꾸므로 서버 시작 전에 호출합니다.
+ */
+class TextScanner
+{
+public:
+    /**
+     * @enum TextScanner::Kernel
+     * @brief 줄 끝 찾기와 UTF-8 검증에 쓰는 구현.
+     */
+    enum class Kernel
+    {
+        SCALAR,     ///< 바이트 단위 구현.
+        SSE2,       ///< 16바이트 단위 구현.
+        AVX2        ///< 32바이트 단위 구현.
+    };
+
+    /// 잘못된 바이트열 대신 넣는 U+FFFD(REPLACEMENT CHARACTER)의 UTF-8 표현.
+    static constexpr const char* REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";
+
+public:
+    // 정적 함수만 제공하므로 생성하지 않습니다.
+    TextScanner() = delete;
+
+public:
+    /**
+     * @fn static TextScanner::Kernel TextScanner::getKernel()
+     * @brief 현재 사용 중인 구현을 반환합니다.
+     * @return TextScanner::Kernel : 구현 종류.
+     */
+    static TextScanner::Kernel getKernel();
+
+    /**
+     * @fn static bool TextScanner::selectKernel(TextScanner::Kernel kernel)
+     * @brief 사용할 구현을 직접 고릅니다. (성능 비교나 문제 확인용)
+     * @param[IN] TextScanner::Kernel kernel : 사용할 구현.
+     * @return bool : 이 CPU가 지원하지 않는 구현이면 false (기존 선택을 유지합니다).
+     */
+    static bool selectKernel(TextScanner::Kernel kernel);
+
+    /**
+     * @fn static const char* TextScanner::getKernelName(TextScanner::Kernel kernel)
+     * @brief 구현 이름을 반환합니다.
+     * @param[IN] TextScanner::Kernel kernel : 구현 종류.
+     * @return const char* : "scalar", "sse2", "avx2" 중 하나.
+     */
+    static const char* getKernelName(TextScanner::Kernel kernel);
+
+    /**
+     * @fn static std::size_t TextScanner::findLineBreak(const char* data, std::size_t size)
+     * @brief 처음 나오는 '\n' 또는 '\r'의 위치를 찾습니다.
+     * @param[IN] const char* data : 검사할 바이트열.
+     * @param[IN] std::size_t size : 바이트 수.
+     * @return std::size_t : 위치, 없으면 size.
+     */
+    static std::size_t findLineBreak(const char* data, std::size_t size);
+
+    /**
+     * @fn static bool TextScanner::isValidUtf8(const char* data, std::size_t size)
+     * @brief 바이트열이 올바른 UTF-8인지 확인합니다.
+     * @param[IN] const char* data : 검사할 바이트열.
+     * @param[IN] std::size_t size : 바이트 수.
+     * @return bool : 과잉 표현, 서로게이트, U+10FFFF 초과, 잘린 시퀀스가 없으면 true.
+     */
+    static bool isValidUtf8(const char* data, std::size_t size);
+
+    /**
+     * @fn static std::size_t TextScanner::sanitizeUtf8(std::string& text)
+     * @brief 잘못된 UTF-8 바이트열을 U+FFFD로 바꿉니다.
+     * @param[IN, OUT] std::string& text : 검사할 문자열.
+     * @return std::size_t : 바꾼 개수 (올바르면 0이며 문자열은 그대로입니다).
+     * @note 먼저 isValidUtf8()로 확인하므로 올바른 입력은 복사하지 않습니다. 잘못된 부분은 유효한 접두부까지를 하나로 보고 U+FFFD 하나로 바꿉니다.
+     */
+    static std::size_t sanitizeUtf8(std::string& text);
+
+    /**
+     * @fn static std::size_t TextScanner::findUtf8Boundary(const char* data, std::size_t size)
+     * @brief 끝에 아직 다 오지 않은 UTF-8 문자가 있으면 그 앞까지의 길이를 구합니다.
+     * @param[IN] const char* data : 검사할 바이트열.
+     * @param[IN] std::size_t size : 바이트 수.
+     * @return std::size_t : 잘린 마지막 문자를 뺀 길이, 잘린 문자가 없으면 size.
+     * @note 올바른 접두부로 끝난 경우만 잘린 것으로 봅니다. 이미 틀린 바이트는 그대로 두어 sanitizeUtf8()이 바꾸게 합니다.
+     */
+    static std::size_t findUtf8Boundary(const char* data, std::size_t size);
+};
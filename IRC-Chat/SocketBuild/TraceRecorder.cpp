@@ -0,0 +1,145 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file TraceRecorder.cpp
+ * @brief TraceRecorder.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TraceRecorder.h"
+
+#ifdef ENABLE_TRACE
+
+#include "DebugHelper.h"
+#include <chrono>
+#include <fstream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+const char* TraceRecorder::DEFAULT_FILE_PATH = "chat_trace.json";
+
+std::vector<std::unique_ptr<TraceRecorder::ThreadRing>> TraceRecorder::_rings;
+std::mutex TraceRecorder::_ringsMutex;
+std::atomic<bool> TraceRecorder::_dumpRequested(false);
+std::atomic<bool> TraceRecorder::_enabled(true);
+std::uint64_t TraceRecorder::_baseTick = TraceRecorder::now();
+std::int64_t TraceRecorder::_baseNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+std::uint64_t TraceRecorder::now()
+{
+#ifdef _MSC_VER
+    return (__rdtsc());
+#else
+    return ((std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+void TraceRecorder::record(const char* name, std::uint64_t begin_tick, std::uint64_t end_tick)
+{
+    TraceRecorder::ThreadRing& ring = TraceRecorder::getThreadRing();
+
+    // 가득 차면 가장 오래된 구간 자리를 덮어씁니다.
+    std::uint64_t written = ring.written.load(std::memory_order_relaxed);
+    TraceRecorder::Span& span = ring.spans[written & (TraceRecorder::RING_CAPACITY - 1)];
+    span.name = name;
+    span.beginTick = begin_tick;
+    span.endTick = end_tick;
+    ring.written.store(written + 1, std::memory_order_release);
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    TraceRecorder::_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::isEnabled()
+{
+    return (TraceRecorder::_enabled.load(std::memory_order_relaxed));
+}
+
+bool TraceRecorder::dumpToFile(const std::string& file_path)
+{
+    std::ofstream out(file_path, std::ios::out | std::ios::trunc);
+    if (out.is_open() == false)
+    {
+        LOG_ERROR("트레이스 파일을 열 수 없습니다: " + file_path);
+        return (false);
+    }
+
+    // 기준 시점부터 지금까지의 TSC 증가량과 실제 경과 시간으로 틱당 마이크로초를 구합니다.
+    std::uint64_t now_tick = TraceRecorder::now();
+    std::int64_t now_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    double micros_per_tick = 0.0;
+    if (now_tick > TraceRecorder::_baseTick)
+    {
+        micros_per_tick = (double)(now_nanos - TraceRecorder::_baseNanos) / 1000.0 / (double)(now_tick - TraceRecorder::_baseTick);
+    }
+
+    int span_count = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    {
+        std::lock_guard<std::mutex> lock(TraceRecorder::_ringsMutex);
+        for (const std::unique_ptr<TraceRecorder::ThreadRing>& ring : TraceRecorder::_rings)
+        {
+            std::uint64_t written = ring->written.load(std::memory_order_acquire);
+            std::uint64_t first = (written > TraceRecorder::RING_CAPACITY) ? written - TraceRecorder::RING_CAPACITY : 0;
+
+            for (std::uint64_t i = first; i < written; ++i)
+            {
+                const TraceRecorder::Span& span = ring->spans[i & (TraceRecorder::RING_CAPACITY - 1)];
+                double begin_micros = (double)(span.beginTick - TraceRecorder::_baseTick) * micros_per_tick;
+                double duration_micros = (double)(span.endTick - span.beginTick) * micros_per_tick;
+
+                if (span_count > 0)
+                {
+                    out << ",";
+                }
+                out << "\n{\"name\":\"" << span.name << "\",\"cat\":\"chat\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->threadId
+                    << ",\"ts\":" << std::fixed << begin_micros << ",\"dur\":" << duration_micros << "}";
+                span_count = span_count + 1;
+            }
+        }
+    }
+    out << "\n]}\n";
+
+    LOG_INFO("트레이스를 저장했습니다: " + file_path + " (" + std::to_string(span_count) + "개 구간)");
+    return (true);
+}
+
+void TraceRecorder::requestDump()
+{
+    TraceRecorder::_dumpRequested.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::dumpIfRequested()
+{
+    if (TraceRecorder::_dumpRequested.exchange(false, std::memory_order_relaxed))
+    {
+        TraceRecorder::dumpToFile(TraceRecorder::DEFAULT_FILE_PATH);
+    }
+}
+
+TraceRecorder::ThreadRing& TraceRecorder::getThreadRing()
+{
+    thread_local TraceRecorder::ThreadRing* thread_ring = nullptr;
+    if (thread_ring != nullptr)
+    {
+        return (*thread_ring);
+    }
+
+    // 스레드마다 처음 한 번만 링 버퍼를 만들어 등록합니다.
+    std::unique_ptr<TraceRecorder::ThreadRing> ring = std::make_unique<TraceRecorder::ThreadRing>();
+    ring->written.store(0, std::memory_order_relaxed);
+    ring->spans.resize(TraceRecorder::RING_CAPACITY);
+
+    std::lock_guard<std::mutex> lock(TraceRecorder::_ringsMutex);
+    ring->threadId = (int)TraceRecorder::_rings.size() + 1;
+    thread_ring = ring.get();
+    TraceRecorder::_rings.push_back(std::move(ring));
+    return (*thread_ring);
+}
+
+#endif
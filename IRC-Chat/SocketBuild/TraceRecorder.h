@@ -0,0 +1,241 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file TraceRecorder.h
+ * @brief 핫 패스 구간 시간을 기록해 Chrome trace-event JSON으로 내보내는 TraceRecorder와 매크로를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * ENABLE_TRACE가 정의된 빌드에서만 동작합니다. (프로젝트 속성 > C/C++ > 전처리기 정의에 ENABLE_TRACE 추가.)
+ * <br>정의되지 않은 빌드에서는 모든 매크로가 컴파일 단계에서 삭제되어 비용이 없습니다.
+ * <br>구간은 스레드별 고정 크기 링 버퍼에 TSC(rdtsc) 값으로 기록되며, 가득 차면 가장 오래된 구간부터 덮어씁니다.
+ * <br>결과 파일은 Perfetto(ui.perfetto.dev) 또는 chrome://tracing에서 열 수 있습니다.
+ *
+ * 사용 예:
+ * @code
+ * void MultiServer::publishPresence()
+ * {
+ *     TRACE_SCOPE("MultiServer::publishPresence");
+ *     ...
+ * }
+ * @endcode
+ */
+
+#ifdef ENABLE_TRACE
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class TraceRecorder
+ * @brief 스레드별 링 버퍼에 구간을 기록하고 trace-event JSON 파일로 저장하는 정적 클래스입니다.
+ *
+ * @note 구간 이름은 문자열 리터럴처럼 프로그램이 끝날 때까지 유효한 포인터여야 합니다. (복사하지 않습니다.)
+ */
+class TraceRecorder
+{
+public:
+    /// 스레드 하나가 보관하는 최대 구간 수 (2의 거듭제곱).
+    static const std::uint32_t RING_CAPACITY = 1u << 16;
+
+    /// 덤프 파일 기본 경로.
+    static const char* DEFAULT_FILE_PATH;
+
+public:
+    // 인스턴스를 만들지 않습니다.
+    TraceRecorder() = delete;
+
+public:
+    /**
+     * @fn static std::uint64_t TraceRecorder::now()
+     * @brief 현재 TSC 값을 읽습니다.
+     * @return std::uint64_t : 단조 증가하는 틱 값.
+     */
+    static std::uint64_t now();
+
+    /**
+     * @fn static void TraceRecorder::record(const char* name, std::uint64_t begin_tick, std::uint64_t end_tick)
+     * @brief 현재 스레드의 링 버퍼에 구간 하나를 기록합니다.
+     * @param[IN] const char* name : 구간 이름.
+     * @param[IN] std::uint64_t begin_tick : 시작 틱.
+     * @param[IN] std::uint64_t end_tick : 종료 틱.
+     * @return 없음.
+     */
+    static void record(const char* name, std::uint64_t begin_tick, std::uint64_t end_tick);
+
+    /**
+     * @fn static void TraceRecorder::setEnabled(bool enabled)
+     * @brief 실행 중에 구간 기록을 켜고 끕니다. 기본값은 켜짐입니다.
+     * @param[IN] bool enabled : false이면 TRACE_SCOPE가 시각을 읽지도 기록하지도 않습니다.
+     * @return 없음.
+     * @note 꺼도 TRACE_SCOPE마다 플래그를 한 번 읽습니다. 비용을 완전히 없애려면 ENABLE_TRACE 없이 빌드합니다.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @fn static bool TraceRecorder::isEnabled()
+     * @brief 구간 기록이 켜져 있는지 확인합니다.
+     * @return bool : 켜져 있으면 true.
+     */
+    static bool isEnabled();
+
+    /**
+     * @fn static bool TraceRecorder::dumpToFile(const std::string& file_path)
+     * @brief 모든 스레드의 기록을 Chrome trace-event JSON 파일로 저장합니다.
+     * @param[IN] const std::string& file_path : 저장할 파일 경로.
+     * @return bool : 저장에 성공하면 true.
+     * @note 다른 스레드가 기록 중이면 해당 스레드의 가장 최근 구간 일부가 어긋날 수 있으므로, 루프 스레드에서 호출합니다.
+     */
+    static bool dumpToFile(const std::string& file_path);
+
+    /**
+     * @fn static void TraceRecorder::requestDump()
+     * @brief 다음 dumpIfRequested() 호출에서 덤프하도록 요청합니다.
+     * @return 없음.
+     * @note 콘솔 제어 처리기 등 다른 스레드에서 호출해도 안전합니다.
+     */
+    static void requestDump();
+
+    /**
+     * @fn static void TraceRecorder::dumpIfRequested()
+     * @brief 덤프 요청이 있으면 기본 경로로 저장합니다.
+     * @return 없음.
+     */
+    static void dumpIfRequested();
+
+private:
+    /**
+     * @struct TraceRecorder::Span
+     * @brief 기록된 구간 하나.
+     */
+    struct Span
+    {
+        const char* name;           ///< 구간 이름.
+        std::uint64_t beginTick;    ///< 시작 틱.
+        std::uint64_t endTick;      ///< 종료 틱.
+    };
+
+    /**
+     * @struct TraceRecorder::ThreadRing
+     * @brief 스레드 하나의 구간 링 버퍼.
+     */
+    struct ThreadRing
+    {
+        int threadId;                           ///< trace 파일의 tid 값.
+        std::atomic<std::uint64_t> written;     ///< 지금까지 기록한 구간 수.
+        std::vector<TraceRecorder::Span> spans; ///< 링 버퍼 (RING_CAPACITY개).
+    };
+
+private:
+    /**
+     * @fn static TraceRecorder::ThreadRing& TraceRecorder::getThreadRing()
+     * @brief 현재 스레드의 링 버퍼를 가져옵니다. 처음 호출 시 생성해 등록합니다.
+     * @return TraceRecorder::ThreadRing& : 현재 스레드의 링 버퍼.
+     */
+    static TraceRecorder::ThreadRing& getThreadRing();
+
+    /// 등록된 모든 스레드의 링 버퍼 (스레드가 끝나도 덤프를 위해 유지).
+    static std::vector<std::unique_ptr<TraceRecorder::ThreadRing>> _rings;
+
+    /// _rings 보호용 뮤텍스 (등록과 덤프 때만 사용).
+    static std::mutex _ringsMutex;
+
+    /// 덤프 요청 플래그.
+    static std::atomic<bool> _dumpRequested;
+
+    /// 구간 기록 여부.
+    static std::atomic<bool> _enabled;
+
+    /// 틱을 마이크로초로 바꾸기 위한 기준 TSC 값.
+    static std::uint64_t _baseTick;
+
+    /// _baseTick을 읽은 시점의 steady_clock 값(나노초).
+    static std::int64_t _baseNanos;
+};
+
+/**
+ * @class TraceScope
+ * @brief 생성부터 소멸까지를 하나의 구간으로 기록하는 RAII 객체입니다.
+ */
+class TraceScope
+{
+public:
+    /**
+     * @fn TraceScope::TraceScope(const char* name)
+     * @brief 구간을 시작합니다.
+     * @param[IN] const char* name : 구간 이름 (문자열 리터럴).
+     * @return 없음.
+     */
+    explicit TraceScope(const char* name)
+        : _name(name), _beginTick(TraceRecorder::isEnabled() ? TraceRecorder::now() : 0)
+    {
+    }
+
+    /**
+     * @fn TraceScope::~TraceScope()
+     * @brief 구간을 끝내고 기록합니다.
+     * @return 없음.
+     */
+    ~TraceScope()
+    {
+        // 시작할 때 기록이 꺼져 있었으면 남기지 않습니다.
+        if (this->_beginTick != 0)
+        {
+            TraceRecorder::record(this->_name, this->_beginTick, TraceRecorder::now());
+        }
+    }
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    TraceScope(const TraceScope& obj) = delete;
+    TraceScope& operator=(const TraceScope& obj) = delete;
+
+private:
+    /// 구간 이름.
+    const char* _name;
+    /// 시작 틱 (기록이 꺼져 있었으면 0).
+    std::uint64_t _beginTick;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @def TRACE_SCOPE(name)
+ * @brief 현재 블록이 끝날 때까지를 name 구간으로 기록합니다.
+ * @param[IN] const char* name : 구간 이름 (문자열 리터럴).
+ */
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+/**
+ * @def TRACE_REQUEST_DUMP()
+ * @brief 다음 TRACE_DUMP_IF_REQUESTED()에서 덤프하도록 요청합니다.
+ */
+#define TRACE_REQUEST_DUMP() TraceRecorder::requestDump()
+
+/**
+ * @def TRACE_DUMP_IF_REQUESTED()
+ * @brief 덤프 요청이 있으면 기본 경로로 저장합니다.
+ */
+#define TRACE_DUMP_IF_REQUESTED() TraceRecorder::dumpIfRequested()
+
+/**
+ * @def TRACE_DUMP()
+ * @brief 지금까지의 기록을 기본 경로로 저장합니다.
+ */
+#define TRACE_DUMP() TraceRecorder::dumpToFile(TraceRecorder::DEFAULT_FILE_PATH)
+
+#else
+
+// 트레이스가 꺼진 빌드에서는 해당 표현이 컴파일 단계에서 완전히 삭제됩니다.
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_REQUEST_DUMP() ((void)0)
+#define TRACE_DUMP_IF_REQUESTED() ((void)0)
+#define TRACE_DUMP() ((void)0)
+
+#endif
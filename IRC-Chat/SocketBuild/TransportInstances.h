@@ -0,0 +1,53 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file TransportInstances.h
+ * @brief 전송 계층을 템플릿 인자로 받는 클래스를 어떤 전송 계층으로 만들어 둘지 한곳에 모읍니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 서버와 구성 요소는 전송 계층 타입을 템플릿 인자로 받으므로, 루프의 소켓 호출이 가상 호출 없이 final 타입의 함수에 바로 묶입니다.
+ * <br>정의는 각 .cpp에 그대로 두고, 파일 끝에서 아래 매크로로 쓰이는 조합만 명시적으로 인스턴스화합니다.
+ * <br>- 서버 조합 : WinSockTransport(실제 서버).
+ * <br>- 구성 요소 조합 : 서버 조합에 더해, MultiServer가 안에서 감싸 쓰는 RecordingTransport<서버 조합>.
+ * <br>CHAT_TEST_TRANSPORTS(SocketTests 프로젝트가 정의)가 있으면 테스트용 조합을 더합니다.
+ * <br>- 서버 조합 : SimulatedTransport(테스트와 재현), NetworkTransport(가상 호출을 쓰는 비교 기준).
+ * <br>- 구성 요소 조합 : 위의 RecordingTransport 조합과, 호출 비용만 재는 NullTransport.
+ * <br>서버 빌드는 쓰지 않는 조합을 만들지 않으므로 컴파일 시간과 실행 파일 크기가 늘지 않습니다.
+ */
+
+#include "NetworkTransport.h"
+#include "RecordingTransport.h"
+#include "WinSockTransport.h"
+
+#ifdef CHAT_TEST_TRANSPORTS
+#include "NullTransport.h"
+#include "SimulatedTransport.h"
+
+/// 테스트 빌드에서만 더하는 서버 조합.
+#define INSTANTIATE_TEST_SERVER_TRANSPORTS(ClassName) \
+    template class ClassName<NetworkTransport>; \
+    template class ClassName<SimulatedTransport>;
+
+/// 테스트 빌드에서만 더하는 구성 요소 조합.
+#define INSTANTIATE_TEST_COMPONENT_TRANSPORTS(ClassName) \
+    template class ClassName<RecordingTransport<NetworkTransport>>; \
+    template class ClassName<RecordingTransport<SimulatedTransport>>; \
+    template class ClassName<NullTransport>;
+#else
+#define INSTANTIATE_TEST_SERVER_TRANSPORTS(ClassName)
+#define INSTANTIATE_TEST_COMPONENT_TRANSPORTS(ClassName)
+#endif
+
+/// MultiServer와 RecordingTransport를 서버 조합으로 인스턴스화합니다.
+#define INSTANTIATE_SERVER_TRANSPORTS(ClassName) \
+    INSTANTIATE_TEST_SERVER_TRANSPORTS(ClassName) \
+    template class ClassName<WinSockTransport>
+
+/// 서버 구성 요소를 서버 조합과 그 RecordingTransport 조합으로 인스턴스화합니다.
+#define INSTANTIATE_COMPONENT_TRANSPORTS(ClassName) \
+    INSTANTIATE_SERVER_TRANSPORTS(ClassName); \
+    INSTANTIATE_TEST_COMPONENT_TRANSPORTS(ClassName) \
+    template class ClassName<RecordingTransport<WinSockTransport>>
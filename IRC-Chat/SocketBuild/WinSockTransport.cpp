@@ -0,0 +1,198 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file WinSockTransport.cpp
+ * @brief WinSockTransport.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "WinSockTransport.h"
+#include "DebugHelper.h"
+#include <WS2tcpip.h>
+
+WinSockTransport::WinSockTransport()
+{
+    LOG_DEBUG("WinSockTransport 객체를 생성합니다.");
+}
+
+WinSockTransport::~WinSockTransport()
+{
+    LOG_DEBUG("WinSockTransport 객체를 삭제합니다.");
+}
+
+SOCKET WinSockTransport::createSocket()
+{
+    // IPv4, TCP 스트림 소켓을 생성합니다.
+    return (socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+}
+
+int WinSockTransport::bindSocket(SOCKET socket, int port)
+{
+    sockaddr_in server_addr = {};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_addr.s_addr = INADDR_ANY;
+    server_addr.sin_port = htons(port);
+
+    return (bind(socket, (sockaddr*)&server_addr, sizeof(server_addr)));
+}
+
+int WinSockTransport::listenSocket(SOCKET socket)
+{
+    return (listen(socket, SOMAXCONN));
+}
+
+SOCKET WinSockTransport::acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr)
+{
+    int addr_len = sizeof(sockaddr_in);
+    SOCKET client_socket = accept(listen_socket, (sockaddr*)client_addr, &addr_len);
+    if (client_socket == INVALID_SOCKET)
+    {
+        return (INVALID_SOCKET);
+    }
+
+    // 느린 수신자 하나가 서버 루프의 send를 막지 않도록 논블로킹으로 바꿉니다.
+    // 송신 버퍼가 가득 차면 send는 WSAEWOULDBLOCK을 돌려주고, 남은 부분은 MessageSender가 다음 flush에서 보냅니다.
+    u_long non_blocking = 1;
+    if (ioctlsocket(client_socket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        closesocket(client_socket);
+        return (INVALID_SOCKET);
+    }
+    return (client_socket);
+}
+
+int WinSockTransport::connectSocket(SOCKET socket, const char* host, int port)
+{
+    sockaddr_in remote_addr = {};
+    remote_addr.sin_family = AF_INET;
+    remote_addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &remote_addr.sin_addr) != 1)
+    {
+        WSASetLastError(WSAEINVAL);
+        return (SOCKET_ERROR);
+    }
+
+    return (connect(socket, (sockaddr*)&remote_addr, sizeof(remote_addr)));
+}
+
+int WinSockTransport::startConnect(SOCKET socket, const char* host, int port)
+{
+    u_long non_blocking = 1;
+    if (ioctlsocket(socket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        return (SOCKET_ERROR);
+    }
+
+    // 논블로킹 소켓의 connect는 연결을 기다리지 않고 WSAEWOULDBLOCK으로 돌아옵니다.
+    return (this->connectSocket(socket, host, port));
+}
+
+int WinSockTransport::getConnectResult(SOCKET socket)
+{
+    int connect_error = 0;
+    int option_length = sizeof(connect_error);
+    if (getsockopt(socket, SOL_SOCKET, SO_ERROR, (char*)&connect_error, &option_length) == SOCKET_ERROR)
+    {
+        return (WSAGetLastError());
+    }
+    return (connect_error);
+}
+
+int WinSockTransport::sendBytes(SOCKET socket, const char* data, int length)
+{
+    return (send(socket, data, length, 0));
+}
+
+int WinSockTransport::receiveBytes(SOCKET socket, char* buffer, int length)
+{
+    return (recv(socket, buffer, length, 0));
+}
+
+int WinSockTransport::selectReadable(fd_set* read_set, int timeout_ms)
+{
+    timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+
+    // Windows에서는 select함수의 첫번 째 매개변수가 무시됩니다.
+    return (select(0, read_set, nullptr, nullptr, &timeout));
+}
+
+int WinSockTransport::selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms)
+{
+    timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+
+    // 연결에 실패한 소켓은 쓰기가 아니라 예외 집합에 표시되므로 같은 소켓을 예외 집합으로도 감시합니다.
+    fd_set error_set = *write_set;
+    int ready_count = select(0, read_set, write_set, &error_set, &timeout);
+    if (ready_count > 0)
+    {
+        for (unsigned int i = 0; i < error_set.fd_count; ++i)
+        {
+            FD_SET(error_set.fd_array[i], write_set);
+        }
+    }
+    return (ready_count);
+}
+
+int WinSockTransport::getPendingBytes(SOCKET socket)
+{
+    u_long pending_bytes = 0;
+    if (ioctlsocket(socket, FIONREAD, &pending_bytes) == SOCKET_ERROR)
+    {
+        return (SOCKET_ERROR);
+    }
+    return ((int)pending_bytes);
+}
+
+SOCKET WinSockTransport::createDatagramSocket()
+{
+    // IPv4, UDP 소켓을 생성하고 수신이 막히지 않도록 논블로킹으로 바꿉니다.
+    SOCKET datagram_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (datagram_socket == INVALID_SOCKET)
+    {
+        return (INVALID_SOCKET);
+    }
+
+    u_long non_blocking = 1;
+    if (ioctlsocket(datagram_socket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        closesocket(datagram_socket);
+        return (INVALID_SOCKET);
+    }
+    return (datagram_socket);
+}
+
+int WinSockTransport::receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr)
+{
+    int addr_len = sizeof(sockaddr_in);
+    return (recvfrom(socket, buffer, length, 0, (sockaddr*)from_addr, &addr_len));
+}
+
+int WinSockTransport::sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr)
+{
+    return (sendto(socket, data, length, 0, (const sockaddr*)&to_addr, sizeof(sockaddr_in)));
+}
+
+int WinSockTransport::closeSocket(SOCKET socket)
+{
+    return (closesocket(socket));
+}
+
+int WinSockTransport::getLastError() const
+{
+    return (WSAGetLastError());
+}
+
+NetworkTransport::Clock::time_point WinSockTransport::now() const
+{
+    return (NetworkTransport::Clock::now());
+}
+
+void WinSockTransport::sleepMillis(int timeout_ms)
+{
+    Sleep(timeout_ms);
+}
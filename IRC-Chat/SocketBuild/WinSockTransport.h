@@ -0,0 +1,68 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file WinSockTransport.h
+ * @brief WinSock 함수를 그대로 호출하는 WinSockTransport 클래스를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 실제 서버에서 사용하는 NetworkTransport 구현입니다.
+ * <br>각 함수는 대응하는 WinSock 함수를 한 번 호출하고 결과를 그대로 반환합니다.
+ */
+
+#include "NetworkTransport.h"
+
+/**
+ * @class WinSockTransport
+ * @brief WinSock 기반 NetworkTransport 구현입니다.
+ *
+ * @note WSAStartup은 SocketIniter가 담당하므로 이 클래스는 초기화/정리를 하지 않습니다.
+ */
+class WinSockTransport final : public NetworkTransport
+{
+public:
+    /**
+     * @fn WinSockTransport::WinSockTransport()
+     * @brief WinSockTransport 객체를 생성합니다.
+     * @return 없음.
+     */
+    WinSockTransport();
+
+    /**
+     * @fn WinSockTransport::~WinSockTransport()
+     * @brief 소멸자.
+     * @return 없음.
+     */
+    ~WinSockTransport() override;
+
+    // 복사 생성자 및 복사 할당 연산자 삭제.
+    WinSockTransport(const WinSockTransport& obj) = delete;
+    WinSockTransport& operator=(const WinSockTransport& obj) = delete;
+
+    // 이동 생성자 및 이동 할당 연산자 삭제.
+    WinSockTransport(WinSockTransport&& obj) = delete;
+    WinSockTransport& operator=(WinSockTransport&& obj) = delete;
+
+public:
+    SOCKET createSocket() override;
+    int bindSocket(SOCKET socket, int port) override;
+    int listenSocket(SOCKET socket) override;
+    SOCKET acceptSocket(SOCKET listen_socket, sockaddr_in* client_addr) override;
+    int connectSocket(SOCKET socket, const char* host, int port) override;
+    int startConnect(SOCKET socket, const char* host, int port) override;
+    int getConnectResult(SOCKET socket) override;
+    int sendBytes(SOCKET socket, const char* data, int length) override;
+    int receiveBytes(SOCKET socket, char* buffer, int length) override;
+    int selectReadable(fd_set* read_set, int timeout_ms) override;
+    int selectSockets(fd_set* read_set, fd_set* write_set, int timeout_ms) override;
+    int getPendingBytes(SOCKET socket) override;
+    SOCKET createDatagramSocket() override;
+    int receiveDatagram(SOCKET socket, char* buffer, int length, sockaddr_in* from_addr) override;
+    int sendDatagram(SOCKET socket, const char* data, int length, const sockaddr_in& to_addr) override;
+    int closeSocket(SOCKET socket) override;
+    int getLastError() const override;
+    NetworkTransport::Clock::time_point now() const override;
+    void sleepMillis(int timeout_ms) override;
+};
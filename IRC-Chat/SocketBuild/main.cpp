@@ -10,11 +10,31 @@
 #include "DebugHelper.h"
 #include "MemoryLeakHelper.h"
 #include "Program.h"
+#include "TraceRecorder.h"
 #include <Windows.h>
 #include <io.h>
 #include <fcntl.h>
 
-int main()
+#ifdef ENABLE_TRACE
+/**
+ * @fn BOOL WINAPI trace_console_handler(DWORD control_type)
+ * @brief Ctrl+Break 입력 시 트레이스 덤프를 요청하는 콘솔 제어 처리기입니다.
+ * @param[IN] DWORD control_type : 콘솔 제어 이벤트 종류.
+ * @return BOOL : 처리했으면 TRUE (프로그램을 종료하지 않음), 아니면 FALSE.
+ * @note 처리기는 별도 스레드에서 불리므로 플래그만 세우고, 실제 저장은 서버 루프가 합니다.
+ */
+static BOOL WINAPI trace_console_handler(DWORD control_type)
+{
+	if (control_type == CTRL_BREAK_EVENT)
+	{
+		TRACE_REQUEST_DUMP();
+		return (TRUE);
+	}
+	return (FALSE);
+}
+#endif
+
+int main(int argc, char* argv[])
 {
 	// 콘솔 입출력 인코딩을 UTF-8로 설정.
 	SetConsoleOutputCP(CP_UTF8);
@@ -23,12 +43,28 @@ int main()
 	// 프로그램 종료 시 메모리 릭을 체크합니다.
 	RUN_MEMORY_LEAK_CHECK;
 
+#ifdef ENABLE_TRACE
+	// Ctrl+Break로 실행 중에 트레이스를 저장할 수 있게 합니다.
+	SetConsoleCtrlHandler(trace_console_handler, TRUE);
+#endif
+
 	LOG_INFO("프로그램을 시작합니다.");
 
-	Program TCPServer;
+	// server.cfg와 "--키 값" 인자로 실행 옵션을 읽습니다.
+	ServerConfig config;
+	if (config.load(argc, argv) != ServerConfig::Result::SUCCESS)
+	{
+		LOG_ERROR("설정을 읽지 못해 프로그램을 종료합니다.");
+		return (-1);
+	}
+
+	Program TCPServer(config);
 	
 	int result = TCPServer.run();
 
+	// 종료 시 트레이스 저장 (ENABLE_TRACE 빌드에서만 동작).
+	TRACE_DUMP();
+
 	LOG_INFO("프로그램을 종료합니다.");
 
 	return (result);
@@ -0,0 +1,180 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ClientStorageTests.cpp
+ * @brief ClientManager의 구조체 배열(SoA) 저장소 스캔을 검사하고, 세션 객체 배열(AoS)과 전체 표 훑기 비용을 비교합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "ClientManager.h"
+#include "SimulatedTransport.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief SoA로 나누기 전의 세션 객체 하나. 비교용으로 ClientManager와 같은 필드를 한 구조체에 둡니다.
+ */
+struct FatSession
+{
+    SOCKET socket;                  ///< 소켓.
+    std::uint8_t stateFlags;        ///< 상태 플래그.
+    std::int64_t lastActivityTick;  ///< 마지막 활동 시각.
+    std::int32_t tokenCount;        ///< 속도 제한 토큰 수.
+    std::int32_t queueDepth;        ///< 송신 대기 큐 깊이.
+    std::string nickname;           ///< 별칭.
+    sockaddr_in address;            ///< 주소.
+};
+
+TEST_CASE(clientManagerSweepsReadHotArrays)
+{
+    SimulatedTransport transport;
+    std::unique_ptr<ClientManager<SimulatedTransport>> client_manager = std::make_unique<ClientManager<SimulatedTransport>>(transport);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(client_manager->addClient((SOCKET)(100 + i)) == i);
+        client_manager->touchActivity(i, (i < 3) ? 0 : 1000);
+    }
+    client_manager->addQueueDepth(5, 40);
+
+    int indices[ClientManagerBase::MAX_CLIENTS];
+    CHECK(client_manager->collectIdleClients(1500, 1000, indices, ClientManagerBase::MAX_CLIENTS) == 3);
+    CHECK(indices[0] == 0 && indices[2] == 2);
+    CHECK(client_manager->collectBackloggedClients(32, indices, ClientManagerBase::MAX_CLIENTS) == 1);
+    CHECK(indices[0] == 5);
+
+    // 충전은 최대치에서 멈추고, 소비는 토큰이 있을 때만 성공합니다.
+    client_manager->refillTokens(3, 2);
+    CHECK(client_manager->consumeToken(0));
+    CHECK(client_manager->consumeToken(0));
+    CHECK(client_manager->consumeToken(0) == false);
+}
+
+BENCHMARK_CASE(benchmarkSessionTableSweeps)
+{
+    const int TARGET_COUNTS[] = { 1000, 10000, 100000 };
+    const int REPEAT = 50;
+
+    for (int target_count : TARGET_COUNTS)
+    {
+        // SoA: MAX_CLIENTS 크기의 ClientManager를 이어 붙입니다. 스캔은 빈 슬롯도 읽으므로 세션 수를 MAX_CLIENTS 단위로 올립니다.
+        int session_count = ((target_count + ClientManagerBase::MAX_CLIENTS - 1) / ClientManagerBase::MAX_CLIENTS) * ClientManagerBase::MAX_CLIENTS;
+        SimulatedTransport transport;
+        std::vector<std::unique_ptr<ClientManager<SimulatedTransport>>> managers;
+        for (int added = 0; added < session_count; added = added + ClientManagerBase::MAX_CLIENTS)
+        {
+            managers.push_back(std::make_unique<ClientManager<SimulatedTransport>>(transport));
+            for (int i = 0; i < ClientManagerBase::MAX_CLIENTS && added + i < session_count; ++i)
+            {
+                managers.back()->addClient((SOCKET)(added + i + 1));
+                managers.back()->touchActivity(i, (added + i) % 100);
+                managers.back()->addQueueDepth(i, (added + i) % 64);
+            }
+        }
+
+        std::vector<FatSession> sessions((std::size_t)session_count);
+        for (int i = 0; i < session_count; ++i)
+        {
+            sessions[i].socket = (SOCKET)(i + 1);
+            sessions[i].stateFlags = ClientManagerBase::FLAG_CONNECTED;
+            sessions[i].lastActivityTick = i % 100;
+            sessions[i].tokenCount = 0;
+            sessions[i].queueDepth = i % 64;
+            sessions[i].nickname = "Player_" + std::to_string(i);
+            sessions[i].address = {};
+        }
+
+        std::vector<int> indices((std::size_t)session_count);
+        long long found = 0;
+
+        // 유휴 세션 찾기: 상태 플래그와 마지막 활동 시각만 읽습니다.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            for (const std::unique_ptr<ClientManager<SimulatedTransport>>& manager : managers)
+            {
+                found = found + manager->collectIdleClients(100 + r, 60, indices.data(), ClientManagerBase::MAX_CLIENTS);
+            }
+        }
+        double soa_idle = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            int count = 0;
+            for (int i = 0; i < session_count; ++i)
+            {
+                if ((sessions[i].stateFlags & ClientManagerBase::FLAG_CONNECTED) != 0 && 100 + r - sessions[i].lastActivityTick >= 60)
+                {
+                    indices[count] = i;
+                    count = count + 1;
+                }
+            }
+            found = found - count;
+        }
+        double aos_idle = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        // 토큰 충전: 토큰 배열만 읽고 씁니다.
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            for (const std::unique_ptr<ClientManager<SimulatedTransport>>& manager : managers)
+            {
+                manager->refillTokens(1, 20);
+            }
+        }
+        double soa_refill = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            for (FatSession& session : sessions)
+            {
+                std::int32_t tokens = session.tokenCount + 1;
+                session.tokenCount = (tokens < 20) ? tokens : 20;
+            }
+        }
+        double aos_refill = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        // 송신 대기열이 밀린 세션 찾기: 큐 깊이 배열만 읽습니다.
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            for (const std::unique_ptr<ClientManager<SimulatedTransport>>& manager : managers)
+            {
+                found = found + manager->collectBackloggedClients(60, indices.data(), ClientManagerBase::MAX_CLIENTS);
+            }
+        }
+        double soa_backlog = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; ++r)
+        {
+            int count = 0;
+            for (int i = 0; i < session_count; ++i)
+            {
+                if (sessions[i].queueDepth > 60)
+                {
+                    indices[count] = i;
+                    count = count + 1;
+                }
+            }
+            found = found - count;
+        }
+        double aos_backlog = elapsedNanoseconds(start) / ((double)session_count * REPEAT);
+
+        // 두 방식이 같은 세션을 찾아야 합니다.
+        CHECK(found == 0);
+
+        std::string label = "sessions=" + std::to_string(session_count);
+        test_context.report(label + " idle SoA", soa_idle, "ns/session");
+        test_context.report(label + " idle AoS", aos_idle, "ns/session");
+        test_context.report(label + " refill SoA", soa_refill, "ns/session");
+        test_context.report(label + " refill AoS", aos_refill, "ns/session");
+        test_context.report(label + " backlog SoA", soa_backlog, "ns/session");
+        test_context.report(label + " backlog AoS", aos_backlog, "ns/session");
+    }
+}
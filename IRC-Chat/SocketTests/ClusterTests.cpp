@@ -0,0 +1,523 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ClusterTests.cpp
+ * @brief 여러 서버 프로세스를 루프백으로 묶은 클러스터에서 노드 간 채팅 중계와 채팅방 주인의 순번 매기기, 재배치 중 끊김을 검사하고,
+ * <br>노드 수에 따른 지연과 처리량을 측정합니다. 응답하지 않거나 거절하는 노드에 대한 링크 연결이 서버 루프를 막지 않는지도 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "LoopbackCluster.h"
+#include "TestUtility.h"
+#include "ClusterRelay.h"
+#include "HashRing.h"
+#include "MultiServer.h"
+#include "SelectManager.h"
+#include "SimulatedTransport.h"
+#include "SocketIniter.h"
+#include <algorithm>
+#include <cstdlib>
+
+/// 노드 프로세스가 뜨고 입장을 마칠 때까지의 최대 대기 시간.
+static const int JOIN_TIMEOUT_MS = 5000;
+
+/// 노드 간 링크가 모두 이어질 때까지의 최대 대기 시간. (재연결 주기 ClusterRelayBase::RECONNECT_INTERVAL_MS의 몇 배)
+static const int MESH_TIMEOUT_MS = 10000;
+
+/**
+ * @brief 노드마다 클라이언트 하나씩 접속해 입장합니다.
+ * @return bool : 모두 시간 안에 입장했으면 true.
+ */
+static bool joinEveryNode(const LoopbackCluster& cluster, std::vector<std::unique_ptr<LoopbackClient>>& clients, int node_count)
+{
+    for (int node = 0; node < node_count; ++node)
+    {
+        if (clients[node]->connectAndJoin(cluster.getChatPort(node), JOIN_TIMEOUT_MS) == false)
+        {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/**
+ * @brief 모든 클라이언트가 모든 노드의 "probe <노드>" 줄을 받을 때까지 probe를 다시 보냅니다.
+ * @return bool : 시간 안에 모든 링크로 채팅이 오갔으면 true.
+ * @note 링크는 큰 클러스터 포트 쪽이 거는데, 상대가 아직 listen하지 않았으면 재연결 주기만큼 늦어집니다.
+ */
+static bool waitForMesh(std::vector<LoopbackClient*>& clients)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MESH_TIMEOUT_MS);
+    std::chrono::steady_clock::time_point next_probe = std::chrono::steady_clock::now();
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (std::chrono::steady_clock::now() >= next_probe)
+        {
+            for (std::size_t i = 0; i < clients.size(); ++i)
+            {
+                clients[i]->sendLine("probe " + std::to_string(i));
+            }
+            next_probe = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+        }
+        LoopbackClient::receiveAny(clients, 50);
+
+        bool complete = true;
+        for (LoopbackClient* client : clients)
+        {
+            for (std::size_t i = 0; i < clients.size() && complete; ++i)
+            {
+                std::string needle = "]: probe " + std::to_string(i);
+                complete = std::any_of(client->getLines().begin(), client->getLines().end(),
+                    [&needle](const std::string& line) { return (line.find(needle) != std::string::npos); });
+            }
+        }
+        if (complete)
+        {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/**
+ * @struct SequencedChat
+ * @brief "#<순번> [닉네임]: 본문" 줄에서 꺼낸 순번과 본문.
+ */
+struct SequencedChat
+{
+    std::uint64_t sequence;     ///< 채팅방 순번.
+    std::string text;           ///< ": " 뒤의 본문.
+    std::size_t lineIndex;      ///< 받은 줄 목록에서의 위치 (도착 시각 조회용).
+};
+
+/**
+ * @brief 받은 줄 중 본문이 prefix로 시작하는 채팅만 받은 순서대로 꺼냅니다.
+ */
+static std::vector<SequencedChat> collectChats(const LoopbackClient& client, const std::string& prefix)
+{
+    std::vector<SequencedChat> chats;
+    const std::vector<std::string>& lines = client.getLines();
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        std::size_t body = lines[i].find("]: " + prefix);
+        if (lines[i].empty() || lines[i][0] != '#' || body == std::string::npos)
+        {
+            continue;
+        }
+        SequencedChat chat = {};
+        chat.sequence = std::strtoull(lines[i].c_str() + 1, nullptr, 10);
+        chat.text = lines[i].substr(body + 3);
+        chat.lineIndex = i;
+        chats.push_back(chat);
+    }
+    return (chats);
+}
+
+TEST_CASE(clusterRelaysChatAcrossProcesses)
+{
+    const int NODE_COUNT = 3;
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    LoopbackCluster cluster(NODE_COUNT);
+    std::vector<std::unique_ptr<LoopbackClient>> clients;
+    std::vector<LoopbackClient*> client_list;
+    for (int node = 0; node < NODE_COUNT; ++node)
+    {
+        REQUIRE(cluster.startNode(node));
+        clients.push_back(std::make_unique<LoopbackClient>(transport));
+        client_list.push_back(clients.back().get());
+    }
+    REQUIRE(joinEveryNode(cluster, clients, NODE_COUNT));
+    REQUIRE(waitForMesh(client_list));
+
+    // 각 노드의 접속자가 보낸 줄을 모든 노드의 접속자가 받습니다.
+    for (int node = 0; node < NODE_COUNT; ++node)
+    {
+        CHECK(clients[node]->sendLine("hello from node " + std::to_string(node)));
+    }
+    for (int receiver = 0; receiver < NODE_COUNT; ++receiver)
+    {
+        for (int sender = 0; sender < NODE_COUNT; ++sender)
+        {
+            CHECK(clients[receiver]->waitForLine("]: hello from node " + std::to_string(sender), 3000));
+        }
+    }
+
+    // 노드 하나가 죽어도 남은 노드끼리는 계속 중계합니다.
+    // (죽은 노드가 로비의 주인이었다면 장애를 알아채기 전에 보낸 줄은 잃을 수 있으므로, 받을 때까지 다시 보냅니다.)
+    cluster.terminateNode(NODE_COUNT - 1);
+    bool relayed = false;
+    for (int attempt = 0; attempt < 25 && relayed == false; ++attempt)
+    {
+        CHECK(clients[0]->sendLine("after failure"));
+        relayed = clients[1]->waitForLine("]: after failure", 200);
+    }
+    CHECK(relayed);
+}
+
+BENCHMARK_CASE(benchmarkClusterDeliveryByNodeCount)
+{
+    const int NODE_COUNTS[] = { 2, 4, 8 };
+    const int LATENCY_SAMPLES = 200;
+    const int BURST_LINES = 300;
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    for (int node_count : NODE_COUNTS)
+    {
+        LoopbackCluster cluster(node_count);
+        std::vector<std::unique_ptr<LoopbackClient>> clients;
+        std::vector<LoopbackClient*> client_list;
+        for (int node = 0; node < node_count; ++node)
+        {
+            REQUIRE(cluster.startNode(node));
+            clients.push_back(std::make_unique<LoopbackClient>(transport));
+            client_list.push_back(clients.back().get());
+        }
+        REQUIRE(joinEveryNode(cluster, clients, node_count));
+        REQUIRE(waitForMesh(client_list));
+
+        // 노드 간 지연: 첫 노드의 접속자가 한 줄을 보내고 마지막 노드의 접속자가 받을 때까지.
+        std::vector<double> latencies_us;
+        LoopbackClient& first = *clients.front();
+        LoopbackClient& last = *clients.back();
+        for (int sample = 0; sample < LATENCY_SAMPLES; ++sample)
+        {
+            std::string line = "latency " + std::to_string(sample);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            REQUIRE(first.sendLine(line));
+            REQUIRE(last.waitForLine("]: " + line, 3000));
+            latencies_us.push_back(std::chrono::duration<double, std::micro>(last.getArrivalTimes().back() - start).count());
+        }
+        std::sort(latencies_us.begin(), latencies_us.end());
+
+        // 합계 처리량: 모든 접속자가 한꺼번에 BURST_LINES줄씩 보내고, 모든 접속자가 전부 받을 때까지.
+        std::vector<std::size_t> scanned(node_count);
+        std::vector<int> burst_received(node_count, 0);
+        for (int node = 0; node < node_count; ++node)
+        {
+            scanned[node] = clients[node]->getLines().size();
+        }
+        std::chrono::steady_clock::time_point burst_start = std::chrono::steady_clock::now();
+        for (int line = 0; line < BURST_LINES; ++line)
+        {
+            for (int node = 0; node < node_count; ++node)
+            {
+                clients[node]->sendLine("burst " + std::to_string(node) + " " + std::to_string(line));
+            }
+        }
+
+        int expected = node_count * BURST_LINES;
+        std::chrono::steady_clock::time_point deadline = burst_start + std::chrono::seconds(30);
+        bool all_received = false;
+        while (all_received == false && std::chrono::steady_clock::now() < deadline)
+        {
+            LoopbackClient::receiveAny(client_list, 50);
+            all_received = true;
+            for (int node = 0; node < node_count; ++node)
+            {
+                const std::vector<std::string>& lines = clients[node]->getLines();
+                for (; scanned[node] < lines.size(); ++scanned[node])
+                {
+                    if (lines[scanned[node]].find("]: burst ") != std::string::npos)
+                    {
+                        burst_received[node] = burst_received[node] + 1;
+                    }
+                }
+                all_received = all_received && (burst_received[node] >= expected);
+            }
+        }
+        double burst_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - burst_start).count();
+        CHECK(all_received);
+
+        std::string label = "nodes=" + std::to_string(node_count);
+        test_context.report(label + " cross-node latency p50", latencies_us[LATENCY_SAMPLES / 2], "us");
+        test_context.report(label + " cross-node latency p99", latencies_us[LATENCY_SAMPLES * 99 / 100], "us");
+        test_context.report(label + " aggregate deliveries", (double)expected * node_count / burst_seconds, "lines/s");
+    }
+}
+
+TEST_CASE(clusterNodesAgreeOnRoomSequence)
+{
+    const int NODE_COUNT = 3;
+    const int LINES_PER_NODE = 50;
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    LoopbackCluster cluster(NODE_COUNT);
+    std::vector<std::unique_ptr<LoopbackClient>> clients;
+    std::vector<LoopbackClient*> client_list;
+    for (int node = 0; node < NODE_COUNT; ++node)
+    {
+        REQUIRE(cluster.startNode(node));
+        clients.push_back(std::make_unique<LoopbackClient>(transport));
+        client_list.push_back(clients.back().get());
+    }
+    REQUIRE(joinEveryNode(cluster, clients, NODE_COUNT));
+    REQUIRE(waitForMesh(client_list));
+
+    // 세 노드의 접속자가 동시에 보내, 주인 노드가 아닌 곳의 채팅은 주인을 거쳐 순번을 받습니다.
+    for (int line = 0; line < LINES_PER_NODE; ++line)
+    {
+        for (int node = 0; node < NODE_COUNT; ++node)
+        {
+            clients[node]->sendLine("order " + std::to_string(node) + " " + std::to_string(line));
+        }
+    }
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    bool all_received = false;
+    while (all_received == false && std::chrono::steady_clock::now() < deadline)
+    {
+        LoopbackClient::receiveAny(client_list, 50);
+        all_received = true;
+        for (LoopbackClient* client : client_list)
+        {
+            all_received = all_received && ((int)collectChats(*client, "order ").size() >= NODE_COUNT * LINES_PER_NODE);
+        }
+    }
+    REQUIRE(all_received);
+
+    // 모든 노드가 같은 순번, 같은 순서로 받고, 순번은 빠짐없이 1씩 늘어납니다.
+    std::vector<SequencedChat> reference = collectChats(*clients[0], "order ");
+    for (std::size_t i = 1; i < reference.size(); ++i)
+    {
+        CHECK(reference[i].sequence == reference[i - 1].sequence + 1);
+    }
+    for (int node = 1; node < NODE_COUNT; ++node)
+    {
+        std::vector<SequencedChat> chats = collectChats(*clients[node], "order ");
+        REQUIRE(chats.size() == reference.size());
+        for (std::size_t i = 0; i < chats.size(); ++i)
+        {
+            CHECK(chats[i].sequence == reference[i].sequence);
+            CHECK(chats[i].text == reference[i].text);
+        }
+    }
+}
+
+TEST_CASE(clusterRebalanceMovesRoomInOrder)
+{
+    const int TICK_INTERVAL_MS = 5;
+    const int JOIN_AT_MS = 500;
+    const int CRASH_AT_MS = 3500;
+    const int END_AT_MS = 6000;
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    // 세 번째 노드가 들어오면 로비의 주인이 그 노드로 옮겨 가도록 클러스터 포트를 고릅니다.
+    // 기존 두 노드의 포트도 매번 다시 고릅니다. 고정해 두면 로비 바로 앞의 점이 가까울 때 어떤 후보도 로비를 가져가지 못합니다.
+    LoopbackCluster cluster(3);
+    HashRing after;
+    bool ports_chosen = false;
+    for (int attempt = 0; attempt < 100 && ports_chosen == false; ++attempt)
+    {
+        int ports[3] = { reserveLoopbackPort(), reserveLoopbackPort(), reserveLoopbackPort() };
+        if (ports[0] == ports[1] || ports[1] == ports[2] || ports[0] == ports[2])
+        {
+            continue;
+        }
+
+        after.setNodes({ ports[0], ports[1], ports[2] });
+        if (after.findOwner(MultiServerBase::LOBBY_ROOM_ID) == ports[2])
+        {
+            for (int node = 0; node < 3; ++node)
+            {
+                cluster.setClusterPort(node, ports[node]);
+            }
+            ports_chosen = true;
+        }
+    }
+    REQUIRE(ports_chosen);
+
+    REQUIRE(cluster.startNode(0));
+    REQUIRE(cluster.startNode(1));
+    std::vector<std::unique_ptr<LoopbackClient>> clients;
+    clients.push_back(std::make_unique<LoopbackClient>(transport));
+    clients.push_back(std::make_unique<LoopbackClient>(transport));
+    std::vector<LoopbackClient*> client_list = { clients[0].get(), clients[1].get() };
+    REQUIRE(joinEveryNode(cluster, clients, 2));
+    REQUIRE(waitForMesh(client_list));
+
+    // 노드 2도 등록되어 있으므로 노드 0과 1은 READY_GRACE_MS가 지나야 링에 들어갑니다. 그 전까지는 각자 혼자인 링입니다.
+    std::chrono::steady_clock::time_point ring_formed = std::chrono::steady_clock::now() + std::chrono::milliseconds(ClusterRelayBase::READY_GRACE_MS);
+    while (std::chrono::steady_clock::now() < ring_formed)
+    {
+        LoopbackClient::receiveAny(client_list, 50);
+    }
+
+    // 노드 0의 접속자가 5ms마다 한 줄씩 보내는 동안, 노드 2가 들어와 로비를 넘겨받고 나중에 강제로 죽습니다.
+    LoopbackClient& sender = *clients[0];
+    LoopbackClient& observer = *clients[1];
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int tick = 0;
+    int crash_tick = -1;
+    bool joined = false;
+    while (true)
+    {
+        long long elapsed_ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed_ms >= END_AT_MS)
+        {
+            break;
+        }
+        if (joined == false && elapsed_ms >= JOIN_AT_MS)
+        {
+            REQUIRE(cluster.startNode(2));
+            joined = true;
+        }
+        if (crash_tick < 0 && elapsed_ms >= CRASH_AT_MS)
+        {
+            cluster.terminateNode(2);
+            crash_tick = tick;
+        }
+        if (elapsed_ms >= (long long)tick * TICK_INTERVAL_MS)
+        {
+            sender.sendLine("tick " + std::to_string(tick));
+            tick = tick + 1;
+        }
+        LoopbackClient::receiveAny(client_list, 1);
+    }
+    observer.waitForLine("]: tick " + std::to_string(tick - 1), 3000);
+
+    // 순번과 보낸 순서는 넘겨주기와 장애 조치를 거쳐도 뒤바뀌거나 겹치지 않습니다.
+    std::vector<SequencedChat> chats = collectChats(observer, "tick ");
+    REQUIRE(chats.empty() == false);
+    std::vector<int> ticks;
+    for (std::size_t i = 0; i < chats.size(); ++i)
+    {
+        ticks.push_back(std::atoi(chats[i].text.c_str() + 5));
+        if (i > 0)
+        {
+            CHECK(chats[i].sequence > chats[i - 1].sequence);
+            CHECK(ticks[i] > ticks[i - 1]);
+        }
+    }
+
+    // 정상적인 넘겨주기(노드 합류)에서는 잃는 줄이 없습니다. 장애 조치 중에는 주인에게 가던 줄을 잃을 수 있으므로,
+    // 죽기 직전 0.5초 동안 보낸 줄은 장애 구간으로 셉니다.
+    int settled_tick = crash_tick - 500 / TICK_INTERVAL_MS;
+    int received_settled = (int)std::count_if(ticks.begin(), ticks.end(), [settled_tick](int value) { return (value < settled_tick); });
+    int received_after_settled = (int)ticks.size() - received_settled;
+    CHECK(received_settled == settled_tick);
+
+    // 끊김 구간: 연속한 두 줄 사이의 가장 긴 도착 간격.
+    const std::vector<std::chrono::steady_clock::time_point>& arrivals = observer.getArrivalTimes();
+    double join_gap_ms = 0.0;
+    double crash_gap_ms = 0.0;
+    for (std::size_t i = 1; i < chats.size(); ++i)
+    {
+        double gap_ms = std::chrono::duration<double, std::milli>(arrivals[chats[i].lineIndex] - arrivals[chats[i - 1].lineIndex]).count();
+        if (ticks[i] < settled_tick)
+        {
+            join_gap_ms = std::max(join_gap_ms, gap_ms);
+        }
+        else
+        {
+            crash_gap_ms = std::max(crash_gap_ms, gap_ms);
+        }
+    }
+    test_context.report("join handoff worst gap", join_gap_ms, "ms");
+    test_context.report("owner crash worst gap", crash_gap_ms, "ms");
+    test_context.report("lines lost during owner crash", (double)(tick - settled_tick - received_after_settled), "lines");
+}
+
+TEST_CASE(clusterLinkConnectDoesNotWaitForRefusingPeer)
+{
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    // 더 큰 클러스터 포트 쪽이 연결하므로, 아무도 리슨하지 않는 더 작은 포트를 상대로 등록합니다.
+    int first_port = reserveLoopbackPort();
+    int second_port = reserveLoopbackPort();
+    int peer_port = std::min(first_port, second_port);
+    int local_port = std::max(first_port, second_port);
+
+    ClusterRelay relay(transport);
+    relay.addPeer("127.0.0.1", peer_port);
+    REQUIRE(relay.open(local_port) == ClusterRelayBase::Result::SUCCESS);
+
+    // 연결을 시작만 하고 바로 돌아옵니다. (Windows의 블로킹 connect는 거절된 루프백 연결에도 SYN 재전송으로 약 2초를 기다립니다.)
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    relay.maintainLinks();
+    double maintain_ms = elapsedNanoseconds(start) / 1000000.0;
+    CHECK(maintain_ms < 100.0);
+    CHECK(relay.getLinkCount() == 0);
+
+    // 서버 루프처럼 select의 쓰기 집합으로 연결이 끝나기를 기다리면 실패로 끝나고 소켓을 닫습니다.
+    SelectManager select_manager(transport);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ClusterRelayBase::CONNECT_TIMEOUT_MS + 1000);
+    while (relay.getConnectingCount() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        SOCKET connecting_sockets[ClusterRelayBase::MAX_LINKS];
+        int connecting_count = relay.getConnectingSockets(connecting_sockets, ClusterRelayBase::MAX_LINKS);
+        select_manager.setupFdSet();
+        select_manager.addSocket(relay.getListenSocket());
+        for (int i = 0; i < connecting_count; ++i)
+        {
+            select_manager.addConnectingSocket(connecting_sockets[i]);
+        }
+        select_manager.executeSelectMillis(100);
+        for (int i = 0; i < connecting_count; ++i)
+        {
+            if (select_manager.isConnectDone(connecting_sockets[i]))
+            {
+                CHECK(relay.finishConnect(connecting_sockets[i]) == false);
+            }
+        }
+    }
+    CHECK(relay.getConnectingCount() == 0);
+    CHECK(relay.getLinkCount() == 0);
+}
+
+TEST_CASE(clusterLinkRetriesStalledPeerWhileServingClients)
+{
+    const int LOCAL_CLUSTER_PORT = 7001;
+    const int PEER_CLUSTER_PORT = 7000;
+
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+    transport.setConnectStalled(PEER_CLUSTER_PORT, true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::HANDLER);
+    server.enableCluster(LOCAL_CLUSTER_PORT);
+    server.addClusterPeer("127.0.0.1", PEER_CLUSTER_PORT);
+    SOCKET client_socket = transport.scheduleConnect(10);
+
+    // 상대가 응답하지 않는 동안에도 서버 루프는 새 접속자를 받아 환영 메시지를 보냅니다.
+    bool welcomed_while_stalled = false;
+    bool linked_while_stalled = true;
+    transport.scheduleCallback(100, [&transport, &welcomed_while_stalled, client_socket]()
+    {
+        welcomed_while_stalled = (transport.getCapturedOutput(client_socket).empty() == false);
+    });
+
+    // 처음 시작한 연결은 끝나지 않으므로 CONNECT_TIMEOUT_MS 뒤에 포기하고, 그때 다시 시도한 연결은 상대가 받아 줍니다.
+    transport.scheduleCallback(ClusterRelayBase::CONNECT_TIMEOUT_MS - 500, [&transport, &linked_while_stalled, PEER_CLUSTER_PORT]()
+    {
+        linked_while_stalled = (transport.findConnectedSocket(PEER_CLUSTER_PORT) != INVALID_SOCKET);
+        transport.setConnectStalled(PEER_CLUSTER_PORT, false);
+    });
+    transport.scheduleCallback(ClusterRelayBase::CONNECT_TIMEOUT_MS + 2000, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+
+    CHECK(welcomed_while_stalled);
+    CHECK(linked_while_stalled == false);
+
+    // 연결이 끝나면 링크로 등록되어 HELLO(본문 2바이트, 종류 1, 클러스터 포트)부터 보냅니다.
+    SOCKET link_socket = transport.findConnectedSocket(PEER_CLUSTER_PORT);
+    REQUIRE(link_socket != INVALID_SOCKET);
+    const std::string& link_output = transport.getCapturedOutput(link_socket);
+    const char hello[] = { 2, 0, (char)ClusterRelayBase::FrameType::HELLO, (char)(LOCAL_CLUSTER_PORT & 0xFF), (char)(LOCAL_CLUSTER_PORT >> 8) };
+    REQUIRE(link_output.size() >= sizeof(hello));
+    CHECK(link_output.compare(0, sizeof(hello), hello, sizeof(hello)) == 0);
+}
@@ -0,0 +1,276 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file CommandParserTests.cpp
+ * @brief CommandParser의 완전 해시 분기와 SWAR 이름 분리가 단순한 표 비교와 같은 결과를 내는지 검사하고, 파싱 비용을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "CommandParser.h"
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief 비교 기준으로 쓰는 명령 표. CommandParser.cpp의 표와 같은 내용을 유지합니다.
+ */
+struct ReferenceEntry
+{
+    std::string_view name;
+    CommandParser::Command command;
+    CommandParser::Arguments arguments;
+};
+
+static const ReferenceEntry REFERENCE_TABLE[] =
+{
+    { "quit",       CommandParser::Command::QUIT,        CommandParser::Arguments::NONE },
+    { "/users",     CommandParser::Command::USERS,       CommandParser::Arguments::NONE },
+    { "/pos",       CommandParser::Command::POS,         CommandParser::Arguments::REQUIRED },
+    { "/say",       CommandParser::Command::SAY,         CommandParser::Arguments::REQUIRED },
+    { "/status",    CommandParser::Command::STATUS,      CommandParser::Arguments::OPTIONAL },
+    { "/resume",    CommandParser::Command::RESUME,      CommandParser::Arguments::REQUIRED },
+    { "/ignore",    CommandParser::Command::IGNORE_USER, CommandParser::Arguments::REQUIRED },
+    { "/mute",      CommandParser::Command::MUTE_USER,   CommandParser::Arguments::REQUIRED },
+    { "/mod",       CommandParser::Command::MODERATOR,   CommandParser::Arguments::REQUIRED },
+    { "/top",       CommandParser::Command::TOP,         CommandParser::Arguments::OPTIONAL },
+    { "/roster",    CommandParser::Command::ROSTER,      CommandParser::Arguments::NONE },
+    { "/reload",    CommandParser::Command::RELOAD,      CommandParser::Arguments::NONE },
+};
+
+/**
+ * @brief 표를 처음부터 차례로 비교하는 단순한 파서. parse()의 기대값이자 성능 비교 기준입니다.
+ */
+static CommandParser::Command reference_parse(std::string_view line, std::string_view& arguments)
+{
+    arguments = std::string_view();
+    for (const ReferenceEntry& entry : REFERENCE_TABLE)
+    {
+        if (line.substr(0, entry.name.size()) != entry.name)
+        {
+            continue;
+        }
+        if (line.size() == entry.name.size())
+        {
+            return ((entry.arguments != CommandParser::Arguments::REQUIRED) ? entry.command : CommandParser::Command::CHAT);
+        }
+        if (line[entry.name.size()] == ' ')
+        {
+            if (entry.arguments == CommandParser::Arguments::NONE)
+            {
+                return (CommandParser::Command::CHAT);
+            }
+            arguments = line.substr(entry.name.size() + 1);
+            return (entry.command);
+        }
+    }
+    return (CommandParser::Command::CHAT);
+}
+
+/**
+ * @brief parse()와 reference_parse()의 명령과 인자가 모두 같은지 확인합니다.
+ */
+static bool matches_reference(std::string_view line)
+{
+    std::string_view arguments;
+    std::string_view expected_arguments;
+    CommandParser::Command command = CommandParser::parse(line, arguments);
+    CommandParser::Command expected = reference_parse(line, expected_arguments);
+    return (command == expected && arguments == expected_arguments && arguments.data() == expected_arguments.data());
+}
+
+TEST_CASE(commandParserDispatchesEveryTableEntry)
+{
+    for (const ReferenceEntry& entry : REFERENCE_TABLE)
+    {
+        std::string name(entry.name);
+        std::string_view arguments;
+
+        CommandParser::Command bare = CommandParser::parse(name, arguments);
+        CHECK(bare == ((entry.arguments != CommandParser::Arguments::REQUIRED) ? entry.command : CommandParser::Command::CHAT));
+        CHECK(arguments.empty());
+
+        std::string with_arguments = name + " Player_1 hello";
+        CommandParser::Command argued = CommandParser::parse(with_arguments, arguments);
+        CHECK(argued == ((entry.arguments != CommandParser::Arguments::NONE) ? entry.command : CommandParser::Command::CHAT));
+        if (argued != CommandParser::Command::CHAT)
+        {
+            CHECK(arguments == "Player_1 hello");
+        }
+    }
+}
+
+TEST_CASE(commandParserTreatsUnknownAndShortLinesAsChat)
+{
+    // 짧은 줄, 한 글자 차이, 접두어, 대소문자, 앞 공백, 이름 안의 '\0', 9바이트를 넘는 이름, 공백처럼 보이는 0xA0
+    const std::string LINES[] = {
+        "", "/", "q", "qu", "qui", "quit!", "quits", "Quit", " /users", "/user", "/usersx", "/users ",
+        "/USERS", "/po", "/pos", "/posx 1 2 3", "/sa", "/say", "/mo", "/modest proposal", "/mute",
+        "/reloads", "/reload now", "/roster on", "/ignorexy", "/ignoreme Player_1", "/statusbar",
+        std::string("/top\0", 5), std::string("/say\0hi", 7), std::string("quit\0\0\0\0", 8),
+        "/say\xA0hi", "/\xED\x95\x9C\xEA\xB8\x80", "hello world", "/tops", "/t", "//users",
+    };
+    for (const std::string& line : LINES)
+    {
+        std::string_view arguments;
+        CHECK(CommandParser::parse(line, arguments) == CommandParser::Command::CHAT);
+        CHECK(arguments.empty());
+        CHECK(matches_reference(line));
+    }
+
+    // 인자를 받는 명령은 공백 하나만 와도 빈 인자로 명령을 돌려줍니다.
+    std::string_view arguments;
+    CHECK(CommandParser::parse("/top ", arguments) == CommandParser::Command::TOP);
+    CHECK(arguments.empty());
+}
+
+TEST_CASE(commandParserFindsFirstSpaceAtEveryPosition)
+{
+    // 7바이트 이름은 공백이 8번째 바이트에 오고, 9바이트째부터의 줄은 SWAR 검사 창 밖입니다.
+    int mismatch_count = 0;
+    for (const ReferenceEntry& entry : REFERENCE_TABLE)
+    {
+        std::string name(entry.name);
+        for (std::size_t cut = 0; cut <= name.size(); ++cut)
+        {
+            for (std::size_t padding = 0; padding < 12; ++padding)
+            {
+                std::string line = name.substr(0, cut) + std::string(padding, 'x');
+                std::string spaced = name.substr(0, cut) + " " + std::string(padding, 'x');
+                std::string double_spaced = name.substr(0, cut) + "  " + std::string(padding, ' ');
+                mismatch_count = mismatch_count + (matches_reference(line) ? 0 : 1);
+                mismatch_count = mismatch_count + (matches_reference(spaced) ? 0 : 1);
+                mismatch_count = mismatch_count + (matches_reference(double_spaced) ? 0 : 1);
+            }
+        }
+    }
+    CHECK(mismatch_count == 0);
+}
+
+TEST_CASE(commandParserRejectsHashCollisions)
+{
+    // 표에 없는 이름도 어떤 명령과 같은 슬롯에 떨어질 수 있으므로, 명령 이름을 한 바이트씩 바꾸거나
+    // <br>무작위 1~8바이트 이름을 많이 넣어 빈 슬롯과 차 있는 슬롯 모두에서 정수 비교가 거르는지 봅니다.
+    std::mt19937 random(20261019);
+    const char ALPHABET[] = "/abcdefghijklmnopqrstuvwxyzQ_ \x80\xFF";
+    int mismatch_count = 0;
+    int command_count = 0;
+    for (const ReferenceEntry& entry : REFERENCE_TABLE)
+    {
+        for (std::size_t position = 0; position < entry.name.size(); ++position)
+        {
+            for (int value = 1; value < 256; ++value)
+            {
+                std::string line(entry.name);
+                line[position] = (char)value;
+                mismatch_count = mismatch_count + (matches_reference(line) ? 0 : 1);
+                mismatch_count = mismatch_count + (matches_reference(line + " x") ? 0 : 1);
+            }
+        }
+    }
+    for (int round = 0; round < 200000; ++round)
+    {
+        std::size_t length = 1 + random() % 8;
+        std::string line(1, (random() % 2 == 0) ? '/' : 'q');
+        while (line.size() < length)
+        {
+            line.push_back(ALPHABET[random() % (sizeof(ALPHABET) - 1)]);
+        }
+        std::string_view arguments;
+        command_count = command_count + ((CommandParser::parse(line, arguments) != CommandParser::Command::CHAT) ? 1 : 0);
+        mismatch_count = mismatch_count + (matches_reference(line) ? 0 : 1);
+    }
+    CHECK(mismatch_count == 0);
+    // 무작위 이름은 거의 모두 CHAT이어야 합니다. (짧은 "/top", "/say x" 같은 것만 우연히 맞습니다)
+    CHECK(command_count < 200);
+}
+
+TEST_CASE(commandParserTokenizerSplitsOnSpaces)
+{
+    CommandParser::Tokenizer tokenizer("  1.5   -2  3 rest of  line ");
+    std::string_view token;
+    REQUIRE(tokenizer.next(token));
+    CHECK(token == "1.5");
+    REQUIRE(tokenizer.next(token));
+    CHECK(token == "-2");
+    REQUIRE(tokenizer.next(token));
+    CHECK(token == "3");
+    CHECK(tokenizer.rest() == "rest of  line ");
+    REQUIRE(tokenizer.next(token));
+    CHECK(token == "rest");
+
+    CommandParser::Tokenizer empty("   ");
+    CHECK(empty.next(token) == false);
+    CHECK(empty.rest().empty());
+}
+
+BENCHMARK_CASE(benchmarkCommandParser)
+{
+    const int LINE_COUNT = 4096;
+    const int ROUNDS = 500;
+
+    // 실제 흐름처럼 대부분 일반 채팅이고, '/'로 시작하는 줄은 명령과 표에 없는 이름을 섞습니다.
+    std::mt19937 random(20261019);
+    const char* const COMMAND_LINES[] = {
+        "/say hello there", "/pos 1.5 2.5 3.5", "/users", "/status away", "/ignore Player_7", "/top bytes",
+        "/unknown thing", "/modest proposal", "quit", "/roster", "/statusbar", "/s",
+    };
+    const char* const CHAT_LINES[] = {
+        "hello everyone", "\xEC\x95\x88\xEB\x85\x95\xED\x95\x98\xEC\x84\xB8\xEC\x9A\x94", "gg", "lol that was close",
+    };
+
+    struct Mix
+    {
+        const char* name;
+        int commandPercent;
+    };
+    const Mix MIXES[] = { { "chat-heavy", 10 }, { "command-only", 100 } };
+
+    for (const Mix& mix : MIXES)
+    {
+        std::vector<std::string> lines;
+        lines.reserve(LINE_COUNT);
+        for (int i = 0; i < LINE_COUNT; ++i)
+        {
+            if ((int)(random() % 100) < mix.commandPercent)
+            {
+                lines.push_back(COMMAND_LINES[random() % (sizeof(COMMAND_LINES) / sizeof(COMMAND_LINES[0]))]);
+            }
+            else
+            {
+                lines.push_back(CHAT_LINES[random() % (sizeof(CHAT_LINES) / sizeof(CHAT_LINES[0]))]);
+            }
+        }
+
+        std::size_t parsed_sum = 0;
+        std::string_view arguments;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            for (const std::string& line : lines)
+            {
+                parsed_sum = parsed_sum + (std::size_t)CommandParser::parse(line, arguments) + arguments.size();
+            }
+        }
+        double parse_ns = elapsedNanoseconds(start);
+
+        std::size_t reference_sum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            for (const std::string& line : lines)
+            {
+                reference_sum = reference_sum + (std::size_t)reference_parse(line, arguments) + arguments.size();
+            }
+        }
+        double reference_ns = elapsedNanoseconds(start);
+        CHECK(parsed_sum == reference_sum);
+
+        std::string label = mix.name;
+        test_context.report(label + " perfect hash", parse_ns / ((double)LINE_COUNT * ROUNDS), "ns/line");
+        test_context.report(label + " linear table", reference_ns / ((double)LINE_COUNT * ROUNDS), "ns/line");
+    }
+}
@@ -0,0 +1,107 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ConfigTests.cpp
+ * @brief ServerConfig가 설정 파일과 명령줄 인자를 읽고, 잘못된 값을 거절하는지 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "ServerConfig.h"
+#include <cstdio>
+#include <fstream>
+
+TEST_CASE(serverConfigDefaultsToCoroutineSessions)
+{
+    ServerConfig config;
+    CHECK(config.getPort() == 5500);
+    CHECK(config.getSessionMode() == MultiServerBase::SessionMode::COROUTINE);
+}
+
+TEST_CASE(serverConfigArgumentsOverrideFile)
+{
+    const char* file_path = "config_test.cfg";
+    {
+        std::ofstream out(file_path, std::ios::out | std::ios::binary);
+        out << "\xEF\xBB\xBF# 주석\r\n";
+        out << "port = 5600\r\n";
+        out << "  session_mode=handler  \r\n";
+    }
+
+    // 파일을 읽은 뒤 인자가 같은 키를 덮어씁니다.
+    char program_name[] = "SocketBuild.exe";
+    char config_key[] = "--config";
+    char port_key[] = "--port";
+    char port_value[] = "5700";
+    char* argv[] = { program_name, config_key, (char*)file_path, port_key, port_value };
+
+    ServerConfig config;
+    CHECK(config.parseArguments(5, argv) == ServerConfig::Result::SUCCESS);
+    CHECK(config.getPort() == 5700);
+    CHECK(config.getSessionMode() == MultiServerBase::SessionMode::HANDLER);
+    std::remove(file_path);
+
+    // 알 수 없는 키, 범위를 벗어난 값, 값이 빠진 인자는 거절합니다.
+    CHECK(config.setValue("colour", "blue") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("port", "70000") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("port", "55x") == ServerConfig::Result::FAIL_VALUE);
+    char* missing_value[] = { program_name, port_key };
+    CHECK(config.parseArguments(2, missing_value) == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.loadFile("no_such_file.cfg") == ServerConfig::Result::FAIL_OPEN);
+    CHECK(config.getPort() == 5700);
+}
+
+TEST_CASE(serverConfigReadsOptionalFeatures)
+{
+    ServerConfig config;
+    CHECK(config.isBusyPollEnabled() == false);
+    CHECK(config.getPinnedCore() == -1);
+    CHECK(config.getFanoutWorkerCount() == 0);
+    CHECK(config.getRoomWorkerCount() == 0);
+    CHECK(config.isDatagramChannelEnabled() == false);
+    CHECK(config.getGameBridgeName().empty());
+    CHECK(config.getClusterPort() == 0);
+    CHECK(config.getClusterPeers().empty());
+    CHECK(config.getChatFilterFile().empty());
+    CHECK(config.getModeratorPassword().empty());
+
+    CHECK(config.setValue("busy_poll", "on") == ServerConfig::Result::SUCCESS);
+    CHECK(config.setValue("pinned_core", "3") == ServerConfig::Result::SUCCESS);
+    CHECK(config.isBusyPollEnabled());
+    CHECK(config.getPinnedCore() == 3);
+    CHECK(config.setValue("fanout_workers", "4") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getFanoutWorkerCount() == 4);
+    CHECK(config.setValue("room_workers", "2") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getRoomWorkerCount() == 2);
+    CHECK(config.setValue("datagram_channel", "on") == ServerConfig::Result::SUCCESS);
+    CHECK(config.isDatagramChannelEnabled());
+    CHECK(config.setValue("game_bridge", "ChatBridge") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getGameBridgeName() == "ChatBridge");
+
+    // cluster_peer는 적은 만큼 노드가 쌓입니다.
+    CHECK(config.setValue("cluster_port", "7001") == ServerConfig::Result::SUCCESS);
+    CHECK(config.setValue("cluster_peer", "127.0.0.1:7002") == ServerConfig::Result::SUCCESS);
+    CHECK(config.setValue("cluster_peer", "10.0.0.5:7003") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getClusterPort() == 7001);
+    REQUIRE(config.getClusterPeers().size() == 2);
+    CHECK(config.getClusterPeers()[1].host == "10.0.0.5");
+    CHECK(config.getClusterPeers()[1].port == 7003);
+    CHECK(config.setValue("chat_filter", "words.txt") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getChatFilterFile() == "words.txt");
+    CHECK(config.setValue("moderator_password", "s3cret") == ServerConfig::Result::SUCCESS);
+    CHECK(config.getModeratorPassword() == "s3cret");
+
+    // on/off가 아닌 값과 선호도 마스크를 넘는 코어는 거절합니다.
+    CHECK(config.setValue("busy_poll", "yes") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("pinned_core", "64") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("fanout_workers", "-1") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("room_workers", "65") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("game_bridge", "Global\\ChatBridge") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("cluster_peer", "127.0.0.1") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.setValue("cluster_peer", ":7002") == ServerConfig::Result::FAIL_VALUE);
+    CHECK(config.getClusterPeers().size() == 2);
+    CHECK(config.getPinnedCore() == 3);
+    CHECK(config.getFanoutWorkerCount() == 4);
+    CHECK(config.getRoomWorkerCount() == 2);
+}
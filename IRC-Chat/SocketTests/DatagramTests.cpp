@@ -0,0 +1,218 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file DatagramTests.cpp
+ * @brief UDP 이벤트 채널의 일괄 수신/송신과 "<토큰> <종류>[ <내용>]" 데이터그램 처리를 검사하고, 루프백 UDP에서의 처리량을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "DatagramChannel.h"
+#include "LoopbackCluster.h"
+#include "MultiServer.h"
+#include "ResumeRegistry.h"
+#include "SimulatedTransport.h"
+#include "SocketIniter.h"
+#include <vector>
+
+/**
+ * @brief 루프백 주소와 포트로 sockaddr_in을 만듭니다.
+ */
+static sockaddr_in makeLoopbackAddress(int port)
+{
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons((unsigned short)port);
+    return (address);
+}
+
+/**
+ * @brief 캡처된 출력에서 "[시스템] UDP <포트> <토큰>" 줄의 토큰을 꺼냅니다.
+ * @return std::string : 토큰, 없으면 빈 문자열.
+ */
+static std::string extractDatagramToken(const std::string& output)
+{
+    const std::string prefix = "[시스템] UDP ";
+    std::size_t position = output.find(prefix);
+    if (position == std::string::npos)
+    {
+        return ("");
+    }
+    position = output.find(' ', position + prefix.size()) + 1;
+    return (output.substr(position, output.find("\r\n", position) - position));
+}
+
+TEST_CASE(datagramChannelReceivesInBatchesAndSkipsOversized)
+{
+    SimulatedTransport transport;
+    DatagramChannel channel(transport, 8);
+    REQUIRE(channel.open(5600) == DatagramChannelBase::Result::SUCCESS);
+    CHECK(channel.getPort() == 5600);
+
+    // 너무 큰 것 하나, 딱 맞는 것 하나, 그리고 한 묶음보다 많은 작은 것들이 도착합니다.
+    const int SMALL_COUNT = DatagramChannelBase::BATCH_SIZE + 6;
+    transport.scheduleDatagram(1, 5600, 7000, std::string(DatagramChannelBase::MAX_DATAGRAM_SIZE + 1, 'x'));
+    transport.scheduleDatagram(1, 5600, 7000, std::string(DatagramChannelBase::MAX_DATAGRAM_SIZE, 'y'));
+    for (int i = 0; i < SMALL_COUNT; ++i)
+    {
+        transport.scheduleDatagram(1, 5600, 7001, "d" + std::to_string(i));
+    }
+    transport.advanceTime(2);
+
+    // 한 번에 BATCH_SIZE개까지만 읽고, 너무 큰 것은 건너뛰어 센 뒤 계속 읽습니다.
+    REQUIRE(channel.receiveBatch() == DatagramChannelBase::BATCH_SIZE);
+    CHECK(channel.getDroppedCount() == 1);
+    CHECK(channel.getReceived(0).length == DatagramChannelBase::MAX_DATAGRAM_SIZE);
+    CHECK(ntohs(channel.getReceived(0).address.sin_port) == 7000);
+    CHECK(std::string(channel.getReceived(1).data, channel.getReceived(1).length) == "d0");
+    CHECK(ntohs(channel.getReceived(1).address.sin_port) == 7001);
+    CHECK(std::string(channel.getReceived(63).data, channel.getReceived(63).length) == "d62");
+
+    REQUIRE(channel.receiveBatch() == SMALL_COUNT + 1 - DatagramChannelBase::BATCH_SIZE);
+    CHECK(std::string(channel.getReceived(6).data, channel.getReceived(6).length) == "d69");
+    CHECK(channel.receiveBatch() == 0);
+    CHECK(channel.getReceivedCount() == (std::uint64_t)SMALL_COUNT + 1);
+}
+
+TEST_CASE(datagramChannelSendsQueuedBatchInOrder)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+    DatagramChannel channel(transport, 8);
+    REQUIRE(channel.open(5600) == DatagramChannelBase::Result::SUCCESS);
+
+    // 송신 버퍼가 가득 차면 다음 queueSend()가 먼저 모아 둔 것을 보냅니다.
+    const int SEND_COUNT = DatagramChannelBase::SEND_BATCH_SIZE + 44;
+    sockaddr_in to_addr = makeLoopbackAddress(7100);
+    for (int i = 0; i < SEND_COUNT; ++i)
+    {
+        std::string payload = "s" + std::to_string(i);
+        channel.queueSend(to_addr, payload.c_str(), (int)payload.size());
+    }
+    CHECK(channel.getSentCount() == (std::uint64_t)DatagramChannelBase::SEND_BATCH_SIZE);
+
+    std::string oversized(DatagramChannelBase::MAX_DATAGRAM_SIZE + 1, 'x');
+    channel.queueSend(to_addr, oversized.c_str(), (int)oversized.size());
+    CHECK(channel.getDroppedCount() == 1);
+
+    CHECK(channel.flushSends() == SEND_COUNT - DatagramChannelBase::SEND_BATCH_SIZE);
+    CHECK(channel.flushSends() == 0);
+
+    const std::vector<std::string>& captured = transport.getCapturedDatagrams(7100);
+    REQUIRE(captured.size() == (std::size_t)SEND_COUNT);
+    CHECK(captured.front() == "s0");
+    CHECK(captured.back() == "s" + std::to_string(SEND_COUNT - 1));
+
+    // 주소 슬롯은 등록, 교체, 해제되고 close()하면 모두 잊습니다.
+    channel.bindEndpoint(3, makeLoopbackAddress(7200));
+    channel.bindEndpoint(3, makeLoopbackAddress(7201));
+    REQUIRE(channel.findEndpoint(3) != nullptr);
+    CHECK(ntohs(channel.findEndpoint(3)->sin_port) == 7201);
+    channel.unbindEndpoint(3);
+    CHECK(channel.findEndpoint(3) == nullptr);
+    channel.bindEndpoint(4, makeLoopbackAddress(7300));
+    channel.close();
+    CHECK(channel.isOpen() == false);
+    CHECK(channel.findEndpoint(4) == nullptr);
+}
+
+TEST_CASE(serverAnswersAuthenticatedDatagramsOnly)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::HANDLER);
+    server.enableDatagramChannel();
+    SOCKET first_client = transport.scheduleConnect(10);
+    SOCKET second_client = transport.scheduleConnect(20);
+
+    // 토큰은 실행 중에야 알 수 있으므로, 입장한 뒤에 데이터그램을 예약합니다.
+    std::string first_token;
+    transport.scheduleCallback(100, [&transport, &first_token, first_client, second_client]()
+    {
+        first_token = extractDatagramToken(transport.getCapturedOutput(first_client));
+        std::string second_token = extractDatagramToken(transport.getCapturedOutput(second_client));
+
+        transport.scheduleDatagram(110, 5500, 7001, first_token + " HELLO");
+        transport.scheduleDatagram(110, 5500, 7002, second_token + " HELLO");
+        transport.scheduleDatagram(120, 5500, 7001, first_token + " PING 42");
+        transport.scheduleDatagram(130, 5500, 7001, first_token + " TYPING");
+        transport.scheduleDatagram(140, 5500, 7003, std::string(ResumeRegistry::TOKEN_LENGTH, '0') + " TYPING");
+        transport.scheduleDatagram(140, 5500, 7003, "short PING");
+        transport.scheduleDatagram(140, 5500, 7003, first_token + " " + std::string(MultiServerBase::MAX_EVENT_KIND_LENGTH + 1, 'K'));
+        transport.scheduleDatagram(140, 5500, 7003, first_token + " ");
+        transport.scheduleDatagram(150, 5500, 7002, second_token + " TYPING");
+    });
+    transport.scheduleCallback(300, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+    REQUIRE(first_token.size() == (std::size_t)ResumeRegistry::TOKEN_LENGTH);
+
+    // PING은 보낸 주소로만 돌아가고, 다른 종류는 UDP 주소를 등록한 다른 접속자에게 닉네임과 함께 전달됩니다.
+    const std::vector<std::string>& first_datagrams = transport.getCapturedDatagrams(7001);
+    const std::vector<std::string>& second_datagrams = transport.getCapturedDatagrams(7002);
+    REQUIRE(second_datagrams.size() == 1);
+    CHECK(second_datagrams[0] == "Player_0 TYPING");
+
+    // 모르는 토큰, 길이가 틀린 토큰, 너무 길거나 빈 종류는 답 없이 버려지고, 등록된 주소도 바꾸지 않습니다.
+    CHECK(transport.getCapturedDatagrams(7003).empty());
+    REQUIRE(first_datagrams.size() == 2);
+    CHECK(first_datagrams[0] == "PONG 42");
+    CHECK(first_datagrams[1] == "Player_1 TYPING");
+}
+
+BENCHMARK_CASE(benchmarkDatagramThroughput)
+{
+    const int DATAGRAM_COUNT = 200000;
+    const int PAYLOAD_SIZE = 64;
+
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    // 두 채널을 루프백으로 마주 보게 열고, 한 묶음씩 보내고 받습니다.
+    DatagramChannel sender(transport, 1);
+    DatagramChannel receiver(transport, 1);
+    REQUIRE(sender.open(reserveLoopbackPort()) == DatagramChannelBase::Result::SUCCESS);
+    REQUIRE(receiver.open(reserveLoopbackPort()) == DatagramChannelBase::Result::SUCCESS);
+    sockaddr_in to_addr = makeLoopbackAddress(receiver.getPort());
+    std::string payload(PAYLOAD_SIZE, 'p');
+
+    int received_total = 0;
+    int batch_calls = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int sent_total = 0; sent_total < DATAGRAM_COUNT; sent_total = sent_total + DatagramChannelBase::BATCH_SIZE)
+    {
+        for (int i = 0; i < DatagramChannelBase::BATCH_SIZE; ++i)
+        {
+            sender.queueSend(to_addr, payload.c_str(), (int)payload.size());
+        }
+        sender.flushSends();
+
+        // 한 묶음을 다 받거나, 잃은 것으로 보고 잠시 뒤 포기합니다.
+        int received_batch = 0;
+        while (received_batch < DatagramChannelBase::BATCH_SIZE)
+        {
+            fd_set read_set;
+            FD_ZERO(&read_set);
+            FD_SET(receiver.getSocket(), &read_set);
+            if (transport.selectReadable(&read_set, 50) <= 0)
+            {
+                break;
+            }
+            received_batch = received_batch + receiver.receiveBatch();
+            batch_calls = batch_calls + 1;
+        }
+        received_total = received_total + received_batch;
+    }
+    double elapsed_ns = elapsedNanoseconds(start);
+
+    test_context.report("datagrams/sec (send + receive)", (double)received_total * 1e9 / elapsed_ns, "datagrams/s");
+    test_context.report("datagrams per receiveBatch", (batch_calls > 0) ? (double)received_total / batch_calls : 0.0, "datagrams");
+    test_context.report("datagrams lost", (double)(sender.getSentCount() - (std::uint64_t)received_total), "datagrams");
+    test_context.report("datagrams dropped by sender", (double)sender.getDroppedCount(), "datagrams");
+}
@@ -0,0 +1,303 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file DiagnosticsTests.cpp
+ * @brief 트레이스 JSON 내보내기와 정체 기록 파일이 읽을 수 있는 내용을 남기는지 검사하고, 트레이스를 켠 서버 루프의 부담을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 테스트 빌드는 ENABLE_TRACE로 컴파일하고 TestMain에서 기록을 꺼 둡니다. 여기의 테스트만 TraceRecorder::setEnabled()로 잠시 켭니다.
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "FlightRecorder.h"
+#include "MultiServer.h"
+#include "SimulatedTransport.h"
+#include "TraceRecorder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 파일 전체를 문자열로 읽습니다.
+ */
+static std::string readWholeFile(const std::string& file_path)
+{
+    std::ifstream in(file_path, std::ios::in | std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return (text.str());
+}
+
+/**
+ * @brief 문자열을 줄 단위로 나눕니다.
+ */
+static std::vector<std::string> splitLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lines.push_back(line);
+    }
+    return (lines);
+}
+
+TEST_CASE(stallDumpListsEventsOfSlowIteration)
+{
+    using namespace std::chrono_literals;
+    const std::string FILE_PATH = "stall_1.log";
+
+    FlightRecorder recorder;
+    recorder.setBudget(10);
+    NetworkTransport::Clock::time_point start = NetworkTransport::Clock::now();
+
+    // 반복 1 : select에서 50ms 기다렸지만 작업은 8ms이므로 정체가 아닙니다.
+    CHECK(recorder.beginIteration(start) == false);
+    recorder.record(FlightRecorder::EventType::SELECT, INVALID_SOCKET, 1, start, start + 50ms);
+    recorder.record(FlightRecorder::EventType::RECV, (SOCKET)7, 42, start + 50ms, start + 51ms);
+    NetworkTransport::Clock::time_point second = start + 58ms;
+    CHECK(recorder.beginIteration(second) == false);
+    CHECK(recorder.getStallCount() == 0);
+
+    // 반복 2 : 대기 없이 25ms 동안 보냈으므로 예산을 넘어 파일을 남깁니다.
+    recorder.record(FlightRecorder::EventType::SEND, (SOCKET)7, 42, second, second + 20ms);
+    CHECK(recorder.beginIteration(second + 25ms));
+    CHECK(recorder.getStallCount() == 1);
+
+    // 곧바로 이어진 정체는 세기만 하고 MIN_DUMP_INTERVAL_MS가 지나기 전에는 다시 저장하지 않습니다.
+    CHECK(recorder.beginIteration(second + 60ms) == false);
+    CHECK(recorder.getStallCount() == 2);
+
+    std::vector<std::string> lines = splitLines(readWholeFile(FILE_PATH));
+    std::remove(FILE_PATH.c_str());
+
+    // 사유, 머리글, 그리고 정체 직전까지의 이벤트가 오래된 순서로 들어 있습니다. 시각은 첫 이벤트 기준 마이크로초입니다.
+    REQUIRE(lines.size() == 7);
+    CHECK(lines[0].rfind("# 반복 2 작업 시간 25ms (예산 10ms", 0) == 0);
+    CHECK(lines[1] == "# offset_us type socket value duration_us");
+    CHECK(lines[2] == "0 ITERATION - 1 0");
+    CHECK(lines[3] == "0 SELECT - 1 50000");
+    CHECK(lines[4] == "50000 RECV 7 42 1000");
+    CHECK(lines[5] == "58000 ITERATION - 2 0");
+    CHECK(lines[6] == "58000 SEND 7 42 20000");
+}
+
+#ifdef ENABLE_TRACE
+
+/**
+ * @brief 트레이스 파일에서 읽은 구간 하나.
+ */
+struct ParsedSpan
+{
+    std::string name;
+    std::string phase;
+    int threadId;
+    double beginMicros;
+    double durationMicros;
+};
+
+/**
+ * @brief 객체 문자열에서 "key": 뒤의 값을 잘라 냅니다. 문자열 값이면 따옴표를 벗깁니다.
+ */
+static std::string findField(const std::string& object, const std::string& key)
+{
+    std::string pattern = "\"" + key + "\":";
+    std::size_t position = object.find(pattern);
+    if (position == std::string::npos)
+    {
+        return ("");
+    }
+    position = position + pattern.size();
+
+    if (object[position] == '"')
+    {
+        std::size_t end = object.find('"', position + 1);
+        return (object.substr(position + 1, end - position - 1));
+    }
+    std::size_t end = object.find_first_of(",}", position);
+    return (object.substr(position, end - position));
+}
+
+/**
+ * @brief trace-event JSON의 traceEvents 배열을 읽습니다. 형식이 어긋나면 false를 반환합니다.
+ */
+static bool parseTraceEvents(const std::string& text, std::vector<ParsedSpan>& spans)
+{
+    const std::string HEADER = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    if (text.compare(0, HEADER.size(), HEADER) != 0)
+    {
+        return (false);
+    }
+    std::size_t array_end = text.rfind("]}");
+    if (array_end == std::string::npos)
+    {
+        return (false);
+    }
+
+    // 구간 객체는 중첩이 없으므로 { 와 } 짝으로 나눕니다. 객체 사이에는 쉼표만 와야 합니다.
+    std::size_t position = HEADER.size();
+    bool expect_comma = false;
+    while (position < array_end)
+    {
+        char c = text[position];
+        if (c == '\n' || c == ' ')
+        {
+            position = position + 1;
+            continue;
+        }
+        if (c == ',' && expect_comma)
+        {
+            expect_comma = false;
+            position = position + 1;
+            continue;
+        }
+        if (c != '{' || expect_comma)
+        {
+            return (false);
+        }
+
+        std::size_t object_end = text.find('}', position);
+        if (object_end == std::string::npos || object_end > array_end)
+        {
+            return (false);
+        }
+        std::string object = text.substr(position, object_end - position + 1);
+
+        ParsedSpan span;
+        span.name = findField(object, "name");
+        span.phase = findField(object, "ph");
+        span.threadId = std::atoi(findField(object, "tid").c_str());
+        span.beginMicros = std::strtod(findField(object, "ts").c_str(), nullptr);
+        span.durationMicros = std::strtod(findField(object, "dur").c_str(), nullptr);
+        if (span.name.empty() || findField(object, "ts").empty() || findField(object, "dur").empty())
+        {
+            return (false);
+        }
+        spans.push_back(span);
+
+        expect_comma = true;
+        position = object_end + 1;
+    }
+    return (true);
+}
+
+/**
+ * @brief 이름이 name인 마지막 구간을 찾습니다.
+ */
+static const ParsedSpan* findSpan(const std::vector<ParsedSpan>& spans, const std::string& name)
+{
+    const ParsedSpan* found = nullptr;
+    for (const ParsedSpan& span : spans)
+    {
+        if (span.name == name)
+        {
+            found = &span;
+        }
+    }
+    return (found);
+}
+
+TEST_CASE(traceExportWritesNestedSpansAsJson)
+{
+    const std::string FILE_PATH = "trace_export_test.json";
+
+    TraceRecorder::setEnabled(true);
+    {
+        TRACE_SCOPE("test.outer");
+        {
+            TRACE_SCOPE("test.inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    std::thread worker([]() { TRACE_SCOPE("test.worker"); });
+    worker.join();
+    TraceRecorder::setEnabled(false);
+
+    // 꺼진 뒤의 구간은 남지 않습니다.
+    {
+        TRACE_SCOPE("test.disabled");
+    }
+
+    REQUIRE(TraceRecorder::dumpToFile(FILE_PATH));
+    std::string text = readWholeFile(FILE_PATH);
+    std::remove(FILE_PATH.c_str());
+
+    std::vector<ParsedSpan> spans;
+    REQUIRE(parseTraceEvents(text, spans));
+
+    const ParsedSpan* outer = findSpan(spans, "test.outer");
+    const ParsedSpan* inner = findSpan(spans, "test.inner");
+    const ParsedSpan* worker_span = findSpan(spans, "test.worker");
+    REQUIRE(outer != nullptr);
+    REQUIRE(inner != nullptr);
+    REQUIRE(worker_span != nullptr);
+    CHECK(findSpan(spans, "test.disabled") == nullptr);
+
+    // 완료 이벤트(X)이고, 안쪽 구간은 바깥 구간 안에 들어가며, 다른 스레드는 다른 tid입니다.
+    CHECK(outer->phase == "X");
+    CHECK(inner->threadId == outer->threadId);
+    CHECK(worker_span->threadId != outer->threadId);
+    CHECK(inner->durationMicros >= 1000.0);
+    CHECK(inner->beginMicros >= outer->beginMicros);
+    CHECK(inner->beginMicros + inner->durationMicros <= outer->beginMicros + outer->durationMicros + 1.0);
+    CHECK(worker_span->beginMicros >= outer->beginMicros + outer->durationMicros - 1.0);
+}
+
+/**
+ * @brief 10개 클라이언트가 20000줄씩 보내는 서버 루프를 돌리고 한 줄당 실제 시간(ns)을 반환합니다.
+ */
+static double runTracedLoop(bool trace_enabled)
+{
+    const int CLIENT_COUNT = 10;
+    const int LINES_PER_CLIENT = 20000;
+
+    SimulatedTransport transport;
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::HANDLER);
+    for (int i = 0; i < CLIENT_COUNT; ++i)
+    {
+        SOCKET client_socket = transport.scheduleConnect(1 + i);
+        transport.scheduleLines(client_socket, 1000, 1, LINES_PER_CLIENT, "benchmark line");
+    }
+    transport.scheduleCallback(1000 + LINES_PER_CLIENT + 100, [&server]() { server.stop(); });
+
+    if (server.startServer() != MultiServerBase::Result::SUCCESS)
+    {
+        return (0.0);
+    }
+    TraceRecorder::setEnabled(trace_enabled);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    server.runServerLoop();
+    double elapsed_ns = elapsedNanoseconds(start);
+    TraceRecorder::setEnabled(false);
+
+    return (elapsed_ns / ((double)LINES_PER_CLIENT * CLIENT_COUNT));
+}
+
+BENCHMARK_CASE(benchmarkTraceOverhead)
+{
+    const int ROUNDS = 5;
+
+    // 켜고 끈 실행을 번갈아 돌리고 각각 가장 빠른 값을 비교해 잡음을 줄입니다.
+    double off_ns = 0.0;
+    double on_ns = 0.0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        double off_sample = runTracedLoop(false);
+        double on_sample = runTracedLoop(true);
+        off_ns = (round == 0 || off_sample < off_ns) ? off_sample : off_ns;
+        on_ns = (round == 0 || on_sample < on_ns) ? on_sample : on_ns;
+    }
+
+    test_context.report("trace off ns/line", off_ns, "ns");
+    test_context.report("trace on ns/line", on_ns, "ns");
+    test_context.report("trace overhead (target < 1%)", (off_ns > 0.0) ? (on_ns - off_ns) * 100.0 / off_ns : 0.0, "%");
+}
+
+#endif
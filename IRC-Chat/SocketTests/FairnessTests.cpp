@@ -0,0 +1,134 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file FairnessTests.cpp
+ * @brief 읽기 예산과 회전 스캔이 밀린 데이터가 많은 클라이언트 사이에서 가벼운 클라이언트를 먼저 처리하는지 검사하고, 그 지연 분포를 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "SimulatedTransport.h"
+#include <algorithm>
+#include <vector>
+
+/// 무거운 클라이언트가 보내는 한 줄 (100바이트). 잘린 조각과 구분되도록 'H'로 시작합니다.
+static const std::string HEAVY_LINE = "H" + std::string(99, 'h');
+
+/// 무거운 클라이언트 하나가 한꺼번에 보내는 줄 수 (약 20KB, 읽기 예산 몇 번 분량).
+static const int HEAVY_LINES_PER_CLIENT = 200;
+
+/**
+ * @brief 관찰자 출력에서 marker 줄보다 앞서 중계된 무거운 줄의 수를 셉니다.
+ * @return int : 앞선 줄 수, marker가 없으면 -1.
+ */
+static int countHeavyLinesBefore(const std::string& output, const std::string& marker)
+{
+    std::size_t position = output.find(marker);
+    if (position == std::string::npos)
+    {
+        return (-1);
+    }
+    return (countOccurrences(output.substr(0, position), "]: " + HEAVY_LINE.substr(0, 1)));
+}
+
+TEST_CASE(lightClientIsServedBeforeHeavyBacklogDrains)
+{
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+
+    for (MultiServerBase::SessionMode mode : modes)
+    {
+        SimulatedTransport transport;
+        transport.setOutputCapture(true);
+
+        MultiServer server(5500, transport, mode);
+        SOCKET heavy_client = transport.scheduleConnect(10);
+        SOCKET light_client = transport.scheduleConnect(20);
+        SOCKET observer = transport.scheduleConnect(30);
+
+        // 무거운 클라이언트의 밀린 줄이 모두 도착한 뒤 가벼운 클라이언트가 한 줄을 보냅니다.
+        transport.scheduleLines(heavy_client, 1000, 0, HEAVY_LINES_PER_CLIENT, HEAVY_LINE);
+        transport.scheduleLines(light_client, 1000, 0, 1, "light");
+        transport.scheduleCallback(1500, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+        // 가벼운 줄은 무거운 클라이언트가 밀린 줄을 다 비우기 전에 중계됩니다.
+        const std::string& output = transport.getCapturedOutput(observer);
+        int heavy_before = countHeavyLinesBefore(output, "[Player_1]: light");
+        CHECK(heavy_before >= 0);
+        CHECK(heavy_before < countOccurrences(output, "]: " + HEAVY_LINE.substr(0, 1)));
+    }
+}
+
+BENCHMARK_CASE(benchmarkReadFairness)
+{
+    const int HEAVY_COUNTS[] = { 1, 2, 4, 8 };
+    const int LIGHT_COUNT = 4;
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+    const char* mode_names[] = { "handler", "coroutine" };
+
+    for (int m = 0; m < 2; ++m)
+    {
+        for (int heavy_count : HEAVY_COUNTS)
+        {
+            SimulatedTransport transport;
+            transport.setOutputCapture(true);
+            MultiServer server(5500, transport, modes[m]);
+
+            // 가벼운 클라이언트를 무거운 클라이언트 사이사이에 두어 인덱스 순서의 유불리도 함께 봅니다.
+            std::vector<std::string> light_markers;
+            int player_index = 0;
+            long long connect_ms = 10;
+            for (int i = 0; i < heavy_count + LIGHT_COUNT; ++i)
+            {
+                SOCKET client_socket = transport.scheduleConnect(connect_ms);
+                connect_ms = connect_ms + 1;
+                bool is_light = (i % ((heavy_count + LIGHT_COUNT) / LIGHT_COUNT) == 0 && (int)light_markers.size() < LIGHT_COUNT);
+                if (is_light)
+                {
+                    transport.scheduleLines(client_socket, 1000, 0, 1, "light");
+                    light_markers.push_back("[Player_" + std::to_string(player_index) + "]: light");
+                }
+                else
+                {
+                    transport.scheduleLines(client_socket, 1000, 0, HEAVY_LINES_PER_CLIENT, HEAVY_LINE);
+                }
+                player_index = player_index + 1;
+            }
+            SOCKET observer = transport.scheduleConnect(connect_ms);
+            transport.scheduleCallback(2000, [&server]() { server.stop(); });
+
+            REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            server.runServerLoop();
+            double elapsed_ns = elapsedNanoseconds(start);
+
+            // 가벼운 줄마다 앞서 중계된 무거운 줄 수가 곧 대기열에서 기다린 양입니다.
+            const std::string& output = transport.getCapturedOutput(observer);
+            int heavy_total = heavy_count * HEAVY_LINES_PER_CLIENT;
+            int worst_ahead = 0;
+            double sum_ahead = 0.0;
+            for (const std::string& marker : light_markers)
+            {
+                int ahead = countHeavyLinesBefore(output, marker);
+                CHECK(ahead >= 0);
+                worst_ahead = std::max(worst_ahead, ahead);
+                sum_ahead = sum_ahead + ahead;
+            }
+            CHECK(worst_ahead < heavy_total);
+
+            // 중계 한 줄의 평균 처리 시간으로 가벼운 줄의 지연을 환산합니다.
+            double ns_per_line = elapsed_ns / (heavy_total + LIGHT_COUNT);
+            std::string label = std::string(mode_names[m]) + " heavy=" + std::to_string(heavy_count);
+            test_context.report(label + " heavy backlog", (double)heavy_total, "lines");
+            test_context.report(label + " light mean ahead", sum_ahead / LIGHT_COUNT, "lines");
+            test_context.report(label + " light worst ahead", (double)worst_ahead, "lines");
+            test_context.report(label + " light worst delay", worst_ahead * ns_per_line / 1000.0, "us");
+            test_context.report(label + " heavy drain", heavy_total * ns_per_line / 1000.0, "us");
+        }
+    }
+}
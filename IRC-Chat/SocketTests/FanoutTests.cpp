@@ -0,0 +1,118 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file FanoutTests.cpp
+ * @brief 병렬 팬아웃이 모든 수신자에게 정확히 한 번씩 대기열에 넣는지 검사하고, 방 크기와 스레드 수에 따른 팬아웃 완료 시간을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * MessageSender를 SimulatedTransport 위에서 직접 사용합니다. MessageSender는 ClientManagerBase::MAX_CLIENTS에 묶이지 않으므로
+ * <br>테스트 빌드의 접속자 상한(CHAT_MAX_CLIENTS=4096)보다 큰 방도 만들 수 있습니다.
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MessageSender.h"
+#include "SimulatedTransport.h"
+#include <vector>
+
+/**
+ * @brief 가상 연결 count개를 받아 열린 소켓 목록을 돌려줍니다.
+ */
+static std::vector<SOCKET> acceptSockets(SimulatedTransport& transport, int count)
+{
+    SOCKET listen_socket = transport.createSocket();
+    transport.bindSocket(listen_socket, 5500);
+    transport.listenSocket(listen_socket);
+
+    for (int i = 0; i < count; ++i)
+    {
+        transport.scheduleConnect(1);
+    }
+    transport.advanceTime(1);
+
+    std::vector<SOCKET> sockets;
+    sockets.reserve((std::size_t)count);
+    for (int i = 0; i < count; ++i)
+    {
+        sockets.push_back(transport.acceptSocket(listen_socket, nullptr));
+    }
+    return (sockets);
+}
+
+TEST_CASE(parallelFanoutQueuesEveryRecipientOnce)
+{
+    const int ROOM_SIZE = 3000;
+
+    SimulatedTransport transport;
+    std::vector<SOCKET> sockets = acceptSockets(transport, ROOM_SIZE);
+    REQUIRE(sockets.back() != INVALID_SOCKET);
+
+    MessageSender sender(transport);
+    sender.enableParallelFanout(2);
+    sender.fixFanoutThreshold(MessageSenderBase::MIN_FANOUT_THRESHOLD);
+
+    // 처음에는 대기열이 없는 소켓뿐이어서, 청크가 모은 소켓을 루프 스레드가 마저 넣습니다.
+    SOCKET except_socket = sockets[ROOM_SIZE / 2];
+    sender.multicast("first", sockets.data(), ROOM_SIZE, except_socket, MessageSenderBase::Lane::CHAT);
+    CHECK(sender.getParallelFanoutCount() == 1);
+    CHECK(sender.getTotalLaneDepth(MessageSenderBase::Lane::CHAT) == ROOM_SIZE - 1);
+    CHECK(sender.getLaneDepth(except_socket, MessageSenderBase::Lane::CHAT) == 0);
+
+    // 이제 모든 소켓에 대기열이 있으므로 청크가 직접 넣습니다.
+    CHECK(sender.broadcast("second", sockets.data(), ROOM_SIZE, MessageSenderBase::Lane::CHAT) == MessageSenderBase::Result::SUCCESS);
+    CHECK(sender.getParallelFanoutCount() == 2);
+    CHECK(sender.getTotalLaneDepth(MessageSenderBase::Lane::CHAT) == ROOM_SIZE * 2 - 1);
+    CHECK(sender.getLaneDepth(except_socket, MessageSenderBase::Lane::CHAT) == 1);
+    CHECK(sender.getDroppedChatCount() == 0);
+    CHECK(sender.getFanoutThreshold() == MessageSenderBase::MIN_FANOUT_THRESHOLD);
+
+    sender.flush();
+    CHECK(sender.getTotalLaneDepth(MessageSenderBase::Lane::CHAT) == 0);
+}
+
+BENCHMARK_CASE(benchmarkFanoutParallel)
+{
+    const int ROOM_SIZES[] = { 1024, 4096, 16384, 65536 };
+    const int THREAD_COUNTS[] = { 0, 1, 2, 4, 8 };
+    const int RECIPIENTS_PER_RUN = 1 << 20;
+
+    for (int room_size : ROOM_SIZES)
+    {
+        for (int thread_count : THREAD_COUNTS)
+        {
+            SimulatedTransport transport;
+            std::vector<SOCKET> sockets = acceptSockets(transport, room_size);
+
+            // 스레드 0은 지금처럼 루프 스레드에서만 처리한 기준값입니다. 나머지는 임계값을 고정해 항상 병렬로 처리합니다.
+            MessageSender sender(transport);
+            if (thread_count > 0)
+            {
+                sender.enableParallelFanout(thread_count);
+                sender.fixFanoutThreshold(MessageSenderBase::MIN_FANOUT_THRESHOLD);
+            }
+
+            // 대기열을 만드는 첫 팬아웃은 재지 않습니다.
+            sender.broadcast("warm up", sockets.data(), room_size, MessageSenderBase::Lane::CHAT);
+            sender.flush();
+
+            // 팬아웃(대기열에 넣기)만 재고, 전송은 매번 비워 대기열이 쌓이지 않게 합니다.
+            int broadcast_count = RECIPIENTS_PER_RUN / room_size;
+            double fanout_ns = 0.0;
+            for (int i = 0; i < broadcast_count; ++i)
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                sender.broadcast("fanout benchmark line", sockets.data(), room_size, MessageSenderBase::Lane::CHAT);
+                fanout_ns = fanout_ns + elapsedNanoseconds(start);
+                sender.flush();
+            }
+            CHECK(sender.getDroppedChatCount() == 0);
+            CHECK(thread_count == 0 || sender.getParallelFanoutCount() == (std::uint64_t)broadcast_count + 1);
+
+            std::string label = "room=" + std::to_string(room_size) + " threads=" + std::to_string(thread_count);
+            test_context.report(label + " fanout", fanout_ns / broadcast_count / 1000.0, "us");
+            test_context.report(label + " per recipient", fanout_ns / broadcast_count / room_size, "ns");
+        }
+    }
+}
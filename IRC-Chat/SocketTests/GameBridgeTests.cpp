@@ -0,0 +1,296 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file GameBridgeTests.cpp
+ * @brief 게임 서버 브리지의 깨우기 소켓이 메시지마다 select를 깨우는지, 링 머리말이 망가져도 비우고 계속 전달하는지 검사하고,
+ * <br>브리지와 루프백 TCP의 전달 지연을 비교합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 같은 프로세스 안에서 SERVER와 GAME 역할로 같은 이름의 브리지를 엽니다. 이름이 겹치지 않도록 테스트마다 다른 이름을 씁니다.
+ */
+
+#include "TestHarness.h"
+#include "LoopbackCluster.h"
+#include "SharedMemoryBridge.h"
+#include "SocketIniter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief socket 하나가 timeout_ms 안에 읽기 가능해지는지 확인합니다.
+ */
+static bool waitReadable(WinSockTransport& transport, SOCKET socket, int timeout_ms)
+{
+    fd_set read_set;
+    FD_ZERO(&read_set);
+    FD_SET(socket, &read_set);
+    return (transport.selectReadable(&read_set, timeout_ms) > 0);
+}
+
+TEST_CASE(bridgeWakeSocketSignalsUntilRearmed)
+{
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+    WinSockTransport transport;
+
+    SharedMemoryBridge server_bridge;
+    SharedMemoryBridge game_bridge;
+    REQUIRE(server_bridge.open("ChatBridgeWakeTest", SharedMemoryBridge::Role::SERVER) == SharedMemoryBridge::Result::SUCCESS);
+    REQUIRE(game_bridge.open("ChatBridgeWakeTest", SharedMemoryBridge::Role::GAME) == SharedMemoryBridge::Result::SUCCESS);
+    REQUIRE(server_bridge.startWakeSocket() == SharedMemoryBridge::Result::SUCCESS);
+    SOCKET wake_socket = server_bridge.getWakeSocket();
+    REQUIRE(wake_socket != INVALID_SOCKET);
+
+    // 메시지가 없으면 깨우지 않습니다.
+    CHECK(waitReadable(transport, wake_socket, 50) == false);
+
+    // 메시지가 들어오면 select가 깨어나고, 다시 무장하기 전까지 들어온 메시지는 모두 같은 신호로 읽습니다.
+    CHECK(game_bridge.send("first") == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(waitReadable(transport, wake_socket, 1000));
+    CHECK(game_bridge.send("second") == SharedMemoryBridge::Result::SUCCESS);
+    std::string message;
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "first");
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "second");
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::EMPTY);
+
+    // 링을 비우고 다시 무장하면 조용해졌다가, 다음 메시지에 다시 깨어납니다.
+    server_bridge.rearmWakeSocket();
+    CHECK(waitReadable(transport, wake_socket, 50) == false);
+    CHECK(game_bridge.send("third") == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(waitReadable(transport, wake_socket, 1000));
+
+    // 읽지 않은 메시지가 남은 채로 다시 무장하면 곧바로 다시 깨웁니다. (묶음 한도로 일부만 읽은 경우)
+    server_bridge.rearmWakeSocket();
+    CHECK(waitReadable(transport, wake_socket, 1000));
+
+    // 닫으면 깨우기 스레드가 멈추고 소켓도 닫힙니다.
+    server_bridge.close();
+    CHECK(server_bridge.getWakeSocket() == INVALID_SOCKET);
+}
+
+/// 공유 영역 안에서 toServer 링이 시작하는 위치 (magic, version 뒤 첫 64바이트 경계).
+static const std::size_t TO_SERVER_RING_OFFSET = 64;
+
+/// 링 안의 head, tail, data 위치 (SharedMemoryBridge::Ring의 필드는 각각 alignas(64)).
+static const std::size_t RING_HEAD_OFFSET = 0;
+static const std::size_t RING_TAIL_OFFSET = 64;
+static const std::size_t RING_DATA_OFFSET = 192;
+
+/**
+ * @brief 잘못 동작하는 상대 프로세스처럼 공유 영역을 직접 매핑합니다. 다 쓰면 UnmapViewOfFile()과 CloseHandle()로 닫습니다.
+ */
+static char* map_bridge_layout(const std::string& name, HANDLE& mapping)
+{
+    mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, ("Local\\" + name).c_str());
+    if (mapping == nullptr)
+    {
+        return (nullptr);
+    }
+    return ((char*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+}
+
+/**
+ * @brief 링의 위치 값 하나(head 또는 tail)를 가리킵니다.
+ */
+static std::atomic<std::uint32_t>& ring_position(char* ring, std::size_t field_offset)
+{
+    return (*(std::atomic<std::uint32_t>*)(ring + field_offset));
+}
+
+TEST_CASE(bridgeResetsCorruptedRingAndKeepsDelivering)
+{
+    SharedMemoryBridge server_bridge;
+    SharedMemoryBridge game_bridge;
+    REQUIRE(server_bridge.open("ChatBridgeCorruptTest", SharedMemoryBridge::Role::SERVER) == SharedMemoryBridge::Result::SUCCESS);
+    REQUIRE(game_bridge.open("ChatBridgeCorruptTest", SharedMemoryBridge::Role::GAME) == SharedMemoryBridge::Result::SUCCESS);
+    HANDLE mapping = nullptr;
+    char* layout = map_bridge_layout("ChatBridgeCorruptTest", mapping);
+    REQUIRE(layout != nullptr);
+    char* ring = layout + TO_SERVER_RING_OFFSET;
+
+    // 배치를 제대로 짚었는지 먼저 확인합니다: 4바이트 메시지 하나는 [길이 4][내용 4] = 8바이트입니다.
+    CHECK(game_bridge.send("abcd") == SharedMemoryBridge::Result::SUCCESS);
+    REQUIRE(ring_position(ring, RING_HEAD_OFFSET).load() == 0);
+    REQUIRE(ring_position(ring, RING_TAIL_OFFSET).load() == 8);
+    std::uint32_t length = 0;
+    std::memcpy(&length, ring + RING_DATA_OFFSET, sizeof(length));
+    REQUIRE(length == 4);
+    std::string message;
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "abcd");
+
+    // 1. 길이가 최대 크기를 넘는 레코드: 남은 내용을 버리고 다음 메시지부터 받습니다.
+    CHECK(game_bridge.send("lost") == SharedMemoryBridge::Result::SUCCESS);
+    length = SharedMemoryBridge::MAX_MESSAGE_SIZE + 1;
+    std::memcpy(ring + RING_DATA_OFFSET + (ring_position(ring, RING_HEAD_OFFSET).load() & (SharedMemoryBridge::RING_CAPACITY - 1)), &length, sizeof(length));
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::CORRUPTED);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::EMPTY);
+    CHECK(game_bridge.send("after length") == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "after length");
+
+    // 2. head가 tail을 앞지름: 빈 레코드를 지어내 읽지 않고 tail로 되돌립니다.
+    ring_position(ring, RING_HEAD_OFFSET).store(ring_position(ring, RING_TAIL_OFFSET).load() + 64);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::CORRUPTED);
+    CHECK(ring_position(ring, RING_HEAD_OFFSET).load() == ring_position(ring, RING_TAIL_OFFSET).load());
+    CHECK(game_bridge.send("after head") == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "after head");
+
+    // 3. tail이 링 크기보다 멀리 튐: 생산자는 튄 위치부터 이어 쓰고, 소비자가 따라가 다시 받습니다.
+    ring_position(ring, RING_TAIL_OFFSET).store(ring_position(ring, RING_HEAD_OFFSET).load() + 2 * SharedMemoryBridge::RING_CAPACITY);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::CORRUPTED);
+    CHECK(game_bridge.send("after tail") == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS);
+    CHECK(message == "after tail");
+
+    CHECK(server_bridge.getCorruptedCount() == 3);
+    CHECK(server_bridge.getReceivedCount() == 4);
+    CHECK(game_bridge.getDroppedCount() == 0);
+
+    UnmapViewOfFile(layout);
+    CloseHandle(mapping);
+}
+
+/**
+ * @brief 지연 시간 목록의 중앙값과 p99를 보고합니다.
+ */
+static void reportLatencies(TestContext& test_context, const std::string& label, std::vector<double>& latencies_us)
+{
+    if (latencies_us.empty())
+    {
+        return;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    test_context.report(label + " latency p50", latencies_us[latencies_us.size() / 2], "us");
+    test_context.report(label + " latency p99", latencies_us[latencies_us.size() * 99 / 100], "us");
+}
+
+BENCHMARK_CASE(benchmarkGameBridgeLatency)
+{
+    const int ROUNDS = 2000;
+    const int IDLE_GAP_MS = 1;
+
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+
+    // 두 경로 모두 받는 쪽 스레드는 채팅 서버 루프처럼 select로 잠들었다가 깨어나 읽습니다.
+    // 보내는 쪽은 매번 잠깐 쉬어 받는 쪽이 잠든 상태에서 깨어나게 합니다.
+    std::vector<NetworkTransport::Clock::time_point> sent_times(ROUNDS);
+    std::vector<NetworkTransport::Clock::time_point> arrival_times(ROUNDS);
+    std::atomic<int> arrived(0);
+
+    auto wait_for_arrival = [&arrived](int round)
+    {
+        NetworkTransport::Clock::time_point deadline = NetworkTransport::Clock::now() + std::chrono::seconds(1);
+        while (arrived.load(std::memory_order_acquire) <= round && NetworkTransport::Clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    };
+    auto collect_latencies = [&sent_times, &arrival_times, &arrived]()
+    {
+        std::vector<double> latencies_us;
+        for (int i = 0; i < arrived.load(); ++i)
+        {
+            latencies_us.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(arrival_times[i] - sent_times[i]).count() / 1000.0);
+        }
+        return (latencies_us);
+    };
+
+    // 공유 메모리 브리지 : 게임 서버 → 링 → 깨우기 스레드 → 깨우기 소켓 → select.
+    {
+        WinSockTransport loop_transport;
+        SharedMemoryBridge server_bridge;
+        SharedMemoryBridge game_bridge;
+        REQUIRE(server_bridge.open("ChatBridgeBenchmark", SharedMemoryBridge::Role::SERVER) == SharedMemoryBridge::Result::SUCCESS);
+        REQUIRE(game_bridge.open("ChatBridgeBenchmark", SharedMemoryBridge::Role::GAME) == SharedMemoryBridge::Result::SUCCESS);
+        REQUIRE(server_bridge.startWakeSocket() == SharedMemoryBridge::Result::SUCCESS);
+
+        arrived.store(0);
+        std::thread loop_thread([&]()
+        {
+            std::string message;
+            while (arrived.load() < ROUNDS && waitReadable(loop_transport, server_bridge.getWakeSocket(), 1000))
+            {
+                while (server_bridge.receive(message) == SharedMemoryBridge::Result::SUCCESS)
+                {
+                    arrival_times[arrived.load()] = NetworkTransport::Clock::now();
+                    arrived.fetch_add(1, std::memory_order_release);
+                }
+                server_bridge.rearmWakeSocket();
+            }
+        });
+
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_GAP_MS));
+            sent_times[round] = NetworkTransport::Clock::now();
+            game_bridge.send("game event");
+            wait_for_arrival(round);
+        }
+        loop_thread.join();
+
+        CHECK(arrived.load() == ROUNDS);
+        std::vector<double> latencies_us = collect_latencies();
+        reportLatencies(test_context, "shared memory bridge", latencies_us);
+    }
+
+    // 루프백 TCP : 게임 서버가 채팅 서버에 TCP로 붙었을 때의 같은 경로.
+    {
+        WinSockTransport loop_transport;
+        WinSockTransport game_transport;
+        int port = reserveLoopbackPort();
+        SOCKET listen_socket = loop_transport.createSocket();
+        REQUIRE(loop_transport.bindSocket(listen_socket, port) == 0);
+        REQUIRE(loop_transport.listenSocket(listen_socket) == 0);
+        SOCKET game_socket = game_transport.createSocket();
+        REQUIRE(game_transport.connectSocket(game_socket, "127.0.0.1", port) == 0);
+        REQUIRE(waitReadable(loop_transport, listen_socket, 1000));
+        SOCKET server_socket = loop_transport.acceptSocket(listen_socket, nullptr);
+        REQUIRE(server_socket != INVALID_SOCKET);
+
+        // 한 바이트씩 보내므로 Nagle 알고리즘이 다음 송신을 붙잡지 않게 합니다.
+        BOOL no_delay = TRUE;
+        setsockopt(game_socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay, (int)sizeof(no_delay));
+
+        arrived.store(0);
+        std::thread loop_thread([&]()
+        {
+            char buffer[256];
+            while (arrived.load() < ROUNDS && waitReadable(loop_transport, server_socket, 1000))
+            {
+                int received = loop_transport.receiveBytes(server_socket, buffer, (int)sizeof(buffer));
+                for (int i = 0; i < received; ++i)
+                {
+                    arrival_times[arrived.load()] = NetworkTransport::Clock::now();
+                    arrived.fetch_add(1, std::memory_order_release);
+                }
+            }
+        });
+
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_GAP_MS));
+            sent_times[round] = NetworkTransport::Clock::now();
+            game_transport.sendBytes(game_socket, "x", 1);
+            wait_for_arrival(round);
+        }
+        loop_thread.join();
+
+        CHECK(arrived.load() == ROUNDS);
+        std::vector<double> latencies_us = collect_latencies();
+        reportLatencies(test_context, "loopback TCP", latencies_us);
+
+        game_transport.closeSocket(game_socket);
+        loop_transport.closeSocket(server_socket);
+        loop_transport.closeSocket(listen_socket);
+    }
+}
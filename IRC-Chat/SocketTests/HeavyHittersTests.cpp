@@ -0,0 +1,197 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file HeavyHittersTests.cpp
+ * @brief HeavyHitters가 지난 조각을 만료시키고 상위 송신자를 지표 순서대로 돌려주는지 검사하고, 호출당 비용을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "HeavyHitters.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 지표 기준 상위 목록에서 키의 값을 찾습니다. 없으면 0.
+ */
+static std::uint32_t find_value(const HeavyHitters::Talker* talkers, int count, std::uint64_t key, HeavyHitters::Metric metric)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (talkers[i].key == key)
+        {
+            return ((metric == HeavyHitters::Metric::MESSAGES) ? talkers[i].messages : talkers[i].bytes);
+        }
+    }
+    return (0);
+}
+
+TEST_CASE(heavyHittersExpiresOldestWindowOnAdvance)
+{
+    const std::int64_t SLICE = HeavyHitters::WINDOW_MS;
+    HeavyHitters hitters;
+    HeavyHitters::Talker talkers[HeavyHitters::TOP_COUNT];
+
+    // 키 1은 첫 조각에 50개와 둘째 조각에 30개, 키 2는 셋째 조각에 60개를 보냅니다.
+    for (int i = 0; i < 50; ++i)
+    {
+        hitters.record(1, 10, 0);
+    }
+    for (int i = 0; i < 30; ++i)
+    {
+        hitters.record(1, 10, SLICE);
+    }
+    for (int i = 0; i < 60; ++i)
+    {
+        hitters.record(2, 10, SLICE * 2);
+    }
+
+    // 첫 조각은 시간 창 길이가 다 지나기 직전까지 남아 있습니다.
+    int count = hitters.collectTop(HeavyHitters::Metric::MESSAGES, hitters.getWindowMs() - 1, talkers, HeavyHitters::TOP_COUNT);
+    REQUIRE(count == 2);
+    CHECK(talkers[0].key == 1 && talkers[0].messages == 80);
+    CHECK(talkers[1].key == 2 && talkers[1].messages == 60);
+
+    // 첫 조각이 만료되면 키 1은 30개만 남아 순위가 바뀝니다.
+    count = hitters.collectTop(HeavyHitters::Metric::MESSAGES, hitters.getWindowMs(), talkers, HeavyHitters::TOP_COUNT);
+    REQUIRE(count == 2);
+    CHECK(talkers[0].key == 2 && talkers[0].messages == 60);
+    CHECK(talkers[1].key == 1 && talkers[1].messages == 30);
+    CHECK(talkers[1].bytes == 300);
+
+    // 둘째 조각도 만료되면 키 1은 목록에서 빠집니다.
+    count = hitters.collectTop(HeavyHitters::Metric::BYTES, hitters.getWindowMs() + SLICE, talkers, HeavyHitters::TOP_COUNT);
+    REQUIRE(count == 1);
+    CHECK(talkers[0].key == 2 && talkers[0].bytes == 600);
+
+    // 시간 창보다 훨씬 오래 조용했으면 조각 수만큼만 비우고 모두 사라집니다.
+    count = hitters.collectTop(HeavyHitters::Metric::MESSAGES, hitters.getWindowMs() * 100, talkers, HeavyHitters::TOP_COUNT);
+    CHECK(count == 0);
+
+    // 비운 뒤에도 새 기록은 처음부터 셉니다.
+    hitters.record(3, 5, hitters.getWindowMs() * 100 + 1);
+    count = hitters.collectTop(HeavyHitters::Metric::MESSAGES, hitters.getWindowMs() * 100 + 2, talkers, HeavyHitters::TOP_COUNT);
+    REQUIRE(count == 1);
+    CHECK(talkers[0].key == 3 && talkers[0].messages == 1 && talkers[0].bytes == 5);
+}
+
+TEST_CASE(heavyHittersCollectTopOrdersByMetric)
+{
+    const int KEY_COUNT = 15;
+    HeavyHitters hitters;
+
+    // 키 k는 메시지 k개를 (20 - k)^2 바이트씩 보내므로 메시지 순위와 바이트 순위가 다릅니다.
+    for (int k = 1; k <= KEY_COUNT; ++k)
+    {
+        for (int i = 0; i < k; ++i)
+        {
+            hitters.record((std::uint64_t)k, (std::uint32_t)((20 - k) * (20 - k)), 1000);
+        }
+    }
+
+    const HeavyHitters::Metric METRICS[] = { HeavyHitters::Metric::MESSAGES, HeavyHitters::Metric::BYTES };
+    for (HeavyHitters::Metric metric : METRICS)
+    {
+        std::vector<HeavyHitters::Talker> expected;
+        for (int k = 1; k <= KEY_COUNT; ++k)
+        {
+            expected.push_back({ (std::uint64_t)k, (std::uint32_t)k, (std::uint32_t)(k * (20 - k) * (20 - k)) });
+        }
+        std::sort(expected.begin(), expected.end(), [metric](const HeavyHitters::Talker& a, const HeavyHitters::Talker& b)
+        {
+            return ((metric == HeavyHitters::Metric::MESSAGES) ? a.messages > b.messages : a.bytes > b.bytes);
+        });
+
+        HeavyHitters::Talker talkers[HeavyHitters::TOP_COUNT];
+        int count = hitters.collectTop(metric, 1000, talkers, HeavyHitters::TOP_COUNT);
+        REQUIRE(count == HeavyHitters::TOP_COUNT);
+        for (int i = 0; i < count; ++i)
+        {
+            // 키가 적어 스케치 칸이 겹치지 않으므로 추정치가 정확합니다.
+            CHECK(talkers[i].key == expected[i].key);
+            CHECK(talkers[i].messages == expected[i].messages);
+            CHECK(talkers[i].bytes == expected[i].bytes);
+        }
+
+        // 배열이 작으면 앞에서부터 그만큼만 채웁니다.
+        HeavyHitters::Talker first_three[3];
+        CHECK(hitters.collectTop(metric, 1000, first_three, 3) == 3);
+        CHECK(first_three[0].key == expected[0].key && first_three[2].key == expected[2].key);
+    }
+
+    // 작은 송신자가 나중에 많이 보내면 가장 적은 송신자를 밀어내고 들어옵니다.
+    for (int i = 0; i < 40; ++i)
+    {
+        hitters.record(100, 1, 2000);
+    }
+    HeavyHitters::Talker talkers[HeavyHitters::TOP_COUNT];
+    int count = hitters.collectTop(HeavyHitters::Metric::MESSAGES, 2000, talkers, HeavyHitters::TOP_COUNT);
+    REQUIRE(count == HeavyHitters::TOP_COUNT);
+    CHECK(talkers[0].key == 100 && talkers[0].messages == 40);
+    CHECK(find_value(talkers, count, 6, HeavyHitters::Metric::MESSAGES) == 0);
+    for (int i = 1; i < count; ++i)
+    {
+        CHECK(talkers[i - 1].messages >= talkers[i].messages);
+    }
+}
+
+BENCHMARK_CASE(benchmarkHeavyHittersCallCost)
+{
+    const int KEY_COUNTS[] = { 100, 4000, 100000 };
+    const int RECORD_COUNT = 1000000;
+    const int COLLECT_COUNT = 100000;
+
+    for (int key_count : KEY_COUNTS)
+    {
+        // 실제 채팅처럼 소수의 송신자가 대부분을 보내도록 키를 제곱 분포로 고릅니다.
+        std::mt19937 random(20261019);
+        std::vector<std::uint64_t> keys(RECORD_COUNT);
+        std::vector<std::uint32_t> sizes(RECORD_COUNT);
+        for (int i = 0; i < RECORD_COUNT; ++i)
+        {
+            double u = (double)(random() % 1000000) / 1000000.0;
+            keys[i] = (std::uint64_t)(u * u * key_count);
+            sizes[i] = 16 + random() % 200;
+        }
+
+        HeavyHitters hitters;
+
+        // 시간은 조각 안에 머물게 하여 record() 자체의 비용만 잽니다.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < RECORD_COUNT; ++i)
+        {
+            hitters.record(keys[i], sizes[i], 1);
+        }
+        double record_ns = elapsedNanoseconds(start);
+
+        HeavyHitters::Talker talkers[HeavyHitters::TOP_COUNT];
+        int collected = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < COLLECT_COUNT; ++i)
+        {
+            collected = collected + hitters.collectTop(HeavyHitters::Metric::BYTES, 2, talkers, HeavyHitters::TOP_COUNT);
+        }
+        double collect_ns = elapsedNanoseconds(start);
+        CHECK(collected == COLLECT_COUNT * std::min(key_count, HeavyHitters::TOP_COUNT));
+
+        // 조각이 바뀌는 첫 record()는 advance()로 가장 오래된 조각을 합계에서 뺍니다.
+        const int ADVANCE_COUNT = 200;
+        double advance_ns = 0;
+        for (int i = 1; i <= ADVANCE_COUNT; ++i)
+        {
+            start = std::chrono::steady_clock::now();
+            hitters.record(keys[i], sizes[i], 1 + (std::int64_t)i * HeavyHitters::WINDOW_MS);
+            advance_ns = advance_ns + elapsedNanoseconds(start);
+        }
+
+        std::string label = "keys=" + std::to_string(key_count);
+        test_context.report(label + " record", record_ns / RECORD_COUNT, "ns/call");
+        test_context.report(label + " collectTop", collect_ns / COLLECT_COUNT, "ns/call");
+        test_context.report(label + " record with advance", advance_ns / ADVANCE_COUNT / 1000.0, "us/call");
+    }
+    HeavyHitters hitters;
+    test_context.report("memory", (double)hitters.getMemoryBytes() / 1024.0, "KiB");
+}
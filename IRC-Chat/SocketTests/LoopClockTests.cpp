@@ -0,0 +1,161 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopClockTests.cpp
+ * @brief LoopClock이 초가 바뀔 때만 타임스탬프를 다시 만들고 로그 시각의 출처를 바꾸는지 검사하고, 매번 서식하던 방식과 호출당 비용을 비교합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "DebugHelper.h"
+#include "LoopClock.h"
+#include <chrono>
+#include <ctime>
+#include <string>
+
+/**
+ * @brief LoopClock 이전의 current_time()처럼 호출할 때마다 시계를 읽고 지역 시각으로 바꿔 서식합니다.
+ */
+static std::string format_time_per_call()
+{
+    time_t now = time(nullptr);
+    struct tm time_info;
+    localtime_s(&time_info, &now);
+    char buffer[32];
+    std::size_t length = strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &time_info);
+    return (std::string(buffer, length));
+}
+
+/**
+ * @brief 벽시계의 초가 바뀔 때까지 update()를 반복합니다. 바뀌면 true.
+ */
+static bool update_until_next_second(LoopClock& clock)
+{
+    std::time_t start_seconds = clock.getWallSeconds();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        clock.update(NetworkTransport::Clock::now());
+        if (clock.getWallSeconds() != start_seconds)
+        {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+TEST_CASE(loopClockRendersTimestampOnlyWhenSecondChanges)
+{
+    LoopClock clock;
+    CHECK(clock.getRenderCount() == 0);
+
+    // 초 경계에서 시작해야 아래 반복이 같은 초 안에 끝납니다.
+    clock.update(NetworkTransport::Clock::now());
+    REQUIRE(update_until_next_second(clock));
+    std::uint64_t renders = clock.getRenderCount();
+    std::time_t seconds = clock.getWallSeconds();
+    std::string timestamp = clock.getTimestamp();
+    const char* storage = clock.getTimestamp().data();
+    CHECK(timestamp.size() == 19);
+
+    // 같은 초 안의 반복은 다시 만들지 않고 같은 문자열을 그대로 돌려줍니다.
+    for (int i = 0; i < 1000; ++i)
+    {
+        clock.update(NetworkTransport::Clock::now());
+        if (clock.getWallSeconds() != seconds)
+        {
+            break;
+        }
+        CHECK(clock.getRenderCount() == renders);
+        CHECK(clock.getTimestamp() == timestamp);
+    }
+
+    // 초가 바뀐 반복에서 한 번만 다시 만들고, 같은 버퍼를 덮어씁니다.
+    // (위 반복 도중 초가 바뀌었을 수도 있으므로 기준을 다시 잡습니다.)
+    renders = clock.getRenderCount();
+    timestamp = clock.getTimestamp();
+    REQUIRE(update_until_next_second(clock));
+    CHECK(clock.getRenderCount() == renders + 1);
+    CHECK(clock.getTimestamp() != timestamp);
+    CHECK(clock.getTimestamp().data() == storage);
+
+    // 단조 시각과 틱은 update()에 넘긴 값을 그대로 씁니다.
+    NetworkTransport::Clock::time_point monotonic_now = NetworkTransport::Clock::time_point(std::chrono::milliseconds(123456));
+    clock.update(monotonic_now);
+    CHECK(clock.now() == monotonic_now);
+    CHECK(clock.getTick() == 123456);
+}
+
+TEST_CASE(loopClockAttachSwitchesLogTimestampSource)
+{
+    LoopClock clock;
+    clock.update(NetworkTransport::Clock::now());
+
+    // 연결 전에는 스레드별 캐시를 씁니다.
+    CHECK(&current_time() != &clock.getTimestamp());
+    CHECK(current_time().size() == 19);
+
+    // 연결하면 이 스레드의 로그는 시계의 문자열을 그대로 씁니다.
+    clock.attachLogger();
+    CHECK(&current_time() == &clock.getTimestamp());
+
+    // 연결을 끊으면 다시 스스로 시각을 읽습니다.
+    clock.detachLogger();
+    CHECK(&current_time() != &clock.getTimestamp());
+    CHECK(current_time().size() == 19);
+
+    // 연결된 채로 소멸해도 로그가 사라진 문자열을 가리키지 않습니다.
+    {
+        LoopClock scoped_clock;
+        scoped_clock.update(NetworkTransport::Clock::now());
+        scoped_clock.attachLogger();
+        CHECK(&current_time() == &scoped_clock.getTimestamp());
+    }
+    CHECK(loop_timestamp == nullptr);
+}
+
+BENCHMARK_CASE(benchmarkLoopClockTimestamp)
+{
+    const int CALLS = 1000000;
+    std::size_t sink = 0;
+
+    // 이전: 로그 한 줄마다 time/localtime_s/strftime과 문자열 생성.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CALLS; ++i)
+    {
+        sink += format_time_per_call().size();
+    }
+    test_context.report("per-call format ns/call", elapsedNanoseconds(start) / CALLS, "ns");
+
+    // 루프 밖 스레드: 초 단위 스레드별 캐시 (time() 한 번과 비교).
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CALLS; ++i)
+    {
+        sink += current_time().size();
+    }
+    test_context.report("thread cache ns/call", elapsedNanoseconds(start) / CALLS, "ns");
+
+    // 루프 스레드: LoopClock이 반복마다 만든 문자열을 참조로 돌려줍니다.
+    LoopClock clock;
+    clock.update(NetworkTransport::Clock::now());
+    clock.attachLogger();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CALLS; ++i)
+    {
+        sink += current_time().size();
+    }
+    test_context.report("loop clock ns/call", elapsedNanoseconds(start) / CALLS, "ns");
+    clock.detachLogger();
+
+    // 반복마다 한 번 드는 update() 비용 (두 시계 읽기, 초가 바뀌면 서식).
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CALLS; ++i)
+    {
+        clock.update(NetworkTransport::Clock::now());
+    }
+    test_context.report("update ns/iteration", elapsedNanoseconds(start) / CALLS, "ns");
+
+    CHECK(sink > 0);
+}
@@ -0,0 +1,109 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopLatencyTests.cpp
+ * @brief 실제 루프백 TCP 위에서 서버 루프가 조용히 있다가 깨어나 채팅 한 줄을 중계하는 지연 시간과, 그동안 루프 스레드가 쓴 CPU 시간을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 서버는 이 프로세스의 스레드에서 WinSockTransport로 돌리고, LoopbackClient 둘이 한 줄씩 주고받습니다.
+ * <br>줄 사이에 잠깐 쉬어 서버가 매번 대기 상태에서 깨어나게 합니다.
+ */
+
+#include "TestHarness.h"
+#include "LoopbackCluster.h"
+#include "MultiServer.h"
+#include "SocketIniter.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief FILETIME(100ns 단위)을 밀리초로 바꿉니다.
+ */
+static double fileTimeToMillis(const FILETIME& time)
+{
+    unsigned long long ticks = ((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime;
+    return ((double)ticks / 10000.0);
+}
+
+/**
+ * @brief 서버를 스레드에서 돌리며 rounds번 깨어나 중계한 지연 시간을 재고, 지연 시간(중앙값, p99)과 루프 스레드의 CPU 사용률을 보고합니다.
+ */
+static void measureWakeLatency(TestContext& test_context, const std::string& label, bool busy_poll)
+{
+    const int ROUNDS = 500;
+    const int IDLE_GAP_MS = 2;
+
+    WinSockTransport server_transport;
+    int port = reserveLoopbackPort();
+    MultiServer server(port, server_transport, MultiServerBase::SessionMode::HANDLER);
+    if (busy_poll)
+    {
+        server.enableBusyPoll();
+    }
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+
+    // 루프 스레드가 끝날 때 자기 CPU 시간(커널 + 사용자)과 실행 시간을 남깁니다.
+    double loop_cpu_ms = 0.0;
+    double loop_wall_ms = 0.0;
+    std::thread loop_thread([&server, &loop_cpu_ms, &loop_wall_ms]()
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        server.runServerLoop();
+        loop_wall_ms = (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        if (GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+        {
+            loop_cpu_ms = fileTimeToMillis(kernel_time) + fileTimeToMillis(user_time);
+        }
+    });
+
+    WinSockTransport client_transport;
+    LoopbackClient sender(client_transport);
+    LoopbackClient receiver(client_transport);
+    bool joined = sender.connectAndJoin(port, 3000) && receiver.connectAndJoin(port, 3000);
+
+    std::vector<double> latencies_us;
+    latencies_us.reserve(ROUNDS);
+    for (int round = 0; joined && round < ROUNDS; ++round)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_GAP_MS));
+
+        std::string needle = "wake " + std::to_string(round) + " end";
+        std::chrono::steady_clock::time_point sent_at = std::chrono::steady_clock::now();
+        if (sender.sendLine(needle) == false || receiver.waitForLine(needle, 1000) == false)
+        {
+            break;
+        }
+        latencies_us.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(receiver.getArrivalTimes().back() - sent_at).count() / 1000.0);
+    }
+
+    // 대기 중인 select를 바로 깨우도록 한 줄 더 보냅니다.
+    server.stop();
+    sender.sendLine("stop");
+    loop_thread.join();
+
+    CHECK(joined);
+    CHECK(latencies_us.size() == (std::size_t)ROUNDS);
+    if (latencies_us.empty())
+    {
+        return;
+    }
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    test_context.report(label + " wake latency p50", latencies_us[latencies_us.size() / 2], "us");
+    test_context.report(label + " wake latency p99", latencies_us[latencies_us.size() * 99 / 100], "us");
+    test_context.report(label + " loop thread CPU", (loop_wall_ms > 0.0) ? loop_cpu_ms * 100.0 / loop_wall_ms : 0.0, "% of one core");
+}
+
+BENCHMARK_CASE(benchmarkBusyPollWakeLatency)
+{
+    SocketIniter socket_initer;
+    REQUIRE(socket_initer.init() == SocketIniter::Result::SUCCESS_SOCKET);
+
+    measureWakeLatency(test_context, "blocking select", false);
+    measureWakeLatency(test_context, "busy poll", true);
+}
@@ -0,0 +1,289 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopbackCluster.cpp
+ * @brief LoopbackCluster.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "LoopbackCluster.h"
+#include <WS2tcpip.h>
+
+int reserveLoopbackPort()
+{
+    SOCKET probe_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (probe_socket == INVALID_SOCKET)
+    {
+        return (0);
+    }
+
+    // 포트 0으로 바인드하면 운영체제가 빈 포트를 골라 줍니다.
+    sockaddr_in local_addr = {};
+    local_addr.sin_family = AF_INET;
+    local_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    local_addr.sin_port = 0;
+    int addr_len = sizeof(local_addr);
+    int port = 0;
+    if (bind(probe_socket, (sockaddr*)&local_addr, sizeof(local_addr)) == 0
+        && getsockname(probe_socket, (sockaddr*)&local_addr, &addr_len) == 0)
+    {
+        port = ntohs(local_addr.sin_port);
+    }
+
+    closesocket(probe_socket);
+    return (port);
+}
+
+NodeProcess::NodeProcess()
+    : _process(nullptr)
+{
+}
+
+NodeProcess::~NodeProcess()
+{
+    this->terminate();
+}
+
+bool NodeProcess::start(const std::vector<std::string>& arguments)
+{
+    char module_path[MAX_PATH] = {};
+    if (GetModuleFileNameA(nullptr, module_path, MAX_PATH) == 0)
+    {
+        return (false);
+    }
+
+    std::string command_line = "\"" + std::string(module_path) + "\" --node";
+    for (const std::string& argument : arguments)
+    {
+        command_line = command_line + " " + argument;
+    }
+
+    STARTUPINFOA startup_info = {};
+    startup_info.cb = sizeof(startup_info);
+    PROCESS_INFORMATION process_info = {};
+    if (CreateProcessA(module_path, command_line.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup_info, &process_info) == FALSE)
+    {
+        return (false);
+    }
+
+    if (process_info.hThread != nullptr)
+    {
+        CloseHandle(process_info.hThread);
+    }
+    this->_process = process_info.hProcess;
+    return (true);
+}
+
+void NodeProcess::terminate()
+{
+    if (this->_process == nullptr)
+    {
+        return;
+    }
+
+    TerminateProcess(this->_process, 0);
+    WaitForSingleObject(this->_process, 5000);
+    CloseHandle(this->_process);
+    this->_process = nullptr;
+}
+
+bool NodeProcess::isRunning() const
+{
+    return (this->_process != nullptr);
+}
+
+LoopbackCluster::LoopbackCluster(int node_count)
+    : _chatPorts(), _clusterPorts(), _nodes()
+{
+    for (int i = 0; i < node_count; ++i)
+    {
+        this->_chatPorts.push_back(reserveLoopbackPort());
+        this->_clusterPorts.push_back(reserveLoopbackPort());
+        this->_nodes.push_back(std::make_unique<NodeProcess>());
+    }
+}
+
+void LoopbackCluster::setClusterPort(int node, int cluster_port)
+{
+    this->_clusterPorts[node] = cluster_port;
+}
+
+bool LoopbackCluster::startNode(int node)
+{
+    std::vector<std::string> arguments = {
+        "--port", std::to_string(this->_chatPorts[node]),
+        "--cluster_port", std::to_string(this->_clusterPorts[node])
+    };
+    for (int peer = 0; peer < (int)this->_clusterPorts.size(); ++peer)
+    {
+        if (peer != node)
+        {
+            arguments.push_back("--cluster_peer");
+            arguments.push_back("127.0.0.1:" + std::to_string(this->_clusterPorts[peer]));
+        }
+    }
+
+    return (this->_nodes[node]->start(arguments));
+}
+
+void LoopbackCluster::terminateNode(int node)
+{
+    this->_nodes[node]->terminate();
+}
+
+int LoopbackCluster::getChatPort(int node) const
+{
+    return (this->_chatPorts[node]);
+}
+
+int LoopbackCluster::getClusterPort(int node) const
+{
+    return (this->_clusterPorts[node]);
+}
+
+LoopbackClient::LoopbackClient(WinSockTransport& transport)
+    : _transport(transport), _socket(INVALID_SOCKET), _lines(), _arrivalTimes(), _partial()
+{
+}
+
+LoopbackClient::~LoopbackClient()
+{
+    if (this->_socket != INVALID_SOCKET)
+    {
+        this->_transport.closeSocket(this->_socket);
+    }
+}
+
+bool LoopbackClient::connectAndJoin(int port, int timeout_ms)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    // 노드 프로세스가 아직 listen하지 않았으면 잠시 뒤 다시 시도합니다.
+    while (this->_socket == INVALID_SOCKET)
+    {
+        SOCKET client_socket = this->_transport.createSocket();
+        if (this->_transport.connectSocket(client_socket, "127.0.0.1", port) == 0)
+        {
+            this->_socket = client_socket;
+            break;
+        }
+
+        this->_transport.closeSocket(client_socket);
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return (false);
+        }
+        this->_transport.sleepMillis(50);
+    }
+
+    int remaining_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return (this->waitForLine("채팅 서버에 오신 것을 환영합니다", remaining_ms > 0 ? remaining_ms : 0));
+}
+
+bool LoopbackClient::sendLine(const std::string& line)
+{
+    std::string framed_line = line + "\r\n";
+    int sent = 0;
+    while (sent < (int)framed_line.size())
+    {
+        int result = this->_transport.sendBytes(this->_socket, framed_line.data() + sent, (int)framed_line.size() - sent);
+        if (result <= 0)
+        {
+            return (false);
+        }
+        sent = sent + result;
+    }
+    return (true);
+}
+
+bool LoopbackClient::waitForLine(const std::string& needle, int timeout_ms)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    std::size_t checked = 0;
+
+    while (true)
+    {
+        for (; checked < this->_lines.size(); ++checked)
+        {
+            if (this->_lines[checked].find(needle) != std::string::npos)
+            {
+                return (true);
+            }
+        }
+
+        int remaining_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (remaining_ms <= 0)
+        {
+            return (false);
+        }
+        LoopbackClient::receiveAny({ this }, remaining_ms);
+    }
+}
+
+void LoopbackClient::receiveAny(const std::vector<LoopbackClient*>& clients, int timeout_ms)
+{
+    fd_set read_set;
+    FD_ZERO(&read_set);
+    for (LoopbackClient* client : clients)
+    {
+        if (client->_socket != INVALID_SOCKET)
+        {
+            FD_SET(client->_socket, &read_set);
+        }
+    }
+    if (read_set.fd_count == 0)
+    {
+        return;
+    }
+
+    if (clients.front()->_transport.selectReadable(&read_set, timeout_ms) <= 0)
+    {
+        return;
+    }
+
+    for (LoopbackClient* client : clients)
+    {
+        if (client->_socket != INVALID_SOCKET && FD_ISSET(client->_socket, &read_set))
+        {
+            client->receiveOnce();
+        }
+    }
+}
+
+const std::vector<std::string>& LoopbackClient::getLines() const
+{
+    return (this->_lines);
+}
+
+const std::vector<std::chrono::steady_clock::time_point>& LoopbackClient::getArrivalTimes() const
+{
+    return (this->_arrivalTimes);
+}
+
+bool LoopbackClient::receiveOnce()
+{
+    char buffer[4096];
+    int received = this->_transport.receiveBytes(this->_socket, buffer, sizeof(buffer));
+    if (received <= 0)
+    {
+        this->_transport.closeSocket(this->_socket);
+        this->_socket = INVALID_SOCKET;
+        return (false);
+    }
+
+    // 완성된 줄만 목록에 옮기고, 같은 읽기에서 나온 줄은 같은 도착 시각을 씁니다.
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    this->_partial.append(buffer, (std::size_t)received);
+    std::size_t line_start = 0;
+    std::size_t line_end = this->_partial.find("\r\n");
+    while (line_end != std::string::npos)
+    {
+        this->_lines.push_back(this->_partial.substr(line_start, line_end - line_start));
+        this->_arrivalTimes.push_back(now);
+        line_start = line_end + 2;
+        line_end = this->_partial.find("\r\n", line_start);
+    }
+    this->_partial.erase(0, line_start);
+    return (true);
+}
@@ -0,0 +1,249 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file LoopbackCluster.h
+ * @brief 같은 호스트에서 여러 서버 프로세스로 클러스터를 띄우고, 실제 TCP 소켓으로 접속하는 테스트 도우미를 선언합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 노드 프로세스는 SocketTests.exe 자신을 "--node --키 값..." 인자로 다시 실행한 것입니다. (TestMain.cpp 참고)
+ * <br>노드는 ServerConfig로 인자를 읽고 Program으로 실행되므로, 실제 배포와 같은 설정 경로를 거칩니다.
+ * @note 테스트 프로세스에서 WinSock을 쓰므로 SocketIniter::init()을 먼저 호출해야 합니다.
+ */
+
+#include "WinSockTransport.h"
+#include <Windows.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @fn int reserveLoopbackPort()
+ * @brief 운영체제가 고른 빈 TCP 포트 번호를 얻습니다.
+ * @return int : 포트 번호, 실패하면 0.
+ * @note 포트를 잡아 두지는 않습니다. 연결한 적 없는 소켓이므로 닫은 뒤 바로 다른 프로세스가 바인드할 수 있습니다.
+ */
+int reserveLoopbackPort();
+
+/**
+ * @class NodeProcess
+ * @brief "--node" 모드로 띄운 서버 프로세스 하나를 소유합니다. 소멸할 때 프로세스를 끝냅니다.
+ */
+class NodeProcess
+{
+public:
+    /**
+     * @fn NodeProcess::NodeProcess()
+     * @brief 실행 중이 아닌 상태로 만듭니다.
+     * @return 없음.
+     */
+    NodeProcess();
+
+    /**
+     * @fn NodeProcess::~NodeProcess()
+     * @brief 실행 중이면 프로세스를 끝냅니다.
+     * @return 없음.
+     */
+    ~NodeProcess();
+
+    NodeProcess(const NodeProcess& obj) = delete;
+    NodeProcess& operator=(const NodeProcess& obj) = delete;
+
+public:
+    /**
+     * @fn bool NodeProcess::start(const std::vector<std::string>& arguments)
+     * @brief 이 실행 파일을 "--node" 뒤에 arguments를 붙여 새 프로세스로 실행합니다.
+     * @param[IN] const std::vector<std::string>& arguments : ServerConfig 인자 (예: "--port", "5600").
+     * @return bool : 프로세스를 만들었으면 true.
+     */
+    bool start(const std::vector<std::string>& arguments);
+
+    /**
+     * @fn void NodeProcess::terminate()
+     * @brief 프로세스를 강제로 끝내고 종료될 때까지 기다립니다. (노드 장애와 같습니다)
+     * @return 없음.
+     */
+    void terminate();
+
+    /**
+     * @fn bool NodeProcess::isRunning() const
+     * @brief start() 뒤 terminate()하지 않았는지 반환합니다.
+     * @return bool : 실행 중이면 true.
+     */
+    bool isRunning() const;
+
+private:
+    /// 프로세스 핸들 (실행 중이 아니면 nullptr).
+    HANDLE _process;
+};
+
+/**
+ * @class LoopbackCluster
+ * @brief 노드마다 채팅 포트와 클러스터 포트를 정해, 서로를 모두 cluster_peer로 등록한 노드 프로세스들을 관리합니다.
+ */
+class LoopbackCluster
+{
+public:
+    /**
+     * @fn LoopbackCluster::LoopbackCluster(int node_count)
+     * @brief 노드 수만큼 빈 포트를 골라 둡니다. 노드는 startNode()로 띄웁니다.
+     * @param[IN] int node_count : 노드 수.
+     * @return 없음.
+     */
+    explicit LoopbackCluster(int node_count);
+
+public:
+    /**
+     * @fn void LoopbackCluster::setClusterPort(int node, int cluster_port)
+     * @brief 노드의 클러스터 포트(곧 노드 번호)를 직접 정합니다. 어떤 노드도 띄우기 전에 호출합니다.
+     * @param[IN] int node : 노드 순번.
+     * @param[IN] int cluster_port : 클러스터 포트.
+     * @return 없음.
+     */
+    void setClusterPort(int node, int cluster_port);
+
+    /**
+     * @fn bool LoopbackCluster::startNode(int node)
+     * @brief 노드 하나를 띄웁니다. 나머지 노드는 아직 떠 있지 않아도 모두 cluster_peer로 등록합니다.
+     * @param[IN] int node : 노드 순번.
+     * @return bool : 프로세스를 만들었으면 true.
+     */
+    bool startNode(int node);
+
+    /**
+     * @fn void LoopbackCluster::terminateNode(int node)
+     * @brief 노드 하나를 강제로 끝냅니다.
+     * @param[IN] int node : 노드 순번.
+     * @return 없음.
+     */
+    void terminateNode(int node);
+
+    /**
+     * @fn int LoopbackCluster::getChatPort(int node) const
+     * @brief 노드의 채팅 포트를 반환합니다.
+     * @param[IN] int node : 노드 순번.
+     * @return int : 채팅 포트.
+     */
+    int getChatPort(int node) const;
+
+    /**
+     * @fn int LoopbackCluster::getClusterPort(int node) const
+     * @brief 노드의 클러스터 포트를 반환합니다.
+     * @param[IN] int node : 노드 순번.
+     * @return int : 클러스터 포트.
+     */
+    int getClusterPort(int node) const;
+
+private:
+    /// 노드별 채팅 포트.
+    std::vector<int> _chatPorts;
+
+    /// 노드별 클러스터 포트.
+    std::vector<int> _clusterPorts;
+
+    /// 노드별 프로세스.
+    std::vector<std::unique_ptr<NodeProcess>> _nodes;
+};
+
+/**
+ * @class LoopbackClient
+ * @brief 노드에 실제 TCP로 접속해 줄 단위로 보내고, 받은 줄과 도착 시각을 기록하는 테스트 클라이언트입니다.
+ */
+class LoopbackClient
+{
+public:
+    /**
+     * @fn LoopbackClient::LoopbackClient(WinSockTransport& transport)
+     * @brief 접속하지 않은 상태로 만듭니다.
+     * @param[IN] WinSockTransport& transport : 소켓 호출에 쓸 전송 계층.
+     * @return 없음.
+     */
+    explicit LoopbackClient(WinSockTransport& transport);
+
+    /**
+     * @fn LoopbackClient::~LoopbackClient()
+     * @brief 접속 중이면 소켓을 닫습니다.
+     * @return 없음.
+     */
+    ~LoopbackClient();
+
+    LoopbackClient(const LoopbackClient& obj) = delete;
+    LoopbackClient& operator=(const LoopbackClient& obj) = delete;
+
+public:
+    /**
+     * @fn bool LoopbackClient::connectAndJoin(int port, int timeout_ms)
+     * @brief 노드가 listen할 때까지 접속을 다시 시도하고, 환영 메시지를 받을 때까지 기다립니다.
+     * @param[IN] int port : 노드의 채팅 포트.
+     * @param[IN] int timeout_ms : 최대 대기 시간.
+     * @return bool : 시간 안에 입장했으면 true.
+     */
+    bool connectAndJoin(int port, int timeout_ms);
+
+    /**
+     * @fn bool LoopbackClient::sendLine(const std::string& line)
+     * @brief 한 줄을 CRLF를 붙여 보냅니다.
+     * @param[IN] const std::string& line : 보낼 줄.
+     * @return bool : 모두 보냈으면 true.
+     */
+    bool sendLine(const std::string& line);
+
+    /**
+     * @fn bool LoopbackClient::waitForLine(const std::string& needle, int timeout_ms)
+     * @brief needle이 들어 있는 줄을 이미 받았거나 시간 안에 받으면 true를 반환합니다.
+     * @param[IN] const std::string& needle : 찾을 문자열.
+     * @param[IN] int timeout_ms : 최대 대기 시간.
+     * @return bool : 찾았으면 true.
+     */
+    bool waitForLine(const std::string& needle, int timeout_ms);
+
+    /**
+     * @fn static void LoopbackClient::receiveAny(const std::vector<LoopbackClient*>& clients, int timeout_ms)
+     * @brief 여러 클라이언트 중 읽을 데이터가 있는 것을 한 번의 select로 골라 읽습니다.
+     * @param[IN] const std::vector<LoopbackClient*>& clients : 클라이언트 목록.
+     * @param[IN] int timeout_ms : select 대기 시간.
+     * @return 없음.
+     */
+    static void receiveAny(const std::vector<LoopbackClient*>& clients, int timeout_ms);
+
+    /**
+     * @fn const std::vector<std::string>& LoopbackClient::getLines() const
+     * @brief 지금까지 받은 줄 목록을 반환합니다. (CRLF 제외)
+     * @return const std::vector<std::string>& : 받은 순서대로의 줄.
+     */
+    const std::vector<std::string>& getLines() const;
+
+    /**
+     * @fn const std::vector<std::chrono::steady_clock::time_point>& LoopbackClient::getArrivalTimes() const
+     * @brief getLines()와 같은 순서로 각 줄을 받은 시각을 반환합니다.
+     * @return const std::vector<std::chrono::steady_clock::time_point>& : 도착 시각.
+     */
+    const std::vector<std::chrono::steady_clock::time_point>& getArrivalTimes() const;
+
+private:
+    /// 소켓 호출에 쓰는 전송 계층.
+    WinSockTransport& _transport;
+
+    /// 접속한 소켓.
+    SOCKET _socket;
+
+    /// 받은 줄.
+    std::vector<std::string> _lines;
+
+    /// 줄별 도착 시각.
+    std::vector<std::chrono::steady_clock::time_point> _arrivalTimes;
+
+    /// 아직 CRLF를 받지 못한 나머지.
+    std::string _partial;
+
+private:
+    /**
+     * @fn bool LoopbackClient::receiveOnce()
+     * @brief 소켓에서 한 번 읽어 완성된 줄을 목록에 더합니다. 읽을 데이터가 있을 때만 호출합니다.
+     * @return bool : 연결이 살아 있으면 true.
+     */
+    bool receiveOnce();
+};
@@ -0,0 +1,336 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ModerationTests.cpp
+ * @brief 운영자 명령과 금칙어 필터, 클러스터 주인 노드에서의 무시 목록을 검사하고,
+ * <br>무시 목록을 적용한 채팅 팬아웃 비용과 큰 금칙어 목록의 컴파일 및 검사 비용을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "ChatFilter.h"
+#include "CommandParser.h"
+#include "MultiServer.h"
+#include "SimulatedTransport.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 금칙어 파일을 words 한 줄씩으로 다시 씁니다.
+ */
+static void writeFilterFile(const char* file_path, const std::string& words)
+{
+    std::ofstream out(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    out << words;
+}
+
+TEST_CASE(secretArgumentsAreRedactedForLogs)
+{
+    CHECK(CommandParser::redactSecrets("/mod secret") == "/mod ***");
+    CHECK(CommandParser::redactSecrets("/resume 0123abcd 42") == "/resume ***");
+    CHECK(CommandParser::redactSecrets("/mute Player_1") == "/mute Player_1");
+    CHECK(CommandParser::redactSecrets("/modest proposal") == "/modest proposal");
+    CHECK(CommandParser::redactSecrets("hello") == "hello");
+}
+
+TEST_CASE(reloadCommandSwapsChatFilterWithoutRestart)
+{
+    const char* file_path = "filter_test.txt";
+    writeFilterFile(file_path, "apple\r\n");
+
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    server.setModeratorPassword("secret");
+    REQUIRE(server.setChatFilterFile(file_path));
+
+    SOCKET moderator = transport.scheduleConnect(10);
+    SOCKET talker = transport.scheduleConnect(20);
+    transport.scheduleLines(moderator, 400, 0, 1, "/mod secret");
+    transport.scheduleLines(talker, 450, 0, 1, "/reload");
+    transport.scheduleLines(talker, 500, 0, 1, "first apple banana");
+
+    // 파일을 바꾼 뒤 운영자가 다시 읽게 하면, 그다음 채팅부터 새 목록으로 가립니다.
+    transport.scheduleCallback(600, [file_path]() { writeFilterFile(file_path, "banana\r\n"); });
+    transport.scheduleLines(moderator, 650, 0, 1, "/reload");
+    transport.scheduleLines(talker, 700, 0, 1, "second apple banana");
+    transport.scheduleCallback(900, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+    std::remove(file_path);
+
+    const std::string& moderator_output = transport.getCapturedOutput(moderator);
+    CHECK(countOccurrences(moderator_output, "first ***** banana") == 1);
+    CHECK(countOccurrences(moderator_output, "second apple ******") == 1);
+    CHECK(countOccurrences(moderator_output, "금칙어 파일을 다시 읽었습니다. 금칙어: 1개") == 1);
+
+    // 운영자가 아니면 다시 읽을 수 없습니다.
+    CHECK(countOccurrences(transport.getCapturedOutput(talker), "운영자만 사용할 수 있는 명령입니다.") == 1);
+}
+
+TEST_CASE(topCommandGroupsSessionsByAddress)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    server.setModeratorPassword("secret");
+
+    // 가상 클라이언트는 모두 127.0.0.1에서 포트만 다르게 접속합니다.
+    SOCKET moderator = transport.scheduleConnect(10);
+    SOCKET first_talker = transport.scheduleConnect(20);
+    SOCKET second_talker = transport.scheduleConnect(30);
+    transport.scheduleLines(moderator, 400, 0, 1, "/mod secret");
+    transport.scheduleLines(first_talker, 450, 5, 3, "hello");
+    transport.scheduleLines(second_talker, 460, 5, 2, "hi");
+    transport.scheduleLines(moderator, 600, 0, 1, "/top");
+    transport.scheduleCallback(800, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+    // 세 세션의 줄(명령 포함 7줄)이 주소 하나로 합쳐지고, 세션은 닉네임으로 따로 나열됩니다.
+    const std::string& moderator_output = transport.getCapturedOutput(moderator);
+    CHECK(countOccurrences(moderator_output, "상위 송신 주소 (1개)") == 1);
+    CHECK(countOccurrences(moderator_output, "1. 127.0.0.1 - 7줄") == 1);
+    CHECK(countOccurrences(moderator_output, "(Player_0, Player_1, Player_2)") == 1);
+}
+
+TEST_CASE(topCommandRanksIpv4AddressesForModeratorsOnly)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    server.setModeratorPassword("secret");
+
+    // 두 세션은 같은 주소(한 NAT 뒤)에서, 나머지는 각자 다른 주소에서 접속합니다.
+    SOCKET moderator = transport.scheduleConnect(10);
+    SOCKET first_shared = transport.scheduleConnect(20);
+    SOCKET second_shared = transport.scheduleConnect(30);
+    SOCKET bulky = transport.scheduleConnect(40);
+    transport.setPeerAddress(moderator, 0x0A000009);
+    transport.setPeerAddress(first_shared, 0x0A000001);
+    transport.setPeerAddress(second_shared, 0x0A000001);
+    transport.setPeerAddress(bulky, 0x0A000002);
+
+    // 운영자가 아니면 거절되지만, 그 명령 줄도 송신량에는 들어갑니다.
+    transport.scheduleLines(first_shared, 300, 0, 1, "/top");
+    transport.scheduleLines(first_shared, 350, 5, 3, "hello");
+    transport.scheduleLines(second_shared, 360, 5, 2, "hi");
+    transport.scheduleLines(bulky, 370, 0, 1, std::string(100, 'x'));
+    transport.scheduleLines(moderator, 400, 0, 1, "/mod secret");
+    transport.scheduleLines(moderator, 500, 0, 1, "/top");
+    transport.scheduleLines(moderator, 550, 0, 1, "/top bytes");
+    transport.scheduleCallback(700, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+    const std::string& denied_output = transport.getCapturedOutput(first_shared);
+    CHECK(countOccurrences(denied_output, "운영자만 사용할 수 있는 명령입니다.") == 1);
+    CHECK(countOccurrences(denied_output, "상위 송신 주소") == 0);
+
+    // 줄 수 기준: 같은 주소의 두 세션은 한 송신자(1 + 3 + 2줄)로 합쳐지고, 닉네임은 따로 나열됩니다.
+    const std::string& moderator_output = transport.getCapturedOutput(moderator);
+    CHECK(countOccurrences(moderator_output, "줄 수 기준 상위 송신 주소 (3개):") == 1);
+    CHECK(countOccurrences(moderator_output, "1. 10.0.0.1 - 6줄 / 23바이트 (Player_1, Player_2)") == 1);
+    CHECK(countOccurrences(moderator_output, "2. 10.0.0.9 - 2줄 / 15바이트 (Player_0)") == 1);
+    CHECK(countOccurrences(moderator_output, "3. 10.0.0.2 - 1줄 / 100바이트 (Player_3)") == 1);
+
+    // 바이트 기준: 한 줄이지만 긴 줄을 보낸 주소가 앞섭니다.
+    CHECK(countOccurrences(moderator_output, "바이트 기준 상위 송신 주소 (3개):") == 1);
+    CHECK(countOccurrences(moderator_output, "1. 10.0.0.2 - 1줄 / 100바이트 (Player_3)") == 1);
+    CHECK(countOccurrences(moderator_output, "2. 10.0.0.9 - 3줄 / 25바이트 (Player_0)") == 1);
+    CHECK(countOccurrences(moderator_output, "3. 10.0.0.1 - 6줄 / 23바이트 (Player_1, Player_2)") == 1);
+}
+
+TEST_CASE(clusterOwnerAppliesIgnoreToLocalSender)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    // 등록한 노드가 없으면 이 노드 혼자 링에 들어가, 기존 주인을 기다리는 JOIN_WAIT_MS가 지나면 로비의 주인이 됩니다.
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::HANDLER);
+    server.enableCluster(7001);
+
+    // 클러스터 리스닝 소켓도 수락하므로 채팅 포트를 지정해 접속합니다.
+    SOCKET talker = transport.scheduleConnect(10, 5500);
+    SOCKET ignorer = transport.scheduleConnect(20, 5500);
+    SOCKET listener = transport.scheduleConnect(30, 5500);
+    transport.scheduleLines(ignorer, 400, 0, 1, "/ignore Player_0");
+    transport.scheduleLines(talker, RoomDirectory::JOIN_WAIT_MS + 500, 0, 1, "hello from the owner node");
+    transport.scheduleCallback(RoomDirectory::JOIN_WAIT_MS + 700, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+    // 주인이 순번을 매긴 줄도 보낸 로컬 슬롯을 알고 있으므로, 무시한 사람에게는 가지 않습니다.
+    CHECK(countOccurrences(transport.getCapturedOutput(listener), "[Player_0]: hello from the owner node") == 1);
+    CHECK(countOccurrences(transport.getCapturedOutput(ignorer), "[Player_0]: hello from the owner node") == 0);
+}
+
+BENCHMARK_CASE(benchmarkIgnoreFanoutOnClusterOwner)
+{
+    const int ROOM_SIZES[] = { 256, 1024, 4000 };
+    const int LINE_COUNT = 500;
+    const long long CHAT_START_MS = RoomDirectory::JOIN_WAIT_MS + 1000;
+    const long long CHAT_END_MS = CHAT_START_MS + LINE_COUNT + 100;
+
+    for (int room_size : ROOM_SIZES)
+    {
+        for (int cluster = 0; cluster < 2; ++cluster)
+        {
+            SimulatedTransport transport;
+            transport.setOutputCapture(true);
+
+            MultiServer server(5500, transport, MultiServerBase::SessionMode::HANDLER);
+            if (cluster == 1)
+            {
+                server.enableCluster(7001);
+            }
+
+            // 절반은 말하는 사람(Player_0)을 무시합니다.
+            std::vector<SOCKET> sockets;
+            for (int i = 0; i < room_size; ++i)
+            {
+                sockets.push_back(transport.scheduleConnect(1 + i / 100, 5500));
+            }
+            for (int i = 1; i < room_size; i += 2)
+            {
+                transport.scheduleLines(sockets[i], CHAT_START_MS / 2, 0, 1, "/ignore Player_0");
+            }
+            transport.scheduleLines(sockets[0], CHAT_START_MS, 1, LINE_COUNT, "fanout benchmark line");
+
+            // 접속과 입장은 빼고, 채팅 줄이 도착하는 구간의 실제 시간만 잽니다.
+            std::chrono::steady_clock::time_point chat_start;
+            double chat_ns = 0.0;
+            transport.scheduleCallback(CHAT_START_MS - 1, [&chat_start]() { chat_start = std::chrono::steady_clock::now(); });
+            transport.scheduleCallback(CHAT_END_MS, [&chat_start, &chat_ns, &server]()
+            {
+                chat_ns = elapsedNanoseconds(chat_start);
+                server.stop();
+            });
+
+            REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+            server.runServerLoop();
+
+            CHECK(countOccurrences(transport.getCapturedOutput(sockets[1]), "fanout benchmark line") == 0);
+            CHECK(countOccurrences(transport.getCapturedOutput(sockets[2]), "fanout benchmark line") == LINE_COUNT);
+
+            double per_line_ns = chat_ns / LINE_COUNT;
+            std::string label = std::string(cluster == 1 ? "cluster owner" : "standalone") + " room=" + std::to_string(room_size);
+            test_context.report(label + " per line", per_line_ns / 1000.0, "us");
+            test_context.report(label + " per recipient", per_line_ns / (room_size / 2), "ns");
+        }
+    }
+}
+
+BENCHMARK_CASE(benchmarkChatFilterLargeWordList)
+{
+    const int WORD_COUNTS[] = { 1000, 10000, 50000 };
+    const int MESSAGE_COUNT = 20000;
+    const int MESSAGE_LENGTH = 120;
+    const int NAIVE_MESSAGE_COUNT = 50;
+
+    for (int word_count : WORD_COUNTS)
+    {
+        // 영문 소문자 4~10자 단어와 한글 2~4글자 단어를 섞습니다. 같은 시드이므로 매번 같은 목록입니다.
+        std::mt19937 random(20261019);
+        std::vector<std::string> words;
+        words.reserve((std::size_t)word_count);
+        for (int i = 0; i < word_count; ++i)
+        {
+            std::string word;
+            if (i % 4 == 0)
+            {
+                int syllable_count = 2 + (int)(random() % 3);
+                for (int k = 0; k < syllable_count; ++k)
+                {
+                    // 한글 음절(U+AC00~U+D7A3)을 UTF-8 3바이트로 씁니다.
+                    unsigned int code_point = 0xAC00 + (unsigned int)(random() % 11172);
+                    word.push_back((char)(0xE0 | (code_point >> 12)));
+                    word.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                    word.push_back((char)(0x80 | (code_point & 0x3F)));
+                }
+            }
+            else
+            {
+                int length = 4 + (int)(random() % 7);
+                for (int k = 0; k < length; ++k)
+                {
+                    word.push_back((char)('a' + random() % 26));
+                }
+            }
+            words.push_back(word);
+        }
+
+        // 메시지는 무작위 영문 단어로 채우고, 열 개 중 하나에는 목록의 단어를 하나 심습니다.
+        std::vector<std::string> messages;
+        messages.reserve(MESSAGE_COUNT);
+        std::size_t total_bytes = 0;
+        for (int i = 0; i < MESSAGE_COUNT; ++i)
+        {
+            std::string message;
+            while ((int)message.size() < MESSAGE_LENGTH)
+            {
+                int length = 2 + (int)(random() % 6);
+                for (int k = 0; k < length; ++k)
+                {
+                    message.push_back((char)('a' + random() % 26));
+                }
+                message.push_back(' ');
+            }
+            if (i % 10 == 0)
+            {
+                message.insert(MESSAGE_LENGTH / 2, " " + words[random() % words.size()] + " ");
+            }
+            total_bytes = total_bytes + message.size();
+            messages.push_back(message);
+        }
+
+        ChatFilter filter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        filter.setWords(words);
+        double build_ns = elapsedNanoseconds(start);
+        // 무작위로 만든 짧은 단어는 겹칠 수 있고, 겹친 단어는 한 번만 셉니다.
+        CHECK(filter.getWordCount() > 0 && filter.getWordCount() <= words.size());
+
+        std::vector<std::string> scanned = messages;
+        start = std::chrono::steady_clock::now();
+        for (std::string& message : scanned)
+        {
+            filter.apply(message);
+        }
+        double scan_ns = elapsedNanoseconds(start);
+        CHECK(filter.getMaskedCount() >= (std::uint64_t)(MESSAGE_COUNT / 10));
+
+        // 기준값: 단어마다 find로 찾는 방식. 단어 수에 비례하므로 메시지 일부만 잽니다.
+        std::size_t naive_found = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NAIVE_MESSAGE_COUNT; ++i)
+        {
+            for (const std::string& word : words)
+            {
+                if (messages[i].find(word) != std::string::npos)
+                {
+                    naive_found = naive_found + 1;
+                }
+            }
+        }
+        double naive_ns = elapsedNanoseconds(start) / NAIVE_MESSAGE_COUNT;
+        CHECK(naive_found >= (std::size_t)(NAIVE_MESSAGE_COUNT / 10));
+
+        std::string label = "words=" + std::to_string(word_count);
+        test_context.report(label + " build", build_ns / 1000000.0, "ms");
+        test_context.report(label + " scan per message", scan_ns / MESSAGE_COUNT, "ns");
+        test_context.report(label + " scan throughput", (double)total_bytes / scan_ns, "GB/s");
+        test_context.report(label + " find-per-word per message", naive_ns, "ns");
+    }
+}
@@ -0,0 +1,91 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file OutboundTests.cpp
+ * @brief 상태 메시지가 키마다 최신 값 하나로 합쳐지고, 제어 메시지 뒤 채팅 앞이라는 순서를 지키는지 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * MessageSender를 SimulatedTransport 위에서 직접 사용합니다. 송신 창을 0으로 닫아 대기열을 쌓은 뒤 열어서 실제로 나간 바이트 순서를 확인합니다.
+ */
+
+#include "TestHarness.h"
+#include "MessageSender.h"
+#include "SimulatedTransport.h"
+
+/**
+ * @brief 가상 연결 하나를 받아 열린 소켓을 돌려줍니다.
+ */
+static SOCKET acceptOneSocket(SimulatedTransport& transport)
+{
+    SOCKET listen_socket = transport.createSocket();
+    transport.bindSocket(listen_socket, 5500);
+    transport.listenSocket(listen_socket);
+
+    transport.scheduleConnect(1);
+    transport.advanceTime(1);
+    return (transport.acceptSocket(listen_socket, nullptr));
+}
+
+TEST_CASE(stateUpdatesCollapseToLatestAfterControl)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+    SOCKET client_socket = acceptOneSocket(transport);
+    REQUIRE(client_socket != INVALID_SOCKET);
+
+    MessageSender sender(transport);
+
+    // 수신자가 읽지 않는 동안 제어, 상태, 채팅을 섞어서 쌓습니다.
+    transport.setSendWindow(client_socket, 0);
+    sender.unicast("control-1", client_socket);
+    sender.publishState("pos:1", "state A1", &client_socket, 1);
+    sender.publishState("pos:2", "state B1", &client_socket, 1);
+    sender.publishState("pos:1", "state A2", &client_socket, 1);
+    sender.unicast("control-2", client_socket);
+    sender.unicast("chat-1", client_socket, MessageSenderBase::Lane::CHAT);
+    sender.publishState("pos:1", "state A3", &client_socket, 1);
+    sender.flush();
+
+    // 한 바이트도 못 보냈으므로 상태는 슬롯에 남아 계속 덮어씁니다.
+    CHECK(transport.getCapturedOutput(client_socket).empty());
+    CHECK(sender.getStateDepth(client_socket) == 2);
+    CHECK(sender.getCoalescedStateCount() == 2);
+    CHECK(sender.hasBacklog());
+
+    // 창을 열면 제어 메시지 전부, 키별 최신 상태(처음 대기한 키 순서), 채팅 순으로 나갑니다.
+    transport.setSendWindow(client_socket, -1);
+    sender.flush();
+    CHECK(transport.getCapturedOutput(client_socket) == "control-1\r\ncontrol-2\r\nstate A3\r\nstate B1\r\nchat-1\r\n");
+    CHECK(sender.getStateDepth(client_socket) == 0);
+    CHECK(sender.hasBacklog() == false);
+}
+
+TEST_CASE(stateWaitsForPartlySentControl)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+    SOCKET client_socket = acceptOneSocket(transport);
+    REQUIRE(client_socket != INVALID_SOCKET);
+
+    MessageSender sender(transport);
+
+    // 제어 메시지가 반쯤 나간 상태에서는 상태를 제어 레인으로 옮기지 않습니다.
+    transport.setSendWindow(client_socket, 5);
+    sender.unicast("control-3", client_socket);
+    sender.publishState("pos:1", "state A4", &client_socket, 1);
+    sender.flush();
+    CHECK(transport.getCapturedOutput(client_socket) == "contr");
+    CHECK(sender.getStateDepth(client_socket) == 1);
+
+    // 그 사이에 온 새 값은 아직 슬롯에 있는 값을 덮어씁니다.
+    sender.publishState("pos:1", "state A5", &client_socket, 1);
+    CHECK(sender.getStateDepth(client_socket) == 1);
+    CHECK(sender.getCoalescedStateCount() == 1);
+
+    transport.setSendWindow(client_socket, -1);
+    sender.flush();
+    CHECK(transport.getCapturedOutput(client_socket) == "control-3\r\nstate A5\r\n");
+    CHECK(sender.hasBacklog() == false);
+}
@@ -0,0 +1,110 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file PresenceTests.cpp
+ * @brief 접속자 목록 프레임이 "/roster"로 신청한 클라이언트에게만, 길이 접두 프레임으로 가는지 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "PresenceTracker.h"
+#include "SimulatedTransport.h"
+#include <vector>
+
+/**
+ * @brief 캡처된 출력에서 텍스트 줄을 건너뛰고 접속자 목록 프레임만 꺼냅니다.
+ * @return bool : 모든 프레임의 길이 필드가 출력 안에서 끝나면 true.
+ */
+static bool extractPresenceFrames(const std::string& output, std::vector<std::string>& frames)
+{
+    std::size_t position = 0;
+    while (position < output.size())
+    {
+        if (output[position] != PresenceTracker::FRAME_MARKER)
+        {
+            std::size_t line_end = output.find('\n', position);
+            position = (line_end == std::string::npos) ? output.size() : line_end + 1;
+            continue;
+        }
+
+        if (position + 1 + PresenceTracker::LENGTH_FIELD_SIZE > output.size())
+        {
+            return (false);
+        }
+        std::uint32_t length = 0;
+        for (std::size_t i = 0; i < PresenceTracker::LENGTH_FIELD_SIZE; ++i)
+        {
+            length = (length << 8) | (unsigned char)output[position + 1 + i];
+        }
+        std::size_t body = position + 1 + PresenceTracker::LENGTH_FIELD_SIZE;
+        if (body + length > output.size())
+        {
+            return (false);
+        }
+        frames.push_back(output.substr(body, length));
+        position = body + length;
+    }
+    return (true);
+}
+
+TEST_CASE(presenceFramesOnlyReachRosterSubscribers)
+{
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+
+    for (MultiServerBase::SessionMode mode : modes)
+    {
+        SimulatedTransport transport;
+        transport.setOutputCapture(true);
+
+        MultiServer server(5500, transport, mode);
+        SOCKET text_client = transport.scheduleConnect(10);
+        SOCKET subscriber = transport.scheduleConnect(20);
+        transport.scheduleLines(subscriber, 300, 0, 1, "/roster");
+        transport.scheduleConnect(500);
+        transport.scheduleLines(text_client, 900, 0, 1, "quit");
+        transport.scheduleCallback(1200, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        server.runServerLoop();
+
+        // 텍스트 클라이언트는 프레임 대신 참가 알림 줄만 받습니다.
+        const std::string& text_output = transport.getCapturedOutput(text_client);
+        CHECK(text_output.find(PresenceTracker::FRAME_MARKER) == std::string::npos);
+        CHECK(countOccurrences(text_output, "Player_2님이 채팅방에 참여했습니다.") == 1);
+
+        // 신청한 클라이언트는 스냅샷 하나 뒤에 참가(Player_2)와 퇴장(Player_0) 델타를 받습니다.
+        std::vector<std::string> frames;
+        CHECK(extractPresenceFrames(transport.getCapturedOutput(subscriber), frames));
+        REQUIRE(frames.size() == 3);
+        CHECK(frames[0][0] == PresenceTracker::SNAPSHOT_FRAME);
+        CHECK(frames[1][0] == PresenceTracker::DELTA_FRAME);
+        CHECK(frames[1].find("Player_2") != std::string::npos);
+        CHECK(frames[2][0] == PresenceTracker::DELTA_FRAME);
+        CHECK(frames[2][7] == (char)PresenceTracker::DeltaType::REMOVED);
+    }
+}
+
+TEST_CASE(rosterCommandTogglesSubscription)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport);
+    SOCKET subscriber = transport.scheduleConnect(10);
+    transport.scheduleLines(subscriber, 100, 0, 1, "/roster");
+    transport.scheduleLines(subscriber, 200, 0, 1, "/roster");
+    transport.scheduleConnect(300);
+    transport.scheduleCallback(500, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+
+    // 끈 뒤에 들어온 접속자는 텍스트 알림으로만 전달됩니다.
+    std::vector<std::string> frames;
+    CHECK(extractPresenceFrames(transport.getCapturedOutput(subscriber), frames));
+    CHECK(frames.size() == 1);
+    CHECK(countOccurrences(transport.getCapturedOutput(subscriber), "Player_1님이 채팅방에 참여했습니다.") == 1);
+}
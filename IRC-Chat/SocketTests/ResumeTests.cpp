@@ -0,0 +1,107 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file ResumeTests.cpp
+ * @brief 코루틴 모드의 재접속 대기 구간과 재접속 토큰 처리를 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "ResumeRegistry.h"
+#include "SimulatedTransport.h"
+
+/**
+ * @brief 캡처된 출력에서 "[시스템] RESUME <토큰> <순번>" 줄의 토큰을 꺼냅니다.
+ * @return std::string : 토큰, 없으면 빈 문자열.
+ */
+static std::string extractResumeToken(const std::string& output)
+{
+    const std::string prefix = "[시스템] RESUME ";
+    std::size_t position = output.find(prefix);
+    if (position == std::string::npos)
+    {
+        return ("");
+    }
+    position = position + prefix.size();
+    return (output.substr(position, output.find(' ', position) - position));
+}
+
+TEST_CASE(pendingConnectionMissesBroadcastsUntilWelcome)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    SOCKET talker = transport.scheduleConnect(10);
+    SOCKET late_client = transport.scheduleConnect(500);
+    // 늦게 온 연결이 재접속 줄을 기다리는 동안(약 200ms) 채팅과 상태 변경이 오갑니다.
+    transport.scheduleLines(talker, 550, 0, 1, "hello");
+    transport.scheduleLines(talker, 560, 0, 1, "/status busy");
+    transport.scheduleCallback(1000, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+
+    // 환영 메시지가 첫 출력이어야 하고, 접속자 수는 입장을 마친 사람과 본인만 셉니다.
+    const std::string& late_output = transport.getCapturedOutput(late_client);
+    CHECK(late_output.rfind("=== 채팅 서버에 오신 것을 환영합니다! ===", 0) == 0);
+    CHECK(countOccurrences(late_output, "현재 접속자 수: 2명") == 1);
+    CHECK(countOccurrences(late_output, "[Player_0]: hello") == 0);
+    CHECK(countOccurrences(late_output, "[상태] Player_0") == 0);
+    CHECK(countOccurrences(transport.getCapturedOutput(talker), "Player_1님이 채팅방에 참여했습니다.") == 1);
+}
+
+TEST_CASE(midSessionResumeIsRejectedPrivately)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    SOCKET sender = transport.scheduleConnect(10);
+    SOCKET listener = transport.scheduleConnect(20);
+    transport.scheduleLines(sender, 500, 0, 1, "/resume 0123456789abcdef0123456789abcdef 0");
+    transport.scheduleCallback(700, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+
+    // 토큰이 담긴 줄은 다른 사람에게 방송되지 않고, 보낸 사람만 거절 안내를 받습니다.
+    CHECK(countOccurrences(transport.getCapturedOutput(listener), "/resume") == 0);
+    CHECK(countOccurrences(transport.getCapturedOutput(sender), "/resume은 접속 직후 첫 줄로만 보낼 수 있습니다.") == 1);
+}
+
+TEST_CASE(resumeTokenIsLongAndReattachesSession)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    SOCKET first_connection = transport.scheduleConnect(10);
+    SOCKET observer = transport.scheduleConnect(20);
+    SOCKET second_connection = transport.scheduleConnect(700);
+    transport.scheduleDisconnect(first_connection, 500);
+
+    // 토큰은 실행 중에야 알 수 있으므로, 재접속 줄은 끊긴 뒤에 예약합니다.
+    std::string token;
+    transport.scheduleCallback(600, [&transport, &token, first_connection, second_connection]()
+    {
+        token = extractResumeToken(transport.getCapturedOutput(first_connection));
+        transport.scheduleLines(second_connection, 710, 0, 1, "/resume " + token + " 0");
+    });
+    transport.scheduleCallback(1200, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    server.runServerLoop();
+
+    // 128비트 토큰은 16진수 32자입니다.
+    CHECK(token.size() == (std::size_t)ResumeRegistry::TOKEN_LENGTH);
+    CHECK(token.find_first_not_of("0123456789abcdef") == std::string::npos);
+
+    // 이어 붙은 세션은 환영 메시지를 다시 받지 않고, 다른 접속자에게 참가/퇴장 알림도 가지 않습니다.
+    CHECK(countOccurrences(transport.getCapturedOutput(second_connection), "채팅 서버에 오신 것을 환영합니다") == 0);
+    CHECK(countOccurrences(transport.getCapturedOutput(observer), "님이 채팅방을 떠났습니다.") == 0);
+    CHECK(countOccurrences(transport.getCapturedOutput(observer), "님이 채팅방에 참여했습니다.") == 0);
+}
@@ -0,0 +1,276 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file RoomWorkersTests.cpp
+ * @brief 채팅방 작업자가 생산자별 순서를 지키는지, 실행 중 이동과 치우침 기반 이동이 끝나는지 검사하고,
+ * <br>room_workers를 켠 서버가 작업자를 거친 채팅을 가려 순서대로 보내는지 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "RoomWorkers.h"
+#include "SimulatedTransport.h"
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 채팅방마다 핸들러가 기록하는 상태. 생산자별 마지막 번호와 마지막 순번입니다.
+ */
+struct RoomOrder
+{
+    std::array<int, 2> lastIndex = { -1, -1 };
+    std::uint64_t lastSequence = 0;
+};
+
+/**
+ * @brief 모든 작업자의 누적 처리 수를 더합니다.
+ */
+static std::uint64_t total_processed(const RoomWorkers& workers)
+{
+    std::uint64_t total = 0;
+    for (const RoomWorkers::WorkerStats& stats : workers.getStats())
+    {
+        total = total + stats.processedCount;
+    }
+    return (total);
+}
+
+/**
+ * @brief 조건이 참이 될 때까지 최대 timeout_ms 동안 기다립니다. 참이 되면 true.
+ */
+template <typename Predicate>
+static bool wait_until(Predicate predicate, int timeout_ms)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (predicate())
+        {
+            return (true);
+        }
+        std::this_thread::yield();
+    }
+    return (predicate());
+}
+
+TEST_CASE(roomWorkersKeepProducerOrderAcrossMigrations)
+{
+    const int ROOM_COUNT = 8;
+    const int MESSAGES_PER_ROOM = 2000;
+    const int PRODUCER_COUNT = 2;
+
+    // 핸들러는 채팅방 주인 작업자에서만 불리므로 채팅방 상태를 잠그지 않고 순서를 확인합니다.
+    std::atomic<int> order_violations(0);
+    RoomWorkers workers(3, PRODUCER_COUNT, [&order_violations](int, RoomWorkers::Room& room, std::uint64_t tag, std::string& payload)
+    {
+        if (room.state.has_value() == false)
+        {
+            room.state = RoomOrder();
+        }
+        RoomOrder& order = std::any_cast<RoomOrder&>(room.state);
+        int index = std::stoi(payload);
+        if (index != order.lastIndex[tag] + 1 || room.sequence != order.lastSequence + 1)
+        {
+            order_violations.fetch_add(1);
+        }
+        order.lastIndex[tag] = index;
+        order.lastSequence = room.sequence;
+    });
+
+    // 생산자는 다 보낸 뒤에도 이동이 끝나도록 sync()를 계속 호출합니다.
+    std::atomic<int> senders_left(PRODUCER_COUNT);
+    std::atomic<bool> producers_done(false);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        producers.emplace_back([&workers, &senders_left, &producers_done, producer, ROOM_COUNT, MESSAGES_PER_ROOM]()
+        {
+            RoomWorkers::Producer& window = workers.getProducer(producer);
+            for (int i = 0; i < MESSAGES_PER_ROOM; ++i)
+            {
+                for (int room = 0; room < ROOM_COUNT; ++room)
+                {
+                    while (window.submit("room-" + std::to_string(room), std::to_string(i), producer) == false)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            senders_left.fetch_sub(1);
+            while (producers_done.load() == false)
+            {
+                window.sync();
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // 보내는 동안 채팅방을 계속 옮깁니다. 이동 중인 채팅방은 거절되므로 시작한 이동만 셉니다.
+    std::uint64_t started_count = 0;
+    while (senders_left.load() > 0)
+    {
+        for (int room = 0; room < ROOM_COUNT; ++room)
+        {
+            std::string room_id = "room-" + std::to_string(room);
+            if (workers.migrateRoom(room_id, (workers.getOwner(room_id) + 1) % workers.getWorkerCount()))
+            {
+                started_count = started_count + 1;
+            }
+        }
+        std::this_thread::yield();
+    }
+
+    std::uint64_t expected = (std::uint64_t)ROOM_COUNT * MESSAGES_PER_ROOM * PRODUCER_COUNT;
+    bool drained = wait_until([&workers, expected, started_count]()
+    {
+        return (total_processed(workers) == expected && workers.getMigrationCount() == started_count);
+    }, 10000);
+    producers_done.store(true);
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    CHECK(drained);
+    CHECK(started_count > 0);
+    CHECK(order_violations.load() == 0);
+    CHECK(total_processed(workers) == expected);
+    CHECK(workers.migrateRoom("room-0", workers.getWorkerCount()) == false);
+}
+
+TEST_CASE(roomWorkersReportSkewAndMoveHottestRoom)
+{
+    RoomWorkers workers(2, 1, [](int, RoomWorkers::Room&, std::uint64_t, std::string&) {});
+
+    // 같은 작업자에 배정된 채팅방 둘을 고릅니다. 다른 작업자는 한가합니다.
+    std::vector<std::string> rooms;
+    for (int i = 0; rooms.size() < 2; ++i)
+    {
+        std::string room_id = "room-" + std::to_string(i);
+        if (rooms.empty() || workers.getOwner(room_id) == workers.getOwner(rooms[0]))
+        {
+            rooms.push_back(room_id);
+        }
+    }
+    int busy_worker = workers.getOwner(rooms[0]);
+    int idle_worker = 1 - busy_worker;
+
+    // 한 통계 구간이 게시될 때까지 첫 채팅방에 세 배 더 보냅니다.
+    RoomWorkers::Producer& producer = workers.getProducer(0);
+    bool published = wait_until([&workers, &producer, &rooms, busy_worker]()
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            while (producer.submit(rooms[(i == 3) ? 1 : 0], "x") == false)
+            {
+                std::this_thread::yield();
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return (workers.getStats()[busy_worker].messagesPerSecond > 0.0);
+    }, 5000);
+    REQUIRE(published);
+
+    // 모든 부하가 한 작업자에 몰렸으므로 치우침은 작업자 수(2)입니다.
+    std::vector<RoomWorkers::WorkerStats> stats = workers.getStats();
+    CHECK(stats[busy_worker].roomCount == 2);
+    CHECK(stats[busy_worker].hottestRoom == rooms[0]);
+    CHECK(stats[idle_worker].messagesPerSecond == 0.0);
+    CHECK(workers.getSkew() > 1.99);
+    CHECK(workers.getSkew() < 2.01);
+
+    // 가장 바쁜 채팅방을 한가한 작업자로 옮기고, 울타리를 넣으면 이동이 끝납니다.
+    REQUIRE(workers.migrateHottestRoom());
+    CHECK(workers.getOwner(rooms[0]) == idle_worker);
+    CHECK(workers.getOwner(rooms[1]) == busy_worker);
+    CHECK(wait_until([&workers, &producer]()
+    {
+        producer.sync();
+        return (workers.getMigrationCount() == 1);
+    }, 5000));
+}
+
+TEST_CASE(roomWorkersRelayFilteredChatInOrder)
+{
+    const char* file_path = "room_workers_filter.txt";
+    {
+        std::ofstream out(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        out << "apple\r\n";
+    }
+    const int LINE_COUNT = 300;
+
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    REQUIRE(server.setChatFilterFile(file_path));
+    server.enableRoomWorkers(2);
+
+    // 두 사람이 번호를 붙인 채팅을 섞어 보내는 동안 다른 스레드가 lobby를 두 작업자 사이에서 계속 옮깁니다.
+    SOCKET listener = transport.scheduleConnect(10);
+    SOCKET first_talker = transport.scheduleConnect(20);
+    SOCKET second_talker = transport.scheduleConnect(30);
+    std::string first_lines;
+    std::string second_lines;
+    for (int i = 0; i < LINE_COUNT; ++i)
+    {
+        first_lines += "a" + std::to_string(i) + " apple\r\n";
+        second_lines += "b" + std::to_string(i) + "\r\n";
+    }
+    transport.scheduleData(first_talker, 400, first_lines.substr(0, first_lines.size() / 2));
+    transport.scheduleData(second_talker, 400, second_lines);
+    transport.scheduleData(first_talker, 410, first_lines.substr(first_lines.size() / 2));
+    transport.scheduleCallback(900, [&server]() { server.stop(); });
+
+    // 이동 중이거나 이미 그 작업자가 주인이면 거절되므로 시작한 이동만 셉니다.
+    std::atomic<bool> stopping(false);
+    int started_count = 0;
+    std::thread migrator([&server, &stopping, &started_count]()
+    {
+        for (int worker = 0; stopping.load() == false; worker = 1 - worker)
+        {
+            if (server.migrateRoom(MultiServerBase::LOBBY_ROOM_ID, worker))
+            {
+                started_count = started_count + 1;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    CHECK(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+    stopping.store(true);
+    migrator.join();
+    std::remove(file_path);
+
+    // 작업자가 가린 줄이 보낸 순서대로, 빠짐없이 한 번씩 도착합니다.
+    const std::string& output = transport.getCapturedOutput(listener);
+    CHECK(countOccurrences(output, " apple") == 0);
+    CHECK(countOccurrences(output, " *****") == LINE_COUNT);
+    std::size_t first_position = 0;
+    std::size_t second_position = 0;
+    bool in_order = true;
+    for (int i = 0; i < LINE_COUNT; ++i)
+    {
+        std::size_t next_first = output.find("[Player_1]: a" + std::to_string(i) + " *****", first_position);
+        std::size_t next_second = output.find("[Player_2]: b" + std::to_string(i) + "\r\n", second_position);
+        in_order = in_order && next_first != std::string::npos && next_second != std::string::npos;
+        first_position = (next_first == std::string::npos) ? first_position : next_first;
+        second_position = (next_second == std::string::npos) ? second_position : next_second;
+    }
+    CHECK(in_order);
+
+    // 작업자를 옮겨 다니는 동안에도 모든 채팅이 한 번씩 처리되었습니다.
+    CHECK(started_count > 0);
+    std::vector<RoomWorkers::WorkerStats> stats = server.getRoomWorkerStats();
+    REQUIRE(stats.size() == 2);
+    CHECK(stats[0].processedCount + stats[1].processedCount == 2 * LINE_COUNT);
+}
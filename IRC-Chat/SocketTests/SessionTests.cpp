@@ -0,0 +1,161 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SessionTests.cpp
+ * @brief 세션 코루틴이 readLine/sleepFor에서 멈췄다가 이어서 실행되는 흐름과, 예열 이후 코루틴 프레임이 재사용되는지 검사합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "CoroutineFramePool.h"
+#include "MessageSender.h"
+#include "MultiServer.h"
+#include "SessionScheduler.h"
+#include "SimulatedTransport.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 한 줄을 읽어 되돌려 보내고, 잠든 뒤, 시간 제한 읽기와 연결 종료까지 차례로 기다리는 세션 코루틴입니다.
+ * @note 각 단계를 마칠 때마다 steps에 이름을 남겨 어디까지 진행했는지 확인합니다.
+ */
+static Task<> run_echo_session(SessionContext<SimulatedTransport>& context, MessageSender<SimulatedTransport>& sender, SOCKET client_socket, std::vector<std::string>& steps)
+{
+    std::string line;
+    if (co_await context.readLine(line) != SessionContextBase::Result::SUCCESS)
+    {
+        co_return;
+    }
+    steps.push_back("read " + line);
+
+    // 출력은 소켓에 직접 쓰지 않고 송신 대기열에 넣습니다. (서버 루프가 비웁니다.)
+    sender.unicast("echo " + line, client_socket);
+    steps.push_back("wrote");
+
+    co_await context.sleepFor(std::chrono::milliseconds(100));
+    steps.push_back("woke");
+
+    SessionContextBase::Result timed_result = co_await context.readLineFor(line, std::chrono::milliseconds(50));
+    steps.push_back(timed_result == SessionContextBase::Result::TIMEOUT ? "timeout" : "no timeout");
+
+    // 잠든 사이에 도착한 줄은 버퍼에 남아 있다가 다음 readLine()이 바로 꺼냅니다.
+    if (co_await context.readLine(line) == SessionContextBase::Result::SUCCESS)
+    {
+        steps.push_back("read " + line);
+    }
+    if (co_await context.readLine(line) == SessionContextBase::Result::CLIENT_DISCONNECTED)
+    {
+        steps.push_back("closed");
+    }
+}
+
+TEST_CASE(sessionCoroutineResumesAcrossReadWriteAndSleep)
+{
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+    SOCKET listen_socket = transport.createSocket();
+    REQUIRE(transport.bindSocket(listen_socket, 5500) == 0);
+    REQUIRE(transport.listenSocket(listen_socket) == 0);
+
+    SOCKET client_socket = transport.scheduleConnect(0);
+    transport.scheduleData(client_socket, 10, "hello\r\n");
+    transport.scheduleData(client_socket, 250, "later\r\n");
+    transport.scheduleDisconnect(client_socket, 300);
+    transport.advanceTime(1);
+    sockaddr_in client_addr = {};
+    REQUIRE(transport.acceptSocket(listen_socket, &client_addr) == client_socket);
+
+    // 스케줄러는 모든 슬롯의 컨텍스트를 품으므로 힙에 둡니다.
+    std::unique_ptr<SessionScheduler<SimulatedTransport>> scheduler = std::make_unique<SessionScheduler<SimulatedTransport>>(transport);
+    MessageSender<SimulatedTransport> sender(transport);
+    std::vector<std::string> steps;
+
+    // 첫 readLine()에서 멈춥니다.
+    SessionContext<SimulatedTransport>& context = scheduler->prepare(0, client_socket);
+    scheduler->spawn(0, run_echo_session(context, sender, client_socket, steps));
+    CHECK(steps.empty());
+    CHECK(scheduler->wantsRead(0));
+
+    // 줄이 오면 읽고, 보내고, sleepFor()에서 다시 멈춥니다.
+    transport.advanceTime(10);
+    scheduler->onReadable(0);
+    REQUIRE(steps.size() == 2);
+    CHECK(steps[0] == "read hello");
+    CHECK(context.isSleeping());
+    sender.flush();
+    CHECK(countOccurrences(transport.getCapturedOutput(client_socket), "echo hello") == 1);
+
+    // 만료 전에는 깨우지 않습니다.
+    transport.advanceTime(50);
+    scheduler->processTimers(transport.now());
+    CHECK(steps.size() == 2);
+    CHECK(scheduler->getNextTimeoutMs(transport.now(), 1000) == 50);
+
+    // 깨어나 시간 제한 읽기로 다시 멈추고, 줄이 오지 않아 TIMEOUT으로 재개됩니다.
+    transport.advanceTime(60);
+    scheduler->processTimers(transport.now());
+    CHECK(steps.size() == 3);
+    CHECK(steps[2] == "woke");
+    transport.advanceTime(60);
+    scheduler->processTimers(transport.now());
+    REQUIRE(steps.size() == 4);
+    CHECK(steps[3] == "timeout");
+
+    // 남은 줄을 받고, 다음 수신에서 종료를 받아 끝납니다.
+    transport.advanceTime(200);
+    scheduler->onReadable(0);
+    REQUIRE(steps.size() == 5);
+    CHECK(steps[4] == "read later");
+    CHECK(scheduler->isFinished(0) == false);
+    scheduler->onReadable(0);
+    REQUIRE(steps.size() == 6);
+    CHECK(steps[5] == "closed");
+    CHECK(scheduler->isFinished(0));
+    CHECK(scheduler->wantsRead(0) == false);
+    scheduler->release(0);
+}
+
+TEST_CASE(sessionFramesAreReusedAfterWarmup)
+{
+    const int WAVE_COUNT = 4;
+    const int CLIENTS_PER_WAVE = 64;
+    const long long WAVE_MS = 2000;
+
+    SimulatedTransport transport;
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+
+    // 물결마다 같은 수의 세션이 접속해 채팅하고 나갑니다.
+    CoroutineFramePool& pool = CoroutineFramePool::getInstance();
+    std::vector<std::size_t> chunk_counts;
+    std::vector<std::size_t> fallback_counts;
+    for (int wave = 0; wave < WAVE_COUNT; ++wave)
+    {
+        long long wave_start = 10 + wave * WAVE_MS;
+        for (int i = 0; i < CLIENTS_PER_WAVE; ++i)
+        {
+            SOCKET client_socket = transport.scheduleConnect(wave_start + i);
+            transport.scheduleLines(client_socket, wave_start + 500, 10, 5, "hello");
+            transport.scheduleLines(client_socket, wave_start + 1000, 0, 1, "quit");
+        }
+        transport.scheduleCallback(wave_start + 1500, [&pool, &chunk_counts, &fallback_counts]()
+        {
+            chunk_counts.push_back(pool.getChunkCount());
+            fallback_counts.push_back(pool.getFallbackCount());
+        });
+    }
+    transport.scheduleCallback(10 + WAVE_COUNT * WAVE_MS, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+    // 첫 물결이 프레임을 확보한 뒤에는 같은 블록을 다시 쓰므로 청크도, 풀 밖 할당도 늘지 않습니다.
+    REQUIRE(chunk_counts.size() == WAVE_COUNT);
+    CHECK(chunk_counts[0] > 0);
+    for (int wave = 1; wave < WAVE_COUNT; ++wave)
+    {
+        CHECK(chunk_counts[wave] == chunk_counts[0]);
+        CHECK(fallback_counts[wave] == fallback_counts[0]);
+    }
+}
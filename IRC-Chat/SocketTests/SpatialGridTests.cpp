@@ -0,0 +1,159 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file SpatialGridTests.cpp
+ * @brief SpatialGrid의 반경 질의가 전체 훑기와 같은 결과를 내는지 검사하고, 월드 인구에 따른 질의/이동 비용을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 격자 없이 모든 세션을 훑어 반경 안의 인덱스를 모읍니다. (비교 기준)
+ */
+static int scanRadius(const std::vector<float>& xs, const std::vector<float>& ys, float x, float y, float radius, int* indices)
+{
+    int count = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        float dx = xs[i] - x;
+        float dy = ys[i] - y;
+        if (dx * dx + dy * dy <= radius * radius)
+        {
+            indices[count] = (int)i;
+            count = count + 1;
+        }
+    }
+    return (count);
+}
+
+/**
+ * @brief 반경 안에 평균 NEIGHBOUR_TARGET명이 들어오도록 인구에 맞춰 정한 정사각형 월드의 한 변 길이.
+ */
+static float getWorldSide(int population)
+{
+    const double NEIGHBOUR_TARGET = 20.0;
+    const double PI = 3.14159265358979;
+    double area_per_player = PI * MultiServerBase::SAY_RADIUS * MultiServerBase::SAY_RADIUS / NEIGHBOUR_TARGET;
+    return ((float)std::sqrt(area_per_player * population));
+}
+
+TEST_CASE(spatialGridMatchesFullScan)
+{
+    const int POPULATION = 2000;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(0.0f, getWorldSide(POPULATION));
+
+    SpatialGrid grid(POPULATION, MultiServerBase::SAY_RADIUS);
+    std::vector<float> xs(POPULATION);
+    std::vector<float> ys(POPULATION);
+    for (int i = 0; i < POPULATION; ++i)
+    {
+        xs[i] = coordinate(random);
+        ys[i] = coordinate(random);
+        REQUIRE(grid.update(i, xs[i], ys[i], 0.0f) == SpatialGrid::Result::SUCCESS);
+    }
+
+    // 절반을 옮긴 뒤에도 격자 질의와 전체 훑기가 같은 집합을 돌려줘야 합니다.
+    for (int i = 0; i < POPULATION; i = i + 2)
+    {
+        xs[i] = coordinate(random);
+        ys[i] = coordinate(random);
+        grid.update(i, xs[i], ys[i], 0.0f);
+    }
+
+    std::vector<int> grid_indices(POPULATION);
+    std::vector<int> scan_indices(POPULATION);
+    for (int q = 0; q < 200; ++q)
+    {
+        int center = (int)(random() % POPULATION);
+        int grid_count = grid.queryRadius(xs[center], ys[center], 0.0f, MultiServerBase::SAY_RADIUS, grid_indices.data(), POPULATION);
+        int scan_count = scanRadius(xs, ys, xs[center], ys[center], MultiServerBase::SAY_RADIUS, scan_indices.data());
+        REQUIRE(grid_count == scan_count);
+        std::sort(grid_indices.begin(), grid_indices.begin() + grid_count);
+        CHECK(std::equal(grid_indices.begin(), grid_indices.begin() + grid_count, scan_indices.begin()));
+    }
+
+    // 제거한 세션은 더 이상 찾지 않습니다.
+    CHECK(grid.remove(0) == SpatialGrid::Result::SUCCESS);
+    int count = grid.queryRadius(xs[0], ys[0], 0.0f, 0.0f, grid_indices.data(), POPULATION);
+    CHECK(std::find(grid_indices.begin(), grid_indices.begin() + count, 0) == grid_indices.begin() + count);
+}
+
+BENCHMARK_CASE(benchmarkSpatialFanoutByPopulation)
+{
+    const int POPULATIONS[] = { 1000, 10000, 100000 };
+    const int QUERY_COUNT = 20000;
+
+    for (int population : POPULATIONS)
+    {
+        // 인구가 늘어도 밀도는 같게 두어, 반경 안의 인원(실제 팬아웃 대상)이 일정하게 합니다.
+        float world_side = getWorldSide(population);
+        std::mt19937 random(11);
+        std::uniform_real_distribution<float> coordinate(0.0f, world_side);
+        std::uniform_real_distribution<float> step(-300.0f, 300.0f);
+
+        SpatialGrid grid(population, MultiServerBase::SAY_RADIUS);
+        std::vector<float> xs((std::size_t)population);
+        std::vector<float> ys((std::size_t)population);
+        for (int i = 0; i < population; ++i)
+        {
+            xs[i] = coordinate(random);
+            ys[i] = coordinate(random);
+            grid.update(i, xs[i], ys[i], 0.0f);
+        }
+
+        std::vector<int> centers(QUERY_COUNT);
+        for (int& center : centers)
+        {
+            center = (int)(random() % population);
+        }
+        std::vector<int> indices((std::size_t)population);
+        long long grid_found = 0;
+        long long scan_found = 0;
+
+        // 근접 채팅 한 번의 대상 찾기: 격자 질의.
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int center : centers)
+        {
+            grid_found = grid_found + grid.queryRadius(xs[center], ys[center], 0.0f, MultiServerBase::SAY_RADIUS, indices.data(), population);
+        }
+        double grid_query = elapsedNanoseconds(start) / QUERY_COUNT;
+
+        // 같은 질의를 모든 세션 훑기로 처리한 경우. 질의 수를 줄여 측정합니다.
+        int scan_query_count = std::max(100, QUERY_COUNT / (population / 1000));
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < scan_query_count; ++q)
+        {
+            int center = centers[q];
+            scan_found = scan_found + scanRadius(xs, ys, xs[center], ys[center], MultiServerBase::SAY_RADIUS, indices.data());
+        }
+        double scan_query = elapsedNanoseconds(start) / scan_query_count;
+
+        // 위치 갱신: 작은 걸음으로 움직여 일부만 칸을 옮깁니다.
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERY_COUNT; ++q)
+        {
+            int mover = centers[q];
+            xs[mover] = std::clamp(xs[mover] + step(random), 0.0f, world_side);
+            ys[mover] = std::clamp(ys[mover] + step(random), 0.0f, world_side);
+            grid.update(mover, xs[mover], ys[mover], 0.0f);
+        }
+        double update_cost = elapsedNanoseconds(start) / QUERY_COUNT;
+
+        std::string label = "population=" + std::to_string(population);
+        test_context.report(label + " neighbours", (double)grid_found / QUERY_COUNT, "players");
+        test_context.report(label + " grid query", grid_query, "ns/query");
+        test_context.report(label + " full scan", scan_query, "ns/query");
+        test_context.report(label + " position update", update_cost, "ns/update");
+        CHECK(scan_found > 0);
+    }
+}
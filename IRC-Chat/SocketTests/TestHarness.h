@@ -0,0 +1,169 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file TestHarness.h
+ * @brief SocketTests 프로젝트의 테스트/벤치마크 등록과 검사 매크로를 제공합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 외부 테스트 프레임워크 없이 SimulatedTransport 위에서 서버 로직을 검사하고 측정하기 위한 최소한의 도구입니다.<br>
+ * - TEST_CASE(이름) : 기본 실행에 포함되는 검사. CHECK/REQUIRE로 조건을 확인합니다.
+ * - BENCHMARK_CASE(이름) : --bench 옵션을 주었을 때만 실행되는 측정. test_context.report()로 수치를 출력합니다.
+ *
+ * 등록은 정적 객체의 생성자에서 이루어지므로 테스트 파일을 프로젝트에 추가하기만 하면 됩니다.<br>
+ * 실행 방법은 TestMain.cpp를 참고하십시오.
+ */
+
+#include <string>
+#include <vector>
+
+/**
+ * @class TestContext
+ * @brief 테스트 하나의 실패 여부와 측정값 출력을 담당합니다.
+ */
+class TestContext
+{
+public:
+    /**
+     * @fn TestContext::TestContext(const std::string& test_name)
+     * @brief 테스트 이름으로 컨텍스트를 생성합니다.
+     * @param[IN] const std::string& test_name : 출력에 쓸 테스트 이름.
+     */
+    explicit TestContext(const std::string& test_name);
+
+    /**
+     * @fn void TestContext::fail(const char* file, int line, const char* expression)
+     * @brief 조건 실패를 기록하고 위치를 출력합니다.
+     * @param[IN] const char* file : 소스 파일 이름.
+     * @param[IN] int line : 줄 번호.
+     * @param[IN] const char* expression : 실패한 조건식.
+     * @return 없음.
+     */
+    void fail(const char* file, int line, const char* expression);
+
+    /**
+     * @fn void TestContext::report(const std::string& label, double value, const std::string& unit)
+     * @brief 벤치마크 측정값 한 줄을 출력합니다.
+     * @param[IN] const std::string& label : 측정 항목 (예: "clients=1000").
+     * @param[IN] double value : 측정값.
+     * @param[IN] const std::string& unit : 단위 (예: "ns/op").
+     * @return 없음.
+     */
+    void report(const std::string& label, double value, const std::string& unit);
+
+    /**
+     * @fn bool TestContext::hasFailed() const
+     * @brief 실패한 조건이 하나라도 있었는지 확인합니다.
+     * @return bool : 실패가 있으면 true.
+     */
+    bool hasFailed() const;
+
+private:
+    /// 출력에 쓸 테스트 이름.
+    std::string _testName;
+    /// 실패한 조건 수.
+    int _failureCount;
+};
+
+/**
+ * @class TestRegistry
+ * @brief 등록된 테스트와 벤치마크 목록을 보관하고 실행합니다.
+ */
+class TestRegistry
+{
+public:
+    /// 테스트 함수 형식.
+    using TestFunction = void (*)(TestContext& test_context);
+
+    /**
+     * @enum TestRegistry::Kind
+     * @brief 등록 항목의 종류.
+     */
+    enum class Kind
+    {
+        TEST,       ///< 기본 실행에 포함되는 검사.
+        BENCHMARK   ///< --bench 옵션으로만 실행되는 측정.
+    };
+
+public:
+    /**
+     * @fn static TestRegistry& TestRegistry::getInstance()
+     * @brief 프로그램 전체에서 하나뿐인 등록부를 반환합니다.
+     * @return TestRegistry& : 등록부.
+     * @note 정적 객체 초기화 순서 문제를 피하기 위해 함수 안의 정적 변수로 만듭니다.
+     */
+    static TestRegistry& getInstance();
+
+    /**
+     * @fn void TestRegistry::add(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function)
+     * @brief 테스트를 등록합니다.
+     * @param[IN] const char* name : 테스트 이름.
+     * @param[IN] TestRegistry::Kind kind : 종류.
+     * @param[IN] TestRegistry::TestFunction function : 실행할 함수.
+     * @return 없음.
+     */
+    void add(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function);
+
+    /**
+     * @fn int TestRegistry::run(TestRegistry::Kind kind, const std::string& filter)
+     * @brief 이름에 filter가 들어 있는 항목을 등록 순서대로 실행합니다.
+     * @param[IN] TestRegistry::Kind kind : 실행할 종류.
+     * @param[IN] const std::string& filter : 이름 필터 (빈 문자열이면 전부).
+     * @return int : 실패한 항목 수.
+     */
+    int run(TestRegistry::Kind kind, const std::string& filter);
+
+private:
+    /**
+     * @struct TestRegistry::Entry
+     * @brief 등록된 항목 하나.
+     */
+    struct Entry
+    {
+        const char* name;               ///< 테스트 이름.
+        TestRegistry::Kind kind;        ///< 종류.
+        TestRegistry::TestFunction function;    ///< 실행할 함수.
+    };
+
+    /// 등록 순서대로의 항목 목록.
+    std::vector<TestRegistry::Entry> _entries;
+};
+
+/**
+ * @class TestRegistrar
+ * @brief 정적 객체로 만들어져 생성자에서 테스트를 등록합니다. TEST_CASE/BENCHMARK_CASE 매크로가 사용합니다.
+ */
+class TestRegistrar
+{
+public:
+    /**
+     * @fn TestRegistrar::TestRegistrar(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function)
+     * @brief 테스트를 등록부에 추가합니다.
+     * @param[IN] const char* name : 테스트 이름.
+     * @param[IN] TestRegistry::Kind kind : 종류.
+     * @param[IN] TestRegistry::TestFunction function : 실행할 함수.
+     */
+    TestRegistrar(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function);
+};
+
+/// 기본 실행에 포함되는 검사를 정의합니다. 본문에서 test_context를 사용할 수 있습니다.
+#define TEST_CASE(name) \
+    static void name(TestContext& test_context); \
+    static TestRegistrar name##_registrar(#name, TestRegistry::Kind::TEST, name); \
+    static void name(TestContext& test_context)
+
+/// --bench 옵션으로만 실행되는 측정을 정의합니다.
+#define BENCHMARK_CASE(name) \
+    static void name(TestContext& test_context); \
+    static TestRegistrar name##_registrar(#name, TestRegistry::Kind::BENCHMARK, name); \
+    static void name(TestContext& test_context)
+
+/// 조건이 거짓이면 실패로 기록하고 계속 진행합니다.
+#define CHECK(expression) \
+    do { if (!(expression)) { test_context.fail(__FILE__, __LINE__, #expression); } } while (0)
+
+/// 조건이 거짓이면 실패로 기록하고 테스트를 끝냅니다.
+#define REQUIRE(expression) \
+    do { if (!(expression)) { test_context.fail(__FILE__, __LINE__, #expression); return ; } } while (0)
@@ -0,0 +1,135 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file TestMain.cpp
+ * @brief SocketTests 실행 진입점과 TestHarness.h 구현부.
+ * @author 최성락
+ * @date 2026-10-19
+ *
+ * @details
+ * 사용법:<br>
+ * - SocketTests.exe : 모든 TEST_CASE를 실행합니다. 실패가 있으면 종료 코드 1.
+ * - SocketTests.exe 이름 : 이름에 해당 문자열이 들어 있는 TEST_CASE만 실행합니다.
+ * - SocketTests.exe --bench [이름] : TEST_CASE 대신 BENCHMARK_CASE를 실행합니다. 측정은 Release 빌드에서 하십시오.
+ * - SocketTests.exe --node --키 값... : 테스트 대신 서버 노드 하나를 실행합니다. 클러스터 테스트가 자식 프로세스로 띄울 때 씁니다. (LoopbackCluster.h 참고)
+ */
+
+#include "TestHarness.h"
+#include "Program.h"
+#include "ServerConfig.h"
+#include "TraceRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+TestContext::TestContext(const std::string& test_name)
+    : _testName(test_name), _failureCount(0)
+{
+}
+
+void TestContext::fail(const char* file, int line, const char* expression)
+{
+    this->_failureCount = this->_failureCount + 1;
+    std::printf("  실패: %s:%d: %s\n", file, line, expression);
+}
+
+void TestContext::report(const std::string& label, double value, const std::string& unit)
+{
+    std::printf("  %-40s %14.2f %s\n", label.c_str(), value, unit.c_str());
+}
+
+bool TestContext::hasFailed() const
+{
+    return (this->_failureCount > 0);
+}
+
+TestRegistry& TestRegistry::getInstance()
+{
+    static TestRegistry instance;
+    return (instance);
+}
+
+void TestRegistry::add(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function)
+{
+    this->_entries.push_back(TestRegistry::Entry{ name, kind, function });
+}
+
+int TestRegistry::run(TestRegistry::Kind kind, const std::string& filter)
+{
+    int run_count = 0;
+    int failed_count = 0;
+
+    for (const TestRegistry::Entry& entry : this->_entries)
+    {
+        if (entry.kind != kind || std::strstr(entry.name, filter.c_str()) == nullptr)
+        {
+            continue;
+        }
+
+        std::printf("[실행] %s\n", entry.name);
+        std::fflush(stdout);
+
+        TestContext context(entry.name);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        entry.function(context);
+        long long elapsed_ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        run_count = run_count + 1;
+        if (context.hasFailed())
+        {
+            failed_count = failed_count + 1;
+            std::printf("[실패] %s (%lld ms)\n", entry.name, elapsed_ms);
+        }
+        else
+        {
+            std::printf("[통과] %s (%lld ms)\n", entry.name, elapsed_ms);
+        }
+    }
+
+    std::printf("%d개 실행, %d개 실패\n", run_count, failed_count);
+    return (failed_count);
+}
+
+TestRegistrar::TestRegistrar(const char* name, TestRegistry::Kind kind, TestRegistry::TestFunction function)
+{
+    TestRegistry::getInstance().add(name, kind, function);
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef ENABLE_TRACE
+    // 테스트 빌드는 트레이스를 컴파일해 두지만, 측정이 흔들리지 않도록 기록은 필요한 테스트에서만 켭니다.
+    TraceRecorder::setEnabled(false);
+#endif
+
+    // 클러스터 테스트의 노드 프로세스: 나머지 인자를 서버 설정으로 읽어 실제 서버처럼 실행합니다.
+    if (argc >= 2 && std::strcmp(argv[1], "--node") == 0)
+    {
+        ServerConfig config;
+        if (config.parseArguments(argc - 1, argv + 1) != ServerConfig::Result::SUCCESS)
+        {
+            return (-1);
+        }
+
+        Program node(config);
+        return (node.run());
+    }
+
+    TestRegistry::Kind kind = TestRegistry::Kind::TEST;
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+        {
+            kind = TestRegistry::Kind::BENCHMARK;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    int failed_count = TestRegistry::getInstance().run(kind, filter);
+    return ((failed_count == 0) ? 0 : 1);
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+#pragma execution_character_set("utf-8")
+
+/**
+ * @file TestUtility.h
+ * @brief 여러 테스트 파일이 함께 쓰는 작은 도우미 함수들.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <string>
+
+/**
+ * @fn inline int countOccurrences(const std::string& text, const std::string& needle)
+ * @brief 문자열 안에서 needle이 겹치지 않게 나타난 횟수를 셉니다.
+ * @param[IN] const std::string& text : 검사할 문자열 (예: getCapturedOutput()).
+ * @param[IN] const std::string& needle : 찾을 문자열.
+ * @return int : 나타난 횟수.
+ */
+inline int countOccurrences(const std::string& text, const std::string& needle)
+{
+    int count = 0;
+    std::size_t position = text.find(needle);
+    while (position != std::string::npos)
+    {
+        count = count + 1;
+        position = text.find(needle, position + needle.size());
+    }
+    return (count);
+}
+
+/**
+ * @fn inline double elapsedNanoseconds(std::chrono::steady_clock::time_point start)
+ * @brief start부터 지금까지 흐른 실제 시간을 나노초로 반환합니다.
+ * @param[IN] std::chrono::steady_clock::time_point start : 측정 시작 시각.
+ * @return double : 흐른 시간 (나노초).
+ */
+inline double elapsedNanoseconds(std::chrono::steady_clock::time_point start)
+{
+    return ((double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
@@ -0,0 +1,250 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file TextScannerTests.cpp
+ * @brief TextScanner의 스칼라, SSE2, AVX2 구현이 같은 결과를 내는지 검사하고, 구현별 처리량을 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "TextScanner.h"
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 이 CPU에서 고를 수 있는 구현 목록을 구합니다. 스칼라는 항상 들어갑니다.
+ */
+static std::vector<TextScanner::Kernel> collect_kernels()
+{
+    TextScanner::Kernel original = TextScanner::getKernel();
+    std::vector<TextScanner::Kernel> kernels;
+    const TextScanner::Kernel CANDIDATES[] = { TextScanner::Kernel::SCALAR, TextScanner::Kernel::SSE2, TextScanner::Kernel::AVX2 };
+    for (TextScanner::Kernel kernel : CANDIDATES)
+    {
+        if (TextScanner::selectKernel(kernel))
+        {
+            kernels.push_back(kernel);
+        }
+    }
+    TextScanner::selectKernel(original);
+    return (kernels);
+}
+
+/**
+ * @brief 한 구현으로 세 함수를 모두 돌린 결과.
+ */
+struct ScanResult
+{
+    std::size_t lineBreak;
+    bool valid;
+    std::size_t replaced;
+    std::string sanitized;
+    std::size_t boundary;
+
+    bool operator==(const ScanResult& other) const
+    {
+        return (this->lineBreak == other.lineBreak && this->valid == other.valid && this->replaced == other.replaced
+                && this->sanitized == other.sanitized && this->boundary == other.boundary);
+    }
+};
+
+static ScanResult scan_with(TextScanner::Kernel kernel, const char* data, std::size_t size)
+{
+    TextScanner::selectKernel(kernel);
+
+    ScanResult result;
+    result.lineBreak = TextScanner::findLineBreak(data, size);
+    result.valid = TextScanner::isValidUtf8(data, size);
+    result.sanitized.assign(data, size);
+    result.replaced = TextScanner::sanitizeUtf8(result.sanitized);
+    result.boundary = TextScanner::findUtf8Boundary(data, size);
+    return (result);
+}
+
+/**
+ * @brief 영문, 한글, 4바이트 문자를 섞고, 가끔 줄 끝이나 잘못된 바이트를 끼운 바이트열을 만듭니다.
+ */
+static std::string make_mixed_text(std::mt19937& random, std::size_t size, bool allow_errors)
+{
+    const char* const PIECES[] = { "a", "Z", " ", "\xED\x95\x9C", "\xEA\xB8\x80", "\xC3\xA9", "\xF0\x9F\x98\x80" };
+    // 잘린 시퀀스, 과잉 표현, 서로게이트, U+10FFFF 초과, 홀로 온 연속 바이트
+    const char* const ERRORS[] = { "\xED\x95", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\x80", "\xFF" };
+
+    std::string text;
+    while (text.size() < size)
+    {
+        unsigned int roll = random() % 100;
+        if (allow_errors && roll < 3)
+        {
+            text += ERRORS[random() % (sizeof(ERRORS) / sizeof(ERRORS[0]))];
+        }
+        else if (roll < 5)
+        {
+            text.push_back((random() % 2 == 0) ? '\n' : '\r');
+        }
+        else if (roll < 60)
+        {
+            text.push_back((char)('a' + random() % 26));
+        }
+        else
+        {
+            text += PIECES[random() % (sizeof(PIECES) / sizeof(PIECES[0]))];
+        }
+    }
+    // 벡터 폭의 배수가 아닌 길이가 나오도록 넘친 부분은 문자 중간이라도 자릅니다.
+    text.resize(size);
+    return (text);
+}
+
+TEST_CASE(textScannerKernelsAgreeOnRandomInput)
+{
+    std::vector<TextScanner::Kernel> kernels = collect_kernels();
+    TextScanner::Kernel original = TextScanner::getKernel();
+    REQUIRE(kernels.front() == TextScanner::Kernel::SCALAR);
+
+    std::mt19937 random(20261019);
+    int mismatch_count = 0;
+    for (int round = 0; round < 400; ++round)
+    {
+        // 0~130바이트: 16과 32의 배수 앞뒤를 모두 지나고, 앞에 1~3바이트를 두어 정렬되지 않은 주소에서도 읽습니다.
+        std::size_t size = (std::size_t)(round % 131);
+        std::size_t offset = (std::size_t)(round % 4);
+        std::string buffer = std::string(offset, 'x') + make_mixed_text(random, size, (round % 3) != 0);
+        const char* data = buffer.data() + offset;
+
+        ScanResult expected = scan_with(TextScanner::Kernel::SCALAR, data, size);
+        for (std::size_t k = 1; k < kernels.size(); ++k)
+        {
+            if (!(scan_with(kernels[k], data, size) == expected))
+            {
+                mismatch_count = mismatch_count + 1;
+            }
+        }
+    }
+    TextScanner::selectKernel(original);
+    CHECK(mismatch_count == 0);
+}
+
+TEST_CASE(textScannerKernelsAgreeAcrossVectorBoundaries)
+{
+    std::vector<TextScanner::Kernel> kernels = collect_kernels();
+    TextScanner::Kernel original = TextScanner::getKernel();
+
+    // 각 시퀀스를 ASCII 뒤 여러 위치에 두어 16, 32바이트 블록 경계에 걸치게 합니다.
+    struct Case
+    {
+        const char* sequence;
+        bool valid;
+    };
+    const Case CASES[] = {
+        { "\xED\x95\x9C", true },           // 한
+        { "\xF0\x9F\x98\x80", true },       // U+1F600
+        { "\xE0\xA0\x80", true },           // U+0800 (가장 작은 3바이트)
+        { "\xF4\x8F\xBF\xBF", true },       // U+10FFFF
+        { "\xC0\xAF", false },              // 과잉 표현
+        { "\xE0\x80\xAF", false },          // 과잉 표현 (3바이트)
+        { "\xED\xA0\x80", false },          // 서로게이트
+        { "\xF4\x90\x80\x80", false },      // U+10FFFF 초과
+        { "\xBF", false },                  // 홀로 온 연속 바이트
+        { "\xF8\x88\x80\x80\x80", false },  // 5바이트 선두
+    };
+
+    int wrong_count = 0;
+    int mismatch_count = 0;
+    for (const Case& test_case : CASES)
+    {
+        for (std::size_t position = 0; position < 70; ++position)
+        {
+            std::string text = std::string(position, 'a') + test_case.sequence + std::string(position % 7, 'b');
+            ScanResult expected = scan_with(TextScanner::Kernel::SCALAR, text.data(), text.size());
+            if (expected.valid != test_case.valid)
+            {
+                wrong_count = wrong_count + 1;
+            }
+            for (std::size_t k = 1; k < kernels.size(); ++k)
+            {
+                if (!(scan_with(kernels[k], text.data(), text.size()) == expected))
+                {
+                    mismatch_count = mismatch_count + 1;
+                }
+            }
+
+            // 끝에서 잘린 올바른 문자는 경계 앞까지만 완성된 것으로 봅니다.
+            if (test_case.valid)
+            {
+                std::string truncated = std::string(position, 'a') + std::string(test_case.sequence, 1);
+                for (TextScanner::Kernel kernel : kernels)
+                {
+                    ScanResult result = scan_with(kernel, truncated.data(), truncated.size());
+                    if (result.valid || result.boundary != position)
+                    {
+                        wrong_count = wrong_count + 1;
+                    }
+                }
+            }
+        }
+    }
+    TextScanner::selectKernel(original);
+    CHECK(wrong_count == 0);
+    CHECK(mismatch_count == 0);
+}
+
+BENCHMARK_CASE(benchmarkTextScannerThroughput)
+{
+    const std::size_t BUFFER_SIZE = 1 << 20;
+    const int ROUNDS = 50;
+
+    std::vector<TextScanner::Kernel> kernels = collect_kernels();
+    TextScanner::Kernel original = TextScanner::getKernel();
+
+    // 줄 끝이 없는 ASCII와, 줄 끝 없이 한글을 섞은 올바른 UTF-8 두 가지를 끝까지 훑습니다.
+    std::string ascii(BUFFER_SIZE, 'a');
+    for (std::size_t i = 0; i < ascii.size(); i += 7)
+    {
+        ascii[i] = ' ';
+    }
+    std::string mixed;
+    while (mixed.size() + 3 <= BUFFER_SIZE)
+    {
+        mixed += (mixed.size() % 5 == 0) ? "ab" : "\xED\x95\x9C";
+    }
+
+    for (TextScanner::Kernel kernel : kernels)
+    {
+        TextScanner::selectKernel(kernel);
+        std::string name = TextScanner::getKernelName(kernel);
+
+        std::size_t sink = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            sink = sink + TextScanner::findLineBreak(ascii.data(), ascii.size());
+        }
+        double line_break_ns = elapsedNanoseconds(start);
+        CHECK(sink == ascii.size() * ROUNDS);
+
+        int valid_count = 0;
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            valid_count = valid_count + (TextScanner::isValidUtf8(ascii.data(), ascii.size()) ? 1 : 0);
+        }
+        double ascii_ns = elapsedNanoseconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round)
+        {
+            valid_count = valid_count + (TextScanner::isValidUtf8(mixed.data(), mixed.size()) ? 1 : 0);
+        }
+        double mixed_ns = elapsedNanoseconds(start);
+        CHECK(valid_count == ROUNDS * 2);
+
+        test_context.report(name + " findLineBreak", (double)ascii.size() * ROUNDS / line_break_ns, "GB/s");
+        test_context.report(name + " isValidUtf8 ascii", (double)ascii.size() * ROUNDS / ascii_ns, "GB/s");
+        test_context.report(name + " isValidUtf8 hangul", (double)mixed.size() * ROUNDS / mixed_ns, "GB/s");
+    }
+    TextScanner::selectKernel(original);
+}
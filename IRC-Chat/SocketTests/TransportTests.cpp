@@ -0,0 +1,314 @@
+﻿#pragma execution_character_set("utf-8")
+
+/**
+ * @file TransportTests.cpp
+ * @brief SimulatedTransport 자체와, 그 위에서 돌린 서버 루프의 기본 동작을 검사하고 측정합니다.
+ * @author 최성락
+ * @date 2026-10-19
+ */
+
+#include "TestHarness.h"
+#include "TestUtility.h"
+#include "MultiServer.h"
+#include "MessageReceiver.h"
+#include "MessageSender.h"
+#include "NullTransport.h"
+#include "SimulatedTransport.h"
+#include "TextScanner.h"
+#include <vector>
+
+/**
+ * @brief 읽을 데이터가 없는 소켓에 MessageReceiver<Transport>::receiveMessage()를 반복하고 호출당 걸린 시간(ns)을 돌려줍니다.
+ * @note 한 번에 receiveBytes()와 getLastError()만 부르므로 걸린 시간 대부분이 전송 계층 호출 비용입니다. 실패하면 -1.
+ */
+template <typename Transport>
+static double run_idle_receive(Transport& transport, int call_count)
+{
+    std::string pending_input;
+    MessageReceiver<Transport> receiver(transport, 1, pending_input);
+    int success_count = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < call_count; ++i)
+    {
+        success_count = success_count + (receiver.receiveMessage() == MessageReceiverBase::Result::SUCCESS ? 1 : 0);
+    }
+    double elapsed_ns = elapsedNanoseconds(start) / call_count;
+    return (success_count == call_count ? elapsed_ns : -1.0);
+}
+
+/**
+ * @brief MessageSender<Transport>로 한 소켓에 줄을 보내고 비우기를 반복하고 줄당 걸린 시간(ns)을 돌려줍니다.
+ * @note 줄마다 문자열 할당과 대기열 처리가 함께 들어가므로, 실제 송신 경로에서 호출 방식이 차지하는 몫을 봅니다.
+ */
+template <typename Transport>
+static double run_unicast_flush(Transport& transport, int line_count)
+{
+    MessageSender<Transport> sender(transport);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < line_count; ++i)
+    {
+        sender.unicast("benchmark line", 1);
+        sender.flush();
+    }
+    double elapsed_ns = elapsedNanoseconds(start) / line_count;
+    return (sender.hasBacklog() ? -1.0 : elapsed_ns);
+}
+
+TEST_CASE(simulatedTransportSplitsReadsAndReportsWouldBlock)
+{
+    SimulatedTransport transport;
+    SOCKET listen_socket = transport.createSocket();
+    REQUIRE(transport.bindSocket(listen_socket, 5500) == 0);
+    REQUIRE(transport.listenSocket(listen_socket) == 0);
+
+    SOCKET client_socket = transport.scheduleConnect(10);
+    transport.scheduleData(client_socket, 20, "abcde");
+    transport.scheduleDisconnect(client_socket, 30);
+    transport.setReadChunkLimit(2);
+
+    transport.advanceTime(25);
+    CHECK(transport.getElapsedMs() == 25);
+
+    sockaddr_in client_addr = {};
+    REQUIRE(transport.acceptSocket(listen_socket, &client_addr) == client_socket);
+
+    // 부분 읽기 제한만큼씩 나누어 돌려주고, 빈 소켓은 WSAEWOULDBLOCK입니다.
+    char buffer[16];
+    CHECK(transport.receiveBytes(client_socket, buffer, sizeof(buffer)) == 2);
+    CHECK(transport.receiveBytes(client_socket, buffer, sizeof(buffer)) == 2);
+    CHECK(transport.receiveBytes(client_socket, buffer, sizeof(buffer)) == 1);
+    CHECK(buffer[0] == 'e');
+    CHECK(transport.receiveBytes(client_socket, buffer, sizeof(buffer)) == SOCKET_ERROR);
+    CHECK(transport.getLastError() == WSAEWOULDBLOCK);
+
+    // 상대가 닫은 뒤에는 0을 돌려줍니다.
+    transport.advanceTime(10);
+    CHECK(transport.receiveBytes(client_socket, buffer, sizeof(buffer)) == 0);
+}
+
+TEST_CASE(serverRelaysChatUnderPartialWrites)
+{
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+
+    for (MultiServerBase::SessionMode mode : modes)
+    {
+        SimulatedTransport transport;
+        transport.setOutputCapture(true);
+        transport.setWriteChunkLimit(7);
+
+        MultiServer server(5500, transport, mode);
+        SOCKET sender = transport.scheduleConnect(10);
+        SOCKET receiver = transport.scheduleConnect(20);
+        transport.scheduleLines(sender, 300, 5, 3, "hello");
+        transport.scheduleCallback(600, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+        // 7바이트씩 나뉘어 보내져도 줄이 온전히 이어져 있어야 합니다. (보낸 사람도 자기 채팅을 돌려받습니다.)
+        CHECK(countOccurrences(transport.getCapturedOutput(receiver), "[Player_0]: hello\r\n") == 3);
+        CHECK(countOccurrences(transport.getCapturedOutput(sender), "[Player_0]: hello\r\n") == 3);
+        CHECK(transport.getElapsedMs() >= 600);
+    }
+}
+
+TEST_CASE(linesSplitAcrossReadsAreRelayedWhole)
+{
+    const std::string GREETING = "반갑습니다";
+    std::string wide_line;
+    for (int i = 0; i < 1500; ++i)
+    {
+        wide_line += "가";
+    }
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+
+    for (MultiServerBase::SessionMode mode : modes)
+    {
+        SimulatedTransport transport;
+        transport.setOutputCapture(true);
+
+        MultiServer server(5500, transport, mode);
+        SOCKET sender = transport.scheduleConnect(10);
+        SOCKET receiver = transport.scheduleConnect(20);
+
+        // UTF-8 문자 중간, 그리고 "\r"과 "\n" 사이에서 나뉘어 도착합니다.
+        transport.scheduleData(sender, 400, GREETING.substr(0, 4));
+        transport.scheduleData(sender, 410, GREETING.substr(4) + "\r");
+        transport.scheduleData(sender, 420, "\nsecond");
+        transport.scheduleData(sender, 430, " line\r\n");
+
+        // 줄 끝 없이 너무 긴 줄은 잘라 내되, 한글 문자를 가르지 않습니다.
+        transport.scheduleData(sender, 450, wide_line + "\r\n");
+        transport.scheduleCallback(700, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+        const std::string& output = transport.getCapturedOutput(receiver);
+        CHECK(countOccurrences(output, "[Player_0]: " + GREETING + "\r\n") == 1);
+        CHECK(countOccurrences(output, "[Player_0]: second line\r\n") == 1);
+        CHECK(countOccurrences(output, "[Player_0]: \r\n") == 0);
+        CHECK(countOccurrences(output, "[Player_0]: 가") == 2);
+        CHECK(countOccurrences(output, TextScanner::REPLACEMENT_CHARACTER) == 0);
+    }
+}
+
+TEST_CASE(slowReaderKeepsWholeLinesWithoutStallingOthers)
+{
+    const int LINE_COUNT = 2000;
+    const std::string PADDING(200, 'x');
+
+    SimulatedTransport transport;
+    transport.setOutputCapture(true);
+
+    MultiServer server(5500, transport, MultiServerBase::SessionMode::COROUTINE);
+    SOCKET slow_reader = transport.scheduleConnect(10);
+    SOCKET fast_reader = transport.scheduleConnect(20);
+    SOCKET talker = transport.scheduleConnect(30);
+
+    // 느린 수신자의 버퍼가 가득 찬 동안 CHAT 상한(256KB)을 넘는 채팅과 입장 알림이 쌓입니다.
+    transport.scheduleCallback(300, [&transport, slow_reader]() { transport.setSendWindow(slow_reader, 0); });
+    for (int i = 0; i < LINE_COUNT; ++i)
+    {
+        transport.scheduleData(talker, 400, "line" + std::to_string(i) + " " + PADDING + "\r\n");
+    }
+    transport.scheduleConnect(600);
+
+    // 10바이트만 비면 메시지 중간까지 보낸 뒤 남은 부분을 기억해야 하고, 그 뒤 버퍼가 모두 비웁니다.
+    transport.scheduleCallback(800, [&transport, slow_reader]() { transport.setSendWindow(slow_reader, 10); });
+    transport.scheduleCallback(900, [&transport, slow_reader]() { transport.setSendWindow(slow_reader, -1); });
+    transport.scheduleCallback(1500, [&server]() { server.stop(); });
+
+    REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+    CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+    // 빠른 수신자는 느린 수신자 때문에 밀리지 않고 모든 줄을 받습니다.
+    const std::string& fast_output = transport.getCapturedOutput(fast_reader);
+    CHECK(countOccurrences(fast_output, PADDING + "\r\n") == LINE_COUNT);
+
+    // 느린 수신자는 오래된 채팅을 잃지만, 입장 알림과 가장 최근 채팅은 받고 잘린 줄은 없습니다.
+    const std::string& slow_output = transport.getCapturedOutput(slow_reader);
+    int slow_lines = countOccurrences(slow_output, PADDING + "\r\n");
+    CHECK(slow_lines > 0);
+    CHECK(slow_lines < LINE_COUNT);
+    CHECK(countOccurrences(slow_output, "Player_3님이 채팅방에 참여했습니다.") == 1);
+    CHECK(countOccurrences(slow_output, "[Player_2]: line" + std::to_string(LINE_COUNT - 1) + " ") == 1);
+    CHECK(countOccurrences(slow_output, "[Player_2]: line") == slow_lines);
+    CHECK(slow_output.size() >= 2 && slow_output.compare(slow_output.size() - 2, 2, "\r\n") == 0);
+}
+
+TEST_CASE(controlMessagesWaitForPartlySentChatLine)
+{
+    const std::string PADDING(200, 'y');
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+
+    for (MultiServerBase::SessionMode mode : modes)
+    {
+        SimulatedTransport transport;
+        transport.setOutputCapture(true);
+
+        MultiServer server(5500, transport, mode);
+        SOCKET reader = transport.scheduleConnect(10);
+        SOCKET talker = transport.scheduleConnect(20);
+
+        // 채팅 줄이 10바이트만 나간 채 멈춘 동안 입장 알림(CONTROL)이 쌓이고, 버퍼가 비면 둘 다 보내집니다.
+        // (COROUTINE 모드의 입장 알림은 재접속 요청을 기다리는 RESUME_WAIT_MS 뒤에 나갑니다.)
+        transport.scheduleCallback(300, [&transport, reader]() { transport.setSendWindow(reader, 10); });
+        transport.scheduleData(talker, 400, "first " + PADDING + "\r\n");
+        transport.scheduleConnect(450);
+        transport.scheduleCallback(800, [&transport, reader]() { transport.setSendWindow(reader, -1); });
+
+        // 다시 채팅 줄 중간에서 멈춘 채로 나가면, 닫기 전에 마저 보내는 퇴장 알림도 그 줄 뒤에 옵니다.
+        transport.scheduleCallback(900, [&transport, reader]() { transport.setSendWindow(reader, 10); });
+        transport.scheduleData(talker, 1000, "second " + PADDING + "\r\n");
+        transport.scheduleCallback(1100, [&transport, reader]() { transport.setSendWindow(reader, -1); });
+        transport.scheduleData(reader, 1100, "quit\r\n");
+        transport.scheduleCallback(1400, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        CHECK(server.runServerLoop() == MultiServerBase::Result::SUCCESS);
+
+        const std::string& output = transport.getCapturedOutput(reader);
+        std::size_t first_line = output.find("[Player_1]: first " + PADDING + "\r\n");
+        std::size_t join_notice = output.find("Player_2님이 채팅방에 참여했습니다.");
+        std::size_t second_line = output.find("[Player_1]: second " + PADDING + "\r\n");
+        std::size_t leave_notice = output.find("Player_0님이 채팅방을 떠났습니다.");
+        REQUIRE(first_line != std::string::npos);
+        REQUIRE(second_line != std::string::npos);
+        CHECK(join_notice != std::string::npos && join_notice > first_line);
+        CHECK(leave_notice != std::string::npos && leave_notice > second_line);
+    }
+}
+
+BENCHMARK_CASE(benchmarkLoopThroughput)
+{
+    const int CLIENT_COUNT = 10;
+    const int LINES_PER_CLIENT = 20000;
+    MultiServerBase::SessionMode modes[] = { MultiServerBase::SessionMode::HANDLER, MultiServerBase::SessionMode::COROUTINE };
+    const char* mode_names[] = { "handler", "coroutine" };
+
+    for (int m = 0; m < 2; ++m)
+    {
+        SimulatedTransport transport;
+        MultiServer server(5500, transport, modes[m]);
+
+        // 클라이언트마다 한 줄씩 1ms 간격으로 보냅니다.
+        for (int i = 0; i < CLIENT_COUNT; ++i)
+        {
+            SOCKET client_socket = transport.scheduleConnect(1 + i);
+            transport.scheduleLines(client_socket, 1000, 1, LINES_PER_CLIENT, "benchmark line");
+        }
+        transport.scheduleCallback(1000 + LINES_PER_CLIENT + 100, [&server]() { server.stop(); });
+
+        REQUIRE(server.startServer() == MultiServerBase::Result::SUCCESS);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        server.runServerLoop();
+        double elapsed_ns = elapsedNanoseconds(start);
+
+        double line_count = (double)LINES_PER_CLIENT * CLIENT_COUNT;
+        test_context.report(std::string(mode_names[m]) + " ns/line", elapsed_ns / line_count, "ns");
+        test_context.report(std::string(mode_names[m]) + " select calls", (double)transport.getSelectCallCount(), "calls");
+        test_context.report(std::string(mode_names[m]) + " send calls/line", (double)transport.getSendCallCount() / line_count, "calls");
+        test_context.report(std::string(mode_names[m]) + " bytes sent", (double)transport.getTotalBytesSent(), "bytes");
+    }
+}
+
+BENCHMARK_CASE(benchmarkTransportDispatch)
+{
+    const int RECEIVE_CALLS = 5000000;
+    const int UNICAST_LINES = 1000000;
+    const int ROUNDS = 3;
+
+    // 이전: 구성 요소가 NetworkTransport&로 소켓을 호출합니다 (가상 호출).
+    // 이후: 같은 NullTransport를 final 타입 그대로 넘겨 호출이 인라인됩니다.
+    // NullTransport는 아무 일도 하지 않으므로 두 값의 차이가 곧 호출 방식의 비용입니다.
+    NullTransport transport;
+    NetworkTransport& virtual_transport = transport;
+    double virtual_receive_ns = 0.0;
+    double direct_receive_ns = 0.0;
+    double virtual_unicast_ns = 0.0;
+    double direct_unicast_ns = 0.0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        double elapsed_ns = run_idle_receive(virtual_transport, RECEIVE_CALLS);
+        REQUIRE(elapsed_ns >= 0.0);
+        virtual_receive_ns = (round == 0 || elapsed_ns < virtual_receive_ns) ? elapsed_ns : virtual_receive_ns;
+
+        elapsed_ns = run_idle_receive(transport, RECEIVE_CALLS);
+        REQUIRE(elapsed_ns >= 0.0);
+        direct_receive_ns = (round == 0 || elapsed_ns < direct_receive_ns) ? elapsed_ns : direct_receive_ns;
+
+        elapsed_ns = run_unicast_flush(virtual_transport, UNICAST_LINES);
+        REQUIRE(elapsed_ns >= 0.0);
+        virtual_unicast_ns = (round == 0 || elapsed_ns < virtual_unicast_ns) ? elapsed_ns : virtual_unicast_ns;
+
+        elapsed_ns = run_unicast_flush(transport, UNICAST_LINES);
+        REQUIRE(elapsed_ns >= 0.0);
+        direct_unicast_ns = (round == 0 || elapsed_ns < direct_unicast_ns) ? elapsed_ns : direct_unicast_ns;
+    }
+
+    test_context.report("idle receive virtual ns/call", virtual_receive_ns, "ns");
+    test_context.report("idle receive direct ns/call", direct_receive_ns, "ns");
+    test_context.report("unicast+flush virtual ns/line", virtual_unicast_ns, "ns");
+    test_context.report("unicast+flush direct ns/line", direct_unicast_ns, "ns");
+}